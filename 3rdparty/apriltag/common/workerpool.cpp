@@ -56,6 +56,8 @@ struct workerpool {
     pthread_cond_t endcond;     // used to signal completion of all work
 
     int end_count; // how many threads are done?
+
+    workerpool_executor_t executor; // runs the tasks instead of threads
 };
 
 struct task
@@ -64,6 +66,21 @@ struct task
     void *p;
 };
 
+static workerpool_executor_t workerpool_executor = NULL;
+
+void workerpool_set_executor(workerpool_executor_t executor)
+{
+    workerpool_executor = executor;
+}
+
+static void workerpool_run_task(void *ctx, int i)
+{
+    workerpool_t *wp = (workerpool_t*) ctx;
+    struct task *task;
+    zarray_get_volatile(wp->tasks, i, &task);
+    task->f(task->p);
+}
+
 void *worker_thread(void *p)
 {
     workerpool_t *wp = (workerpool_t*) p;
@@ -108,7 +125,9 @@ workerpool_t *workerpool_create(int nthreads)
     wp->nthreads = nthreads;
     wp->tasks = zarray_create(sizeof(struct task));
 
-    if (nthreads > 1) {
+    wp->executor = workerpool_executor;
+
+    if (nthreads > 1 && wp->executor == NULL) {
         wp->threads = (pthread_t *)calloc(wp->nthreads, sizeof(pthread_t));
 
         pthread_mutex_init(&wp->mutex, NULL);
@@ -133,7 +152,7 @@ void workerpool_destroy(workerpool_t *wp)
         return;
 
     // force all worker threads to exit.
-    if (wp->nthreads > 1) {
+    if (wp->nthreads > 1 && wp->executor == NULL) {
         for (int i = 0; i < wp->nthreads; i++)
             workerpool_add_task(wp, NULL, NULL);
 
@@ -182,7 +201,11 @@ void workerpool_run_single(workerpool_t *wp)
 // runs all added tasks, waits for them to complete.
 void workerpool_run(workerpool_t *wp)
 {
-    if (wp->nthreads > 1) {
+    if (wp->nthreads > 1 && wp->executor != NULL) {
+        wp->executor(zarray_size(wp->tasks), wp->nthreads, workerpool_run_task, wp);
+        zarray_clear(wp->tasks);
+
+    } else if (wp->nthreads > 1) {
         wp->end_count = 0;
 
         pthread_mutex_lock(&wp->mutex);
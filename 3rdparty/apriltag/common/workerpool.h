@@ -47,3 +47,12 @@ void workerpool_run_single(workerpool_t *wp);
 int workerpool_get_nthreads(workerpool_t *wp);
 
 int workerpool_get_nprocs();
+
+// Optional executor shared by all the worker pools of the process. When one
+// is installed before workerpool_create(), the pool does not start threads
+// of its own and workerpool_run() hands the queued tasks over to the
+// executor. The executor must call run_task(ctx, i) for each i in
+// [0, ntasks), using at most nthreads threads, and return once they are all
+// done.
+typedef void (*workerpool_executor_t)(int ntasks, int nthreads, void (*run_task)(void *ctx, int i), void *ctx);
+void workerpool_set_executor(workerpool_executor_t executor);
@@ -144,12 +144,16 @@ public:
   //! Address of the first element of the data array
   Type *data;
 
+protected:
+  //! True when \e data and \e rowPtrs point to buffers owned by a derived class
+  bool fixedStorage;
+
 public:
   /*!
   Basic constructor of a 2D array.
   Number of columns and rows are set to zero.
   */
-  vpArray2D<Type>() : rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL) {}
+  vpArray2D<Type>() : rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL), fixedStorage(false) {}
 
   /*!
   Copy constructor of a 2D array.
@@ -158,7 +162,7 @@ public:
   #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
     vpArray2D<Type>()
   #else
-    rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL)
+    rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL), fixedStorage(false)
   #endif
   {
     resize(A.rowNum, A.colNum, false, false);
@@ -175,7 +179,7 @@ public:
   #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
       vpArray2D<Type>()
   #else
-      rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL)
+      rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL), fixedStorage(false)
   #endif
   {
     resize(r, c);
@@ -192,7 +196,7 @@ public:
   #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
       vpArray2D<Type>()
   #else
-      rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL)
+      rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL), fixedStorage(false)
   #endif
   {
     resize(r, c, false, false);
@@ -200,8 +204,15 @@ public:
   }
 
 #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
-  vpArray2D<Type>(vpArray2D<Type> &&A)
+  vpArray2D<Type>(vpArray2D<Type> &&A) : vpArray2D<Type>()
   {
+    if (A.fixedStorage) {
+      // The storage of A is part of the object and can not be stolen
+      resize(A.rowNum, A.colNum, false, false);
+      memcpy(data, A.data, (size_t)rowNum * (size_t)colNum * sizeof(Type));
+      return;
+    }
+
     rowNum = A.rowNum;
     colNum = A.colNum;
     rowPtrs = A.rowPtrs;
@@ -222,7 +233,7 @@ public:
   }
 
   explicit vpArray2D<Type>(unsigned int nrows, unsigned int ncols, const std::initializer_list<Type> &list)
-    : rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL)
+    : rowNum(0), colNum(0), rowPtrs(NULL), dsize(0), data(NULL), fixedStorage(false)
   {
     if (nrows * ncols != static_cast<unsigned int>(list.size())) {
       std::ostringstream oss;
@@ -257,6 +268,11 @@ public:
   */
   virtual ~vpArray2D<Type>()
   {
+    if (fixedStorage) {
+      data = NULL;
+      rowPtrs = NULL;
+    }
+
     if (data != NULL) {
       free(data);
       data = NULL;
@@ -310,6 +326,10 @@ public:
         memset(this->data, 0, this->dsize * sizeof(Type));
       }
     } else {
+      if (fixedStorage) {
+        releaseFixedStorage();
+      }
+
       bool recopy = !flagNullify && recopy_; // priority to flagNullify
       const bool recopyNeeded = (ncols != this->colNum && this->colNum > 0 && ncols > 0 && (!flagNullify || recopy));
       Type *copyTmp = NULL;
@@ -392,6 +412,10 @@ public:
       throw vpException(vpException::dimensionError, oss.str());
     }
 
+    if (fixedStorage && (nrows != rowNum || ncols != colNum)) {
+      releaseFixedStorage();
+    }
+
     rowNum = nrows;
     colNum = ncols;
     rowPtrs = reinterpret_cast<Type **>(realloc(rowPtrs, nrows * sizeof(Type *)));
@@ -434,6 +458,11 @@ public:
   vpArray2D<Type> &operator=(vpArray2D<Type> &&other)
   {
     if (this != &other) {
+      if (fixedStorage || other.fixedStorage) {
+        // At least one storage is part of its object: fall back to a copy
+        return *this = static_cast<const vpArray2D<Type> &>(other);
+      }
+
       free(data);
       free(rowPtrs);
 
@@ -889,6 +918,49 @@ public:
     return true;
   }
   //@}
+
+protected:
+  /*!
+    Constructor used by the fixed-size arrays (vpHomogeneousMatrix,
+    vpRotationMatrix...) that keep their elements in the object itself
+    instead of the heap. \e buffer and \e rows must be members of the
+    derived class, able to contain respectively \e r * \e c elements and \e r
+    row pointers. The array is initialized with 0.
+
+    If the array is later resized to other dimensions, its elements are
+    moved to the heap as for any other array.
+  */
+  vpArray2D<Type>(unsigned int r, unsigned int c, Type *buffer, Type **rows)
+    : rowNum(r), colNum(c), rowPtrs(rows), dsize(r * c), data(buffer), fixedStorage(true)
+  {
+    for (unsigned int i = 0; i < r; i++) {
+      rowPtrs[i] = data + i * c;
+    }
+    memset(data, 0, (size_t)dsize * sizeof(Type));
+  }
+
+private:
+  /*!
+    Move the elements of a fixed-size array to the heap so that the array
+    can be resized like any other.
+  */
+  void releaseFixedStorage()
+  {
+    Type *heapData = (Type *)malloc((size_t)dsize * sizeof(Type));
+    Type **heapRows = (Type **)malloc((size_t)rowNum * sizeof(Type *));
+    if ((heapData == NULL || heapRows == NULL) && dsize != 0) {
+      free(heapData);
+      free(heapRows);
+      throw(vpException(vpException::memoryAllocationError, "Memory allocation error when allocating 2D array data"));
+    }
+    memcpy(heapData, data, (size_t)dsize * sizeof(Type));
+    for (unsigned int i = 0; i < rowNum; i++) {
+      heapRows[i] = heapData + i * colNum;
+    }
+    data = heapData;
+    rowPtrs = heapRows;
+    fixedStorage = false;
+  }
 };
 
 /*!
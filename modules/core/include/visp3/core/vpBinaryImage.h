@@ -0,0 +1,145 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Bit-packed binary image.
+ *
+ *****************************************************************************/
+
+#ifndef _vpBinaryImage_h_
+#define _vpBinaryImage_h_
+
+/*!
+  \file vpBinaryImage.h
+  \brief Bit-packed binary image.
+*/
+
+#include <stdint.h>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImage.h>
+
+/*!
+  \class vpBinaryImage
+
+  \ingroup group_core_image
+
+  Binary image storing 64 pixels per 64-bit word.
+
+  Each row is made of getNbWords() words. The pixel of column \e j is the bit
+  \e j % 64 of the word \e j / 64 of its row, so that the morphological
+  operators and the region filling algorithms process 64 pixels with a few
+  logical operations. The bits after the last column of a row are always 0.
+  A 4K mask takes 1 MB instead of 8 MB with a vpImage<unsigned char>.
+
+  The following functions process a vpBinaryImage:
+  - vpImageMorphology::erosion(), vpImageMorphology::dilatation(),
+    vpImageMorphology::opening() and vpImageMorphology::closing() with a
+    square or cross structuring element of any radius
+  - vp::reconstruct(), vp::floodFill() and vp::fillHoles() from the imgproc
+    module
+
+  \code
+#include <visp3/core/vpBinaryImage.h>
+#include <visp3/core/vpImageMorphology.h>
+
+int main()
+{
+  vpImage<unsigned char> I(480, 640, 0);
+  // Threshold or segment I...
+
+  vpBinaryImage B(I); // Pixels different from 0 are set
+  vpImageMorphology::opening(B, vpImageMorphology::STRUCTURING_ELEMENT_SQUARE, 2);
+  B.convert(I); // Back to 0 / 255
+}
+  \endcode
+*/
+class VISP_EXPORT vpBinaryImage
+{
+public:
+  vpBinaryImage();
+  vpBinaryImage(unsigned int height, unsigned int width, bool value = false);
+  explicit vpBinaryImage(const vpImage<unsigned char> &I);
+
+  void convert(vpImage<unsigned char> &I, unsigned char foreground = 255, unsigned char background = 0) const;
+
+  unsigned int getCount() const;
+  //! Return the number of rows.
+  inline unsigned int getHeight() const { return m_height; }
+  //! Return the number of 64-bit words of a row.
+  inline unsigned int getNbWords() const { return m_nbWords; }
+  //! Return the words of the row \e i.
+  inline uint64_t *getRow(unsigned int i) { return &m_words[i * m_nbWords]; }
+  //! Return the words of the row \e i.
+  inline const uint64_t *getRow(unsigned int i) const { return &m_words[i * m_nbWords]; }
+  //! Return the value of the pixel of row \e i and column \e j.
+  inline bool getValue(unsigned int i, unsigned int j) const
+  {
+    return ((m_words[i * m_nbWords + (j >> 6)] >> (j & 63)) & 1) != 0;
+  }
+  //! Return the number of columns.
+  inline unsigned int getWidth() const { return m_width; }
+
+  void init(const vpImage<unsigned char> &I);
+  void invert();
+  //! Return true if the image has no pixel.
+  inline bool isEmpty() const { return m_height == 0 || m_width == 0; }
+
+  void resize(unsigned int height, unsigned int width, bool value = false);
+
+  //! Set the value of the pixel of row \e i and column \e j.
+  inline void setValue(unsigned int i, unsigned int j, bool value)
+  {
+    uint64_t &w = m_words[i * m_nbWords + (j >> 6)];
+    const uint64_t bit = (uint64_t)1 << (j & 63);
+    w = value ? (w | bit) : (w & ~bit);
+  }
+
+  bool operator==(const vpBinaryImage &B) const;
+  bool operator!=(const vpBinaryImage &B) const;
+
+  /*!
+    Return the mask of the bits of the last word of a row that correspond to
+    pixels. The other bits must stay equal to 0.
+  */
+  inline uint64_t getLastWordMask() const
+  {
+    return (m_width & 63) ? (((uint64_t)1 << (m_width & 63)) - 1) : ~(uint64_t)0;
+  }
+
+private:
+  unsigned int m_height;
+  unsigned int m_width;
+  unsigned int m_nbWords;
+  std::vector<uint64_t> m_words;
+};
+
+#endif
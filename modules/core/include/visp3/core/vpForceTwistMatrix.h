@@ -237,6 +237,11 @@ public:
   vp_deprecated void setIdentity();
 //@}
 #endif
+
+private:
+  // Elements and row pointers of the fixed-size storage, see vpArray2D
+  double m_fixedData[36];
+  double *m_fixedRowPtrs[6];
 };
 
 #endif
@@ -52,6 +52,7 @@
 #include <visp3/core/vpHistogramPeak.h>
 #include <visp3/core/vpHistogramValey.h>
 #include <visp3/core/vpImage.h>
+#include <visp3/core/vpImageView.h>
 
 #ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
 #include <visp3/core/vpList.h>
@@ -239,6 +240,10 @@ public:
   };
 
   void calculate(const vpImage<unsigned char> &I, const unsigned int nbins = 256, const unsigned int nbThreads = 1);
+  void calculate(const vpImageView<unsigned char> &I, const unsigned int nbins = 256,
+                 const unsigned int nbThreads = 1);
+  static void calculate(const vpImage<vpRGBa> &I, vpHistogram &histR, vpHistogram &histG, vpHistogram &histB,
+                        vpHistogram &histA, const unsigned int nbins = 256, const unsigned int nbThreads = 1);
 
   void display(const vpImage<unsigned char> &I, const vpColor &color = vpColor::white, const unsigned int thickness = 2,
                const unsigned int maxValue_ = 0);
@@ -291,6 +296,7 @@ public:
 
 private:
   void init(unsigned size = 256);
+  void initBins(const unsigned int nbins, unsigned int lut[256]);
 
   unsigned int *histogram;
   unsigned size; // Histogram size (max allowed 256)
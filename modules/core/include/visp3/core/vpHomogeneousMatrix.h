@@ -233,6 +233,7 @@ public:
   };
 
   static vpHomogeneousMatrix mean(const std::vector<vpHomogeneousMatrix> &vec_M);
+  static void multiply(const vpHomogeneousMatrix &aMb, const vpHomogeneousMatrix &bMc, vpHomogeneousMatrix &aMc);
 
 #if defined(VISP_BUILD_DEPRECATED_FUNCTIONS)
   /*!
@@ -250,6 +251,11 @@ public:
   vp_deprecated void setIdentity();
 //@}
 #endif
+
+private:
+  // Elements and row pointers of the fixed-size storage, see vpArray2D
+  double m_fixedData[16];
+  double *m_fixedRowPtrs[4];
 };
 
 #endif
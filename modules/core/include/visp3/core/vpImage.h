@@ -47,9 +47,11 @@
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpDebug.h>
 #include <visp3/core/vpException.h>
+#include <visp3/core/vpImageAllocator.h>
 #include <visp3/core/vpImageException.h>
 #include <visp3/core/vpImagePoint.h>
 #include <visp3/core/vpRGBa.h>
+#include <visp3/core/vpThreadPool.h>
 #if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
 #include <visp3/core/vpThread.h>
 #endif
@@ -58,6 +60,7 @@
 #include <iomanip> // std::setw
 #include <iostream>
 #include <math.h>
+#include <new>
 #include <string.h>
 
 // Visual Studio 2010 or previous is missing inttypes.h
@@ -94,6 +97,13 @@ class vpDisplay;
   if i is the ith rows and j the jth columns the value of this pixel
   is given by I[i][j] (that is equivalent to row[i][j]).
 
+  The bitmap is obtained from a vpImageAllocator. By default, it is aligned
+  on vpImageAllocator::alignment bytes. A vpImageBufferPool given to
+  setAllocator(), or installed with vpImageAllocator::setDefault(), recycles
+  the bitmaps of the images of a processing loop instead of allocating them
+  for each frame. The size of an image is kept when it is assigned another
+  image of the same size, so that its bitmap is reused.
+
   <h3>Example</h3>
   The following example available in tutorial-image-manipulation.cpp shows how
   to create gray level and color images and how to access to the pixels.
@@ -175,6 +185,15 @@ public:
     \sa getWidth()
    */
   inline unsigned int getCols() const { return width; }
+  /*!
+    Get the allocator of the bitmap.
+
+    \return The allocator given to setAllocator(), the default allocator
+    the bitmap was obtained from, or NULL if the image has never been
+    allocated.
+   */
+  inline vpImageAllocator *getAllocator() const { return allocator; }
+
   /*!
     Get the image height.
 
@@ -316,7 +335,11 @@ public:
   vpImage<Type> operator-(const vpImage<Type> &B);
 
   //! Copy operator
-  vpImage<Type> &operator=(vpImage<Type> other);
+  vpImage<Type> &operator=(const vpImage<Type> &other);
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  //! Move operator
+  vpImage<Type> &operator=(vpImage<Type> &&other);
+#endif
 
   vpImage<Type> &operator=(const Type &v);
   bool operator==(const vpImage<Type> &I);
@@ -338,6 +361,8 @@ public:
   // set the size of the image and initialize it.
   void resize(const unsigned int h, const unsigned int w, const Type &val);
 
+  void setAllocator(vpImageAllocator *allocator);
+
   void sub(const vpImage<Type> &B, vpImage<Type> &C);
   void sub(const vpImage<Type> &A, const vpImage<Type> &B, vpImage<Type> &C);
   void subsample(unsigned int v_scale, unsigned int h_scale, vpImage<Type> &sampled) const;
@@ -347,11 +372,15 @@ public:
   //@}
 
 private:
+  void allocateBitmap();
+  void releaseBitmap();
+
   unsigned int npixels; ///! number of pixel in the image
   unsigned int width;   ///! number of columns
   unsigned int height;  ///! number of rows
   Type **row;           ///! points the row pointer array
   bool hasOwnership;    ///! true if this instance owns the bitmap, false otherwise (e.g. copyData=false)
+  vpImageAllocator *allocator; ///! allocator of the bitmap when hasOwnership is true
 };
 
 template <class Type> std::ostream &operator<<(std::ostream &s, const vpImage<Type> &I)
@@ -483,145 +512,88 @@ inline std::ostream &operator<<(std::ostream &s, const vpImage<double> &I)
   return s;
 }
 
-#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
 namespace
 {
-struct ImageLut_Param_t {
-  unsigned int m_start_index;
-  unsigned int m_end_index;
-
-  unsigned char m_lut[256];
-  unsigned char *m_bitmap;
-
-  ImageLut_Param_t() : m_start_index(0), m_end_index(0), m_lut(), m_bitmap(NULL) {}
-
-  ImageLut_Param_t(const unsigned int start_index, const unsigned int end_index, unsigned char *bitmap)
-    : m_start_index(start_index), m_end_index(end_index), m_lut(), m_bitmap(bitmap)
-  {
-  }
-};
-
-vpThread::Return performLutThread(vpThread::Args args)
+class vpImageLutBody : public vpParallelForBody
 {
-  ImageLut_Param_t *imageLut_param = static_cast<ImageLut_Param_t *>(args);
-  unsigned int start_index = imageLut_param->m_start_index;
-  unsigned int end_index = imageLut_param->m_end_index;
-
-  unsigned char *bitmap = imageLut_param->m_bitmap;
-
-  unsigned char *ptrStart = bitmap + start_index;
-  unsigned char *ptrEnd = bitmap + end_index;
-  unsigned char *ptrCurrent = ptrStart;
+public:
+  vpImageLutBody(const unsigned char (&lut)[256], unsigned char *bitmap) : m_lut(lut), m_bitmap(bitmap) {}
 
-  //    while(ptrCurrent != ptrEnd) {
-  //      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent];
-  //      ++ptrCurrent;
-  //    }
+  void operator()(int begin, int end)
+  {
+    unsigned char *ptrCurrent = m_bitmap + begin;
+    unsigned char *ptrEnd = m_bitmap + end;
 
-  if (end_index - start_index >= 8) {
-    // Unroll loop version
-    for (; ptrCurrent <= ptrEnd - 8;) {
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent];
-      ++ptrCurrent;
+    if (end - begin >= 8) {
+      // Unroll loop version
+      for (; ptrCurrent <= ptrEnd - 8;) {
+        *ptrCurrent = m_lut[*ptrCurrent];
+        ++ptrCurrent;
 
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent];
-      ++ptrCurrent;
+        *ptrCurrent = m_lut[*ptrCurrent];
+        ++ptrCurrent;
 
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent];
-      ++ptrCurrent;
+        *ptrCurrent = m_lut[*ptrCurrent];
+        ++ptrCurrent;
 
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent];
-      ++ptrCurrent;
+        *ptrCurrent = m_lut[*ptrCurrent];
+        ++ptrCurrent;
 
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent];
-      ++ptrCurrent;
+        *ptrCurrent = m_lut[*ptrCurrent];
+        ++ptrCurrent;
 
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent];
-      ++ptrCurrent;
+        *ptrCurrent = m_lut[*ptrCurrent];
+        ++ptrCurrent;
 
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent];
-      ++ptrCurrent;
+        *ptrCurrent = m_lut[*ptrCurrent];
+        ++ptrCurrent;
 
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent];
-      ++ptrCurrent;
+        *ptrCurrent = m_lut[*ptrCurrent];
+        ++ptrCurrent;
+      }
     }
-  }
 
-  for (; ptrCurrent != ptrEnd; ++ptrCurrent) {
-    *ptrCurrent = imageLut_param->m_lut[*ptrCurrent];
+    for (; ptrCurrent != ptrEnd; ++ptrCurrent) {
+      *ptrCurrent = m_lut[*ptrCurrent];
+    }
   }
 
-  return 0;
-}
-
-struct ImageLutRGBa_Param_t {
-  unsigned int m_start_index;
-  unsigned int m_end_index;
-
-  vpRGBa m_lut[256];
+private:
+  const unsigned char (&m_lut)[256];
   unsigned char *m_bitmap;
-
-  ImageLutRGBa_Param_t() : m_start_index(0), m_end_index(0), m_lut(), m_bitmap(NULL) {}
-
-  ImageLutRGBa_Param_t(const unsigned int start_index, const unsigned int end_index, unsigned char *bitmap)
-    : m_start_index(start_index), m_end_index(end_index), m_lut(), m_bitmap(bitmap)
-  {
-  }
 };
 
-vpThread::Return performLutRGBaThread(vpThread::Args args)
+class vpImageLutRGBaBody : public vpParallelForBody
 {
-  ImageLutRGBa_Param_t *imageLut_param = static_cast<ImageLutRGBa_Param_t *>(args);
-  unsigned int start_index = imageLut_param->m_start_index;
-  unsigned int end_index = imageLut_param->m_end_index;
-
-  unsigned char *bitmap = imageLut_param->m_bitmap;
+public:
+  vpImageLutRGBaBody(const vpRGBa (&lut)[256], unsigned char *bitmap) : m_lut(lut), m_bitmap(bitmap) {}
 
-  unsigned char *ptrStart = bitmap + start_index * 4;
-  unsigned char *ptrEnd = bitmap + end_index * 4;
-  unsigned char *ptrCurrent = ptrStart;
+  // begin and end are pixel indexes
+  void operator()(int begin, int end)
+  {
+    unsigned char *ptrCurrent = m_bitmap + 4 * begin;
+    unsigned char *ptrEnd = m_bitmap + 4 * end;
 
-  if (end_index - start_index >= 4 * 2) {
-    // Unroll loop version
-    for (; ptrCurrent <= ptrEnd - 4 * 2;) {
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent].R;
-      ptrCurrent++;
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent].G;
-      ptrCurrent++;
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent].B;
-      ptrCurrent++;
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent].A;
+    while (ptrCurrent != ptrEnd) {
+      *ptrCurrent = m_lut[*ptrCurrent].R;
       ptrCurrent++;
 
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent].R;
+      *ptrCurrent = m_lut[*ptrCurrent].G;
       ptrCurrent++;
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent].G;
-      ptrCurrent++;
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent].B;
+
+      *ptrCurrent = m_lut[*ptrCurrent].B;
       ptrCurrent++;
-      *ptrCurrent = imageLut_param->m_lut[*ptrCurrent].A;
+
+      *ptrCurrent = m_lut[*ptrCurrent].A;
       ptrCurrent++;
     }
   }
 
-  while (ptrCurrent != ptrEnd) {
-    *ptrCurrent = imageLut_param->m_lut[*ptrCurrent].R;
-    ptrCurrent++;
-
-    *ptrCurrent = imageLut_param->m_lut[*ptrCurrent].G;
-    ptrCurrent++;
-
-    *ptrCurrent = imageLut_param->m_lut[*ptrCurrent].B;
-    ptrCurrent++;
-
-    *ptrCurrent = imageLut_param->m_lut[*ptrCurrent].A;
-    ptrCurrent++;
-  }
-
-  return 0;
-}
+private:
+  const vpRGBa (&m_lut)[256];
+  unsigned char *m_bitmap;
+};
 }
-#endif
 
 /*!
   \brief Image initialisation
@@ -675,10 +647,7 @@ template <class Type> void vpImage<Type>::init(unsigned int h, unsigned int w)
   if ((h != this->height) || (w != this->width)) {
     if (bitmap != NULL) {
       vpDEBUG_TRACE(10, "Destruction bitmap[]");
-      if (hasOwnership) {
-        delete[] bitmap;
-      }
-      bitmap = NULL;
+      releaseBitmap();
     }
   }
 
@@ -688,7 +657,7 @@ template <class Type> void vpImage<Type>::init(unsigned int h, unsigned int w)
   npixels = width * height;
 
   if (bitmap == NULL) {
-    bitmap = new Type[npixels];
+    allocateBitmap();
     hasOwnership = true;
   }
 
@@ -730,12 +699,10 @@ void vpImage<Type>::init(Type *const array, const unsigned int h, const unsigned
   }
 
   // Delete bitmap if copyData==false, otherwise only if the dimension differs
-  if ((copyData && ((h != this->height) || (w != this->width))) || !copyData) {
+  // or if the bitmap belongs to the caller
+  if ((copyData && ((h != this->height) || (w != this->width) || !hasOwnership)) || !copyData) {
     if (bitmap != NULL) {
-      if (hasOwnership) {
-        delete[] bitmap;
-      }
-      bitmap = NULL;
+      releaseBitmap();
     }
   }
 
@@ -747,7 +714,7 @@ void vpImage<Type>::init(Type *const array, const unsigned int h, const unsigned
 
   if (copyData) {
     if (bitmap == NULL)
-      bitmap = new Type[npixels];
+      allocateBitmap();
 
     if (bitmap == NULL) {
       throw(vpException(vpException::memoryAllocationError, "cannot allocate bitmap "));
@@ -791,7 +758,7 @@ void vpImage<Type>::init(Type *const array, const unsigned int h, const unsigned
 */
 template <class Type>
 vpImage<Type>::vpImage(unsigned int h, unsigned int w)
-  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true), allocator(NULL)
 {
   init(h, w, 0);
 }
@@ -815,7 +782,7 @@ vpImage<Type>::vpImage(unsigned int h, unsigned int w)
 */
 template <class Type>
 vpImage<Type>::vpImage(unsigned int h, unsigned int w, Type value)
-  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true), allocator(NULL)
 {
   init(h, w, value);
 }
@@ -837,7 +804,7 @@ vpImage<Type>::vpImage(unsigned int h, unsigned int w, Type value)
 */
 template <class Type>
 vpImage<Type>::vpImage(Type *const array, const unsigned int h, const unsigned int w, const bool copyData)
-  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true), allocator(NULL)
 {
   init(array, h, w, copyData);
 }
@@ -852,7 +819,7 @@ vpImage<Type>::vpImage(Type *const array, const unsigned int h, const unsigned i
   \sa vpImage::resize(height, width) for memory allocation
 */
 template <class Type> vpImage<Type>::vpImage() :
-  bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true)
+  bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true), allocator(NULL)
 {
 }
 
@@ -912,10 +879,7 @@ template <class Type> void vpImage<Type>::destroy()
   if (bitmap != NULL) {
     //  vpERROR_TRACE("Deallocate bitmap memory %p",bitmap);
     //    vpDEBUG_TRACE(20,"Deallocate bitmap memory %p",bitmap);
-    if (hasOwnership) {
-      delete[] bitmap;
-    }
-    bitmap = NULL;
+    releaseBitmap();
   }
 
   if (row != NULL) {
@@ -939,7 +903,7 @@ template <class Type> vpImage<Type>::~vpImage() { destroy(); }
 */
 template <class Type>
 vpImage<Type>::vpImage(const vpImage<Type> &I)
-  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true), allocator(NULL)
 {
   resize(I.getHeight(), I.getWidth());
   memcpy(static_cast<void*>(bitmap), static_cast<void*>(I.bitmap), I.npixels * sizeof(Type));
@@ -951,7 +915,8 @@ vpImage<Type>::vpImage(const vpImage<Type> &I)
 */
 template <class Type>
 vpImage<Type>::vpImage(vpImage<Type> &&I)
-  : bitmap(I.bitmap), display(I.display), npixels(I.npixels), width(I.width), height(I.height), row(I.row), hasOwnership(I.hasOwnership)
+  : bitmap(I.bitmap), display(I.display), npixels(I.npixels), width(I.width), height(I.height), row(I.row),
+    hasOwnership(I.hasOwnership), allocator(I.allocator)
 {
   I.bitmap = NULL;
   I.display = NULL;
@@ -960,6 +925,7 @@ vpImage<Type>::vpImage(vpImage<Type> &&I)
   I.height = 0;
   I.row = NULL;
   I.hasOwnership = false;
+  I.allocator = NULL;
 }
 #endif
 
@@ -1087,20 +1053,54 @@ void vpImage<Type>::getMinMaxLoc(vpImagePoint *minLoc, vpImagePoint *maxLoc, Typ
 
 /*!
   \brief Copy operator
+
+  The bitmap is reused when the image already has the size of \e other and
+  owns its bitmap. The display attached to the image, if any, is kept.
 */
-template <class Type> vpImage<Type> &vpImage<Type>::operator=(vpImage<Type> other)
+template <class Type> vpImage<Type> &vpImage<Type>::operator=(const vpImage<Type> &other)
 {
-  swap(*this, other);
-  // Swap back display pointer if it was not null
-  // vpImage<unsigned char> I2(480, 640);
-  // vpDisplayX d(I2);
-  // I2 = I1; //copy only the data
-  if (other.display != NULL)
-    display = other.display;
+  if (this == &other) {
+    return *this;
+  }
+
+  if (other.bitmap == NULL) {
+    destroy();
+    npixels = 0;
+    width = 0;
+    height = 0;
+    return *this;
+  }
+
+  if (!hasOwnership) {
+    // Do not write into an array that belongs to the caller
+    destroy();
+  }
+  resize(other.height, other.width);
+  memcpy(static_cast<void *>(bitmap), static_cast<void *>(other.bitmap), npixels * sizeof(Type));
 
   return *this;
 }
 
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+/*!
+  \brief Move operator
+
+  The image takes the bitmap of \e other. The display attached to the image,
+  if any, is kept.
+*/
+template <class Type> vpImage<Type> &vpImage<Type>::operator=(vpImage<Type> &&other)
+{
+  if (this != &other) {
+    swap(*this, other);
+    // Swap back display pointer if it was not null
+    if (other.display != NULL)
+      display = other.display;
+  }
+
+  return *this;
+}
+#endif
+
 /*!
   \brief = operator : Set all the element of the bitmap to a given  value \e
   v. \f$ A = v <=> A[i][j] = v \f$
@@ -1738,76 +1738,20 @@ template <class Type> void vpImage<Type>::performLut(const Type (&)[256], const
   in parameter.
 
   \param lut : Look-up table (unsigned char array of size=256) which maps each
-  intensity to his new value. \param nbThreads : Number of threads to use for
-  the computation.
+  intensity to his new value. \param nbThreads : Maximum number of threads
+  of vpThreadPool to use for the computation.
 */
 template <>
 inline void vpImage<unsigned char>::performLut(const unsigned char (&lut)[256], const unsigned int nbThreads)
 {
-  unsigned int size = getWidth() * getHeight();
-  unsigned char *ptrStart = (unsigned char *)bitmap;
-  unsigned char *ptrEnd = ptrStart + size;
-  unsigned char *ptrCurrent = ptrStart;
-
-  bool use_single_thread = (nbThreads == 0 || nbThreads == 1);
-#if !defined(VISP_HAVE_PTHREAD) && !defined(_WIN32)
-  use_single_thread = true;
-#endif
+  vpImageLutBody body(lut, bitmap);
 
-  if (!use_single_thread && getSize() <= nbThreads) {
-    use_single_thread = true;
-  }
-
-  if (use_single_thread) {
+  if (nbThreads == 0 || nbThreads == 1) {
     // Single thread
-
-    while (ptrCurrent != ptrEnd) {
-      *ptrCurrent = lut[*ptrCurrent];
-      ++ptrCurrent;
-    }
+    body(0, (int)getSize());
   } else {
-#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
-    // Multi-threads
-
-    std::vector<vpThread *> threadpool;
-    std::vector<ImageLut_Param_t *> imageLutParams;
-
-    unsigned int image_size = getSize();
-    unsigned int step = image_size / nbThreads;
-    unsigned int last_step = image_size - step * (nbThreads - 1);
-
-    for (unsigned int index = 0; index < nbThreads; index++) {
-      unsigned int start_index = index * step;
-      unsigned int end_index = (index + 1) * step;
-
-      if (index == nbThreads - 1) {
-        end_index = start_index + last_step;
-      }
-
-      ImageLut_Param_t *imageLut_param = new ImageLut_Param_t(start_index, end_index, bitmap);
-      memcpy(imageLut_param->m_lut, lut, 256 * sizeof(unsigned char));
-
-      imageLutParams.push_back(imageLut_param);
-
-      // Start the threads
-      vpThread *imageLut_thread = new vpThread((vpThread::Fn)performLutThread, (vpThread::Args)imageLut_param);
-      threadpool.push_back(imageLut_thread);
-    }
-
-    for (size_t cpt = 0; cpt < threadpool.size(); cpt++) {
-      // Wait until thread ends up
-      threadpool[cpt]->join();
-    }
-
-    // Delete
-    for (size_t cpt = 0; cpt < threadpool.size(); cpt++) {
-      delete threadpool[cpt];
-    }
-
-    for (size_t cpt = 0; cpt < imageLutParams.size(); cpt++) {
-      delete imageLutParams[cpt];
-    }
-#endif
+    // Multi-threads, on the workers of the process-wide pool
+    vpThreadPool::instance().parallel_for(0, (int)getSize(), body, 1 << 16, nbThreads);
   }
 }
 
@@ -1816,83 +1760,96 @@ inline void vpImage<unsigned char>::performLut(const unsigned char (&lut)[256],
   parameter.
 
   \param lut : Look-up table (vpRGBa array of size=256) which maps each
-  intensity to his new value. \param nbThreads : Number of threads to use for
-  the computation.
+  intensity to his new value. \param nbThreads : Maximum number of threads
+  of vpThreadPool to use for the computation.
 */
 template <> inline void vpImage<vpRGBa>::performLut(const vpRGBa (&lut)[256], const unsigned int nbThreads)
 {
-  unsigned int size = getWidth() * getHeight();
-  unsigned char *ptrStart = (unsigned char *)bitmap;
-  unsigned char *ptrEnd = ptrStart + size * 4;
-  unsigned char *ptrCurrent = ptrStart;
-
-  bool use_single_thread = (nbThreads == 0 || nbThreads == 1);
-#if !defined(VISP_HAVE_PTHREAD) && !defined(_WIN32)
-  use_single_thread = true;
-#endif
+  vpImageLutRGBaBody body(lut, (unsigned char *)bitmap);
 
-  if (!use_single_thread && getSize() <= nbThreads) {
-    use_single_thread = true;
-  }
-
-  if (use_single_thread) {
+  if (nbThreads == 0 || nbThreads == 1) {
     // Single thread
-    while (ptrCurrent != ptrEnd) {
-      *ptrCurrent = lut[*ptrCurrent].R;
-      ++ptrCurrent;
-
-      *ptrCurrent = lut[*ptrCurrent].G;
-      ++ptrCurrent;
-
-      *ptrCurrent = lut[*ptrCurrent].B;
-      ++ptrCurrent;
-
-      *ptrCurrent = lut[*ptrCurrent].A;
-      ++ptrCurrent;
-    }
+    body(0, (int)getSize());
   } else {
-#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
-    // Multi-threads
-    std::vector<vpThread *> threadpool;
-    std::vector<ImageLutRGBa_Param_t *> imageLutParams;
+    // Multi-threads, on the workers of the process-wide pool
+    vpThreadPool::instance().parallel_for(0, (int)getSize(), body, 1 << 14, nbThreads);
+  }
+}
 
-    unsigned int image_size = getSize();
-    unsigned int step = image_size / nbThreads;
-    unsigned int last_step = image_size - step * (nbThreads - 1);
+/*!
+  Set the allocator the bitmap is obtained from. If the image owns a bitmap,
+  its pixels are moved to a bitmap obtained from \e allocator.
 
-    for (unsigned int index = 0; index < nbThreads; index++) {
-      unsigned int start_index = index * step;
-      unsigned int end_index = (index + 1) * step;
+  \param allocator : Allocator, for instance a vpImageBufferPool, that must
+  outlive the image. NULL selects the current default allocator returned by
+  vpImageAllocator::getDefault().
 
-      if (index == nbThreads - 1) {
-        end_index = start_index + last_step;
-      }
+  \exception vpException::memoryAllocationError
+*/
+template <class Type> void vpImage<Type>::setAllocator(vpImageAllocator *allocator)
+{
+  if (allocator == NULL) {
+    allocator = vpImageAllocator::getDefault();
+  }
+  if (allocator == this->allocator) {
+    return;
+  }
 
-      ImageLutRGBa_Param_t *imageLut_param = new ImageLutRGBa_Param_t(start_index, end_index, (unsigned char *)bitmap);
-      memcpy(imageLut_param->m_lut, lut, 256 * sizeof(vpRGBa));
+  if (bitmap == NULL || !hasOwnership || this->allocator == NULL) {
+    this->allocator = allocator;
+    return;
+  }
 
-      imageLutParams.push_back(imageLut_param);
+  Type *previousBitmap = bitmap;
+  vpImageAllocator *previousAllocator = this->allocator;
+  this->allocator = allocator;
+  allocateBitmap();
+  memcpy(static_cast<void *>(bitmap), static_cast<void *>(previousBitmap), npixels * sizeof(Type));
+  for (unsigned int i = 0; i < height; i++) {
+    row[i] = bitmap + i * width;
+  }
 
-      // Start the threads
-      vpThread *imageLut_thread = new vpThread((vpThread::Fn)performLutRGBaThread, (vpThread::Args)imageLut_param);
-      threadpool.push_back(imageLut_thread);
-    }
+  for (unsigned int i = 0; i < npixels; i++) {
+    previousBitmap[i].~Type();
+  }
+  previousAllocator->deallocate(previousBitmap, (size_t)npixels * sizeof(Type));
+}
 
-    for (size_t cpt = 0; cpt < threadpool.size(); cpt++) {
-      // Wait until thread ends up
-      threadpool[cpt]->join();
-    }
+/*!
+  Obtain a bitmap of npixels elements from the allocator and construct its
+  elements.
 
-    // Delete
-    for (size_t cpt = 0; cpt < threadpool.size(); cpt++) {
-      delete threadpool[cpt];
-    }
+  \exception vpException::memoryAllocationError
+*/
+template <class Type> void vpImage<Type>::allocateBitmap()
+{
+  if (allocator == NULL) {
+    allocator = vpImageAllocator::getDefault();
+  }
+  void *ptr = allocator->allocate((size_t)npixels * sizeof(Type));
+  if (ptr == NULL) {
+    throw(vpException(vpException::memoryAllocationError, "cannot allocate bitmap "));
+  }
 
-    for (size_t cpt = 0; cpt < imageLutParams.size(); cpt++) {
-      delete imageLutParams[cpt];
+  bitmap = static_cast<Type *>(ptr);
+  for (unsigned int i = 0; i < npixels; i++) {
+    new (bitmap + i) Type;
+  }
+}
+
+/*!
+  Give the bitmap back to its allocator if the image owns it, and forget it.
+  npixels must still be the number of elements of the bitmap.
+*/
+template <class Type> void vpImage<Type>::releaseBitmap()
+{
+  if (hasOwnership && allocator != NULL) {
+    for (unsigned int i = 0; i < npixels; i++) {
+      bitmap[i].~Type();
     }
-#endif
+    allocator->deallocate(bitmap, (size_t)npixels * sizeof(Type));
   }
+  bitmap = NULL;
 }
 
 template <class Type> void swap(vpImage<Type> &first, vpImage<Type> &second)
@@ -1904,6 +1861,8 @@ template <class Type> void swap(vpImage<Type> &first, vpImage<Type> &second)
   swap(first.width, second.width);
   swap(first.height, second.height);
   swap(first.row, second.row);
+  swap(first.hasOwnership, second.hasOwnership);
+  swap(first.allocator, second.allocator);
 }
 
 #endif
@@ -0,0 +1,98 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Memory allocation policy of the image bitmaps.
+ *
+ *****************************************************************************/
+
+#ifndef _vpImageAllocator_h_
+#define _vpImageAllocator_h_
+
+/*!
+  \file vpImageAllocator.h
+  \brief Memory allocation policy of the image bitmaps.
+*/
+
+#include <stddef.h>
+
+#include <visp3/core/vpConfig.h>
+
+/*!
+  \class vpImageAllocator
+
+  \ingroup group_core_image
+
+  Interface of the objects that provide the memory of the vpImage bitmaps.
+
+  An image asks its allocator for raw memory each time its bitmap needs to
+  be (re)allocated and gives the memory back with the same size when the
+  bitmap is released. Unless vpImage::setAllocator() is used, an image uses
+  the process-wide default allocator returned by getDefault() at the time of
+  its first allocation. Out of the box, the default allocator returns
+  blocks aligned on alignment bytes, so that the first pixel of every image
+  can be read with aligned vector loads.
+
+  An allocator must outlive all the images that use it.
+
+  \sa vpImageBufferPool
+*/
+class VISP_EXPORT vpImageAllocator
+{
+public:
+  //! Alignment in bytes of the memory returned by alignedMalloc()
+  static const size_t alignment = 64;
+
+  virtual ~vpImageAllocator() {}
+
+  /*!
+    Allocate a block of \e size bytes aligned on alignment bytes.
+
+    \return The address of the block, or NULL when the memory cannot be
+    allocated.
+  */
+  virtual void *allocate(size_t size) = 0;
+  /*!
+    Release a block returned by allocate().
+
+    \param ptr : Address of the block.
+    \param size : Size given to allocate() for this block.
+  */
+  virtual void deallocate(void *ptr, size_t size) = 0;
+
+  static void *alignedMalloc(size_t size);
+  static void alignedFree(void *ptr);
+
+  static vpImageAllocator *getDefault();
+  static void setDefault(vpImageAllocator *allocator);
+};
+
+#endif
@@ -0,0 +1,112 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Pool of image buffers recycled between frames.
+ *
+ *****************************************************************************/
+
+#ifndef _vpImageBufferPool_h_
+#define _vpImageBufferPool_h_
+
+/*!
+  \file vpImageBufferPool.h
+  \brief Pool of image buffers recycled between frames.
+*/
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImageAllocator.h>
+
+/*!
+  \class vpImageBufferPool
+
+  \ingroup group_core_image
+
+  Image allocator that keeps the bitmaps released by the images instead of
+  freeing them, and gives them back to the next images of the same size.
+
+  In a capture and processing loop, the frames and the intermediate images
+  have the same few sizes from one iteration to the next. Recycling their
+  memory avoids the calls to malloc() and free(), and the page faults that
+  follow each new allocation of a large block.
+
+  The pool can be given to a few images with vpImage::setAllocator(), or
+  installed as the default allocator of all the images with
+  vpImageAllocator::setDefault(). The blocks are aligned on
+  vpImageAllocator::alignment bytes. When the size of the cached blocks
+  would exceed getMaxCachedBytes(), the released blocks are freed instead.
+  With C++11 support, the pool can be shared by images of several threads.
+
+  The pool must outlive all the images that use it.
+
+  \code
+#include <visp3/core/vpImageBufferPool.h>
+
+int main()
+{
+  vpImageBufferPool pool;
+  vpImageAllocator::setDefault(&pool);
+  {
+    for (int frame = 0; frame < 100; frame++) {
+      vpImage<unsigned char> I(480, 640); // Recycled from the second frame
+      // Acquire and process I
+    }
+  }
+  vpImageAllocator::setDefault(NULL);
+}
+  \endcode
+*/
+class VISP_EXPORT vpImageBufferPool : public vpImageAllocator
+{
+public:
+  explicit vpImageBufferPool(size_t maxCachedBytes = 256 * 1024 * 1024);
+  virtual ~vpImageBufferPool();
+
+  void *allocate(size_t size);
+  void clear();
+  void deallocate(void *ptr, size_t size);
+
+  size_t getCachedBytes() const;
+  size_t getMaxCachedBytes() const;
+  unsigned int getNbAllocations() const;
+  unsigned int getNbReuses() const;
+
+  void setMaxCachedBytes(size_t maxCachedBytes);
+
+private:
+  vpImageBufferPool(const vpImageBufferPool &);
+  vpImageBufferPool &operator=(const vpImageBufferPool &);
+
+  class Impl;
+  Impl *m_impl;
+};
+
+#endif
@@ -52,6 +52,7 @@
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpDebug.h>
 #include <visp3/core/vpImage.h>
+#include <visp3/core/vpImageView.h>
 // color
 #include <visp3/core/vpRGBa.h>
 
@@ -107,10 +108,30 @@ class VISP_EXPORT vpImageConvert
 {
 
 public:
+  /*!
+    Arrangement of the color filters of a Bayer sensor, named after the
+    colors of the 2x2 top-left pixels read row by row.
+  */
+  enum vpBayerPatternType {
+    BAYER_BGGR, /*!< First row: blue, green. Second row: green, red. */
+    BAYER_GBRG, /*!< First row: green, blue. Second row: red, green. */
+    BAYER_GRBG, /*!< First row: green, red. Second row: blue, green. */
+    BAYER_RGGB  /*!< First row: red, green. Second row: green, blue. */
+  };
+
+  /*!
+    Interpolation used to reconstruct the missing colors of a Bayer image.
+  */
+  enum vpDemosaicMethodType {
+    DEMOSAIC_BILINEAR,  /*!< Average of the nearest pixels of the same color (fastest). */
+    DEMOSAIC_EDGE_AWARE /*!< Green interpolated along the edges, then red and blue from the color differences. */
+  };
+
   static void createDepthHistogram(const vpImage<uint16_t> &src_depth, vpImage<vpRGBa> &dest_rgba);
   static void createDepthHistogram(const vpImage<uint16_t> &src_depth, vpImage<unsigned char> &dest_depth);
   static void convert(const vpImage<unsigned char> &src, vpImage<vpRGBa> &dest);
   static void convert(const vpImage<vpRGBa> &src, vpImage<unsigned char> &dest);
+  static void convert(const vpImageView<vpRGBa> &src, vpImage<unsigned char> &dest);
 
   static void convert(const vpImage<float> &src, vpImage<unsigned char> &dest);
   static void convert(const vpImage<unsigned char> &src, vpImage<float> &dest);
@@ -245,6 +266,15 @@ public:
   static void YCrCbToRGBa(unsigned char *ycbcr, unsigned char *rgb, unsigned int size);
   static void YCbCrToGrey(unsigned char *ycbcr, unsigned char *grey, unsigned int size);
   static void MONO16ToGrey(unsigned char *grey16, unsigned char *grey, unsigned int size);
+
+  static void BayerToRGBa(const unsigned char *bayer, unsigned char *rgba, unsigned int width, unsigned int height,
+                          vpBayerPatternType pattern, vpDemosaicMethodType method = DEMOSAIC_BILINEAR);
+  static void BayerToRGBa(const uint16_t *bayer, unsigned char *rgba, unsigned int width, unsigned int height,
+                          vpBayerPatternType pattern, vpDemosaicMethodType method = DEMOSAIC_BILINEAR,
+                          unsigned int bitDepth = 16);
+  static void BayerToGrey(const unsigned char *bayer, unsigned char *grey, unsigned int width, unsigned int height);
+  static void BayerToGrey(const uint16_t *bayer, unsigned char *grey, unsigned int width, unsigned int height,
+                          unsigned int bitDepth = 16);
   static void MONO16ToRGBa(unsigned char *grey16, unsigned char *rgba, unsigned int size);
 
   static void HSVToRGBa(const double *hue, const double *saturation, const double *value, unsigned char *rgba,
@@ -272,6 +302,8 @@ private:
                       const unsigned int size, const unsigned int step);
   static void RGB2HSV(const unsigned char *rgb, double *hue, double *saturation, double *value, const unsigned int size,
                       const unsigned int step);
+  static void RGB2HSV(const unsigned char *rgb, unsigned char *hue, unsigned char *saturation, unsigned char *value,
+                      const unsigned int size, const unsigned int step);
 
 private:
   static bool YCbCrLUTcomputed;
@@ -47,6 +47,7 @@
 
 #include <visp3/core/vpImage.h>
 #include <visp3/core/vpImageException.h>
+#include <visp3/core/vpImageView.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpMatrix.h>
 #include <visp3/core/vpRGBa.h>
@@ -166,6 +167,8 @@ public:
 
   static void filter(const vpImage<unsigned char> &I, vpImage<double> &GI, const double *filter, unsigned int size);
   static void filter(const vpImage<double> &I, vpImage<double> &GI, const double *filter, unsigned int size);
+  static void filter(const vpImage<unsigned char> &I, vpImage<float> &GI, const float *filter, unsigned int size);
+  static void filter(const vpImage<float> &I, vpImage<float> &GI, const float *filter, unsigned int size);
 
   static inline unsigned char filterGaussXPyramidal(const vpImage<unsigned char> &I, unsigned int i, unsigned int j)
   {
@@ -180,6 +183,12 @@ public:
 
   static void filterX(const vpImage<unsigned char> &I, vpImage<double> &dIx, const double *filter, unsigned int size);
   static void filterX(const vpImage<double> &I, vpImage<double> &dIx, const double *filter, unsigned int size);
+  static void filterX(const vpImage<unsigned char> &I, vpImage<float> &dIx, const float *filter, unsigned int size);
+  static void filterX(const vpImage<float> &I, vpImage<float> &dIx, const float *filter, unsigned int size);
+  static void filterX(const vpImageView<unsigned char> &I, vpImage<double> &dIx, const double *filter,
+                      unsigned int size);
+  static void filterX(const vpImageView<unsigned char> &I, vpImage<float> &dIx, const float *filter,
+                      unsigned int size);
   static void filterX(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &dIx, const double *filter, unsigned int size);
   static void filterXR(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &dIx, const double *filter, unsigned int size);
   static void filterXG(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &dIx, const double *filter, unsigned int size);
@@ -416,6 +425,12 @@ public:
   static void filterYG(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &dIx, const double *filter, unsigned int size);
   static void filterYB(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &dIx, const double *filter, unsigned int size);
   static void filterY(const vpImage<double> &I, vpImage<double> &dIx, const double *filter, unsigned int size);
+  static void filterY(const vpImage<unsigned char> &I, vpImage<float> &dIy, const float *filter, unsigned int size);
+  static void filterY(const vpImage<float> &I, vpImage<float> &dIy, const float *filter, unsigned int size);
+  static void filterY(const vpImageView<unsigned char> &I, vpImage<double> &dIy, const double *filter,
+                      unsigned int size);
+  static void filterY(const vpImageView<unsigned char> &I, vpImage<float> &dIy, const float *filter,
+                      unsigned int size);
   static inline double filterY(const vpImage<unsigned char> &I, unsigned int r, unsigned int c, const double *filter,
                                unsigned int size)
   {
@@ -645,6 +660,16 @@ public:
                            double sigma = 0., bool normalize = true);
   static void gaussianBlur(const vpImage<double> &I, vpImage<double> &GI, unsigned int size = 7, double sigma = 0.,
                            bool normalize = true);
+  static void gaussianBlur(const vpImage<unsigned char> &I, vpImage<float> &GI, unsigned int size = 7,
+                           double sigma = 0., bool normalize = true);
+  static void gaussianBlur(const vpImage<unsigned char> &I, vpImage<unsigned char> &GI, unsigned int size = 7,
+                           double sigma = 0.);
+  static void gaussianBlur(const vpImageView<unsigned char> &I, vpImage<double> &GI, unsigned int size = 7,
+                           double sigma = 0., bool normalize = true);
+  static void gaussianBlur(const vpImageView<unsigned char> &I, vpImage<float> &GI, unsigned int size = 7,
+                           double sigma = 0., bool normalize = true);
+  static void gaussianBlur(const vpImageView<unsigned char> &I, vpImage<unsigned char> &GI, unsigned int size = 7,
+                           double sigma = 0.);
   /*!
    Apply a 5x5 Gaussian filter to an image pixel.
 
@@ -676,6 +701,8 @@ public:
   static void getGradX(const vpImage<unsigned char> &I, vpImage<double> &dIx);
   static void getGradX(const vpImage<unsigned char> &I, vpImage<double> &dIx, const double *filter, unsigned int size);
   static void getGradX(const vpImage<double> &I, vpImage<double> &dIx, const double *filter, unsigned int size);
+  static void getGradX(const vpImageView<unsigned char> &I, vpImage<double> &dIx, const double *filter,
+                       unsigned int size);
   static void getGradXGauss2D(const vpImage<unsigned char> &I, vpImage<double> &dIx, const double *gaussianKernel,
                               const double *gaussianDerivativeKernel, unsigned int size);
 
@@ -683,6 +710,8 @@ public:
   static void getGradY(const vpImage<unsigned char> &I, vpImage<double> &dIy);
   static void getGradY(const vpImage<unsigned char> &I, vpImage<double> &dIy, const double *filter, unsigned int size);
   static void getGradY(const vpImage<double> &I, vpImage<double> &dIy, const double *filter, unsigned int size);
+  static void getGradY(const vpImageView<unsigned char> &I, vpImage<double> &dIy, const double *filter,
+                       unsigned int size);
   static void getGradYGauss2D(const vpImage<unsigned char> &I, vpImage<double> &dIy, const double *gaussianKernel,
                               const double *gaussianDerivativeKernel, unsigned int size);
 
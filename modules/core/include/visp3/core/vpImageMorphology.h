@@ -44,6 +44,7 @@
   \brief Various mathematical morphology tools, erosion, dilatation...
 
 */
+#include <visp3/core/vpBinaryImage.h>
 #include <visp3/core/vpImage.h>
 #include <visp3/core/vpImageException.h>
 #include <visp3/core/vpMatrix.h>
@@ -78,6 +79,19 @@ public:
                     diagonal) */
   } vpConnexityType;
 
+  /*! \enum vpStructuringElementType
+  Shape of the structuring element of the binary operators on a
+  vpBinaryImage.
+  */
+  typedef enum {
+    STRUCTURING_ELEMENT_CROSS, /*!< Horizontal and vertical segments of 2 *
+                                    radius + 1 pixels. With a radius of 1, the
+                                    4 neighbors are considered. */
+    STRUCTURING_ELEMENT_SQUARE /*!< Square of 2 * radius + 1 pixels. With a
+                                    radius of 1, the 8 neighbors are
+                                    considered. */
+  } vpStructuringElementType;
+
 public:
   template <class Type>
   static void erosion(vpImage<Type> &I, Type value, Type value_out, vpConnexityType connexity = CONNEXITY_4);
@@ -87,6 +101,15 @@ public:
 
   static void erosion(vpImage<unsigned char> &I, const vpConnexityType &connexity = CONNEXITY_4);
   static void dilatation(vpImage<unsigned char> &I, const vpConnexityType &connexity = CONNEXITY_4);
+
+  static void erosion(vpBinaryImage &I, const vpStructuringElementType &element = STRUCTURING_ELEMENT_CROSS,
+                      unsigned int radius = 1);
+  static void dilatation(vpBinaryImage &I, const vpStructuringElementType &element = STRUCTURING_ELEMENT_CROSS,
+                         unsigned int radius = 1);
+  static void opening(vpBinaryImage &I, const vpStructuringElementType &element = STRUCTURING_ELEMENT_CROSS,
+                      unsigned int radius = 1);
+  static void closing(vpBinaryImage &I, const vpStructuringElementType &element = STRUCTURING_ELEMENT_CROSS,
+                      unsigned int radius = 1);
 };
 
 /*!
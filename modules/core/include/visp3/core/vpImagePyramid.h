@@ -0,0 +1,151 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Gaussian and box image pyramids with optional gradient levels.
+ *
+ *****************************************************************************/
+
+#ifndef _vpImagePyramid_h_
+#define _vpImagePyramid_h_
+
+/*!
+  \file vpImagePyramid.h
+  \brief Gaussian and box image pyramids with optional gradient levels.
+*/
+
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImage.h>
+
+/*!
+  \class vpImagePyramid
+
+  \ingroup group_core_image
+
+  Pyramid of grey level images built once per frame and shared by const
+  reference between the algorithms processing the same frame, such as the
+  pyramidal template trackers with vpTemplateTracker::track(const vpImagePyramid &).
+
+  Level 0 is a copy of the input image and each following level halves the
+  width and the height of the previous one, rounding down. With
+  GAUSSIAN_FILTER, the pixel \f$(u, v)\f$ of a level is the previous level
+  smoothed by the 5x5 kernel \f$[1\ 4\ 6\ 4\ 1]^T [1\ 4\ 6\ 4\ 1] / 256\f$ at
+  \f$(2u, 2v)\f$, with borders mirrored without repeating the border pixel as
+  in OpenCV pyrDown(). With BOX_FILTER, it is the mean of the 2x2 block of
+  pixels starting at \f$(2u, 2v)\f$. Both filters are computed in integer
+  arithmetic rounded to the nearest, with SSE2 instructions when available,
+  and the rows of each level are shared between the threads of vpThreadPool.
+
+  When requested, the horizontal and vertical gradients of each level are
+  computed with the 3x3 Sobel kernels divided by 8, so that they are
+  expressed in grey levels per pixel, with the border pixels replicated.
+
+  The pyramid keeps its memory between two calls to build() with images of
+  the same size.
+
+  \code
+#include <visp3/core/vpImagePyramid.h>
+
+int main()
+{
+  vpImage<unsigned char> I(480, 640);
+  vpImagePyramid pyramid;
+  for (int frame = 0; frame < 100; frame++) {
+    // Acquire I
+    pyramid.build(I, 4, vpImagePyramid::GAUSSIAN_FILTER, true);
+    const vpImage<unsigned char> &I2 = pyramid.getLevel(2); // 160x120 image
+    const vpImage<float> &dIx = pyramid.getGradientU(2);
+  }
+}
+  \endcode
+
+  \sa vpImageFilter::getGaussPyramidal()
+*/
+class VISP_EXPORT vpImagePyramid
+{
+public:
+  //! Filter used to down-sample a level into the next one
+  typedef enum {
+    GAUSSIAN_FILTER, /*!< 5x5 Gaussian kernel sampled at even pixels. */
+    BOX_FILTER       /*!< Mean of 2x2 blocks of pixels. */
+  } vpPyramidFilterType;
+
+  vpImagePyramid();
+  vpImagePyramid(const vpImage<unsigned char> &I, unsigned int nbLevels,
+                 const vpPyramidFilterType &filter = GAUSSIAN_FILTER, bool computeGradients = false,
+                 unsigned int nThreads = 0);
+
+  void build(const vpImage<unsigned char> &I, unsigned int nbLevels,
+             const vpPyramidFilterType &filter = GAUSSIAN_FILTER, bool computeGradients = false,
+             unsigned int nThreads = 0);
+
+  /*!
+    Filter used to build the pyramid.
+  */
+  inline vpPyramidFilterType getFilterType() const { return m_filter; }
+  const vpImage<float> &getGradientU(unsigned int level) const;
+  const vpImage<float> &getGradientV(unsigned int level) const;
+  const vpImage<unsigned char> &getLevel(unsigned int level) const;
+  /*!
+    Number of levels of the pyramid, level 0 included. It is lower than the
+    number of levels given to build() when the input image is too small to
+    be halved that many times.
+  */
+  inline unsigned int getNbLevels() const { return m_nbLevels; }
+  /*!
+    Return true if the gradients of the levels have been computed by build().
+  */
+  inline bool hasGradients() const { return m_hasGradients; }
+
+  /*!
+    Return the image of a level of the pyramid.
+    \sa getLevel()
+  */
+  inline const vpImage<unsigned char> &operator[](unsigned int level) const { return getLevel(level); }
+
+private:
+  void checkLevel(unsigned int level) const;
+
+  //! Filter used to down-sample the levels
+  vpPyramidFilterType m_filter;
+  //! Number of valid levels
+  unsigned int m_nbLevels;
+  //! True if m_gradientU and m_gradientV are valid
+  bool m_hasGradients;
+  //! Images of the levels, kept allocated between two calls to build()
+  std::vector<vpImage<unsigned char> > m_levels;
+  //! Horizontal and vertical gradients of the levels
+  std::vector<vpImage<float> > m_gradientU, m_gradientV;
+};
+
+#endif
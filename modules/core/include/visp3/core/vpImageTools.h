@@ -48,15 +48,13 @@
 
 #include <visp3/core/vpImage.h>
 
-#ifdef VISP_HAVE_PTHREAD
-#include <pthread.h>
-#endif
-
 #include <visp3/core/vpCameraParameters.h>
 #include <visp3/core/vpImageException.h>
+#include <visp3/core/vpImageView.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpRect.h>
 #include <visp3/core/vpRectOriented.h>
+#include <visp3/core/vpThreadPool.h>
 
 #include <fstream>
 #include <iostream>
@@ -82,7 +80,8 @@ public:
   enum vpImageInterpolationType {
     INTERPOLATION_NEAREST, /*!< Nearest neighbor interpolation (fastest). */
     INTERPOLATION_LINEAR,  /*!< Bi-linear interpolation. */
-    INTERPOLATION_CUBIC    /*!< Bi-cubic interpolation. */
+    INTERPOLATION_CUBIC,   /*!< Bi-cubic interpolation. */
+    INTERPOLATION_AREA     /*!< Mean of the input pixels covered by each output pixel, to reduce an image. */
   };
 
   template <class Type>
@@ -103,6 +102,7 @@ public:
   template <class Type>
   static void crop(const vpImage<Type> &I, const vpRect &roi, vpImage<Type> &crop, unsigned int v_scale = 1,
                    unsigned int h_scale = 1);
+  template <class Type> static void crop(const vpImageView<Type> &I, vpImage<Type> &crop);
   template <class Type>
   static void crop(const unsigned char *bitmap, unsigned int width, unsigned int height, const vpRect &roi,
                    vpImage<Type> &crop, unsigned int v_scale = 1, unsigned int h_scale = 1);
@@ -156,6 +156,13 @@ public:
   static void resize(const vpImage<Type> &I, vpImage<Type> &Ires,
                      const vpImageInterpolationType &method = INTERPOLATION_NEAREST, unsigned int nThreads=0);
 
+  static void resize(const vpImageView<unsigned char> &I, vpImage<unsigned char> &Ires,
+                     const vpImageInterpolationType &method = INTERPOLATION_NEAREST, unsigned int nThreads=0);
+  static void resize(const vpImageView<vpRGBa> &I, vpImage<vpRGBa> &Ires,
+                     const vpImageInterpolationType &method = INTERPOLATION_NEAREST, unsigned int nThreads=0);
+  static void resize(const vpImageView<float> &I, vpImage<float> &Ires,
+                     const vpImageInterpolationType &method = INTERPOLATION_NEAREST, unsigned int nThreads=0);
+
   static void templateMatching(const vpImage<unsigned char> &I, const vpImage<unsigned char> &I_tpl,
                                vpImage<double> &I_score, const unsigned int step_u, const unsigned int step_v,
                                const bool useOptimized = true);
@@ -196,10 +203,6 @@ private:
   static float lerp(float A, float B, float t);
   static int64_t lerp2(int64_t A, int64_t B, int64_t t, int64_t t_1);
 
-  static double normalizedCorrelation(const vpImage<double> &I1, const vpImage<double> &I2, const vpImage<double> &II,
-                                      const vpImage<double> &IIsq, const vpImage<double> &II_tpl,
-                                      const vpImage<double> &IIsq_tpl, const unsigned int i0, const unsigned int j0);
-
   template <class Type>
   static void resizeBicubic(const vpImage<Type> &I, vpImage<Type> &Ires, const unsigned int i, const unsigned int j,
                             const float u, const float v, const float xFrac, const float yFrac);
@@ -219,6 +222,26 @@ private:
   static void warpLinear(const vpImage<Type> &src, const vpMatrix &T, vpImage<Type> &dst, bool affine, bool centerCorner, bool fixedPoint);
 
   static bool checkFixedPoint(unsigned int x, unsigned int y, const vpMatrix &T, bool affine);
+
+  static void resizeSeparable(const vpImageView<unsigned char> &I, vpImage<unsigned char> &Ires,
+                              const vpImageInterpolationType &method, unsigned int nThreads);
+  static void resizeSeparable(const vpImageView<vpRGBa> &I, vpImage<vpRGBa> &Ires,
+                              const vpImageInterpolationType &method, unsigned int nThreads);
+  static void resizeSeparable(const vpImageView<float> &I, vpImage<float> &Ires,
+                              const vpImageInterpolationType &method, unsigned int nThreads);
+
+  // Span-based warps, only available for unsigned char, vpRGBa and float images
+  template <class Type>
+  static bool warpSpans(const vpImage<Type> &, const vpMatrix &, vpImage<Type> &, bool, bool, bool)
+  {
+    return false;
+  }
+  static bool warpSpans(const vpImage<unsigned char> &src, const vpMatrix &T, vpImage<unsigned char> &dst,
+                        bool affine, bool linear, bool centerCorner);
+  static bool warpSpans(const vpImage<vpRGBa> &src, const vpMatrix &T, vpImage<vpRGBa> &dst, bool affine,
+                        bool linear, bool centerCorner);
+  static bool warpSpans(const vpImage<float> &src, const vpMatrix &T, vpImage<float> &dst, bool affine, bool linear,
+                        bool centerCorner);
 };
 
 #if defined(VISP_BUILD_DEPRECATED_FUNCTIONS)
@@ -380,6 +403,20 @@ void vpImageTools::crop(const vpImage<Type> &I, const vpRect &roi, vpImage<Type>
                      v_scale, h_scale);
 }
 
+/*!
+  Copy the pixels of a region of interest of an image, given by a view, into
+  a new image.
+
+  \param I : View of the region of interest.
+  \param crop : Cropped image, of the size of the view.
+
+  \sa vpImageView::copyTo()
+*/
+template <class Type> void vpImageTools::crop(const vpImageView<Type> &I, vpImage<Type> &crop)
+{
+  I.copyTo(crop);
+}
+
 /*!
   Crop a region of interest (ROI) in an image. The ROI coordinates and
   dimension are defined in the original image.
@@ -507,109 +544,86 @@ inline void vpImageTools::binarise(vpImage<unsigned char> &I, unsigned char thre
   }
 }
 
-#ifdef VISP_HAVE_PTHREAD
-
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
-template <class Type> class vpUndistortInternalType
+template <class Type> class vpUndistortInternalType : public vpParallelForBody
 {
 public:
-  Type *src;
-  Type *dst;
-  unsigned int width;
-  unsigned int height;
-  vpCameraParameters cam;
-  unsigned int nthreads;
-  unsigned int threadid;
-
-public:
-  vpUndistortInternalType() : src(NULL), dst(NULL), width(0), height(0), cam(), nthreads(0), threadid(0) {}
-
-  vpUndistortInternalType(const vpUndistortInternalType<Type> &u) { *this = u; }
-  vpUndistortInternalType &operator=(const vpUndistortInternalType<Type> &u)
+  vpUndistortInternalType(const vpImage<Type> &I, const vpCameraParameters &cam, vpImage<Type> &undistI)
+    : m_src(I.bitmap), m_dst(undistI.bitmap), m_width((int)I.getWidth()), m_height((int)I.getHeight()), m_cam(cam)
   {
-    src = u.src;
-    dst = u.dst;
-    width = u.width;
-    height = u.height;
-    cam = u.cam;
-    nthreads = u.nthreads;
-    threadid = u.threadid;
-
-    return *this;
   }
 
-  static void *vpUndistort_threaded(void *arg);
-};
-
-template <class Type> void *vpUndistortInternalType<Type>::vpUndistort_threaded(void *arg)
-{
-  vpUndistortInternalType<Type> *undistortSharedData = static_cast<vpUndistortInternalType<Type> *>(arg);
-  int offset = (int)undistortSharedData->threadid;
-  int width = (int)undistortSharedData->width;
-  int height = (int)undistortSharedData->height;
-  int nthreads = (int)undistortSharedData->nthreads;
-
-  double u0 = undistortSharedData->cam.get_u0();
-  double v0 = undistortSharedData->cam.get_v0();
-  double px = undistortSharedData->cam.get_px();
-  double py = undistortSharedData->cam.get_py();
-  double kud = undistortSharedData->cam.get_kud();
-
-  double invpx = 1.0 / px;
-  double invpy = 1.0 / py;
-
-  double kud_px2 = kud * invpx * invpx;
-  double kud_py2 = kud * invpy * invpy;
-
-  Type *dst = undistortSharedData->dst + (height / nthreads * offset) * width;
-  Type *src = undistortSharedData->src;
-
-  for (double v = height / nthreads * offset; v < height / nthreads * (offset + 1); v++) {
-    double deltav = v - v0;
-    // double fr1 = 1.0 + kd * (vpMath::sqr(deltav * invpy));
-    double fr1 = 1.0 + kud_py2 * deltav * deltav;
-
-    for (double u = 0; u < width; u++) {
-      // computation of u,v : corresponding pixel coordinates in I.
-      double deltau = u - u0;
-      // double fr2 = fr1 + kd * (vpMath::sqr(deltau * invpx));
-      double fr2 = fr1 + kud_px2 * deltau * deltau;
-
-      double u_double = deltau * fr2 + u0;
-      double v_double = deltav * fr2 + v0;
-
-      // computation of the bilinear interpolation
-
-      // declarations
-      int u_round = (int)(u_double);
-      int v_round = (int)(v_double);
-      if (u_round < 0.f)
-        u_round = -1;
-      if (v_round < 0.f)
-        v_round = -1;
-      double du_double = (u_double) - (double)u_round;
-      double dv_double = (v_double) - (double)v_round;
-      Type v01;
-      Type v23;
-      if ((0 <= u_round) && (0 <= v_round) && (u_round < ((width)-1)) && (v_round < ((height)-1))) {
-        // process interpolation
-        const Type *_mp = &src[v_round * width + u_round];
-        v01 = (Type)(_mp[0] + ((_mp[1] - _mp[0]) * du_double));
-        _mp += width;
-        v23 = (Type)(_mp[0] + ((_mp[1] - _mp[0]) * du_double));
-        *dst = (Type)(v01 + ((v23 - v01) * dv_double));
-      } else {
-        *dst = 0;
+  // Undistort the rows in [begin, end)
+  void operator()(int begin, int end)
+  {
+    int width = m_width;
+    int height = m_height;
+
+    double u0 = m_cam.get_u0();
+    double v0 = m_cam.get_v0();
+    double px = m_cam.get_px();
+    double py = m_cam.get_py();
+    double kud = m_cam.get_kud();
+
+    double invpx = 1.0 / px;
+    double invpy = 1.0 / py;
+
+    double kud_px2 = kud * invpx * invpx;
+    double kud_py2 = kud * invpy * invpy;
+
+    Type *dst = m_dst + begin * width;
+    const Type *src = m_src;
+
+    for (double v = begin; v < end; v++) {
+      double deltav = v - v0;
+      // double fr1 = 1.0 + kd * (vpMath::sqr(deltav * invpy));
+      double fr1 = 1.0 + kud_py2 * deltav * deltav;
+
+      for (double u = 0; u < width; u++) {
+        // computation of u,v : corresponding pixel coordinates in I.
+        double deltau = u - u0;
+        // double fr2 = fr1 + kd * (vpMath::sqr(deltau * invpx));
+        double fr2 = fr1 + kud_px2 * deltau * deltau;
+
+        double u_double = deltau * fr2 + u0;
+        double v_double = deltav * fr2 + v0;
+
+        // computation of the bilinear interpolation
+
+        // declarations
+        int u_round = (int)(u_double);
+        int v_round = (int)(v_double);
+        if (u_round < 0.f)
+          u_round = -1;
+        if (v_round < 0.f)
+          v_round = -1;
+        double du_double = (u_double) - (double)u_round;
+        double dv_double = (v_double) - (double)v_round;
+        Type v01;
+        Type v23;
+        if ((0 <= u_round) && (0 <= v_round) && (u_round < ((width)-1)) && (v_round < ((height)-1))) {
+          // process interpolation
+          const Type *_mp = &src[v_round * width + u_round];
+          v01 = (Type)(_mp[0] + ((_mp[1] - _mp[0]) * du_double));
+          _mp += width;
+          v23 = (Type)(_mp[0] + ((_mp[1] - _mp[0]) * du_double));
+          *dst = (Type)(v01 + ((v23 - v01) * dv_double));
+        } else {
+          *dst = 0;
+        }
+        dst++;
       }
-      dst++;
     }
   }
 
-  pthread_exit((void *)0);
-  return NULL;
-}
+private:
+  const Type *m_src;
+  Type *m_dst;
+  int m_width;
+  int m_height;
+  vpCameraParameters m_cam;
+};
 #endif // DOXYGEN_SHOULD_SKIP_THIS
-#endif // VISP_HAVE_PTHREAD
 
 /*!
   Undistort an image
@@ -623,7 +637,8 @@ template <class Type> void *vpUndistortInternalType<Type>::vpUndistort_threaded(
   parameter \f$K_d\f$ is null (see cam.get_kd_mp()), \e undistI is
   just a copy of \e I.
 
-  \param nThreads : Number of threads to use if pthreads library is available.
+  \param nThreads : Maximum number of threads of vpThreadPool to use. If 0,
+  all the threads of the pool can be used.
 
   \warning This function works only with Types authorizing "+,-,
   multiplication by a scalar" operators.
@@ -632,19 +647,15 @@ template <class Type> void *vpUndistortInternalType<Type>::vpUndistort_threaded(
     - On "Rhea"(Intel Core 2 Extreme X6800 2.93GHz, 2Go RAM)
       or "Charon"(Intel Xeon 3 GHz, 2Go RAM) : ~8 ms for a 640x480 image.
 
-  \note If you want to undistort multiple images, you should call `vpImageTools::initUndistortMap()`
-  once and then `vpImageTools::remap()` to undistort the images. This will be less time consuming.
+  \note If you want to undistort multiple images, you should build a vpUndistortMap once and then call
+  vpUndistortMap::remap() to undistort the images. This will be less time consuming.
 
-  \sa initUndistortMap, remap
+  \sa initUndistortMap, remap, vpUndistortMap
 */
 template <class Type>
 void vpImageTools::undistort(const vpImage<Type> &I, const vpCameraParameters &cam, vpImage<Type> &undistI,
                              unsigned int nThreads)
 {
-#ifdef VISP_HAVE_PTHREAD
-  //
-  // Optimized version using pthreads
-  //
   unsigned int width = I.getWidth();
   unsigned int height = I.getHeight();
 
@@ -659,111 +670,8 @@ void vpImageTools::undistort(const vpImage<Type> &I, const vpCameraParameters &c
     return;
   }
 
-  unsigned int nthreads = nThreads;
-  pthread_attr_t attr;
-  pthread_t *callThd = new pthread_t[nthreads];
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  vpUndistortInternalType<Type> *undistortSharedData;
-  undistortSharedData = new vpUndistortInternalType<Type>[nthreads];
-
-  for (unsigned int i = 0; i < nthreads; i++) {
-    // Each thread works on a different set of data.
-    //    vpTRACE("create thread %d", i);
-    undistortSharedData[i].src = I.bitmap;
-    undistortSharedData[i].dst = undistI.bitmap;
-    undistortSharedData[i].width = I.getWidth();
-    undistortSharedData[i].height = I.getHeight();
-    undistortSharedData[i].cam = cam;
-    undistortSharedData[i].nthreads = nthreads;
-    undistortSharedData[i].threadid = i;
-    pthread_create(&callThd[i], &attr, &vpUndistortInternalType<Type>::vpUndistort_threaded, &undistortSharedData[i]);
-  }
-  pthread_attr_destroy(&attr);
-  /* Wait on the other threads */
-
-  for (unsigned int i = 0; i < nthreads; i++) {
-    //  vpTRACE("join thread %d", i);
-    pthread_join(callThd[i], NULL);
-  }
-
-  delete[] callThd;
-  delete[] undistortSharedData;
-#else  // VISP_HAVE_PTHREAD
-  (void)nThreads;
-  //
-  // optimized version without pthreads
-  //
-  unsigned int width = I.getWidth();
-  unsigned int height = I.getHeight();
-
-  undistI.resize(height, width);
-
-  double u0 = cam.get_u0();
-  double v0 = cam.get_v0();
-  double px = cam.get_px();
-  double py = cam.get_py();
-  double kud = cam.get_kud();
-
-  // if (kud == 0) {
-  if (std::fabs(kud) <= std::numeric_limits<double>::epsilon()) {
-    // There is no need to undistort the image
-    undistI = I;
-    return;
-  }
-
-  double invpx = 1.0 / px;
-  double invpy = 1.0 / py;
-
-  double kud_px2 = kud * invpx * invpx;
-  double kud_py2 = kud * invpy * invpy;
-
-  Type *dst = undistI.bitmap;
-  for (double v = 0; v < height; v++) {
-    double deltav = v - v0;
-    // double fr1 = 1.0 + kd * (vpMath::sqr(deltav * invpy));
-    double fr1 = 1.0 + kud_py2 * deltav * deltav;
-
-    for (double u = 0; u < width; u++) {
-      // computation of u,v : corresponding pixel coordinates in I.
-      double deltau = u - u0;
-      // double fr2 = fr1 + kd * (vpMath::sqr(deltau * invpx));
-      double fr2 = fr1 + kud_px2 * deltau * deltau;
-
-      double u_double = deltau * fr2 + u0;
-      double v_double = deltav * fr2 + v0;
-
-      // printf("[%g][%g] %g %g : ", u, v, u_double, v_double );
-
-      // computation of the bilinear interpolation
-
-      // declarations
-      int u_round = (int)(u_double);
-      int v_round = (int)(v_double);
-      if (u_round < 0.f)
-        u_round = -1;
-      if (v_round < 0.f)
-        v_round = -1;
-      double du_double = (u_double) - (double)u_round;
-      double dv_double = (v_double) - (double)v_round;
-      Type v01;
-      Type v23;
-      if ((0 <= u_round) && (0 <= v_round) && (u_round < (((int)width) - 1)) && (v_round < (((int)height) - 1))) {
-        // process interpolation
-        const Type *_mp = &I[(unsigned int)v_round][(unsigned int)u_round];
-        v01 = (Type)(_mp[0] + ((_mp[1] - _mp[0]) * du_double));
-        _mp += width;
-        v23 = (Type)(_mp[0] + ((_mp[1] - _mp[0]) * du_double));
-        *dst = (Type)(v01 + ((v23 - v01) * dv_double));
-        // printf("R %d G %d B %d\n", dst->R, dst->G, dst->B);
-      } else {
-        *dst = 0;
-      }
-      dst++;
-    }
-  }
-#endif // VISP_HAVE_PTHREAD
+  vpUndistortInternalType<Type> undistortBody(I, cam, undistI);
+  vpThreadPool::instance().parallel_for(0, (int)height, undistortBody, 8, nThreads);
 
 #if 0
   // non optimized version
@@ -1044,7 +952,8 @@ void vpImageTools::resizeNearest(const vpImage<Type> &I, vpImage<Type> &Ires, co
   \param width : Resized width.
   \param height : Resized height.
   \param method : Interpolation method.
-  \param nThreads : Number of threads to use if OpenMP is available.
+  \param nThreads : Maximum number of threads to use, see resize(const vpImage<Type> &, vpImage<Type> &, const
+  vpImageInterpolationType &, unsigned int).
 
   \warning The input \e I and output \e Ires images must be different.
 */
@@ -1066,7 +975,17 @@ void vpImageTools::resize(const vpImage<Type> &I, vpImage<Type> &Ires, const uns
   \param Ires : Output image resized (you have to init the image \e Ires at
   the desired size).
   \param method : Interpolation method.
-  \param nThreads : Number of threads to use if OpenMP is available.
+  \param nThreads : Maximum number of threads to use. For unsigned char, vpRGBa and float images, it is the maximum
+  number of vpThreadPool threads (0 to use all of them). For the other image types, it is the number of threads used
+  if OpenMP is available.
+
+  Unsigned char, vpRGBa and float images are resized with separable kernels: the interpolation coefficients of each
+  column and row are precomputed, every source row is resampled horizontally once and the output rows are the
+  weighted sums of these rows, computed with SSE2 if available. Bands of rows are processed in parallel. The four
+  channels of vpRGBa images, alpha included, are interpolated.
+
+  INTERPOLATION_AREA is only implemented for these three image types; the other types use INTERPOLATION_LINEAR
+  instead.
 
   \warning The input \e I and output \e Ires images must be different.
 */
@@ -1107,7 +1026,7 @@ void vpImageTools::resize(const vpImage<Type> &I, vpImage<Type> &Ires, const vpI
 
       if (method == INTERPOLATION_NEAREST) {
         resizeNearest(I, Ires, static_cast<unsigned int>(i), j, u, v);
-      } else if (method == INTERPOLATION_LINEAR) {
+      } else if (method == INTERPOLATION_LINEAR || method == INTERPOLATION_AREA) {
         resizeBilinear(I, Ires, static_cast<unsigned int>(i), j, u, v, xFrac, yFrac);
       } else if (method == INTERPOLATION_CUBIC) {
         resizeBicubic(I, Ires, static_cast<unsigned int>(i), j, u, v, xFrac, yFrac);
@@ -1118,198 +1037,23 @@ void vpImageTools::resize(const vpImage<Type> &I, vpImage<Type> &Ires, const vpI
 
 template <> inline
 void vpImageTools::resize(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires,
-                          const vpImageInterpolationType &method, unsigned int
-                                                                  #if defined _OPENMP
-                                                                    nThreads
-                                                                  #endif
-                          )
+                          const vpImageInterpolationType &method, unsigned int nThreads)
 {
-  if (I.getWidth() < 2 || I.getHeight() < 2 || Ires.getWidth() < 2 || Ires.getHeight() < 2) {
-    std::cerr << "Input or output image is too small!" << std::endl;
-    return;
-  }
-
-  if (method == INTERPOLATION_NEAREST || method == INTERPOLATION_CUBIC) {
-    float scaleY = (I.getHeight() - 1) / static_cast<float>(Ires.getHeight() - 1);
-    float scaleX = (I.getWidth() - 1) / static_cast<float>(Ires.getWidth() - 1);
-
-    if (method == INTERPOLATION_NEAREST) {
-      scaleY = I.getHeight() / static_cast<float>(Ires.getHeight() - 1);
-      scaleX = I.getWidth() / static_cast<float>(Ires.getWidth() - 1);
-    }
-
-  #if defined _OPENMP
-    if (nThreads > 0) {
-      omp_set_num_threads(static_cast<int>(nThreads));
-    }
-    #pragma omp parallel for schedule(dynamic)
-  #endif
-    for (int i = 0; i < static_cast<int>(Ires.getHeight()); i++) {
-      float v = i * scaleY;
-      float yFrac = v - static_cast<int>(v);
-
-      for (unsigned int j = 0; j < Ires.getWidth(); j++) {
-        float u = j * scaleX;
-        float xFrac = u - static_cast<int>(u);
-
-        if (method == INTERPOLATION_NEAREST) {
-          resizeNearest(I, Ires, static_cast<unsigned int>(i), j, u, v);
-        } else if (method == INTERPOLATION_CUBIC) {
-          resizeBicubic(I, Ires, static_cast<unsigned int>(i), j, u, v, xFrac, yFrac);
-        }
-      }
-    }
-  } else if (method == INTERPOLATION_LINEAR) {
-    const int precision = 1 << 16;
-    int64_t scaleY = static_cast<int64_t>((I.getHeight() - 1) / static_cast<float>(Ires.getHeight() - 1) * precision);
-    int64_t scaleX = static_cast<int64_t>((I.getWidth() - 1) / static_cast<float>(Ires.getWidth() - 1) * precision);
-
-#if defined _OPENMP
-    if (nThreads > 0) {
-      omp_set_num_threads(static_cast<int>(nThreads));
-    }
-#pragma omp parallel for schedule(dynamic)
-#endif
-    for (int i = 0; i < static_cast<int>(Ires.getHeight()); i++) {
-      int64_t v = i * scaleY;
-      int64_t vround = v & (~0xFFFF);
-      int64_t rratio = v - vround;
-      int64_t y_ = v >> 16;
-      int64_t rfrac = precision - rratio;
-
-      for (unsigned int j = 0; j < Ires.getWidth(); j++) {
-        int64_t u = j * scaleX;
-        int64_t uround = u & (~0xFFFF);
-        int64_t cratio = u - uround;
-        int64_t x_ = u >> 16;
-        int64_t cfrac = precision - cratio;
-
-        if (y_ + 1 < static_cast<int64_t>(I.getHeight()) && x_ + 1 < static_cast<int64_t>(I.getWidth())) {
-          int64_t up = *reinterpret_cast<uint16_t *>(I.bitmap + y_ * I.getWidth() + x_);
-          int64_t down = *reinterpret_cast<uint16_t *>(I.bitmap + (y_ + 1) * I.getWidth() + x_);
-
-          Ires[i][j] = static_cast<unsigned char>((((up & 0x00FF) * rfrac + (down & 0x00FF) * rratio) * cfrac +
-                                                  ((up >> 8) * rfrac + (down >> 8) * rratio) * cratio) >> 32);
-        } else if (y_ + 1 < static_cast<int64_t>(I.getHeight())) {
-          Ires[i][j] = static_cast<unsigned char>(((*(I.bitmap + y_ * I.getWidth() + x_)
-                                                  * rfrac + *(I.bitmap + (y_ + 1) * I.getWidth() + x_) * rratio)) >> 16);
-        } else if (x_ + 1 < static_cast<int64_t>(I.getWidth())) {
-          uint16_t up = *reinterpret_cast<uint16_t *>(I.bitmap + y_ * I.getWidth() + x_);
-          Ires[i][j] = static_cast<unsigned char>(((up & 0x00FF) * cfrac + (up >> 8) * cratio) >> 16);
-        } else {
-          Ires[i][j] = *(I.bitmap + y_ * I.getWidth() + x_);
-        }
-      }
-    }
-  }
+  resizeSeparable(vpImageView<unsigned char>(I), Ires, method, nThreads);
 }
 
 template <> inline
 void vpImageTools::resize(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &Ires,
-                          const vpImageInterpolationType &method, unsigned int
-                                                                  #if defined _OPENMP
-                                                                    nThreads
-                                                                  #endif
-                          )
+                          const vpImageInterpolationType &method, unsigned int nThreads)
 {
-  if (I.getWidth() < 2 || I.getHeight() < 2 || Ires.getWidth() < 2 || Ires.getHeight() < 2) {
-    std::cerr << "Input or output image is too small!" << std::endl;
-    return;
-  }
-
-  if (method == INTERPOLATION_NEAREST || method == INTERPOLATION_CUBIC) {
-    float scaleY = (I.getHeight() - 1) / static_cast<float>(Ires.getHeight() - 1);
-    float scaleX = (I.getWidth() - 1) / static_cast<float>(Ires.getWidth() - 1);
-
-    if (method == INTERPOLATION_NEAREST) {
-      scaleY = I.getHeight() / static_cast<float>(Ires.getHeight() - 1);
-      scaleX = I.getWidth() / static_cast<float>(Ires.getWidth() - 1);
-    }
-
-  #if defined _OPENMP
-    if (nThreads > 0) {
-      omp_set_num_threads(static_cast<int>(nThreads));
-    }
-    #pragma omp parallel for schedule(dynamic)
-  #endif
-    for (int i = 0; i < static_cast<int>(Ires.getHeight()); i++) {
-      float v = i * scaleY;
-      float yFrac = v - static_cast<int>(v);
-
-      for (unsigned int j = 0; j < Ires.getWidth(); j++) {
-        float u = j * scaleX;
-        float xFrac = u - static_cast<int>(u);
-
-        if (method == INTERPOLATION_NEAREST) {
-          resizeNearest(I, Ires, static_cast<unsigned int>(i), j, u, v);
-        } else if (method == INTERPOLATION_CUBIC) {
-          resizeBicubic(I, Ires, static_cast<unsigned int>(i), j, u, v, xFrac, yFrac);
-        }
-      }
-    }
-  } else {
-    const int precision = 1 << 16;
-    int64_t scaleY = static_cast<int64_t>((I.getHeight() - 1) / static_cast<float>(Ires.getHeight() - 1) * precision);
-    int64_t scaleX = static_cast<int64_t>((I.getWidth() - 1) / static_cast<float>(Ires.getWidth() - 1) * precision);
+  resizeSeparable(vpImageView<vpRGBa>(I), Ires, method, nThreads);
+}
 
-#if defined _OPENMP
-    if (nThreads > 0) {
-      omp_set_num_threads(static_cast<int>(nThreads));
-    }
-#pragma omp parallel for schedule(dynamic)
-#endif
-    for (int i = 0; i < static_cast<int>(Ires.getHeight()); i++) {
-      int64_t v = i * scaleY;
-      int64_t vround = v & (~0xFFFF);
-      int64_t rratio = v - vround;
-      int64_t y_ = v >> 16;
-      int64_t rfrac = precision - rratio;
-
-      for (unsigned int j = 0; j < Ires.getWidth(); j++) {
-        int64_t u = j * scaleX;
-        int64_t uround = u & (~0xFFFF);
-        int64_t cratio = u - uround;
-        int64_t x_ = u >> 16;
-        int64_t cfrac = precision - cratio;
-
-        if (y_ + 1 < static_cast<int64_t>(I.getHeight()) && x_ + 1 < static_cast<int64_t>(I.getWidth())) {
-          int64_t col0 = lerp2((I.bitmap + y_ * I.getWidth() + x_)->R, (I.bitmap + (y_ + 1) * I.getWidth() + x_)->R, rratio, rfrac);
-          int64_t col1 = lerp2((I.bitmap + y_ * I.getWidth() + x_ + 1)->R, (I.bitmap + (y_ + 1) * I.getWidth() + x_ + 1)->R, rratio, rfrac);
-          int64_t valueR = lerp2(col0, col1, cratio, cfrac);
-
-          col0 = lerp2((I.bitmap + y_ * I.getWidth() + x_)->G, (I.bitmap + (y_ + 1) * I.getWidth() + x_)->G, rratio, rfrac);
-          col1 = lerp2((I.bitmap + y_ * I.getWidth() + x_ + 1)->G, (I.bitmap + (y_ + 1) * I.getWidth() + x_ + 1)->G, rratio, rfrac);
-          int64_t valueG = lerp2(col0, col1, cratio, cfrac);
-
-          col0 = lerp2((I.bitmap + y_ * I.getWidth() + x_)->B, (I.bitmap + (y_ + 1) * I.getWidth() + x_)->B, rratio, rfrac);
-          col1 = lerp2((I.bitmap + y_ * I.getWidth() + x_ + 1)->B, (I.bitmap + (y_ + 1) * I.getWidth() + x_ + 1)->B, rratio, rfrac);
-          int64_t valueB = lerp2(col0, col1, cratio, cfrac);
-
-          Ires[i][j] = vpRGBa(static_cast<unsigned char>(valueR >> 32),
-                              static_cast<unsigned char>(valueG >> 32),
-                              static_cast<unsigned char>(valueB >> 32));
-        } else if (y_ + 1 < static_cast<int64_t>(I.getHeight())) {
-          int64_t valueR = lerp2((I.bitmap + y_ * I.getWidth() + x_)->R, (I.bitmap + (y_ + 1) * I.getWidth() + x_)->R, rratio, rfrac);
-          int64_t valueG = lerp2((I.bitmap + y_ * I.getWidth() + x_)->G, (I.bitmap + (y_ + 1) * I.getWidth() + x_)->G, rratio, rfrac);
-          int64_t valueB = lerp2((I.bitmap + y_ * I.getWidth() + x_)->B, (I.bitmap + (y_ + 1) * I.getWidth() + x_)->B, rratio, rfrac);
-
-          Ires[i][j] = vpRGBa(static_cast<unsigned char>(valueR >> 16),
-                              static_cast<unsigned char>(valueG >> 16),
-                              static_cast<unsigned char>(valueB >> 16));
-        } else if (x_ + 1 < static_cast<int64_t>(I.getWidth())) {
-          int64_t valueR = lerp2((I.bitmap + x_)->R, (I.bitmap + x_ + 1)->R, cratio, cfrac);
-          int64_t valueG = lerp2((I.bitmap + x_)->G, (I.bitmap + x_ + 1)->G, cratio, cfrac);
-          int64_t valueB = lerp2((I.bitmap + x_)->B, (I.bitmap + x_ + 1)->B, cratio, cfrac);
-
-          Ires[i][j] = vpRGBa(static_cast<unsigned char>(valueR >> 16),
-                              static_cast<unsigned char>(valueG >> 16),
-                              static_cast<unsigned char>(valueB >> 16));
-        } else {
-          Ires[i][j] = *(I.bitmap + y_ * I.getWidth() + x_);
-        }
-      }
-    }
-  }
+template <> inline
+void vpImageTools::resize(const vpImage<float> &I, vpImage<float> &Ires,
+                          const vpImageInterpolationType &method, unsigned int nThreads)
+{
+  resizeSeparable(vpImageView<float>(I), Ires, method, nThreads);
 }
 
 /*!
@@ -1321,8 +1065,11 @@ void vpImageTools::resize(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &Ires,
   \param dst : Output image, if empty it will be of the same size than src and zero-initialized.
   \param interpolation : Interpolation method (only INTERPOLATION_NEAREST and INTERPOLATION_LINEAR
   are accepted, if INTERPOLATION_CUBIC is passed, INTERPOLATION_NEAREST will be used instead).
-  \param fixedPointArithmetic : If true and if `pixelCenter` is false, fixed-point arithmetic is used if
-  possible. Otherwise (e.g. the input image is too big) it fallbacks to the default implementation.
+  \param fixedPointArithmetic : If true, a faster but approximate implementation is used. For unsigned char,
+  vpRGBa and float images, the source coordinates of each output row are computed incrementally with SSE2, the
+  spans of pixels falling inside the input image are then interpolated without bound checks and the rows are
+  processed in parallel by vpThreadPool. For the other image types, fixed-point arithmetic is used if `pixelCenter`
+  is false and if possible, otherwise (e.g. the input image is too big) it fallbacks to the default implementation.
   \param pixelCenter : If true, pixel coordinates are at (0.5, 0.5), otherwise at (0,0). Fixed-point
   arithmetic cannot be used with `pixelCenter` option.
 */
@@ -1361,6 +1108,10 @@ void vpImageTools::warpImage(const vpImage<Type> &src, const vpMatrix &T, vpImag
     M = T.inverseByLU();
   }
 
+  if (fixedPointArithmetic && warpSpans(src, M, dst, affine, !interp_NN, pixelCenter)) {
+    return;
+  }
+
   if (fixedPointArithmetic && !pixelCenter) {
     fixedPointArithmetic = checkFixedPoint(0, 0, M, affine) &&
                            checkFixedPoint(dst.getWidth()-1, 0, M, affine) &&
@@ -1641,19 +1392,19 @@ void vpImageTools::warpLinear(const vpImage<Type> &src, const vpMatrix &T, vpIma
           const Type val01 = src[y_lower][x_lower + 1];
           const Type val10 = src[y_lower + 1][x_lower];
           const Type val11 = src[y_lower + 1][x_lower + 1];
-          const double col0 = lerp(val00, val01, s);
-          const double col1 = lerp(val10, val11, s);
+          const double col0 = lerp(static_cast<double>(val00), static_cast<double>(val01), s);
+          const double col1 = lerp(static_cast<double>(val10), static_cast<double>(val11), s);
           const double interp = lerp(col0, col1, t);
           dst[i][j] = vpMath::saturate<Type>(interp);
         } else if (y_lower < static_cast<int>(src.getHeight())-1) {
           const Type val00 = src[y_lower][x_lower];
           const Type val10 = src[y_lower + 1][x_lower];
-          const double interp = lerp(val00, val10, t);
+          const double interp = lerp(static_cast<double>(val00), static_cast<double>(val10), t);
           dst[i][j] = vpMath::saturate<Type>(interp);
         } else if (x_lower < static_cast<int>(src.getWidth())-1) {
           const Type val00 = src[y_lower][x_lower];
           const Type val01 = src[y_lower][x_lower + 1];
-          const double interp = lerp(val00, val01, s);
+          const double interp = lerp(static_cast<double>(val00), static_cast<double>(val01), s);
           dst[i][j] = vpMath::saturate<Type>(interp);
         } else {
           dst[i][j] = src[y_lower][x_lower];
@@ -0,0 +1,247 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Non-owning view of a rectangle of an image.
+ *
+ *****************************************************************************/
+
+#ifndef _vpImageView_h_
+#define _vpImageView_h_
+
+/*!
+  \file vpImageView.h
+  \brief Non-owning view of a rectangle of an image.
+*/
+
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpRect.h>
+
+/*!
+  \class vpImageView
+
+  \ingroup group_core_image
+
+  Read-only view of a rectangle of pixels of an image, or of any buffer whose
+  rows are separated by a constant stride, without copying the pixels.
+
+  A view only stores the address of its first pixel, its size and the number
+  of elements between the beginnings of two consecutive rows. It does not
+  own the pixels: the viewed image must not be resized or destroyed while
+  the view is used. A vpImage converts implicitly to a view of the whole
+  image, so that the functions taking a view also accept an image.
+
+  The functions below accept a view and process a region of interest of a
+  larger image in place:
+  - vpImageFilter::filterX(), vpImageFilter::filterY(),
+    vpImageFilter::gaussianBlur(), vpImageFilter::getGradX() and
+    vpImageFilter::getGradY() for grey level images
+  - vpImageConvert::convert() from color to grey level
+  - vpImageTools::resize() for grey level, color and float images
+  - vpImageTools::crop(), when a copy is needed
+  - vpHistogram::calculate()
+  - vpTemplateMatcher::setImage() and vpTemplateMatcher::match()
+
+  \code
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpImageView.h>
+
+int main()
+{
+  vpImage<unsigned char> I(480, 640);
+  vpImage<unsigned char> I_blur;
+
+  // Blur the 80x100 rectangle whose top-left corner is at row 50, column 60
+  vpImageView<unsigned char> roi(I, vpRect(60, 50, 80, 100));
+  vpImageFilter::gaussianBlur(roi, I_blur);
+}
+  \endcode
+*/
+template <class Type> class vpImageView
+{
+public:
+  /*!
+    Empty view.
+  */
+  vpImageView() : m_data(NULL), m_height(0), m_width(0), m_stride(0) {}
+
+  /*!
+    View of all the pixels of an image.
+  */
+  vpImageView(const vpImage<Type> &I)
+    : m_data(I.bitmap), m_height(I.getHeight()), m_width(I.getWidth()), m_stride(I.getWidth())
+  {
+  }
+
+  /*!
+    View of a region of interest of an image. As in vpImageTools::crop(),
+    the coordinates of the rectangle are rounded up and the rectangle is
+    clipped to the image.
+
+    \param I : Viewed image.
+    \param roi : Region of interest.
+  */
+  vpImageView(const vpImage<Type> &I, const vpRect &roi)
+    : m_data(NULL), m_height(0), m_width(0), m_stride(I.getWidth())
+  {
+    const int iMin = (std::max)((int)ceil(roi.getTop()), 0);
+    const int jMin = (std::max)((int)ceil(roi.getLeft()), 0);
+    const int iMax = (std::min)((int)ceil(roi.getTop() + roi.getHeight()), (int)I.getHeight());
+    const int jMax = (std::min)((int)ceil(roi.getLeft() + roi.getWidth()), (int)I.getWidth());
+    if (iMax > iMin && jMax > jMin) {
+      m_data = I[iMin] + jMin;
+      m_height = (unsigned int)(iMax - iMin);
+      m_width = (unsigned int)(jMax - jMin);
+    }
+  }
+
+  /*!
+    View of a rectangle of an image.
+
+    \param I : Viewed image.
+    \param top, left : Position of the top-left pixel of the rectangle.
+    \param height, width : Size of the rectangle.
+
+    \exception vpException::dimensionError : If the rectangle is not inside
+    the image.
+  */
+  vpImageView(const vpImage<Type> &I, unsigned int top, unsigned int left, unsigned int height, unsigned int width)
+    : m_data(NULL), m_height(height), m_width(width), m_stride(I.getWidth())
+  {
+    if (top + height > I.getHeight() || left + width > I.getWidth()) {
+      throw(vpException(vpException::dimensionError, "The %ux%u rectangle at (%u, %u) is not inside a %ux%u image",
+                        width, height, top, left, I.getWidth(), I.getHeight()));
+    }
+    if (height > 0 && width > 0) {
+      m_data = I[top] + left;
+    }
+  }
+
+  /*!
+    View of a buffer of pixels.
+
+    \param data : Address of the top-left pixel.
+    \param height, width : Size of the view.
+    \param stride : Number of elements of type Type between the beginnings of
+    two consecutive rows, at least \e width.
+  */
+  vpImageView(const Type *data, unsigned int height, unsigned int width, unsigned int stride)
+    : m_data(data), m_height(height), m_width(width), m_stride(stride)
+  {
+    if (stride < width) {
+      throw(vpException(vpException::dimensionError, "The stride %u of a view is smaller than its width %u", stride,
+                        width));
+    }
+  }
+
+  /*!
+    Copy the pixels of the view into an image.
+  */
+  void copyTo(vpImage<Type> &I) const
+  {
+    I.resize(m_height, m_width);
+    for (unsigned int i = 0; i < m_height; i++) {
+      memcpy(static_cast<void *>(I[i]), static_cast<const void *>((*this)[i]), m_width * sizeof(Type));
+    }
+  }
+
+  /*!
+    Number of columns of the view.
+  */
+  inline unsigned int getCols() const { return m_width; }
+  /*!
+    Number of rows of the view.
+  */
+  inline unsigned int getHeight() const { return m_height; }
+  /*!
+    Number of rows of the view.
+  */
+  inline unsigned int getRows() const { return m_height; }
+  /*!
+    Number of pixels of the view.
+  */
+  inline unsigned int getSize() const { return m_width * m_height; }
+  /*!
+    Number of elements between the beginnings of two consecutive rows.
+  */
+  inline unsigned int getStride() const { return m_stride; }
+
+  /*!
+    View of a rectangle of this view.
+
+    \param top, left : Position of the top-left pixel of the rectangle in
+    this view.
+    \param height, width : Size of the rectangle.
+
+    \exception vpException::dimensionError : If the rectangle is not inside
+    the view.
+  */
+  vpImageView<Type> getView(unsigned int top, unsigned int left, unsigned int height, unsigned int width) const
+  {
+    if (top + height > m_height || left + width > m_width) {
+      throw(vpException(vpException::dimensionError, "The %ux%u rectangle at (%u, %u) is not inside a %ux%u view",
+                        width, height, top, left, m_width, m_height));
+    }
+    if (height == 0 || width == 0) {
+      return vpImageView<Type>();
+    }
+    return vpImageView<Type>((*this)[top] + left, height, width, m_stride);
+  }
+
+  /*!
+    Number of columns of the view.
+  */
+  inline unsigned int getWidth() const { return m_width; }
+
+  /*!
+    Return true if the rows of the view are contiguous in memory.
+  */
+  inline bool isContinuous() const { return m_stride == m_width; }
+
+  //! Address of the first pixel of a row
+  inline const Type *operator[](unsigned int i) const { return m_data + (size_t)i * m_stride; }
+  //! Address of the first pixel of a row
+  inline const Type *operator[](int i) const { return m_data + (size_t)i * m_stride; }
+
+private:
+  const Type *m_data;
+  unsigned int m_height;
+  unsigned int m_width;
+  unsigned int m_stride;
+};
+
+#endif
@@ -417,6 +417,11 @@ vpMatrix M(R);
 
   vpMatrix AtA() const;
   void AtA(vpMatrix &B) const;
+
+  vpMatrix AtB(const vpMatrix &B) const;
+  void AtB(const vpMatrix &B, vpMatrix &C) const;
+  vpColVector AtB(const vpColVector &b) const;
+  void AtB(const vpColVector &b, vpColVector &c) const;
   //@}
 
   //-------------------------------------------------
@@ -508,6 +513,11 @@ vpMatrix M(R);
   double cond(double svThreshold = 1e-6) const;
   unsigned int kernel(vpMatrix &kerAt, double svThreshold = 1e-6) const;
 
+  // solve the 6-by-6 normal equations of a least-squares problem
+  unsigned int solveNormalEquations6(const vpColVector &b, vpColVector &x, double svThreshold = 1e-6) const;
+  // kernel of a matrix with 6 columns from its normal matrix
+  unsigned int kernelNormalEquations6(vpMatrix &kerAt, double svThreshold = 1e-12) const;
+
   // solve Ax=B using the SVD decomposition (usage A = solveBySVD(B,x) )
   void solveBySVD(const vpColVector &B, vpColVector &x) const;
   // solve Ax=B using the SVD decomposition (usage  x=A.solveBySVD(B))
@@ -640,6 +650,32 @@ vpMatrix M(R);
   static void sub2Matrices(const vpColVector &A, const vpColVector &B, vpColVector &C);
   //@}
 
+  /** @name Selection of the matrix product implementation  */
+  //@{
+  /*!
+    Return the minimum size of the matrices for which the products are
+    computed with the external BLAS library (OpenBLAS, MKL, Netlib...).
+    Smaller products are computed with the built-in blocked and vectorized
+    implementation.
+
+    \sa setLapackMatrixMinSize()
+  */
+  static unsigned int getLapackMatrixMinSize() { return m_lapack_min_size; }
+
+  /*!
+    Set the minimum size of the matrices for which the products are computed
+    with the external BLAS library. Below this size, calling BLAS is often
+    slower than the built-in implementation. Default value is 0 meaning that
+    BLAS is always used when available.
+
+    \param min_size : Minimum number of rows and columns of the matrices
+    involved in the product. Vectors are not taken into account.
+
+    \sa getLapackMatrixMinSize()
+  */
+  static void setLapackMatrixMinSize(unsigned int min_size) { m_lapack_min_size = min_size; }
+  //@}
+
   //---------------------------------
   // Kronecker product Static Public Member Functions
   //---------------------------------
@@ -806,6 +842,24 @@ vpMatrix M(R);
 #endif
 
 private:
+  static unsigned int m_lapack_min_size;
+
+  static bool useBlas(unsigned int m, unsigned int n, unsigned int k);
+
+  // Built-in matrix products on row-major data
+  static void builtin_dgemm(unsigned int M, unsigned int N, unsigned int K, const double *a_data, unsigned int lda,
+                            const double *b_data, unsigned int ldb, double *c_data, unsigned int ldc);
+  static void builtin_dgemm_tn(unsigned int M, unsigned int N, unsigned int K, const double *a_data, unsigned int lda,
+                               const double *b_data, unsigned int ldb, double *c_data, unsigned int ldc);
+  static void builtin_dgemv(unsigned int M, unsigned int N, const double *a_data, unsigned int lda,
+                            const double *x_data, double *y_data);
+  static void builtin_dgemv_t(unsigned int M, unsigned int N, const double *a_data, unsigned int lda,
+                              const double *x_data, double *y_data);
+  static void builtin_dsyrk(unsigned int N, unsigned int K, const double *a_data, unsigned int lda, double *c_data,
+                            unsigned int ldc);
+  static void builtin_dsyrk_t(unsigned int N, unsigned int K, const double *a_data, unsigned int lda, double *c_data,
+                              unsigned int ldc);
+
 #if defined(VISP_HAVE_LAPACK) && !defined(VISP_HAVE_LAPACK_BUILT_IN)
   static void blas_dgemm(char trans_a, char trans_b, const int M, const int N, const int K, double alpha,
                          double *a_data, const int lda, double *b_data, const int ldb, double beta, double *c_data,
@@ -153,6 +153,8 @@ class VISP_EXPORT vpPoseVector : public vpArray2D<double>
 public:
   // constructor
   vpPoseVector();
+  // copy constructor
+  vpPoseVector(const vpPoseVector &p);
   // constructor from 3 angles (in radian)
   vpPoseVector(const double tx, const double ty, const double tz, const double tux, const double tuy, const double tuz);
   // constructor convert an homogeneous matrix in a pose
@@ -232,6 +234,8 @@ public:
   */
   inline const double &operator[](unsigned int i) const { return *(data + i); }
 
+  vpPoseVector &operator=(const vpPoseVector &p);
+
   // Print  a vector [T thetaU] thetaU in degree
   void print() const;
   int print(std::ostream &s, unsigned int length, char const *intro = 0) const;
@@ -266,6 +270,11 @@ public:
   vp_deprecated void init(){};
 //@}
 #endif
+
+private:
+  // Elements and row pointers of the fixed-size storage, see vpArray2D
+  double m_fixedData[6];
+  double *m_fixedRowPtrs[6];
 };
 
 #endif
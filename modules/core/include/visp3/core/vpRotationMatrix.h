@@ -224,6 +224,9 @@ public:
 
 private:
   static const double threshold;
+  // Elements and row pointers of the fixed-size storage, see vpArray2D
+  double m_fixedData[9];
+  double *m_fixedRowPtrs[3];
 
 protected:
   unsigned int m_index;
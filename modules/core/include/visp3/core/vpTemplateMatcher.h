@@ -0,0 +1,156 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Template matching with zero-mean normalized cross-correlation.
+ *
+ *****************************************************************************/
+
+#ifndef _vpTemplateMatcher_h_
+#define _vpTemplateMatcher_h_
+
+/*!
+  \file vpTemplateMatcher.h
+  \brief Template matching with zero-mean normalized cross-correlation.
+*/
+
+#include <stdint.h>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpImageView.h>
+#include <visp3/core/vpRect.h>
+
+/*!
+  \class vpTemplateMatcher
+
+  \ingroup group_core_image
+
+  Search templates in an image with the zero-mean normalized
+  cross-correlation (ZNCC) score used by vpImageTools::templateMatching().
+
+  The image is given once with setImage(), that computes its integral
+  images, and its Gaussian pyramid when a coarse-to-fine search is
+  requested. Any number of templates can then be searched in it with
+  match(). The correlations are computed in integer arithmetic with SSE2
+  dot products, and the rows of positions are shared between the threads of
+  vpThreadPool.
+
+  With setPyramidLevels(), the exhaustive search is done on the coarsest
+  level only. The best peaks are then refined in a small neighbourhood at
+  each finer level, which divides the cost by about 16 per level for
+  textured templates of a few tens of pixels.
+
+  \code
+#include <visp3/core/vpTemplateMatcher.h>
+
+int main()
+{
+  vpImage<unsigned char> I(480, 640), I_tpl(48, 64);
+  // Acquire I and extract I_tpl
+
+  vpTemplateMatcher matcher;
+  matcher.setPyramidLevels(2);
+  matcher.setMaxMatches(3);
+  matcher.setImage(I);
+
+  std::vector<vpTemplateMatcher::vpMatch> matches;
+  matcher.match(I_tpl, matches);
+  for (size_t k = 0; k < matches.size(); k++) {
+    std::cout << "Template at (" << matches[k].i << ", " << matches[k].j << "), score " << matches[k].score << std::endl;
+  }
+}
+  \endcode
+
+  \sa vpImageTools::templateMatching()
+*/
+class VISP_EXPORT vpTemplateMatcher
+{
+public:
+  /*!
+    Location of a template in the image.
+  */
+  struct vpMatch {
+    unsigned int i;  //!< Row of the top-left corner of the template
+    unsigned int j;  //!< Column of the top-left corner of the template
+    double score;    //!< Zero-mean normalized cross-correlation in [-1, 1]
+  };
+
+  vpTemplateMatcher();
+
+  void computeScores(const vpImage<unsigned char> &I_tpl, vpImage<double> &I_score, unsigned int step_u = 1,
+                     unsigned int step_v = 1) const;
+
+  /*!
+    Maximum number of matches returned by match().
+  */
+  inline unsigned int getMaxMatches() const { return m_maxMatches; }
+  /*!
+    Minimum score of the matches returned by match().
+  */
+  inline double getMinScore() const { return m_minScore; }
+  /*!
+    Number of coarse levels of the pyramid used by match().
+  */
+  inline unsigned int getPyramidLevels() const { return m_nbLevels; }
+
+  void match(const vpImage<unsigned char> &I_tpl, std::vector<vpMatch> &matches) const;
+  void match(const vpImageView<unsigned char> &I_tpl, std::vector<vpMatch> &matches) const;
+  void match(const std::vector<vpImage<unsigned char> > &templates, std::vector<std::vector<vpMatch> > &matches) const;
+
+  void resetROI();
+
+  void setImage(const vpImage<unsigned char> &I);
+  void setImage(const vpImageView<unsigned char> &I);
+  void setMaxMatches(unsigned int maxMatches);
+  /*!
+    Set the minimum score of the matches returned by match(). Default is 0.
+  */
+  inline void setMinScore(double minScore) { m_minScore = minScore; }
+  void setPyramidLevels(unsigned int nbLevels);
+  void setROI(const vpRect &roi);
+
+private:
+  void buildLevels();
+
+  //! Image at full resolution followed by its pyramid levels
+  std::vector<vpImage<unsigned char> > m_pyramid;
+  //! Integral images of the pixels and of their squares, for each level
+  std::vector<std::vector<uint64_t> > m_sums, m_sqSums;
+  unsigned int m_nbLevels;
+  unsigned int m_maxMatches;
+  double m_minScore;
+  bool m_useROI;
+  vpRect m_roi;
+};
+
+#endif
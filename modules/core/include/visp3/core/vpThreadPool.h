@@ -0,0 +1,169 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Process-wide pool of persistent worker threads.
+ *
+ *****************************************************************************/
+
+#ifndef _vpThreadPool_h_
+#define _vpThreadPool_h_
+
+/*!
+  \file vpThreadPool.h
+  \brief Process-wide pool of persistent worker threads.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#include <type_traits>
+#endif
+
+/*!
+  \class vpParallelForBody
+
+  \ingroup group_core_threading
+
+  Interface of the work executed by vpThreadPool::parallel_for(). The
+  operator() is called concurrently on disjoint sub-ranges \f$[begin, end)\f$
+  of the iteration space and must therefore only write to data that depends
+  on the indices it receives.
+*/
+class VISP_EXPORT vpParallelForBody
+{
+public:
+  virtual ~vpParallelForBody() {}
+
+  /*!
+    Process the indices of the half-open range \f$[begin, end)\f$.
+  */
+  virtual void operator()(int begin, int end) = 0;
+};
+
+/*!
+  \class vpThreadPool
+
+  \ingroup group_core_threading
+
+  Process-wide task scheduler shared by all the ViSP algorithms that run in
+  parallel.
+
+  The worker threads are created once, the first time the pool is used, and
+  are then kept asleep between two calls. This avoids paying for a thread
+  creation on every frame and prevents oversubscribing the cores when several
+  trackers or detectors run in the same process.
+
+  parallel_for() splits an index range between the worker threads and the
+  calling thread, which always takes part in the computation. Each
+  participant first processes its own contiguous share of the range by chunks
+  of \e grain indices and, once it is exhausted, steals half of the remaining
+  work of another participant. Calls made from inside a parallel_for() body,
+  or while the workers are busy with another caller, are executed
+  sequentially by the calling thread.
+
+  When ViSP is not built with C++11 support, no thread is created and
+  parallel_for() runs the body sequentially.
+
+  \code
+#include <visp3/core/vpThreadPool.h>
+
+class Scale : public vpParallelForBody
+{
+public:
+  Scale(std::vector<double> &v, double s) : m_v(v), m_s(s) {}
+  void operator()(int begin, int end)
+  {
+    for (int i = begin; i < end; i++)
+      m_v[i] *= m_s;
+  }
+
+private:
+  std::vector<double> &m_v;
+  double m_s;
+};
+
+int main()
+{
+  std::vector<double> v(100000, 1.0);
+  Scale body(v, 2.0);
+  vpThreadPool::instance().parallel_for(0, (int)v.size(), body, 1024);
+}
+  \endcode
+*/
+class VISP_EXPORT vpThreadPool
+{
+public:
+  static vpThreadPool &instance();
+
+  unsigned int getNumThreads() const;
+  void setNumThreads(unsigned int nbThreads);
+
+  void parallel_for(int begin, int end, vpParallelForBody &body, int grain = 1, unsigned int maxThreads = 0);
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  /*!
+    Convenience overload that accepts any callable with a
+    <tt>void(int begin, int end)</tt> signature, typically a lambda.
+
+    \sa parallel_for(int, int, vpParallelForBody &, int, unsigned int)
+  */
+  template <typename Func>
+  typename std::enable_if<!std::is_base_of<vpParallelForBody, Func>::value>::type
+  parallel_for(int begin, int end, const Func &func, int grain = 1, unsigned int maxThreads = 0)
+  {
+    FunctorBody<Func> body(func);
+    parallel_for(begin, end, static_cast<vpParallelForBody &>(body), grain, maxThreads);
+  }
+#endif
+
+private:
+  vpThreadPool();
+  vpThreadPool(const vpThreadPool &);
+  vpThreadPool &operator=(const vpThreadPool &);
+  ~vpThreadPool();
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  template <typename Func> class FunctorBody : public vpParallelForBody
+  {
+  public:
+    explicit FunctorBody(const Func &func) : m_func(func) {}
+    void operator()(int begin, int end) { m_func(begin, end); }
+
+  private:
+    const Func &m_func;
+  };
+#endif
+
+  class Impl;
+  Impl *m_impl;
+};
+
+#endif
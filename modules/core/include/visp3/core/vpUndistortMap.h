@@ -0,0 +1,126 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Precomputed undistortion and rectification map.
+ *
+ *****************************************************************************/
+
+#ifndef _vpUndistortMap_h_
+#define _vpUndistortMap_h_
+
+/*!
+  \file vpUndistortMap.h
+  \brief Precomputed undistortion and rectification map.
+*/
+
+#include <stdint.h>
+#include <vector>
+
+#include <visp3/core/vpCameraParameters.h>
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpRGBa.h>
+#include <visp3/core/vpRotationMatrix.h>
+
+/*!
+  \class vpUndistortMap
+
+  \ingroup group_core_image
+
+  Map from the pixels of an undistorted, and optionally rectified, image to
+  the pixels of the image acquired by a camera, computed once for a given
+  camera and image size and then applied to each frame of a stream.
+
+  For each destination pixel, the map stores the integer coordinates of the
+  top-left source pixel as 16-bit integers and the position inside the
+  source pixel with a precision of 1/32 pixel. The bilinear interpolation is
+  done in fixed-point arithmetic, with SSE2 instructions when available, and
+  the rows of the image are shared between the threads of vpThreadPool.
+  Destination pixels whose source falls outside of the acquired image are set
+  to 0.
+
+  \code
+#include <visp3/core/vpUndistortMap.h>
+
+int main()
+{
+  vpCameraParameters cam;
+  cam.initPersProjWithDistortion(1200, 1200, 640, 512, -0.15, 0.16);
+  vpUndistortMap map(cam, 1280, 1024);
+
+  vpImage<unsigned char> I(1024, 1280), I_undist;
+  for (int frame = 0; frame < 100; frame++) {
+    // Acquire I
+    map.remap(I, I_undist);
+  }
+}
+  \endcode
+
+  \sa vpImageTools::undistort()
+*/
+class VISP_EXPORT vpUndistortMap
+{
+public:
+  vpUndistortMap();
+  vpUndistortMap(const vpCameraParameters &cam, unsigned int width, unsigned int height);
+
+  /*!
+    Height of the images the map produces.
+  */
+  inline unsigned int getHeight() const { return m_height; }
+  /*!
+    Width of the images the map produces.
+  */
+  inline unsigned int getWidth() const { return m_width; }
+
+  void init(const vpCameraParameters &cam, unsigned int width, unsigned int height);
+  void init(const vpCameraParameters &cam, unsigned int width, unsigned int height, const vpRotationMatrix &rRc,
+            const vpCameraParameters &camRect, unsigned int rectWidth, unsigned int rectHeight);
+
+  void remap(const vpImage<unsigned char> &I, vpImage<unsigned char> &Iundist, unsigned int nThreads = 0) const;
+  void remap(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &Iundist, unsigned int nThreads = 0) const;
+  void remap(const vpImage<uint16_t> &I, vpImage<uint16_t> &Iundist, unsigned int nThreads = 0) const;
+
+private:
+  void checkSourceSize(unsigned int width, unsigned int height) const;
+
+  //! Size of the destination images
+  unsigned int m_width, m_height;
+  //! Size of the source images
+  unsigned int m_srcWidth, m_srcHeight;
+  //! Integer coordinates (u, v) of the top-left source pixel
+  std::vector<int16_t> m_coords;
+  //! Index of the interpolation weights, or outside for pixels without source
+  std::vector<uint16_t> m_weightIndex;
+};
+
+#endif
@@ -0,0 +1,223 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Bit-packed binary image.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpBinaryImage.cpp
+  \brief Bit-packed binary image.
+*/
+
+#include <algorithm>
+
+#include <visp3/core/vpBinaryImage.h>
+#include <visp3/core/vpCPUFeatures.h>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+inline unsigned int popCount(uint64_t w)
+{
+#if defined(__GNUC__)
+  return (unsigned int)__builtin_popcountll(w);
+#else
+  w = w - ((w >> 1) & 0x5555555555555555ULL);
+  w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+  w = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return (unsigned int)((w * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// Pack the bytes of a row, one bit set per byte different from 0
+void packRow(const unsigned char *src, unsigned int width, uint64_t *dst, bool checkSSE2)
+{
+  unsigned int j = 0;
+#if VISP_HAVE_SSE2
+  if (checkSSE2) {
+    const __m128i zero = _mm_setzero_si128();
+    for (; j + 64 <= width; j += 64) {
+      uint64_t w = 0;
+      for (unsigned int k = 0; k < 4; k++) {
+        const __m128i v = _mm_loadu_si128((const __m128i *)(src + j + 16 * k));
+        const unsigned int isZero = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero));
+        w |= (uint64_t)(~isZero & 0xFFFF) << (16 * k);
+      }
+      dst[j >> 6] = w;
+    }
+  }
+#else
+  (void)checkSSE2;
+#endif
+  for (; j < width; j += 64) {
+    const unsigned int n = std::min(64u, width - j);
+    uint64_t w = 0;
+    for (unsigned int k = 0; k < n; k++) {
+      w |= (uint64_t)(src[j + k] != 0) << k;
+    }
+    dst[j >> 6] = w;
+  }
+}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Construct an empty image.
+*/
+vpBinaryImage::vpBinaryImage() : m_height(0), m_width(0), m_nbWords(0), m_words() {}
+
+/*!
+  Construct an image of \e height rows and \e width columns whose pixels are
+  all set to \e value.
+*/
+vpBinaryImage::vpBinaryImage(unsigned int height, unsigned int width, bool value)
+  : m_height(0), m_width(0), m_nbWords(0), m_words()
+{
+  resize(height, width, value);
+}
+
+/*!
+  Construct an image of the size of \e I whose pixels are set where \e I is
+  different from 0.
+*/
+vpBinaryImage::vpBinaryImage(const vpImage<unsigned char> &I) : m_height(0), m_width(0), m_nbWords(0), m_words()
+{
+  init(I);
+}
+
+/*!
+  Convert to a grey level image.
+
+  \param I : Converted image, resized to the size of this image.
+  \param foreground : Value of the pixels that are set.
+  \param background : Value of the pixels that are not set.
+*/
+void vpBinaryImage::convert(vpImage<unsigned char> &I, unsigned char foreground, unsigned char background) const
+{
+  I.resize(m_height, m_width, false);
+  for (unsigned int i = 0; i < m_height; i++) {
+    const uint64_t *row = getRow(i);
+    unsigned char *dst = I[i];
+    for (unsigned int j = 0; j < m_width; j += 64) {
+      const uint64_t w = row[j >> 6];
+      const unsigned int n = std::min(64u, m_width - j);
+      if (w == 0) {
+        memset(dst + j, background, n);
+      } else if (w == ~(uint64_t)0) {
+        memset(dst + j, foreground, n);
+      } else {
+        for (unsigned int k = 0; k < n; k++) {
+          dst[j + k] = ((w >> k) & 1) ? foreground : background;
+        }
+      }
+    }
+  }
+}
+
+/*!
+  Return the number of pixels that are set.
+*/
+unsigned int vpBinaryImage::getCount() const
+{
+  unsigned int count = 0;
+  for (size_t k = 0; k < m_words.size(); k++) {
+    count += popCount(m_words[k]);
+  }
+  return count;
+}
+
+/*!
+  Resize to the size of \e I and set the pixels where \e I is different
+  from 0.
+*/
+void vpBinaryImage::init(const vpImage<unsigned char> &I)
+{
+  resize(I.getHeight(), I.getWidth());
+  const bool checkSSE2 = vpCPUFeatures::checkSSE2();
+  for (unsigned int i = 0; i < m_height; i++) {
+    packRow(I[i], m_width, getRow(i), checkSSE2);
+  }
+}
+
+/*!
+  Invert all the pixels.
+*/
+void vpBinaryImage::invert()
+{
+  if (isEmpty()) {
+    return;
+  }
+  const uint64_t lastMask = getLastWordMask();
+  for (unsigned int i = 0; i < m_height; i++) {
+    uint64_t *row = getRow(i);
+    for (unsigned int k = 0; k < m_nbWords; k++) {
+      row[k] = ~row[k];
+    }
+    row[m_nbWords - 1] &= lastMask;
+  }
+}
+
+/*!
+  Resize the image. The previous pixels are lost and all the pixels are set
+  to \e value.
+*/
+void vpBinaryImage::resize(unsigned int height, unsigned int width, bool value)
+{
+  m_height = height;
+  m_width = width;
+  m_nbWords = (width + 63) / 64;
+  m_words.assign((size_t)m_height * m_nbWords, value ? ~(uint64_t)0 : 0);
+  if (value && m_nbWords > 0) {
+    const uint64_t lastMask = getLastWordMask();
+    for (unsigned int i = 0; i < m_height; i++) {
+      getRow(i)[m_nbWords - 1] = lastMask;
+    }
+  }
+}
+
+/*!
+  Return true if both images have the same size and the same pixels.
+*/
+bool vpBinaryImage::operator==(const vpBinaryImage &B) const
+{
+  return m_height == B.m_height && m_width == B.m_width && m_words == B.m_words;
+}
+
+/*!
+  Return true if the images differ in size or by at least one pixel.
+*/
+bool vpBinaryImage::operator!=(const vpBinaryImage &B) const { return !(*this == B); }
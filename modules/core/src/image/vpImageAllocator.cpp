@@ -0,0 +1,131 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Memory allocation policy of the image bitmaps.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpImageAllocator.cpp
+  \brief Memory allocation policy of the image bitmaps.
+*/
+
+#include <stdlib.h>
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+#include <visp3/core/vpImageAllocator.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+class vpAlignedImageAllocator : public vpImageAllocator
+{
+public:
+  void *allocate(size_t size) { return alignedMalloc(size); }
+  void deallocate(void *ptr, size_t /* size */) { alignedFree(ptr); }
+};
+
+// Never destroyed, so that images released during the static destruction
+// can still give their bitmap back
+vpImageAllocator *alignedAllocator()
+{
+  static vpImageAllocator *allocator = new vpAlignedImageAllocator;
+  return allocator;
+}
+
+vpImageAllocator *g_defaultAllocator = NULL;
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Allocate a block of memory aligned on vpImageAllocator::alignment bytes.
+  A block of at least one byte is allocated when \e size is 0.
+
+  \param size : Size in bytes.
+  \return The address of the block, or NULL when the memory cannot be
+  allocated. It must be released with alignedFree().
+*/
+void *vpImageAllocator::alignedMalloc(size_t size)
+{
+  if (size == 0) {
+    size = 1;
+  }
+#if defined(_WIN32)
+  return _aligned_malloc(size, alignment);
+#else
+  void *ptr = NULL;
+  if (posix_memalign(&ptr, alignment, size) != 0) {
+    return NULL;
+  }
+  return ptr;
+#endif
+}
+
+/*!
+  Release a block returned by alignedMalloc(). Nothing is done if \e ptr is
+  NULL.
+*/
+void vpImageAllocator::alignedFree(void *ptr)
+{
+#if defined(_WIN32)
+  _aligned_free(ptr);
+#else
+  free(ptr);
+#endif
+}
+
+/*!
+  Return the allocator used by the images that have not been given one with
+  vpImage::setAllocator().
+*/
+vpImageAllocator *vpImageAllocator::getDefault()
+{
+  return g_defaultAllocator != NULL ? g_defaultAllocator : alignedAllocator();
+}
+
+/*!
+  Change the allocator used by the images that have not been given one with
+  vpImage::setAllocator(). The images already allocated keep releasing their
+  bitmap with the allocator they got it from.
+
+  This function is not thread-safe: it should be called once, for instance
+  at the beginning of main(), before images are created in other threads.
+
+  \param allocator : New default allocator, or NULL to restore the aligned
+  allocator.
+*/
+void vpImageAllocator::setDefault(vpImageAllocator *allocator)
+{
+  g_defaultAllocator = allocator;
+}
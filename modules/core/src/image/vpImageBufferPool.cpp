@@ -0,0 +1,229 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Pool of image buffers recycled between frames.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpImageBufferPool.cpp
+  \brief Pool of image buffers recycled between frames.
+*/
+
+#include <map>
+
+#include <visp3/core/vpImageBufferPool.h>
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#include <mutex>
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+class vpImageBufferPool::Impl
+{
+public:
+  explicit Impl(size_t maxCachedBytes)
+    : m_buffers(), m_cachedBytes(0), m_maxCachedBytes(maxCachedBytes), m_nbAllocations(0), m_nbReuses(0)
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+      , m_mutex()
+#endif
+  {
+  }
+
+  ~Impl() { clear(); }
+
+  void *allocate(size_t size)
+  {
+    {
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+      std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+      std::multimap<size_t, void *>::iterator it = m_buffers.find(size);
+      if (it != m_buffers.end()) {
+        void *ptr = it->second;
+        m_buffers.erase(it);
+        m_cachedBytes -= size;
+        m_nbReuses++;
+        return ptr;
+      }
+      m_nbAllocations++;
+    }
+    return vpImageAllocator::alignedMalloc(size);
+  }
+
+  void deallocate(void *ptr, size_t size)
+  {
+    if (ptr == NULL) {
+      return;
+    }
+    {
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+      std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+      if (m_cachedBytes + size <= m_maxCachedBytes) {
+        m_buffers.insert(std::make_pair(size, ptr));
+        m_cachedBytes += size;
+        return;
+      }
+    }
+    vpImageAllocator::alignedFree(ptr);
+  }
+
+  void clear()
+  {
+    std::multimap<size_t, void *> buffers;
+    {
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+      std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+      buffers.swap(m_buffers);
+      m_cachedBytes = 0;
+    }
+    for (std::multimap<size_t, void *>::iterator it = buffers.begin(); it != buffers.end(); ++it) {
+      vpImageAllocator::alignedFree(it->second);
+    }
+  }
+
+  void setMaxCachedBytes(size_t maxCachedBytes)
+  {
+    std::multimap<size_t, void *> evicted;
+    {
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+      std::lock_guard<std::mutex> lock(m_mutex);
+#endif
+      m_maxCachedBytes = maxCachedBytes;
+      // Free the largest blocks first
+      while (m_cachedBytes > m_maxCachedBytes) {
+        std::multimap<size_t, void *>::iterator it = m_buffers.end();
+        --it;
+        m_cachedBytes -= it->first;
+        evicted.insert(*it);
+        m_buffers.erase(it);
+      }
+    }
+    for (std::multimap<size_t, void *>::iterator it = evicted.begin(); it != evicted.end(); ++it) {
+      vpImageAllocator::alignedFree(it->second);
+    }
+  }
+
+  //! Cached blocks sorted by size
+  std::multimap<size_t, void *> m_buffers;
+  size_t m_cachedBytes;
+  size_t m_maxCachedBytes;
+  unsigned int m_nbAllocations;
+  unsigned int m_nbReuses;
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  mutable std::mutex m_mutex;
+#endif
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Create an empty pool.
+
+  \param maxCachedBytes : Maximum size in bytes of the blocks kept by the
+  pool for later reuse.
+*/
+vpImageBufferPool::vpImageBufferPool(size_t maxCachedBytes) : m_impl(new Impl(maxCachedBytes)) {}
+
+/*!
+  Free the cached blocks. The images that still use the pool must have been
+  destroyed before.
+*/
+vpImageBufferPool::~vpImageBufferPool() { delete m_impl; }
+
+/*!
+  Return a cached block of exactly \e size bytes if there is one, or a new
+  block aligned on vpImageAllocator::alignment bytes.
+*/
+void *vpImageBufferPool::allocate(size_t size) { return m_impl->allocate(size); }
+
+/*!
+  Free all the cached blocks. The blocks used by the images are not affected.
+*/
+void vpImageBufferPool::clear() { m_impl->clear(); }
+
+/*!
+  Keep a block released by an image for a later allocate() of the same
+  size, or free it if the pool is full.
+*/
+void vpImageBufferPool::deallocate(void *ptr, size_t size) { m_impl->deallocate(ptr, size); }
+
+/*!
+  Size in bytes of the blocks currently kept by the pool.
+*/
+size_t vpImageBufferPool::getCachedBytes() const
+{
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+#endif
+  return m_impl->m_cachedBytes;
+}
+
+/*!
+  Maximum size in bytes of the blocks kept by the pool.
+*/
+size_t vpImageBufferPool::getMaxCachedBytes() const
+{
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+#endif
+  return m_impl->m_maxCachedBytes;
+}
+
+/*!
+  Number of calls to allocate() that needed a new block.
+*/
+unsigned int vpImageBufferPool::getNbAllocations() const
+{
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+#endif
+  return m_impl->m_nbAllocations;
+}
+
+/*!
+  Number of calls to allocate() served with a cached block.
+*/
+unsigned int vpImageBufferPool::getNbReuses() const
+{
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+  std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+#endif
+  return m_impl->m_nbReuses;
+}
+
+/*!
+  Change the maximum size in bytes of the blocks kept by the pool. The
+  largest cached blocks are freed until the new limit is met.
+*/
+void vpImageBufferPool::setMaxCachedBytes(size_t maxCachedBytes) { m_impl->setMaxCachedBytes(maxCachedBytes); }
@@ -43,12 +43,14 @@
   \brief Convert image types
 */
 
+#include <algorithm>
 #include <map>
 #include <sstream>
 
 // image
 #include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpThreadPool.h>
 
 #if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
 #include <emmintrin.h>
@@ -70,6 +72,412 @@ int vpImageConvert::vpCgb[256];
 int vpImageConvert::vpCgr[256];
 int vpImageConvert::vpCbb[256];
 
+#define vpSAT(c)                                                                                                       \
+  if (c & (~255)) {                                                                                                    \
+    if (c < 0)                                                                                                         \
+      c = 0;                                                                                                           \
+    else                                                                                                               \
+      c = 255;                                                                                                         \
+  }
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Images of at least this number of pixels are converted by bands of rows
+// (or of pixels) on the workers of vpThreadPool
+const unsigned int convertMinSizeForThreads = 640 * 480;
+
+// Number of pixels of a band processed by a thread at once
+const unsigned int convertGrainSize = 1 << 15;
+
+/*
+  Run the body over [0, n) where each of the n units holds nbPixels / n
+  pixels, on vpThreadPool for large images.
+*/
+void runConversion(vpParallelForBody &body, int n, unsigned int nbPixels)
+{
+  if (n <= 0) {
+    return;
+  }
+  if (nbPixels >= convertMinSizeForThreads) {
+    unsigned int pixelsPerUnit = std::max(1u, nbPixels / static_cast<unsigned int>(n));
+    int grain = static_cast<int>(std::max(1u, convertGrainSize / pixelsPerUnit));
+    vpThreadPool::instance().parallel_for(0, n, body, grain);
+  } else {
+    body(0, n);
+  }
+}
+
+#if VISP_HAVE_SSE2
+// Store 16 pixels given by their R, G, B and A components as RGBa
+inline void storeRGBa16(unsigned char *rgba, const __m128i &r, const __m128i &g, const __m128i &b, const __m128i &a)
+{
+  const __m128i rg_lo = _mm_unpacklo_epi8(r, g);
+  const __m128i rg_hi = _mm_unpackhi_epi8(r, g);
+  const __m128i ba_lo = _mm_unpacklo_epi8(b, a);
+  const __m128i ba_hi = _mm_unpackhi_epi8(b, a);
+
+  _mm_storeu_si128((__m128i *)rgba, _mm_unpacklo_epi16(rg_lo, ba_lo));
+  _mm_storeu_si128((__m128i *)(rgba + 16), _mm_unpackhi_epi16(rg_lo, ba_lo));
+  _mm_storeu_si128((__m128i *)(rgba + 32), _mm_unpacklo_epi16(rg_hi, ba_hi));
+  _mm_storeu_si128((__m128i *)(rgba + 48), _mm_unpackhi_epi16(rg_hi, ba_hi));
+}
+
+// Duplicate the 4 32-bit values of v, that fit on 16 bits, into 8 16-bit
+// values: [v0 v0 v1 v1 v2 v2 v3 v3]
+inline __m128i duplicate32To16(const __m128i &v)
+{
+  const __m128i p = _mm_packs_epi32(v, v);
+  return _mm_unpacklo_epi16(p, p);
+}
+
+/*
+  Compute (int)(x * c) on 16-bit lanes, where x is given by its absolute
+  value a <= 128 and its sign mask, and c = ci + m / 2^(16-p) with m chosen
+  so that the result is exactly the one of the double product. When shr8 is
+  true, the result is shifted by 8 bits as the YCbCr look-up tables are.
+*/
+inline __m128i mulTrunc(const __m128i &a, const __m128i &sign, short ci, int p, unsigned short m, bool shr8)
+{
+  __m128i t = _mm_mulhi_epu16(_mm_sll_epi16(a, _mm_cvtsi32_si128(p)), _mm_set1_epi16((short)m));
+  if (ci != 0) {
+    t = _mm_add_epi16(t, _mm_mullo_epi16(a, _mm_set1_epi16(ci)));
+  }
+  if (shr8) {
+    // floor(-t / 256) = -((t + 255) >> 8)
+    t = _mm_srli_epi16(_mm_add_epi16(t, _mm_and_si128(sign, _mm_set1_epi16(255))), 8);
+  }
+  return _mm_sub_epi16(_mm_xor_si128(t, sign), sign);
+}
+#endif
+
+/*
+  Convert YUYV 4:2:2 pixel pairs (y0 u y1 v) to RGBa. The units are pixel
+  pairs.
+*/
+class vpYUYVToRGBaBody : public vpParallelForBody
+{
+public:
+  vpYUYVToRGBaBody(const unsigned char *yuyv, unsigned char *rgba, bool useSSE2)
+    : m_yuyv(yuyv), m_rgba(rgba), m_useSSE2(useSSE2)
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    const unsigned char *s = m_yuyv + 4 * begin;
+    unsigned char *d = m_rgba + 8 * begin;
+    int i = begin;
+
+#if VISP_HAVE_SSE2
+    if (m_useSSE2) {
+      const __m128i mask_y = _mm_set1_epi16(0x00FF);
+      const __m128i offset = _mm_set1_epi16(128);
+      const __m128i coeff_b = _mm_set_epi16(0, 454, 0, 454, 0, 454, 0, 454);
+      const __m128i coeff_g = _mm_set_epi16(183, 88, 183, 88, 183, 88, 183, 88);
+      const __m128i coeff_r = _mm_set_epi16(359, 0, 359, 0, 359, 0, 359, 0);
+      const __m128i alpha = _mm_set1_epi8((char)vpRGBa::alpha_default);
+
+      for (; i + 8 <= end; i += 8) {
+        __m128i r[2], g[2], b[2];
+        for (int k = 0; k < 2; k++) {
+          const __m128i data = _mm_loadu_si128((const __m128i *)(s + 16 * k));
+          const __m128i y = _mm_and_si128(data, mask_y);
+          // u0 v0 u1 v1 u2 v2 u3 v3 centered on 0
+          const __m128i uv = _mm_sub_epi16(_mm_srli_epi16(data, 8), offset);
+
+          const __m128i cb = duplicate32To16(_mm_srai_epi32(_mm_madd_epi16(uv, coeff_b), 8));
+          const __m128i cg = duplicate32To16(_mm_srai_epi32(_mm_madd_epi16(uv, coeff_g), 8));
+          const __m128i cr = duplicate32To16(_mm_srai_epi32(_mm_madd_epi16(uv, coeff_r), 8));
+
+          r[k] = _mm_add_epi16(y, cr);
+          g[k] = _mm_sub_epi16(y, cg);
+          b[k] = _mm_add_epi16(y, cb);
+        }
+
+        storeRGBa16(d, _mm_packus_epi16(r[0], r[1]), _mm_packus_epi16(g[0], g[1]), _mm_packus_epi16(b[0], b[1]),
+                    alpha);
+        s += 32;
+        d += 64;
+      }
+    }
+#endif
+
+    for (; i < end; i++) {
+      int r, g, b, cr, cg, cb, y1, y2;
+      y1 = *s++;
+      cb = ((*s - 128) * 454) >> 8;
+      cg = (*s++ - 128) * 88;
+      y2 = *s++;
+      cr = ((*s - 128) * 359) >> 8;
+      cg = (cg + (*s++ - 128) * 183) >> 8;
+
+      r = y1 + cr;
+      b = y1 + cb;
+      g = y1 - cg;
+      vpSAT(r);
+      vpSAT(g);
+      vpSAT(b);
+
+      *d++ = static_cast<unsigned char>(r);
+      *d++ = static_cast<unsigned char>(g);
+      *d++ = static_cast<unsigned char>(b);
+      *d++ = vpRGBa::alpha_default;
+
+      r = y2 + cr;
+      b = y2 + cb;
+      g = y2 - cg;
+      vpSAT(r);
+      vpSAT(g);
+      vpSAT(b);
+
+      *d++ = static_cast<unsigned char>(r);
+      *d++ = static_cast<unsigned char>(g);
+      *d++ = static_cast<unsigned char>(b);
+      *d++ = vpRGBa::alpha_default;
+    }
+  }
+
+private:
+  const unsigned char *m_yuyv;
+  unsigned char *m_rgba;
+  bool m_useSSE2;
+};
+
+/*
+  Convert planar 4:2:0 images (YUV420 or YV12) to RGBa. The units are pairs
+  of rows sharing the same chroma row.
+*/
+class vpYUV420ToRGBaBody : public vpParallelForBody
+{
+public:
+  vpYUV420ToRGBaBody(const unsigned char *y, const unsigned char *u, const unsigned char *v, unsigned char *rgba,
+                     unsigned int width, bool useSSE2)
+    : m_y(y), m_u(u), m_v(v), m_rgba(rgba), m_width(width), m_useSSE2(useSSE2)
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    const unsigned int halfWidth = m_width / 2;
+    for (int i = begin; i < end; i++) {
+      const unsigned char *y0 = m_y + i * (m_width + 2 * halfWidth);
+      const unsigned char *y1 = y0 + m_width;
+      const unsigned char *u = m_u + i * halfWidth;
+      const unsigned char *v = m_v + i * halfWidth;
+      unsigned char *d0 = m_rgba + i * (4 * m_width + 8 * halfWidth);
+      unsigned char *d1 = d0 + 4 * m_width;
+      unsigned int j = 0;
+
+#if VISP_HAVE_SSE2
+      if (m_useSSE2) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i offset = _mm_set1_epi16(128);
+        const __m128i alpha = _mm_set1_epi8((char)vpRGBa::alpha_default);
+
+        for (; j + 8 <= halfWidth; j += 8) {
+          const __m128i uc = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(u + j)), zero), offset);
+          const __m128i vc = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(v + j)), zero), offset);
+          const __m128i usign = _mm_srai_epi16(uc, 15);
+          const __m128i vsign = _mm_srai_epi16(vc, 15);
+
+          // U = (int)(u * 0.354), V = (int)(v * 0.707)
+          const __m128i U = mulTrunc(_mm_sub_epi16(_mm_xor_si128(uc, usign), usign), usign, 0, 5, 725, false);
+          const __m128i V = mulTrunc(_mm_sub_epi16(_mm_xor_si128(vc, vsign), vsign), vsign, 0, 8, 181, false);
+          const __m128i U5 = _mm_add_epi16(_mm_slli_epi16(U, 2), U);
+          const __m128i V2 = _mm_add_epi16(V, V);
+          const __m128i UV = _mm_sub_epi16(zero, _mm_add_epi16(U, V));
+
+          const __m128i U5_lo = _mm_unpacklo_epi16(U5, U5), U5_hi = _mm_unpackhi_epi16(U5, U5);
+          const __m128i V2_lo = _mm_unpacklo_epi16(V2, V2), V2_hi = _mm_unpackhi_epi16(V2, V2);
+          const __m128i UV_lo = _mm_unpacklo_epi16(UV, UV), UV_hi = _mm_unpackhi_epi16(UV, UV);
+
+          const unsigned char *rows[2] = {y0, y1};
+          unsigned char *dsts[2] = {d0, d1};
+          for (unsigned int k = 0; k < 2; k++) {
+            const __m128i Y = _mm_loadu_si128((const __m128i *)(rows[k] + 2 * j));
+            const __m128i Y_lo = _mm_unpacklo_epi8(Y, zero);
+            const __m128i Y_hi = _mm_unpackhi_epi8(Y, zero);
+
+            storeRGBa16(dsts[k] + 8 * j, _mm_packus_epi16(_mm_add_epi16(Y_lo, V2_lo), _mm_add_epi16(Y_hi, V2_hi)),
+                        _mm_packus_epi16(_mm_add_epi16(Y_lo, UV_lo), _mm_add_epi16(Y_hi, UV_hi)),
+                        _mm_packus_epi16(_mm_add_epi16(Y_lo, U5_lo), _mm_add_epi16(Y_hi, U5_hi)), alpha);
+          }
+        }
+      }
+#endif
+
+      for (; j < halfWidth; j++) {
+        int U = (int)((u[j] - 128) * 0.354);
+        int U5 = 5 * U;
+        int V = (int)((v[j] - 128) * 0.707);
+        int V2 = 2 * V;
+        int UV = -U - V;
+        const int Y[4] = {y0[2 * j], y0[2 * j + 1], y1[2 * j], y1[2 * j + 1]};
+        unsigned char *d[4] = {d0 + 8 * j, d0 + 8 * j + 4, d1 + 8 * j, d1 + 8 * j + 4};
+
+        // Original equations
+        // R = Y           + 1.402 V
+        // G = Y - 0.344 U - 0.714 V
+        // B = Y + 1.772 U
+        for (unsigned int k = 0; k < 4; k++) {
+          int R = Y[k] + V2;
+          if ((R >> 8) > 0)
+            R = 255;
+          else if (R < 0)
+            R = 0;
+
+          int G = Y[k] + UV;
+          if ((G >> 8) > 0)
+            G = 255;
+          else if (G < 0)
+            G = 0;
+
+          int B = Y[k] + U5;
+          if ((B >> 8) > 0)
+            B = 255;
+          else if (B < 0)
+            B = 0;
+
+          d[k][0] = (unsigned char)R;
+          d[k][1] = (unsigned char)G;
+          d[k][2] = (unsigned char)B;
+          d[k][3] = vpRGBa::alpha_default;
+        }
+      }
+    }
+  }
+
+private:
+  const unsigned char *m_y;
+  const unsigned char *m_u;
+  const unsigned char *m_v;
+  unsigned char *m_rgba;
+  unsigned int m_width;
+  bool m_useSSE2;
+};
+
+/*
+  Convert YCbCr 4:2:2 pixel pairs (y0 cb y1 cr) to RGBa. The SSE2 code
+  evaluates exactly the look-up tables of vpImageConvert::computeYCbCrLUT(),
+  that are used by the scalar code. The units are pixel pairs.
+*/
+class vpYCbCrToRGBaBody : public vpParallelForBody
+{
+public:
+  vpYCbCrToRGBaBody(const unsigned char *ycbcr, unsigned char *rgba, const int *crr, const int *cgb, const int *cgr,
+                    const int *cbb, bool useSSE2)
+    : m_ycbcr(ycbcr), m_rgba(rgba), m_crr(crr), m_cgb(cgb), m_cgr(cgr), m_cbb(cbb), m_useSSE2(useSSE2)
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    const unsigned char *s = m_ycbcr + 4 * begin;
+    unsigned char *d = m_rgba + 8 * begin;
+    int i = begin;
+
+#if VISP_HAVE_SSE2
+    if (m_useSSE2) {
+      const __m128i mask_y = _mm_set1_epi16(0x00FF);
+      const __m128i offset = _mm_set1_epi16(128);
+      const __m128i mask_cb = _mm_set1_epi32(0x0000FFFF);
+      const __m128i select_cb = _mm_set_epi16(0, 1, 0, 1, 0, 1, 0, 1);
+      const __m128i select_cr = _mm_set_epi16(1, 0, 1, 0, 1, 0, 1, 0);
+      const __m128i ones = _mm_set1_epi16(1);
+      const __m128i alpha = _mm_set1_epi8((char)vpRGBa::alpha_default);
+
+      for (; i + 8 <= end; i += 8) {
+        __m128i r[2], g[2], b[2];
+        for (int k = 0; k < 2; k++) {
+          const __m128i data = _mm_loadu_si128((const __m128i *)(s + 16 * k));
+          const __m128i y = _mm_and_si128(data, mask_y);
+          // cb0 cr0 cb1 cr1 cb2 cr2 cb3 cr3 centered on 0
+          const __m128i c = _mm_sub_epi16(_mm_srli_epi16(data, 8), offset);
+          const __m128i sign = _mm_srai_epi16(c, 15);
+          const __m128i nsign = _mm_xor_si128(sign, _mm_set1_epi16(-1));
+          const __m128i a = _mm_sub_epi16(_mm_xor_si128(c, sign), sign);
+
+          // vpCrr, vpCbb, vpCgb and vpCgr evaluated on both chroma
+          const __m128i crr = mulTrunc(a, sign, 364, 4, 2707, true);
+          const __m128i cbb = mulTrunc(a, sign, 460, 7, 293, true);
+          const __m128i cgb = mulTrunc(a, nsign, 89, 6, 899, true);
+          const __m128i cgr = mulTrunc(a, nsign, 185, 6, 835, true);
+          const __m128i cg = _mm_or_si128(_mm_and_si128(mask_cb, cgb), _mm_andnot_si128(mask_cb, cgr));
+
+          r[k] = _mm_add_epi16(y, duplicate32To16(_mm_madd_epi16(crr, select_cr)));
+          g[k] = _mm_add_epi16(y, duplicate32To16(_mm_madd_epi16(cg, ones)));
+          b[k] = _mm_add_epi16(y, duplicate32To16(_mm_madd_epi16(cbb, select_cb)));
+        }
+
+        storeRGBa16(d, _mm_packus_epi16(r[0], r[1]), _mm_packus_epi16(g[0], g[1]), _mm_packus_epi16(b[0], b[1]),
+                    alpha);
+        s += 32;
+        d += 64;
+      }
+    }
+#endif
+
+    for (; i < end; i++) {
+      const unsigned char cb = s[1], cr = s[3];
+      for (unsigned int k = 0; k < 2; k++) {
+        int val_r = s[2 * k] + m_crr[cr];
+        int val_g = s[2 * k] + m_cgb[cb] + m_cgr[cr];
+        int val_b = s[2 * k] + m_cbb[cb];
+
+        *d++ = (val_r < 0) ? 0u : ((val_r > 255) ? 255u : (unsigned char)val_r); // Red component.
+        *d++ = (val_g < 0) ? 0u : ((val_g > 255) ? 255u : (unsigned char)val_g); // Green component.
+        *d++ = (val_b < 0) ? 0u : ((val_b > 255) ? 255u : (unsigned char)val_b); // Blue component.
+        *d++ = vpRGBa::alpha_default;
+      }
+      s += 4;
+    }
+  }
+
+private:
+  const unsigned char *m_ycbcr;
+  unsigned char *m_rgba;
+  const int *m_crr;
+  const int *m_cgb;
+  const int *m_cgr;
+  const int *m_cbb;
+  bool m_useSSE2;
+};
+
+/*
+  Copy one byte over two: dst[i] = src[2 * i + offset] with offset 0 or 1.
+  Used to extract the luma of the packed 4:2:2 formats and the most
+  significant byte of MONO16 images.
+*/
+void extractBytes(const unsigned char *src, unsigned char *dst, unsigned int size, unsigned int offset)
+{
+  unsigned int i = 0;
+
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2() && size >= 16) {
+    const __m128i mask = _mm_set1_epi16(0x00FF);
+    for (; i <= size - 16; i += 16) {
+      __m128i a = _mm_loadu_si128((const __m128i *)(src + 2 * i));
+      __m128i b = _mm_loadu_si128((const __m128i *)(src + 2 * i + 16));
+      if (offset) {
+        a = _mm_srli_epi16(a, 8);
+        b = _mm_srli_epi16(b, 8);
+      } else {
+        a = _mm_and_si128(a, mask);
+        b = _mm_and_si128(b, mask);
+      }
+      _mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi16(a, b));
+    }
+  }
+#endif
+
+  for (; i < size; i++) {
+    dst[i] = src[2 * i + offset];
+  }
+}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 /*!
   Convert a vpImage\<unsigned char\> to a vpImage\<vpRGBa\>.
   Tha alpha component is set to vpRGBa::alpha_default.
@@ -95,6 +503,25 @@ void vpImageConvert::convert(const vpImage<vpRGBa> &src, vpImage<unsigned char>
   RGBaToGrey((unsigned char *)src.bitmap, dest.bitmap, src.getHeight() * src.getWidth());
 }
 
+/*!
+  Convert a region of a vpImage\<vpRGBa\> to a vpImage\<unsigned char\>,
+  without copying the region first.
+  \param src : view of the source image
+  \param dest : destination image, of the size of the view
+*/
+void vpImageConvert::convert(const vpImageView<vpRGBa> &src, vpImage<unsigned char> &dest)
+{
+  dest.resize(src.getHeight(), src.getWidth());
+
+  if (src.isContinuous()) {
+    RGBaToGrey((unsigned char *)src[0], dest.bitmap, src.getSize());
+    return;
+  }
+  for (unsigned int i = 0; i < src.getHeight(); i++) {
+    RGBaToGrey((unsigned char *)src[i], dest[i], src.getWidth());
+  }
+}
+
 /*!
   Convert a vpImage\<float\> to a vpImage\<unsigend char\> by renormalizing
   between 0 and 255. \param src : source image \param dest : destination image
@@ -1227,13 +1654,6 @@ void vpImageConvert::convert(const yarp::sig::ImageOf<yarp::sig::PixelRgb> *src,
 
 #endif
 
-#define vpSAT(c)                                                                                                       \
-  if (c & (~255)) {                                                                                                    \
-    if (c < 0)                                                                                                         \
-      c = 0;                                                                                                           \
-    else                                                                                                               \
-      c = 255;                                                                                                         \
-  }
 /*!
   Convert an image from YUYV 4:2:2 (y0 u01 y1 v01 y2 u23 y3 v23 ...) to RGB32.
   Destination rgba memory area has to be allocated before.
@@ -1244,50 +1664,13 @@ void vpImageConvert::convert(const yarp::sig::ImageOf<yarp::sig::PixelRgb> *src,
 */
 void vpImageConvert::YUYVToRGBa(unsigned char *yuyv, unsigned char *rgba, unsigned int width, unsigned int height)
 {
-  unsigned char *s;
-  unsigned char *d;
-  int w, h;
-  int r, g, b, cr, cg, cb, y1, y2;
-
-  h = (int)height;
-  w = (int)width;
-  s = yuyv;
-  d = rgba;
-  while (h--) {
-    int c = w >> 1;
-    while (c--) {
-      y1 = *s++;
-      cb = ((*s - 128) * 454) >> 8;
-      cg = (*s++ - 128) * 88;
-      y2 = *s++;
-      cr = ((*s - 128) * 359) >> 8;
-      cg = (cg + (*s++ - 128) * 183) >> 8;
-
-      r = y1 + cr;
-      b = y1 + cb;
-      g = y1 - cg;
-      vpSAT(r);
-      vpSAT(g);
-      vpSAT(b);
-
-      *d++ = static_cast<unsigned char>(r);
-      *d++ = static_cast<unsigned char>(g);
-      *d++ = static_cast<unsigned char>(b);
-      *d++ = vpRGBa::alpha_default;
-
-      r = y2 + cr;
-      b = y2 + cb;
-      g = y2 - cg;
-      vpSAT(r);
-      vpSAT(g);
-      vpSAT(b);
+  bool checkSSE2 = vpCPUFeatures::checkSSE2();
+#if !VISP_HAVE_SSE2
+  checkSSE2 = false;
+#endif
 
-      *d++ = static_cast<unsigned char>(r);
-      *d++ = static_cast<unsigned char>(g);
-      *d++ = static_cast<unsigned char>(b);
-      *d++ = vpRGBa::alpha_default;
-    }
-  }
+  vpYUYVToRGBaBody body(yuyv, rgba, checkSSE2);
+  runConversion(body, (int)((width >> 1) * height), width * height);
 }
 
 /*!
@@ -1351,13 +1734,7 @@ void vpImageConvert::YUYVToRGB(unsigned char *yuyv, unsigned char *rgb, unsigned
 */
 void vpImageConvert::YUYVToGrey(unsigned char *yuyv, unsigned char *grey, unsigned int size)
 {
-  unsigned int i = 0, j = 0;
-
-  while (j < size * 2) {
-    grey[i++] = yuyv[j];
-    grey[i++] = yuyv[j + 2];
-    j += 4;
-  }
+  extractBytes(yuyv, grey, size, 0);
 }
 
 /*!
@@ -1737,13 +2114,7 @@ void vpImageConvert::YUV422ToRGB(unsigned char *yuv, unsigned char *rgb, unsigne
 */
 void vpImageConvert::YUV422ToGrey(unsigned char *yuv, unsigned char *grey, unsigned int size)
 {
-  unsigned int i = 0, j = 0;
-
-  while (j < size * 2) {
-    grey[i++] = yuv[j + 1];
-    grey[i++] = yuv[j + 3];
-    j += 4;
-  }
+  extractBytes(yuv, grey, size, 1);
 }
 
 /*!
@@ -1908,130 +2279,16 @@ void vpImageConvert::YUV411ToRGB(unsigned char *yuv, unsigned char *rgb, unsigne
 */
 void vpImageConvert::YUV420ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height)
 {
-  //  std::cout << "call optimized ConvertYUV420ToRGBa()" << std::endl;
-  int U, V, R, G, B, V2, U5, UV;
-  int Y0, Y1, Y2, Y3;
+  bool checkSSE2 = vpCPUFeatures::checkSSE2();
+#if !VISP_HAVE_SSE2
+  checkSSE2 = false;
+#endif
+
   unsigned int size = width * height;
   unsigned char *iU = yuv + size;
   unsigned char *iV = yuv + 5 * size / 4;
-  for (unsigned int i = 0; i < height / 2; i++) {
-    for (unsigned int j = 0; j < width / 2; j++) {
-      U = (int)((*iU++ - 128) * 0.354);
-      U5 = 5 * U;
-      V = (int)((*iV++ - 128) * 0.707);
-      V2 = 2 * V;
-      UV = -U - V;
-      Y0 = *yuv++;
-      Y1 = *yuv;
-      yuv = yuv + width - 1;
-      Y2 = *yuv++;
-      Y3 = *yuv;
-      yuv = yuv - width + 1;
-
-      // Original equations
-      // R = Y           + 1.402 V
-      // G = Y - 0.344 U - 0.714 V
-      // B = Y + 1.772 U
-      R = Y0 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y0 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y0 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y1 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y1 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y1 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba = vpRGBa::alpha_default;
-      rgba = rgba + 4 * width - 7;
-
-      //---
-      R = Y2 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y2 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y2 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y3 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y3 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y3 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba = vpRGBa::alpha_default;
-      rgba = rgba - 4 * width + 1;
-    }
-    yuv += width;
-    rgba += 4 * width;
-  }
+  vpYUV420ToRGBaBody body(yuv, iU, iV, rgba, width, checkSSE2);
+  runConversion(body, (int)(height / 2), size);
 }
 /*!
 
@@ -2284,130 +2541,16 @@ void vpImageConvert::YUV444ToGrey(unsigned char *yuv, unsigned char *grey, unsig
 */
 void vpImageConvert::YV12ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height)
 {
-  //  std::cout << "call optimized ConvertYV12ToRGBa()" << std::endl;
-  int U, V, R, G, B, V2, U5, UV;
-  int Y0, Y1, Y2, Y3;
+  bool checkSSE2 = vpCPUFeatures::checkSSE2();
+#if !VISP_HAVE_SSE2
+  checkSSE2 = false;
+#endif
+
   unsigned int size = width * height;
   unsigned char *iV = yuv + size;
   unsigned char *iU = yuv + 5 * size / 4;
-  for (unsigned int i = 0; i < height / 2; i++) {
-    for (unsigned int j = 0; j < width / 2; j++) {
-      U = (int)((*iU++ - 128) * 0.354);
-      U5 = 5 * U;
-      V = (int)((*iV++ - 128) * 0.707);
-      V2 = 2 * V;
-      UV = -U - V;
-      Y0 = *yuv++;
-      Y1 = *yuv;
-      yuv = yuv + width - 1;
-      Y2 = *yuv++;
-      Y3 = *yuv;
-      yuv = yuv - width + 1;
-
-      // Original equations
-      // R = Y           + 1.402 V
-      // G = Y - 0.344 U - 0.714 V
-      // B = Y + 1.772 U
-      R = Y0 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y0 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y0 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y1 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y1 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y1 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba = 0;
-      rgba = rgba + 4 * width - 7;
-
-      //---
-      R = Y2 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y2 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y2 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y3 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y3 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y3 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba = vpRGBa::alpha_default;
-      rgba = rgba - 4 * width + 1;
-    }
-    yuv += width;
-    rgba += 4 * width;
-  }
+  vpYUV420ToRGBaBody body(yuv, iU, iV, rgba, width, checkSSE2);
+  runConversion(body, (int)(height / 2), size);
 }
 /*!
 
@@ -4159,36 +4302,28 @@ void vpImageConvert::YCbCrToRGB(unsigned char *ycbcr, unsigned char *rgb, unsign
 */
 void vpImageConvert::YCbCrToRGBa(unsigned char *ycbcr, unsigned char *rgba, unsigned int size)
 {
-  unsigned char *cbv;
-  unsigned char *crv;
-  unsigned char *pt_ycbcr = ycbcr;
-  unsigned char *pt_rgba = rgba;
-  cbv = pt_ycbcr + 1;
-  crv = pt_ycbcr + 3;
+  bool checkSSE2 = vpCPUFeatures::checkSSE2();
+#if !VISP_HAVE_SSE2
+  checkSSE2 = false;
+#endif
 
   vpImageConvert::computeYCbCrLUT();
 
-  int col = 0;
-
-  while (size--) {
-    int val_r, val_g, val_b;
-    if (!(col++ % 2)) {
-      cbv = pt_ycbcr + 1;
-      crv = pt_ycbcr + 3;
-    }
-
-    val_r = *pt_ycbcr + vpImageConvert::vpCrr[*crv];
-    val_g = *pt_ycbcr + vpImageConvert::vpCgb[*cbv] + vpImageConvert::vpCgr[*crv];
-    val_b = *pt_ycbcr + vpImageConvert::vpCbb[*cbv];
+  vpYCbCrToRGBaBody body(ycbcr, rgba, vpCrr, vpCgb, vpCgr, vpCbb, checkSSE2);
+  runConversion(body, (int)(size / 2), size);
 
-    vpDEBUG_TRACE(5, "[%d] R: %d G: %d B: %d\n", size, val_r, val_g, val_b);
+  if (size % 2) {
+    // Last pixel, with the chroma that follows it
+    unsigned char *pt_ycbcr = ycbcr + 2 * (size - 1);
+    unsigned char *pt_rgba = rgba + 4 * (size - 1);
+    int val_r = *pt_ycbcr + vpImageConvert::vpCrr[pt_ycbcr[3]];
+    int val_g = *pt_ycbcr + vpImageConvert::vpCgb[pt_ycbcr[1]] + vpImageConvert::vpCgr[pt_ycbcr[3]];
+    int val_b = *pt_ycbcr + vpImageConvert::vpCbb[pt_ycbcr[1]];
 
     *pt_rgba++ = (val_r < 0) ? 0u : ((val_r > 255) ? 255u : (unsigned char)val_r); // Red component.
     *pt_rgba++ = (val_g < 0) ? 0u : ((val_g > 255) ? 255u : (unsigned char)val_g); // Green component.
     *pt_rgba++ = (val_b < 0) ? 0u : ((val_b > 255) ? 255u : (unsigned char)val_b); // Blue component.
     *pt_rgba++ = vpRGBa::alpha_default;
-
-    pt_ycbcr += 2;
   }
 }
 
@@ -4210,13 +4345,7 @@ void vpImageConvert::YCbCrToRGBa(unsigned char *ycbcr, unsigned char *rgba, unsi
 */
 void vpImageConvert::YCbCrToGrey(unsigned char *yuv, unsigned char *grey, unsigned int size)
 {
-  unsigned int i = 0, j = 0;
-
-  while (j < size * 2) {
-    grey[i++] = yuv[j];
-    grey[i++] = yuv[j + 2];
-    j += 4;
-  }
+  extractBytes(yuv, grey, size, 0);
 }
 
 /*!
@@ -4365,59 +4494,51 @@ int main()
 void vpImageConvert::split(const vpImage<vpRGBa> &src, vpImage<unsigned char> *pR, vpImage<unsigned char> *pG,
                            vpImage<unsigned char> *pB, vpImage<unsigned char> *pa)
 {
+  bool checkSSE2 = vpCPUFeatures::checkSSE2();
+#if !VISP_HAVE_SSE2
+  checkSSE2 = false;
+#endif
+
   size_t n = src.getNumberOfPixel();
   unsigned int height = src.getHeight();
   unsigned int width = src.getWidth();
-  unsigned char *input;
+  const unsigned char *input;
   unsigned char *dst;
 
   vpImage<unsigned char> *tabChannel[4];
 
-  /*  incrsrc[0] = 0; //init
-  incrsrc[1] = 0; //step after the first used channel
-  incrsrc[2] = 0; //step after the second used channel
-  incrsrc[3] = 0;
-  incrsrc[4] = 0;
- */
   tabChannel[0] = pR;
   tabChannel[1] = pG;
   tabChannel[2] = pB;
   tabChannel[3] = pa;
 
-  size_t i; /* ordre    */
   for (unsigned int j = 0; j < 4; j++) {
     if (tabChannel[j] != NULL) {
       if (tabChannel[j]->getHeight() != height || tabChannel[j]->getWidth() != width) {
         tabChannel[j]->resize(height, width);
       }
       dst = (unsigned char *)tabChannel[j]->bitmap;
-
-      input = (unsigned char *)src.bitmap + j;
-      i = 0;
-#if 1               // optimization
-      if (n >= 4) { /* boucle deroulee lsize fois    */
-        n -= 3;
-        for (; i < n; i += 4) {
-          *dst = *input;
-          input += 4;
-          dst++;
-          *dst = *input;
-          input += 4;
-          dst++;
-          *dst = *input;
-          input += 4;
-          dst++;
-          *dst = *input;
-          input += 4;
-          dst++;
+      input = (const unsigned char *)src.bitmap;
+      size_t i = 0;
+
+      if (checkSSE2) {
+#if VISP_HAVE_SSE2
+        const __m128i mask = _mm_set1_epi32(0xFF);
+        const __m128i shift = _mm_cvtsi32_si128((int)(8 * j));
+        for (; i + 16 <= n; i += 16) {
+          // Channel j of 16 pixels, one by 32-bit lane
+          __m128i c[4];
+          for (unsigned int k = 0; k < 4; k++) {
+            c[k] = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128((const __m128i *)(input + 4 * i + 16 * k)), shift), mask);
+          }
+          _mm_storeu_si128((__m128i *)(dst + i),
+                           _mm_packus_epi16(_mm_packs_epi32(c[0], c[1]), _mm_packs_epi32(c[2], c[3])));
         }
-        n += 3;
-      }
 #endif
+      }
+
       for (; i < n; i++) {
-        *dst = *input;
-        input += 4;
-        dst++;
+        dst[i] = input[4 * i + j];
       }
     }
   }
@@ -4462,8 +4583,55 @@ void vpImageConvert::merge(const vpImage<unsigned char> *R, const vpImage<unsign
 
     RGBa.resize(height, width);
 
+    const vpImage<unsigned char> *tabChannel[4] = {R, G, B, a};
+    unsigned char *dst = (unsigned char *)RGBa.bitmap;
     unsigned int size = width * height;
-    for (unsigned int i = 0; i < size; i++) {
+    unsigned int i = 0;
+
+    bool checkSSE2 = vpCPUFeatures::checkSSE2();
+#if !VISP_HAVE_SSE2
+    checkSSE2 = false;
+#endif
+
+    if (checkSSE2) {
+#if VISP_HAVE_SSE2
+      // Bytes of the missing channels, that are kept
+      unsigned int keep = 0;
+      for (unsigned int j = 0; j < 4; j++) {
+        if (tabChannel[j] == NULL) {
+          keep |= 0xFFu << (8 * j);
+        }
+      }
+      const __m128i mask_keep = _mm_set1_epi32((int)keep);
+      const __m128i zero = _mm_setzero_si128();
+
+      for (; i + 16 <= size; i += 16) {
+        __m128i p[4];
+        for (unsigned int k = 0; k < 4; k++) {
+          p[k] = keep ? _mm_and_si128(_mm_loadu_si128((const __m128i *)(dst + 4 * i + 16 * k)), mask_keep) : zero;
+        }
+
+        for (unsigned int j = 0; j < 4; j++) {
+          if (tabChannel[j] != NULL) {
+            const __m128i c = _mm_loadu_si128((const __m128i *)(tabChannel[j]->bitmap + i));
+            const __m128i c_lo = _mm_unpacklo_epi8(c, zero);
+            const __m128i c_hi = _mm_unpackhi_epi8(c, zero);
+            const __m128i shift = _mm_cvtsi32_si128((int)(8 * j));
+            p[0] = _mm_or_si128(p[0], _mm_sll_epi32(_mm_unpacklo_epi16(c_lo, zero), shift));
+            p[1] = _mm_or_si128(p[1], _mm_sll_epi32(_mm_unpackhi_epi16(c_lo, zero), shift));
+            p[2] = _mm_or_si128(p[2], _mm_sll_epi32(_mm_unpacklo_epi16(c_hi, zero), shift));
+            p[3] = _mm_or_si128(p[3], _mm_sll_epi32(_mm_unpackhi_epi16(c_hi, zero), shift));
+          }
+        }
+
+        for (unsigned int k = 0; k < 4; k++) {
+          _mm_storeu_si128((__m128i *)(dst + 4 * i + 16 * k), p[k]);
+        }
+      }
+#endif
+    }
+
+    for (; i < size; i++) {
       if (R != NULL) {
         RGBa.bitmap[i].R = R->bitmap[i];
       }
@@ -4497,13 +4665,8 @@ void vpImageConvert::merge(const vpImage<unsigned char> *R, const vpImage<unsign
 */
 void vpImageConvert::MONO16ToGrey(unsigned char *grey16, unsigned char *grey, unsigned int size)
 {
-  int i = (((int)size) << 1) - 1;
-  int j = (int)size - 1;
-
-  while (i >= 0) {
-    int y = grey16[i--];
-    grey[j--] = static_cast<unsigned char>((y + (grey16[i--] << 8)) >> 8);
-  }
+  // The most significant byte comes first
+  extractBytes(grey16, grey, size, 0);
 }
 
 /*!
@@ -4606,7 +4769,70 @@ void vpImageConvert::HSV2RGB(const double *hue_, const double *saturation_, cons
 void vpImageConvert::RGB2HSV(const unsigned char *rgb, double *hue, double *saturation, double *value,
                              const unsigned int size, const unsigned int step)
 {
-  for (unsigned int i = 0; i < size; i++) {
+  bool checkSSE2 = vpCPUFeatures::checkSSE2();
+#if !VISP_HAVE_SSE2
+  checkSSE2 = false;
+#endif
+
+  unsigned int i = 0;
+
+  if (checkSSE2) {
+#if VISP_HAVE_SSE2
+    // Same operations as the scalar code below on 2 pixels, the branches
+    // being replaced by selections
+    const __m128d c255 = _mm_set1_pd(255.0);
+    const __m128d eps = _mm_set1_pd(std::numeric_limits<double>::epsilon());
+    const __m128d sign_mask = _mm_set1_pd(-0.0);
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d one = _mm_set1_pd(1.0);
+    const __m128d two = _mm_set1_pd(2.0);
+    const __m128d four = _mm_set1_pd(4.0);
+    const __m128d six = _mm_set1_pd(6.0);
+
+    for (; i + 2 <= size; i += 2) {
+      const unsigned char *p0 = rgb + i * step;
+      const unsigned char *p1 = p0 + step;
+      const __m128d red = _mm_div_pd(_mm_set_pd(p1[0], p0[0]), c255);
+      const __m128d green = _mm_div_pd(_mm_set_pd(p1[1], p0[1]), c255);
+      const __m128d blue = _mm_div_pd(_mm_set_pd(p1[2], p0[2]), c255);
+
+      const __m128d max = _mm_max_pd(_mm_max_pd(red, green), blue);
+      const __m128d min = _mm_min_pd(_mm_min_pd(red, green), blue);
+
+      // vpMath::equal(x, 0, eps) is fabs(x) < eps
+      const __m128d max_nul = _mm_cmplt_pd(_mm_andnot_pd(sign_mask, max), eps);
+      const __m128d s = _mm_andnot_pd(max_nul, _mm_div_pd(_mm_sub_pd(max, min), max));
+      const __m128d s_nul = _mm_cmplt_pd(_mm_andnot_pd(sign_mask, s), eps);
+
+      __m128d delta = _mm_sub_pd(max, min);
+      const __m128d delta_nul = _mm_cmplt_pd(_mm_andnot_pd(sign_mask, delta), eps);
+      delta = _mm_or_pd(_mm_and_pd(delta_nul, one), _mm_andnot_pd(delta_nul, delta));
+
+      const __m128d red_max = _mm_cmplt_pd(_mm_andnot_pd(sign_mask, _mm_sub_pd(red, max)), eps);
+      const __m128d green_max = _mm_cmplt_pd(_mm_andnot_pd(sign_mask, _mm_sub_pd(green, max)), eps);
+
+      const __m128d h_red = _mm_div_pd(_mm_sub_pd(green, blue), delta);
+      const __m128d h_green = _mm_add_pd(two, _mm_div_pd(_mm_sub_pd(blue, red), delta));
+      const __m128d h_blue = _mm_add_pd(four, _mm_div_pd(_mm_sub_pd(red, green), delta));
+
+      __m128d h = _mm_or_pd(_mm_and_pd(green_max, h_green), _mm_andnot_pd(green_max, h_blue));
+      h = _mm_or_pd(_mm_and_pd(red_max, h_red), _mm_andnot_pd(red_max, h));
+      h = _mm_div_pd(h, six);
+
+      const __m128d h_neg = _mm_cmplt_pd(h, zero);
+      const __m128d h_gt1 = _mm_cmpgt_pd(h, one);
+      h = _mm_or_pd(_mm_and_pd(h_gt1, _mm_sub_pd(h, one)), _mm_andnot_pd(h_gt1, h));
+      h = _mm_or_pd(_mm_and_pd(h_neg, _mm_add_pd(h, one)), _mm_andnot_pd(h_neg, h));
+      h = _mm_andnot_pd(s_nul, h);
+
+      _mm_storeu_pd(hue + i, h);
+      _mm_storeu_pd(saturation + i, s);
+      _mm_storeu_pd(value + i, max);
+    }
+#endif
+  }
+
+  for (; i < size; i++) {
     double red, green, blue;
     double h, s, v;
     double min, max;
@@ -4661,6 +4887,25 @@ void vpImageConvert::RGB2HSV(const unsigned char *rgb, double *hue, double *satu
   }
 }
 
+void vpImageConvert::RGB2HSV(const unsigned char *rgb, unsigned char *hue, unsigned char *saturation,
+                             unsigned char *value, const unsigned int size, const unsigned int step)
+{
+  // Convert by blocks of pixels so that the intermediate values stay in cache
+  const unsigned int blockSize = 256;
+  double h[blockSize], s[blockSize], v[blockSize];
+
+  for (unsigned int i = 0; i < size; i += blockSize) {
+    const unsigned int n = std::min(blockSize, size - i);
+    RGB2HSV(rgb + i * step, h, s, v, n, step);
+
+    for (unsigned int k = 0; k < n; k++) {
+      hue[i + k] = (unsigned char)(255.0 * h[k]);
+      saturation[i + k] = (unsigned char)(255.0 * s[k]);
+      value[i + k] = (unsigned char)(255.0 * v[k]);
+    }
+  }
+}
+
 /*!
   Converts an array of hue, saturation and value to an array of RGBa values.
 
@@ -4732,14 +4977,7 @@ void vpImageConvert::RGBaToHSV(const unsigned char *rgba, double *hue, double *s
 void vpImageConvert::RGBaToHSV(const unsigned char *rgba, unsigned char *hue, unsigned char *saturation,
                                unsigned char *value, const unsigned int size)
 {
-  for (unsigned int i = 0; i < size; i++) {
-    double h, s, v;
-    vpImageConvert::RGBaToHSV((rgba + i * 4), &h, &s, &v, 1);
-
-    hue[i] = (unsigned char)(255.0 * h);
-    saturation[i] = (unsigned char)(255.0 * s);
-    value[i] = (unsigned char)(255.0 * v);
-  }
+  vpImageConvert::RGB2HSV(rgba, hue, saturation, value, size, 4);
 }
 
 /*!
@@ -4805,13 +5043,5 @@ void vpImageConvert::RGBToHSV(const unsigned char *rgb, double *hue, double *sat
 void vpImageConvert::RGBToHSV(const unsigned char *rgb, unsigned char *hue, unsigned char *saturation,
                               unsigned char *value, const unsigned int size)
 {
-  for (unsigned int i = 0; i < size; i++) {
-    double h, s, v;
-
-    vpImageConvert::RGBToHSV((rgb + i * 3), &h, &s, &v, 1);
-
-    hue[i] = (unsigned char)(255.0 * h);
-    saturation[i] = (unsigned char)(255.0 * s);
-    value[i] = (unsigned char)(255.0 * v);
-  }
+  vpImageConvert::RGB2HSV(rgb, hue, saturation, value, size, 3);
 }
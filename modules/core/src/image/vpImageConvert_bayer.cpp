@@ -0,0 +1,720 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Bayer demosaicing.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpImageConvert_bayer.cpp
+  \brief Convert raw Bayer images to color or grey images.
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpThreadPool.h>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Images of at least this number of pixels are demosaiced by bands of rows
+// on the workers of vpThreadPool
+const unsigned int bayerMinSizeForThreads = 640 * 480;
+
+// Number of pixels of a band processed by a thread at once
+const unsigned int bayerGrainSize = 1 << 15;
+
+void runRows(vpParallelForBody &body, unsigned int width, unsigned int height)
+{
+  if (width * height >= bayerMinSizeForThreads) {
+    int grain = static_cast<int>(std::max(1u, bayerGrainSize / width));
+    vpThreadPool::instance().parallel_for(0, (int)height, body, grain);
+  } else {
+    body(0, (int)height);
+  }
+}
+
+// Mirror an index over the borders without repeating the border pixel, so
+// that the parity of the index, thus the Bayer color, is kept
+inline int mirror(int i, int n) { return i < 0 ? -i : (i >= n ? 2 * n - 2 - i : i); }
+
+inline unsigned char saturate(int v) { return static_cast<unsigned char>(v < 0 ? 0 : (v > 255 ? 255 : v)); }
+
+/*
+  Color layout of a row. The color sites are the red pixels of a red row and
+  the blue pixels of a blue row, the other pixels being green. The channel of
+  the color sites in the RGBa output is m_channel, the channel of the
+  opposite color is 2 - m_channel.
+*/
+struct vpBayerRow {
+  vpBayerRow(vpImageConvert::vpBayerPatternType pattern, int i)
+  {
+    // Position of the red pixel in the top-left 2x2 block
+    int ry = (pattern == vpImageConvert::BAYER_GBRG || pattern == vpImageConvert::BAYER_BGGR) ? 1 : 0;
+    int rx = (pattern == vpImageConvert::BAYER_GRBG || pattern == vpImageConvert::BAYER_BGGR) ? 1 : 0;
+    bool redRow = (i & 1) == ry;
+    m_channel = redRow ? 0 : 2;
+    m_colorParity = redRow ? rx : 1 - rx;
+  }
+
+  bool isColorSite(int j) const { return (j & 1) == m_colorParity; }
+
+  int m_channel;
+  int m_colorParity;
+};
+
+/*
+  Bilinear interpolation of the pixel j of a row. rows[0], rows[1] and
+  rows[2] are the rows i-1, i and i+1 of the mosaic.
+*/
+inline void bilinearPixel(const unsigned char *const *rows, int j, int width, const vpBayerRow &layout,
+                          unsigned char *rgba)
+{
+  const int l = mirror(j - 1, width), r = mirror(j + 1, width);
+  const int cc = layout.m_channel;
+  if (layout.isColorSite(j)) {
+    rgba[cc] = rows[1][j];
+    rgba[1] = static_cast<unsigned char>((rows[0][j] + rows[2][j] + rows[1][l] + rows[1][r] + 2) >> 2);
+    rgba[2 - cc] = static_cast<unsigned char>((rows[0][l] + rows[0][r] + rows[2][l] + rows[2][r] + 2) >> 2);
+  } else {
+    rgba[cc] = static_cast<unsigned char>((rows[1][l] + rows[1][r] + 1) >> 1);
+    rgba[1] = rows[1][j];
+    rgba[2 - cc] = static_cast<unsigned char>((rows[0][j] + rows[2][j] + 1) >> 1);
+  }
+  rgba[3] = vpRGBa::alpha_default;
+}
+
+/*
+  Green value of the color site j of a row, interpolated along the direction
+  of the smallest gradient with a second-order correction from the color
+  site (Hamilton-Adams). rows[0] to rows[4] are the rows i-2 to i+2.
+*/
+inline unsigned char edgeAwareGreen(const unsigned char *const *rows, int j, int width)
+{
+  const int c = rows[2][j];
+  const int l1 = rows[2][mirror(j - 1, width)], r1 = rows[2][mirror(j + 1, width)];
+  const int l2 = rows[2][mirror(j - 2, width)], r2 = rows[2][mirror(j + 2, width)];
+  const int u1 = rows[1][j], d1 = rows[3][j], u2 = rows[0][j], d2 = rows[4][j];
+
+  const int lapH = 2 * c - l2 - r2, lapV = 2 * c - u2 - d2;
+  const int dH = std::abs(l1 - r1) + std::abs(lapH);
+  const int dV = std::abs(u1 - d1) + std::abs(lapV);
+  const int gH = (2 * (l1 + r1) + lapH + 2) >> 2;
+  const int gV = (2 * (u1 + d1) + lapV + 2) >> 2;
+
+  return saturate(dH < dV ? gH : (dV < dH ? gV : (gH + gV + 1) >> 1));
+}
+
+/*
+  Red and blue of the pixel j of a row interpolated from the differences
+  with the green plane. rows and greens are the rows i-1, i and i+1 of the
+  mosaic and of the green plane.
+*/
+inline void edgeAwarePixel(const unsigned char *const *rows, const unsigned char *const *greens, int j, int width,
+                           const vpBayerRow &layout, unsigned char *rgba)
+{
+  const int l = mirror(j - 1, width), r = mirror(j + 1, width);
+  const int cc = layout.m_channel;
+  const int g = greens[1][j];
+  if (layout.isColorSite(j)) {
+    const int diag = rows[0][l] - greens[0][l] + rows[0][r] - greens[0][r] + rows[2][l] - greens[2][l] + rows[2][r] -
+                     greens[2][r];
+    rgba[cc] = rows[1][j];
+    rgba[1] = static_cast<unsigned char>(g);
+    rgba[2 - cc] = saturate(g + ((diag + 2) >> 2));
+  } else {
+    const int h = rows[1][l] - greens[1][l] + rows[1][r] - greens[1][r];
+    const int v = rows[0][j] - greens[0][j] + rows[2][j] - greens[2][j];
+    rgba[cc] = saturate(g + ((h + 1) >> 1));
+    rgba[1] = static_cast<unsigned char>(g);
+    rgba[2 - cc] = saturate(g + ((v + 1) >> 1));
+  }
+  rgba[3] = vpRGBa::alpha_default;
+}
+
+// Luminance (R + 2 G + B) / 4 of the pixel j, given by the 3x3 binomial
+// filter whatever the color of the pixel
+inline unsigned char greyPixel(const unsigned char *const *rows, int j, int width)
+{
+  const int l = mirror(j - 1, width), r = mirror(j + 1, width);
+  const int sum = rows[0][l] + 2 * rows[0][j] + rows[0][r] + 2 * (rows[1][l] + 2 * rows[1][j] + rows[1][r]) +
+                  rows[2][l] + 2 * rows[2][j] + rows[2][r];
+  return static_cast<unsigned char>((sum + 8) >> 4);
+}
+
+#if VISP_HAVE_SSE2
+inline void storeRGBa16(unsigned char *rgba, const __m128i &r, const __m128i &g, const __m128i &b, const __m128i &a)
+{
+  const __m128i rg_lo = _mm_unpacklo_epi8(r, g);
+  const __m128i rg_hi = _mm_unpackhi_epi8(r, g);
+  const __m128i ba_lo = _mm_unpacklo_epi8(b, a);
+  const __m128i ba_hi = _mm_unpackhi_epi8(b, a);
+
+  _mm_storeu_si128((__m128i *)rgba, _mm_unpacklo_epi16(rg_lo, ba_lo));
+  _mm_storeu_si128((__m128i *)(rgba + 16), _mm_unpackhi_epi16(rg_lo, ba_lo));
+  _mm_storeu_si128((__m128i *)(rgba + 32), _mm_unpacklo_epi16(rg_hi, ba_hi));
+  _mm_storeu_si128((__m128i *)(rgba + 48), _mm_unpackhi_epi16(rg_hi, ba_hi));
+}
+
+inline __m128i select(const __m128i &mask, const __m128i &a, const __m128i &b)
+{
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+inline __m128i load(const unsigned char *p) { return _mm_loadu_si128((const __m128i *)p); }
+
+// 16 unsigned char values widened to two vectors of 8 16-bit values
+struct vpWide {
+  explicit vpWide(const __m128i &v)
+    : lo(_mm_unpacklo_epi8(v, _mm_setzero_si128())), hi(_mm_unpackhi_epi8(v, _mm_setzero_si128()))
+  {
+  }
+  vpWide(const __m128i &l, const __m128i &h) : lo(l), hi(h) {}
+
+  __m128i lo, hi;
+};
+
+inline vpWide operator+(const vpWide &a, const vpWide &b)
+{
+  return vpWide(_mm_add_epi16(a.lo, b.lo), _mm_add_epi16(a.hi, b.hi));
+}
+inline vpWide operator-(const vpWide &a, const vpWide &b)
+{
+  return vpWide(_mm_sub_epi16(a.lo, b.lo), _mm_sub_epi16(a.hi, b.hi));
+}
+inline vpWide addConst(const vpWide &a, short c)
+{
+  return vpWide(_mm_add_epi16(a.lo, _mm_set1_epi16(c)), _mm_add_epi16(a.hi, _mm_set1_epi16(c)));
+}
+inline vpWide shiftRight(const vpWide &a, int n)
+{
+  return vpWide(_mm_srai_epi16(a.lo, n), _mm_srai_epi16(a.hi, n));
+}
+inline vpWide absolute(const vpWide &a)
+{
+  const __m128i zero = _mm_setzero_si128();
+  return vpWide(_mm_max_epi16(a.lo, _mm_sub_epi16(zero, a.lo)), _mm_max_epi16(a.hi, _mm_sub_epi16(zero, a.hi)));
+}
+// Saturated narrowing to 16 unsigned char values
+inline __m128i narrow(const vpWide &a) { return _mm_packus_epi16(a.lo, a.hi); }
+
+// Mask of the bytes of the color sites for 16 pixels starting at an even column
+inline __m128i colorSiteMask(const vpBayerRow &layout)
+{
+  const __m128i even = _mm_set1_epi16(0x00FF);
+  return layout.m_colorParity == 0 ? even : _mm_xor_si128(even, _mm_set1_epi8(-1));
+}
+#endif
+
+/*
+  Bilinear demosaicing of rows [begin, end).
+*/
+class vpBayerBilinearBody : public vpParallelForBody
+{
+public:
+  vpBayerBilinearBody(const unsigned char *bayer, unsigned char *rgba, unsigned int width, unsigned int height,
+                      vpImageConvert::vpBayerPatternType pattern, bool useSSE2)
+    : m_bayer(bayer), m_rgba(rgba), m_width((int)width), m_height((int)height), m_pattern(pattern),
+      m_useSSE2(useSSE2)
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    for (int i = begin; i < end; i++) {
+      const unsigned char *rows[3];
+      for (int k = 0; k < 3; k++) {
+        rows[k] = m_bayer + mirror(i + k - 1, m_height) * m_width;
+      }
+      unsigned char *dst = m_rgba + 4 * i * m_width;
+      const vpBayerRow layout(m_pattern, i);
+      int j = 0;
+
+      for (; j < std::min(2, m_width); j++) {
+        bilinearPixel(rows, j, m_width, layout, dst + 4 * j);
+      }
+
+#if VISP_HAVE_SSE2
+      if (m_useSSE2) {
+        const __m128i mask = colorSiteMask(layout);
+        const __m128i alpha = _mm_set1_epi8((char)vpRGBa::alpha_default);
+        for (; j + 17 <= m_width; j += 16) {
+          const __m128i c = load(rows[1] + j);
+          const __m128i u = load(rows[0] + j), d = load(rows[2] + j);
+          const __m128i l = load(rows[1] + j - 1), r = load(rows[1] + j + 1);
+          const vpWide cross = shiftRight(addConst(vpWide(u) + vpWide(d) + vpWide(l) + vpWide(r), 2), 2);
+          const vpWide diag = shiftRight(addConst(vpWide(load(rows[0] + j - 1)) + vpWide(load(rows[0] + j + 1)) +
+                                                      vpWide(load(rows[2] + j - 1)) + vpWide(load(rows[2] + j + 1)),
+                                                  2),
+                                         2);
+
+          __m128i ch[3];
+          ch[layout.m_channel] = select(mask, c, _mm_avg_epu8(l, r));
+          ch[1] = select(mask, narrow(cross), c);
+          ch[2 - layout.m_channel] = select(mask, narrow(diag), _mm_avg_epu8(u, d));
+          storeRGBa16(dst + 4 * j, ch[0], ch[1], ch[2], alpha);
+        }
+      }
+#endif
+
+      for (; j < m_width; j++) {
+        bilinearPixel(rows, j, m_width, layout, dst + 4 * j);
+      }
+    }
+  }
+
+private:
+  const unsigned char *m_bayer;
+  unsigned char *m_rgba;
+  int m_width, m_height;
+  vpImageConvert::vpBayerPatternType m_pattern;
+  bool m_useSSE2;
+};
+
+/*
+  First pass of the edge-aware demosaicing: green plane of rows [begin, end).
+*/
+class vpBayerGreenBody : public vpParallelForBody
+{
+public:
+  vpBayerGreenBody(const unsigned char *bayer, unsigned char *green, unsigned int width, unsigned int height,
+                   vpImageConvert::vpBayerPatternType pattern, bool useSSE2)
+    : m_bayer(bayer), m_green(green), m_width((int)width), m_height((int)height), m_pattern(pattern),
+      m_useSSE2(useSSE2)
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    for (int i = begin; i < end; i++) {
+      const unsigned char *rows[5];
+      for (int k = 0; k < 5; k++) {
+        rows[k] = m_bayer + mirror(i + k - 2, m_height) * m_width;
+      }
+      unsigned char *dst = m_green + i * m_width;
+      const vpBayerRow layout(m_pattern, i);
+      int j = 0;
+
+      for (; j < std::min(2, m_width); j++) {
+        dst[j] = layout.isColorSite(j) ? edgeAwareGreen(rows, j, m_width) : rows[2][j];
+      }
+
+#if VISP_HAVE_SSE2
+      if (m_useSSE2) {
+        const __m128i mask = colorSiteMask(layout);
+        for (; j + 18 <= m_width; j += 16) {
+          const __m128i c8 = load(rows[2] + j);
+          const vpWide c(c8);
+          const vpWide l1(load(rows[2] + j - 1)), r1(load(rows[2] + j + 1));
+          const vpWide l2(load(rows[2] + j - 2)), r2(load(rows[2] + j + 2));
+          const vpWide u1(load(rows[1] + j)), d1(load(rows[3] + j));
+          const vpWide u2(load(rows[0] + j)), d2(load(rows[4] + j));
+
+          const vpWide lapH = c + c - l2 - r2, lapV = c + c - u2 - d2;
+          const vpWide dH = absolute(l1 - r1) + absolute(lapH);
+          const vpWide dV = absolute(u1 - d1) + absolute(lapV);
+          const vpWide sumH = l1 + r1, sumV = u1 + d1;
+          const vpWide gH = shiftRight(addConst(sumH + sumH + lapH, 2), 2);
+          const vpWide gV = shiftRight(addConst(sumV + sumV + lapV, 2), 2);
+          const vpWide gHV = shiftRight(addConst(gH + gV, 1), 1);
+
+          vpWide g(gHV);
+          g.lo = select(_mm_cmplt_epi16(dV.lo, dH.lo), gV.lo, g.lo);
+          g.hi = select(_mm_cmplt_epi16(dV.hi, dH.hi), gV.hi, g.hi);
+          g.lo = select(_mm_cmplt_epi16(dH.lo, dV.lo), gH.lo, g.lo);
+          g.hi = select(_mm_cmplt_epi16(dH.hi, dV.hi), gH.hi, g.hi);
+
+          _mm_storeu_si128((__m128i *)(dst + j), select(mask, narrow(g), c8));
+        }
+      }
+#endif
+
+      for (; j < m_width; j++) {
+        dst[j] = layout.isColorSite(j) ? edgeAwareGreen(rows, j, m_width) : rows[2][j];
+      }
+    }
+  }
+
+private:
+  const unsigned char *m_bayer;
+  unsigned char *m_green;
+  int m_width, m_height;
+  vpImageConvert::vpBayerPatternType m_pattern;
+  bool m_useSSE2;
+};
+
+/*
+  Second pass of the edge-aware demosaicing: red and blue of rows
+  [begin, end) from the green plane.
+*/
+class vpBayerEdgeAwareBody : public vpParallelForBody
+{
+public:
+  vpBayerEdgeAwareBody(const unsigned char *bayer, const unsigned char *green, unsigned char *rgba, unsigned int width,
+                       unsigned int height, vpImageConvert::vpBayerPatternType pattern, bool useSSE2)
+    : m_bayer(bayer), m_green(green), m_rgba(rgba), m_width((int)width), m_height((int)height), m_pattern(pattern),
+      m_useSSE2(useSSE2)
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    for (int i = begin; i < end; i++) {
+      const unsigned char *rows[3], *greens[3];
+      for (int k = 0; k < 3; k++) {
+        rows[k] = m_bayer + mirror(i + k - 1, m_height) * m_width;
+        greens[k] = m_green + mirror(i + k - 1, m_height) * m_width;
+      }
+      unsigned char *dst = m_rgba + 4 * i * m_width;
+      const vpBayerRow layout(m_pattern, i);
+      int j = 0;
+
+      for (; j < std::min(2, m_width); j++) {
+        edgeAwarePixel(rows, greens, j, m_width, layout, dst + 4 * j);
+      }
+
+#if VISP_HAVE_SSE2
+      if (m_useSSE2) {
+        const __m128i mask = colorSiteMask(layout);
+        const __m128i alpha = _mm_set1_epi8((char)vpRGBa::alpha_default);
+        for (; j + 17 <= m_width; j += 16) {
+          const __m128i c = load(rows[1] + j);
+          const __m128i g8 = load(greens[1] + j);
+          const vpWide g(g8);
+          // Color differences with the green plane of the neighbours
+          const vpWide dl = vpWide(load(rows[1] + j - 1)) - vpWide(load(greens[1] + j - 1));
+          const vpWide dr = vpWide(load(rows[1] + j + 1)) - vpWide(load(greens[1] + j + 1));
+          const vpWide du = vpWide(load(rows[0] + j)) - vpWide(load(greens[0] + j));
+          const vpWide dd = vpWide(load(rows[2] + j)) - vpWide(load(greens[2] + j));
+          const vpWide dul = vpWide(load(rows[0] + j - 1)) - vpWide(load(greens[0] + j - 1));
+          const vpWide dur = vpWide(load(rows[0] + j + 1)) - vpWide(load(greens[0] + j + 1));
+          const vpWide ddl = vpWide(load(rows[2] + j - 1)) - vpWide(load(greens[2] + j - 1));
+          const vpWide ddr = vpWide(load(rows[2] + j + 1)) - vpWide(load(greens[2] + j + 1));
+
+          const __m128i h = narrow(g + shiftRight(addConst(dl + dr, 1), 1));
+          const __m128i v = narrow(g + shiftRight(addConst(du + dd, 1), 1));
+          const __m128i diag = narrow(g + shiftRight(addConst(dul + dur + ddl + ddr, 2), 2));
+
+          __m128i ch[3];
+          ch[layout.m_channel] = select(mask, c, h);
+          ch[1] = g8;
+          ch[2 - layout.m_channel] = select(mask, diag, v);
+          storeRGBa16(dst + 4 * j, ch[0], ch[1], ch[2], alpha);
+        }
+      }
+#endif
+
+      for (; j < m_width; j++) {
+        edgeAwarePixel(rows, greens, j, m_width, layout, dst + 4 * j);
+      }
+    }
+  }
+
+private:
+  const unsigned char *m_bayer;
+  const unsigned char *m_green;
+  unsigned char *m_rgba;
+  int m_width, m_height;
+  vpImageConvert::vpBayerPatternType m_pattern;
+  bool m_useSSE2;
+};
+
+/*
+  Luminance of rows [begin, end).
+*/
+class vpBayerGreyBody : public vpParallelForBody
+{
+public:
+  vpBayerGreyBody(const unsigned char *bayer, unsigned char *grey, unsigned int width, unsigned int height,
+                  bool useSSE2)
+    : m_bayer(bayer), m_grey(grey), m_width((int)width), m_height((int)height), m_useSSE2(useSSE2)
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    for (int i = begin; i < end; i++) {
+      const unsigned char *rows[3];
+      for (int k = 0; k < 3; k++) {
+        rows[k] = m_bayer + mirror(i + k - 1, m_height) * m_width;
+      }
+      unsigned char *dst = m_grey + i * m_width;
+      int j = 0;
+
+      for (; j < std::min(1, m_width); j++) {
+        dst[j] = greyPixel(rows, j, m_width);
+      }
+
+#if VISP_HAVE_SSE2
+      if (m_useSSE2) {
+        for (; j + 17 <= m_width; j += 16) {
+          // Vertical [1 2 1] filter of the columns j-1, j and j+1
+          vpWide v[3] = {vpWide(_mm_setzero_si128()), vpWide(_mm_setzero_si128()), vpWide(_mm_setzero_si128())};
+          for (int k = 0; k < 3; k++) {
+            const vpWide c(load(rows[1] + j + k - 1));
+            v[k] = vpWide(load(rows[0] + j + k - 1)) + c + c + vpWide(load(rows[2] + j + k - 1));
+          }
+          const vpWide sum = v[0] + v[1] + v[1] + v[2];
+          _mm_storeu_si128((__m128i *)(dst + j), narrow(shiftRight(addConst(sum, 8), 4)));
+        }
+      }
+#endif
+
+      for (; j < m_width; j++) {
+        dst[j] = greyPixel(rows, j, m_width);
+      }
+    }
+  }
+
+private:
+  const unsigned char *m_bayer;
+  unsigned char *m_grey;
+  int m_width, m_height;
+  bool m_useSSE2;
+};
+
+/*
+  Conversion of 16-bit raw values of bitDepth significant bits to 8 bits,
+  by rows [begin, end).
+*/
+class vpBayer16To8Body : public vpParallelForBody
+{
+public:
+  vpBayer16To8Body(const uint16_t *src, unsigned char *dst, unsigned int width, unsigned int bitDepth, bool useSSE2)
+    : m_src(src), m_dst(dst), m_width(width), m_shift(bitDepth - 8), m_useSSE2(useSSE2)
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    const uint16_t *src = m_src + begin * m_width;
+    unsigned char *dst = m_dst + begin * m_width;
+    const unsigned int size = (unsigned int)(end - begin) * m_width;
+    unsigned int i = 0;
+
+#if VISP_HAVE_SSE2
+    if (m_useSSE2) {
+      const __m128i shift = _mm_cvtsi32_si128((int)m_shift);
+      const __m128i max = _mm_set1_epi16(255);
+      for (; i + 16 <= size; i += 16) {
+        __m128i a = _mm_srl_epi16(_mm_loadu_si128((const __m128i *)(src + i)), shift);
+        __m128i b = _mm_srl_epi16(_mm_loadu_si128((const __m128i *)(src + i + 8)), shift);
+        // min(x, 255) with unsigned saturated arithmetic
+        a = _mm_sub_epi16(a, _mm_subs_epu16(a, max));
+        b = _mm_sub_epi16(b, _mm_subs_epu16(b, max));
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi16(a, b));
+      }
+    }
+#endif
+
+    for (; i < size; i++) {
+      dst[i] = static_cast<unsigned char>(std::min(255, src[i] >> m_shift));
+    }
+  }
+
+private:
+  const uint16_t *m_src;
+  unsigned char *m_dst;
+  unsigned int m_width;
+  unsigned int m_shift;
+  bool m_useSSE2;
+};
+
+void checkBayerSize(unsigned int width, unsigned int height)
+{
+  if (width < 3 || height < 3) {
+    throw(vpException(vpException::dimensionError, "Cannot demosaic a %dx%d Bayer image, 3x3 at least expected", width,
+                      height));
+  }
+}
+
+void checkBitDepth(unsigned int bitDepth)
+{
+  if (bitDepth < 8 || bitDepth > 16) {
+    throw(vpException(vpException::badValue, "Bayer bit depth %d not in [8, 16]", bitDepth));
+  }
+}
+
+bool useSSE2()
+{
+#if VISP_HAVE_SSE2
+  return vpCPUFeatures::checkSSE2();
+#else
+  return false;
+#endif
+}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Demosaic a raw 8-bit Bayer image into a RGBa image. Destination rgba
+  memory area of width x height pixels has to be allocated before.
+
+  The bilinear method averages the nearest pixels of the missing color. The
+  edge-aware method first interpolates the green along the direction of the
+  smallest gradient, corrected by the curvature of the color of the pixel,
+  and then the red and blue from their differences with the green. It
+  reduces the zipper artifacts and false colors along the edges at about
+  twice the cost. Image borders are mirrored.
+
+  The alpha component of the converted image is set to vpRGBa::alpha_default.
+
+  \code
+#include <visp3/core/vpImageConvert.h>
+
+int main()
+{
+  unsigned int width = 640, height = 480;
+  std::vector<unsigned char> raw(width * height); // Frame from the camera
+  vpImage<vpRGBa> I(height, width);
+
+  vpImageConvert::BayerToRGBa(&raw[0], reinterpret_cast<unsigned char *>(I.bitmap), width, height,
+                              vpImageConvert::BAYER_RGGB, vpImageConvert::DEMOSAIC_EDGE_AWARE);
+}
+  \endcode
+
+  \param bayer : Raw image, one byte per pixel.
+  \param rgba : Destination RGBa image.
+  \param width, height : Image size, at least 3x3.
+  \param pattern : Color filter arrangement of the sensor.
+  \param method : Interpolation method.
+
+  \sa BayerToGrey()
+*/
+void vpImageConvert::BayerToRGBa(const unsigned char *bayer, unsigned char *rgba, unsigned int width,
+                                 unsigned int height, vpBayerPatternType pattern, vpDemosaicMethodType method)
+{
+  checkBayerSize(width, height);
+
+  if (method == DEMOSAIC_EDGE_AWARE) {
+    std::vector<unsigned char> green(width * height);
+    vpBayerGreenBody greenBody(bayer, &green[0], width, height, pattern, useSSE2());
+    runRows(greenBody, width, height);
+
+    vpBayerEdgeAwareBody body(bayer, &green[0], rgba, width, height, pattern, useSSE2());
+    runRows(body, width, height);
+  } else {
+    vpBayerBilinearBody body(bayer, rgba, width, height, pattern, useSSE2());
+    runRows(body, width, height);
+  }
+}
+
+/*!
+  Demosaic a raw 16-bit Bayer image into a RGBa image. Destination rgba
+  memory area of width x height pixels has to be allocated before.
+
+  The values are first reduced to 8 bits by keeping their 8 most significant
+  bits among \e bitDepth, then the image is demosaiced as with the 8-bit
+  version.
+
+  \param bayer : Raw image, one 16-bit value per pixel.
+  \param rgba : Destination RGBa image.
+  \param width, height : Image size, at least 3x3.
+  \param pattern : Color filter arrangement of the sensor.
+  \param method : Interpolation method.
+  \param bitDepth : Number of significant bits of the raw values, between 8
+  and 16, for instance 12 for a 12-bit sensor.
+
+  \sa BayerToRGBa(const unsigned char *, unsigned char *, unsigned int, unsigned int, vpBayerPatternType, vpDemosaicMethodType)
+*/
+void vpImageConvert::BayerToRGBa(const uint16_t *bayer, unsigned char *rgba, unsigned int width, unsigned int height,
+                                 vpBayerPatternType pattern, vpDemosaicMethodType method, unsigned int bitDepth)
+{
+  checkBayerSize(width, height);
+  checkBitDepth(bitDepth);
+
+  std::vector<unsigned char> bayer8(width * height);
+  vpBayer16To8Body body(bayer, &bayer8[0], width, bitDepth, useSSE2());
+  runRows(body, width, height);
+
+  BayerToRGBa(&bayer8[0], rgba, width, height, pattern, method);
+}
+
+/*!
+  Compute the grey image of a raw 8-bit Bayer image without reconstructing
+  the colors. Destination grey memory area of width x height pixels has to
+  be allocated before.
+
+  Each grey value is the luminance (R + 2G + B) / 4 given by the 3x3
+  binomial filter of the mosaic, that weights the colors the same way at
+  every pixel. The result does therefore not depend on the Bayer pattern.
+  Image borders are mirrored.
+
+  \param bayer : Raw image, one byte per pixel.
+  \param grey : Destination grey image.
+  \param width, height : Image size, at least 3x3.
+
+  \sa BayerToRGBa()
+*/
+void vpImageConvert::BayerToGrey(const unsigned char *bayer, unsigned char *grey, unsigned int width,
+                                 unsigned int height)
+{
+  checkBayerSize(width, height);
+
+  vpBayerGreyBody body(bayer, grey, width, height, useSSE2());
+  runRows(body, width, height);
+}
+
+/*!
+  Compute the grey image of a raw 16-bit Bayer image without reconstructing
+  the colors. Destination grey memory area of width x height pixels has to
+  be allocated before.
+
+  \param bayer : Raw image, one 16-bit value per pixel.
+  \param grey : Destination grey image.
+  \param width, height : Image size, at least 3x3.
+  \param bitDepth : Number of significant bits of the raw values, between 8
+  and 16.
+
+  \sa BayerToGrey(const unsigned char *, unsigned char *, unsigned int, unsigned int)
+*/
+void vpImageConvert::BayerToGrey(const uint16_t *bayer, unsigned char *grey, unsigned int width, unsigned int height,
+                                 unsigned int bitDepth)
+{
+  checkBayerSize(width, height);
+  checkBitDepth(bitDepth);
+
+  std::vector<unsigned char> bayer8(width * height);
+  vpBayer16To8Body body(bayer, &bayer8[0], width, bitDepth, useSSE2());
+  runRows(body, width, height);
+
+  BayerToGrey(&bayer8[0], grey, width, height);
+}
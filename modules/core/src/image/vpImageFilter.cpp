@@ -36,9 +36,14 @@
  *
  *****************************************************************************/
 
+#include <algorithm>
+#include <vector>
+
+#include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpImageConvert.h>
 #include <visp3/core/vpImageFilter.h>
 #include <visp3/core/vpRGBa.h>
+#include <visp3/core/vpThreadPool.h>
 #if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408)
 #include <opencv2/imgproc/imgproc.hpp>
 #elif defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020101)
@@ -47,6 +52,492 @@
 #include <cv.h>
 #endif
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Separable filtering engine. A 1D kernel of size 2h+1 is given by its h+1
+// first coefficients: f[0] is the central one and f[i] is applied to both
+// neighbours at distance i. It is either symmetric
+//   dst[k] = sum_{i=1..h} f[i] * (src[k+i] + src[k-i]) + f[0] * src[k]
+// or antisymmetric (derivative kernels)
+//   dst[k] = sum_{i=1..h} f[i] * (src[k+i] - src[k-i])
+// The sums are accumulated tap by tap over contiguous row segments. The
+// per-pixel order of the operations is the same as in the per-pixel inline
+// functions of vpImageFilter, so that the results are bitwise identical,
+// while the inner loops are vectorized. Borders are processed apart.
+
+// Number of columns processed at once by the vertical pass, the
+// accumulators of a tile stay in cache while all the taps are applied
+const unsigned int filterTileWidth = 1024;
+
+// Minimal number of pixels for a pass to be split in row bands processed by
+// several threads
+const int filterMinSizeForThreads = 320 * 240;
+
+// Mirror an index that is outside [0, n-1] as done by the filter*Border()
+// functions: -k -> k on the first side, n-1+k -> n-k on the last one
+inline unsigned int reflectIndex(int k, int n)
+{
+  if (k < 0) {
+    k = -k;
+  }
+  if (k >= n) {
+    k = 2 * n - k - 1;
+  }
+  return static_cast<unsigned int>(vpMath::maximum(0, vpMath::minimum(k, n - 1)));
+}
+
+// dst[k] += coef * (a[k] + b[k]) or dst[k] += coef * (a[k] - b[k]) when
+// derivative is true. When b is NULL: dst[k] += coef * a[k]
+template <typename Tin, typename Tacc>
+void accumulateTap(Tacc *dst, const Tin *a, const Tin *b, Tacc coef, bool derivative, unsigned int n, bool)
+{
+  if (b == NULL) {
+    for (unsigned int k = 0; k < n; k++) {
+      dst[k] += static_cast<Tacc>(coef * a[k]);
+    }
+  } else if (derivative) {
+    for (unsigned int k = 0; k < n; k++) {
+      dst[k] += static_cast<Tacc>(coef * (static_cast<Tacc>(a[k]) - static_cast<Tacc>(b[k])));
+    }
+  } else {
+    for (unsigned int k = 0; k < n; k++) {
+      dst[k] += static_cast<Tacc>(coef * (static_cast<Tacc>(a[k]) + static_cast<Tacc>(b[k])));
+    }
+  }
+}
+
+#if VISP_HAVE_SSE2
+// Convert 8 unsigned char of a and b into a + b or a - b as 16 bits integers
+inline __m128i loadTap8(const unsigned char *a, const unsigned char *b, bool derivative)
+{
+  const __m128i zero = _mm_setzero_si128();
+  __m128i v = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)a), zero);
+  if (b != NULL) {
+    __m128i w = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)b), zero);
+    v = derivative ? _mm_sub_epi16(v, w) : _mm_add_epi16(v, w);
+  }
+  return v;
+}
+
+void accumulateTap(double *dst, const double *a, const double *b, double coef, bool derivative, unsigned int n,
+                   bool useSSE2)
+{
+  unsigned int k = 0;
+  if (useSSE2) {
+    const __m128d v_coef = _mm_set1_pd(coef);
+    for (; k + 2 <= n; k += 2) {
+      __m128d v = _mm_loadu_pd(a + k);
+      if (b != NULL) {
+        v = derivative ? _mm_sub_pd(v, _mm_loadu_pd(b + k)) : _mm_add_pd(v, _mm_loadu_pd(b + k));
+      }
+      _mm_storeu_pd(dst + k, _mm_add_pd(_mm_loadu_pd(dst + k), _mm_mul_pd(v_coef, v)));
+    }
+  }
+  accumulateTap<double, double>(dst + k, a + k, b == NULL ? NULL : b + k, coef, derivative, n - k, false);
+}
+
+void accumulateTap(double *dst, const unsigned char *a, const unsigned char *b, double coef, bool derivative,
+                   unsigned int n, bool useSSE2)
+{
+  unsigned int k = 0;
+  if (useSSE2) {
+    const __m128d v_coef = _mm_set1_pd(coef);
+    for (; k + 8 <= n; k += 8) {
+      __m128i v = loadTap8(a + k, b == NULL ? NULL : b + k, derivative);
+      // Sign extension to 32 bits integers
+      __m128i sign = _mm_srai_epi16(v, 15);
+      __m128i lo = _mm_unpacklo_epi16(v, sign);
+      __m128i hi = _mm_unpackhi_epi16(v, sign);
+      _mm_storeu_pd(dst + k, _mm_add_pd(_mm_loadu_pd(dst + k), _mm_mul_pd(v_coef, _mm_cvtepi32_pd(lo))));
+      _mm_storeu_pd(dst + k + 2, _mm_add_pd(_mm_loadu_pd(dst + k + 2),
+                                            _mm_mul_pd(v_coef, _mm_cvtepi32_pd(_mm_srli_si128(lo, 8)))));
+      _mm_storeu_pd(dst + k + 4, _mm_add_pd(_mm_loadu_pd(dst + k + 4), _mm_mul_pd(v_coef, _mm_cvtepi32_pd(hi))));
+      _mm_storeu_pd(dst + k + 6, _mm_add_pd(_mm_loadu_pd(dst + k + 6),
+                                            _mm_mul_pd(v_coef, _mm_cvtepi32_pd(_mm_srli_si128(hi, 8)))));
+    }
+  }
+  accumulateTap<unsigned char, double>(dst + k, a + k, b == NULL ? NULL : b + k, coef, derivative, n - k, false);
+}
+
+void accumulateTap(float *dst, const float *a, const float *b, float coef, bool derivative, unsigned int n,
+                   bool useSSE2)
+{
+  unsigned int k = 0;
+  if (useSSE2) {
+    const __m128 v_coef = _mm_set1_ps(coef);
+    for (; k + 4 <= n; k += 4) {
+      __m128 v = _mm_loadu_ps(a + k);
+      if (b != NULL) {
+        v = derivative ? _mm_sub_ps(v, _mm_loadu_ps(b + k)) : _mm_add_ps(v, _mm_loadu_ps(b + k));
+      }
+      _mm_storeu_ps(dst + k, _mm_add_ps(_mm_loadu_ps(dst + k), _mm_mul_ps(v_coef, v)));
+    }
+  }
+  accumulateTap<float, float>(dst + k, a + k, b == NULL ? NULL : b + k, coef, derivative, n - k, false);
+}
+
+void accumulateTap(float *dst, const unsigned char *a, const unsigned char *b, float coef, bool derivative,
+                   unsigned int n, bool useSSE2)
+{
+  unsigned int k = 0;
+  if (useSSE2) {
+    const __m128 v_coef = _mm_set1_ps(coef);
+    for (; k + 8 <= n; k += 8) {
+      __m128i v = loadTap8(a + k, b == NULL ? NULL : b + k, derivative);
+      __m128i sign = _mm_srai_epi16(v, 15);
+      __m128 lo = _mm_cvtepi32_ps(_mm_unpacklo_epi16(v, sign));
+      __m128 hi = _mm_cvtepi32_ps(_mm_unpackhi_epi16(v, sign));
+      _mm_storeu_ps(dst + k, _mm_add_ps(_mm_loadu_ps(dst + k), _mm_mul_ps(v_coef, lo)));
+      _mm_storeu_ps(dst + k + 4, _mm_add_ps(_mm_loadu_ps(dst + k + 4), _mm_mul_ps(v_coef, hi)));
+    }
+  }
+  accumulateTap<unsigned char, float>(dst + k, a + k, b == NULL ? NULL : b + k, coef, derivative, n - k, false);
+}
+
+// Fixed-point horizontal pass, the products are computed on 32 bits
+void accumulateTap(unsigned int *dst, const unsigned char *a, const unsigned char *b, unsigned int coef,
+                   bool derivative, unsigned int n, bool useSSE2)
+{
+  unsigned int k = 0;
+  if (useSSE2 && !derivative) {
+    const __m128i v_coef = _mm_set1_epi16(static_cast<short>(coef));
+    for (; k + 8 <= n; k += 8) {
+      __m128i v = loadTap8(a + k, b == NULL ? NULL : b + k, false);
+      __m128i prod_lo = _mm_mullo_epi16(v, v_coef);
+      __m128i prod_hi = _mm_mulhi_epu16(v, v_coef);
+      _mm_storeu_si128((__m128i *)(dst + k),
+                       _mm_add_epi32(_mm_loadu_si128((const __m128i *)(dst + k)), _mm_unpacklo_epi16(prod_lo, prod_hi)));
+      _mm_storeu_si128((__m128i *)(dst + k + 4), _mm_add_epi32(_mm_loadu_si128((const __m128i *)(dst + k + 4)),
+                                                               _mm_unpackhi_epi16(prod_lo, prod_hi)));
+    }
+  }
+  accumulateTap<unsigned char, unsigned int>(dst + k, a + k, b == NULL ? NULL : b + k, coef, derivative, n - k,
+                                             false);
+}
+
+// Fixed-point vertical pass, the products are computed on 32 bits
+void accumulateTap(unsigned int *dst, const unsigned short *a, const unsigned short *b, unsigned int coef,
+                   bool derivative, unsigned int n, bool useSSE2)
+{
+  unsigned int k = 0;
+  if (useSSE2 && !derivative) {
+    const __m128i v_coef = _mm_set1_epi16(static_cast<short>(coef));
+    for (; k + 8 <= n; k += 8) {
+      __m128i lo = _mm_loadu_si128((const __m128i *)(dst + k));
+      __m128i hi = _mm_loadu_si128((const __m128i *)(dst + k + 4));
+      for (int side = 0; side < 2; side++) {
+        const unsigned short *src = (side == 0) ? a : b;
+        if (src == NULL) {
+          continue;
+        }
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + k));
+        __m128i prod_lo = _mm_mullo_epi16(v, v_coef);
+        __m128i prod_hi = _mm_mulhi_epu16(v, v_coef);
+        lo = _mm_add_epi32(lo, _mm_unpacklo_epi16(prod_lo, prod_hi));
+        hi = _mm_add_epi32(hi, _mm_unpackhi_epi16(prod_lo, prod_hi));
+      }
+      _mm_storeu_si128((__m128i *)(dst + k), lo);
+      _mm_storeu_si128((__m128i *)(dst + k + 4), hi);
+    }
+  }
+  accumulateTap<unsigned short, unsigned int>(dst + k, a + k, b == NULL ? NULL : b + k, coef, derivative, n - k,
+                                              false);
+}
+#endif
+
+// Value of a pixel close to the left or right border, the missing
+// neighbours are mirrored
+template <typename Tin, typename Tacc>
+Tacc filterBorderX(const Tin *src, int width, int c, const Tacc *filter, unsigned int half)
+{
+  Tacc result = 0;
+  for (unsigned int i = 1; i <= half; i++) {
+    result += filter[i] * (static_cast<Tacc>(src[reflectIndex(c + static_cast<int>(i), width)]) +
+                           static_cast<Tacc>(src[reflectIndex(c - static_cast<int>(i), width)]));
+  }
+  return result + filter[0] * src[c];
+}
+
+// Run the body over the rows of the image, on vpThreadPool for large images
+void runRows(vpParallelForBody &body, int height, unsigned int size)
+{
+  unsigned int nThreads = (static_cast<int>(size) >= filterMinSizeForThreads) ? 0 : 1;
+  vpThreadPool::instance().parallel_for(0, height, body, 1, nThreads);
+}
+
+// Horizontal pass over a band of rows. With a derivative kernel the border
+// columns are set to 0
+template <typename Tin, typename Tacc> class vpSeparableFilterXBody : public vpParallelForBody
+{
+public:
+  vpSeparableFilterXBody(const vpImageView<Tin> &I, vpImage<Tacc> &dst, const Tacc *filter, unsigned int half,
+                         bool derivative)
+    : m_I(I), m_dst(dst), m_filter(filter), m_half(half), m_derivative(derivative),
+      m_useSSE2(vpCPUFeatures::checkSSE2()), m_first(vpMath::minimum(half, I.getWidth())),
+      m_last(vpMath::maximum(I.getWidth() > half ? I.getWidth() - half : 0, m_first))
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    unsigned int width = m_I.getWidth();
+    for (int r = begin; r < end; r++) {
+      const Tin *src = m_I[r];
+      Tacc *out = m_dst[r];
+
+      if (m_last > m_first) {
+        unsigned int n = m_last - m_first;
+        std::fill(out + m_first, out + m_last, Tacc(0));
+        for (unsigned int i = 1; i <= m_half; i++) {
+          accumulateTap(out + m_first, src + m_first + i, src + m_first - i, m_filter[i], m_derivative, n,
+                        m_useSSE2);
+        }
+        if (!m_derivative) {
+          accumulateTap(out + m_first, src + m_first, static_cast<const Tin *>(NULL), m_filter[0], false, n,
+                        m_useSSE2);
+        }
+      }
+
+      for (unsigned int c = 0; c < m_first; c++) {
+        out[c] = m_derivative ? Tacc(0)
+                              : filterBorderX(src, static_cast<int>(width), static_cast<int>(c), m_filter, m_half);
+      }
+      for (unsigned int c = m_last; c < width; c++) {
+        out[c] = m_derivative ? Tacc(0)
+                              : filterBorderX(src, static_cast<int>(width), static_cast<int>(c), m_filter, m_half);
+      }
+    }
+  }
+
+private:
+  const vpImageView<Tin> &m_I;
+  vpImage<Tacc> &m_dst;
+  const Tacc *m_filter;
+  unsigned int m_half;
+  bool m_derivative;
+  bool m_useSSE2;
+  unsigned int m_first;
+  unsigned int m_last;
+};
+
+// Vertical pass over a band of rows. With a derivative kernel the border
+// rows are set to 0
+template <typename Tin, typename Tacc> class vpSeparableFilterYBody : public vpParallelForBody
+{
+public:
+  vpSeparableFilterYBody(const vpImageView<Tin> &I, vpImage<Tacc> &dst, const Tacc *filter, unsigned int half,
+                         bool derivative)
+    : m_I(I), m_dst(dst), m_filter(filter), m_half(static_cast<int>(half)), m_derivative(derivative),
+      m_useSSE2(vpCPUFeatures::checkSSE2())
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    int height = static_cast<int>(m_I.getHeight());
+    unsigned int width = m_I.getWidth();
+    for (int r = begin; r < end; r++) {
+      Tacc *out = m_dst[r];
+      if (m_derivative && (r < m_half || r >= height - m_half)) {
+        std::fill(out, out + width, Tacc(0));
+        continue;
+      }
+
+      for (unsigned int c0 = 0; c0 < width; c0 += filterTileWidth) {
+        unsigned int n = vpMath::minimum(filterTileWidth, width - c0);
+        std::fill(out + c0, out + c0 + n, Tacc(0));
+        for (int i = 1; i <= m_half; i++) {
+          // Mirrored rows are selected here, outside the inner loop
+          const Tin *up = m_I[reflectIndex(r + i, height)] + c0;
+          const Tin *down = m_I[reflectIndex(r - i, height)] + c0;
+          accumulateTap(out + c0, up, down, m_filter[i], m_derivative, n, m_useSSE2);
+        }
+        if (!m_derivative) {
+          accumulateTap(out + c0, m_I[r] + c0, static_cast<const Tin *>(NULL), m_filter[0], false, n, m_useSSE2);
+        }
+      }
+    }
+  }
+
+private:
+  const vpImageView<Tin> &m_I;
+  vpImage<Tacc> &m_dst;
+  const Tacc *m_filter;
+  int m_half;
+  bool m_derivative;
+  bool m_useSSE2;
+};
+
+template <typename Tin, typename Tacc>
+void separableFilterX(const vpImageView<Tin> &I, vpImage<Tacc> &dst, const Tacc *filter, unsigned int size,
+                      bool derivative)
+{
+  dst.resize(I.getHeight(), I.getWidth());
+  vpSeparableFilterXBody<Tin, Tacc> body(I, dst, filter, (size - 1) / 2, derivative);
+  runRows(body, static_cast<int>(I.getHeight()), I.getSize());
+}
+
+template <typename Tin, typename Tacc>
+void separableFilterY(const vpImageView<Tin> &I, vpImage<Tacc> &dst, const Tacc *filter, unsigned int size,
+                      bool derivative)
+{
+  dst.resize(I.getHeight(), I.getWidth());
+  vpSeparableFilterYBody<Tin, Tacc> body(I, dst, filter, (size - 1) / 2, derivative);
+  runRows(body, static_cast<int>(I.getHeight()), I.getSize());
+}
+
+template <typename Tin, typename Tacc>
+void separableFilterX(const vpImage<Tin> &I, vpImage<Tacc> &dst, const Tacc *filter, unsigned int size,
+                      bool derivative)
+{
+  separableFilterX(vpImageView<Tin>(I), dst, filter, size, derivative);
+}
+
+template <typename Tin, typename Tacc>
+void separableFilterY(const vpImage<Tin> &I, vpImage<Tacc> &dst, const Tacc *filter, unsigned int size,
+                      bool derivative)
+{
+  separableFilterY(vpImageView<Tin>(I), dst, filter, size, derivative);
+}
+
+// Horizontal pass of the fixed-point Gaussian blur over a band of rows, the
+// result is stored on 16 bits with 8 fractional bits
+class vpGaussianFixedPointXBody : public vpParallelForBody
+{
+public:
+  vpGaussianFixedPointXBody(const vpImageView<unsigned char> &I, vpImage<unsigned short> &GIx,
+                            const std::vector<unsigned int> &kernel)
+    : m_I(I), m_GIx(GIx), m_kernel(kernel), m_half(static_cast<unsigned int>(kernel.size()) - 1),
+      m_useSSE2(vpCPUFeatures::checkSSE2()), m_first(vpMath::minimum(m_half, I.getWidth())),
+      m_last(vpMath::maximum(I.getWidth() > m_half ? I.getWidth() - m_half : 0, m_first))
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    int width = static_cast<int>(m_I.getWidth());
+    std::vector<unsigned int> acc(vpMath::maximum(vpMath::minimum(filterTileWidth, m_I.getWidth()), 1u));
+    for (int r = begin; r < end; r++) {
+      const unsigned char *src = m_I[r];
+      unsigned short *out = m_GIx[r];
+      for (unsigned int c0 = m_first; c0 < m_last; c0 += filterTileWidth) {
+        unsigned int n = vpMath::minimum(filterTileWidth, m_last - c0);
+        std::fill(acc.begin(), acc.begin() + n, 0u);
+        for (unsigned int i = 1; i <= m_half; i++) {
+          accumulateTap(&acc[0], src + c0 + i, src + c0 - i, m_kernel[i], false, n, m_useSSE2);
+        }
+        accumulateTap(&acc[0], src + c0, static_cast<const unsigned char *>(NULL), m_kernel[0], false, n,
+                      m_useSSE2);
+        for (unsigned int k = 0; k < n; k++) {
+          out[c0 + k] = static_cast<unsigned short>((acc[k] + 32u) >> 6);
+        }
+      }
+      for (int c = 0; c < width; c++) {
+        if (c == static_cast<int>(m_first)) {
+          // Skip the columns processed above
+          c = static_cast<int>(m_last);
+          if (c >= width) {
+            break;
+          }
+        }
+        out[c] = static_cast<unsigned short>((filterBorderX(src, width, c, &m_kernel[0], m_half) + 32u) >> 6);
+      }
+    }
+  }
+
+private:
+  const vpImageView<unsigned char> &m_I;
+  vpImage<unsigned short> &m_GIx;
+  const std::vector<unsigned int> &m_kernel;
+  unsigned int m_half;
+  bool m_useSSE2;
+  unsigned int m_first;
+  unsigned int m_last;
+};
+
+// Vertical pass of the fixed-point Gaussian blur over a band of rows
+class vpGaussianFixedPointYBody : public vpParallelForBody
+{
+public:
+  vpGaussianFixedPointYBody(const vpImage<unsigned short> &GIx, vpImage<unsigned char> &GI,
+                            const std::vector<unsigned int> &kernel)
+    : m_GIx(GIx), m_GI(GI), m_kernel(kernel), m_half(static_cast<int>(kernel.size()) - 1),
+      m_useSSE2(vpCPUFeatures::checkSSE2())
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    int height = static_cast<int>(m_GIx.getHeight());
+    unsigned int width = m_GIx.getWidth();
+    std::vector<unsigned int> acc(vpMath::maximum(vpMath::minimum(filterTileWidth, width), 1u));
+    for (int r = begin; r < end; r++) {
+      for (unsigned int c0 = 0; c0 < width; c0 += filterTileWidth) {
+        unsigned int n = vpMath::minimum(filterTileWidth, width - c0);
+        std::fill(acc.begin(), acc.begin() + n, 0u);
+        for (int i = 1; i <= m_half; i++) {
+          accumulateTap(&acc[0], m_GIx[reflectIndex(r + i, height)] + c0, m_GIx[reflectIndex(r - i, height)] + c0,
+                        m_kernel[i], false, n, m_useSSE2);
+        }
+        accumulateTap(&acc[0], m_GIx[r] + c0, static_cast<const unsigned short *>(NULL), m_kernel[0], false, n,
+                      m_useSSE2);
+
+        unsigned char *out = m_GI[r] + c0;
+        for (unsigned int k = 0; k < n; k++) {
+          out[k] = static_cast<unsigned char>(vpMath::minimum((acc[k] + (1u << 21)) >> 22, 255u));
+        }
+      }
+    }
+  }
+
+private:
+  const vpImage<unsigned short> &m_GIx;
+  vpImage<unsigned char> &m_GI;
+  const std::vector<unsigned int> &m_kernel;
+  int m_half;
+  bool m_useSSE2;
+};
+
+// Fixed-point Gaussian blur of an unsigned char image. The kernel is
+// quantized with 14 bits, the horizontal pass is stored on 16 bits with 8
+// fractional bits and the products are accumulated on 32 bits.
+void gaussianBlurFixedPoint(const vpImageView<unsigned char> &I, vpImage<unsigned char> &GI, const double *fg,
+                            unsigned int size)
+{
+  const unsigned int one = 1u << 14;
+  unsigned int half = (size - 1) / 2;
+  std::vector<unsigned int> kernel(half + 1);
+  unsigned int sum = 0;
+  for (unsigned int i = 1; i <= half; i++) {
+    kernel[i] = static_cast<unsigned int>(vpMath::round(fg[i] * one));
+    sum += 2 * kernel[i];
+  }
+  // Rounding may lead to a sum greater than one for wide kernels
+  for (unsigned int i = half; sum > one && i >= 1; i--) {
+    while (sum > one && kernel[i] > 0) {
+      kernel[i]--;
+      sum -= 2;
+    }
+  }
+  kernel[0] = one - sum;
+
+  vpImage<unsigned short> GIx(I.getHeight(), I.getWidth());
+  GI.resize(I.getHeight(), I.getWidth());
+
+  vpGaussianFixedPointXBody bodyX(I, GIx, kernel);
+  runRows(bodyX, static_cast<int>(I.getHeight()), I.getSize());
+  vpGaussianFixedPointYBody bodyY(GIx, GI, kernel);
+  runRows(bodyY, static_cast<int>(I.getHeight()), I.getSize());
+}
+} // namespace
+#endif
+
 /*!
   Apply a filter to an image.
   \param I : Image to filter
@@ -344,23 +835,54 @@ void vpImageFilter::filter(const vpImage<double> &I, vpImage<double> &GI, const
   GIx.destroy();
 }
 
+/*!
+  Apply a separable filter to an image, the result is stored as float.
+
+  \param I : Input image.
+  \param GI : Filtered image.
+  \param filter : Half size filter kernel, see filterX().
+  \param size : Filter size. This value should be odd.
+ */
+void vpImageFilter::filter(const vpImage<unsigned char> &I, vpImage<float> &GI, const float *filter, unsigned int size)
+{
+  vpImage<float> GIx;
+  filterX(I, GIx, filter, size);
+  filterY(GIx, GI, filter, size);
+}
+
+/*!
+  Apply a separable filter to a float image.
+
+  \param I : Input image.
+  \param GI : Filtered image.
+  \param filter : Half size filter kernel, see filterX().
+  \param size : Filter size. This value should be odd.
+ */
+void vpImageFilter::filter(const vpImage<float> &I, vpImage<float> &GI, const float *filter, unsigned int size)
+{
+  vpImage<float> GIx;
+  filterX(I, GIx, filter, size);
+  filterY(GIx, GI, filter, size);
+}
+
+/*!
+  Apply a symmetric filter along the rows of an image.
+
+  The rows are processed in bands on vpThreadPool when the image is large
+  enough, the inner loops use SSE2 instructions when available. Missing pixels close to the borders are
+  mirrored.
+
+  \param I : Input image.
+  \param dIx : Filtered image.
+  \param filter : Pointer to the half size filter kernel that should refer to
+  a (size+1)/2 array. The first value refers to the central coefficient, the
+  next one to the right coefficients.
+  \param size : Filter size. This value should be odd.
+ */
 void vpImageFilter::filterX(const vpImage<unsigned char> &I, vpImage<double> &dIx, const double *filter,
                             unsigned int size)
 {
-  dIx.resize(I.getHeight(), I.getWidth());
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < (size - 1) / 2; j++) {
-      dIx[i][j] = vpImageFilter::filterXLeftBorder(I, i, j, filter, size);
-      // dIx[i][j]=0;
-    }
-    for (unsigned int j = (size - 1) / 2; j < I.getWidth() - (size - 1) / 2; j++) {
-      dIx[i][j] = vpImageFilter::filterX(I, i, j, filter, size);
-    }
-    for (unsigned int j = I.getWidth() - (size - 1) / 2; j < I.getWidth(); j++) {
-      dIx[i][j] = vpImageFilter::filterXRightBorder(I, i, j, filter, size);
-      // dIx[i][j]=0;
-    }
-  }
+  separableFilterX(I, dIx, filter, size, false);
 }
 void vpImageFilter::filterX(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &dIx, const double *filter,
                             unsigned int size)
@@ -386,40 +908,66 @@ void vpImageFilter::filterX(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &dIx, cons
 }
 void vpImageFilter::filterX(const vpImage<double> &I, vpImage<double> &dIx, const double *filter, unsigned int size)
 {
-  dIx.resize(I.getHeight(), I.getWidth());
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < (size - 1) / 2; j++) {
-      dIx[i][j] = vpImageFilter::filterXLeftBorder(I, i, j, filter, size);
-      // dIx[i][j]=0;
-    }
-    for (unsigned int j = (size - 1) / 2; j < I.getWidth() - (size - 1) / 2; j++) {
-      dIx[i][j] = vpImageFilter::filterX(I, i, j, filter, size);
-    }
-    for (unsigned int j = I.getWidth() - (size - 1) / 2; j < I.getWidth(); j++) {
-      dIx[i][j] = vpImageFilter::filterXRightBorder(I, i, j, filter, size);
-      // dIx[i][j]=0;
-    }
-  }
+  separableFilterX(I, dIx, filter, size, false);
+}
+/*!
+  Apply a symmetric filter along the rows of an image, the result is stored
+  as float. See filterX(const vpImage<unsigned char> &, vpImage<double> &, const double *, unsigned int).
+ */
+void vpImageFilter::filterX(const vpImage<unsigned char> &I, vpImage<float> &dIx, const float *filter,
+                            unsigned int size)
+{
+  separableFilterX(I, dIx, filter, size, false);
+}
+
+/*!
+  Apply a symmetric filter along the rows of a float image. See
+  filterX(const vpImage<unsigned char> &, vpImage<double> &, const double *, unsigned int).
+ */
+void vpImageFilter::filterX(const vpImage<float> &I, vpImage<float> &dIx, const float *filter, unsigned int size)
+{
+  separableFilterX(I, dIx, filter, size, false);
+}
+
+/*!
+  Apply a symmetric filter along the rows of a region of an image, without
+  copying it. See filterX(const vpImage<unsigned char> &, vpImage<double> &, const double *, unsigned int).
+ */
+void vpImageFilter::filterX(const vpImageView<unsigned char> &I, vpImage<double> &dIx, const double *filter,
+                            unsigned int size)
+{
+  separableFilterX(I, dIx, filter, size, false);
 }
+
+/*!
+  Apply a symmetric filter along the rows of a region of an image, the
+  result is stored as float. See
+  filterX(const vpImage<unsigned char> &, vpImage<double> &, const double *, unsigned int).
+ */
+void vpImageFilter::filterX(const vpImageView<unsigned char> &I, vpImage<float> &dIx, const float *filter,
+                            unsigned int size)
+{
+  separableFilterX(I, dIx, filter, size, false);
+}
+
+/*!
+  Apply a symmetric filter along the columns of an image.
+
+  The rows are processed in bands on vpThreadPool when the image is large
+  enough, the inner loops use SSE2 instructions when available. Missing pixels close to the borders are
+  mirrored.
+
+  \param I : Input image.
+  \param dIy : Filtered image.
+  \param filter : Pointer to the half size filter kernel that should refer to
+  a (size+1)/2 array. The first value refers to the central coefficient, the
+  next one to the bottom coefficients.
+  \param size : Filter size. This value should be odd.
+ */
 void vpImageFilter::filterY(const vpImage<unsigned char> &I, vpImage<double> &dIy, const double *filter,
                             unsigned int size)
 {
-  dIy.resize(I.getHeight(), I.getWidth());
-  for (unsigned int i = 0; i < (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::filterYTopBorder(I, i, j, filter, size);
-    }
-  }
-  for (unsigned int i = (size - 1) / 2; i < I.getHeight() - (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::filterY(I, i, j, filter, size);
-    }
-  }
-  for (unsigned int i = I.getHeight() - (size - 1) / 2; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::filterYBottomBorder(I, i, j, filter, size);
-    }
-  }
+  separableFilterY(I, dIy, filter, size, false);
 }
 void vpImageFilter::filterY(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &dIy, const double *filter,
                             unsigned int size)
@@ -449,22 +997,48 @@ void vpImageFilter::filterY(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &dIy, cons
 }
 void vpImageFilter::filterY(const vpImage<double> &I, vpImage<double> &dIy, const double *filter, unsigned int size)
 {
-  dIy.resize(I.getHeight(), I.getWidth());
-  for (unsigned int i = 0; i < (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::filterYTopBorder(I, i, j, filter, size);
-    }
-  }
-  for (unsigned int i = (size - 1) / 2; i < I.getHeight() - (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::filterY(I, i, j, filter, size);
-    }
-  }
-  for (unsigned int i = I.getHeight() - (size - 1) / 2; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::filterYBottomBorder(I, i, j, filter, size);
-    }
-  }
+  separableFilterY(I, dIy, filter, size, false);
+}
+
+/*!
+  Apply a symmetric filter along the columns of an image, the result is
+  stored as float. See filterY(const vpImage<unsigned char> &, vpImage<double> &, const double *, unsigned int).
+ */
+void vpImageFilter::filterY(const vpImage<unsigned char> &I, vpImage<float> &dIy, const float *filter,
+                            unsigned int size)
+{
+  separableFilterY(I, dIy, filter, size, false);
+}
+
+/*!
+  Apply a symmetric filter along the columns of a float image. See
+  filterY(const vpImage<unsigned char> &, vpImage<double> &, const double *, unsigned int).
+ */
+void vpImageFilter::filterY(const vpImage<float> &I, vpImage<float> &dIy, const float *filter, unsigned int size)
+{
+  separableFilterY(I, dIy, filter, size, false);
+}
+
+/*!
+  Apply a symmetric filter along the columns of a region of an image,
+  without copying it. See
+  filterY(const vpImage<unsigned char> &, vpImage<double> &, const double *, unsigned int).
+ */
+void vpImageFilter::filterY(const vpImageView<unsigned char> &I, vpImage<double> &dIy, const double *filter,
+                            unsigned int size)
+{
+  separableFilterY(I, dIy, filter, size, false);
+}
+
+/*!
+  Apply a symmetric filter along the columns of a region of an image, the
+  result is stored as float. See
+  filterY(const vpImage<unsigned char> &, vpImage<double> &, const double *, unsigned int).
+ */
+void vpImageFilter::filterY(const vpImageView<unsigned char> &I, vpImage<float> &dIy, const float *filter,
+                            unsigned int size)
+{
+  separableFilterY(I, dIy, filter, size, false);
 }
 
 /*!
@@ -481,6 +1055,24 @@ void vpImageFilter::filterY(const vpImage<double> &I, vpImage<double> &dIy, cons
  */
 void vpImageFilter::gaussianBlur(const vpImage<unsigned char> &I, vpImage<double> &GI, unsigned int size, double sigma,
                                  bool normalize)
+{
+  gaussianBlur(vpImageView<unsigned char>(I), GI, size, sigma, normalize);
+}
+
+/*!
+  Apply a Gaussian blur to a region of an image, without copying it.
+  \param I : View of the region to filter.
+  \param GI : Filtered image, of the size of the region.
+  \param size : Filter size. This value should be odd.
+  \param sigma : Gaussian standard deviation. If it is equal to zero or
+  negative, it is computed from filter size as sigma = (size-1)/6.
+  \param normalize : Flag indicating whether to normalize the filter coefficients or
+  not.
+
+  \sa getGaussianKernel() to know which kernel is used.
+ */
+void vpImageFilter::gaussianBlur(const vpImageView<unsigned char> &I, vpImage<double> &GI, unsigned int size,
+                                 double sigma, bool normalize)
 {
   double *fg = new double[(size + 1) / 2];
   vpImageFilter::getGaussianKernel(fg, size, sigma, normalize);
@@ -537,6 +1129,87 @@ void vpImageFilter::gaussianBlur(const vpImage<double> &I, vpImage<double> &GI,
   delete[] fg;
 }
 
+/*!
+  Apply a Gaussian blur to an image, the result is stored as float.
+  \param I : Input image.
+  \param GI : Filtered image.
+  \param size : Filter size. This value should be odd.
+  \param sigma : Gaussian standard deviation. If it is equal to zero or
+  negative, it is computed from filter size as sigma = (size-1)/6.
+  \param normalize : Flag indicating whether to normalize the filter coefficients or not.
+
+  \sa getGaussianKernel() to know which kernel is used.
+ */
+void vpImageFilter::gaussianBlur(const vpImage<unsigned char> &I, vpImage<float> &GI, unsigned int size, double sigma,
+                                 bool normalize)
+{
+  gaussianBlur(vpImageView<unsigned char>(I), GI, size, sigma, normalize);
+}
+
+/*!
+  Apply a Gaussian blur to a region of an image, without copying it, the
+  result is stored as float.
+  \param I : View of the region to filter.
+  \param GI : Filtered image, of the size of the region.
+  \param size : Filter size. This value should be odd.
+  \param sigma : Gaussian standard deviation. If it is equal to zero or
+  negative, it is computed from filter size as sigma = (size-1)/6.
+  \param normalize : Flag indicating whether to normalize the filter coefficients or not.
+
+  \sa getGaussianKernel() to know which kernel is used.
+ */
+void vpImageFilter::gaussianBlur(const vpImageView<unsigned char> &I, vpImage<float> &GI, unsigned int size,
+                                 double sigma, bool normalize)
+{
+  double *fg = new double[(size + 1) / 2];
+  vpImageFilter::getGaussianKernel(fg, size, sigma, normalize);
+  std::vector<float> fg_float(fg, fg + (size + 1) / 2);
+  vpImage<float> GIx;
+  vpImageFilter::filterX(I, GIx, &fg_float[0], size);
+  vpImageFilter::filterY(GIx, GI, &fg_float[0], size);
+  delete[] fg;
+}
+
+/*!
+  Apply a Gaussian blur to an image using fixed-point arithmetic. The
+  normalized kernel is quantized on 14 bits and the intermediate
+  horizontally filtered image is stored on 16 bits. The result only differs
+  from the rounded floating-point one by about half a gray level.
+
+  \param I : Input image.
+  \param GI : Filtered image.
+  \param size : Filter size. This value should be odd.
+  \param sigma : Gaussian standard deviation. If it is equal to zero or
+  negative, it is computed from filter size as sigma = (size-1)/6.
+
+  \sa getGaussianKernel() to know which kernel is used.
+ */
+void vpImageFilter::gaussianBlur(const vpImage<unsigned char> &I, vpImage<unsigned char> &GI, unsigned int size,
+                                 double sigma)
+{
+  gaussianBlur(vpImageView<unsigned char>(I), GI, size, sigma);
+}
+
+/*!
+  Apply a Gaussian blur to a region of an image, without copying it, using
+  fixed-point arithmetic. See
+  gaussianBlur(const vpImage<unsigned char> &, vpImage<unsigned char> &, unsigned int, double).
+
+  \param I : View of the region to filter.
+  \param GI : Filtered image, of the size of the region.
+  \param size : Filter size. This value should be odd.
+  \param sigma : Gaussian standard deviation. If it is equal to zero or
+  negative, it is computed from filter size as sigma = (size-1)/6.
+ */
+void vpImageFilter::gaussianBlur(const vpImageView<unsigned char> &I, vpImage<unsigned char> &GI, unsigned int size,
+                                 double sigma)
+{
+  double *fg = new double[(size + 1) / 2];
+  vpImageFilter::getGaussianKernel(fg, size, sigma, true);
+  gaussianBlurFixedPoint(I, GI, fg, size);
+  delete[] fg;
+}
+
 /*!
   Return the coefficients \f$G_i\f$ of a Gaussian filter.
 
@@ -662,80 +1335,42 @@ void vpImageFilter::getGradY(const vpImage<unsigned char> &I, vpImage<double> &d
 void vpImageFilter::getGradX(const vpImage<unsigned char> &I, vpImage<double> &dIx, const double *filter,
                              unsigned int size)
 {
-  dIx.resize(I.getHeight(), I.getWidth());
-  //#pragma omp parallel for
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < (size - 1) / 2; j++) {
-      dIx[i][j] = 0;
-    }
-    for (unsigned int j = (size - 1) / 2; j < I.getWidth() - (size - 1) / 2; j++) {
-      dIx[i][j] = vpImageFilter::derivativeFilterX(I, i, j, filter, size);
-    }
-    for (unsigned int j = I.getWidth() - (size - 1) / 2; j < I.getWidth(); j++) {
-      dIx[i][j] = 0;
-    }
-  }
+  separableFilterX(I, dIx, filter, size, true);
 }
 void vpImageFilter::getGradX(const vpImage<double> &I, vpImage<double> &dIx, const double *filter, unsigned int size)
 {
-  dIx.resize(I.getHeight(), I.getWidth());
-  // dIx=0;
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < (size - 1) / 2; j++) {
-      dIx[i][j] = 0;
-    }
-    for (unsigned int j = (size - 1) / 2; j < I.getWidth() - (size - 1) / 2; j++) {
-      dIx[i][j] = vpImageFilter::derivativeFilterX(I, i, j, filter, size);
-    }
-    for (unsigned int j = I.getWidth() - (size - 1) / 2; j < I.getWidth(); j++) {
-      dIx[i][j] = 0;
-    }
-  }
+  separableFilterX(I, dIx, filter, size, true);
+}
+
+/*!
+  Compute the gradient along the rows of a region of an image, without
+  copying it. The border columns are set to 0.
+ */
+void vpImageFilter::getGradX(const vpImageView<unsigned char> &I, vpImage<double> &dIx, const double *filter,
+                             unsigned int size)
+{
+  separableFilterX(I, dIx, filter, size, true);
 }
 
 void vpImageFilter::getGradY(const vpImage<unsigned char> &I, vpImage<double> &dIy, const double *filter,
                              unsigned int size)
 {
-  dIy.resize(I.getHeight(), I.getWidth());
-  //#pragma omp parallel for
-  for (unsigned int i = 0; i < (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = 0;
-    }
-  }
-  //#pragma omp parallel for
-  for (unsigned int i = (size - 1) / 2; i < I.getHeight() - (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::derivativeFilterY(I, i, j, filter, size);
-    }
-  }
-  //#pragma omp parallel for
-  for (unsigned int i = I.getHeight() - (size - 1) / 2; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = 0;
-    }
-  }
+  separableFilterY(I, dIy, filter, size, true);
 }
 
 void vpImageFilter::getGradY(const vpImage<double> &I, vpImage<double> &dIy, const double *filter, unsigned int size)
 {
-  dIy.resize(I.getHeight(), I.getWidth());
-  // dIy=0;
-  for (unsigned int i = 0; i < (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = 0;
-    }
-  }
-  for (unsigned int i = (size - 1) / 2; i < I.getHeight() - (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::derivativeFilterY(I, i, j, filter, size);
-    }
-  }
-  for (unsigned int i = I.getHeight() - (size - 1) / 2; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = 0;
-    }
-  }
+  separableFilterY(I, dIy, filter, size, true);
+}
+
+/*!
+  Compute the gradient along the columns of a region of an image, without
+  copying it. The border rows are set to 0.
+ */
+void vpImageFilter::getGradY(const vpImageView<unsigned char> &I, vpImage<double> &dIy, const double *filter,
+                             unsigned int size)
+{
+  separableFilterY(I, dIy, filter, size, true);
 }
 
 /*!
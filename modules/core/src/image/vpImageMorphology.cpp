@@ -36,6 +36,8 @@
  *
  *****************************************************************************/
 
+#include <algorithm>
+
 #include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpImageMorphology.h>
 
@@ -44,6 +46,97 @@
 #define VISP_HAVE_SSE2 1
 #endif
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Erode (isErosion) or dilate the rows of I by a horizontal segment of
+// 2 * radius + 1 pixels. The pixels outside the image are considered set for
+// the erosion and not set for the dilatation.
+void binaryMorphologyX(vpBinaryImage &I, bool isErosion, unsigned int radius)
+{
+  const unsigned int nbWords = I.getNbWords();
+  const uint64_t fill = isErosion ? ~(uint64_t)0 : 0;
+  const uint64_t lastMask = I.getLastWordMask();
+
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    uint64_t *row = I.getRow(i);
+    for (unsigned int r = 0; r < radius; r++) {
+      // The bits after the last column act as the pixels outside the image
+      row[nbWords - 1] = (row[nbWords - 1] & lastMask) | (fill & ~lastMask);
+
+      uint64_t prev = fill;
+      for (unsigned int k = 0; k < nbWords; k++) {
+        const uint64_t curr = row[k];
+        const uint64_t next = (k + 1 < nbWords) ? row[k + 1] : fill;
+        const uint64_t left = (curr << 1) | (prev >> 63);
+        const uint64_t right = (curr >> 1) | (next << 63);
+        row[k] = isErosion ? (curr & left & right) : (curr | left | right);
+        prev = curr;
+      }
+    }
+    row[nbWords - 1] &= lastMask;
+  }
+}
+
+// Erode (isErosion) or dilate the columns of I by a vertical segment of
+// 2 * radius + 1 pixels.
+void binaryMorphologyY(vpBinaryImage &I, bool isErosion, unsigned int radius)
+{
+  const unsigned int nbWords = I.getNbWords();
+  const unsigned int height = I.getHeight();
+  const uint64_t fill = isErosion ? ~(uint64_t)0 : 0;
+  std::vector<uint64_t> prevRow(nbWords);
+
+  for (unsigned int r = 0; r < radius; r++) {
+    std::fill(prevRow.begin(), prevRow.end(), fill);
+    for (unsigned int i = 0; i < height; i++) {
+      uint64_t *row = I.getRow(i);
+      const uint64_t *nextRow = (i + 1 < height) ? I.getRow(i + 1) : NULL;
+      for (unsigned int k = 0; k < nbWords; k++) {
+        const uint64_t curr = row[k];
+        const uint64_t next = nextRow ? nextRow[k] : fill;
+        row[k] = isErosion ? (curr & prevRow[k] & next) : (curr | prevRow[k] | next);
+        prevRow[k] = curr;
+      }
+    }
+  }
+  if (isErosion) {
+    // The pixels outside the image may have set the bits after the last column
+    const uint64_t lastMask = I.getLastWordMask();
+    for (unsigned int i = 0; i < height; i++) {
+      I.getRow(i)[nbWords - 1] &= lastMask;
+    }
+  }
+}
+
+void binaryMorphology(vpBinaryImage &I, bool isErosion,
+                      const vpImageMorphology::vpStructuringElementType &element, unsigned int radius)
+{
+  if (I.isEmpty() || radius == 0) {
+    return;
+  }
+
+  if (element == vpImageMorphology::STRUCTURING_ELEMENT_SQUARE) {
+    // The square is the sum of a horizontal and a vertical segment
+    binaryMorphologyX(I, isErosion, radius);
+    binaryMorphologyY(I, isErosion, radius);
+  } else {
+    // The cross is the union of a horizontal and a vertical segment
+    vpBinaryImage J = I;
+    binaryMorphologyX(I, isErosion, radius);
+    binaryMorphologyY(J, isErosion, radius);
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      uint64_t *row = I.getRow(i);
+      const uint64_t *rowJ = J.getRow(i);
+      for (unsigned int k = 0; k < I.getNbWords(); k++) {
+        row[k] = isErosion ? (row[k] & rowJ[k]) : (row[k] | rowJ[k]);
+      }
+    }
+  }
+}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 /*!
   Erode a grayscale image using the given structuring element.
 
@@ -303,3 +396,78 @@ void vpImageMorphology::dilatation(vpImage<unsigned char> &I, const vpConnexityT
     }
   }
 }
+
+/*!
+  Erode a binary image with a square or cross structuring element.
+
+  The pixels outside the image are considered as set, so that the objects
+  touching the border are not eroded from the border. With a radius of 1,
+  the result is the one of erosion(vpImage<Type> &, Type, Type,
+  vpConnexityType) with CONNEXITY_4 for a cross and CONNEXITY_8 for a square.
+
+  The rows are processed 64 pixels at a time, and the cost grows linearly
+  with the radius.
+
+  \param I : Image to process.
+  \param element : Shape of the structuring element.
+  \param radius : Half size of the structuring element, whose width and
+  height are 2 * radius + 1 pixels.
+
+  \sa dilatation(vpBinaryImage &, const vpStructuringElementType &, unsigned int)
+*/
+void vpImageMorphology::erosion(vpBinaryImage &I, const vpStructuringElementType &element, unsigned int radius)
+{
+  binaryMorphology(I, true, element, radius);
+}
+
+/*!
+  Dilate a binary image with a square or cross structuring element.
+
+  The pixels outside the image are considered as not set. With a radius of
+  1, the result is the one of dilatation(vpImage<Type> &, Type, Type,
+  vpConnexityType) with CONNEXITY_4 for a cross and CONNEXITY_8 for a square.
+
+  \param I : Image to process.
+  \param element : Shape of the structuring element.
+  \param radius : Half size of the structuring element, whose width and
+  height are 2 * radius + 1 pixels.
+
+  \sa erosion(vpBinaryImage &, const vpStructuringElementType &, unsigned int)
+*/
+void vpImageMorphology::dilatation(vpBinaryImage &I, const vpStructuringElementType &element, unsigned int radius)
+{
+  binaryMorphology(I, false, element, radius);
+}
+
+/*!
+  Open a binary image: erosion followed by a dilatation with the same
+  structuring element. Removes the objects smaller than the structuring
+  element.
+
+  \param I : Image to process.
+  \param element : Shape of the structuring element.
+  \param radius : Half size of the structuring element.
+
+  \sa closing(vpBinaryImage &, const vpStructuringElementType &, unsigned int)
+*/
+void vpImageMorphology::opening(vpBinaryImage &I, const vpStructuringElementType &element, unsigned int radius)
+{
+  binaryMorphology(I, true, element, radius);
+  binaryMorphology(I, false, element, radius);
+}
+
+/*!
+  Close a binary image: dilatation followed by an erosion with the same
+  structuring element. Fills the holes smaller than the structuring element.
+
+  \param I : Image to process.
+  \param element : Shape of the structuring element.
+  \param radius : Half size of the structuring element.
+
+  \sa opening(vpBinaryImage &, const vpStructuringElementType &, unsigned int)
+*/
+void vpImageMorphology::closing(vpBinaryImage &I, const vpStructuringElementType &element, unsigned int radius)
+{
+  binaryMorphology(I, false, element, radius);
+  binaryMorphology(I, true, element, radius);
+}
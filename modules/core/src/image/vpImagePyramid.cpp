@@ -0,0 +1,458 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Gaussian and box image pyramids with optional gradient levels.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpImagePyramid.cpp
+  \brief Gaussian and box image pyramids with optional gradient levels.
+*/
+
+#include <algorithm>
+#include <vector>
+
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpImagePyramid.h>
+#include <visp3/core/vpThreadPool.h>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Number of destination pixels of a band of rows processed by a thread at once
+const unsigned int pyramidGrainSize = 1 << 15;
+
+bool useSSE2()
+{
+  bool checkSSE2 = vpCPUFeatures::checkSSE2();
+#if !VISP_HAVE_SSE2
+  checkSSE2 = false;
+#endif
+  return checkSSE2;
+}
+
+void runRows(vpParallelForBody &body, unsigned int width, unsigned int height, unsigned int nThreads)
+{
+  int grain = static_cast<int>(std::max(1u, pyramidGrainSize / std::max(1u, width)));
+  vpThreadPool::instance().parallel_for(0, (int)height, body, grain, nThreads);
+}
+
+// Mirror an index into [0, size - 1] without repeating the border (OpenCV BORDER_REFLECT_101)
+int reflect101(int x, int size)
+{
+  if (size == 1) {
+    return 0;
+  }
+  while (x < 0 || x >= size) {
+    x = x < 0 ? -x : 2 * size - 2 - x;
+  }
+  return x;
+}
+
+/*
+  Gaussian down-sampling: the 5 source rows around 2i are first summed with
+  the weights 1 4 6 4 1 into a 16-bit row padded with 2 mirrored values on
+  each side, which is then filtered and decimated horizontally. The sums stay
+  below 16 * 16 * 255 + 128 < 2^16.
+*/
+class vpPyrDownGaussianBody : public vpParallelForBody
+{
+public:
+  vpPyrDownGaussianBody(const vpImage<unsigned char> &src, vpImage<unsigned char> &dst)
+    : m_src(src), m_dst(dst), m_checkSSE2(useSSE2())
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    const int srcWidth = (int)m_src.getWidth(), srcHeight = (int)m_src.getHeight();
+    const int dstWidth = (int)m_dst.getWidth();
+    std::vector<unsigned short> buffer((size_t)srcWidth + 4);
+    unsigned short *tmp = &buffer[2];
+
+    for (int i = begin; i < end; i++) {
+      const unsigned char *r0 = m_src[reflect101(2 * i - 2, srcHeight)];
+      const unsigned char *r1 = m_src[reflect101(2 * i - 1, srcHeight)];
+      const unsigned char *r2 = m_src[reflect101(2 * i, srcHeight)];
+      const unsigned char *r3 = m_src[reflect101(2 * i + 1, srcHeight)];
+      const unsigned char *r4 = m_src[reflect101(2 * i + 2, srcHeight)];
+      int x = 0;
+
+#if VISP_HAVE_SSE2
+      if (m_checkSSE2) {
+        const __m128i zero = _mm_setzero_si128();
+        for (; x + 8 <= srcWidth; x += 8) {
+          const __m128i v0 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(r0 + x)), zero);
+          const __m128i v1 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(r1 + x)), zero);
+          const __m128i v2 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(r2 + x)), zero);
+          const __m128i v3 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(r3 + x)), zero);
+          const __m128i v4 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(r4 + x)), zero);
+          const __m128i v13 = _mm_slli_epi16(_mm_add_epi16(v1, v3), 2);
+          const __m128i v22 = _mm_add_epi16(_mm_slli_epi16(v2, 2), _mm_slli_epi16(v2, 1));
+          _mm_storeu_si128((__m128i *)(tmp + x), _mm_add_epi16(_mm_add_epi16(v0, v4), _mm_add_epi16(v13, v22)));
+        }
+      }
+#endif
+
+      for (; x < srcWidth; x++) {
+        tmp[x] = (unsigned short)(r0[x] + r4[x] + 4 * (r1[x] + r3[x]) + 6 * r2[x]);
+      }
+      tmp[-2] = tmp[reflect101(-2, srcWidth)];
+      tmp[-1] = tmp[reflect101(-1, srcWidth)];
+      tmp[srcWidth] = tmp[reflect101(srcWidth, srcWidth)];
+      tmp[srcWidth + 1] = tmp[reflect101(srcWidth + 1, srcWidth)];
+
+      // From here, t[k] is tmp[k - 2] and dst[j] uses t[2j] to t[2j + 4]
+      const unsigned short *t = tmp - 2;
+      unsigned char *dst = m_dst[i];
+      int j = 0;
+
+#if VISP_HAVE_SSE2
+      if (m_checkSSE2) {
+        const __m128i round = _mm_set1_epi16(128);
+        for (; 2 * j + 20 <= srcWidth + 4; j += 8) {
+          __m128i even[3], odd[2];
+          for (int k = 0; k < 3; k++) {
+            // Split 16 consecutive values into their even and odd ones,
+            // which are small enough for a signed pack
+            const __m128i a = _mm_loadu_si128((const __m128i *)(t + 2 * j + 2 * k));
+            const __m128i b = _mm_loadu_si128((const __m128i *)(t + 2 * j + 2 * k + 8));
+            even[k] = _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16),
+                                      _mm_srai_epi32(_mm_slli_epi32(b, 16), 16));
+            if (k < 2) {
+              odd[k] = _mm_packs_epi32(_mm_srai_epi32(a, 16), _mm_srai_epi32(b, 16));
+            }
+          }
+          const __m128i o = _mm_slli_epi16(_mm_add_epi16(odd[0], odd[1]), 2);
+          const __m128i c = _mm_add_epi16(_mm_slli_epi16(even[1], 2), _mm_slli_epi16(even[1], 1));
+          __m128i sum = _mm_add_epi16(_mm_add_epi16(even[0], even[2]), _mm_add_epi16(o, c));
+          sum = _mm_srli_epi16(_mm_add_epi16(sum, round), 8);
+          _mm_storel_epi64((__m128i *)(dst + j), _mm_packus_epi16(sum, sum));
+        }
+      }
+#endif
+
+      for (; j < dstWidth; j++) {
+        const unsigned short *p = t + 2 * j;
+        dst[j] = (unsigned char)((p[0] + p[4] + 4 * (p[1] + p[3]) + 6 * p[2] + 128) >> 8);
+      }
+    }
+  }
+
+private:
+  const vpImage<unsigned char> &m_src;
+  vpImage<unsigned char> &m_dst;
+  bool m_checkSSE2;
+};
+
+// Box down-sampling: mean of the 2x2 blocks rounded to the nearest
+class vpPyrDownBoxBody : public vpParallelForBody
+{
+public:
+  vpPyrDownBoxBody(const vpImage<unsigned char> &src, vpImage<unsigned char> &dst)
+    : m_src(src), m_dst(dst), m_checkSSE2(useSSE2())
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    const int dstWidth = (int)m_dst.getWidth();
+
+    for (int i = begin; i < end; i++) {
+      const unsigned char *r0 = m_src[2 * i];
+      const unsigned char *r1 = m_src[2 * i + 1];
+      unsigned char *dst = m_dst[i];
+      int j = 0;
+
+#if VISP_HAVE_SSE2
+      if (m_checkSSE2) {
+        const __m128i mask = _mm_set1_epi16(0x00FF);
+        const __m128i round = _mm_set1_epi16(2);
+        for (; j + 8 <= dstWidth; j += 8) {
+          const __m128i a = _mm_loadu_si128((const __m128i *)(r0 + 2 * j));
+          const __m128i b = _mm_loadu_si128((const __m128i *)(r1 + 2 * j));
+          const __m128i sa = _mm_add_epi16(_mm_and_si128(a, mask), _mm_srli_epi16(a, 8));
+          const __m128i sb = _mm_add_epi16(_mm_and_si128(b, mask), _mm_srli_epi16(b, 8));
+          const __m128i sum = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(sa, sb), round), 2);
+          _mm_storel_epi64((__m128i *)(dst + j), _mm_packus_epi16(sum, sum));
+        }
+      }
+#endif
+
+      for (; j < dstWidth; j++) {
+        dst[j] = (unsigned char)((r0[2 * j] + r0[2 * j + 1] + r1[2 * j] + r1[2 * j + 1] + 2) >> 2);
+      }
+    }
+  }
+
+private:
+  const vpImage<unsigned char> &m_src;
+  vpImage<unsigned char> &m_dst;
+  bool m_checkSSE2;
+};
+
+// Sobel gradients divided by 8, with replicated borders
+class vpPyrGradientBody : public vpParallelForBody
+{
+public:
+  vpPyrGradientBody(const vpImage<unsigned char> &I, vpImage<float> &dIx, vpImage<float> &dIy)
+    : m_I(I), m_dIx(dIx), m_dIy(dIy), m_checkSSE2(useSSE2())
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    const int width = (int)m_I.getWidth(), height = (int)m_I.getHeight();
+
+    for (int i = begin; i < end; i++) {
+      const unsigned char *r0 = m_I[std::max(i - 1, 0)];
+      const unsigned char *r1 = m_I[i];
+      const unsigned char *r2 = m_I[std::min(i + 1, height - 1)];
+      float *gx = m_dIx[i];
+      float *gy = m_dIy[i];
+
+      computeScalar(r0, r1, r2, width, 0, gx, gy);
+      int j = 1;
+
+#if VISP_HAVE_SSE2
+      if (m_checkSSE2) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128 scale = _mm_set1_ps(0.125f);
+        for (; j + 9 <= width; j += 8) {
+          __m128i left[3], center[3], right[3];
+          const unsigned char *rows[3] = {r0, r1, r2};
+          for (int k = 0; k < 3; k++) {
+            left[k] = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(rows[k] + j - 1)), zero);
+            center[k] = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(rows[k] + j)), zero);
+            right[k] = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(rows[k] + j + 1)), zero);
+          }
+          const __m128i dx0 = _mm_sub_epi16(right[0], left[0]);
+          const __m128i dx1 = _mm_sub_epi16(right[1], left[1]);
+          const __m128i dx2 = _mm_sub_epi16(right[2], left[2]);
+          const __m128i sx = _mm_add_epi16(_mm_add_epi16(dx0, dx2), _mm_slli_epi16(dx1, 1));
+          const __m128i s0 = _mm_add_epi16(_mm_add_epi16(left[0], right[0]), _mm_slli_epi16(center[0], 1));
+          const __m128i s2 = _mm_add_epi16(_mm_add_epi16(left[2], right[2]), _mm_slli_epi16(center[2], 1));
+          const __m128i sy = _mm_sub_epi16(s2, s0);
+          store(gx + j, sx, scale);
+          store(gy + j, sy, scale);
+        }
+      }
+#endif
+
+      for (; j < width; j++) {
+        computeScalar(r0, r1, r2, width, j, gx, gy);
+      }
+    }
+  }
+
+private:
+  static void computeScalar(const unsigned char *r0, const unsigned char *r1, const unsigned char *r2, int width,
+                            int j, float *gx, float *gy)
+  {
+    const int l = std::max(j - 1, 0), r = std::min(j + 1, width - 1);
+    const int sx = (r0[r] - r0[l]) + 2 * (r1[r] - r1[l]) + (r2[r] - r2[l]);
+    const int sy = (r2[l] + 2 * r2[j] + r2[r]) - (r0[l] + 2 * r0[j] + r0[r]);
+    gx[j] = sx * 0.125f;
+    gy[j] = sy * 0.125f;
+  }
+
+#if VISP_HAVE_SSE2
+  // Convert 8 signed 16-bit values to scaled floats
+  static void store(float *dst, const __m128i &v, const __m128 &scale)
+  {
+    const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+    const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+    _mm_storeu_ps(dst, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+    _mm_storeu_ps(dst + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+  }
+#endif
+
+  const vpImage<unsigned char> &m_I;
+  vpImage<float> &m_dIx, &m_dIy;
+  bool m_checkSSE2;
+};
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Default constructor: the pyramid has no level until build() is called.
+*/
+vpImagePyramid::vpImagePyramid()
+  : m_filter(GAUSSIAN_FILTER), m_nbLevels(0), m_hasGradients(false), m_levels(), m_gradientU(), m_gradientV()
+{
+}
+
+/*!
+  Build the pyramid of an image.
+
+  \param I : Image of level 0.
+  \param nbLevels : Number of levels, level 0 included.
+  \param filter : Filter used to down-sample the levels.
+  \param computeGradients : If true, compute the gradients of each level.
+  \param nThreads : Number of threads, 0 to use vpThreadPool default.
+
+  \sa build()
+*/
+vpImagePyramid::vpImagePyramid(const vpImage<unsigned char> &I, unsigned int nbLevels,
+                               const vpPyramidFilterType &filter, bool computeGradients, unsigned int nThreads)
+  : m_filter(GAUSSIAN_FILTER), m_nbLevels(0), m_hasGradients(false), m_levels(), m_gradientU(), m_gradientV()
+{
+  build(I, nbLevels, filter, computeGradients, nThreads);
+}
+
+/*!
+  Build the pyramid of an image, reusing the memory of the levels of the
+  previous call when the image size is unchanged.
+
+  \param I : Image of level 0.
+  \param nbLevels : Number of levels, level 0 included. Fewer levels are
+  built if a level would have a null width or height.
+  \param filter : Filter used to down-sample the levels.
+  \param computeGradients : If true, compute the gradients of each level.
+  \param nThreads : Number of threads, 0 to use vpThreadPool default.
+
+  \exception vpException::badValue : If \e nbLevels is 0.
+  \exception vpException::dimensionError : If \e I is empty.
+*/
+void vpImagePyramid::build(const vpImage<unsigned char> &I, unsigned int nbLevels, const vpPyramidFilterType &filter,
+                           bool computeGradients, unsigned int nThreads)
+{
+  if (nbLevels == 0) {
+    throw(vpException(vpException::badValue, "An image pyramid needs at least one level"));
+  }
+  if (I.getSize() == 0) {
+    throw(vpException(vpException::dimensionError, "Cannot build the pyramid of an empty image"));
+  }
+
+  unsigned int nbValidLevels = 1;
+  for (unsigned int w = I.getWidth() / 2, h = I.getHeight() / 2; nbValidLevels < nbLevels && w > 0 && h > 0;
+       w /= 2, h /= 2) {
+    nbValidLevels++;
+  }
+
+  m_filter = filter;
+  m_nbLevels = nbValidLevels;
+  m_hasGradients = computeGradients;
+  if (m_levels.size() < m_nbLevels) {
+    m_levels.resize(m_nbLevels);
+  }
+
+  m_levels[0] = I;
+  for (unsigned int l = 1; l < m_nbLevels; l++) {
+    const vpImage<unsigned char> &src = m_levels[l - 1];
+    vpImage<unsigned char> &dst = m_levels[l];
+    dst.resize(src.getHeight() / 2, src.getWidth() / 2);
+    if (m_filter == BOX_FILTER) {
+      vpPyrDownBoxBody body(src, dst);
+      runRows(body, dst.getWidth(), dst.getHeight(), nThreads);
+    } else {
+      vpPyrDownGaussianBody body(src, dst);
+      runRows(body, dst.getWidth(), dst.getHeight(), nThreads);
+    }
+  }
+
+  if (m_hasGradients) {
+    if (m_gradientU.size() < m_nbLevels) {
+      m_gradientU.resize(m_nbLevels);
+      m_gradientV.resize(m_nbLevels);
+    }
+    for (unsigned int l = 0; l < m_nbLevels; l++) {
+      const vpImage<unsigned char> &level = m_levels[l];
+      m_gradientU[l].resize(level.getHeight(), level.getWidth());
+      m_gradientV[l].resize(level.getHeight(), level.getWidth());
+      vpPyrGradientBody body(level, m_gradientU[l], m_gradientV[l]);
+      runRows(body, level.getWidth(), level.getHeight(), nThreads);
+    }
+  }
+}
+
+void vpImagePyramid::checkLevel(unsigned int level) const
+{
+  if (level >= m_nbLevels) {
+    throw(vpException(vpException::dimensionError, "Pyramid level %u does not exist, the pyramid has %u levels",
+                      level, m_nbLevels));
+  }
+}
+
+/*!
+  Horizontal gradient of a level.
+
+  \param level : Level index, 0 for the full resolution image.
+
+  \exception vpException::dimensionError : If the level does not exist.
+  \exception vpException::notInitialized : If the gradients have not been computed.
+*/
+const vpImage<float> &vpImagePyramid::getGradientU(unsigned int level) const
+{
+  checkLevel(level);
+  if (!m_hasGradients) {
+    throw(vpException(vpException::notInitialized, "The gradients of the pyramid have not been computed"));
+  }
+  return m_gradientU[level];
+}
+
+/*!
+  Vertical gradient of a level.
+
+  \param level : Level index, 0 for the full resolution image.
+
+  \exception vpException::dimensionError : If the level does not exist.
+  \exception vpException::notInitialized : If the gradients have not been computed.
+*/
+const vpImage<float> &vpImagePyramid::getGradientV(unsigned int level) const
+{
+  checkLevel(level);
+  if (!m_hasGradients) {
+    throw(vpException(vpException::notInitialized, "The gradients of the pyramid have not been computed"));
+  }
+  return m_gradientV[level];
+}
+
+/*!
+  Image of a level.
+
+  \param level : Level index, 0 for the full resolution image.
+
+  \exception vpException::dimensionError : If the level does not exist.
+*/
+const vpImage<unsigned char> &vpImagePyramid::getLevel(unsigned int level) const
+{
+  checkLevel(level);
+  return m_levels[level];
+}
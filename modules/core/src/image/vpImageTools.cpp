@@ -39,6 +39,7 @@
 #include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpImageConvert.h>
 #include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpTemplateMatcher.h>
 
 #if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
 #include <emmintrin.h>
@@ -749,7 +750,12 @@ void vpImageTools::extract(const vpImage<unsigned char> &Src, vpImage<double> &D
   \param I_score : Output template matching score.
   \param step_u : Step in u-direction to speed-up the computation.
   \param step_v : Step in v-direction to speed-up the computation.
-  \param useOptimized : Use optimized version (SSE, OpenMP, integral images, ...) if true and available.
+  \param useOptimized : Use optimized version (integral images, SSE2 integer dot products, vpThreadPool) if true.
+
+  \note To search several templates in the same image, or to search only the best locations with a coarse-to-fine
+  strategy, use vpTemplateMatcher.
+
+  \sa vpTemplateMatcher
 */
 void vpImageTools::templateMatching(const vpImage<unsigned char> &I, const vpImage<unsigned char> &I_tpl,
                                     vpImage<double> &I_score, const unsigned int step_u, const unsigned int step_v,
@@ -770,53 +776,21 @@ void vpImageTools::templateMatching(const vpImage<unsigned char> &I, const vpIma
     return;
   }
 
-  vpImage<double> I_double, I_tpl_double;
-  vpImageConvert::convert(I, I_double);
-  vpImageConvert::convert(I_tpl, I_tpl_double);
-
   const unsigned int height_tpl = I_tpl.getHeight(), width_tpl = I_tpl.getWidth();
   I_score.resize(I.getHeight() - height_tpl, I.getWidth() - width_tpl, 0.0);
 
   if (useOptimized) {
-    vpImage<double> II, IIsq;
-    integralImage(I, II, IIsq);
-
-    vpImage<double> II_tpl, IIsq_tpl;
-    integralImage(I_tpl, II_tpl, IIsq_tpl);
-
-    // zero-mean template image
-    const double sum2 = (II_tpl[height_tpl][width_tpl] + II_tpl[0][0] - II_tpl[0][width_tpl] - II_tpl[height_tpl][0]);
-    const double mean2 = sum2 / I_tpl.getSize();
-    for (unsigned int cpt = 0; cpt < I_tpl_double.getSize(); cpt++) {
-      I_tpl_double.bitmap[cpt] -= mean2;
-    }
-
-#if defined _OPENMP && _OPENMP >= 200711 // OpenMP 3.1
-#pragma omp parallel for schedule(dynamic)
-    for (unsigned int i = 0; i < I.getHeight() - height_tpl; i += step_v) {
-      for (unsigned int j = 0; j < I.getWidth() - width_tpl; j += step_u) {
-        I_score[i][j] = normalizedCorrelation(I_double, I_tpl_double, II, IIsq, II_tpl, IIsq_tpl, i, j);
-      }
-    }
-#else
-    // error C3016: 'i': index variable in OpenMP 'for' statement must have signed integral type
-    int end = (int)((I.getHeight() - height_tpl) / step_v) + 1;
-    std::vector<unsigned int> vec_step_v((size_t)end);
-    for (unsigned int cpt = 0, idx = 0; cpt < I.getHeight() - height_tpl; cpt += step_v, idx++) {
-      vec_step_v[(size_t)idx] = cpt;
+    vpTemplateMatcher matcher;
+    matcher.setImage(I);
+    vpImage<double> I_all_scores;
+    matcher.computeScores(I_tpl, I_all_scores, step_u, step_v);
+    for (unsigned int i = 0; i < I_score.getHeight(); i++) {
+      memcpy(I_score[i], I_all_scores[i], I_score.getWidth() * sizeof(double));
     }
-#if defined _OPENMP // only to disable warning: ignoring #pragma omp parallel [-Wunknown-pragmas]
-#pragma omp parallel for schedule(dynamic)
-#endif
-    for (int cpt = 0; cpt < end; cpt++) {
-      for (unsigned int j = 0; j < I.getWidth() - width_tpl; j += step_u) {
-        I_score[vec_step_v[cpt]][j] =
-            normalizedCorrelation(I_double, I_tpl_double, II, IIsq, II_tpl, IIsq_tpl, vec_step_v[cpt], j);
-      }
-    }
-#endif
   } else {
-    vpImage<double> I_cur;
+    vpImage<double> I_double, I_tpl_double, I_cur;
+    vpImageConvert::convert(I, I_double);
+    vpImageConvert::convert(I_tpl, I_tpl_double);
 
     for (unsigned int i = 0; i < I.getHeight() - height_tpl; i += step_v) {
       for (unsigned int j = 0; j < I.getWidth() - width_tpl; j += step_u) {
@@ -863,69 +837,6 @@ int64_t vpImageTools::lerp2(int64_t A, int64_t B, int64_t t, int64_t t_1) {
   return A * t_1 + B * t;
 }
 
-double vpImageTools::normalizedCorrelation(const vpImage<double> &I1, const vpImage<double> &I2,
-                                           const vpImage<double> &II, const vpImage<double> &IIsq,
-                                           const vpImage<double> &II_tpl, const vpImage<double> &IIsq_tpl,
-                                           const unsigned int i0, const unsigned int j0)
-{
-  double ab = 0.0;
-#if VISP_HAVE_SSE2
-  bool use_sse_version = true;
-  if (vpCPUFeatures::checkSSE2() && I2.getWidth() >= 2) {
-    const double *ptr_I1 = I1.bitmap;
-    const double *ptr_I2 = I2.bitmap;
-
-    __m128d v_ab = _mm_setzero_pd();
-
-    for (unsigned int i = 0; i < I2.getHeight(); i++) {
-      unsigned int j = 0;
-      ptr_I1 = &I1.bitmap[(i0 + i) * I1.getWidth() + j0];
-
-      for (; j <= I2.getWidth() - 2; j += 2, ptr_I1 += 2, ptr_I2 += 2) {
-        const __m128d v1 = _mm_loadu_pd(ptr_I1);
-        const __m128d v2 = _mm_loadu_pd(ptr_I2);
-        v_ab = _mm_add_pd(v_ab, _mm_mul_pd(v1, v2));
-      }
-
-      for (; j < I2.getWidth(); j++) {
-        ab += (I1[i0 + i][j0 + j]) * I2[i][j];
-      }
-    }
-
-    double v_res_ab[2];
-    _mm_storeu_pd(v_res_ab, v_ab);
-
-    ab += v_res_ab[0] + v_res_ab[1];
-  } else {
-    use_sse_version = false;
-  }
-#else
-  bool use_sse_version = false;
-#endif
-
-  if (!use_sse_version) {
-    for (unsigned int i = 0; i < I2.getHeight(); i++) {
-      for (unsigned int j = 0; j < I2.getWidth(); j++) {
-        ab += (I1[i0 + i][j0 + j]) * I2[i][j];
-      }
-    }
-  }
-
-  const unsigned int height_tpl = I2.getHeight(), width_tpl = I2.getWidth();
-  const double sum1 =
-      (II[i0 + height_tpl][j0 + width_tpl] + II[i0][j0] - II[i0][j0 + width_tpl] - II[i0 + height_tpl][j0]);
-  const double sum2 = (II_tpl[height_tpl][width_tpl] + II_tpl[0][0] - II_tpl[0][width_tpl] - II_tpl[height_tpl][0]);
-
-  double a2 = ((IIsq[i0 + I2.getHeight()][j0 + I2.getWidth()] + IIsq[i0][j0] - IIsq[i0][j0 + I2.getWidth()] -
-                IIsq[i0 + I2.getHeight()][j0]) -
-               (1.0 / I2.getSize()) * vpMath::sqr(sum1));
-
-  double b2 = ((IIsq_tpl[I2.getHeight()][I2.getWidth()] + IIsq_tpl[0][0] - IIsq_tpl[0][I2.getWidth()] -
-                IIsq_tpl[I2.getHeight()][0]) -
-               (1.0 / I2.getSize()) * vpMath::sqr(sum2));
-  return ab / sqrt(a2 * b2);
-}
-
 /*!
   Apply the transformation map to the image.
 
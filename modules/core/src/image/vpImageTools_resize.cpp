@@ -0,0 +1,511 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Separable image resize of unsigned char, vpRGBa and float images.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpImageTools_resize.cpp
+  \brief Separable image resize of unsigned char, vpRGBa and float images.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpThreadPool.h>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Number of destination values of a band of rows processed by a thread at once
+const unsigned int resizeGrainSize = 1 << 15;
+
+bool useSSE2()
+{
+  bool checkSSE2 = vpCPUFeatures::checkSSE2();
+#if !VISP_HAVE_SSE2
+  checkSSE2 = false;
+#endif
+  return checkSSE2;
+}
+
+void runRows(vpParallelForBody &body, unsigned int width, unsigned int height, unsigned int nThreads)
+{
+  int grain = static_cast<int>(std::max(1u, resizeGrainSize / std::max(1u, width)));
+  vpThreadPool::instance().parallel_for(0, (int)height, body, grain, nThreads);
+}
+
+/*
+  Resampling of one image direction: each destination position dst is the
+  weighted sum of the nbTaps source positions index[dst * nbTaps + k], already
+  clamped to the image, with the weights weight[dst * nbTaps + k].
+*/
+struct vpResizeTable {
+  vpResizeTable() : nbTaps(0), index(), weight() {}
+
+  int nbTaps;
+  std::vector<int> index;
+  std::vector<float> weight;
+};
+
+inline int clampIndex(int i, unsigned int size) { return std::max(0, std::min(i, static_cast<int>(size) - 1)); }
+
+// Same coefficients as vpImageTools::cubicHermite() applied to (A, B, C, D)
+inline void cubicWeights(float t, float *w)
+{
+  const float t2 = t * t, t3 = t2 * t;
+  w[0] = -0.5f * t3 + t2 - 0.5f * t;
+  w[1] = 1.5f * t3 - 2.5f * t2 + 1.0f;
+  w[2] = -1.5f * t3 + 2.0f * t2 + 0.5f * t;
+  w[3] = 0.5f * t3 - 0.5f * t2;
+}
+
+/*
+  The linear and cubic positions are the ones of the generic
+  vpImageTools::resize(): the first and last pixels of both images coincide.
+  With INTERPOLATION_AREA, destination pixel j covers the source interval
+  [j * scale, (j + 1) * scale) and each source pixel is weighted by its overlap
+  with that interval.
+*/
+void buildTable(unsigned int srcSize, unsigned int dstSize, vpImageTools::vpImageInterpolationType method,
+                vpResizeTable &table)
+{
+  if (method == vpImageTools::INTERPOLATION_AREA) {
+    const double scale = srcSize / static_cast<double>(dstSize);
+    table.nbTaps = static_cast<int>(std::ceil(scale)) + 1;
+    table.index.assign(dstSize * table.nbTaps, 0);
+    table.weight.assign(dstSize * table.nbTaps, 0.0f);
+
+    for (unsigned int j = 0; j < dstSize; j++) {
+      const double start = j * scale;
+      const double end = std::min((j + 1) * scale, static_cast<double>(srcSize));
+      const int first = static_cast<int>(start);
+      int *index = &table.index[j * table.nbTaps];
+      float *weight = &table.weight[j * table.nbTaps];
+      for (int k = 0; k < table.nbTaps; k++) {
+        const int i = first + k;
+        const double overlap = std::min(end, i + 1.0) - std::max(start, static_cast<double>(i));
+        index[k] = clampIndex(i, srcSize);
+        weight[k] = overlap > 0.0 ? static_cast<float>(overlap / scale) : 0.0f;
+      }
+    }
+    return;
+  }
+
+  const float scale = (srcSize - 1) / static_cast<float>(dstSize - 1);
+  table.nbTaps = method == vpImageTools::INTERPOLATION_CUBIC ? 4 : 2;
+  table.index.resize(dstSize * table.nbTaps);
+  table.weight.resize(dstSize * table.nbTaps);
+
+  for (unsigned int j = 0; j < dstSize; j++) {
+    const float u = j * scale;
+    const int u0 = clampIndex(static_cast<int>(u), srcSize);
+    const float frac = u - u0;
+    int *index = &table.index[j * table.nbTaps];
+    float *weight = &table.weight[j * table.nbTaps];
+
+    if (method == vpImageTools::INTERPOLATION_CUBIC) {
+      cubicWeights(frac, weight);
+      for (int k = 0; k < 4; k++) {
+        index[k] = clampIndex(u0 - 1 + k, srcSize);
+      }
+    } else {
+      index[0] = u0;
+      index[1] = clampIndex(u0 + 1, srcSize);
+      weight[0] = 1.0f - frac;
+      weight[1] = frac;
+    }
+  }
+}
+
+// Source index of each destination position with the legacy nearest neighbor mapping
+void buildNearestTable(unsigned int srcSize, unsigned int dstSize, std::vector<int> &index)
+{
+  const float scale = srcSize / static_cast<float>(dstSize - 1);
+  index.resize(dstSize);
+  for (unsigned int j = 0; j < dstSize; j++) {
+    const float u = j * scale;
+    index[j] = u > static_cast<float>(srcSize) - 1.f ? static_cast<int>(srcSize) - 1 : static_cast<int>(u);
+  }
+}
+
+template <class Type> class vpResizeNearestBody : public vpParallelForBody
+{
+public:
+  vpResizeNearestBody(const vpImageView<Type> &src, vpImage<Type> &dst, const std::vector<int> &xIndex,
+                      const std::vector<int> &yIndex)
+    : m_src(src), m_dst(dst), m_xIndex(xIndex), m_yIndex(yIndex)
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    const unsigned int width = m_dst.getWidth();
+    for (int i = begin; i < end; i++) {
+      const Type *src = m_src[static_cast<unsigned int>(m_yIndex[i])];
+      Type *dst = m_dst[static_cast<unsigned int>(i)];
+      for (unsigned int j = 0; j < width; j++) {
+        dst[j] = src[m_xIndex[j]];
+      }
+    }
+  }
+
+private:
+  const vpImageView<Type> &m_src;
+  vpImage<Type> &m_dst;
+  const std::vector<int> &m_xIndex;
+  const std::vector<int> &m_yIndex;
+};
+
+inline float toFloat(unsigned char v) { return static_cast<float>(v); }
+inline float toFloat(float v) { return v; }
+
+inline void storeValue(float v, unsigned char &dst)
+{
+  dst = static_cast<unsigned char>(v <= 0.0f ? 0 : std::min(static_cast<int>(v + 0.5f), 255));
+}
+inline void storeValue(float v, float &dst) { dst = v; }
+
+/*
+  Separable resampling of images of nbChannels interleaved values of type
+  Type. A band of destination rows keeps the horizontally resampled source
+  rows it needs in nbTaps float rows, so that each source row of the band is
+  resampled only once; each destination row is then the weighted sum of these
+  rows. Consecutive source rows are srcStride values of type Type apart.
+*/
+template <class Type> class vpResizeSeparableBody : public vpParallelForBody
+{
+public:
+  vpResizeSeparableBody(const Type *src, unsigned int srcStride, Type *dst, unsigned int dstWidth,
+                        unsigned int nbChannels, const vpResizeTable &xTable, const vpResizeTable &yTable)
+    : m_src(src), m_srcStride(srcStride), m_dst(dst), m_dstWidth(dstWidth), m_nbChannels(nbChannels),
+      m_xTable(xTable), m_yTable(yTable), m_checkSSE2(useSSE2())
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    const int nbTaps = m_yTable.nbTaps;
+    const unsigned int rowSize = m_dstWidth * m_nbChannels;
+    std::vector<float> buffer(nbTaps * rowSize);
+    std::vector<int> bufferRow(nbTaps, -1);
+    std::vector<const float *> rows(nbTaps);
+
+    for (int i = begin; i < end; i++) {
+      const int *index = &m_yTable.index[i * nbTaps];
+      for (int k = 0; k < nbTaps; k++) {
+        int slot = static_cast<int>(std::find(bufferRow.begin(), bufferRow.end(), index[k]) - bufferRow.begin());
+        if (slot == nbTaps) {
+          // Reuse a row that is not needed by the current destination row
+          for (slot = 0; slot < nbTaps; slot++) {
+            if (std::find(index, index + nbTaps, bufferRow[slot]) == index + nbTaps) {
+              break;
+            }
+          }
+          resampleRow(m_src + static_cast<size_t>(index[k]) * m_srcStride, &buffer[slot * rowSize]);
+          bufferRow[slot] = index[k];
+        }
+        rows[k] = &buffer[slot * rowSize];
+      }
+
+      sumRows(&rows[0], &m_yTable.weight[i * nbTaps], m_dst + static_cast<size_t>(i) * rowSize);
+    }
+  }
+
+private:
+  void resampleRow(const Type *src, float *dst) const
+  {
+    const int nbTaps = m_xTable.nbTaps;
+    const int *index = &m_xTable.index[0];
+    const float *weight = &m_xTable.weight[0];
+
+    if (m_nbChannels == 1) {
+      // The usual numbers of taps are known at compile time
+      if (nbTaps == 2) {
+        resampleRow<2>(src, dst);
+      } else if (nbTaps == 3) {
+        resampleRow<3>(src, dst);
+      } else if (nbTaps == 4) {
+        resampleRow<4>(src, dst);
+      } else {
+        for (unsigned int j = 0; j < m_dstWidth; j++, index += nbTaps, weight += nbTaps) {
+          float sum = 0.0f;
+          for (int k = 0; k < nbTaps; k++) {
+            sum += weight[k] * toFloat(src[index[k]]);
+          }
+          dst[j] = sum;
+        }
+      }
+      return;
+    }
+
+    unsigned int j = 0;
+#if VISP_HAVE_SSE2
+    if (m_checkSSE2 && m_nbChannels == 4 && sizeof(Type) == 1) {
+      // The four channels of a pixel are resampled at once
+      const unsigned char *src8 = reinterpret_cast<const unsigned char *>(src);
+      const __m128i zero = _mm_setzero_si128();
+      for (; j < m_dstWidth; j++, index += nbTaps, weight += nbTaps) {
+        __m128 sum = _mm_setzero_ps();
+        for (int k = 0; k < nbTaps; k++) {
+          int pixel;
+          memcpy(&pixel, src8 + 4 * index[k], sizeof(pixel));
+          const __m128i p = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(pixel), zero), zero);
+          sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weight[k]), _mm_cvtepi32_ps(p)));
+        }
+        _mm_storeu_ps(dst + 4 * j, sum);
+      }
+    }
+#endif
+
+    for (; j < m_dstWidth; j++, index += nbTaps, weight += nbTaps) {
+      for (unsigned int c = 0; c < m_nbChannels; c++) {
+        float sum = 0.0f;
+        for (int k = 0; k < nbTaps; k++) {
+          sum += weight[k] * toFloat(src[m_nbChannels * index[k] + c]);
+        }
+        dst[m_nbChannels * j + c] = sum;
+      }
+    }
+  }
+
+  template <int nbTaps> void resampleRow(const Type *src, float *dst) const
+  {
+    const int *index = &m_xTable.index[0];
+    const float *weight = &m_xTable.weight[0];
+    for (unsigned int j = 0; j < m_dstWidth; j++, index += nbTaps, weight += nbTaps) {
+      float sum = weight[0] * toFloat(src[index[0]]);
+      for (int k = 1; k < nbTaps; k++) {
+        sum += weight[k] * toFloat(src[index[k]]);
+      }
+      dst[j] = sum;
+    }
+  }
+
+  void sumRows(const float *const *rows, const float *weight, Type *dst) const
+  {
+    const int nbTaps = m_yTable.nbTaps;
+    const unsigned int size = m_dstWidth * m_nbChannels;
+    unsigned int j = 0;
+
+#if VISP_HAVE_SSE2
+    if (m_checkSSE2) {
+      for (; j + 8 <= size; j += 8) {
+        __m128 sum0 = _mm_setzero_ps(), sum1 = _mm_setzero_ps();
+        for (int k = 0; k < nbTaps; k++) {
+          const __m128 w = _mm_set1_ps(weight[k]);
+          sum0 = _mm_add_ps(sum0, _mm_mul_ps(w, _mm_loadu_ps(rows[k] + j)));
+          sum1 = _mm_add_ps(sum1, _mm_mul_ps(w, _mm_loadu_ps(rows[k] + j + 4)));
+        }
+        store8(sum0, sum1, dst + j);
+      }
+    }
+#endif
+
+    for (; j < size; j++) {
+      float sum = 0.0f;
+      for (int k = 0; k < nbTaps; k++) {
+        sum += weight[k] * rows[k][j];
+      }
+      storeValue(sum, dst[j]);
+    }
+  }
+
+#if VISP_HAVE_SSE2
+  static void store8(const __m128 &v0, const __m128 &v1, float *dst)
+  {
+    _mm_storeu_ps(dst, v0);
+    _mm_storeu_ps(dst + 4, v1);
+  }
+
+  // Round half up and saturate like storeValue()
+  static void store8(const __m128 &v0, const __m128 &v1, unsigned char *dst)
+  {
+    const __m128 zero = _mm_setzero_ps(), half = _mm_set1_ps(0.5f);
+    const __m128i i0 = _mm_cvttps_epi32(_mm_add_ps(_mm_max_ps(v0, zero), half));
+    const __m128i i1 = _mm_cvttps_epi32(_mm_add_ps(_mm_max_ps(v1, zero), half));
+    const __m128i i16 = _mm_packs_epi32(i0, i1);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(dst), _mm_packus_epi16(i16, i16));
+  }
+#endif
+
+  const Type *m_src;
+  unsigned int m_srcStride;
+  Type *m_dst;
+  unsigned int m_dstWidth;
+  unsigned int m_nbChannels;
+  const vpResizeTable &m_xTable;
+  const vpResizeTable &m_yTable;
+  bool m_checkSSE2;
+};
+
+bool checkResizeSize(unsigned int srcWidth, unsigned int srcHeight, unsigned int dstWidth, unsigned int dstHeight)
+{
+  if (srcWidth < 2 || srcHeight < 2 || dstWidth < 2 || dstHeight < 2) {
+    std::cerr << "Input or output image is too small!" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+template <class Type>
+void resizeNearestNeighbor(const vpImageView<Type> &I, vpImage<Type> &Ires, unsigned int nThreads)
+{
+  std::vector<int> xIndex, yIndex;
+  buildNearestTable(I.getWidth(), Ires.getWidth(), xIndex);
+  buildNearestTable(I.getHeight(), Ires.getHeight(), yIndex);
+
+  vpResizeNearestBody<Type> body(I, Ires, xIndex, yIndex);
+  runRows(body, Ires.getWidth(), Ires.getHeight(), nThreads);
+}
+
+template <class Type>
+void resizeWithTables(const Type *src, unsigned int srcWidth, unsigned int srcHeight, unsigned int srcStride, Type *dst,
+                     unsigned int dstWidth, unsigned int dstHeight, unsigned int nbChannels,
+                     const vpImageTools::vpImageInterpolationType &method, unsigned int nThreads)
+{
+  vpResizeTable xTable, yTable;
+  buildTable(srcWidth, dstWidth, method, xTable);
+  buildTable(srcHeight, dstHeight, method, yTable);
+
+  vpResizeSeparableBody<Type> body(src, srcStride * nbChannels, dst, dstWidth, nbChannels, xTable, yTable);
+  runRows(body, dstWidth * nbChannels, dstHeight, nThreads);
+}
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Resize a grayscale image with separable kernels: the interpolation
+  coefficients of each column and row are computed once, each source row is
+  resampled horizontally and the destination rows are weighted sums of these
+  rows computed with SSE2. Bands of rows are processed by vpThreadPool.
+*/
+void vpImageTools::resizeSeparable(const vpImageView<unsigned char> &I, vpImage<unsigned char> &Ires,
+                                   const vpImageInterpolationType &method, unsigned int nThreads)
+{
+  if (!checkResizeSize(I.getWidth(), I.getHeight(), Ires.getWidth(), Ires.getHeight())) {
+    return;
+  }
+
+  if (method == INTERPOLATION_NEAREST) {
+    resizeNearestNeighbor(I, Ires, nThreads);
+  } else {
+    resizeWithTables(I[0], I.getWidth(), I.getHeight(), I.getStride(), Ires.bitmap, Ires.getWidth(),
+                     Ires.getHeight(), 1, method, nThreads);
+  }
+}
+
+/*!
+  Resize a color image with separable kernels. The four channels, alpha
+  included, are interpolated.
+*/
+void vpImageTools::resizeSeparable(const vpImageView<vpRGBa> &I, vpImage<vpRGBa> &Ires,
+                                   const vpImageInterpolationType &method, unsigned int nThreads)
+{
+  if (!checkResizeSize(I.getWidth(), I.getHeight(), Ires.getWidth(), Ires.getHeight())) {
+    return;
+  }
+
+  if (method == INTERPOLATION_NEAREST) {
+    resizeNearestNeighbor(I, Ires, nThreads);
+  } else {
+    resizeWithTables(reinterpret_cast<const unsigned char *>(I[0]), I.getWidth(), I.getHeight(), I.getStride(),
+                     reinterpret_cast<unsigned char *>(Ires.bitmap), Ires.getWidth(), Ires.getHeight(), 4, method,
+                     nThreads);
+  }
+}
+
+/*!
+  Resize a float image with separable kernels.
+*/
+void vpImageTools::resizeSeparable(const vpImageView<float> &I, vpImage<float> &Ires,
+                                   const vpImageInterpolationType &method, unsigned int nThreads)
+{
+  if (!checkResizeSize(I.getWidth(), I.getHeight(), Ires.getWidth(), Ires.getHeight())) {
+    return;
+  }
+
+  if (method == INTERPOLATION_NEAREST) {
+    resizeNearestNeighbor(I, Ires, nThreads);
+  } else {
+    resizeWithTables(I[0], I.getWidth(), I.getHeight(), I.getStride(), Ires.bitmap, Ires.getWidth(),
+                     Ires.getHeight(), 1, method, nThreads);
+  }
+}
+
+/*!
+  Resize a region of a grayscale image, without copying it, to the size of
+  \e Ires. See resize(const vpImage<Type> &, vpImage<Type> &, const vpImageInterpolationType &, unsigned int).
+
+  \param I : View of the region to resize.
+  \param Ires : Output image resized (you have to init the image \e Ires at
+  the desired size).
+  \param method : Interpolation method.
+  \param nThreads : Maximum number of vpThreadPool threads, 0 to use all of
+  them.
+*/
+void vpImageTools::resize(const vpImageView<unsigned char> &I, vpImage<unsigned char> &Ires,
+                          const vpImageInterpolationType &method, unsigned int nThreads)
+{
+  resizeSeparable(I, Ires, method, nThreads);
+}
+
+/*!
+  Resize a region of a color image, without copying it, to the size of
+  \e Ires. See resize(const vpImage<Type> &, vpImage<Type> &, const vpImageInterpolationType &, unsigned int).
+*/
+void vpImageTools::resize(const vpImageView<vpRGBa> &I, vpImage<vpRGBa> &Ires, const vpImageInterpolationType &method,
+                          unsigned int nThreads)
+{
+  resizeSeparable(I, Ires, method, nThreads);
+}
+
+/*!
+  Resize a region of a float image, without copying it, to the size of
+  \e Ires. See resize(const vpImage<Type> &, vpImage<Type> &, const vpImageInterpolationType &, unsigned int).
+*/
+void vpImageTools::resize(const vpImageView<float> &I, vpImage<float> &Ires, const vpImageInterpolationType &method,
+                          unsigned int nThreads)
+{
+  resizeSeparable(I, Ires, method, nThreads);
+}
@@ -0,0 +1,386 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Affine and perspective warps of unsigned char, vpRGBa and float images.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpImageTools_warp.cpp
+  \brief Affine and perspective warps of unsigned char, vpRGBa and float images.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpThreadPool.h>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Number of destination pixels of a band of rows processed by a thread at once
+const unsigned int warpGrainSize = 1 << 14;
+
+/*
+  Source coordinates of the pixels of a destination row. The inverse
+  transformation is applied incrementally along the row, two pixels at a time
+  with SSE2, and the coordinates are shifted so that the source pixel is given
+  by a truncation:
+  - nearest neighbor without pixel center: x + 0.5, as vpMath::round(x),
+  - bilinear with pixel center: x - 0.5.
+*/
+class vpWarpCoordinates
+{
+public:
+  vpWarpCoordinates(const vpMatrix &M, bool affine, bool linear, bool centerCorner)
+    : m_affine(affine), m_center(centerCorner ? 0.5 : 0.0), m_shift(0.0), m_checkSSE2(vpCPUFeatures::checkSSE2())
+  {
+#if !VISP_HAVE_SSE2
+    m_checkSSE2 = false;
+#endif
+    for (unsigned int i = 0; i < 3; i++) {
+      for (unsigned int j = 0; j < 3; j++) {
+        m_M[3 * i + j] = i < M.getRows() ? M[i][j] : (j == 2 ? 1.0 : 0.0);
+      }
+    }
+    if (linear) {
+      m_shift = -m_center;
+    } else if (!centerCorner) {
+      m_shift = 0.5;
+    }
+  }
+
+  void compute(unsigned int i, unsigned int width, double *xs, double *ys) const
+  {
+    const double *M = m_M;
+    const double v = i + m_center;
+    const double x0 = M[1] * v + M[2], y0 = M[4] * v + M[5], w0 = M[7] * v + M[8];
+    unsigned int j = 0;
+
+#if VISP_HAVE_SSE2
+    if (m_checkSSE2) {
+      const __m128d a0 = _mm_set1_pd(M[0]), a3 = _mm_set1_pd(M[3]), a6 = _mm_set1_pd(M[6]);
+      const __m128d vx0 = _mm_set1_pd(x0), vy0 = _mm_set1_pd(y0), vw0 = _mm_set1_pd(w0);
+      const __m128d shift = _mm_set1_pd(m_shift), two = _mm_set1_pd(2.0);
+      __m128d u = _mm_setr_pd(m_center, 1.0 + m_center);
+
+      if (m_affine) {
+        for (; j + 2 <= width; j += 2) {
+          _mm_storeu_pd(xs + j, _mm_add_pd(_mm_add_pd(_mm_mul_pd(a0, u), vx0), shift));
+          _mm_storeu_pd(ys + j, _mm_add_pd(_mm_add_pd(_mm_mul_pd(a3, u), vy0), shift));
+          u = _mm_add_pd(u, two);
+        }
+      } else {
+        const __m128d eps = _mm_set1_pd(std::numeric_limits<double>::epsilon()), one = _mm_set1_pd(1.0);
+        const __m128d zero = _mm_setzero_pd();
+        for (; j + 2 <= width; j += 2) {
+          __m128d w = _mm_add_pd(_mm_mul_pd(a6, u), vw0);
+          // As the reference implementation, a null w is replaced by 1
+          const __m128d null = _mm_cmplt_pd(_mm_max_pd(w, _mm_sub_pd(zero, w)), eps);
+          w = _mm_or_pd(_mm_and_pd(null, one), _mm_andnot_pd(null, w));
+          const __m128d x = _mm_add_pd(_mm_mul_pd(a0, u), vx0);
+          const __m128d y = _mm_add_pd(_mm_mul_pd(a3, u), vy0);
+          _mm_storeu_pd(xs + j, _mm_add_pd(_mm_div_pd(x, w), shift));
+          _mm_storeu_pd(ys + j, _mm_add_pd(_mm_div_pd(y, w), shift));
+          u = _mm_add_pd(u, two);
+        }
+      }
+    }
+#endif
+
+    for (; j < width; j++) {
+      const double u = j + m_center;
+      double w = M[6] * u + w0;
+      if (std::fabs(w) < std::numeric_limits<double>::epsilon()) {
+        w = 1.0;
+      }
+      xs[j] = (M[0] * u + x0) / w + m_shift;
+      ys[j] = (M[3] * u + y0) / w + m_shift;
+    }
+  }
+
+  bool useSSE2() const { return m_checkSSE2; }
+
+private:
+  double m_M[9];
+  bool m_affine;
+  double m_center;
+  double m_shift;
+  bool m_checkSSE2;
+};
+
+inline unsigned char roundValue(float v, unsigned char) { return static_cast<unsigned char>(v + 0.5f); }
+inline float roundValue(float v, float) { return v; }
+
+// Bilinear interpolation of a single channel image, the neighbors being clamped to the image
+template <class Type>
+inline Type interpolate(const Type *src, unsigned int stride, int x0, int y0, int dx, int dy, float s, float t)
+{
+  const Type *p = src + y0 * stride + x0;
+  const float top = p[0] + s * (p[dx] - p[0]);
+  const float bottom = p[dy] + s * (p[dy + dx] - p[dy]);
+  return roundValue(top + t * (bottom - top), Type());
+}
+
+template <class Type> class vpWarpBody : public vpParallelForBody
+{
+public:
+  vpWarpBody(const vpImage<Type> &src, vpImage<Type> &dst, const vpWarpCoordinates &coordinates, bool linear)
+    : m_src(src), m_dst(dst), m_coordinates(coordinates), m_linear(linear)
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    const unsigned int width = m_dst.getWidth();
+    const double srcWidth = m_src.getWidth(), srcHeight = m_src.getHeight();
+    const int srcStride = static_cast<int>(m_src.getWidth());
+    std::vector<double> xs(width), ys(width);
+
+    for (int i = begin; i < end; i++) {
+      m_coordinates.compute(static_cast<unsigned int>(i), width, &xs[0], &ys[0]);
+
+      unsigned int j = 0;
+      while (j < width) {
+        // Span of pixels whose source lies inside the input image
+        while (j < width && !(xs[j] >= 0.0 && xs[j] < srcWidth && ys[j] >= 0.0 && ys[j] < srcHeight)) {
+          j++;
+        }
+        const unsigned int first = j;
+        while (j < width && xs[j] >= 0.0 && xs[j] < srcWidth && ys[j] >= 0.0 && ys[j] < srcHeight) {
+          j++;
+        }
+
+        if (m_linear) {
+          interpolateSpan(&xs[first], &ys[first], j - first, m_dst[static_cast<unsigned int>(i)] + first);
+        } else {
+          Type *dst = m_dst[static_cast<unsigned int>(i)];
+          for (unsigned int k = first; k < j; k++) {
+            dst[k] = m_src.bitmap[static_cast<int>(ys[k]) * srcStride + static_cast<int>(xs[k])];
+          }
+        }
+      }
+    }
+  }
+
+private:
+  void interpolateSpan(const double *xs, const double *ys, unsigned int size, Type *dst) const;
+
+  // Top-left neighbor, offsets to the right and bottom neighbors and weights
+  void neighbors(double x, double y, int &x0, int &y0, int &dx, int &dy, float &s, float &t) const
+  {
+    x0 = static_cast<int>(x);
+    y0 = static_cast<int>(y);
+    s = static_cast<float>(x - x0);
+    t = static_cast<float>(y - y0);
+    dx = x0 + 1 < static_cast<int>(m_src.getWidth()) ? 1 : 0;
+    dy = y0 + 1 < static_cast<int>(m_src.getHeight()) ? static_cast<int>(m_src.getWidth()) : 0;
+  }
+
+  const vpImage<Type> &m_src;
+  vpImage<Type> &m_dst;
+  const vpWarpCoordinates &m_coordinates;
+  bool m_linear;
+};
+
+#if VISP_HAVE_SSE2
+inline void store4(const __m128 &v, float *dst) { _mm_storeu_ps(dst, v); }
+
+inline void store4(const __m128 &v, unsigned char *dst)
+{
+  const __m128i v32 = _mm_cvttps_epi32(_mm_add_ps(v, _mm_set1_ps(0.5f)));
+  const __m128i v16 = _mm_packs_epi32(v32, v32);
+  const int values = _mm_cvtsi128_si32(_mm_packus_epi16(v16, v16));
+  memcpy(dst, &values, 4);
+}
+#endif
+
+template <class Type>
+void vpWarpBody<Type>::interpolateSpan(const double *xs, const double *ys, unsigned int size, Type *dst) const
+{
+  unsigned int k = 0;
+
+#if VISP_HAVE_SSE2
+  if (m_coordinates.useSSE2()) {
+    // Four pixels at a time: the neighbors are gathered, the weights and the
+    // interpolation are computed with SSE2
+    const int width = static_cast<int>(m_src.getWidth());
+    const __m128 lastX = _mm_set1_ps(static_cast<float>(width - 1));
+    const __m128 lastY = _mm_set1_ps(static_cast<float>(m_src.getHeight() - 1));
+    const __m128i lastXi = _mm_set1_epi32(width - 1), lastYi = _mm_set1_epi32(static_cast<int>(m_src.getHeight()) - 1);
+    const __m128i stride = _mm_set1_epi32(width), zero = _mm_setzero_si128();
+    for (; k + 4 <= size; k += 4) {
+      // A source position past the last column or row is only interpolated
+      // along the other direction, as with a clamped position
+      const __m128 x = _mm_min_ps(_mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(xs + k)),
+                                                _mm_cvtpd_ps(_mm_loadu_pd(xs + k + 2))), lastX);
+      const __m128 y = _mm_min_ps(_mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(ys + k)),
+                                                _mm_cvtpd_ps(_mm_loadu_pd(ys + k + 2))), lastY);
+      const __m128i x0 = _mm_cvttps_epi32(x), y0 = _mm_cvttps_epi32(y);
+      const __m128 s = _mm_sub_ps(x, _mm_cvtepi32_ps(x0)), t = _mm_sub_ps(y, _mm_cvtepi32_ps(y0));
+
+      int xi[4], yi[4], dx[4], dy[4];
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(xi), x0);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(yi), y0);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dx), _mm_sub_epi32(zero, _mm_cmplt_epi32(x0, lastXi)));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dy), _mm_and_si128(_mm_cmplt_epi32(y0, lastYi), stride));
+
+      float p00[4], p01[4], p10[4], p11[4];
+      for (int n = 0; n < 4; n++) {
+        const Type *p = m_src.bitmap + yi[n] * width + xi[n];
+        p00[n] = p[0];
+        p01[n] = p[dx[n]];
+        p10[n] = p[dy[n]];
+        p11[n] = p[dy[n] + dx[n]];
+      }
+
+      const __m128 v00 = _mm_loadu_ps(p00), v01 = _mm_loadu_ps(p01);
+      const __m128 v10 = _mm_loadu_ps(p10), v11 = _mm_loadu_ps(p11);
+      const __m128 top = _mm_add_ps(v00, _mm_mul_ps(s, _mm_sub_ps(v01, v00)));
+      const __m128 bottom = _mm_add_ps(v10, _mm_mul_ps(s, _mm_sub_ps(v11, v10)));
+      store4(_mm_add_ps(top, _mm_mul_ps(t, _mm_sub_ps(bottom, top))), dst + k);
+    }
+  }
+#endif
+
+  for (; k < size; k++) {
+    int x0, y0, dx, dy;
+    float s, t;
+    neighbors(xs[k], ys[k], x0, y0, dx, dy, s, t);
+    dst[k] = interpolate(m_src.bitmap, m_src.getWidth(), x0, y0, dx, dy, s, t);
+  }
+}
+
+template <>
+void vpWarpBody<vpRGBa>::interpolateSpan(const double *xs, const double *ys, unsigned int size, vpRGBa *dst) const
+{
+  const unsigned char *src = reinterpret_cast<const unsigned char *>(m_src.bitmap);
+  const unsigned int stride = 4 * m_src.getWidth();
+  unsigned int k = 0;
+
+#if VISP_HAVE_SSE2
+  if (m_coordinates.useSSE2()) {
+    // The four channels of a pixel are interpolated at once
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 half = _mm_set1_ps(0.5f);
+    for (; k < size; k++) {
+      int x0, y0, dx, dy;
+      float s, t;
+      neighbors(xs[k], ys[k], x0, y0, dx, dy, s, t);
+      const unsigned char *p = src + y0 * stride + 4 * x0;
+      int pixels[4];
+      memcpy(&pixels[0], p, 4);
+      memcpy(&pixels[1], p + 4 * dx, 4);
+      memcpy(&pixels[2], p + 4 * dy, 4);
+      memcpy(&pixels[3], p + 4 * (dx + dy), 4);
+      const __m128i p8 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels));
+      const __m128i lo = _mm_unpacklo_epi8(p8, zero), hi = _mm_unpackhi_epi8(p8, zero);
+      const __m128 p00 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero));
+      const __m128 p01 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero));
+      const __m128 p10 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero));
+      const __m128 p11 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero));
+
+      const __m128 vs = _mm_set1_ps(s), vt = _mm_set1_ps(t);
+      const __m128 top = _mm_add_ps(p00, _mm_mul_ps(vs, _mm_sub_ps(p01, p00)));
+      const __m128 bottom = _mm_add_ps(p10, _mm_mul_ps(vs, _mm_sub_ps(p11, p10)));
+      const __m128 value = _mm_add_ps(_mm_add_ps(top, _mm_mul_ps(vt, _mm_sub_ps(bottom, top))), half);
+      const __m128i v32 = _mm_cvttps_epi32(value);
+      const __m128i v16 = _mm_packs_epi32(v32, v32);
+      const int rgba = _mm_cvtsi128_si32(_mm_packus_epi16(v16, v16));
+      memcpy(reinterpret_cast<unsigned char *>(dst + k), &rgba, 4);
+    }
+  }
+#endif
+
+  for (; k < size; k++) {
+    int x0, y0, dx, dy;
+    float s, t;
+    neighbors(xs[k], ys[k], x0, y0, dx, dy, s, t);
+    unsigned char *d = reinterpret_cast<unsigned char *>(dst + k);
+    for (int c = 0; c < 4; c++) {
+      d[c] = interpolate(src + c, stride, 4 * x0, y0, 4 * dx, 4 * dy, s, t);
+    }
+  }
+}
+
+template <class Type>
+void warp(const vpImage<Type> &src, const vpMatrix &M, vpImage<Type> &dst, bool affine, bool linear, bool centerCorner)
+{
+  vpWarpCoordinates coordinates(M, affine, linear, centerCorner);
+  vpWarpBody<Type> body(src, dst, coordinates, linear);
+  int grain = static_cast<int>(std::max(1u, warpGrainSize / std::max(1u, dst.getWidth())));
+  vpThreadPool::instance().parallel_for(0, (int)dst.getHeight(), body, grain);
+}
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Warp a grayscale image with the inverse transformation \e T (see warpImage()).
+  The destination pixels whose source is outside of \e src are left unchanged.
+*/
+bool vpImageTools::warpSpans(const vpImage<unsigned char> &src, const vpMatrix &T, vpImage<unsigned char> &dst,
+                             bool affine, bool linear, bool centerCorner)
+{
+  warp(src, T, dst, affine, linear, centerCorner);
+  return true;
+}
+
+/*!
+  Warp a color image with the inverse transformation \e T (see warpImage()).
+  The four channels, alpha included, are interpolated.
+*/
+bool vpImageTools::warpSpans(const vpImage<vpRGBa> &src, const vpMatrix &T, vpImage<vpRGBa> &dst, bool affine,
+                             bool linear, bool centerCorner)
+{
+  warp(src, T, dst, affine, linear, centerCorner);
+  return true;
+}
+
+/*!
+  Warp a float image with the inverse transformation \e T (see warpImage()).
+*/
+bool vpImageTools::warpSpans(const vpImage<float> &src, const vpMatrix &T, vpImage<float> &dst, bool affine,
+                             bool linear, bool centerCorner)
+{
+  warp(src, T, dst, affine, linear, centerCorner);
+  return true;
+}
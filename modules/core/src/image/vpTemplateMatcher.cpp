@@ -0,0 +1,567 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Template matching with zero-mean normalized cross-correlation.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpTemplateMatcher.cpp
+  \brief Template matching with zero-mean normalized cross-correlation.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpTemplateMatcher.h>
+#include <visp3/core/vpThreadPool.h>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Smallest size of the template at the coarsest level of the pyramid
+const unsigned int minTemplateSize = 4;
+// Number of candidates kept at the coarse levels for each requested match
+const unsigned int candidatesPerMatch = 4;
+// Half size of the neighbourhood searched around a candidate of the coarser level
+const int refineRadius = 2;
+
+// Template pixels and the statistics of the ZNCC denominator
+class vpTemplateData
+{
+public:
+  explicit vpTemplateData(const vpImage<unsigned char> &I_tpl)
+    : m_width(I_tpl.getWidth()), m_height(I_tpl.getHeight()), m_pixels(I_tpl.getSize()), m_sum(0), m_variance(0)
+  {
+    int64_t sqSum = 0;
+    for (unsigned int k = 0; k < I_tpl.getSize(); k++) {
+      m_pixels[k] = I_tpl.bitmap[k];
+      m_sum += I_tpl.bitmap[k];
+      sqSum += I_tpl.bitmap[k] * I_tpl.bitmap[k];
+    }
+    const int64_t n = (int64_t)I_tpl.getSize();
+    m_variance = static_cast<double>(n * sqSum - m_sum * m_sum);
+  }
+
+  unsigned int m_width, m_height;
+  std::vector<int16_t> m_pixels;
+  int64_t m_sum;
+  //! Size times the sum of the squared deviations to the mean
+  double m_variance;
+};
+
+// Inclusive range of the template positions searched at a level
+struct vpPositionRange {
+  int iMin, iMax, jMin, jMax;
+
+  bool empty() const { return iMin > iMax || jMin > jMax; }
+};
+
+struct vpCandidate {
+  int i, j;
+  double score;
+
+  bool operator<(const vpCandidate &other) const
+  {
+    // Best scores first, then the position to get a deterministic order
+    if (score != other.score) {
+      return score > other.score;
+    }
+    return i != other.i ? i < other.i : j < other.j;
+  }
+};
+
+// Sum of the products of the pixels of the image window at ptr with the template
+inline int64_t dotProduct(const unsigned char *ptr, unsigned int stride, const vpTemplateData &tpl, bool useSSE2)
+{
+  int64_t sum = 0;
+  const int16_t *t = &tpl.m_pixels[0];
+#if !VISP_HAVE_SSE2
+  (void)useSSE2;
+#endif
+
+  for (unsigned int r = 0; r < tpl.m_height; r++, ptr += stride, t += tpl.m_width) {
+    unsigned int k = 0;
+    int rowSum = 0;
+#if VISP_HAVE_SSE2
+    if (useSSE2) {
+      const __m128i zero = _mm_setzero_si128();
+      __m128i acc = zero;
+      for (; k + 16 <= tpl.m_width; k += 16) {
+        const __m128i v = _mm_loadu_si128((const __m128i *)(ptr + k));
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_unpacklo_epi8(v, zero), _mm_loadu_si128((const __m128i *)(t + k))));
+        acc = _mm_add_epi32(acc,
+                            _mm_madd_epi16(_mm_unpackhi_epi8(v, zero), _mm_loadu_si128((const __m128i *)(t + k + 8))));
+      }
+      for (; k + 8 <= tpl.m_width; k += 8) {
+        const __m128i v = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(ptr + k)), zero);
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(v, _mm_loadu_si128((const __m128i *)(t + k))));
+      }
+      acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+      acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+      rowSum = _mm_cvtsi128_si32(acc);
+    }
+#endif
+    for (; k < tpl.m_width; k++) {
+      rowSum += ptr[k] * t[k];
+    }
+    sum += rowSum;
+  }
+  return sum;
+}
+
+/*
+  ZNCC of the template at the position (i, j) of an image, with the sums of
+  the window given by the integral images. With n the number of pixels:
+
+  score = (n sum(ab) - sum(a) sum(b)) / sqrt((n sum(a^2) - sum(a)^2) (n sum(b^2) - sum(b)^2))
+
+  Windows or templates of uniform intensity get a null score.
+*/
+inline double zncc(const vpImage<unsigned char> &I, const uint64_t *sums, const uint64_t *sqSums, int i, int j,
+                   const vpTemplateData &tpl, bool useSSE2)
+{
+  const unsigned int stride = I.getWidth() + 1;
+  const unsigned int tl = (unsigned int)i * stride + (unsigned int)j, tr = tl + tpl.m_width;
+  const unsigned int bl = tl + tpl.m_height * stride, br = bl + tpl.m_width;
+  const int64_t n = (int64_t)tpl.m_pixels.size();
+  const int64_t sum = (int64_t)(sums[br] - sums[tr] - sums[bl] + sums[tl]);
+  const int64_t sqSum = (int64_t)(sqSums[br] - sqSums[tr] - sqSums[bl] + sqSums[tl]);
+
+  const double variance = static_cast<double>(n * sqSum - sum * sum) * tpl.m_variance;
+  if (variance <= 0.0) {
+    return 0.0;
+  }
+  const int64_t ab = dotProduct(I.bitmap + (unsigned int)i * I.getWidth() + j, I.getWidth(), tpl, useSSE2);
+  return static_cast<double>(n * ab - sum * tpl.m_sum) / std::sqrt(variance);
+}
+
+/*
+  Scores of the positions of rows [begin, end) of a range, stored at
+  m_scores[(i - m_iOrigin) * m_stride + j - m_jOrigin] for the position
+  (i, j). Rows and columns are visited with steps.
+*/
+class vpScoreBody : public vpParallelForBody
+{
+public:
+  vpScoreBody(const vpImage<unsigned char> &I, const uint64_t *sums, const uint64_t *sqSums,
+              const vpTemplateData &tpl, const vpPositionRange &range, unsigned int step_u, unsigned int step_v,
+              double *scores, int iOrigin, int jOrigin, unsigned int stride)
+    : m_I(I), m_sums(sums), m_sqSums(sqSums), m_tpl(tpl), m_range(range), m_step_u((int)step_u), m_step_v((int)step_v),
+      m_scores(scores), m_iOrigin(iOrigin), m_jOrigin(jOrigin), m_stride(stride)
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    bool useSSE2 = vpCPUFeatures::checkSSE2();
+#if !VISP_HAVE_SSE2
+    useSSE2 = false;
+#endif
+    for (int k = begin; k < end; k++) {
+      const int i = m_range.iMin + k * m_step_v;
+      double *scores = m_scores + (unsigned int)(i - m_iOrigin) * m_stride;
+      for (int j = m_range.jMin; j <= m_range.jMax; j += m_step_u) {
+        scores[j - m_jOrigin] = zncc(m_I, m_sums, m_sqSums, i, j, m_tpl, useSSE2);
+      }
+    }
+  }
+
+private:
+  const vpImage<unsigned char> &m_I;
+  const uint64_t *m_sums;
+  const uint64_t *m_sqSums;
+  const vpTemplateData &m_tpl;
+  vpPositionRange m_range;
+  int m_step_u, m_step_v;
+  double *m_scores;
+  int m_iOrigin, m_jOrigin;
+  unsigned int m_stride;
+};
+
+void computeIntegralImages(const vpImage<unsigned char> &I, std::vector<uint64_t> &sums,
+                           std::vector<uint64_t> &sqSums)
+{
+  const unsigned int stride = I.getWidth() + 1;
+  sums.assign(stride * (I.getHeight() + 1), 0);
+  sqSums.assign(stride * (I.getHeight() + 1), 0);
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    const unsigned char *row = I[i];
+    uint64_t rowSum = 0, rowSqSum = 0;
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      rowSum += row[j];
+      rowSqSum += row[j] * row[j];
+      sums[(i + 1) * stride + j + 1] = sums[i * stride + j + 1] + rowSum;
+      sqSums[(i + 1) * stride + j + 1] = sqSums[i * stride + j + 1] + rowSqSum;
+    }
+  }
+}
+
+/*
+  Keep the best candidates, discarding the ones closer than half the
+  template size to a better one.
+*/
+void selectPeaks(std::vector<vpCandidate> &candidates, unsigned int maxPeaks, int minDistance_i, int minDistance_j,
+                 std::vector<vpCandidate> &peaks)
+{
+  std::sort(candidates.begin(), candidates.end());
+  peaks.clear();
+  for (size_t k = 0; k < candidates.size() && peaks.size() < maxPeaks; k++) {
+    bool isolated = true;
+    for (size_t l = 0; l < peaks.size() && isolated; l++) {
+      isolated = std::abs(candidates[k].i - peaks[l].i) >= minDistance_i ||
+                 std::abs(candidates[k].j - peaks[l].j) >= minDistance_j;
+    }
+    if (isolated) {
+      peaks.push_back(candidates[k]);
+    }
+  }
+}
+
+// Positions of a score map that are not lower than their 8 neighbours
+void localMaxima(const std::vector<double> &scores, const vpPositionRange &range, double minScore,
+                 std::vector<vpCandidate> &candidates)
+{
+  const int rows = range.iMax - range.iMin + 1, cols = range.jMax - range.jMin + 1;
+  candidates.clear();
+  for (int r = 0; r < rows; r++) {
+    for (int c = 0; c < cols; c++) {
+      const double score = scores[(unsigned int)(r * cols + c)];
+      if (score < minScore) {
+        continue;
+      }
+      bool isMaximum = true;
+      for (int dr = std::max(r - 1, 0); dr <= std::min(r + 1, rows - 1) && isMaximum; dr++) {
+        for (int dc = std::max(c - 1, 0); dc <= std::min(c + 1, cols - 1) && isMaximum; dc++) {
+          isMaximum = scores[(unsigned int)(dr * cols + dc)] <= score;
+        }
+      }
+      if (isMaximum) {
+        vpCandidate candidate = {range.iMin + r, range.jMin + c, score};
+        candidates.push_back(candidate);
+      }
+    }
+  }
+}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Default constructor. The search is exhaustive at full resolution over the
+  whole image and returns the best match with a positive score.
+*/
+vpTemplateMatcher::vpTemplateMatcher()
+  : m_pyramid(), m_sums(), m_sqSums(), m_nbLevels(0), m_maxMatches(1), m_minScore(0.0), m_useROI(false), m_roi()
+{
+}
+
+void vpTemplateMatcher::buildLevels()
+{
+  if (m_pyramid.empty()) {
+    return;
+  }
+  m_pyramid.resize(1);
+  while (m_pyramid.size() <= m_nbLevels && m_pyramid.back().getHeight() / 2 >= minTemplateSize &&
+         m_pyramid.back().getWidth() / 2 >= minTemplateSize) {
+    vpImage<unsigned char> I_down;
+    vpImageFilter::getGaussPyramidal(m_pyramid.back(), I_down);
+    m_pyramid.push_back(I_down);
+  }
+
+  m_sums.resize(m_pyramid.size());
+  m_sqSums.resize(m_pyramid.size());
+  for (size_t l = 0; l < m_pyramid.size(); l++) {
+    computeIntegralImages(m_pyramid[l], m_sums[l], m_sqSums[l]);
+  }
+}
+
+/*!
+  Compute the score of each position of a template in the image set with
+  setImage(), at full resolution and regardless of the region of interest.
+
+  \param I_tpl : Template image.
+  \param I_score : Score of the template with its top-left corner at each
+  position of the image, of size (I.getHeight() - I_tpl.getHeight() + 1) x
+  (I.getWidth() - I_tpl.getWidth() + 1). Positions skipped by the steps are
+  set to 0.
+  \param step_u, step_v : Steps between the columns and the rows of the
+  positions to evaluate.
+*/
+void vpTemplateMatcher::computeScores(const vpImage<unsigned char> &I_tpl, vpImage<double> &I_score,
+                                      unsigned int step_u, unsigned int step_v) const
+{
+  if (m_pyramid.empty()) {
+    throw(vpException(vpException::notInitialized, "No image to search the template in"));
+  }
+  const vpImage<unsigned char> &I = m_pyramid[0];
+  if (I_tpl.getSize() == 0 || I_tpl.getHeight() > I.getHeight() || I_tpl.getWidth() > I.getWidth()) {
+    throw(vpException(vpException::dimensionError, "Cannot search a %dx%d template in a %dx%d image",
+                      I_tpl.getWidth(), I_tpl.getHeight(), I.getWidth(), I.getHeight()));
+  }
+  step_u = std::max(step_u, 1u);
+  step_v = std::max(step_v, 1u);
+
+  I_score.resize(I.getHeight() - I_tpl.getHeight() + 1, I.getWidth() - I_tpl.getWidth() + 1, 0.0);
+  const vpTemplateData tpl(I_tpl);
+  vpPositionRange range = {0, (int)I_score.getHeight() - 1, 0, (int)I_score.getWidth() - 1};
+  vpScoreBody body(I, &m_sums[0][0], &m_sqSums[0][0], tpl, range, step_u, step_v, I_score.bitmap, 0, 0,
+                   I_score.getWidth());
+  vpThreadPool::instance().parallel_for(0, (int)((I_score.getHeight() - 1) / step_v + 1), body);
+}
+
+/*!
+  Search a template in the image set with setImage().
+
+  \param I_tpl : Template image.
+  \param matches : At most getMaxMatches() locations of the template with a
+  score of at least getMinScore(), sorted by decreasing score. Two matches
+  are at least half the template size apart.
+*/
+void vpTemplateMatcher::match(const vpImage<unsigned char> &I_tpl, std::vector<vpMatch> &matches) const
+{
+  if (m_pyramid.empty()) {
+    throw(vpException(vpException::notInitialized, "No image to search the template in"));
+  }
+  if (I_tpl.getSize() == 0 || I_tpl.getHeight() > m_pyramid[0].getHeight() ||
+      I_tpl.getWidth() > m_pyramid[0].getWidth()) {
+    throw(vpException(vpException::dimensionError, "Cannot search a %dx%d template in a %dx%d image",
+                      I_tpl.getWidth(), I_tpl.getHeight(), m_pyramid[0].getWidth(), m_pyramid[0].getHeight()));
+  }
+
+  // Template pyramid and search ranges, down to the coarsest level where the
+  // template stays large enough and the region of interest is not empty
+  std::vector<vpImage<unsigned char> > tplPyramid(1, I_tpl);
+  std::vector<vpPositionRange> ranges;
+  for (size_t l = 0; l < m_pyramid.size(); l++) {
+    if (l > 0) {
+      const vpImage<unsigned char> &prev = tplPyramid.back();
+      if (prev.getHeight() / 2 < minTemplateSize || prev.getWidth() / 2 < minTemplateSize) {
+        break;
+      }
+      vpImage<unsigned char> I_down;
+      vpImageFilter::getGaussPyramidal(prev, I_down);
+      tplPyramid.push_back(I_down);
+    }
+
+    const double scale = 1.0 / (1 << l);
+    const int maxI = (int)m_pyramid[l].getHeight() - (int)tplPyramid[l].getHeight();
+    const int maxJ = (int)m_pyramid[l].getWidth() - (int)tplPyramid[l].getWidth();
+    vpPositionRange range = {0, maxI, 0, maxJ};
+    if (m_useROI) {
+      range.iMin = std::max(range.iMin, (int)std::ceil(m_roi.getTop() * scale));
+      range.jMin = std::max(range.jMin, (int)std::ceil(m_roi.getLeft() * scale));
+      range.iMax = std::min(range.iMax, (int)std::floor((m_roi.getTop() + m_roi.getHeight()) * scale) -
+                                            (int)tplPyramid[l].getHeight());
+      range.jMax = std::min(range.jMax, (int)std::floor((m_roi.getLeft() + m_roi.getWidth()) * scale) -
+                                            (int)tplPyramid[l].getWidth());
+    }
+    if (range.empty() && l > 0) {
+      tplPyramid.pop_back();
+      break;
+    }
+    ranges.push_back(range);
+  }
+
+  matches.clear();
+  if (ranges[0].empty()) {
+    return;
+  }
+
+  bool useSSE2 = vpCPUFeatures::checkSSE2();
+#if !VISP_HAVE_SSE2
+  useSSE2 = false;
+#endif
+
+  // Exhaustive search at the coarsest level
+  const size_t top = ranges.size() - 1;
+  const vpPositionRange &range = ranges[top];
+  const unsigned int cols = (unsigned int)(range.jMax - range.jMin + 1);
+  std::vector<double> scores((unsigned int)(range.iMax - range.iMin + 1) * cols);
+  std::vector<vpTemplateData> tpls;
+  for (size_t l = 0; l < tplPyramid.size(); l++) {
+    tpls.push_back(vpTemplateData(tplPyramid[l]));
+  }
+  vpScoreBody body(m_pyramid[top], &m_sums[top][0], &m_sqSums[top][0], tpls[top], range, 1, 1, &scores[0],
+                   range.iMin, range.jMin, cols);
+  vpThreadPool::instance().parallel_for(0, range.iMax - range.iMin + 1, body);
+
+  std::vector<vpCandidate> candidates, peaks;
+  localMaxima(scores, range, top == 0 ? m_minScore : -std::numeric_limits<double>::max(), candidates);
+  selectPeaks(candidates, top == 0 ? m_maxMatches : candidatesPerMatch * m_maxMatches,
+              (int)std::max(1u, tpls[top].m_height / 2), (int)std::max(1u, tpls[top].m_width / 2), peaks);
+
+  // Refinement around the peaks at the finer levels
+  for (size_t l = top; l-- > 0;) {
+    candidates.clear();
+    for (size_t k = 0; k < peaks.size(); k++) {
+      vpCandidate best = {0, 0, -std::numeric_limits<double>::max()};
+      const int iMin = std::max(2 * peaks[k].i - refineRadius, ranges[l].iMin);
+      const int iMax = std::min(2 * peaks[k].i + refineRadius, ranges[l].iMax);
+      const int jMin = std::max(2 * peaks[k].j - refineRadius, ranges[l].jMin);
+      const int jMax = std::min(2 * peaks[k].j + refineRadius, ranges[l].jMax);
+      for (int i = iMin; i <= iMax; i++) {
+        for (int j = jMin; j <= jMax; j++) {
+          const double score = zncc(m_pyramid[l], &m_sums[l][0], &m_sqSums[l][0], i, j, tpls[l], useSSE2);
+          if (score > best.score) {
+            vpCandidate candidate = {i, j, score};
+            best = candidate;
+          }
+        }
+      }
+      if (iMin <= iMax && jMin <= jMax && (l > 0 || best.score >= m_minScore)) {
+        candidates.push_back(best);
+      }
+    }
+    selectPeaks(candidates, l == 0 ? m_maxMatches : candidatesPerMatch * m_maxMatches,
+                (int)std::max(1u, tpls[l].m_height / 2), (int)std::max(1u, tpls[l].m_width / 2), peaks);
+  }
+
+  for (size_t k = 0; k < peaks.size(); k++) {
+    vpMatch match;
+    match.i = (unsigned int)peaks[k].i;
+    match.j = (unsigned int)peaks[k].j;
+    match.score = peaks[k].score;
+    matches.push_back(match);
+  }
+}
+
+/*!
+  Search a region of an image, given by a view, as template in the image set
+  with setImage(). See match(const vpImage<unsigned char> &, std::vector<vpMatch> &).
+
+  \param I_tpl : View of the template.
+  \param matches : Matches of the template.
+*/
+void vpTemplateMatcher::match(const vpImageView<unsigned char> &I_tpl, std::vector<vpMatch> &matches) const
+{
+  vpImage<unsigned char> tpl;
+  I_tpl.copyTo(tpl);
+  match(tpl, matches);
+}
+
+/*!
+  Search several templates in the image set with setImage(). The integral
+  images and the pyramid of the image are shared by all the searches.
+
+  \param templates : Template images.
+  \param matches : Matches of each template, see match(const vpImage<unsigned char> &, std::vector<vpMatch> &).
+*/
+void vpTemplateMatcher::match(const std::vector<vpImage<unsigned char> > &templates,
+                              std::vector<std::vector<vpMatch> > &matches) const
+{
+  matches.resize(templates.size());
+  for (size_t k = 0; k < templates.size(); k++) {
+    match(templates[k], matches[k]);
+  }
+}
+
+/*!
+  Search the templates in the whole image.
+
+  \sa setROI()
+*/
+void vpTemplateMatcher::resetROI() { m_useROI = false; }
+
+/*!
+  Set the image to search the templates in and compute its integral images
+  and pyramid.
+
+  \param I : Image.
+*/
+void vpTemplateMatcher::setImage(const vpImage<unsigned char> &I)
+{
+  if (I.getSize() == 0) {
+    throw(vpException(vpException::dimensionError, "Cannot search templates in an empty image"));
+  }
+  m_pyramid.assign(1, I);
+  buildLevels();
+}
+
+/*!
+  Set a region of an image, given by a view, as the image to search the
+  templates in. The region is copied once into the full resolution level of
+  the pyramid, no intermediate cropped image is needed.
+
+  \param I : View of the region.
+*/
+void vpTemplateMatcher::setImage(const vpImageView<unsigned char> &I)
+{
+  if (I.getSize() == 0) {
+    throw(vpException(vpException::dimensionError, "Cannot search templates in an empty image"));
+  }
+  m_pyramid.resize(1);
+  I.copyTo(m_pyramid[0]);
+  buildLevels();
+}
+
+/*!
+  Set the maximum number of matches returned by match(). Default is 1.
+
+  \param maxMatches : Maximum number of matches, at least 1.
+*/
+void vpTemplateMatcher::setMaxMatches(unsigned int maxMatches) { m_maxMatches = std::max(maxMatches, 1u); }
+
+/*!
+  Set the number of levels of the pyramid built above the full resolution
+  image. With 0, the default, the search is exhaustive at full resolution.
+  Levels where the template would be smaller than 4 pixels are not used.
+
+  \param nbLevels : Number of coarse levels.
+*/
+void vpTemplateMatcher::setPyramidLevels(unsigned int nbLevels)
+{
+  m_nbLevels = nbLevels;
+  buildLevels();
+}
+
+/*!
+  Restrict the search to the templates entirely inside a region of the
+  image.
+
+  \param roi : Region of interest in the full resolution image.
+
+  \sa resetROI()
+*/
+void vpTemplateMatcher::setROI(const vpRect &roi)
+{
+  m_roi = roi;
+  m_useROI = true;
+}
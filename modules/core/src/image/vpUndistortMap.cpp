@@ -0,0 +1,503 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Precomputed undistortion and rectification map.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpUndistortMap.cpp
+  \brief Precomputed undistortion and rectification map.
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpThreadPool.h>
+#include <visp3/core/vpUndistortMap.h>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Sub-pixel positions are quantized to 1/interSize pixel
+const int interBits = 5;
+const int interSize = 1 << interBits;
+// Positions inside a source pixel, from 0 to interSize included so that the
+// last row and column of the source image can be reached
+const int nbPositions = interSize + 1;
+// The four bilinear weights of a position sum to 1 << weightBits
+const int weightBits = 2 * interBits;
+// Index of the null weights used for the pixels without source
+const uint16_t outsideIndex = nbPositions * nbPositions;
+
+// Number of destination pixels processed by a thread at once
+const unsigned int remapGrainSize = 1 << 15;
+
+/*
+  Bilinear weights (top-left, top-right, bottom-left, bottom-right) of each
+  position (fu, fv) stored at index fv * nbPositions + fu, followed by null
+  weights.
+*/
+class vpBilinearWeights
+{
+public:
+  vpBilinearWeights() : m_weights(4 * (nbPositions * nbPositions + 1), 0)
+  {
+    for (int fv = 0; fv < nbPositions; fv++) {
+      for (int fu = 0; fu < nbPositions; fu++) {
+        int16_t *w = &m_weights[4 * (fv * nbPositions + fu)];
+        w[0] = static_cast<int16_t>((interSize - fu) * (interSize - fv));
+        w[1] = static_cast<int16_t>(fu * (interSize - fv));
+        w[2] = static_cast<int16_t>((interSize - fu) * fv);
+        w[3] = static_cast<int16_t>(fu * fv);
+      }
+    }
+  }
+
+  const int16_t *operator[](uint16_t index) const { return &m_weights[4 * index]; }
+
+private:
+  std::vector<int16_t> m_weights;
+};
+
+const vpBilinearWeights bilinearWeights;
+
+// Fixed-point coordinate of a source position, or -1 if it is outside of [0, size - 1]
+inline int toFixedPoint(double x, unsigned int size)
+{
+  const double fixedPoint = std::floor(x * interSize + 0.5);
+  if (!(fixedPoint >= 0.0 && fixedPoint <= static_cast<double>((size - 1) * interSize))) {
+    return -1;
+  }
+  return static_cast<int>(fixedPoint);
+}
+
+// Split a fixed-point coordinate into the top-left pixel and the position
+// inside that pixel, staying inside the image for the last row or column
+inline void splitFixedPoint(int x, unsigned int size, int &pixel, int &position)
+{
+  pixel = x >> interBits;
+  position = x & (interSize - 1);
+  if (pixel >= static_cast<int>(size) - 1) {
+    pixel = static_cast<int>(size) - 2;
+    position += interSize;
+  }
+}
+
+void runRows(vpParallelForBody &body, unsigned int width, unsigned int height, unsigned int nThreads)
+{
+  int grain = static_cast<int>(std::max(1u, remapGrainSize / std::max(1u, width)));
+  vpThreadPool::instance().parallel_for(0, (int)height, body, grain, nThreads);
+}
+
+class vpRemapGreyBody : public vpParallelForBody
+{
+public:
+  vpRemapGreyBody(const unsigned char *src, unsigned int srcWidth, const int16_t *coords, const uint16_t *weightIndex,
+                  unsigned char *dst, unsigned int width)
+    : m_src(src), m_srcWidth(srcWidth), m_coords(coords), m_weightIndex(weightIndex), m_dst(dst), m_width(width)
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    const vpBilinearWeights &weights = bilinearWeights;
+    bool checkSSE2 = vpCPUFeatures::checkSSE2();
+#if !VISP_HAVE_SSE2
+    checkSSE2 = false;
+#endif
+
+    for (int i = begin; i < end; i++) {
+      const unsigned int offset = (unsigned int)i * m_width;
+      const int16_t *coords = m_coords + 2 * offset;
+      const uint16_t *index = m_weightIndex + offset;
+      unsigned char *dst = m_dst + offset;
+      unsigned int j = 0;
+
+#if VISP_HAVE_SSE2
+      if (checkSSE2) {
+        const __m128i round = _mm_set1_epi32(1 << (weightBits - 1));
+        for (; j + 8 <= m_width; j += 8) {
+          int top[8], bottom[8], wTop[8], wBottom[8];
+          for (int k = 0; k < 8; k++) {
+            // Pairs of horizontal neighbours and of their weights as 32-bit
+            // words of two 16-bit values
+            const unsigned char *p = m_src + coords[2 * (j + k) + 1] * m_srcWidth + coords[2 * (j + k)];
+            const int16_t *w = weights[index[j + k]];
+            top[k] = p[0] | (p[1] << 16);
+            bottom[k] = p[m_srcWidth] | (p[m_srcWidth + 1] << 16);
+            wTop[k] = (uint16_t)w[0] | ((uint16_t)w[1] << 16);
+            wBottom[k] = (uint16_t)w[2] | ((uint16_t)w[3] << 16);
+          }
+          __m128i sums[2];
+          for (int k = 0; k < 2; k++) {
+            const __m128i t = _mm_loadu_si128((const __m128i *)(top + 4 * k));
+            const __m128i b = _mm_loadu_si128((const __m128i *)(bottom + 4 * k));
+            const __m128i wt = _mm_loadu_si128((const __m128i *)(wTop + 4 * k));
+            const __m128i wb = _mm_loadu_si128((const __m128i *)(wBottom + 4 * k));
+            const __m128i sum = _mm_add_epi32(_mm_madd_epi16(t, wt), _mm_madd_epi16(b, wb));
+            sums[k] = _mm_srai_epi32(_mm_add_epi32(sum, round), weightBits);
+          }
+          const __m128i values = _mm_packs_epi32(sums[0], sums[1]);
+          _mm_storel_epi64((__m128i *)(dst + j), _mm_packus_epi16(values, values));
+        }
+      }
+#endif
+
+      for (; j < m_width; j++) {
+        const unsigned char *p = m_src + coords[2 * j + 1] * m_srcWidth + coords[2 * j];
+        const int16_t *w = weights[index[j]];
+        dst[j] = static_cast<unsigned char>(
+            (p[0] * w[0] + p[1] * w[1] + p[m_srcWidth] * w[2] + p[m_srcWidth + 1] * w[3] + (1 << (weightBits - 1))) >>
+            weightBits);
+      }
+    }
+  }
+
+private:
+  const unsigned char *m_src;
+  unsigned int m_srcWidth;
+  const int16_t *m_coords;
+  const uint16_t *m_weightIndex;
+  unsigned char *m_dst;
+  unsigned int m_width;
+};
+
+class vpRemapRGBaBody : public vpParallelForBody
+{
+public:
+  vpRemapRGBaBody(const unsigned char *src, unsigned int srcWidth, const int16_t *coords, const uint16_t *weightIndex,
+                  unsigned char *dst, unsigned int width)
+    : m_src(src), m_srcWidth(srcWidth), m_coords(coords), m_weightIndex(weightIndex), m_dst(dst), m_width(width)
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    const vpBilinearWeights &weights = bilinearWeights;
+    const unsigned int stride = 4 * m_srcWidth;
+    bool checkSSE2 = vpCPUFeatures::checkSSE2();
+#if !VISP_HAVE_SSE2
+    checkSSE2 = false;
+#endif
+
+    for (int i = begin; i < end; i++) {
+      const unsigned int offset = (unsigned int)i * m_width;
+      const int16_t *coords = m_coords + 2 * offset;
+      const uint16_t *index = m_weightIndex + offset;
+      unsigned char *dst = m_dst + 4 * offset;
+      unsigned int j = 0;
+
+#if VISP_HAVE_SSE2
+      if (checkSSE2) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i round = _mm_set1_epi32(1 << (weightBits - 1));
+        for (; j + 2 <= m_width; j += 2) {
+          __m128i sums[2];
+          for (int k = 0; k < 2; k++) {
+            const unsigned char *p = m_src + coords[2 * (j + k) + 1] * stride + 4 * coords[2 * (j + k)];
+            // R0 G0 B0 A0 R1 G1 B1 A1 reordered as R0 R1 G0 G1 B0 B1 A0 A1
+            __m128i t = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)p), zero);
+            __m128i b = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(p + stride)), zero);
+            t = _mm_unpacklo_epi16(t, _mm_unpackhi_epi64(t, t));
+            b = _mm_unpacklo_epi16(b, _mm_unpackhi_epi64(b, b));
+
+            const __m128i w = _mm_loadl_epi64((const __m128i *)weights[index[j + k]]);
+            const __m128i sum = _mm_add_epi32(_mm_madd_epi16(t, _mm_shuffle_epi32(w, 0x00)),
+                                              _mm_madd_epi16(b, _mm_shuffle_epi32(w, 0x55)));
+            sums[k] = _mm_srai_epi32(_mm_add_epi32(sum, round), weightBits);
+          }
+          const __m128i values = _mm_packs_epi32(sums[0], sums[1]);
+          _mm_storel_epi64((__m128i *)(dst + 4 * j), _mm_packus_epi16(values, values));
+        }
+      }
+#endif
+
+      for (; j < m_width; j++) {
+        const unsigned char *p = m_src + coords[2 * j + 1] * stride + 4 * coords[2 * j];
+        const int16_t *w = weights[index[j]];
+        for (unsigned int c = 0; c < 4; c++) {
+          dst[4 * j + c] = static_cast<unsigned char>((p[c] * w[0] + p[4 + c] * w[1] + p[stride + c] * w[2] +
+                                                       p[stride + 4 + c] * w[3] + (1 << (weightBits - 1))) >>
+                                                      weightBits);
+        }
+      }
+    }
+  }
+
+private:
+  const unsigned char *m_src;
+  unsigned int m_srcWidth;
+  const int16_t *m_coords;
+  const uint16_t *m_weightIndex;
+  unsigned char *m_dst;
+  unsigned int m_width;
+};
+
+class vpRemapDepthBody : public vpParallelForBody
+{
+public:
+  vpRemapDepthBody(const uint16_t *src, unsigned int srcWidth, const int16_t *coords, const uint16_t *weightIndex,
+                   uint16_t *dst, unsigned int width)
+    : m_src(src), m_srcWidth(srcWidth), m_coords(coords), m_weightIndex(weightIndex), m_dst(dst), m_width(width)
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    const vpBilinearWeights &weights = bilinearWeights;
+
+    for (int i = begin; i < end; i++) {
+      const unsigned int offset = (unsigned int)i * m_width;
+      const int16_t *coords = m_coords + 2 * offset;
+      const uint16_t *index = m_weightIndex + offset;
+      uint16_t *dst = m_dst + offset;
+
+      for (unsigned int j = 0; j < m_width; j++) {
+        const uint16_t *p = m_src + coords[2 * j + 1] * m_srcWidth + coords[2 * j];
+        const int16_t *w = weights[index[j]];
+        const int values[4] = {p[0], p[1], p[m_srcWidth], p[m_srcWidth + 1]};
+
+        // Missing depths are not blended with the valid ones: take the
+        // nearest neighbour instead
+        bool missing = false;
+        int nearest = 0;
+        for (int k = 0; k < 4; k++) {
+          missing = missing || (w[k] != 0 && values[k] == 0);
+          nearest = w[k] > w[nearest] ? k : nearest;
+        }
+        if (missing) {
+          dst[j] = w[nearest] != 0 ? static_cast<uint16_t>(values[nearest]) : 0;
+        } else {
+          dst[j] = static_cast<uint16_t>((values[0] * w[0] + values[1] * w[1] + values[2] * w[2] + values[3] * w[3] +
+                                          (1 << (weightBits - 1))) >>
+                                         weightBits);
+        }
+      }
+    }
+  }
+
+private:
+  const uint16_t *m_src;
+  unsigned int m_srcWidth;
+  const int16_t *m_coords;
+  const uint16_t *m_weightIndex;
+  uint16_t *m_dst;
+  unsigned int m_width;
+};
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Default constructor. The map is empty until init() is called.
+*/
+vpUndistortMap::vpUndistortMap()
+  : m_width(0), m_height(0), m_srcWidth(0), m_srcHeight(0), m_coords(), m_weightIndex()
+{
+}
+
+/*!
+  Build the map that undistorts the images of size \e width x \e height
+  acquired by a camera.
+
+  \param cam : Parameters of the camera causing distortion.
+  \param width, height : Size of the acquired and undistorted images.
+
+  \sa init(const vpCameraParameters &, unsigned int, unsigned int)
+*/
+vpUndistortMap::vpUndistortMap(const vpCameraParameters &cam, unsigned int width, unsigned int height)
+  : m_width(0), m_height(0), m_srcWidth(0), m_srcHeight(0), m_coords(), m_weightIndex()
+{
+  init(cam, width, height);
+}
+
+/*!
+  Build the map that undistorts the images of size \e width x \e height
+  acquired by a camera. The undistorted images have the same size and the
+  same intrinsic parameters as the camera, without distortion.
+
+  \param cam : Parameters of the camera causing distortion.
+  \param width, height : Size of the acquired and undistorted images.
+*/
+void vpUndistortMap::init(const vpCameraParameters &cam, unsigned int width, unsigned int height)
+{
+  init(cam, width, height, vpRotationMatrix(), cam, width, height);
+}
+
+/*!
+  Build the map that undistorts and rectifies the images of size \e width x
+  \e height acquired by a camera. This is typically used on each camera of a
+  stereo rig to get images whose epipolar lines are the image rows.
+
+  The rectified image is the image of a virtual camera with parameters \e
+  camRect, without distortion, that shares the optical center of the real
+  camera and whose orientation is given by \e rRc.
+
+  \param cam : Parameters of the camera causing distortion.
+  \param width, height : Size of the acquired images.
+  \param rRc : Rotation from the frame of the camera to the frame of the
+  rectified camera.
+  \param camRect : Parameters of the rectified camera. Its distortion
+  parameters are ignored.
+  \param rectWidth, rectHeight : Size of the rectified images.
+*/
+void vpUndistortMap::init(const vpCameraParameters &cam, unsigned int width, unsigned int height,
+                          const vpRotationMatrix &rRc, const vpCameraParameters &camRect, unsigned int rectWidth,
+                          unsigned int rectHeight)
+{
+  if (width < 2 || height < 2 || width > 32767 || height > 32767) {
+    throw(vpException(vpException::dimensionError, "Cannot build an undistortion map for %dx%d images", width,
+                      height));
+  }
+  if (rectWidth == 0 || rectHeight == 0) {
+    throw(vpException(vpException::dimensionError, "Cannot build an undistortion map to %dx%d images", rectWidth,
+                      rectHeight));
+  }
+
+  m_width = rectWidth;
+  m_height = rectHeight;
+  m_srcWidth = width;
+  m_srcHeight = height;
+  m_coords.assign(2 * m_width * m_height, 0);
+  m_weightIndex.assign(m_width * m_height, outsideIndex);
+
+  const double u0 = cam.get_u0(), v0 = cam.get_v0(), px = cam.get_px(), py = cam.get_py();
+  const double kud = cam.get_projModel() == vpCameraParameters::perspectiveProjWithDistortion ? cam.get_kud() : 0.0;
+  const double u0r = camRect.get_u0(), v0r = camRect.get_v0();
+  const double inv_pxr = camRect.get_px_inverse(), inv_pyr = camRect.get_py_inverse();
+
+  for (unsigned int v = 0; v < m_height; v++) {
+    const double yr = (v - v0r) * inv_pyr;
+    for (unsigned int u = 0; u < m_width; u++) {
+      const double xr = (u - u0r) * inv_pxr;
+
+      // Ray of the rectified pixel expressed in the camera frame
+      const double X = rRc[0][0] * xr + rRc[1][0] * yr + rRc[2][0];
+      const double Y = rRc[0][1] * xr + rRc[1][1] * yr + rRc[2][1];
+      const double Z = rRc[0][2] * xr + rRc[1][2] * yr + rRc[2][2];
+      if (Z <= 0.0) {
+        continue;
+      }
+      const double x = X / Z, y = Y / Z;
+      const double fr = 1.0 + kud * (x * x + y * y);
+
+      const int us = toFixedPoint(u0 + px * x * fr, m_srcWidth);
+      const int vs = toFixedPoint(v0 + py * y * fr, m_srcHeight);
+      if (us < 0 || vs < 0) {
+        continue;
+      }
+
+      int ui, fu, vi, fv;
+      splitFixedPoint(us, m_srcWidth, ui, fu);
+      splitFixedPoint(vs, m_srcHeight, vi, fv);
+      const unsigned int k = v * m_width + u;
+      m_coords[2 * k] = static_cast<int16_t>(ui);
+      m_coords[2 * k + 1] = static_cast<int16_t>(vi);
+      m_weightIndex[k] = static_cast<uint16_t>(fv * nbPositions + fu);
+    }
+  }
+}
+
+void vpUndistortMap::checkSourceSize(unsigned int width, unsigned int height) const
+{
+  if (m_weightIndex.empty()) {
+    throw(vpException(vpException::notInitialized, "The undistortion map is not initialized"));
+  }
+  if (width != m_srcWidth || height != m_srcHeight) {
+    throw(vpException(vpException::dimensionError, "Cannot remap a %dx%d image with a map built for %dx%d images",
+                      width, height, m_srcWidth, m_srcHeight));
+  }
+}
+
+/*!
+  Undistort a grey image.
+
+  \param I : Image acquired by the camera, of the size given to init().
+  \param Iundist : Undistorted image, resized to getHeight() x getWidth().
+  \param nThreads : Maximum number of threads of vpThreadPool to use. If 0,
+  all the threads of the pool can be used.
+*/
+void vpUndistortMap::remap(const vpImage<unsigned char> &I, vpImage<unsigned char> &Iundist,
+                           unsigned int nThreads) const
+{
+  checkSourceSize(I.getWidth(), I.getHeight());
+  Iundist.resize(m_height, m_width);
+
+  vpRemapGreyBody body(I.bitmap, m_srcWidth, &m_coords[0], &m_weightIndex[0], Iundist.bitmap, m_width);
+  runRows(body, m_width, m_height, nThreads);
+}
+
+/*!
+  Undistort a color image. The four channels, alpha included, are
+  interpolated.
+
+  \param I : Image acquired by the camera, of the size given to init().
+  \param Iundist : Undistorted image, resized to getHeight() x getWidth().
+  \param nThreads : Maximum number of threads of vpThreadPool to use. If 0,
+  all the threads of the pool can be used.
+*/
+void vpUndistortMap::remap(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &Iundist, unsigned int nThreads) const
+{
+  checkSourceSize(I.getWidth(), I.getHeight());
+  Iundist.resize(m_height, m_width);
+
+  vpRemapRGBaBody body(reinterpret_cast<const unsigned char *>(I.bitmap), m_srcWidth, &m_coords[0],
+                       &m_weightIndex[0], reinterpret_cast<unsigned char *>(Iundist.bitmap), m_width);
+  runRows(body, m_width, m_height, nThreads);
+}
+
+/*!
+  Undistort a depth image. Null depths are considered as missing: a
+  destination pixel whose interpolation involves a missing depth takes the
+  depth of the nearest source pixel instead of a blend.
+
+  \param I : Depth image acquired by the camera, of the size given to init().
+  \param Iundist : Undistorted depth image, resized to getHeight() x
+  getWidth().
+  \param nThreads : Maximum number of threads of vpThreadPool to use. If 0,
+  all the threads of the pool can be used.
+*/
+void vpUndistortMap::remap(const vpImage<uint16_t> &I, vpImage<uint16_t> &Iundist, unsigned int nThreads) const
+{
+  checkSourceSize(I.getWidth(), I.getHeight());
+  Iundist.resize(m_height, m_width);
+
+  vpRemapDepthBody body(I.bitmap, m_srcWidth, &m_coords[0], &m_weightIndex[0], Iundist.bitmap, m_width);
+  runRows(body, m_width, m_height, nThreads);
+}
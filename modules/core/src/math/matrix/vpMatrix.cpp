@@ -126,6 +126,28 @@ namespace {
 }
 #endif
 
+unsigned int vpMatrix::m_lapack_min_size = 0;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/*!
+  Return true when a product involving m x k and k x n matrices has to be
+  computed with the external BLAS library rather than with the built-in
+  implementation. For matrix-vector products, the vector is not taken into
+  account and n is set to the other dimension of the matrix.
+*/
+bool vpMatrix::useBlas(unsigned int m, unsigned int n, unsigned int k)
+{
+#if defined(VISP_HAVE_LAPACK) && !defined(VISP_HAVE_LAPACK_BUILT_IN)
+  return m >= m_lapack_min_size && n >= m_lapack_min_size && k >= m_lapack_min_size;
+#else
+  (void)m;
+  (void)n;
+  (void)k;
+  return false;
+#endif
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 // Prototypes of specific functions
 vpMatrix subblock(const vpMatrix &, unsigned int, unsigned int);
 
@@ -618,21 +640,7 @@ void vpMatrix::AAt(vpMatrix &B) const
     B.resize(rowNum, rowNum, false, false);
 
   // compute A*A^T
-  for (unsigned int i = 0; i < rowNum; i++) {
-    for (unsigned int j = i; j < rowNum; j++) {
-      double *pi = rowPtrs[i]; // row i
-      double *pj = rowPtrs[j]; // row j
-
-      // sum (row i .* row j)
-      double ssum = 0;
-      for (unsigned int k = 0; k < colNum; k++)
-        ssum += *(pi++) * *(pj++);
-
-      B[i][j] = ssum; // upper triangle
-      if (i != j)
-        B[j][i] = ssum; // lower triangle
-    }
-  }
+  vpMatrix::builtin_dsyrk(rowNum, colNum, data, colNum, B.data, rowNum);
 }
 
 /*!
@@ -651,38 +659,19 @@ void vpMatrix::AtA(vpMatrix &B) const
   if ((B.rowNum != colNum) || (B.colNum != colNum))
     B.resize(colNum, colNum, false, false);
 
+  if (vpMatrix::useBlas(colNum, colNum, rowNum)) {
 #if defined(VISP_HAVE_LAPACK) && !defined(VISP_HAVE_LAPACK_BUILT_IN)
-  double alpha = 1.0;
-  double beta = 0.0;
-  char transa = 'n';
-  char transb = 't';
+    double alpha = 1.0;
+    double beta = 0.0;
+    char transa = 'n';
+    char transb = 't';
 
-  vpMatrix::blas_dgemm(transa, transb, colNum, colNum, rowNum, alpha, data, colNum, data, colNum, beta, B.data, colNum);
-#else
-  unsigned int i, j, k;
-  double s;
-  double *ptr;
-  for (i = 0; i < colNum; i++) {
-    double *Bi = B[i];
-    for (j = 0; j < i; j++) {
-      ptr = data;
-      s = 0;
-      for (k = 0; k < rowNum; k++) {
-        s += (*(ptr + i)) * (*(ptr + j));
-        ptr += colNum;
-      }
-      *Bi++ = s;
-      B[j][i] = s;
-    }
-    ptr = data;
-    s = 0;
-    for (k = 0; k < rowNum; k++) {
-      s += (*(ptr + i)) * (*(ptr + i));
-      ptr += colNum;
-    }
-    *Bi = s;
-  }
+    vpMatrix::blas_dgemm(transa, transb, colNum, colNum, rowNum, alpha, data, colNum, data, colNum, beta, B.data,
+                         colNum);
 #endif
+  } else {
+    vpMatrix::builtin_dsyrk_t(colNum, rowNum, data, colNum, B.data, colNum);
+  }
 }
 
 /*!
@@ -699,6 +688,109 @@ vpMatrix vpMatrix::AtA() const
   return B;
 }
 
+/*!
+  Compute the AtB operation such as \f$C = A^T*B\f$ without computing the
+  transpose of A.
+
+  The result is placed in the parameter \e C and not returned.
+
+  A new matrix won't be allocated for every use of the function. This
+  results in a speed gain if used many times with the same result matrix
+  size.
+
+  \param B : Matrix with as many rows as A.
+  \param C : Resulting matrix with as many rows as A has columns.
+
+  \sa AtB(const vpMatrix &) const
+*/
+void vpMatrix::AtB(const vpMatrix &B, vpMatrix &C) const
+{
+  if (rowNum != B.rowNum) {
+    throw(vpException(vpException::dimensionError, "Cannot compute A^T*B with A (%dx%d) and B (%dx%d)", rowNum,
+                      colNum, B.getRows(), B.getCols()));
+  }
+
+  if ((C.rowNum != colNum) || (C.colNum != B.colNum))
+    C.resize(colNum, B.colNum, false, false);
+
+  if (vpMatrix::useBlas(colNum, B.colNum, rowNum)) {
+#if defined(VISP_HAVE_LAPACK) && !defined(VISP_HAVE_LAPACK_BUILT_IN)
+    double alpha = 1.0;
+    double beta = 0.0;
+    char transa = 'n';
+    char transb = 't';
+
+    vpMatrix::blas_dgemm(transa, transb, B.colNum, colNum, rowNum, alpha, B.data, B.colNum, data, colNum, beta,
+                         C.data, B.colNum);
+#endif
+  } else {
+    vpMatrix::builtin_dgemm_tn(colNum, B.colNum, rowNum, data, colNum, B.data, B.colNum, C.data, B.colNum);
+  }
+}
+
+/*!
+  Compute the AtB operation such as \f$C = A^T*B\f$
+  \return  \f$A^T*B\f$
+  \sa AtB(const vpMatrix &, vpMatrix &) const
+*/
+vpMatrix vpMatrix::AtB(const vpMatrix &B) const
+{
+  vpMatrix C;
+
+  AtB(B, C);
+
+  return C;
+}
+
+/*!
+  Compute the operation \f$c = A^T*b\f$ without computing the transpose of
+  A. This is typically the right-hand side \f$J^T e\f$ of normal equations.
+
+  The result is placed in the parameter \e c and not returned.
+
+  \param b : Vector with as many rows as A.
+  \param c : Resulting vector with as many rows as A has columns.
+
+  \sa AtB(const vpColVector &) const
+*/
+void vpMatrix::AtB(const vpColVector &b, vpColVector &c) const
+{
+  if (rowNum != b.getRows()) {
+    throw(vpException(vpException::dimensionError, "Cannot compute A^T*b with A (%dx%d) and b (%d)", rowNum, colNum,
+                      b.getRows()));
+  }
+
+  if (c.getRows() != colNum)
+    c.resize(colNum, false);
+
+  if (vpMatrix::useBlas(colNum, rowNum, rowNum)) {
+#if defined(VISP_HAVE_LAPACK) && !defined(VISP_HAVE_LAPACK_BUILT_IN)
+    double alpha = 1.0;
+    double beta = 0.0;
+    char trans = 'n';
+    int incr = 1;
+
+    vpMatrix::blas_dgemv(trans, colNum, rowNum, alpha, data, colNum, b.data, incr, beta, c.data, incr);
+#endif
+  } else {
+    vpMatrix::builtin_dgemv_t(rowNum, colNum, data, colNum, b.data, c.data);
+  }
+}
+
+/*!
+  Compute the operation \f$c = A^T*b\f$
+  \return  \f$A^T*b\f$
+  \sa AtB(const vpColVector &, vpColVector &) const
+*/
+vpColVector vpMatrix::AtB(const vpColVector &b) const
+{
+  vpColVector c;
+
+  AtB(b, c);
+
+  return c;
+}
+
 /*!
   Copy operator that allows to convert on of the following container that
   inherit from vpArray2D such as vpMatrix, vpRotationMatrix,
@@ -1030,22 +1122,18 @@ void vpMatrix::multMatrixVector(const vpMatrix &A, const vpColVector &v, vpColVe
   if (A.rowNum != w.rowNum)
     w.resize(A.rowNum, false);
 
+  if (vpMatrix::useBlas(A.rowNum, A.colNum, A.colNum)) {
 #if defined(VISP_HAVE_LAPACK) && !defined(VISP_HAVE_LAPACK_BUILT_IN)
-  double alpha = 1.0;
-  double beta = 0.0;
-  char trans = 't';
-  int incr = 1;
+    double alpha = 1.0;
+    double beta = 0.0;
+    char trans = 't';
+    int incr = 1;
 
-  vpMatrix::blas_dgemv(trans, A.colNum, A.rowNum, alpha, A.data, A.colNum, v.data, incr, beta, w.data, incr);
-#else
-  w = 0.0;
-  for (unsigned int j = 0; j < A.colNum; j++) {
-    double vj = v[j]; // optimization em 5/12/2006
-    for (unsigned int i = 0; i < A.rowNum; i++) {
-      w[i] += A.rowPtrs[i][j] * vj;
-    }
-  }
+    vpMatrix::blas_dgemv(trans, A.colNum, A.rowNum, alpha, A.data, A.colNum, v.data, incr, beta, w.data, incr);
 #endif
+  } else {
+    vpMatrix::builtin_dgemv(A.rowNum, A.colNum, A.data, A.colNum, v.data, w.data);
+  }
 }
 
 //---------------------------------
@@ -1071,30 +1159,18 @@ void vpMatrix::mult2Matrices(const vpMatrix &A, const vpMatrix &B, vpMatrix &C)
                       A.getCols(), B.getRows(), B.getCols()));
   }
 
+  if (vpMatrix::useBlas(A.rowNum, B.colNum, A.colNum)) {
 #if defined(VISP_HAVE_LAPACK) && !defined(VISP_HAVE_LAPACK_BUILT_IN)
-  double alpha = 1.0;
-  double beta = 0.0;
-  char trans = 'n';
+    double alpha = 1.0;
+    double beta = 0.0;
+    char trans = 'n';
 
-  vpMatrix::blas_dgemm(trans, trans, B.colNum, A.rowNum, A.colNum, alpha, B.data, B.colNum, A.data, A.colNum, beta,
-                       C.data, B.colNum);
-#else
-  // 5/12/06 some "very" simple optimization to avoid indexation
-  unsigned int BcolNum = B.colNum;
-  unsigned int BrowNum = B.rowNum;
-  unsigned int i, j, k;
-  double **BrowPtrs = B.rowPtrs;
-  for (i = 0; i < A.rowNum; i++) {
-    double *rowptri = A.rowPtrs[i];
-    double *ci = C[i];
-    for (j = 0; j < BcolNum; j++) {
-      double s = 0;
-      for (k = 0; k < BrowNum; k++)
-        s += rowptri[k] * BrowPtrs[k][j];
-      ci[j] = s;
-    }
-  }
+    vpMatrix::blas_dgemm(trans, trans, B.colNum, A.rowNum, A.colNum, alpha, B.data, B.colNum, A.data, A.colNum, beta,
+                         C.data, B.colNum);
 #endif
+  } else {
+    vpMatrix::builtin_dgemm(A.rowNum, B.colNum, A.colNum, A.data, A.colNum, B.data, B.colNum, C.data, B.colNum);
+  }
 }
 
 /*!
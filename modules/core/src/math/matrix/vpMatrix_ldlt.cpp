@@ -0,0 +1,316 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Solver of the 6-by-6 normal equations of pose estimation problems.
+ *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <visp3/core/vpColVector.h>
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpMatrix.h>
+
+namespace
+{
+// Smallest pivot of the LDL^T factorization, relative to the largest
+// diagonal element, for which the factorization is trusted. Below, the
+// matrix is close to be rank deficient and the eigen decomposition is used.
+const double ldltPivotThreshold = 1e-10;
+
+const unsigned int maxJacobiSweeps = 50;
+
+void checkNormalMatrix6(const vpMatrix &A)
+{
+  if (A.getRows() != 6 || A.getCols() != 6) {
+    throw(vpException(vpException::dimensionError, "Cannot solve the normal equations of a (%dx%d) matrix, 6-by-6 expected",
+                      A.getRows(), A.getCols()));
+  }
+}
+
+/*
+  LDL^T factorization of the symmetric matrix A. Only the strictly lower part
+  of L is written. Return false if a pivot is not larger than tol.
+*/
+bool ldlt6(const double *A, double *L, double *d, double tol)
+{
+  for (unsigned int j = 0; j < 6; j++) {
+    const double *Lj = L + 6 * j;
+    double dj = A[6 * j + j];
+    for (unsigned int k = 0; k < j; k++) {
+      dj -= Lj[k] * Lj[k] * d[k];
+    }
+    if (!(dj > tol)) {
+      return false;
+    }
+    d[j] = dj;
+
+    for (unsigned int i = j + 1; i < 6; i++) {
+      double *Li = L + 6 * i;
+      double s = A[6 * i + j];
+      for (unsigned int k = 0; k < j; k++) {
+        s -= Li[k] * Lj[k] * d[k];
+      }
+      Li[j] = s / dj;
+    }
+  }
+  return true;
+}
+
+// Solve L D L^T x = b from the factorization computed by ldlt6().
+void ldltSolve6(const double *L, const double *d, const double *b, double *x)
+{
+  double z[6];
+  for (unsigned int i = 0; i < 6; i++) {
+    double s = b[i];
+    for (unsigned int k = 0; k < i; k++) {
+      s -= L[6 * i + k] * z[k];
+    }
+    z[i] = s;
+  }
+  for (unsigned int i = 0; i < 6; i++) {
+    z[i] /= d[i];
+  }
+  for (int i = 5; i >= 0; i--) {
+    double s = z[i];
+    for (unsigned int k = (unsigned int)i + 1; k < 6; k++) {
+      s -= L[6 * k + i] * x[k];
+    }
+    x[i] = s;
+  }
+}
+
+/*
+  Eigen decomposition of the symmetric matrix A by cyclic Jacobi rotations.
+  A is overwritten. On return lambda contains the eigenvalues and the
+  columns of V the corresponding eigenvectors.
+*/
+void jacobiEigen6(double *A, double *lambda, double *V)
+{
+  double norm2 = 0.;
+  for (unsigned int i = 0; i < 36; i++) {
+    V[i] = (i % 7 == 0) ? 1. : 0.;
+    norm2 += A[i] * A[i];
+  }
+  const double eps = std::numeric_limits<double>::epsilon();
+
+  for (unsigned int sweep = 0; sweep < maxJacobiSweeps; sweep++) {
+    double off = 0.;
+    for (unsigned int p = 0; p < 5; p++) {
+      for (unsigned int q = p + 1; q < 6; q++) {
+        off += A[6 * p + q] * A[6 * p + q];
+      }
+    }
+    if (off <= eps * eps * norm2) {
+      break;
+    }
+
+    for (unsigned int p = 0; p < 5; p++) {
+      for (unsigned int q = p + 1; q < 6; q++) {
+        const double apq = A[6 * p + q];
+        if (apq == 0.) {
+          continue;
+        }
+        // Rotation that cancels A[p][q]
+        const double theta = (A[6 * q + q] - A[6 * p + p]) / (2. * apq);
+        const double t = (theta >= 0. ? 1. : -1.) / (std::fabs(theta) + std::sqrt(theta * theta + 1.));
+        const double c = 1. / std::sqrt(t * t + 1.);
+        const double s = t * c;
+
+        for (unsigned int k = 0; k < 6; k++) {
+          const double akp = A[6 * k + p], akq = A[6 * k + q];
+          A[6 * k + p] = c * akp - s * akq;
+          A[6 * k + q] = s * akp + c * akq;
+        }
+        for (unsigned int k = 0; k < 6; k++) {
+          const double apk = A[6 * p + k], aqk = A[6 * q + k];
+          A[6 * p + k] = c * apk - s * aqk;
+          A[6 * q + k] = s * apk + c * aqk;
+        }
+        for (unsigned int k = 0; k < 6; k++) {
+          const double vkp = V[6 * k + p], vkq = V[6 * k + q];
+          V[6 * k + p] = c * vkp - s * vkq;
+          V[6 * k + q] = s * vkp + c * vkq;
+        }
+      }
+    }
+  }
+
+  for (unsigned int i = 0; i < 6; i++) {
+    lambda[i] = A[6 * i + i];
+  }
+}
+
+// Return the number of eigenvalues larger than svThreshold times the largest one.
+unsigned int rank6(const double *lambda, double svThreshold, bool *isKept)
+{
+  double maxsv = 0.;
+  for (unsigned int i = 0; i < 6; i++) {
+    if (std::fabs(lambda[i]) > maxsv) {
+      maxsv = std::fabs(lambda[i]);
+    }
+  }
+
+  unsigned int rank = 0;
+  for (unsigned int i = 0; i < 6; i++) {
+    isKept[i] = std::fabs(lambda[i]) > maxsv * svThreshold;
+    if (isKept[i]) {
+      rank++;
+    }
+  }
+  return rank;
+}
+}
+
+/*!
+  Solve the normal equations \f${\bf A}^T {\bf A} \; {\bf x} = {\bf A}^T {\bf b}\f$
+  of a least-squares problem with 6 unknowns, as those of the pose
+  estimation and model-based tracking algorithms. The matrix must be the
+  6-by-6 symmetric matrix \f${\bf A}^T {\bf A}\f$, that can be obtained with
+  AtA().
+
+  The system is solved without any heap allocation by an \f${\bf L D
+  L}^T\f$ factorization. When the matrix is rank deficient or close to, the
+  solution is rather computed from an eigen decomposition by Jacobi
+  rotations, that gives the same result as <tt>pseudoInverse(svThreshold) *
+  b</tt>.
+
+  \param b : 6-dimension vector \f${\bf A}^T {\bf b}\f$.
+  \param x : Least-squares solution of minimal norm.
+  \param svThreshold : Threshold used to test the singular values of this
+  6-by-6 matrix, that are the squares of the singular values of \f$\bf
+  A\f$. A singular value lower than \e svThreshold times the largest one is
+  considered as null.
+
+  \return The rank of the matrix.
+
+  \exception vpException::dimensionError : If the matrix is not 6-by-6 or
+  \e b not a 6-dimension vector.
+
+  \sa kernelNormalEquations6(), pseudoInverse()
+*/
+unsigned int vpMatrix::solveNormalEquations6(const vpColVector &b, vpColVector &x, double svThreshold) const
+{
+  checkNormalMatrix6(*this);
+  if (b.getRows() != 6) {
+    throw(vpException(vpException::dimensionError, "Cannot solve 6-by-6 normal equations with a %d-dimension vector",
+                      b.getRows()));
+  }
+
+  double bData[6];
+  memcpy(bData, b.data, 6 * sizeof(double));
+  x.resize(6, false);
+
+  double maxDiag = 0.;
+  for (unsigned int i = 0; i < 6; i++) {
+    if (data[7 * i] > maxDiag) {
+      maxDiag = data[7 * i];
+    }
+  }
+
+  double L[36], d[6];
+  if (maxDiag > 0. && ldlt6(data, L, d, std::max(ldltPivotThreshold, svThreshold) * maxDiag)) {
+    ldltSolve6(L, d, bData, x.data);
+    return 6;
+  }
+
+  double A[36], lambda[6], V[36];
+  memcpy(A, data, 36 * sizeof(double));
+  jacobiEigen6(A, lambda, V);
+
+  bool isKept[6];
+  unsigned int rank = rank6(lambda, svThreshold, isKept);
+
+  for (unsigned int i = 0; i < 6; i++) {
+    x[i] = 0.;
+  }
+  for (unsigned int j = 0; j < 6; j++) {
+    if (!isKept[j]) {
+      continue;
+    }
+    double vtb = 0.;
+    for (unsigned int i = 0; i < 6; i++) {
+      vtb += V[6 * i + j] * bData[i];
+    }
+    vtb /= lambda[j];
+    for (unsigned int i = 0; i < 6; i++) {
+      x[i] += V[6 * i + j] * vtb;
+    }
+  }
+
+  return rank;
+}
+
+/*!
+  Compute the kernel of a matrix \f$\bf A\f$ with 6 columns from the 6-by-6
+  symmetric matrix \f${\bf A}^T {\bf A}\f$, that can be obtained with AtA().
+  This is faster than calling kernel() on \f$\bf A\f$ since only a 6-by-6
+  eigen decomposition is needed.
+
+  \param kerAt : The rows of this matrix are an orthonormal basis of the
+  kernel of \f$\bf A\f$, as with kernel().
+  \param svThreshold : Threshold used to test the singular values of this
+  6-by-6 matrix, that are the squares of the singular values of \f$\bf A\f$.
+  To obtain the same result as <tt>A.kernel(kerAt, t)</tt> use
+  \f$t^2\f$.
+
+  \return The rank of the matrix.
+
+  \exception vpException::dimensionError : If the matrix is not 6-by-6.
+
+  \sa solveNormalEquations6(), kernel()
+*/
+unsigned int vpMatrix::kernelNormalEquations6(vpMatrix &kerAt, double svThreshold) const
+{
+  checkNormalMatrix6(*this);
+
+  double A[36], lambda[6], V[36];
+  memcpy(A, data, 36 * sizeof(double));
+  jacobiEigen6(A, lambda, V);
+
+  bool isKept[6];
+  unsigned int rank = rank6(lambda, svThreshold, isKept);
+
+  kerAt.resize(6 - rank, 6);
+  for (unsigned int j = 0, k = 0; j < 6; j++) {
+    if (!isKept[j]) {
+      for (unsigned int i = 0; i < 6; i++) {
+        kerAt[k][i] = V[6 * i + j];
+      }
+      k++;
+    }
+  }
+
+  return rank;
+}
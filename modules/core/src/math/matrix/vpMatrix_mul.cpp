@@ -29,15 +29,527 @@
  * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
  *
  * Description:
- * BLAS subroutines.
+ * BLAS subroutines and built-in matrix products.
  *
  *****************************************************************************/
 
+#include <algorithm>
+#include <vector>
+
+#include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpMatrix.h>
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#if defined __AVX__
+#include <immintrin.h>
+#define VISP_HAVE_AVX 1
+#endif
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
+namespace
+{
+// Blocking of the built-in GEMM: a kc x nc panel of B is packed in strips of
+// nr columns and multiplied by mr rows of A at a time.
+const unsigned int g_gemm_kc = 256;
+const unsigned int g_gemm_nc = 256;
+const unsigned int g_gemm_mr = 4;
+// Square tiles of the result of the rank-k updates (A^T A, A^T B, A A^T)
+const unsigned int g_tile = 64;
+// Above this number of columns of A, A^T A and A^T B transpose A and use the
+// packed GEMM instead of rank-1 updates
+const unsigned int g_gemm_min_cols = 16;
+
+enum vpSimdPath { SIMD_NONE, SIMD_SSE2, SIMD_AVX };
+
+vpSimdPath getSimdPath()
+{
+#if VISP_HAVE_AVX
+  if (vpCPUFeatures::checkAVX())
+    return SIMD_AVX;
+#endif
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2())
+    return SIMD_SSE2;
+#endif
+  return SIMD_NONE;
+}
+
+// y[0:n] += alpha * x[0:n]
+void axpy(vpSimdPath path, unsigned int n, double alpha, const double *x, double *y)
+{
+  unsigned int i = 0;
+#if VISP_HAVE_AVX
+  if (path == SIMD_AVX) {
+    const __m256d v_alpha = _mm256_set1_pd(alpha);
+    for (; i + 4 <= n; i += 4) {
+      _mm256_storeu_pd(y + i, _mm256_add_pd(_mm256_loadu_pd(y + i), _mm256_mul_pd(v_alpha, _mm256_loadu_pd(x + i))));
+    }
+  }
+#endif
+#if VISP_HAVE_SSE2
+  if (path != SIMD_NONE) {
+    const __m128d v_alpha = _mm_set1_pd(alpha);
+    for (; i + 2 <= n; i += 2) {
+      _mm_storeu_pd(y + i, _mm_add_pd(_mm_loadu_pd(y + i), _mm_mul_pd(v_alpha, _mm_loadu_pd(x + i))));
+    }
+  }
+#endif
+  (void)path;
+  for (; i < n; i++) {
+    y[i] += alpha * x[i];
+  }
+}
+
+// Dot product of x[0:n] and y[0:n]
+double dot(vpSimdPath path, unsigned int n, const double *x, const double *y)
+{
+  unsigned int i = 0;
+  double sum = 0;
+#if VISP_HAVE_SSE2
+  if (path != SIMD_NONE) {
+    __m128d v_sum0 = _mm_setzero_pd();
+    __m128d v_sum1 = _mm_setzero_pd();
+    for (; i + 4 <= n; i += 4) {
+      v_sum0 = _mm_add_pd(v_sum0, _mm_mul_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i)));
+      v_sum1 = _mm_add_pd(v_sum1, _mm_mul_pd(_mm_loadu_pd(x + i + 2), _mm_loadu_pd(y + i + 2)));
+    }
+    double v_tmp[2];
+    _mm_storeu_pd(v_tmp, _mm_add_pd(v_sum0, v_sum1));
+    sum = v_tmp[0] + v_tmp[1];
+  }
+#endif
+  (void)path;
+  for (; i < n; i++) {
+    sum += x[i] * y[i];
+  }
+  return sum;
+}
+
+// tile[4][4] = a[0:4][0:kc] * bp, with bp a kc x 4 packed strip of B
+void gemmKernel4x4(unsigned int kc, const double *const a[4], const double *bp, double *tile)
+{
+  double c[4][4] = {{0, 0, 0, 0}, {0, 0, 0, 0}, {0, 0, 0, 0}, {0, 0, 0, 0}};
+  for (unsigned int k = 0; k < kc; k++, bp += 4) {
+    for (unsigned int r = 0; r < 4; r++) {
+      const double ar = a[r][k];
+      c[r][0] += ar * bp[0];
+      c[r][1] += ar * bp[1];
+      c[r][2] += ar * bp[2];
+      c[r][3] += ar * bp[3];
+    }
+  }
+  for (unsigned int r = 0; r < 4; r++) {
+    for (unsigned int j = 0; j < 4; j++) {
+      tile[r * 4 + j] = c[r][j];
+    }
+  }
+}
+
+#if VISP_HAVE_SSE2
+void gemmKernel4x4SSE2(unsigned int kc, const double *const a[4], const double *bp, double *tile)
+{
+  __m128d c00 = _mm_setzero_pd(), c01 = _mm_setzero_pd();
+  __m128d c10 = _mm_setzero_pd(), c11 = _mm_setzero_pd();
+  __m128d c20 = _mm_setzero_pd(), c21 = _mm_setzero_pd();
+  __m128d c30 = _mm_setzero_pd(), c31 = _mm_setzero_pd();
+  const double *a0 = a[0], *a1 = a[1], *a2 = a[2], *a3 = a[3];
+
+  for (unsigned int k = 0; k < kc; k++, bp += 4) {
+    const __m128d b0 = _mm_loadu_pd(bp);
+    const __m128d b1 = _mm_loadu_pd(bp + 2);
+
+    __m128d ar = _mm_set1_pd(a0[k]);
+    c00 = _mm_add_pd(c00, _mm_mul_pd(ar, b0));
+    c01 = _mm_add_pd(c01, _mm_mul_pd(ar, b1));
+    ar = _mm_set1_pd(a1[k]);
+    c10 = _mm_add_pd(c10, _mm_mul_pd(ar, b0));
+    c11 = _mm_add_pd(c11, _mm_mul_pd(ar, b1));
+    ar = _mm_set1_pd(a2[k]);
+    c20 = _mm_add_pd(c20, _mm_mul_pd(ar, b0));
+    c21 = _mm_add_pd(c21, _mm_mul_pd(ar, b1));
+    ar = _mm_set1_pd(a3[k]);
+    c30 = _mm_add_pd(c30, _mm_mul_pd(ar, b0));
+    c31 = _mm_add_pd(c31, _mm_mul_pd(ar, b1));
+  }
+
+  _mm_storeu_pd(tile, c00);
+  _mm_storeu_pd(tile + 2, c01);
+  _mm_storeu_pd(tile + 4, c10);
+  _mm_storeu_pd(tile + 6, c11);
+  _mm_storeu_pd(tile + 8, c20);
+  _mm_storeu_pd(tile + 10, c21);
+  _mm_storeu_pd(tile + 12, c30);
+  _mm_storeu_pd(tile + 14, c31);
+}
+#endif
+
+#if VISP_HAVE_AVX
+// tile[4][8] = a[0:4][0:kc] * bp, with bp a kc x 8 packed strip of B
+void gemmKernel4x8AVX(unsigned int kc, const double *const a[4], const double *bp, double *tile)
+{
+  __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+  __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+  __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+  __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+  const double *a0 = a[0], *a1 = a[1], *a2 = a[2], *a3 = a[3];
+
+  for (unsigned int k = 0; k < kc; k++, bp += 8) {
+    const __m256d b0 = _mm256_loadu_pd(bp);
+    const __m256d b1 = _mm256_loadu_pd(bp + 4);
+
+    __m256d ar = _mm256_broadcast_sd(a0 + k);
+    c00 = _mm256_add_pd(c00, _mm256_mul_pd(ar, b0));
+    c01 = _mm256_add_pd(c01, _mm256_mul_pd(ar, b1));
+    ar = _mm256_broadcast_sd(a1 + k);
+    c10 = _mm256_add_pd(c10, _mm256_mul_pd(ar, b0));
+    c11 = _mm256_add_pd(c11, _mm256_mul_pd(ar, b1));
+    ar = _mm256_broadcast_sd(a2 + k);
+    c20 = _mm256_add_pd(c20, _mm256_mul_pd(ar, b0));
+    c21 = _mm256_add_pd(c21, _mm256_mul_pd(ar, b1));
+    ar = _mm256_broadcast_sd(a3 + k);
+    c30 = _mm256_add_pd(c30, _mm256_mul_pd(ar, b0));
+    c31 = _mm256_add_pd(c31, _mm256_mul_pd(ar, b1));
+  }
+
+  _mm256_storeu_pd(tile, c00);
+  _mm256_storeu_pd(tile + 4, c01);
+  _mm256_storeu_pd(tile + 8, c10);
+  _mm256_storeu_pd(tile + 12, c11);
+  _mm256_storeu_pd(tile + 16, c20);
+  _mm256_storeu_pd(tile + 20, c21);
+  _mm256_storeu_pd(tile + 24, c30);
+  _mm256_storeu_pd(tile + 28, c31);
+}
+#endif
+
+#if VISP_HAVE_SSE2
+// Upper triangle of C = A^T A for a K x 6 matrix A, the shape of the
+// interaction matrices of the trackers. The 21 sums are kept in registers.
+void syrkT6SSE2(unsigned int K, const double *a_data, unsigned int lda, double *c_data, unsigned int ldc)
+{
+  __m128d c0_01 = _mm_setzero_pd(), c0_23 = _mm_setzero_pd(), c0_45 = _mm_setzero_pd();
+  __m128d c1_01 = _mm_setzero_pd(), c1_23 = _mm_setzero_pd(), c1_45 = _mm_setzero_pd();
+  __m128d c2_23 = _mm_setzero_pd(), c2_45 = _mm_setzero_pd();
+  __m128d c3_23 = _mm_setzero_pd(), c3_45 = _mm_setzero_pd();
+  __m128d c4_45 = _mm_setzero_pd(), c5_45 = _mm_setzero_pd();
+
+  for (unsigned int k = 0; k < K; k++) {
+    const double *a = a_data + k * lda;
+    const __m128d a01 = _mm_loadu_pd(a);
+    const __m128d a23 = _mm_loadu_pd(a + 2);
+    const __m128d a45 = _mm_loadu_pd(a + 4);
+
+    __m128d ai = _mm_set1_pd(a[0]);
+    c0_01 = _mm_add_pd(c0_01, _mm_mul_pd(ai, a01));
+    c0_23 = _mm_add_pd(c0_23, _mm_mul_pd(ai, a23));
+    c0_45 = _mm_add_pd(c0_45, _mm_mul_pd(ai, a45));
+    ai = _mm_set1_pd(a[1]);
+    c1_01 = _mm_add_pd(c1_01, _mm_mul_pd(ai, a01));
+    c1_23 = _mm_add_pd(c1_23, _mm_mul_pd(ai, a23));
+    c1_45 = _mm_add_pd(c1_45, _mm_mul_pd(ai, a45));
+    ai = _mm_set1_pd(a[2]);
+    c2_23 = _mm_add_pd(c2_23, _mm_mul_pd(ai, a23));
+    c2_45 = _mm_add_pd(c2_45, _mm_mul_pd(ai, a45));
+    ai = _mm_set1_pd(a[3]);
+    c3_23 = _mm_add_pd(c3_23, _mm_mul_pd(ai, a23));
+    c3_45 = _mm_add_pd(c3_45, _mm_mul_pd(ai, a45));
+    ai = _mm_set1_pd(a[4]);
+    c4_45 = _mm_add_pd(c4_45, _mm_mul_pd(ai, a45));
+    ai = _mm_set1_pd(a[5]);
+    c5_45 = _mm_add_pd(c5_45, _mm_mul_pd(ai, a45));
+  }
+
+  // Lower parts of the pairs are overwritten when mirroring the upper
+  // triangle
+  double *c = c_data;
+  _mm_storeu_pd(c, c0_01);
+  _mm_storeu_pd(c + 2, c0_23);
+  _mm_storeu_pd(c + 4, c0_45);
+  c += ldc;
+  _mm_storeu_pd(c, c1_01);
+  _mm_storeu_pd(c + 2, c1_23);
+  _mm_storeu_pd(c + 4, c1_45);
+  c += ldc;
+  _mm_storeu_pd(c + 2, c2_23);
+  _mm_storeu_pd(c + 4, c2_45);
+  c += ldc;
+  _mm_storeu_pd(c + 2, c3_23);
+  _mm_storeu_pd(c + 4, c3_45);
+  c += ldc;
+  _mm_storeu_pd(c + 4, c4_45);
+  c += ldc;
+  _mm_storeu_pd(c + 4, c5_45);
+}
+
+// y = A^T x for a K x 6 matrix A
+void gemvT6SSE2(unsigned int K, const double *a_data, unsigned int lda, const double *x_data, double *y_data)
+{
+  __m128d y01 = _mm_setzero_pd(), y23 = _mm_setzero_pd(), y45 = _mm_setzero_pd();
+  for (unsigned int k = 0; k < K; k++) {
+    const double *a = a_data + k * lda;
+    const __m128d xk = _mm_set1_pd(x_data[k]);
+    y01 = _mm_add_pd(y01, _mm_mul_pd(xk, _mm_loadu_pd(a)));
+    y23 = _mm_add_pd(y23, _mm_mul_pd(xk, _mm_loadu_pd(a + 2)));
+    y45 = _mm_add_pd(y45, _mm_mul_pd(xk, _mm_loadu_pd(a + 4)));
+  }
+  _mm_storeu_pd(y_data, y01);
+  _mm_storeu_pd(y_data + 2, y23);
+  _mm_storeu_pd(y_data + 4, y45);
+}
+#endif
+
+// At = A^T for a K x N matrix A stored row-major
+void transposeTo(unsigned int K, unsigned int N, const double *a_data, unsigned int lda, std::vector<double> &At)
+{
+  At.resize((size_t)N * K);
+  for (unsigned int k0 = 0; k0 < K; k0 += g_tile) {
+    const unsigned int k1 = std::min(k0 + g_tile, K);
+    for (unsigned int i0 = 0; i0 < N; i0 += g_tile) {
+      const unsigned int i1 = std::min(i0 + g_tile, N);
+      for (unsigned int k = k0; k < k1; k++) {
+        for (unsigned int i = i0; i < i1; i++) {
+          At[(size_t)i * K + k] = a_data[k * lda + i];
+        }
+      }
+    }
+  }
+}
+
+// Copy the upper triangle of a n x n matrix into its lower triangle
+void mirrorUpper(unsigned int n, double *c_data, unsigned int ldc)
+{
+  for (unsigned int i = 1; i < n; i++) {
+    for (unsigned int j = 0; j < i; j++) {
+      c_data[i * ldc + j] = c_data[j * ldc + i];
+    }
+  }
+}
+}
+
+/*!
+  Compute C = A * B where A is M x K, B is K x N and C is M x N, all stored
+  row-major. B is packed by panels so that the inner kernel reads it
+  contiguously and keeps a 4 x nr tile of C in registers.
+*/
+void vpMatrix::builtin_dgemm(unsigned int M, unsigned int N, unsigned int K, const double *a_data, unsigned int lda,
+                             const double *b_data, unsigned int ldb, double *c_data, unsigned int ldc)
+{
+  for (unsigned int i = 0; i < M; i++) {
+    std::fill(c_data + i * ldc, c_data + i * ldc + N, 0.0);
+  }
+  if (M == 0 || N == 0 || K == 0) {
+    return;
+  }
+
+  const vpSimdPath path = getSimdPath();
+  void (*kernel)(unsigned int, const double *const *, const double *, double *) = gemmKernel4x4;
+  unsigned int nr = 4;
+#if VISP_HAVE_SSE2
+  if (path == SIMD_SSE2) {
+    kernel = gemmKernel4x4SSE2;
+  }
+#endif
+#if VISP_HAVE_AVX
+  if (path == SIMD_AVX) {
+    kernel = gemmKernel4x8AVX;
+    nr = 8;
+  }
+#endif
+
+  std::vector<double> packed(((g_gemm_nc + nr - 1) / nr) * nr * g_gemm_kc);
+  std::vector<double> zeros(g_gemm_kc, 0.0);
+  double tile[g_gemm_mr * 8];
+
+  for (unsigned int jc = 0; jc < N; jc += g_gemm_nc) {
+    const unsigned int nc = std::min(g_gemm_nc, N - jc);
+    const unsigned int nbStrips = (nc + nr - 1) / nr;
+
+    for (unsigned int pc = 0; pc < K; pc += g_gemm_kc) {
+      const unsigned int kc = std::min(g_gemm_kc, K - pc);
+
+      // Pack B[pc:pc+kc][jc:jc+nc] in strips of nr columns padded with zeros
+      for (unsigned int s = 0; s < nbStrips; s++) {
+        double *strip = &packed[s * kc * nr];
+        const unsigned int ncols = std::min(nr, nc - s * nr);
+        for (unsigned int k = 0; k < kc; k++) {
+          const double *b = b_data + (pc + k) * ldb + jc + s * nr;
+          unsigned int j = 0;
+          for (; j < ncols; j++) {
+            strip[k * nr + j] = b[j];
+          }
+          for (; j < nr; j++) {
+            strip[k * nr + j] = 0.0;
+          }
+        }
+      }
+
+      for (unsigned int i = 0; i < M; i += g_gemm_mr) {
+        const unsigned int mr = std::min(g_gemm_mr, M - i);
+        const double *a[g_gemm_mr];
+        for (unsigned int r = 0; r < g_gemm_mr; r++) {
+          a[r] = r < mr ? a_data + (i + r) * lda + pc : &zeros[0];
+        }
+
+        for (unsigned int s = 0; s < nbStrips; s++) {
+          kernel(kc, a, &packed[s * kc * nr], tile);
+
+          const unsigned int ncols = std::min(nr, nc - s * nr);
+          for (unsigned int r = 0; r < mr; r++) {
+            double *c = c_data + (i + r) * ldc + jc + s * nr;
+            for (unsigned int j = 0; j < ncols; j++) {
+              c[j] += tile[r * nr + j];
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+/*!
+  Compute C = A^T * B where A is K x M, B is K x N and C is M x N, all stored
+  row-major. Large products transpose A to use the packed GEMM, smaller ones
+  are computed as a sum of rank-1 updates on square tiles of C.
+*/
+void vpMatrix::builtin_dgemm_tn(unsigned int M, unsigned int N, unsigned int K, const double *a_data,
+                                unsigned int lda, const double *b_data, unsigned int ldb, double *c_data,
+                                unsigned int ldc)
+{
+  if (M >= g_gemm_min_cols && N >= g_gemm_min_cols) {
+    std::vector<double> At;
+    transposeTo(K, M, a_data, lda, At);
+    builtin_dgemm(M, N, K, At.empty() ? NULL : &At[0], K, b_data, ldb, c_data, ldc);
+    return;
+  }
+
+  for (unsigned int i = 0; i < M; i++) {
+    std::fill(c_data + i * ldc, c_data + i * ldc + N, 0.0);
+  }
+
+  const vpSimdPath path = getSimdPath();
+  for (unsigned int i0 = 0; i0 < M; i0 += g_tile) {
+    const unsigned int i1 = std::min(i0 + g_tile, M);
+    for (unsigned int j0 = 0; j0 < N; j0 += g_tile) {
+      const unsigned int nj = std::min(g_tile, N - j0);
+      for (unsigned int k = 0; k < K; k++) {
+        const double *a = a_data + k * lda;
+        const double *b = b_data + k * ldb + j0;
+        for (unsigned int i = i0; i < i1; i++) {
+          axpy(path, nj, a[i], b, c_data + i * ldc + j0);
+        }
+      }
+    }
+  }
+}
+
+/*!
+  Compute y = A * x where A is M x N stored row-major.
+*/
+void vpMatrix::builtin_dgemv(unsigned int M, unsigned int N, const double *a_data, unsigned int lda,
+                             const double *x_data, double *y_data)
+{
+  const vpSimdPath path = getSimdPath();
+  for (unsigned int i = 0; i < M; i++) {
+    y_data[i] = dot(path, N, a_data + i * lda, x_data);
+  }
+}
+
+/*!
+  Compute y = A^T * x where A is M x N stored row-major.
+*/
+void vpMatrix::builtin_dgemv_t(unsigned int M, unsigned int N, const double *a_data, unsigned int lda,
+                               const double *x_data, double *y_data)
+{
+  const vpSimdPath path = getSimdPath();
+#if VISP_HAVE_SSE2
+  if (N == 6 && path != SIMD_NONE) {
+    gemvT6SSE2(M, a_data, lda, x_data, y_data);
+    return;
+  }
+#endif
+
+  std::fill(y_data, y_data + N, 0.0);
+  for (unsigned int i = 0; i < M; i++) {
+    axpy(path, N, x_data[i], a_data + i * lda, y_data);
+  }
+}
+
+/*!
+  Compute C = A * A^T where A is N x K stored row-major. Only the upper
+  triangle is computed, tile by tile, and then mirrored.
+*/
+void vpMatrix::builtin_dsyrk(unsigned int N, unsigned int K, const double *a_data, unsigned int lda, double *c_data,
+                             unsigned int ldc)
+{
+  const vpSimdPath path = getSimdPath();
+  for (unsigned int i0 = 0; i0 < N; i0 += g_tile) {
+    const unsigned int i1 = std::min(i0 + g_tile, N);
+    for (unsigned int j0 = i0; j0 < N; j0 += g_tile) {
+      const unsigned int j1 = std::min(j0 + g_tile, N);
+      for (unsigned int i = i0; i < i1; i++) {
+        const double *ai = a_data + i * lda;
+        for (unsigned int j = std::max(i, j0); j < j1; j++) {
+          c_data[i * ldc + j] = dot(path, K, ai, a_data + j * lda);
+        }
+      }
+    }
+  }
+  mirrorUpper(N, c_data, ldc);
+}
+
+/*!
+  Compute C = A^T * A where A is K x N stored row-major. The K x 6
+  interaction matrices use a dedicated register kernel and wide matrices are
+  transposed to use the packed GEMM. Otherwise the upper triangle is
+  accumulated row after row of A on square tiles of C, so that a tile stays
+  in cache while A is streamed, and then mirrored.
+*/
+void vpMatrix::builtin_dsyrk_t(unsigned int N, unsigned int K, const double *a_data, unsigned int lda,
+                               double *c_data, unsigned int ldc)
+{
+  const vpSimdPath path = getSimdPath();
+#if VISP_HAVE_SSE2
+  if (N == 6 && path != SIMD_NONE) {
+    syrkT6SSE2(K, a_data, lda, c_data, ldc);
+    mirrorUpper(N, c_data, ldc);
+    return;
+  }
+#endif
+  if (N >= g_gemm_min_cols) {
+    std::vector<double> At;
+    transposeTo(K, N, a_data, lda, At);
+    builtin_dgemm(N, N, K, At.empty() ? NULL : &At[0], K, a_data, lda, c_data, ldc);
+    return;
+  }
+
+  for (unsigned int i = 0; i < N; i++) {
+    std::fill(c_data + i * ldc, c_data + i * ldc + N, 0.0);
+  }
+
+  for (unsigned int i0 = 0; i0 < N; i0 += g_tile) {
+    const unsigned int i1 = std::min(i0 + g_tile, N);
+    for (unsigned int j0 = i0; j0 < N; j0 += g_tile) {
+      const unsigned int j1 = std::min(j0 + g_tile, N);
+      for (unsigned int k = 0; k < K; k++) {
+        const double *a = a_data + k * lda;
+        for (unsigned int i = i0; i < i1; i++) {
+          const unsigned int j = std::max(i, j0);
+          if (j < j1) {
+            axpy(path, j1 - j, a[i], a + j, c_data + i * ldc + j);
+          }
+        }
+      }
+    }
+  }
+  mirrorUpper(N, c_data, ldc);
+}
+
 #if defined(VISP_HAVE_LAPACK) && !defined(VISP_HAVE_LAPACK_BUILT_IN)
 #  ifdef VISP_HAVE_MKL
 #include <mkl.h>
@@ -88,10 +600,6 @@ void vpMatrix::blas_dgemv(char trans, const int M_, const int N_, double alpha,
   dgemv_(&trans, &M, &N, &alpha, a_data, &lda, x_data, &incx, &beta, y_data, &incy);
 }
 #  endif
-#else
-// Work arround to avoid warning LNK4221: This object file does not define any
-// previously undefined public symbols
-void dummy_vpMatrix_blas() {};
 #endif
 
 #endif // #ifndef DOXYGEN_SHOULD_SKIP_THIS
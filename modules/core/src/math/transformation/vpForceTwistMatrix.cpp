@@ -59,10 +59,8 @@
 */
 vpForceTwistMatrix &vpForceTwistMatrix::operator=(const vpForceTwistMatrix &M)
 {
-  for (int i = 0; i < 6; i++) {
-    for (int j = 0; j < 6; j++) {
-      rowPtrs[i][j] = M.rowPtrs[i][j];
-    }
+  if (this != &M) {
+    memcpy(data, M.data, 36 * sizeof(double));
   }
 
   return *this;
@@ -86,7 +84,7 @@ void vpForceTwistMatrix::eye()
 /*!
   Initialize a force/torque twist transformation matrix to identity.
 */
-vpForceTwistMatrix::vpForceTwistMatrix() : vpArray2D<double>(6, 6) { eye(); }
+vpForceTwistMatrix::vpForceTwistMatrix() : vpArray2D<double>(6, 6, m_fixedData, m_fixedRowPtrs) { eye(); }
 
 /*!
 
@@ -95,7 +93,7 @@ vpForceTwistMatrix::vpForceTwistMatrix() : vpArray2D<double>(6, 6) { eye(); }
 
   \param F : Force/torque twist matrix used as initializer.
 */
-vpForceTwistMatrix::vpForceTwistMatrix(const vpForceTwistMatrix &F) : vpArray2D<double>(6, 6) { *this = F; }
+vpForceTwistMatrix::vpForceTwistMatrix(const vpForceTwistMatrix &F) : vpArray2D<double>(6, 6, m_fixedData, m_fixedRowPtrs) { *this = F; }
 
 /*!
 
@@ -126,7 +124,7 @@ vpForceTwistMatrix::vpForceTwistMatrix(const vpForceTwistMatrix &F) : vpArray2D<
   \f]
 
 */
-vpForceTwistMatrix::vpForceTwistMatrix(const vpHomogeneousMatrix &M, bool full) : vpArray2D<double>(6, 6)
+vpForceTwistMatrix::vpForceTwistMatrix(const vpHomogeneousMatrix &M, bool full) : vpArray2D<double>(6, 6, m_fixedData, m_fixedRowPtrs)
 {
   if (full)
     buildFrom(M);
@@ -154,7 +152,7 @@ vpForceTwistMatrix::vpForceTwistMatrix(const vpHomogeneousMatrix &M, bool full)
 
 */
 vpForceTwistMatrix::vpForceTwistMatrix(const vpTranslationVector &t, const vpThetaUVector &thetau)
-  : vpArray2D<double>(6, 6)
+  : vpArray2D<double>(6, 6, m_fixedData, m_fixedRowPtrs)
 {
   buildFrom(t, thetau);
 }
@@ -176,7 +174,7 @@ vpForceTwistMatrix::vpForceTwistMatrix(const vpTranslationVector &t, const vpThe
   \param thetau : \f$\theta u\f$ rotation vector used to initialize \f$R\f$.
 
 */
-vpForceTwistMatrix::vpForceTwistMatrix(const vpThetaUVector &thetau) : vpArray2D<double>(6, 6) { buildFrom(thetau); }
+vpForceTwistMatrix::vpForceTwistMatrix(const vpThetaUVector &thetau) : vpArray2D<double>(6, 6, m_fixedData, m_fixedRowPtrs) { buildFrom(thetau); }
 
 /*!
 
@@ -198,7 +196,7 @@ vpForceTwistMatrix::vpForceTwistMatrix(const vpThetaUVector &thetau) : vpArray2D
 
 */
 vpForceTwistMatrix::vpForceTwistMatrix(const vpTranslationVector &t, const vpRotationMatrix &R)
-  : vpArray2D<double>(6, 6)
+  : vpArray2D<double>(6, 6, m_fixedData, m_fixedRowPtrs)
 {
   buildFrom(t, R);
 }
@@ -220,7 +218,7 @@ vpForceTwistMatrix::vpForceTwistMatrix(const vpTranslationVector &t, const vpRot
   \param R : Rotation matrix.
 
 */
-vpForceTwistMatrix::vpForceTwistMatrix(const vpRotationMatrix &R) : vpArray2D<double>(6, 6) { buildFrom(R); }
+vpForceTwistMatrix::vpForceTwistMatrix(const vpRotationMatrix &R) : vpArray2D<double>(6, 6, m_fixedData, m_fixedRowPtrs) { buildFrom(R); }
 
 /*!
 
@@ -244,7 +242,7 @@ vpForceTwistMatrix::vpForceTwistMatrix(const vpRotationMatrix &R) : vpArray2D<do
 */
 vpForceTwistMatrix::vpForceTwistMatrix(const double tx, const double ty, const double tz, const double tux,
                                        const double tuy, const double tuz)
-  : vpArray2D<double>(6, 6)
+  : vpArray2D<double>(6, 6, m_fixedData, m_fixedRowPtrs)
 {
   vpTranslationVector T(tx, ty, tz);
   vpThetaUVector tu(tux, tuy, tuz);
@@ -273,12 +271,20 @@ vpForceTwistMatrix vpForceTwistMatrix::operator*(const vpForceTwistMatrix &F) co
 {
   vpForceTwistMatrix Fout;
 
-  for (unsigned int i = 0; i < 6; i++) {
+  const double *a = data;
+  double *c = Fout.data;
+
+  // Accumulate the rows of F weighted by the coefficients of this matrix
+  for (unsigned int i = 0; i < 36; i += 6) {
     for (unsigned int j = 0; j < 6; j++) {
-      double s = 0;
-      for (unsigned int k = 0; k < 6; k++)
-        s += rowPtrs[i][k] * F.rowPtrs[k][j];
-      Fout[i][j] = s;
+      c[i + j] = 0.;
+    }
+    for (unsigned int k = 0; k < 6; k++) {
+      const double aik = a[i + k];
+      const double *b = F.data + 6 * k;
+      for (unsigned int j = 0; j < 6; j++) {
+        c[i + j] += aik * b[j];
+      }
     }
   }
   return Fout;
@@ -54,7 +54,7 @@
   rotation vector.
  */
 vpHomogeneousMatrix::vpHomogeneousMatrix(const vpTranslationVector &t, const vpQuaternionVector &q)
-  : vpArray2D<double>(4, 4)
+  : vpArray2D<double>(4, 4, m_fixedData, m_fixedRowPtrs)
 {
   buildFrom(t, q);
   (*this)[3][3] = 1.;
@@ -63,20 +63,20 @@ vpHomogeneousMatrix::vpHomogeneousMatrix(const vpTranslationVector &t, const vpQ
 /*!
   Default constructor that initialize an homogeneous matrix as identity.
 */
-vpHomogeneousMatrix::vpHomogeneousMatrix() : vpArray2D<double>(4, 4) { eye(); }
+vpHomogeneousMatrix::vpHomogeneousMatrix() : vpArray2D<double>(4, 4, m_fixedData, m_fixedRowPtrs) { eye(); }
 
 /*!
   Copy constructor that initialize an homogeneous matrix from another
   homogeneous matrix.
 */
-vpHomogeneousMatrix::vpHomogeneousMatrix(const vpHomogeneousMatrix &M) : vpArray2D<double>(4, 4) { *this = M; }
+vpHomogeneousMatrix::vpHomogeneousMatrix(const vpHomogeneousMatrix &M) : vpArray2D<double>(4, 4, m_fixedData, m_fixedRowPtrs) { *this = M; }
 
 /*!
   Construct an homogeneous matrix from a translation vector and \f$\theta {\bf
   u}\f$ rotation vector.
  */
 vpHomogeneousMatrix::vpHomogeneousMatrix(const vpTranslationVector &t, const vpThetaUVector &tu)
-  : vpArray2D<double>(4, 4)
+  : vpArray2D<double>(4, 4, m_fixedData, m_fixedRowPtrs)
 {
   buildFrom(t, tu);
   (*this)[3][3] = 1.;
@@ -87,7 +87,7 @@ vpHomogeneousMatrix::vpHomogeneousMatrix(const vpTranslationVector &t, const vpT
   matrix.
  */
 vpHomogeneousMatrix::vpHomogeneousMatrix(const vpTranslationVector &t, const vpRotationMatrix &R)
-  : vpArray2D<double>(4, 4)
+  : vpArray2D<double>(4, 4, m_fixedData, m_fixedRowPtrs)
 {
   insert(R);
   insert(t);
@@ -97,7 +97,7 @@ vpHomogeneousMatrix::vpHomogeneousMatrix(const vpTranslationVector &t, const vpR
 /*!
   Construct an homogeneous matrix from a pose vector.
  */
-vpHomogeneousMatrix::vpHomogeneousMatrix(const vpPoseVector &p) : vpArray2D<double>(4, 4)
+vpHomogeneousMatrix::vpHomogeneousMatrix(const vpPoseVector &p) : vpArray2D<double>(4, 4, m_fixedData, m_fixedRowPtrs)
 {
   buildFrom(p[0], p[1], p[2], p[3], p[4], p[5]);
   (*this)[3][3] = 1.;
@@ -142,7 +142,7 @@ M:
 0  0  0  1
   \endcode
   */
-vpHomogeneousMatrix::vpHomogeneousMatrix(const std::vector<float> &v) : vpArray2D<double>(4, 4)
+vpHomogeneousMatrix::vpHomogeneousMatrix(const std::vector<float> &v) : vpArray2D<double>(4, 4, m_fixedData, m_fixedRowPtrs)
 {
   buildFrom(v);
   (*this)[3][3] = 1.;
@@ -187,7 +187,7 @@ M:
 0  0  0  1
   \endcode
   */
-vpHomogeneousMatrix::vpHomogeneousMatrix(const std::vector<double> &v) : vpArray2D<double>(4, 4)
+vpHomogeneousMatrix::vpHomogeneousMatrix(const std::vector<double> &v) : vpArray2D<double>(4, 4, m_fixedData, m_fixedRowPtrs)
 {
   buildFrom(v);
   (*this)[3][3] = 1.;
@@ -200,7 +200,7 @@ vpHomogeneousMatrix::vpHomogeneousMatrix(const std::vector<double> &v) : vpArray
  */
 vpHomogeneousMatrix::vpHomogeneousMatrix(const double tx, const double ty, const double tz, const double tux,
                                          const double tuy, const double tuz)
-  : vpArray2D<double>(4, 4)
+  : vpArray2D<double>(4, 4, m_fixedData, m_fixedRowPtrs)
 {
   buildFrom(tx, ty, tz, tux, tuy, tuz);
   (*this)[3][3] = 1.;
@@ -370,10 +370,8 @@ void vpHomogeneousMatrix::buildFrom(const std::vector<double> &v)
 */
 vpHomogeneousMatrix &vpHomogeneousMatrix::operator=(const vpHomogeneousMatrix &M)
 {
-  for (int i = 0; i < 4; i++) {
-    for (int j = 0; j < 4; j++) {
-      rowPtrs[i][j] = M.rowPtrs[i][j];
-    }
+  if (this != &M) {
+    memcpy(data, M.data, 16 * sizeof(double));
   }
   return *this;
 }
@@ -398,23 +396,7 @@ int main()
 vpHomogeneousMatrix vpHomogeneousMatrix::operator*(const vpHomogeneousMatrix &M) const
 {
   vpHomogeneousMatrix p;
-
-  vpRotationMatrix R1, R2, R;
-  vpTranslationVector T1, T2, T;
-
-  extract(T1);
-  M.extract(T2);
-
-  extract(R1);
-  M.extract(R2);
-
-  R = R1 * R2;
-
-  T = R1 * T2 + T1;
-
-  p.insert(T);
-  p.insert(R);
-
+  multiply(*this, M, p);
   return p;
 }
 
@@ -437,8 +419,34 @@ int main()
 */
 vpHomogeneousMatrix &vpHomogeneousMatrix::operator*=(const vpHomogeneousMatrix &M)
 {
-  (*this) = (*this) * M;
-  return (*this);
+  vpHomogeneousMatrix p;
+  multiply(*this, M, p);
+  return (*this) = p;
+}
+
+/*!
+  Compute the product \f$ {^a}{\bf M}_c = {^a}{\bf M}_b \; {^b}{\bf M}_c \f$
+  of two homogeneous matrices without any temporary.
+
+  \param aMb, bMc : Homogeneous matrices to multiply.
+  \param aMc : Result of the product. It must not be \e aMb or \e bMc.
+*/
+void vpHomogeneousMatrix::multiply(const vpHomogeneousMatrix &aMb, const vpHomogeneousMatrix &bMc,
+                                   vpHomogeneousMatrix &aMc)
+{
+  const double *a = aMb.data;
+  const double *b = bMc.data;
+  double *c = aMc.data;
+
+  for (unsigned int i = 0; i < 12; i += 4) {
+    const double a0 = a[i], a1 = a[i + 1], a2 = a[i + 2];
+    c[i] = a0 * b[0] + a1 * b[4] + a2 * b[8];
+    c[i + 1] = a0 * b[1] + a1 * b[5] + a2 * b[9];
+    c[i + 2] = a0 * b[2] + a1 * b[6] + a2 * b[10];
+    c[i + 3] = a0 * b[3] + a1 * b[7] + a2 * b[11] + a[i + 3];
+  }
+  c[12] = c[13] = c[14] = 0.;
+  c[15] = 1.;
 }
 
 /*!
@@ -643,18 +651,7 @@ void vpHomogeneousMatrix::insert(const vpQuaternionVector &q) { insert(vpRotatio
 vpHomogeneousMatrix vpHomogeneousMatrix::inverse() const
 {
   vpHomogeneousMatrix Mi;
-
-  vpRotationMatrix R;
-  extract(R);
-  vpTranslationVector T;
-  extract(T);
-
-  vpTranslationVector RtT;
-  RtT = -(R.t() * T);
-
-  Mi.insert(R.t());
-  Mi.insert(RtT);
-
+  inverse(Mi);
   return Mi;
 }
 
@@ -688,7 +685,35 @@ void vpHomogeneousMatrix::eye()
   \right]\f$
 
 */
-void vpHomogeneousMatrix::inverse(vpHomogeneousMatrix &M) const { M = inverse(); }
+void vpHomogeneousMatrix::inverse(vpHomogeneousMatrix &M) const
+{
+  if (&M == this) {
+    M = inverse();
+    return;
+  }
+
+  const double *a = data;
+  double *b = M.data;
+
+  // Rotation part: R^T
+  b[0] = a[0];
+  b[1] = a[4];
+  b[2] = a[8];
+  b[4] = a[1];
+  b[5] = a[5];
+  b[6] = a[9];
+  b[8] = a[2];
+  b[9] = a[6];
+  b[10] = a[10];
+
+  // Translation part: -R^T t
+  b[3] = -(a[0] * a[3] + a[4] * a[7] + a[8] * a[11]);
+  b[7] = -(a[1] * a[3] + a[5] * a[7] + a[9] * a[11]);
+  b[11] = -(a[2] * a[3] + a[6] * a[7] + a[10] * a[11]);
+
+  b[12] = b[13] = b[14] = 0.;
+  b[15] = 1.;
+}
 
 /*!
   Write an homogeneous matrix in an output file stream.
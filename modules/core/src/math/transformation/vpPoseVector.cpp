@@ -63,7 +63,26 @@
   The pose vector is initialized to zero.
 
 */
-vpPoseVector::vpPoseVector() : vpArray2D<double>(6, 1) {}
+vpPoseVector::vpPoseVector() : vpArray2D<double>(6, 1, m_fixedData, m_fixedRowPtrs) {}
+
+/*!
+  Copy constructor.
+*/
+vpPoseVector::vpPoseVector(const vpPoseVector &p) : vpArray2D<double>(6, 1, m_fixedData, m_fixedRowPtrs)
+{
+  *this = p;
+}
+
+/*!
+  Copy operator.
+*/
+vpPoseVector &vpPoseVector::operator=(const vpPoseVector &p)
+{
+  if (this != &p) {
+    memcpy(data, p.data, 6 * sizeof(double));
+  }
+  return *this;
+}
 
 /*!
 
@@ -82,7 +101,7 @@ vpPoseVector::vpPoseVector() : vpArray2D<double>(6, 1) {}
 */
 vpPoseVector::vpPoseVector(const double tx, const double ty, const double tz, const double tux, const double tuy,
                            const double tuz)
-  : vpArray2D<double>(6, 1)
+  : vpArray2D<double>(6, 1, m_fixedData, m_fixedRowPtrs)
 {
   (*this)[0] = tx;
   (*this)[1] = ty;
@@ -103,7 +122,7 @@ vpPoseVector::vpPoseVector(const double tx, const double ty, const double tz, co
   \param tu : \f$\theta \bf u\f$ rotation  vector.
 
 */
-vpPoseVector::vpPoseVector(const vpTranslationVector &tv, const vpThetaUVector &tu) : vpArray2D<double>(6, 1)
+vpPoseVector::vpPoseVector(const vpTranslationVector &tv, const vpThetaUVector &tu) : vpArray2D<double>(6, 1, m_fixedData, m_fixedRowPtrs)
 {
   buildFrom(tv, tu);
 }
@@ -120,7 +139,7 @@ vpPoseVector::vpPoseVector(const vpTranslationVector &tv, const vpThetaUVector &
   u\f$ vector is extracted to initialise the pose vector.
 
 */
-vpPoseVector::vpPoseVector(const vpTranslationVector &tv, const vpRotationMatrix &R) : vpArray2D<double>(6, 1)
+vpPoseVector::vpPoseVector(const vpTranslationVector &tv, const vpRotationMatrix &R) : vpArray2D<double>(6, 1, m_fixedData, m_fixedRowPtrs)
 {
   buildFrom(tv, R);
 }
@@ -135,7 +154,7 @@ vpPoseVector::vpPoseVector(const vpTranslationVector &tv, const vpRotationMatrix
   initialize the pose vector.
 
 */
-vpPoseVector::vpPoseVector(const vpHomogeneousMatrix &M) : vpArray2D<double>(6, 1) { buildFrom(M); }
+vpPoseVector::vpPoseVector(const vpHomogeneousMatrix &M) : vpArray2D<double>(6, 1, m_fixedData, m_fixedRowPtrs) { buildFrom(M); }
 
 /*!
 
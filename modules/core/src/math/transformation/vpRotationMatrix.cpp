@@ -84,10 +84,8 @@ void vpRotationMatrix::eye()
 */
 vpRotationMatrix &vpRotationMatrix::operator=(const vpRotationMatrix &R)
 {
-  for (unsigned int i = 0; i < 3; i++) {
-    for (unsigned int j = 0; j < 3; j++) {
-      rowPtrs[i][j] = R.rowPtrs[i][j];
-    }
+  if (this != &R) {
+    memcpy(data, R.data, 9 * sizeof(double));
   }
 
   return *this;
@@ -122,7 +120,7 @@ R:
 vpRotationMatrix& vpRotationMatrix::operator=(const std::initializer_list<double> &list)
 {
   if (dsize != static_cast<unsigned int>(list.size())) {
-    throw(vpException(vpException::dimensionError, "Cannot set a 3-by-3 rotation matrix from a %d-elements list of doubles."));
+    throw(vpException(vpException::dimensionError, "Cannot set a 3-by-3 rotation matrix from a %d-elements list of doubles.", (int)list.size()));
   }
 
   std::copy(list.begin(), list.end(), data);
@@ -250,14 +248,14 @@ vpRotationMatrix& vpRotationMatrix::operator,(double val)
 vpRotationMatrix vpRotationMatrix::operator*(const vpRotationMatrix &R) const
 {
   vpRotationMatrix p;
-
-  for (unsigned int i = 0; i < 3; i++) {
-    for (unsigned int j = 0; j < 3; j++) {
-      double s = 0;
-      for (unsigned int k = 0; k < 3; k++)
-        s += rowPtrs[i][k] * R.rowPtrs[k][j];
-      p[i][j] = s;
-    }
+  const double *a = data;
+  const double *b = R.data;
+
+  for (unsigned int i = 0; i < 9; i += 3) {
+    const double a0 = a[i], a1 = a[i + 1], a2 = a[i + 2];
+    p.data[i] = a0 * b[0] + a1 * b[3] + a2 * b[6];
+    p.data[i + 1] = a0 * b[1] + a1 * b[4] + a2 * b[7];
+    p.data[i + 2] = a0 * b[2] + a1 * b[5] + a2 * b[8];
   }
   return p;
 }
@@ -350,15 +348,12 @@ vpColVector vpRotationMatrix::operator*(const vpColVector &v) const
 vpTranslationVector vpRotationMatrix::operator*(const vpTranslationVector &tv) const
 {
   vpTranslationVector p;
+  const double *a = data;
+  const double t0 = tv[0], t1 = tv[1], t2 = tv[2];
 
-  for (unsigned int j = 0; j < 3; j++)
-    p[j] = 0;
-
-  for (unsigned int j = 0; j < 3; j++) {
-    for (unsigned int i = 0; i < 3; i++) {
-      p[i] += rowPtrs[i][j] * tv[j];
-    }
-  }
+  p[0] = a[0] * t0 + a[1] * t1 + a[2] * t2;
+  p[1] = a[3] * t0 + a[4] * t1 + a[5] * t2;
+  p[2] = a[6] * t0 + a[7] * t1 + a[8] * t2;
 
   return p;
 }
@@ -438,57 +433,57 @@ bool vpRotationMatrix::isARotationMatrix() const
 /*!
   Default constructor that initialise a 3-by-3 rotation matrix to identity.
 */
-vpRotationMatrix::vpRotationMatrix() : vpArray2D<double>(3, 3), m_index(0) { eye(); }
+vpRotationMatrix::vpRotationMatrix() : vpArray2D<double>(3, 3, m_fixedData, m_fixedRowPtrs), m_index(0) { eye(); }
 
 /*!
   Copy contructor that construct a 3-by-3 rotation matrix from another
   rotation matrix.
 */
-vpRotationMatrix::vpRotationMatrix(const vpRotationMatrix &M) : vpArray2D<double>(3, 3), m_index(0) { (*this) = M; }
+vpRotationMatrix::vpRotationMatrix(const vpRotationMatrix &M) : vpArray2D<double>(3, 3, m_fixedData, m_fixedRowPtrs), m_index(0) { (*this) = M; }
 /*!
   Construct a 3-by-3 rotation matrix from an homogeneous matrix.
 */
-vpRotationMatrix::vpRotationMatrix(const vpHomogeneousMatrix &M) : vpArray2D<double>(3, 3), m_index(0) { buildFrom(M); }
+vpRotationMatrix::vpRotationMatrix(const vpHomogeneousMatrix &M) : vpArray2D<double>(3, 3, m_fixedData, m_fixedRowPtrs), m_index(0) { buildFrom(M); }
 
 /*!
   Construct a 3-by-3 rotation matrix from \f$ \theta {\bf u}\f$ angle
   representation.
  */
-vpRotationMatrix::vpRotationMatrix(const vpThetaUVector &tu) : vpArray2D<double>(3, 3), m_index(0) { buildFrom(tu); }
+vpRotationMatrix::vpRotationMatrix(const vpThetaUVector &tu) : vpArray2D<double>(3, 3, m_fixedData, m_fixedRowPtrs), m_index(0) { buildFrom(tu); }
 
 /*!
   Construct a 3-by-3 rotation matrix from a pose vector.
  */
-vpRotationMatrix::vpRotationMatrix(const vpPoseVector &p) : vpArray2D<double>(3, 3), m_index(0) { buildFrom(p); }
+vpRotationMatrix::vpRotationMatrix(const vpPoseVector &p) : vpArray2D<double>(3, 3, m_fixedData, m_fixedRowPtrs), m_index(0) { buildFrom(p); }
 
 /*!
   Construct a 3-by-3 rotation matrix from \f$ R(z,y,z) \f$ Euler angle
   representation.
  */
-vpRotationMatrix::vpRotationMatrix(const vpRzyzVector &euler) : vpArray2D<double>(3, 3), m_index(0) { buildFrom(euler); }
+vpRotationMatrix::vpRotationMatrix(const vpRzyzVector &euler) : vpArray2D<double>(3, 3, m_fixedData, m_fixedRowPtrs), m_index(0) { buildFrom(euler); }
 
 /*!
   Construct a 3-by-3 rotation matrix from \f$ R(x,y,z) \f$ Euler angle
   representation.
  */
-vpRotationMatrix::vpRotationMatrix(const vpRxyzVector &Rxyz) : vpArray2D<double>(3, 3), m_index(0) { buildFrom(Rxyz); }
+vpRotationMatrix::vpRotationMatrix(const vpRxyzVector &Rxyz) : vpArray2D<double>(3, 3, m_fixedData, m_fixedRowPtrs), m_index(0) { buildFrom(Rxyz); }
 
 /*!
   Construct a 3-by-3 rotation matrix from \f$ R(z,y,x) \f$ Euler angle
   representation.
  */
-vpRotationMatrix::vpRotationMatrix(const vpRzyxVector &Rzyx) : vpArray2D<double>(3, 3), m_index(0) { buildFrom(Rzyx); }
+vpRotationMatrix::vpRotationMatrix(const vpRzyxVector &Rzyx) : vpArray2D<double>(3, 3, m_fixedData, m_fixedRowPtrs), m_index(0) { buildFrom(Rzyx); }
 
 /*!
   Construct a 3-by-3 rotation matrix from a matrix that contains values corresponding to a rotation matrix.
 */
-vpRotationMatrix::vpRotationMatrix(const vpMatrix &R) : vpArray2D<double>(3, 3), m_index(0) { *this = R; }
+vpRotationMatrix::vpRotationMatrix(const vpMatrix &R) : vpArray2D<double>(3, 3, m_fixedData, m_fixedRowPtrs), m_index(0) { *this = R; }
 
 /*!
   Construct a 3-by-3 rotation matrix from \f$ \theta {\bf u}=(\theta u_x,
   \theta u_y, \theta u_z)^T\f$ angle representation.
  */
-vpRotationMatrix::vpRotationMatrix(const double tux, const double tuy, const double tuz) : vpArray2D<double>(3, 3), m_index(0)
+vpRotationMatrix::vpRotationMatrix(const double tux, const double tuy, const double tuz) : vpArray2D<double>(3, 3, m_fixedData, m_fixedRowPtrs), m_index(0)
 {
   buildFrom(tux, tuy, tuz);
 }
@@ -496,7 +491,7 @@ vpRotationMatrix::vpRotationMatrix(const double tux, const double tuy, const dou
 /*!
   Construct a 3-by-3 rotation matrix from quaternion angle representation.
  */
-vpRotationMatrix::vpRotationMatrix(const vpQuaternionVector &q) : vpArray2D<double>(3, 3), m_index(0) { buildFrom(q); }
+vpRotationMatrix::vpRotationMatrix(const vpQuaternionVector &q) : vpArray2D<double>(3, 3, m_fixedData, m_fixedRowPtrs), m_index(0) { buildFrom(q); }
 
 #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
 /*!
@@ -522,11 +517,10 @@ R:
 -1  0  0
   \endcode
  */
-vpRotationMatrix::vpRotationMatrix(const std::initializer_list<double> &list) : vpArray2D<double>(3, 3, list), m_index(0)
+vpRotationMatrix::vpRotationMatrix(const std::initializer_list<double> &list)
+  : vpArray2D<double>(3, 3, m_fixedData, m_fixedRowPtrs), m_index(0)
 {
-  if (! isARotationMatrix() ) {
-    throw(vpException(vpException::fatalError, "Rotation matrix initialization fails since it's elements doesn't represent a rotation matrix"));
-  }
+  *this = list;
 }
 #endif
 
@@ -539,11 +533,18 @@ vpRotationMatrix::vpRotationMatrix(const std::initializer_list<double> &list) :
 vpRotationMatrix vpRotationMatrix::t() const
 {
   vpRotationMatrix Rt;
-
-  unsigned int i, j;
-  for (i = 0; i < 3; i++)
-    for (j = 0; j < 3; j++)
-      Rt[j][i] = (*this)[i][j];
+  const double *a = data;
+  double *b = Rt.data;
+
+  b[0] = a[0];
+  b[1] = a[3];
+  b[2] = a[6];
+  b[3] = a[1];
+  b[4] = a[4];
+  b[5] = a[7];
+  b[6] = a[2];
+  b[7] = a[5];
+  b[8] = a[8];
 
   return Rt;
 }
@@ -57,10 +57,8 @@
 */
 vpVelocityTwistMatrix &vpVelocityTwistMatrix::operator=(const vpVelocityTwistMatrix &V)
 {
-  for (int i = 0; i < 6; i++) {
-    for (int j = 0; j < 6; j++) {
-      rowPtrs[i][j] = V.rowPtrs[i][j];
-    }
+  if (this != &V) {
+    memcpy(data, V.data, 36 * sizeof(double));
   }
 
   return *this;
@@ -82,7 +80,7 @@ void vpVelocityTwistMatrix::eye()
 /*!
   Initialize a velocity twist transformation matrix as identity.
 */
-vpVelocityTwistMatrix::vpVelocityTwistMatrix() : vpArray2D<double>(6, 6) { eye(); }
+vpVelocityTwistMatrix::vpVelocityTwistMatrix() : vpArray2D<double>(6, 6, m_fixedData, m_fixedRowPtrs) { eye(); }
 
 /*!
   Initialize a velocity twist transformation matrix from another velocity
@@ -90,7 +88,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix() : vpArray2D<double>(6, 6) { eye()
 
   \param V : Velocity twist matrix used as initializer.
 */
-vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpVelocityTwistMatrix &V) : vpArray2D<double>(6, 6) { *this = V; }
+vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpVelocityTwistMatrix &V) : vpArray2D<double>(6, 6, m_fixedData, m_fixedRowPtrs) { *this = V; }
 
 /*!
 
@@ -110,7 +108,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpVelocityTwistMatrix &V) : v
   {\bf 0}_{3\times 3} & {\bf R} \end{array} \right] \f]
 
 */
-vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpHomogeneousMatrix &M, bool full) : vpArray2D<double>(6, 6)
+vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpHomogeneousMatrix &M, bool full) : vpArray2D<double>(6, 6, m_fixedData, m_fixedRowPtrs)
 {
   if (full)
     buildFrom(M);
@@ -133,7 +131,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpHomogeneousMatrix &M, bool
 
 */
 vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpTranslationVector &t, const vpThetaUVector &thetau)
-  : vpArray2D<double>(6, 6)
+  : vpArray2D<double>(6, 6, m_fixedData, m_fixedRowPtrs)
 {
   buildFrom(t, thetau);
 }
@@ -150,7 +148,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpTranslationVector &t, const
   vector \f$R\f$ .
 
 */
-vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpThetaUVector &thetau) : vpArray2D<double>(6, 6)
+vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpThetaUVector &thetau) : vpArray2D<double>(6, 6, m_fixedData, m_fixedRowPtrs)
 {
   buildFrom(thetau);
 }
@@ -169,7 +167,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpThetaUVector &thetau) : vpA
 
 */
 vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpTranslationVector &t, const vpRotationMatrix &R)
-  : vpArray2D<double>(6, 6)
+  : vpArray2D<double>(6, 6, m_fixedData, m_fixedRowPtrs)
 {
   buildFrom(t, R);
 }
@@ -185,7 +183,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpTranslationVector &t, const
   \param R : Rotation matrix.
 
 */
-vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpRotationMatrix &R) : vpArray2D<double>(6, 6) { buildFrom(R); }
+vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpRotationMatrix &R) : vpArray2D<double>(6, 6, m_fixedData, m_fixedRowPtrs) { buildFrom(R); }
 
 /*!
 
@@ -204,7 +202,7 @@ vpVelocityTwistMatrix::vpVelocityTwistMatrix(const vpRotationMatrix &R) : vpArra
 */
 vpVelocityTwistMatrix::vpVelocityTwistMatrix(const double tx, const double ty, const double tz, const double tux,
                                              const double tuy, const double tuz)
-  : vpArray2D<double>(6, 6)
+  : vpArray2D<double>(6, 6, m_fixedData, m_fixedRowPtrs)
 {
   vpTranslationVector t(tx, ty, tz);
   vpThetaUVector tu(tux, tuy, tuz);
@@ -221,12 +219,20 @@ vpVelocityTwistMatrix vpVelocityTwistMatrix::operator*(const vpVelocityTwistMatr
 {
   vpVelocityTwistMatrix p;
 
-  for (unsigned int i = 0; i < 6; i++) {
+  const double *a = data;
+  double *c = p.data;
+
+  // Accumulate the rows of V weighted by the coefficients of this matrix
+  for (unsigned int i = 0; i < 36; i += 6) {
     for (unsigned int j = 0; j < 6; j++) {
-      double s = 0;
-      for (int k = 0; k < 6; k++)
-        s += rowPtrs[i][k] * V.rowPtrs[k][j];
-      p[i][j] = s;
+      c[i + j] = 0.;
+    }
+    for (unsigned int k = 0; k < 6; k++) {
+      const double aik = a[i + k];
+      const double *b = V.data + 6 * k;
+      for (unsigned int j = 0; j < 6; j++) {
+        c[i + j] += aik * b[j];
+      }
     }
   }
   return p;
@@ -45,94 +45,111 @@
 
 */
 
+#include <algorithm>
+#include <stdint.h>
 #include <stdlib.h>
+#include <vector>
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpHistogram.h>
 #include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpThreadPool.h>
 
-#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
-#include <visp3/core/vpThread.h>
-
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
 namespace
 {
-struct Histogram_Param_t {
-  unsigned int m_start_index;
-  unsigned int m_end_index;
-
-  unsigned int m_lut[256];
-  unsigned int *m_histogram;
-  const vpImage<unsigned char> *m_I;
-
-  Histogram_Param_t() : m_start_index(0), m_end_index(0), m_lut(), m_histogram(NULL), m_I(NULL) {}
+// Smallest image, in bytes, whose histogram is counted on several threads.
+// Smaller images are counted in a single band by the calling thread
+const unsigned int histogramMinParallelBytes = 1 << 16;
+
+/*
+  Count n bytes in 8 tables of 256 counters, byte k of the row going to
+  table k % 8. Consecutive equal bytes thus increment different counters,
+  which avoids the store-to-load dependency of a single table on uniform
+  regions. For interleaved RGBa pixels, tables c and c + 4 hold channel c.
+*/
+void countBytes(const unsigned char *ptr, unsigned int n, unsigned int (*tables)[256])
+{
+  unsigned int k = 0;
+  for (; k + 8 <= n; k += 8) {
+    tables[0][ptr[k]]++;
+    tables[1][ptr[k + 1]]++;
+    tables[2][ptr[k + 2]]++;
+    tables[3][ptr[k + 3]]++;
+    tables[4][ptr[k + 4]]++;
+    tables[5][ptr[k + 5]]++;
+    tables[6][ptr[k + 6]]++;
+    tables[7][ptr[k + 7]]++;
+  }
+  for (; k < n; k++) {
+    tables[k & 7][ptr[k]]++;
+  }
+}
 
-  Histogram_Param_t(const unsigned int start_index, const unsigned int end_index, const vpImage<unsigned char> *const I)
-    : m_start_index(start_index), m_end_index(end_index), m_lut(), m_histogram(NULL), m_I(I)
+/*
+  Each band of rows is counted in its own 8 tables, so that the bands can be
+  processed concurrently without synchronization.
+*/
+class vpHistogramBody : public vpParallelForBody
+{
+public:
+  vpHistogramBody(const unsigned char *data, unsigned int height, unsigned int rowBytes, size_t strideBytes,
+                  unsigned int nbBands, std::vector<unsigned int> &tables)
+    : m_data(data), m_height(height), m_rowBytes(rowBytes), m_strideBytes(strideBytes), m_nbBands(nbBands),
+      m_tables(tables)
   {
   }
 
-  ~Histogram_Param_t()
+  void operator()(int begin, int end)
   {
-    if (m_histogram != NULL) {
-      delete[] m_histogram;
+    for (int b = begin; b < end; b++) {
+      unsigned int(*tables)[256] = reinterpret_cast<unsigned int(*)[256]>(&m_tables[(size_t)b * 8 * 256]);
+      const unsigned int iMin = (unsigned int)((uint64_t)b * m_height / m_nbBands);
+      const unsigned int iMax = (unsigned int)((uint64_t)(b + 1) * m_height / m_nbBands);
+      for (unsigned int i = iMin; i < iMax; i++) {
+        countBytes(m_data + i * m_strideBytes, m_rowBytes, tables);
+      }
     }
   }
+
+private:
+  const unsigned char *m_data;
+  unsigned int m_height;
+  unsigned int m_rowBytes;
+  size_t m_strideBytes;
+  unsigned int m_nbBands;
+  std::vector<unsigned int> &m_tables;
 };
 
-vpThread::Return computeHistogramThread(vpThread::Args args)
+/*
+  Count the bytes of height rows of rowBytes bytes on at most nbThreads
+  threads of vpThreadPool. The 8 tables of 256 counters of all the bands are
+  summed into the first 8 * 256 elements of tables.
+*/
+void countRows(const unsigned char *data, unsigned int height, unsigned int rowBytes, size_t strideBytes,
+               unsigned int nbThreads, std::vector<unsigned int> &tables)
 {
-  Histogram_Param_t *histogram_param = static_cast<Histogram_Param_t *>(args);
-  unsigned int start_index = histogram_param->m_start_index;
-  unsigned int end_index = histogram_param->m_end_index;
-
-  const vpImage<unsigned char> *I = histogram_param->m_I;
-
-  unsigned char *ptrStart = (unsigned char *)(I->bitmap) + start_index;
-  unsigned char *ptrEnd = (unsigned char *)(I->bitmap) + end_index;
-  unsigned char *ptrCurrent = ptrStart;
-
-  //    while(ptrCurrent != ptrEnd) {
-  //      histogram_param->m_histogram[ histogram_param->m_lut[ *ptrCurrent ]
-  //      ] ++;
-  //      ++ptrCurrent;
-  //    }
-
-  if (end_index - start_index >= 8) {
-    // Unroll loop version
-    for (; ptrCurrent <= ptrEnd - 8;) {
-      histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
-      ++ptrCurrent;
-
-      histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
-      ++ptrCurrent;
-
-      histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
-      ++ptrCurrent;
-
-      histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
-      ++ptrCurrent;
-
-      histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
-      ++ptrCurrent;
-
-      histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
-      ++ptrCurrent;
-
-      histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
-      ++ptrCurrent;
-
-      histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
-      ++ptrCurrent;
-    }
+  unsigned int nbBands = 1;
+  if (nbThreads > 1 && (uint64_t)height * rowBytes > histogramMinParallelBytes) {
+    // A few bands per thread to balance the load
+    nbBands = std::min(height, 4 * nbThreads);
   }
+  tables.assign((size_t)nbBands * 8 * 256, 0);
 
-  for (; ptrCurrent != ptrEnd; ++ptrCurrent) {
-    histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
+  vpHistogramBody body(data, height, rowBytes, strideBytes, nbBands, tables);
+  if (nbBands == 1) {
+    body(0, 1);
+  } else {
+    vpThreadPool::instance().parallel_for(0, (int)nbBands, body, 1, nbThreads);
+    for (unsigned int b = 1; b < nbBands; b++) {
+      const unsigned int *band = &tables[(size_t)b * 8 * 256];
+      for (unsigned int k = 0; k < 8 * 256; k++) {
+        tables[k] += band[k];
+      }
+    }
   }
-
-  return 0;
 }
-}
-#endif
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
 
 bool compare_vpHistogramPeak(vpHistogramPeak first, vpHistogramPeak second);
 
@@ -228,14 +245,13 @@ void vpHistogram::init(unsigned size_)
 }
 
 /*!
+  Set the number of bins, clear the histogram and compute the bin of each
+  gray level.
 
-  Calculate the histogram from a gray level image.
-
-  \param I : Gray level image.
-  \param nbins : Number of bins to compute the histogram.
-  \param nbThreads : Number of threads to use for the computation.
+  \param nbins : Number of bins, between 1 and 256.
+  \param lut : Bin of each gray level.
 */
-void vpHistogram::calculate(const vpImage<unsigned char> &I, const unsigned int nbins, const unsigned int nbThreads)
+void vpHistogram::initBins(const unsigned int nbins, unsigned int lut[256])
 {
   if (size != nbins) {
     if (histogram != NULL) {
@@ -252,89 +268,79 @@ void vpHistogram::calculate(const vpImage<unsigned char> &I, const unsigned int
 
   memset(histogram, 0, size * sizeof(unsigned int));
 
-  bool use_single_thread;
-#if !defined(VISP_HAVE_PTHREAD) && !defined(_WIN32)
-  use_single_thread = true;
-#else
-  use_single_thread = (nbThreads == 0 || nbThreads == 1);
-#endif
-
-  if (!use_single_thread && I.getSize() <= nbThreads) {
-    use_single_thread = true;
-  }
-
-  unsigned int lut[256];
   for (unsigned int i = 0; i < 256; i++) {
     lut[i] = (unsigned int)(i * size / 256.0);
   }
+}
 
-  if (use_single_thread) {
-    // Single thread
-
-    unsigned int size_ = I.getWidth() * I.getHeight();
-    unsigned char *ptrStart = (unsigned char *)I.bitmap;
-    unsigned char *ptrEnd = ptrStart + size_;
-    unsigned char *ptrCurrent = ptrStart;
-
-    while (ptrCurrent != ptrEnd) {
-      histogram[lut[*ptrCurrent]]++;
-      ++ptrCurrent;
-    }
-  } else {
-#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
-    // Multi-threads
-
-    std::vector<vpThread *> threadpool;
-    std::vector<Histogram_Param_t *> histogramParams;
-
-    unsigned int image_size = I.getSize();
-    unsigned int step = image_size / nbThreads;
-    unsigned int last_step = image_size - step * (nbThreads - 1);
-
-    for (unsigned int index = 0; index < nbThreads; index++) {
-      unsigned int start_index = index * step;
-      unsigned int end_index = (index + 1) * step;
-
-      if (index == nbThreads - 1) {
-        end_index = start_index + last_step;
-      }
-
-      Histogram_Param_t *histogram_param = new Histogram_Param_t(start_index, end_index, &I);
-      histogram_param->m_histogram = new unsigned int[size];
-      memset(histogram_param->m_histogram, 0, size * sizeof(unsigned int));
-      memcpy(histogram_param->m_lut, lut, 256 * sizeof(unsigned int));
-
-      histogramParams.push_back(histogram_param);
+/*!
 
-      // Start the threads
-      vpThread *histogram_thread = new vpThread((vpThread::Fn)computeHistogramThread, (vpThread::Args)histogram_param);
-      threadpool.push_back(histogram_thread);
-    }
+  Calculate the histogram from a gray level image.
 
-    for (size_t cpt = 0; cpt < threadpool.size(); cpt++) {
-      // Wait until thread ends up
-      threadpool[cpt]->join();
-    }
+  \param I : Gray level image.
+  \param nbins : Number of bins to compute the histogram.
+  \param nbThreads : Maximum number of threads of vpThreadPool to use for the
+  computation. Each thread counts its bands of rows in its own
+  sub-histograms, which are summed at the end.
+*/
+void vpHistogram::calculate(const vpImage<unsigned char> &I, const unsigned int nbins, const unsigned int nbThreads)
+{
+  calculate(vpImageView<unsigned char>(I), nbins, nbThreads);
+}
 
-    for (unsigned int cpt1 = 0; cpt1 < size; cpt1++) {
-      unsigned int sum = 0;
+/*!
 
-      for (size_t cpt2 = 0; cpt2 < histogramParams.size(); cpt2++) {
-        sum += histogramParams[cpt2]->m_histogram[cpt1];
-      }
+  Calculate the histogram of a region of a gray level image, without copying
+  the region.
 
-      histogram[cpt1] = sum;
+  \param I : View of the region of the gray level image.
+  \param nbins : Number of bins to compute the histogram.
+  \param nbThreads : Maximum number of threads of vpThreadPool to use for the
+  computation.
+*/
+void vpHistogram::calculate(const vpImageView<unsigned char> &I, const unsigned int nbins, const unsigned int nbThreads)
+{
+  unsigned int lut[256];
+  initBins(nbins, lut);
+
+  std::vector<unsigned int> tables;
+  countRows(I[0], I.getHeight(), I.getWidth(), I.getStride(), nbThreads, tables);
+  for (unsigned int v = 0; v < 256; v++) {
+    unsigned int count = 0;
+    for (unsigned int t = 0; t < 8; t++) {
+      count += tables[t * 256 + v];
     }
+    histogram[lut[v]] += count;
+  }
+}
 
-    // Delete
-    for (size_t cpt = 0; cpt < threadpool.size(); cpt++) {
-      delete threadpool[cpt];
-    }
+/*!
+  Calculate the histograms of the four channels of a color image in a single
+  pass over the pixels.
+
+  \param I : Color image.
+  \param histR, histG, histB, histA : Histograms of the red, green, blue and
+  alpha channels.
+  \param nbins : Number of bins of each histogram.
+  \param nbThreads : Maximum number of threads of vpThreadPool to use for the
+  computation.
+*/
+void vpHistogram::calculate(const vpImage<vpRGBa> &I, vpHistogram &histR, vpHistogram &histG, vpHistogram &histB,
+                            vpHistogram &histA, const unsigned int nbins, const unsigned int nbThreads)
+{
+  vpHistogram *histograms[4] = {&histR, &histG, &histB, &histA};
+  unsigned int lut[256];
+  for (unsigned int c = 0; c < 4; c++) {
+    histograms[c]->initBins(nbins, lut);
+  }
 
-    for (size_t cpt = 0; cpt < histogramParams.size(); cpt++) {
-      delete histogramParams[cpt];
+  std::vector<unsigned int> tables;
+  countRows(reinterpret_cast<const unsigned char *>(I.bitmap), I.getHeight(), I.getWidth() * 4, I.getWidth() * 4,
+            nbThreads, tables);
+  for (unsigned int c = 0; c < 4; c++) {
+    for (unsigned int v = 0; v < 256; v++) {
+      histograms[c]->histogram[lut[v]] += tables[c * 256 + v] + tables[(c + 4) * 256 + v];
     }
-#endif
   }
 }
 
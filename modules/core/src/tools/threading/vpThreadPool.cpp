@@ -0,0 +1,365 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Process-wide pool of persistent worker threads.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpThreadPool.cpp
+  \brief Process-wide pool of persistent worker threads.
+*/
+
+#include <visp3/core/vpThreadPool.h>
+
+#include <algorithm>
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// True for the pool workers and for a caller while it runs a parallel_for()
+// body, so that nested calls are executed sequentially.
+thread_local bool g_insideParallelRegion = false;
+
+unsigned int defaultNumThreads()
+{
+  unsigned int nbThreads = std::thread::hardware_concurrency();
+  return nbThreads > 0 ? nbThreads : 1;
+}
+}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+class vpThreadPool::Impl
+{
+public:
+  // Remaining part of the range owned by a participant. The padding keeps
+  // two ranges on different cache lines.
+  struct Range {
+    std::mutex mutex;
+    int begin;
+    int end;
+    char padding[64];
+
+    Range() : mutex(), begin(0), end(0), padding() {}
+  };
+
+  Impl()
+    : m_nbThreads(defaultNumThreads()), m_workers(), m_ranges(), m_callMutex(), m_mutex(), m_startCond(), m_endCond(),
+      m_generation(0), m_nbParticipants(0), m_nbRunning(0), m_body(NULL), m_grain(1), m_stop(false), m_error()
+  {
+  }
+
+  ~Impl() { stopWorkers(); }
+
+  void startWorkers()
+  {
+    if (!m_workers.empty() || m_nbThreads <= 1) {
+      return;
+    }
+
+    m_ranges.reset(new Range[m_nbThreads]);
+    m_stop = false;
+    for (unsigned int id = 1; id < m_nbThreads; id++) {
+      m_workers.push_back(std::thread(&Impl::workerLoop, this, id));
+    }
+  }
+
+  void stopWorkers()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_startCond.notify_all();
+    for (size_t i = 0; i < m_workers.size(); i++) {
+      m_workers[i].join();
+    }
+    m_workers.clear();
+  }
+
+  void workerLoop(unsigned int id)
+  {
+    g_insideParallelRegion = true;
+    unsigned long seen = 0;
+
+    for (;;) {
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_startCond.wait(lock, [&] { return m_stop || m_generation != seen; });
+        if (m_stop) {
+          return;
+        }
+        seen = m_generation;
+        if (id >= m_nbParticipants) {
+          continue;
+        }
+      }
+
+      run(id);
+
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_nbRunning == 0) {
+          m_endCond.notify_one();
+        }
+      }
+    }
+  }
+
+  // Take the next chunk of the range owned by participant id.
+  bool pop(unsigned int id, int &begin, int &end)
+  {
+    Range &range = m_ranges[id];
+    std::lock_guard<std::mutex> lock(range.mutex);
+    if (range.begin >= range.end) {
+      return false;
+    }
+    begin = range.begin;
+    end = range.end - range.begin > m_grain ? range.begin + m_grain : range.end;
+    range.begin = end;
+    return true;
+  }
+
+  // Move the second half of the work left to another participant into the
+  // range owned by participant id.
+  bool steal(unsigned int id)
+  {
+    for (unsigned int k = 1; k < m_nbParticipants; k++) {
+      Range &victim = m_ranges[(id + k) % m_nbParticipants];
+      int begin = 0, end = 0;
+      {
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        int remaining = victim.end - victim.begin;
+        if (remaining <= 0) {
+          continue;
+        }
+        end = victim.end;
+        begin = remaining > m_grain ? victim.end - remaining / 2 : victim.begin;
+        victim.end = begin;
+      }
+
+      Range &range = m_ranges[id];
+      std::lock_guard<std::mutex> lock(range.mutex);
+      range.begin = begin;
+      range.end = end;
+      return true;
+    }
+    return false;
+  }
+
+  void run(unsigned int id)
+  {
+    int begin = 0, end = 0;
+    for (;;) {
+      if (!pop(id, begin, end)) {
+        if (steal(id)) {
+          continue;
+        }
+        break;
+      }
+
+      try {
+        (*m_body)(begin, end);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_error) {
+          m_error = std::current_exception();
+        }
+      }
+    }
+  }
+
+  void parallel_for(int begin, int end, vpParallelForBody &body, int grain, unsigned int maxThreads)
+  {
+    if (end <= begin) {
+      return;
+    }
+    grain = std::max(grain, 1);
+
+    const long long count = (long long)end - begin;
+    unsigned int nbParticipants = m_nbThreads;
+    if (maxThreads > 0) {
+      nbParticipants = std::min(nbParticipants, maxThreads);
+    }
+    nbParticipants = (unsigned int)std::min((long long)nbParticipants, (count + grain - 1) / grain);
+
+    if (nbParticipants <= 1 || g_insideParallelRegion) {
+      body(begin, end);
+      return;
+    }
+
+    std::unique_lock<std::mutex> callLock(m_callMutex, std::try_to_lock);
+    if (!callLock.owns_lock()) {
+      // The workers are busy with another caller: do not oversubscribe.
+      body(begin, end);
+      return;
+    }
+
+    startWorkers();
+
+    for (unsigned int i = 0; i < nbParticipants; i++) {
+      m_ranges[i].begin = begin + (int)(count * i / nbParticipants);
+      m_ranges[i].end = begin + (int)(count * (i + 1) / nbParticipants);
+    }
+    m_body = &body;
+    m_grain = grain;
+    m_error = std::exception_ptr();
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_nbParticipants = nbParticipants;
+      m_nbRunning = nbParticipants - 1;
+      ++m_generation;
+    }
+    m_startCond.notify_all();
+
+    g_insideParallelRegion = true;
+    run(0);
+    g_insideParallelRegion = false;
+
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_endCond.wait(lock, [&] { return m_nbRunning == 0; });
+    }
+    m_body = NULL;
+
+    if (m_error) {
+      std::rethrow_exception(m_error);
+    }
+  }
+
+  void setNumThreads(unsigned int nbThreads)
+  {
+    std::lock_guard<std::mutex> callLock(m_callMutex);
+    stopWorkers();
+    m_nbThreads = nbThreads > 0 ? nbThreads : defaultNumThreads();
+  }
+
+  unsigned int m_nbThreads;
+  std::vector<std::thread> m_workers;
+  std::unique_ptr<Range[]> m_ranges;
+  std::mutex m_callMutex; // Serializes the callers of parallel_for()
+  std::mutex m_mutex;     // Protects the fields below
+  std::condition_variable m_startCond;
+  std::condition_variable m_endCond;
+  unsigned long m_generation;
+  unsigned int m_nbParticipants;
+  unsigned int m_nbRunning;
+  vpParallelForBody *m_body;
+  int m_grain;
+  bool m_stop;
+  std::exception_ptr m_error;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+#else
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+class vpThreadPool::Impl
+{
+public:
+  Impl() : m_nbThreads(1) {}
+
+  void parallel_for(int begin, int end, vpParallelForBody &body, int, unsigned int)
+  {
+    if (end > begin) {
+      body(begin, end);
+    }
+  }
+
+  void setNumThreads(unsigned int) {}
+
+  unsigned int m_nbThreads;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+#endif
+
+vpThreadPool::vpThreadPool() : m_impl(new Impl) {}
+
+vpThreadPool::~vpThreadPool() { delete m_impl; }
+
+/*!
+  Return the pool shared by the whole process. The worker threads are only
+  created the first time a parallel_for() call needs them.
+*/
+vpThreadPool &vpThreadPool::instance()
+{
+  static vpThreadPool pool;
+  return pool;
+}
+
+/*!
+  Return the number of threads, including the calling thread, that take part
+  in a parallel_for() call. By default this is the number of hardware threads.
+*/
+unsigned int vpThreadPool::getNumThreads() const { return m_impl->m_nbThreads; }
+
+/*!
+  Change the number of threads of the pool. The current workers are stopped
+  and new ones are created by the next parallel_for() call.
+
+  \param nbThreads : Number of threads including the calling thread. If 0,
+  the number of hardware threads is used. Set 1 to run everything
+  sequentially.
+
+  \warning This function must not be called from a parallel_for() body.
+*/
+void vpThreadPool::setNumThreads(unsigned int nbThreads) { m_impl->setNumThreads(nbThreads); }
+
+/*!
+  Call \e body on sub-ranges covering \f$[begin, end)\f$ from the pool
+  threads and the calling thread, and return once the whole range is
+  processed.
+
+  \param begin : First index of the range.
+  \param end : Index past the last one of the range.
+  \param body : Work to execute on each sub-range.
+  \param grain : Number of indices processed at once by a thread. Larger
+  values reduce the scheduling overhead, smaller ones improve the load
+  balancing.
+  \param maxThreads : Maximum number of threads taking part in this call. If
+  0, all the threads of the pool can be used.
+
+  If \e body throws, the remaining sub-ranges are still processed and the
+  first exception is rethrown to the caller.
+*/
+void vpThreadPool::parallel_for(int begin, int end, vpParallelForBody &body, int grain, unsigned int maxThreads)
+{
+  m_impl->parallel_for(begin, end, body, grain, maxThreads);
+}
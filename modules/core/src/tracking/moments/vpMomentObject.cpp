@@ -42,15 +42,69 @@
 #include <visp3/core/vpMomentBasic.h>
 #include <visp3/core/vpMomentObject.h>
 #include <visp3/core/vpPixelMeterConversion.h>
+#include <visp3/core/vpThreadPool.h>
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
-#ifdef VISP_HAVE_OPENMP
-#include <omp.h>
-#endif
 #include <cassert>
 
+namespace
+{
+// Number of image columns whose moments are accumulated in the same partial
+// sum by vpMomentObject::fromImage()
+const int g_momentColumnBlock = 16;
+
+// Accumulates x^k * y^l over the pixels above a threshold, one partial sum
+// per block of columns so that the result does not depend on the number of
+// threads.
+class vpMomentImageBody : public vpParallelForBody
+{
+public:
+  vpMomentImageBody(const vpImage<unsigned char> &image, unsigned char threshold, const vpCameraParameters &cam,
+                    unsigned int order, std::vector<double> &partials)
+    : m_image(image), m_threshold(threshold), m_cam(cam), m_order(order), m_partials(partials)
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    const unsigned int order = m_order;
+    for (int block = begin; block < end; block++) {
+      double *curvals = &m_partials[(size_t)block * order * order];
+      unsigned int i_end = std::min((block + 1) * g_momentColumnBlock, (int)m_image.getCols());
+      for (unsigned int i = block * g_momentColumnBlock; i < i_end; i++) {
+        for (unsigned int j = 0; j < m_image.getRows(); j++) {
+          if (m_image[j][i] > m_threshold) {
+            double x = 0;
+            double y = 0;
+            vpPixelMeterConversion::convertPoint(m_cam, i, j, x, y);
+
+            double yval = 1.;
+            for (unsigned int k = 0; k < order; k++) {
+              double xval = 1.;
+              for (unsigned int l = 0; l < order - k; l++) {
+                curvals[(k * order + l)] += (xval * yval);
+                xval *= x;
+              }
+              yval *= y;
+            }
+          }
+        }
+      }
+    }
+  }
+
+private:
+  const vpImage<unsigned char> &m_image;
+  unsigned char m_threshold;
+  const vpCameraParameters &m_cam;
+  unsigned int m_order;
+  std::vector<double> &m_partials;
+};
+}
+
 /*!
   Computes moments from a vector of points describing a polygon.
   The points must be stored in a clockwise order. Used internally.
@@ -289,67 +343,17 @@ image
 void vpMomentObject::fromImage(const vpImage<unsigned char> &image, unsigned char threshold,
                                const vpCameraParameters &cam)
 {
-#ifdef VISP_HAVE_OPENMP
-#pragma omp parallel shared(threshold)
-  {
-    std::vector<double> curvals(order * order);
-    curvals.assign(order * order, 0.);
-
-#pragma omp for nowait // automatically organize loop counter between threads
-    for (int i = 0; i < (int)image.getCols(); i++) {
-      for (int j = 0; j < (int)image.getRows(); j++) {
-        unsigned int i_ = static_cast<unsigned int>(i);
-        unsigned int j_ = static_cast<unsigned int>(j);
-        if (image[j_][i_] > threshold) {
-          double x = 0;
-          double y = 0;
-          vpPixelMeterConversion::convertPoint(cam, i_, j_, x, y);
-
-          double yval = 1.;
-          for (unsigned int k = 0; k < order; k++) {
-            double xval = 1.;
-            for (unsigned int l = 0; l < order - k; l++) {
-              curvals[(k * order + l)] += (xval * yval);
-              xval *= x;
-            }
-            yval *= y;
-          }
-        }
-      }
-    }
-
-#pragma omp master // only set this variable in master thread
-    {
-      values.assign(order * order, 0.);
-    }
-
-#pragma omp barrier
-    for (unsigned int k = 0; k < order; k++) {
-      for (unsigned int l = 0; l < order - k; l++) {
-#pragma omp atomic
-        values[k * order + l] += curvals[k * order + l];
-      }
-    }
-  }
-#else
-  std::vector<double> cache(order * order, 0.);
-  values.assign(order * order, 0);
-  for (unsigned int i = 0; i < image.getCols(); i++) {
-    for (unsigned int j = 0; j < image.getRows(); j++) {
-      if (image[j][i] > threshold) {
-        double x = 0;
-        double y = 0;
-        vpPixelMeterConversion::convertPoint(cam, i, j, x, y);
-        cacheValues(cache, x, y);
-        for (unsigned int k = 0; k < order; k++) {
-          for (unsigned int l = 0; l < order - k; l++) {
-            values[k * order + l] += cache[k * order + l];
-          }
-        }
-      }
+  int nbBlocks = ((int)image.getCols() + g_momentColumnBlock - 1) / g_momentColumnBlock;
+  std::vector<double> partials((size_t)nbBlocks * order * order, 0.);
+  vpMomentImageBody body(image, threshold, cam, order, partials);
+  vpThreadPool::instance().parallel_for(0, nbBlocks, body);
+
+  values.assign(order * order, 0.);
+  for (int block = 0; block < nbBlocks; block++) {
+    for (unsigned int k = 0; k < order * order; k++) {
+      values[k] += partials[(size_t)block * order * order + k];
     }
   }
-#endif
 
   // Normalisation equivalent to sampling interval/pixel size delX x delY
   double norm_factor = 1. / (cam.get_px() * cam.get_py());
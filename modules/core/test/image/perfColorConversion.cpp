@@ -29,7 +29,7 @@
  * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
  *
  * Description:
- * Benchmark rgba to grayscale image conversion.
+ * Benchmark color conversions.
  *
  *****************************************************************************/
 
@@ -40,7 +40,12 @@
 #define CATCH_CONFIG_RUNNER
 #include <catch.hpp>
 
+#include <sstream>
+#include <vector>
+
+#include <visp3/core/vpImageConvert.h>
 #include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpUniRand.h>
 #include <visp3/io/vpImageIo.h>
 
 namespace {
@@ -59,6 +64,36 @@ void computeRegularRGBaToGrayscale(const unsigned char * rgba, unsigned char *gr
   }
 }
 
+// Resolutions of the benchmark matrix of the camera-facing conversions
+const unsigned int resolutions[][2] = {{640, 480}, {1280, 720}, {1920, 1080}};
+const size_t nbResolutions = sizeof(resolutions) / sizeof(resolutions[0]);
+
+std::string resolutionName(size_t i)
+{
+  std::stringstream ss;
+  ss << resolutions[i][0] << "x" << resolutions[i][1];
+  return ss.str();
+}
+
+std::vector<unsigned char> randomBuffer(size_t size)
+{
+  vpUniRand rng;
+  std::vector<unsigned char> buffer(size);
+  for (size_t i = 0; i < size; i++) {
+    buffer[i] = static_cast<unsigned char>(rng.uniform(0, 256));
+  }
+  return buffer;
+}
+
+void computeRegularYUYVToRGBa(const unsigned char *yuyv, unsigned char *rgba, unsigned int width, unsigned int height)
+{
+  for (unsigned int i = 0; i < width * height; i++) {
+    unsigned char y = yuyv[2 * i], u = yuyv[4 * (i / 2) + 1], v = yuyv[4 * (i / 2) + 3];
+    vpImageConvert::YUVToRGB(y, u, v, rgba[4 * i], rgba[4 * i + 1], rgba[4 * i + 2]);
+    rgba[4 * i + 3] = vpRGBa::alpha_default;
+  }
+}
+
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020101)
 void computeRegularBGRToGrayscale(unsigned char *bgr, unsigned char *grey, unsigned int width,
                                   unsigned int height, bool flip=false)
@@ -154,6 +189,135 @@ TEST_CASE("Benchmark bgr to grayscale (OpenCV)", "[benchmark]") {
 }
 #endif
 
+TEST_CASE("Benchmark camera color conversions (naive code)", "[benchmark]") {
+  for (size_t r = 0; r < nbResolutions; r++) {
+    const unsigned int width = resolutions[r][0], height = resolutions[r][1];
+    std::vector<unsigned char> yuyv = randomBuffer(2 * width * height);
+    vpImage<vpRGBa> I(height, width);
+
+    BENCHMARK("YUYVToRGBa " + resolutionName(r) + " (naive code)") {
+      computeRegularYUYVToRGBa(&yuyv.front(), reinterpret_cast<unsigned char *>(I.bitmap), width, height);
+      return I;
+    };
+  }
+}
+
+TEST_CASE("Benchmark camera color conversions (ViSP)", "[benchmark]") {
+  for (size_t r = 0; r < nbResolutions; r++) {
+    const unsigned int width = resolutions[r][0], height = resolutions[r][1];
+    const unsigned int size = width * height;
+    const std::string res = resolutionName(r);
+    std::vector<unsigned char> packed = randomBuffer(2 * size);
+    std::vector<unsigned char> planar = randomBuffer(size * 3 / 2);
+    vpImage<vpRGBa> I(height, width);
+    vpImage<unsigned char> I_gray(height, width), R, G, B, A;
+    std::vector<double> hue(size), saturation(size), value(size);
+    unsigned char *rgba = reinterpret_cast<unsigned char *>(I.bitmap);
+
+    BENCHMARK("YUYVToRGBa " + res + " (ViSP)") {
+      vpImageConvert::YUYVToRGBa(&packed.front(), rgba, width, height);
+      return I;
+    };
+
+    BENCHMARK("YCbCrToRGBa " + res + " (ViSP)") {
+      vpImageConvert::YCbCrToRGBa(&packed.front(), rgba, size);
+      return I;
+    };
+
+    BENCHMARK("YUV420ToRGBa " + res + " (ViSP)") {
+      vpImageConvert::YUV420ToRGBa(&planar.front(), rgba, width, height);
+      return I;
+    };
+
+    BENCHMARK("YV12ToRGBa " + res + " (ViSP)") {
+      vpImageConvert::YV12ToRGBa(&planar.front(), rgba, width, height);
+      return I;
+    };
+
+    BENCHMARK("YUV422ToGrey " + res + " (ViSP)") {
+      vpImageConvert::YUV422ToGrey(&packed.front(), I_gray.bitmap, size);
+      return I_gray;
+    };
+
+    BENCHMARK("MONO16ToGrey " + res + " (ViSP)") {
+      vpImageConvert::MONO16ToGrey(&packed.front(), I_gray.bitmap, size);
+      return I_gray;
+    };
+
+    BENCHMARK("split " + res + " (ViSP)") {
+      vpImageConvert::split(I, &R, &G, &B, &A);
+      return R;
+    };
+
+    BENCHMARK("merge " + res + " (ViSP)") {
+      vpImageConvert::merge(&R, &G, &B, &A, I);
+      return I;
+    };
+
+    BENCHMARK("RGBaToHSV " + res + " (ViSP)") {
+      vpImageConvert::RGBaToHSV(rgba, &hue.front(), &saturation.front(), &value.front(), size);
+      return hue;
+    };
+
+    BENCHMARK("BayerToRGBa bilinear " + res + " (ViSP)") {
+      vpImageConvert::BayerToRGBa(&packed.front(), rgba, width, height, vpImageConvert::BAYER_RGGB);
+      return I;
+    };
+
+    BENCHMARK("BayerToRGBa edge-aware " + res + " (ViSP)") {
+      vpImageConvert::BayerToRGBa(&packed.front(), rgba, width, height, vpImageConvert::BAYER_RGGB,
+                                  vpImageConvert::DEMOSAIC_EDGE_AWARE);
+      return I;
+    };
+
+    BENCHMARK("BayerToGrey " + res + " (ViSP)") {
+      vpImageConvert::BayerToGrey(&packed.front(), I_gray.bitmap, width, height);
+      return I_gray;
+    };
+  }
+}
+
+#if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
+TEST_CASE("Benchmark camera color conversions (OpenCV)", "[benchmark]") {
+  for (size_t r = 0; r < nbResolutions; r++) {
+    const int width = (int)resolutions[r][0], height = (int)resolutions[r][1];
+    const std::string res = resolutionName(r);
+    std::vector<unsigned char> packed = randomBuffer(2 * width * height);
+    std::vector<unsigned char> planar = randomBuffer(width * height * 3 / 2);
+    cv::Mat yuyv(height, width, CV_8UC2, &packed.front());
+    cv::Mat yuv420(height * 3 / 2, width, CV_8UC1, &planar.front());
+    cv::Mat img_rgba(height, width, CV_8UC4);
+
+    BENCHMARK("YUYVToRGBa " + res + " (OpenCV)") {
+      cv::cvtColor(yuyv, img_rgba, cv::COLOR_YUV2RGBA_YUYV);
+      return img_rgba;
+    };
+
+    BENCHMARK("YUV420ToRGBa " + res + " (OpenCV)") {
+      cv::cvtColor(yuv420, img_rgba, cv::COLOR_YUV2RGBA_I420);
+      return img_rgba;
+    };
+
+    BENCHMARK("YV12ToRGBa " + res + " (OpenCV)") {
+      cv::cvtColor(yuv420, img_rgba, cv::COLOR_YUV2RGBA_YV12);
+      return img_rgba;
+    };
+
+    cv::Mat bayer(height, width, CV_8UC1, &packed.front());
+    cv::Mat img_rgb(height, width, CV_8UC3);
+    BENCHMARK("BayerToRGB bilinear " + res + " (OpenCV)") {
+      cv::cvtColor(bayer, img_rgb, cv::COLOR_BayerBG2RGB);
+      return img_rgb;
+    };
+
+    BENCHMARK("BayerToRGB edge-aware " + res + " (OpenCV)") {
+      cv::cvtColor(bayer, img_rgb, cv::COLOR_BayerBG2RGB_EA);
+      return img_rgb;
+    };
+  }
+}
+#endif
+
 int main(int argc, char *argv[])
 {
   Catch::Session session; // There must be exactly one instance
@@ -0,0 +1,183 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Benchmark image resize.
+ *
+ *****************************************************************************/
+
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpImageTools.h>
+
+namespace {
+const unsigned int width = 1280, height = 960;
+
+template <class Type> void fillImage(vpImage<Type> &I)
+{
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = static_cast<Type>(i * 2654435761u >> 24);
+  }
+}
+
+template <class Type> void benchmarkResize(const vpImage<Type> &I, const std::string &type)
+{
+  const vpImageTools::vpImageInterpolationType methods[4] = {
+      vpImageTools::INTERPOLATION_NEAREST, vpImageTools::INTERPOLATION_LINEAR, vpImageTools::INTERPOLATION_CUBIC,
+      vpImageTools::INTERPOLATION_AREA};
+  const std::string names[4] = {"nearest", "bilinear", "bicubic", "area"};
+
+  for (int m = 0; m < 4; m++) {
+    vpImage<Type> I_half, I_double;
+    BENCHMARK("Benchmark " + type + " resize to half size (ViSP) (" + names[m] + ")") {
+      vpImageTools::resize(I, I_half, I.getWidth() / 2, I.getHeight() / 2, methods[m]);
+      return I_half;
+    };
+
+    BENCHMARK("Benchmark " + type + " resize to double size (ViSP) (" + names[m] + ")") {
+      vpImageTools::resize(I, I_double, I.getWidth() * 2, I.getHeight() * 2, methods[m]);
+      return I_double;
+    };
+  }
+}
+}
+
+TEST_CASE("Benchmark resize of a grayscale image", "[benchmark]") {
+  vpImage<unsigned char> I(height, width);
+  fillImage(I);
+  benchmarkResize(I, "grayscale");
+
+#if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
+  cv::Mat img, img_half, img_double;
+  vpImageConvert::convert(I, img);
+
+  BENCHMARK("Benchmark grayscale resize to half size (OpenCV) (area)") {
+    cv::resize(img, img_half, cv::Size(width / 2, height / 2), 0, 0, cv::INTER_AREA);
+    return img_half;
+  };
+
+  BENCHMARK("Benchmark grayscale resize to double size (OpenCV) (bicubic)") {
+    cv::resize(img, img_double, cv::Size(width * 2, height * 2), 0, 0, cv::INTER_CUBIC);
+    return img_double;
+  };
+#endif
+}
+
+TEST_CASE("Benchmark resize of a color image", "[benchmark]") {
+  vpImage<vpRGBa> I(height, width);
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = vpRGBa(static_cast<unsigned char>(i), static_cast<unsigned char>(i >> 3),
+                         static_cast<unsigned char>(i >> 7), 255);
+  }
+  benchmarkResize(I, "color");
+}
+
+TEST_CASE("Benchmark resize of a float image", "[benchmark]") {
+  vpImage<float> I(height, width);
+  fillImage(I);
+  benchmarkResize(I, "float");
+}
+
+TEST_CASE("Benchmark perspective warp of color and float images", "[benchmark]") {
+  vpMatrix M(3, 3);
+  M.eye();
+  M[0][1] = 0.1;  M[0][2] = 30;
+  M[1][0] = -0.05;  M[1][2] = 20;
+  M[2][0] = 2e-4;  M[2][1] = -1e-4;
+
+  vpImage<vpRGBa> I_color(height, width), I_color_warp(height, width);
+  vpImage<float> I_float(height, width), I_float_warp(height, width);
+  fillImage(I_float);
+
+  BENCHMARK("Benchmark color perspective warp (ref code) (bilinear)") {
+    vpImageTools::warpImage(I_color, M, I_color_warp, vpImageTools::INTERPOLATION_LINEAR, false);
+    return I_color_warp;
+  };
+
+  BENCHMARK("Benchmark color perspective warp (ViSP) (bilinear)") {
+    vpImageTools::warpImage(I_color, M, I_color_warp, vpImageTools::INTERPOLATION_LINEAR);
+    return I_color_warp;
+  };
+
+  BENCHMARK("Benchmark float perspective warp (ref code) (bilinear)") {
+    vpImageTools::warpImage(I_float, M, I_float_warp, vpImageTools::INTERPOLATION_LINEAR, false);
+    return I_float_warp;
+  };
+
+  BENCHMARK("Benchmark float perspective warp (ViSP) (bilinear)") {
+    vpImageTools::warpImage(I_float, M, I_float_warp, vpImageTools::INTERPOLATION_LINEAR);
+    return I_float_warp;
+  };
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  bool runBenchmark = false;
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli() // Get Catch's composite command line parser
+    | Opt(runBenchmark)    // bind variable to a new option, with a hint string
+    ["--benchmark"]        // the option names it will respond to
+    ("run benchmark?");    // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  if (runBenchmark) {
+    int numFailed = session.run();
+
+    // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+    // This clamping has already been applied, so just return it here
+    // You can also do any post run clean-up here
+    return numFailed;
+  }
+
+  return EXIT_SUCCESS;
+}
+#else
+#include <iostream>
+
+int main()
+{
+  return 0;
+}
+#endif
@@ -0,0 +1,144 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Benchmark template matching.
+ *
+ *****************************************************************************/
+
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpTemplateMatcher.h>
+
+namespace {
+void createImages(vpImage<unsigned char> &I, vpImage<unsigned char> &I_tpl)
+{
+  vpImage<unsigned char> I_noise(480, 640);
+  for (unsigned int i = 0; i < I_noise.getSize(); i++) {
+    I_noise.bitmap[i] = static_cast<unsigned char>(i * 2654435761u >> 24);
+  }
+  vpImageFilter::gaussianBlur(I_noise, I, 7);
+
+  I_tpl.resize(48, 64);
+  for (unsigned int i = 0; i < I_tpl.getHeight(); i++) {
+    for (unsigned int j = 0; j < I_tpl.getWidth(); j++) {
+      I_tpl[i][j] = I[300 + i][400 + j];
+    }
+  }
+}
+}
+
+TEST_CASE("Benchmark template matching", "[benchmark]") {
+  vpImage<unsigned char> I, I_tpl;
+  createImages(I, I_tpl);
+  vpImage<double> I_score;
+
+  BENCHMARK("Benchmark templateMatching step 4 (ref code)") {
+    vpImageTools::templateMatching(I, I_tpl, I_score, 4, 4, false);
+    return I_score;
+  };
+
+  BENCHMARK("Benchmark templateMatching step 4 (ViSP)") {
+    vpImageTools::templateMatching(I, I_tpl, I_score, 4, 4);
+    return I_score;
+  };
+
+  BENCHMARK("Benchmark templateMatching step 1 (ViSP)") {
+    vpImageTools::templateMatching(I, I_tpl, I_score, 1, 1);
+    return I_score;
+  };
+
+  vpTemplateMatcher matcher;
+  std::vector<vpTemplateMatcher::vpMatch> matches;
+  BENCHMARK("Benchmark vpTemplateMatcher exhaustive (ViSP)") {
+    matcher.setImage(I);
+    matcher.match(I_tpl, matches);
+    return matches;
+  };
+
+  matcher.setPyramidLevels(2);
+  BENCHMARK("Benchmark vpTemplateMatcher 2 pyramid levels (ViSP)") {
+    matcher.setImage(I);
+    matcher.match(I_tpl, matches);
+    return matches;
+  };
+
+  matcher.setROI(vpRect(320, 240, 320, 240));
+  BENCHMARK("Benchmark vpTemplateMatcher 2 pyramid levels in ROI (ViSP)") {
+    matcher.match(I_tpl, matches);
+    return matches;
+  };
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  bool runBenchmark = false;
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli() // Get Catch's composite command line parser
+    | Opt(runBenchmark)    // bind variable to a new option, with a hint string
+    ["--benchmark"]        // the option names it will respond to
+    ("run benchmark?");    // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  if (runBenchmark) {
+    int numFailed = session.run();
+
+    // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+    // This clamping has already been applied, so just return it here
+    // You can also do any post run clean-up here
+    return numFailed;
+  }
+
+  return EXIT_SUCCESS;
+}
+#else
+#include <iostream>
+
+int main()
+{
+  return 0;
+}
+#endif
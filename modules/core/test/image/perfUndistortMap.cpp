@@ -0,0 +1,175 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Benchmark image undistortion.
+ *
+ *****************************************************************************/
+
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpUndistortMap.h>
+
+namespace {
+const unsigned int width = 1280, height = 1024;
+
+vpCameraParameters camera()
+{
+  vpCameraParameters cam;
+  cam.initPersProjWithDistortion(1200, 1200, width / 2, height / 2, -0.15, 0.16);
+  return cam;
+}
+
+template <class Type> void fillImage(vpImage<Type> &I)
+{
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = static_cast<Type>(i * 2654435761u >> 24);
+  }
+}
+}
+
+TEST_CASE("Benchmark undistortion of a grayscale image", "[benchmark]") {
+  vpImage<unsigned char> I(height, width), I_undist;
+  fillImage(I);
+  const vpCameraParameters cam = camera();
+
+  BENCHMARK("Benchmark undistort (ViSP)") {
+    vpImageTools::undistort(I, cam, I_undist);
+    return I_undist;
+  };
+
+  vpArray2D<int> mapU, mapV;
+  vpArray2D<float> mapDu, mapDv;
+  vpImageTools::initUndistortMap(cam, width, height, mapU, mapV, mapDu, mapDv);
+  BENCHMARK("Benchmark remap (ViSP)") {
+    vpImageTools::remap(I, mapU, mapV, mapDu, mapDv, I_undist);
+    return I_undist;
+  };
+
+  vpUndistortMap map(cam, width, height);
+  BENCHMARK("Benchmark vpUndistortMap (ViSP)") {
+    map.remap(I, I_undist);
+    return I_undist;
+  };
+
+  BENCHMARK("Benchmark vpUndistortMap single thread (ViSP)") {
+    map.remap(I, I_undist, 1);
+    return I_undist;
+  };
+}
+
+TEST_CASE("Benchmark undistortion of a color image", "[benchmark]") {
+  vpImage<vpRGBa> I(height, width), I_undist;
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = vpRGBa(static_cast<unsigned char>(i), static_cast<unsigned char>(i >> 3),
+                         static_cast<unsigned char>(i >> 7), 255);
+  }
+  const vpCameraParameters cam = camera();
+
+  BENCHMARK("Benchmark undistort (ViSP)") {
+    vpImageTools::undistort(I, cam, I_undist);
+    return I_undist;
+  };
+
+  vpArray2D<int> mapU, mapV;
+  vpArray2D<float> mapDu, mapDv;
+  vpImageTools::initUndistortMap(cam, width, height, mapU, mapV, mapDu, mapDv);
+  BENCHMARK("Benchmark remap (ViSP)") {
+    vpImageTools::remap(I, mapU, mapV, mapDu, mapDv, I_undist);
+    return I_undist;
+  };
+
+  vpUndistortMap map(cam, width, height);
+  BENCHMARK("Benchmark vpUndistortMap (ViSP)") {
+    map.remap(I, I_undist);
+    return I_undist;
+  };
+
+  BENCHMARK("Benchmark vpUndistortMap single thread (ViSP)") {
+    map.remap(I, I_undist, 1);
+    return I_undist;
+  };
+}
+
+TEST_CASE("Benchmark undistortion of a depth image", "[benchmark]") {
+  vpImage<uint16_t> I(height, width), I_undist;
+  fillImage(I);
+  vpUndistortMap map(camera(), width, height);
+
+  BENCHMARK("Benchmark vpUndistortMap (ViSP)") {
+    map.remap(I, I_undist);
+    return I_undist;
+  };
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  bool runBenchmark = false;
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli() // Get Catch's composite command line parser
+    | Opt(runBenchmark)    // bind variable to a new option, with a hint string
+    ["--benchmark"]        // the option names it will respond to
+    ("run benchmark?");    // description string for the help output
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  if (runBenchmark) {
+    int numFailed = session.run();
+
+    // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+    // This clamping has already been applied, so just return it here
+    // You can also do any post run clean-up here
+    return numFailed;
+  }
+
+  return EXIT_SUCCESS;
+}
+#else
+#include <iostream>
+
+int main()
+{
+  return 0;
+}
+#endif
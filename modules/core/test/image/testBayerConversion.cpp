@@ -0,0 +1,282 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Test Bayer demosaicing.
+ *
+ *****************************************************************************/
+/*!
+  \example testBayerConversion.cpp
+
+  \brief Check the Bayer demosaicing of vpImageConvert against a per-pixel
+  reference, for the four patterns and both interpolation methods.
+*/
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace
+{
+inline unsigned char saturate(int c) { return static_cast<unsigned char>(c < 0 ? 0 : (c > 255 ? 255 : c)); }
+
+// Raw image with mirrored borders and the channel of each pixel
+class BayerImage
+{
+public:
+  BayerImage(const std::vector<unsigned char> &raw, int width, int height, vpImageConvert::vpBayerPatternType pattern)
+    : m_raw(raw), m_width(width), m_height(height), m_ry(0), m_rx(0)
+  {
+    if (pattern == vpImageConvert::BAYER_GBRG || pattern == vpImageConvert::BAYER_BGGR) {
+      m_ry = 1;
+    }
+    if (pattern == vpImageConvert::BAYER_GRBG || pattern == vpImageConvert::BAYER_BGGR) {
+      m_rx = 1;
+    }
+  }
+
+  int operator()(int i, int j) const
+  {
+    i = i < 0 ? -i : (i >= m_height ? 2 * m_height - 2 - i : i);
+    j = j < 0 ? -j : (j >= m_width ? 2 * m_width - 2 - j : j);
+    return m_raw[i * m_width + j];
+  }
+
+  // 0 for red, 1 for green, 2 for blue
+  int channel(int i, int j) const
+  {
+    if ((i & 1) == m_ry) {
+      return (j & 1) == m_rx ? 0 : 1;
+    }
+    return (j & 1) == m_rx ? 1 : 2;
+  }
+
+  const std::vector<unsigned char> &m_raw;
+  int m_width, m_height, m_ry, m_rx;
+};
+
+void bilinearReference(const BayerImage &b, std::vector<unsigned char> &rgba)
+{
+  for (int i = 0; i < b.m_height; i++) {
+    for (int j = 0; j < b.m_width; j++) {
+      unsigned char *d = &rgba[4 * (i * b.m_width + j)];
+      const int c = b.channel(i, j);
+      d[c] = (unsigned char)b(i, j);
+      if (c == 1) {
+        // The horizontal neighbours have the color of the row
+        const int h = b.channel(i, j + 1);
+        d[h] = (unsigned char)((b(i, j - 1) + b(i, j + 1) + 1) >> 1);
+        d[2 - h] = (unsigned char)((b(i - 1, j) + b(i + 1, j) + 1) >> 1);
+      } else {
+        d[1] = (unsigned char)((b(i - 1, j) + b(i + 1, j) + b(i, j - 1) + b(i, j + 1) + 2) >> 2);
+        d[2 - c] = (unsigned char)((b(i - 1, j - 1) + b(i - 1, j + 1) + b(i + 1, j - 1) + b(i + 1, j + 1) + 2) >> 2);
+      }
+      d[3] = vpRGBa::alpha_default;
+    }
+  }
+}
+
+void edgeAwareReference(const BayerImage &b, std::vector<unsigned char> &rgba)
+{
+  std::vector<unsigned char> green(b.m_raw.size());
+  for (int i = 0; i < b.m_height; i++) {
+    for (int j = 0; j < b.m_width; j++) {
+      if (b.channel(i, j) == 1) {
+        green[i * b.m_width + j] = (unsigned char)b(i, j);
+        continue;
+      }
+      const int lapH = 2 * b(i, j) - b(i, j - 2) - b(i, j + 2);
+      const int lapV = 2 * b(i, j) - b(i - 2, j) - b(i + 2, j);
+      const int dH = std::abs(b(i, j - 1) - b(i, j + 1)) + std::abs(lapH);
+      const int dV = std::abs(b(i - 1, j) - b(i + 1, j)) + std::abs(lapV);
+      const int gH = (2 * (b(i, j - 1) + b(i, j + 1)) + lapH + 2) >> 2;
+      const int gV = (2 * (b(i - 1, j) + b(i + 1, j)) + lapV + 2) >> 2;
+      green[i * b.m_width + j] = saturate(dH < dV ? gH : (dV < dH ? gV : (gH + gV + 1) >> 1));
+    }
+  }
+
+  const std::vector<unsigned char> &raw = b.m_raw;
+  BayerImage g(green, b.m_width, b.m_height, vpImageConvert::BAYER_RGGB);
+  for (int i = 0; i < b.m_height; i++) {
+    for (int j = 0; j < b.m_width; j++) {
+      unsigned char *d = &rgba[4 * (i * b.m_width + j)];
+      const int c = b.channel(i, j);
+      const int gc = g(i, j);
+      d[1] = (unsigned char)gc;
+      if (c == 1) {
+        const int h = b.channel(i, j + 1);
+        const int dh = b(i, j - 1) - g(i, j - 1) + b(i, j + 1) - g(i, j + 1);
+        const int dv = b(i - 1, j) - g(i - 1, j) + b(i + 1, j) - g(i + 1, j);
+        d[h] = saturate(gc + ((dh + 1) >> 1));
+        d[2 - h] = saturate(gc + ((dv + 1) >> 1));
+      } else {
+        int diag = 0;
+        for (int di = -1; di <= 1; di += 2) {
+          for (int dj = -1; dj <= 1; dj += 2) {
+            diag += b(i + di, j + dj) - g(i + di, j + dj);
+          }
+        }
+        d[c] = raw[i * b.m_width + j];
+        d[2 - c] = saturate(gc + ((diag + 2) >> 2));
+      }
+      d[3] = vpRGBa::alpha_default;
+    }
+  }
+}
+
+void greyReference(const BayerImage &b, std::vector<unsigned char> &grey)
+{
+  const int w[3] = {1, 2, 1};
+  for (int i = 0; i < b.m_height; i++) {
+    for (int j = 0; j < b.m_width; j++) {
+      int sum = 0;
+      for (int di = -1; di <= 1; di++) {
+        for (int dj = -1; dj <= 1; dj++) {
+          sum += w[di + 1] * w[dj + 1] * b(i + di, j + dj);
+        }
+      }
+      grey[i * b.m_width + j] = (unsigned char)((sum + 8) >> 4);
+    }
+  }
+}
+
+bool check(const std::string &name, const std::vector<unsigned char> &result,
+           const std::vector<unsigned char> &reference)
+{
+  for (size_t i = 0; i < reference.size(); i++) {
+    if (result[i] != reference[i]) {
+      std::cerr << name << ": mismatch at index " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool runTest(unsigned int height, unsigned int width)
+{
+  std::cout << "Test " << width << "x" << height << " images" << std::endl;
+  vpUniRand rng(width * height);
+  const unsigned int size = width * height;
+  const vpImageConvert::vpBayerPatternType patterns[4] = {vpImageConvert::BAYER_BGGR, vpImageConvert::BAYER_GBRG,
+                                                          vpImageConvert::BAYER_GRBG, vpImageConvert::BAYER_RGGB};
+  const std::string names[4] = {"BGGR", "GBRG", "GRBG", "RGGB"};
+
+  // 12-bit raw values, including saturated ones
+  std::vector<uint16_t> raw16(size);
+  std::vector<unsigned char> raw(size);
+  for (unsigned int i = 0; i < size; i++) {
+    raw16[i] = static_cast<uint16_t>(i % 13 == 0 ? 4095 : rng.uniform(0, 4096));
+    raw[i] = static_cast<unsigned char>(raw16[i] >> 4);
+  }
+
+  std::vector<unsigned char> rgba(4 * size), rgba_ref(4 * size);
+  for (unsigned int p = 0; p < 4; p++) {
+    const BayerImage bayer(raw, (int)width, (int)height, patterns[p]);
+
+    vpImageConvert::BayerToRGBa(&raw[0], &rgba[0], width, height, patterns[p]);
+    bilinearReference(bayer, rgba_ref);
+    if (!check("BayerToRGBa bilinear " + names[p], rgba, rgba_ref)) {
+      return false;
+    }
+    vpImageConvert::BayerToRGBa(&raw16[0], &rgba[0], width, height, patterns[p], vpImageConvert::DEMOSAIC_BILINEAR,
+                                12);
+    if (!check("BayerToRGBa 16-bit bilinear " + names[p], rgba, rgba_ref)) {
+      return false;
+    }
+
+    vpImageConvert::BayerToRGBa(&raw[0], &rgba[0], width, height, patterns[p], vpImageConvert::DEMOSAIC_EDGE_AWARE);
+    edgeAwareReference(bayer, rgba_ref);
+    if (!check("BayerToRGBa edge-aware " + names[p], rgba, rgba_ref)) {
+      return false;
+    }
+  }
+
+  std::vector<unsigned char> grey(size), grey_ref(size);
+  greyReference(BayerImage(raw, (int)width, (int)height, vpImageConvert::BAYER_RGGB), grey_ref);
+  vpImageConvert::BayerToGrey(&raw[0], &grey[0], width, height);
+  if (!check("BayerToGrey", grey, grey_ref)) {
+    return false;
+  }
+  vpImageConvert::BayerToGrey(&raw16[0], &grey[0], width, height, 12);
+  if (!check("BayerToGrey 16-bit", grey, grey_ref)) {
+    return false;
+  }
+
+  // A uniform color is reconstructed exactly by both methods
+  const unsigned char color[3] = {200, 90, 30};
+  for (unsigned int p = 0; p < 4; p++) {
+    std::vector<unsigned char> flat(size);
+    const BayerImage bayer(flat, (int)width, (int)height, patterns[p]);
+    for (unsigned int i = 0; i < height; i++) {
+      for (unsigned int j = 0; j < width; j++) {
+        flat[i * width + j] = color[bayer.channel((int)i, (int)j)];
+      }
+    }
+    for (int m = 0; m < 2; m++) {
+      vpImageConvert::BayerToRGBa(&flat[0], &rgba[0], width, height, patterns[p],
+                                  m == 0 ? vpImageConvert::DEMOSAIC_BILINEAR : vpImageConvert::DEMOSAIC_EDGE_AWARE);
+      for (unsigned int i = 0; i < size; i++) {
+        if (rgba[4 * i] != color[0] || rgba[4 * i + 1] != color[1] || rgba[4 * i + 2] != color[2]) {
+          std::cerr << "BayerToRGBa " << names[p] << ": uniform color not reconstructed at index " << i << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+} // namespace
+
+int main()
+{
+  // Odd sizes exercise the scalar borders and tails of the vectorized loops,
+  // VGA and larger images the multi-threaded conversions
+  if (!runTest(3, 3) || !runTest(7, 33) || !runTest(61, 131) || !runTest(62, 138) || !runTest(480, 640) ||
+      !runTest(721, 1283)) {
+    return EXIT_FAILURE;
+  }
+
+  try {
+    std::vector<unsigned char> raw(4), rgba(16);
+    vpImageConvert::BayerToRGBa(&raw[0], &rgba[0], 2, 2, vpImageConvert::BAYER_RGGB);
+    std::cerr << "BayerToRGBa: no exception for a 2x2 image" << std::endl;
+    return EXIT_FAILURE;
+  } catch (const vpException &) {
+  }
+
+  std::cout << "Test succeed" << std::endl;
+  return EXIT_SUCCESS;
+}
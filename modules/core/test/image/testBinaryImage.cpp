@@ -0,0 +1,196 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test vpBinaryImage and the binary morphology.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testBinaryImage.cpp
+
+  \brief Check the conversions of vpBinaryImage and compare its morphological
+  operators with a pixel by pixel implementation.
+*/
+
+#include <cstdlib>
+#include <iostream>
+
+#include <visp3/core/vpBinaryImage.h>
+#include <visp3/core/vpImageMorphology.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace
+{
+// Erode or dilate a 0 / 255 image pixel by pixel
+void morphology(vpImage<unsigned char> &I, bool isErosion, bool isSquare, int radius)
+{
+  const vpImage<unsigned char> J = I;
+  const int height = (int)I.getHeight(), width = (int)I.getWidth();
+  for (int i = 0; i < height; i++) {
+    for (int j = 0; j < width; j++) {
+      bool value = isErosion;
+      for (int di = -radius; di <= radius; di++) {
+        for (int dj = -radius; dj <= radius; dj++) {
+          if (!isSquare && di != 0 && dj != 0) {
+            continue;
+          }
+          const int y = i + di, x = j + dj;
+          const bool v = (y < 0 || x < 0 || y >= height || x >= width) ? isErosion : (J[y][x] != 0);
+          value = isErosion ? (value && v) : (value || v);
+        }
+      }
+      I[i][j] = value ? 255 : 0;
+    }
+  }
+}
+}
+
+int main()
+{
+  try {
+    vpUniRand rng(42);
+    const vpImageMorphology::vpStructuringElementType elements[2] = {vpImageMorphology::STRUCTURING_ELEMENT_CROSS,
+                                                                      vpImageMorphology::STRUCTURING_ELEMENT_SQUARE};
+
+    for (int test = 0; test < 50; test++) {
+      // Widths around and between multiples of 64
+      const unsigned int height = (unsigned int)rng.uniform(1, 30), width = (unsigned int)rng.uniform(1, 200);
+      const int density = rng.uniform(0, 100);
+      vpImage<unsigned char> I(height, width);
+      unsigned int count = 0;
+      for (unsigned int i = 0; i < I.getSize(); i++) {
+        I.bitmap[i] = rng.uniform(0, 100) < density ? (unsigned char)rng.uniform(1, 256) : 0;
+        count += I.bitmap[i] != 0;
+      }
+      const vpBinaryImage B(I);
+
+      vpImage<unsigned char> I_binary, I_converted;
+      B.convert(I_converted, 1, 0);
+      for (unsigned int i = 0; i < I.getSize(); i++) {
+        if (I_converted.bitmap[i] != (I.bitmap[i] != 0)) {
+          std::cerr << "Conversion error at index " << i << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+      if (B.getCount() != count) {
+        std::cerr << "Wrong count of pixels: " << B.getCount() << " instead of " << count << std::endl;
+        return EXIT_FAILURE;
+      }
+      B.convert(I_binary);
+
+      for (int e = 0; e < 2; e++) {
+        for (int radius = 0; radius <= 3; radius++) {
+          for (int isErosion = 0; isErosion < 2; isErosion++) {
+            vpImage<unsigned char> I_ref = I_binary;
+            morphology(I_ref, isErosion != 0, e == 1, radius);
+
+            vpBinaryImage B_morpho = B;
+            if (isErosion) {
+              vpImageMorphology::erosion(B_morpho, elements[e], (unsigned int)radius);
+            } else {
+              vpImageMorphology::dilatation(B_morpho, elements[e], (unsigned int)radius);
+            }
+            B_morpho.convert(I_converted);
+            if (I_converted != I_ref) {
+              std::cerr << (isErosion ? "Erosion" : "Dilatation") << " with a " << (e == 0 ? "cross" : "square")
+                        << " of radius " << radius << " differs on a " << width << "x" << height << " image"
+                        << std::endl;
+              return EXIT_FAILURE;
+            }
+
+            if (radius == 1) {
+              // Same result as the binary operators on unsigned char images
+              const vpImageMorphology::vpConnexityType connexity =
+                  e == 0 ? vpImageMorphology::CONNEXITY_4 : vpImageMorphology::CONNEXITY_8;
+              vpImage<unsigned char> I_morpho = I_binary;
+              if (isErosion) {
+                vpImageMorphology::erosion<unsigned char>(I_morpho, 255, 0, connexity);
+              } else {
+                vpImageMorphology::dilatation<unsigned char>(I_morpho, 255, 0, connexity);
+              }
+              if (I_morpho != I_converted) {
+                std::cerr << "Binary morphology differs from vpImageMorphology on unsigned char images" << std::endl;
+                return EXIT_FAILURE;
+              }
+            }
+          }
+
+          vpImage<unsigned char> I_ref = I_binary;
+          morphology(I_ref, true, e == 1, radius);
+          morphology(I_ref, false, e == 1, radius);
+          vpBinaryImage B_morpho = B;
+          vpImageMorphology::opening(B_morpho, elements[e], (unsigned int)radius);
+          B_morpho.convert(I_converted);
+          if (I_converted != I_ref) {
+            std::cerr << "Opening differs" << std::endl;
+            return EXIT_FAILURE;
+          }
+
+          I_ref = I_binary;
+          morphology(I_ref, false, e == 1, radius);
+          morphology(I_ref, true, e == 1, radius);
+          B_morpho = B;
+          vpImageMorphology::closing(B_morpho, elements[e], (unsigned int)radius);
+          B_morpho.convert(I_converted);
+          if (I_converted != I_ref) {
+            std::cerr << "Closing differs" << std::endl;
+            return EXIT_FAILURE;
+          }
+        }
+      }
+
+      vpBinaryImage B_inverted = B;
+      B_inverted.invert();
+      if (B_inverted.getCount() != height * width - count) {
+        std::cerr << "Wrong count of pixels of the inverted image" << std::endl;
+        return EXIT_FAILURE;
+      }
+      B_inverted.invert();
+      if (B_inverted != B) {
+        std::cerr << "Inverting twice changes the image" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    vpBinaryImage B(3, 70, true);
+    B.setValue(1, 65, false);
+    if (B.getCount() != 3 * 70 - 1 || B.getValue(1, 65) || !B.getValue(1, 64)) {
+      std::cerr << "Wrong pixel values" << std::endl;
+      return EXIT_FAILURE;
+    }
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test succeed" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,302 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test color conversions.
+ *
+ *****************************************************************************/
+/*!
+  \example testColorConversion.cpp
+
+  \brief Check the vectorized and multi-threaded color conversions of
+  vpImageConvert against the per-pixel reference code.
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace
+{
+inline unsigned char saturate(int c) { return static_cast<unsigned char>(c < 0 ? 0 : (c > 255 ? 255 : c)); }
+
+void YUYVToRGBaReference(const unsigned char *s, unsigned char *d, unsigned int width, unsigned int height)
+{
+  for (unsigned int n = 0; n < (width >> 1) * height; n++) {
+    int y1 = s[0], y2 = s[2];
+    int cb = ((s[1] - 128) * 454) >> 8;
+    int cg = ((s[1] - 128) * 88 + (s[3] - 128) * 183) >> 8;
+    int cr = ((s[3] - 128) * 359) >> 8;
+    const int y[2] = {y1, y2};
+    for (unsigned int k = 0; k < 2; k++) {
+      *d++ = saturate(y[k] + cr);
+      *d++ = saturate(y[k] - cg);
+      *d++ = saturate(y[k] + cb);
+      *d++ = vpRGBa::alpha_default;
+    }
+    s += 4;
+  }
+}
+
+void YUV420ToRGBaReference(const unsigned char *yuv, const unsigned char *iU, const unsigned char *iV,
+                           unsigned char *rgba, unsigned int width, unsigned int height)
+{
+  for (unsigned int i = 0; i < height / 2; i++) {
+    for (unsigned int j = 0; j < width / 2; j++) {
+      int U = (int)((iU[i * (width / 2) + j] - 128) * 0.354);
+      int V = (int)((iV[i * (width / 2) + j] - 128) * 0.707);
+      for (unsigned int k = 0; k < 4; k++) {
+        unsigned int row = 2 * i + k / 2, col = 2 * j + k % 2;
+        int Y = yuv[row * width + col];
+        unsigned char *d = rgba + 4 * (row * width + col);
+        d[0] = saturate(Y + 2 * V);
+        d[1] = saturate(Y - U - V);
+        d[2] = saturate(Y + 5 * U);
+        d[3] = vpRGBa::alpha_default;
+      }
+    }
+  }
+}
+
+void YCbCrToRGBaReference(const unsigned char *s, unsigned char *d, unsigned int size)
+{
+  int crr[256], cgb[256], cgr[256], cbb[256];
+  for (int index = 0; index < 256; index++) {
+    int aux = index - 128;
+    crr[index] = (int)(364.6610 * aux) >> 8;
+    cgb[index] = (int)(-89.8779 * aux) >> 8;
+    cgr[index] = (int)(-185.8154 * aux) >> 8;
+    cbb[index] = (int)(460.5724 * aux) >> 8;
+  }
+
+  for (unsigned int n = 0; n < size; n++) {
+    const unsigned char *c = s + 4 * (n / 2);
+    int y = s[2 * n];
+    *d++ = saturate(y + crr[c[3]]);
+    *d++ = saturate(y + cgb[c[1]] + cgr[c[3]]);
+    *d++ = saturate(y + cbb[c[1]]);
+    *d++ = vpRGBa::alpha_default;
+  }
+}
+
+void RGBaToHSVReference(const unsigned char *rgba, double *hue, double *saturation, double *value, unsigned int size)
+{
+  const double eps = std::numeric_limits<double>::epsilon();
+  for (unsigned int i = 0; i < size; i++) {
+    double red = rgba[4 * i] / 255.0, green = rgba[4 * i + 1] / 255.0, blue = rgba[4 * i + 2] / 255.0;
+    double max = std::max(std::max(red, green), blue);
+    double min = std::min(std::min(red, green), blue);
+    double h = 0.0, s = 0.0;
+
+    if (!vpMath::equal(max, 0.0, eps)) {
+      s = (max - min) / max;
+    }
+    if (!vpMath::equal(s, 0.0, eps)) {
+      double delta = max - min;
+      if (vpMath::equal(delta, 0.0, eps)) {
+        delta = 1.0;
+      }
+      if (vpMath::equal(red, max, eps)) {
+        h = (green - blue) / delta;
+      } else if (vpMath::equal(green, max, eps)) {
+        h = 2 + (blue - red) / delta;
+      } else {
+        h = 4 + (red - green) / delta;
+      }
+      h /= 6.0;
+      if (h < 0.0) {
+        h += 1.0;
+      } else if (h > 1.0) {
+        h -= 1.0;
+      }
+    }
+
+    hue[i] = h;
+    saturation[i] = s;
+    value[i] = max;
+  }
+}
+
+template <class T> bool check(const std::string &name, const std::vector<T> &result, const std::vector<T> &reference)
+{
+  for (size_t i = 0; i < reference.size(); i++) {
+    if (result[i] != reference[i]) {
+      std::cerr << name << ": mismatch at index " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<unsigned char> randomBuffer(vpUniRand &rng, size_t size)
+{
+  std::vector<unsigned char> buffer(size);
+  for (size_t i = 0; i < size; i++) {
+    buffer[i] = static_cast<unsigned char>(rng.uniform(0, 256));
+  }
+  return buffer;
+}
+
+bool runTest(unsigned int height, unsigned int width)
+{
+  std::cout << "Test " << width << "x" << height << " images" << std::endl;
+  vpUniRand rng(width * height);
+  const unsigned int size = width * height;
+
+  // Packed 4:2:2 formats, with a padding since YCbCrToRGBa() reads the
+  // chroma that follows an odd last pixel
+  std::vector<unsigned char> packed = randomBuffer(rng, 2 * size + 4);
+  std::vector<unsigned char> rgba(4 * size), rgba_ref(4 * size);
+
+  vpImageConvert::YUYVToRGBa(&packed[0], &rgba[0], width, height);
+  YUYVToRGBaReference(&packed[0], &rgba_ref[0], width, height);
+  if (!check("YUYVToRGBa", rgba, rgba_ref)) {
+    return false;
+  }
+
+  vpImageConvert::YCbCrToRGBa(&packed[0], &rgba[0], size);
+  YCbCrToRGBaReference(&packed[0], &rgba_ref[0], size);
+  if (!check("YCbCrToRGBa", rgba, rgba_ref)) {
+    return false;
+  }
+
+  std::vector<unsigned char> grey(size), grey_even(size), grey_odd(size);
+  for (unsigned int i = 0; i < size; i++) {
+    grey_even[i] = packed[2 * i];
+    grey_odd[i] = packed[2 * i + 1];
+  }
+  vpImageConvert::YUYVToGrey(&packed[0], &grey[0], size);
+  if (!check("YUYVToGrey", grey, grey_even)) {
+    return false;
+  }
+  vpImageConvert::YUV422ToGrey(&packed[0], &grey[0], size);
+  if (!check("YUV422ToGrey", grey, grey_odd)) {
+    return false;
+  }
+  vpImageConvert::MONO16ToGrey(&packed[0], &grey[0], size);
+  if (!check("MONO16ToGrey", grey, grey_even)) {
+    return false;
+  }
+
+  // Planar 4:2:0 formats
+  if (width % 2 == 0 && height % 2 == 0) {
+    std::vector<unsigned char> planar = randomBuffer(rng, size * 3 / 2);
+    vpImageConvert::YUV420ToRGBa(&planar[0], &rgba[0], width, height);
+    YUV420ToRGBaReference(&planar[0], &planar[size], &planar[size * 5 / 4], &rgba_ref[0], width, height);
+    if (!check("YUV420ToRGBa", rgba, rgba_ref)) {
+      return false;
+    }
+
+    vpImageConvert::YV12ToRGBa(&planar[0], &rgba[0], width, height);
+    YUV420ToRGBaReference(&planar[0], &planar[size * 5 / 4], &planar[size], &rgba_ref[0], width, height);
+    if (!check("YV12ToRGBa", rgba, rgba_ref)) {
+      return false;
+    }
+  }
+
+  // Split and merge
+  vpImage<vpRGBa> I(height, width);
+  std::vector<unsigned char> pixels = randomBuffer(rng, 4 * size);
+  std::copy(pixels.begin(), pixels.end(), reinterpret_cast<unsigned char *>(I.bitmap));
+
+  vpImage<unsigned char> R, G, B, A;
+  vpImageConvert::split(I, &R, &G, &B, &A);
+  const vpImage<unsigned char> *channels[4] = {&R, &G, &B, &A};
+  for (unsigned int c = 0; c < 4; c++) {
+    for (unsigned int i = 0; i < size; i++) {
+      if (channels[c]->bitmap[i] != pixels[4 * i + c]) {
+        std::cerr << "split: mismatch in channel " << c << " at index " << i << std::endl;
+        return false;
+      }
+    }
+  }
+
+  vpImage<vpRGBa> I_merge(height, width, vpRGBa(1, 2, 3, 4));
+  vpImageConvert::merge(&B, NULL, &R, &G, I_merge);
+  for (unsigned int i = 0; i < size; i++) {
+    if (I_merge.bitmap[i].R != I.bitmap[i].B || I_merge.bitmap[i].G != 2 || I_merge.bitmap[i].B != I.bitmap[i].R ||
+        I_merge.bitmap[i].A != I.bitmap[i].G) {
+      std::cerr << "merge: mismatch at index " << i << std::endl;
+      return false;
+    }
+  }
+  vpImageConvert::merge(&R, &G, &B, &A, I_merge);
+  if (I_merge != I) {
+    std::cerr << "merge: the merged image differs from the split one" << std::endl;
+    return false;
+  }
+
+  // HSV, with grey and saturated pixels
+  for (unsigned int i = 0; i < size; i += 7) {
+    pixels[4 * i + 1] = pixels[4 * i + 2] = pixels[4 * i];
+  }
+  for (unsigned int i = 3; i < size; i += 11) {
+    pixels[4 * i + 1] = 255;
+  }
+  std::vector<double> hue(size), saturation(size), value(size);
+  std::vector<double> hue_ref(size), saturation_ref(size), value_ref(size);
+  vpImageConvert::RGBaToHSV(&pixels[0], &hue[0], &saturation[0], &value[0], size);
+  RGBaToHSVReference(&pixels[0], &hue_ref[0], &saturation_ref[0], &value_ref[0], size);
+  if (!check("RGBaToHSV hue", hue, hue_ref) || !check("RGBaToHSV saturation", saturation, saturation_ref) ||
+      !check("RGBaToHSV value", value, value_ref)) {
+    return false;
+  }
+
+  std::vector<unsigned char> hue_uc(size), saturation_uc(size), value_uc(size), hue_uc_ref(size);
+  vpImageConvert::RGBaToHSV(&pixels[0], &hue_uc[0], &saturation_uc[0], &value_uc[0], size);
+  for (unsigned int i = 0; i < size; i++) {
+    hue_uc_ref[i] = (unsigned char)(255.0 * hue_ref[i]);
+  }
+  if (!check("RGBaToHSV unsigned char", hue_uc, hue_uc_ref)) {
+    return false;
+  }
+
+  return true;
+}
+} // namespace
+
+int main()
+{
+  // Odd sizes exercise the scalar tails of the vectorized loops, VGA and
+  // larger images the multi-threaded conversions
+  if (!runTest(2, 2) || !runTest(7, 33) || !runTest(61, 131) || !runTest(62, 138) || !runTest(480, 640) || !runTest(721, 1283)) {
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test succeed" << std::endl;
+  return EXIT_SUCCESS;
+}
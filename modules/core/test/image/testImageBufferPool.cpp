@@ -0,0 +1,179 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Test vpImageAllocator and vpImageBufferPool.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testImageBufferPool.cpp
+
+  \brief Check the alignment of the image bitmaps, the recycling of the
+  bitmaps by vpImageBufferPool and the reuse of the bitmap by the image
+  assignment.
+*/
+
+#include <cstdlib>
+#include <iostream>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpImageBufferPool.h>
+
+namespace
+{
+bool isAligned(const void *ptr) { return reinterpret_cast<size_t>(ptr) % vpImageAllocator::alignment == 0; }
+
+template <class Type> bool checkAlignment(const std::string &name)
+{
+  vpImage<Type> I(37, 41);
+  vpImage<Type> I2(I);
+  I2.resize(480, 640);
+  if (!isAligned(I.bitmap) || !isAligned(I2.bitmap)) {
+    std::cerr << "Bitmap of a vpImage<" << name << "> not aligned" << std::endl;
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+int main()
+{
+  try {
+    if (!checkAlignment<unsigned char>("unsigned char") || !checkAlignment<vpRGBa>("vpRGBa") ||
+        !checkAlignment<float>("float") || !checkAlignment<double>("double")) {
+      return EXIT_FAILURE;
+    }
+
+    // The pixels of a new color image are still initialized by vpRGBa
+    vpImage<vpRGBa> Icolor;
+    Icolor.resize(3, 5);
+    for (unsigned int i = 0; i < Icolor.getSize(); i++) {
+      if (Icolor.bitmap[i].R != 0 || Icolor.bitmap[i].G != 0 || Icolor.bitmap[i].B != 0 ||
+        Icolor.bitmap[i].A != vpRGBa::alpha_default) {
+        std::cerr << "The pixels of a new vpImage<vpRGBa> are not initialized" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // Assigning an image of the same size keeps the bitmap
+    vpImage<unsigned char> I(48, 64, 1), J(48, 64, 2);
+    unsigned char *bitmap = I.bitmap;
+    I = J;
+    if (I.bitmap != bitmap || I[47][63] != 2 || J.bitmap == I.bitmap) {
+      std::cerr << "Assignment did not reuse the bitmap" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Assigning to an image built on an external array does not modify the array
+    {
+      unsigned char array[4] = {0, 1, 2, 3};
+      vpImage<unsigned char> Iext(array, 2, 2, false);
+      Iext = vpImage<unsigned char>(2, 2, 9);
+      if (array[0] != 0 || Iext.bitmap == array || Iext[1][1] != 9) {
+        std::cerr << "Assignment modified an external array" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // Assigning an empty image
+    I = vpImage<unsigned char>();
+    if (I.bitmap != NULL || I.getSize() != 0) {
+      std::cerr << "Assignment of an empty image failed" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    vpImageBufferPool pool;
+    {
+      // Images of a processing loop recycle their bitmaps
+      vpImage<unsigned char> Iprev;
+      Iprev.setAllocator(&pool);
+      for (int frame = 0; frame < 10; frame++) {
+        vpImage<unsigned char> Iframe;
+        Iframe.setAllocator(&pool);
+        Iframe.resize(480, 640, (unsigned char)frame);
+        std::swap(Iframe, Iprev);
+        if (!isAligned(Iprev.bitmap) || Iprev[479][639] != frame) {
+          std::cerr << "Bad bitmap obtained from the pool" << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+      if (pool.getNbAllocations() != 2 || pool.getNbReuses() != 8) {
+        std::cerr << "The pool made " << pool.getNbAllocations() << " allocations and " << pool.getNbReuses()
+                  << " reuses" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    if (pool.getCachedBytes() != 2 * 480 * 640) {
+      std::cerr << "The pool keeps " << pool.getCachedBytes() << " bytes" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Moving an image to another allocator keeps its pixels
+    vpImage<float> Ifloat(10, 20, 1.5f);
+    Ifloat[9][19] = 2.5f;
+    Ifloat.setAllocator(&pool);
+    if (Ifloat.getAllocator() != &pool || Ifloat[0][0] != 1.5f || Ifloat[9][19] != 2.5f ||
+        Ifloat[9] != Ifloat.bitmap + 9 * 20) {
+      std::cerr << "The pixels have not been moved to the new allocator" << std::endl;
+      return EXIT_FAILURE;
+    }
+    Ifloat.destroy();
+
+    // The pool as the default allocator
+    vpImageAllocator::setDefault(&pool);
+    {
+      vpImage<unsigned char> I1(480, 640);
+      if (I1.getAllocator() != &pool || pool.getNbReuses() != 9) {
+        std::cerr << "The default allocator is not used" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    vpImageAllocator::setDefault(NULL);
+
+    pool.setMaxCachedBytes(480 * 640);
+    if (pool.getCachedBytes() > 480 * 640) {
+      std::cerr << "The pool keeps " << pool.getCachedBytes() << " bytes after a limit change" << std::endl;
+      return EXIT_FAILURE;
+    }
+    pool.clear();
+    if (pool.getCachedBytes() != 0) {
+      std::cerr << "The pool has not been cleared" << std::endl;
+      return EXIT_FAILURE;
+    }
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test succeed" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,195 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Test vpImagePyramid.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testImagePyramid.cpp
+
+  \brief Check the levels and the gradients of vpImagePyramid against a
+  direct computation, for odd and even image sizes and both filters.
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+#include <visp3/core/vpImagePyramid.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace
+{
+int reflect(int x, int size)
+{
+  if (size == 1) {
+    return 0;
+  }
+  while (x < 0 || x >= size) {
+    x = x < 0 ? -x : 2 * size - 2 - x;
+  }
+  return x;
+}
+
+void pyrDownReference(const vpImage<unsigned char> &src, vpImage<unsigned char> &dst,
+                      const vpImagePyramid::vpPyramidFilterType &filter)
+{
+  static const int kernel[5] = {1, 4, 6, 4, 1};
+  const int w = (int)src.getWidth(), h = (int)src.getHeight();
+  dst.resize(src.getHeight() / 2, src.getWidth() / 2);
+  for (int i = 0; i < (int)dst.getHeight(); i++) {
+    for (int j = 0; j < (int)dst.getWidth(); j++) {
+      int sum = 0;
+      if (filter == vpImagePyramid::BOX_FILTER) {
+        sum = src[2 * i][2 * j] + src[2 * i][2 * j + 1] + src[2 * i + 1][2 * j] + src[2 * i + 1][2 * j + 1];
+        dst[i][j] = (unsigned char)((sum + 2) / 4);
+      } else {
+        for (int k = 0; k < 5; k++) {
+          for (int l = 0; l < 5; l++) {
+            sum += kernel[k] * kernel[l] * src[reflect(2 * i + k - 2, h)][reflect(2 * j + l - 2, w)];
+          }
+        }
+        dst[i][j] = (unsigned char)((sum + 128) / 256);
+      }
+    }
+  }
+}
+
+bool checkGradients(const vpImage<unsigned char> &I, const vpImage<float> &dIx, const vpImage<float> &dIy)
+{
+  const int w = (int)I.getWidth(), h = (int)I.getHeight();
+  for (int i = 0; i < h; i++) {
+    for (int j = 0; j < w; j++) {
+      int v[3][3];
+      for (int k = 0; k < 3; k++) {
+        for (int l = 0; l < 3; l++) {
+          v[k][l] = I[std::min(std::max(i + k - 1, 0), h - 1)][std::min(std::max(j + l - 1, 0), w - 1)];
+        }
+      }
+      const float gx = ((v[0][2] - v[0][0]) + 2 * (v[1][2] - v[1][0]) + (v[2][2] - v[2][0])) / 8.0f;
+      const float gy = ((v[2][0] + 2 * v[2][1] + v[2][2]) - (v[0][0] + 2 * v[0][1] + v[0][2])) / 8.0f;
+      if (dIx[i][j] != gx || dIy[i][j] != gy) {
+        std::cerr << "Bad gradient (" << dIx[i][j] << ", " << dIy[i][j] << ") instead of (" << gx << ", " << gy
+                  << ") at (" << i << ", " << j << ") of a " << w << "x" << h << " level" << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool checkPyramid(const vpImage<unsigned char> &I, unsigned int nbLevels,
+                  const vpImagePyramid::vpPyramidFilterType &filter)
+{
+  vpImagePyramid pyramid(I, nbLevels, filter, true);
+  vpImagePyramid pyramidSequential;
+  pyramidSequential.build(I, nbLevels, filter, true, 1);
+
+  vpImage<unsigned char> ref = I, next;
+  for (unsigned int l = 0; l < pyramid.getNbLevels(); l++) {
+    if (l > 0) {
+      pyrDownReference(ref, next, filter);
+      ref = next;
+    }
+    const std::string name = filter == vpImagePyramid::BOX_FILTER ? "box" : "gaussian";
+    if (ref != pyramid[l]) {
+      std::cerr << "Bad " << name << " level " << l << " of a " << I.getWidth() << "x" << I.getHeight() << " image"
+                << std::endl;
+      return false;
+    }
+    if (ref != pyramidSequential.getLevel(l)) {
+      std::cerr << "Bad " << name << " level " << l << " computed with one thread" << std::endl;
+      return false;
+    }
+    if (!checkGradients(ref, pyramid.getGradientU(l), pyramid.getGradientV(l))) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int main()
+{
+  try {
+    vpUniRand rng(42);
+    const unsigned int sizes[][2] = {{480, 640}, {101, 67}, {33, 130}, {5, 7}, {2, 3}, {1, 1}};
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+      vpImage<unsigned char> I(sizes[s][0], sizes[s][1]);
+      for (unsigned int i = 0; i < I.getSize(); i++) {
+        I.bitmap[i] = (unsigned char)rng.uniform(0, 256);
+      }
+      if (!checkPyramid(I, 5, vpImagePyramid::GAUSSIAN_FILTER) || !checkPyramid(I, 5, vpImagePyramid::BOX_FILTER)) {
+        return EXIT_FAILURE;
+      }
+    }
+
+    // The number of levels is limited by the image size
+    vpImage<unsigned char> I(20, 35, 128);
+    vpImagePyramid pyramid(I, 10);
+    if (pyramid.getNbLevels() != 5 || pyramid.getLevel(4).getWidth() != 2 || pyramid.getLevel(4).getHeight() != 1) {
+      std::cerr << "Bad number of levels: " << pyramid.getNbLevels() << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // The levels of a second build with the same size reuse their memory
+    const unsigned char *bitmap = pyramid.getLevel(2).bitmap;
+    pyramid.build(I, 3, vpImagePyramid::BOX_FILTER);
+    if (pyramid.getNbLevels() != 3 || pyramid.getLevel(2).bitmap != bitmap || pyramid.hasGradients()) {
+      std::cerr << "The pyramid levels have been reallocated" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    bool thrown = false;
+    try {
+      pyramid.getGradientU(0);
+    } catch (const vpException &) {
+      thrown = true;
+    }
+    try {
+      pyramid.getLevel(3);
+      thrown = false;
+    } catch (const vpException &) {
+    }
+    if (!thrown) {
+      std::cerr << "Missing exception for a bad level or missing gradients" << std::endl;
+      return EXIT_FAILURE;
+    }
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test succeed" << std::endl;
+  return EXIT_SUCCESS;
+}
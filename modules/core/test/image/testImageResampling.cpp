@@ -0,0 +1,323 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Test the separable resize and the span-based warps.
+ *
+ *****************************************************************************/
+/*!
+  \example testImageResampling.cpp
+
+  \brief Check the separable resize and the span-based warps of unsigned char,
+  vpRGBa and float images against per-pixel reference implementations.
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <visp3/core/vpImageTools.h>
+
+namespace
+{
+void fillImage(vpImage<unsigned char> &I)
+{
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      I[i][j] = (unsigned char)(127.5 + 60 * std::sin(j / 5.0) + 60 * std::cos(i / 7.0 + j / 11.0));
+    }
+  }
+}
+
+template <class Type> void toDouble(const vpImage<Type> &I, vpImage<double> &D)
+{
+  D.resize(I.getHeight(), I.getWidth());
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    D.bitmap[i] = I.bitmap[i];
+  }
+}
+
+void channel(const vpImage<vpRGBa> &I, unsigned int c, vpImage<unsigned char> &C)
+{
+  C.resize(I.getHeight(), I.getWidth());
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    C.bitmap[i] = reinterpret_cast<const unsigned char *>(&I.bitmap[i])[c];
+  }
+}
+
+double pixelClamped(const vpImage<double> &I, int u, int v)
+{
+  u = std::max(0, std::min(u, static_cast<int>(I.getWidth()) - 1));
+  v = std::max(0, std::min(v, static_cast<int>(I.getHeight()) - 1));
+  return I[v][u];
+}
+
+double cubic(double A, double B, double C, double D, double t)
+{
+  return B + 0.5 * t * (C - A + t * (2 * A - 5 * B + 4 * C - D + t * (3 * (B - C) + D - A)));
+}
+
+// Per-pixel nearest, bilinear and bicubic interpolations with the mapping of the generic resize
+void resizeReference(const vpImage<double> &I, vpImage<double> &Ires, vpImageTools::vpImageInterpolationType method)
+{
+  const bool nearest = method == vpImageTools::INTERPOLATION_NEAREST;
+  const float sx = (I.getWidth() - (nearest ? 0 : 1)) / static_cast<float>(Ires.getWidth() - 1);
+  const float sy = (I.getHeight() - (nearest ? 0 : 1)) / static_cast<float>(Ires.getHeight() - 1);
+  for (unsigned int i = 0; i < Ires.getHeight(); i++) {
+    const float v = i * sy;
+    const int v0 = static_cast<int>(v);
+    for (unsigned int j = 0; j < Ires.getWidth(); j++) {
+      const float u = j * sx;
+      const int u0 = static_cast<int>(u);
+      const double s = u - u0, t = v - v0;
+      if (nearest) {
+        Ires[i][j] = pixelClamped(I, u0, v0);
+      } else if (method == vpImageTools::INTERPOLATION_LINEAR) {
+        const double top = (1 - s) * pixelClamped(I, u0, v0) + s * pixelClamped(I, u0 + 1, v0);
+        const double bottom = (1 - s) * pixelClamped(I, u0, v0 + 1) + s * pixelClamped(I, u0 + 1, v0 + 1);
+        Ires[i][j] = (1 - t) * top + t * bottom;
+      } else {
+        double col[4];
+        for (int k = 0; k < 4; k++) {
+          col[k] = cubic(pixelClamped(I, u0 - 1, v0 - 1 + k), pixelClamped(I, u0, v0 - 1 + k),
+                         pixelClamped(I, u0 + 1, v0 - 1 + k), pixelClamped(I, u0 + 2, v0 - 1 + k), s);
+        }
+        Ires[i][j] = cubic(col[0], col[1], col[2], col[3], t);
+      }
+    }
+  }
+}
+
+// Mean of the source pixels covered by each destination pixel
+void areaReference(const vpImage<double> &I, vpImage<double> &Ires)
+{
+  const double sx = I.getWidth() / static_cast<double>(Ires.getWidth());
+  const double sy = I.getHeight() / static_cast<double>(Ires.getHeight());
+  for (unsigned int i = 0; i < Ires.getHeight(); i++) {
+    for (unsigned int j = 0; j < Ires.getWidth(); j++) {
+      double sum = 0;
+      for (unsigned int v = 0; v < I.getHeight(); v++) {
+        double wy = std::min((i + 1) * sy, v + 1.0) - std::max(i * sy, static_cast<double>(v));
+        for (unsigned int u = 0; wy > 0 && u < I.getWidth(); u++) {
+          double wx = std::min((j + 1) * sx, u + 1.0) - std::max(j * sx, static_cast<double>(u));
+          if (wx > 0) {
+            sum += wx * wy * I[v][u];
+          }
+        }
+      }
+      Ires[i][j] = sum / (sx * sy);
+    }
+  }
+}
+
+bool checkResize(const vpImage<unsigned char> &I, unsigned int width, unsigned int height,
+                 vpImageTools::vpImageInterpolationType method)
+{
+  vpImage<double> D, Dres(height, width);
+  toDouble(I, D);
+  if (method == vpImageTools::INTERPOLATION_AREA) {
+    areaReference(D, Dres);
+  } else {
+    resizeReference(D, Dres, method);
+  }
+
+  vpImage<unsigned char> Ires(height, width), Ires_seq(height, width);
+  vpImageTools::resize(I, Ires, method);
+  vpImageTools::resize(I, Ires_seq, method, 1);
+  if (Ires != Ires_seq) {
+    std::cerr << "Resize " << method << ": multi-threaded and sequential results differ" << std::endl;
+    return false;
+  }
+
+  vpImage<float> F(I.getHeight(), I.getWidth()), Fres(height, width);
+  vpImage<vpRGBa> C(I.getHeight(), I.getWidth()), Cres(height, width);
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    F.bitmap[i] = I.bitmap[i];
+    C.bitmap[i] = vpRGBa(I.bitmap[i], (unsigned char)(255 - I.bitmap[i]), I.bitmap[i], 255);
+  }
+  vpImageTools::resize(F, Fres, method);
+  vpImageTools::resize(C, Cres, method);
+
+  // Rounding of the float sums may differ from the double reference by one
+  const double tolerance = method == vpImageTools::INTERPOLATION_NEAREST ? 0.0 : 1.0;
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      const double ref = std::min(255.0, std::max(0.0, Dres[i][j]));
+      const vpRGBa &c = Cres[i][j];
+      if (std::fabs(Ires[i][j] - ref) > tolerance || std::fabs(Fres[i][j] - Dres[i][j]) > 1e-3 ||
+          std::fabs(c.R - ref) > tolerance || std::fabs(c.G - (255 - ref)) > tolerance || c.B != Ires[i][j] ||
+          c.A != 255) {
+        std::cerr << "Resize " << method << " to " << width << "x" << height << ": bad value at (" << j << ", " << i
+                  << "): " << (int)Ires[i][j] << " / " << Fres[i][j] << " instead of " << Dres[i][j] << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Number of pixels that differ by more than one grey level
+template <class Type> unsigned int countDifferences(const vpImage<Type> &I1, const vpImage<Type> &I2)
+{
+  unsigned int nb = 0;
+  for (unsigned int i = 0; i < I1.getSize(); i++) {
+    nb += std::fabs(static_cast<double>(I1.bitmap[i]) - static_cast<double>(I2.bitmap[i])) > 1.0 ? 1 : 0;
+  }
+  return nb;
+}
+
+bool checkWarp(const std::string &name, const vpImage<unsigned char> &I, const vpMatrix &M)
+{
+  vpImage<float> F(I.getHeight(), I.getWidth());
+  vpImage<vpRGBa> C(I.getHeight(), I.getWidth());
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    F.bitmap[i] = I.bitmap[i];
+    C.bitmap[i] = vpRGBa(I.bitmap[i], (unsigned char)(255 - I.bitmap[i]), (unsigned char)(I.bitmap[i] / 2), 255);
+  }
+
+  for (int m = 0; m < 2; m++) {
+    vpImageTools::vpImageInterpolationType method =
+        m == 0 ? vpImageTools::INTERPOLATION_NEAREST : vpImageTools::INTERPOLATION_LINEAR;
+    for (int center = 0; center < 2; center++) {
+      vpImage<unsigned char> Iref, Iwarp;
+      vpImageTools::warpImage(I, M, Iref, method, false, center == 1);
+      vpImageTools::warpImage(I, M, Iwarp, method, true, center == 1);
+
+      vpImage<float> Fref, Fwarp;
+      vpImageTools::warpImage(F, M, Fref, method, false, center == 1);
+      vpImageTools::warpImage(F, M, Fwarp, method, true, center == 1);
+
+      vpImage<vpRGBa> Cref, Cwarp;
+      vpImageTools::warpImage(C, M, Cref, method, false, center == 1);
+      vpImageTools::warpImage(C, M, Cwarp, method, true, center == 1);
+      unsigned int nbColor = 0;
+      for (unsigned int c = 0; c < 3; c++) {
+        vpImage<unsigned char> Cref_c, Cwarp_c;
+        channel(Cref, c, Cref_c);
+        channel(Cwarp, c, Cwarp_c);
+        nbColor = std::max(nbColor, countDifferences(Cref_c, Cwarp_c));
+      }
+
+      // Only a few pixels at the border of the warped area may differ
+      const unsigned int nbMax = I.getSize() / 1000;
+      const unsigned int nbGrey = countDifferences(Iref, Iwarp), nbFloat = countDifferences(Fref, Fwarp);
+      if (nbGrey > nbMax || nbFloat > nbMax || nbColor > nbMax) {
+        std::cerr << name << " warp, method " << method << ", pixel center " << center << ": " << nbGrey << " grey, "
+                  << nbFloat << " float and " << nbColor << " color pixels differ from the reference" << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+} // namespace
+
+int main()
+{
+  try {
+    vpImage<unsigned char> I(83, 97);
+    fillImage(I);
+
+    // Upscaling, downscaling and sizes that do not fill the SSE2 registers
+    const unsigned int sizes[4][2] = {{211, 173}, {48, 41}, {31, 19}, {97, 83}};
+    for (int m = 0; m < 4; m++) {
+      for (int s = 0; s < 4; s++) {
+        if (!checkResize(I, sizes[s][0], sizes[s][1], static_cast<vpImageTools::vpImageInterpolationType>(m))) {
+          return EXIT_FAILURE;
+        }
+      }
+    }
+
+    // Large enough image to be split in several bands of rows
+    vpImage<unsigned char> I_large(480, 640);
+    fillImage(I_large);
+    if (!checkResize(I_large, 320, 240, vpImageTools::INTERPOLATION_AREA) ||
+        !checkResize(I_large, 1000, 700, vpImageTools::INTERPOLATION_LINEAR)) {
+      return EXIT_FAILURE;
+    }
+
+    // Downscaling by an integer factor is an exact box filter
+    vpImage<unsigned char> I_half;
+    vpImageTools::resize(I_large, I_half, 320, 240, vpImageTools::INTERPOLATION_AREA);
+    for (unsigned int i = 0; i < I_half.getHeight(); i++) {
+      for (unsigned int j = 0; j < I_half.getWidth(); j++) {
+        const int sum = I_large[2 * i][2 * j] + I_large[2 * i][2 * j + 1] + I_large[2 * i + 1][2 * j] +
+                        I_large[2 * i + 1][2 * j + 1];
+        if (I_half[i][j] != (sum + 2) / 4) {
+          std::cerr << "Bad 2x2 mean at (" << j << ", " << i << ")" << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+
+    vpMatrix affine(2, 3);
+    const double theta = vpMath::rad(25);
+    affine[0][0] = 0.9 * cos(theta);
+    affine[0][1] = -0.9 * sin(theta);
+    affine[0][2] = 60;
+    affine[1][0] = 0.9 * sin(theta);
+    affine[1][1] = 0.9 * cos(theta);
+    affine[1][2] = -40;
+
+    vpMatrix perspective(3, 3);
+    perspective[0][0] = 0.8;
+    perspective[0][1] = 0.1;
+    perspective[0][2] = 30;
+    perspective[1][0] = -0.05;
+    perspective[1][1] = 0.9;
+    perspective[1][2] = 20;
+    perspective[2][0] = 5e-4;
+    perspective[2][1] = -3e-4;
+    perspective[2][2] = 1;
+
+    if (!checkWarp("Affine", I_large, affine) || !checkWarp("Perspective", I_large, perspective)) {
+      return EXIT_FAILURE;
+    }
+
+    vpMatrix identity(2, 3);
+    identity[0][0] = identity[1][1] = 1;
+    for (int m = 0; m < 2; m++) {
+      vpImage<unsigned char> I_identity;
+      vpImageTools::warpImage(I, identity, I_identity, static_cast<vpImageTools::vpImageInterpolationType>(m));
+      if (I_identity != I) {
+        std::cerr << "The identity warp changes the image" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test succeed" << std::endl;
+  return EXIT_SUCCESS;
+}
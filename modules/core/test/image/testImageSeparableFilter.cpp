@@ -0,0 +1,240 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test separable image filtering.
+ *
+ *****************************************************************************/
+/*!
+  \example testImageSeparableFilter.cpp
+
+  \brief Check the separable filters of vpImageFilter against the per-pixel
+  inline functions, and the float and fixed-point variants against the
+  double-precision one.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpThreadPool.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace
+{
+// Reference horizontal filtering computed pixel by pixel
+template <class T>
+void filterXReference(const vpImage<T> &I, vpImage<double> &dIx, const double *filter, unsigned int size)
+{
+  unsigned int half = (size - 1) / 2;
+  dIx.resize(I.getHeight(), I.getWidth());
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < half; j++) {
+      dIx[i][j] = vpImageFilter::filterXLeftBorder(I, i, j, filter, size);
+    }
+    for (unsigned int j = half; j < I.getWidth() - half; j++) {
+      dIx[i][j] = vpImageFilter::filterX(I, i, j, filter, size);
+    }
+    for (unsigned int j = I.getWidth() - half; j < I.getWidth(); j++) {
+      dIx[i][j] = vpImageFilter::filterXRightBorder(I, i, j, filter, size);
+    }
+  }
+}
+
+// Reference vertical filtering computed pixel by pixel
+template <class T>
+void filterYReference(const vpImage<T> &I, vpImage<double> &dIy, const double *filter, unsigned int size)
+{
+  unsigned int half = (size - 1) / 2;
+  dIy.resize(I.getHeight(), I.getWidth());
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      if (i < half) {
+        dIy[i][j] = vpImageFilter::filterYTopBorder(I, i, j, filter, size);
+      } else if (i >= I.getHeight() - half) {
+        dIy[i][j] = vpImageFilter::filterYBottomBorder(I, i, j, filter, size);
+      } else {
+        dIy[i][j] = vpImageFilter::filterY(I, i, j, filter, size);
+      }
+    }
+  }
+}
+
+// Reference derivative filtering computed pixel by pixel, borders are null
+template <class T>
+void getGradReference(const vpImage<T> &I, vpImage<double> &dIx, vpImage<double> &dIy, const double *filter,
+                      unsigned int size)
+{
+  unsigned int half = (size - 1) / 2;
+  dIx.resize(I.getHeight(), I.getWidth(), 0);
+  dIy.resize(I.getHeight(), I.getWidth(), 0);
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      if (j >= half && j < I.getWidth() - half) {
+        dIx[i][j] = vpImageFilter::derivativeFilterX(I, i, j, filter, size);
+      }
+      if (i >= half && i < I.getHeight() - half) {
+        dIy[i][j] = vpImageFilter::derivativeFilterY(I, i, j, filter, size);
+      }
+    }
+  }
+}
+
+template <class T1, class T2> double maxDifference(const vpImage<T1> &I1, const vpImage<T2> &I2)
+{
+  if (I1.getHeight() != I2.getHeight() || I1.getWidth() != I2.getWidth()) {
+    return std::numeric_limits<double>::max();
+  }
+  double diff = 0;
+  for (unsigned int i = 0; i < I1.getSize(); i++) {
+    diff = std::max(diff, std::fabs(static_cast<double>(I1.bitmap[i]) - static_cast<double>(I2.bitmap[i])));
+  }
+  return diff;
+}
+
+bool check(const std::string &name, double diff, double threshold)
+{
+  std::cout << name << ": max difference " << diff << std::endl;
+  if (diff > threshold) {
+    std::cerr << "Test " << name << " failed, max difference " << diff << " > " << threshold << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool runTest(unsigned int height, unsigned int width, unsigned int size)
+{
+  std::cout << "Image " << width << "x" << height << ", filter size " << size << std::endl;
+  vpUniRand rng;
+  vpImage<unsigned char> I(height, width);
+  vpImage<double> I_double(height, width);
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = static_cast<unsigned char>(rng.uniform(0, 256));
+    I_double.bitmap[i] = rng.uniform(-100.0, 100.0);
+  }
+
+  std::vector<double> fg((size + 1) / 2), fd((size + 1) / 2);
+  vpImageFilter::getGaussianKernel(&fg[0], size);
+  vpImageFilter::getGaussianDerivativeKernel(&fd[0], size);
+
+  // Results have to be bitwise identical
+  vpImage<double> I_ref, I_res, I_ref2, I_res2;
+  filterXReference(I, I_ref, &fg[0], size);
+  vpImageFilter::filterX(I, I_res, &fg[0], size);
+  bool success = check("filterX<unsigned char>", maxDifference(I_ref, I_res), 0);
+
+  filterXReference(I_double, I_ref, &fg[0], size);
+  vpImageFilter::filterX(I_double, I_res, &fg[0], size);
+  success = check("filterX<double>", maxDifference(I_ref, I_res), 0) && success;
+
+  filterYReference(I, I_ref, &fg[0], size);
+  vpImageFilter::filterY(I, I_res, &fg[0], size);
+  success = check("filterY<unsigned char>", maxDifference(I_ref, I_res), 0) && success;
+
+  filterYReference(I_double, I_ref, &fg[0], size);
+  vpImageFilter::filterY(I_double, I_res, &fg[0], size);
+  success = check("filterY<double>", maxDifference(I_ref, I_res), 0) && success;
+
+  getGradReference(I, I_ref, I_ref2, &fd[0], size);
+  vpImageFilter::getGradX(I, I_res, &fd[0], size);
+  vpImageFilter::getGradY(I, I_res2, &fd[0], size);
+  success = check("getGradX<unsigned char>", maxDifference(I_ref, I_res), 0) && success;
+  success = check("getGradY<unsigned char>", maxDifference(I_ref2, I_res2), 0) && success;
+
+  getGradReference(I_double, I_ref, I_ref2, &fd[0], size);
+  vpImageFilter::getGradX(I_double, I_res, &fd[0], size);
+  vpImageFilter::getGradY(I_double, I_res2, &fd[0], size);
+  success = check("getGradX<double>", maxDifference(I_ref, I_res), 0) && success;
+  success = check("getGradY<double>", maxDifference(I_ref2, I_res2), 0) && success;
+
+  // Float and fixed-point Gaussian blur against the double-precision one
+  vpImage<double> I_blur;
+  vpImage<float> I_blur_float;
+  vpImage<unsigned char> I_blur_uchar;
+  vpImageFilter::gaussianBlur(I, I_blur, size);
+  vpImageFilter::gaussianBlur(I, I_blur_float, size);
+  vpImageFilter::gaussianBlur(I, I_blur_uchar, size);
+  success = check("gaussianBlur<float>", maxDifference(I_blur, I_blur_float), 1e-3) && success;
+  success = check("gaussianBlur<unsigned char>", maxDifference(I_blur, I_blur_uchar), 0.6) && success;
+
+  return success;
+}
+} // namespace
+
+int main()
+{
+  // Odd widths exercise the scalar tails of the vectorized loops, large
+  // images are split in bands over the threads of the pool
+  unsigned int nbThreads[] = {1, 4};
+  for (unsigned int i = 0; i < 2; i++) {
+    std::cout << "Thread pool with " << nbThreads[i] << " threads" << std::endl;
+    vpThreadPool::instance().setNumThreads(nbThreads[i]);
+    if (!runTest(240, 320, 7) || !runTest(97, 131, 3) || !runTest(61, 2051, 11) || !runTest(480, 640, 5)) {
+      return EXIT_FAILURE;
+    }
+  }
+
+  vpUniRand rng;
+  vpImage<unsigned char> I(480, 640);
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = static_cast<unsigned char>(rng.uniform(0, 256));
+  }
+  vpImage<double> I_blur;
+  vpImage<float> I_blur_float;
+  vpImage<unsigned char> I_blur_uchar;
+  const unsigned int nbIter = 20;
+
+  double t = vpTime::measureTimeMs();
+  for (unsigned int cpt = 0; cpt < nbIter; cpt++) {
+    vpImageFilter::gaussianBlur(I, I_blur, 7);
+  }
+  std::cout << "gaussianBlur<double>: " << (vpTime::measureTimeMs() - t) / nbIter << " ms" << std::endl;
+
+  t = vpTime::measureTimeMs();
+  for (unsigned int cpt = 0; cpt < nbIter; cpt++) {
+    vpImageFilter::gaussianBlur(I, I_blur_float, 7);
+  }
+  std::cout << "gaussianBlur<float>: " << (vpTime::measureTimeMs() - t) / nbIter << " ms" << std::endl;
+
+  t = vpTime::measureTimeMs();
+  for (unsigned int cpt = 0; cpt < nbIter; cpt++) {
+    vpImageFilter::gaussianBlur(I, I_blur_uchar, 7);
+  }
+  std::cout << "gaussianBlur<unsigned char>: " << (vpTime::measureTimeMs() - t) / nbIter << " ms" << std::endl;
+
+  std::cout << "Test succeed" << std::endl;
+  return EXIT_SUCCESS;
+}
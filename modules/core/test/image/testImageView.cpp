@@ -0,0 +1,217 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Test vpImageView.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testImageView.cpp
+
+  \brief Check that the functions accepting a vpImageView give on a region of
+  interest the same result as on a cropped copy of this region.
+*/
+
+#include <cstdlib>
+#include <iostream>
+
+#include <visp3/core/vpHistogram.h>
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpImageView.h>
+#include <visp3/core/vpTemplateMatcher.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace
+{
+template <class Type> bool equal(vpImage<Type> &I1, const vpImage<Type> &I2, const std::string &name)
+{
+  if (I1 != I2) {
+    std::cerr << name << ": the result on the view differs from the result on the cropped image" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int main()
+{
+  try {
+    vpUniRand rng(42);
+    vpImage<unsigned char> I(120, 161);
+    vpImage<vpRGBa> I_color(I.getHeight(), I.getWidth());
+    vpImage<float> I_float(I.getHeight(), I.getWidth());
+    for (unsigned int i = 0; i < I.getSize(); i++) {
+      I.bitmap[i] = (unsigned char)rng.uniform(0, 256);
+      I_color.bitmap[i] = vpRGBa((unsigned char)rng.uniform(0, 256), (unsigned char)rng.uniform(0, 256),
+                                 (unsigned char)rng.uniform(0, 256), (unsigned char)rng.uniform(0, 256));
+      I_float.bitmap[i] = (float)rng.uniform(0.0, 1.0);
+    }
+
+    const vpRect roi(17, 9, 101, 77);
+    vpImageView<unsigned char> view(I, roi);
+    vpImage<unsigned char> I_crop;
+    vpImageTools::crop(I, roi, I_crop);
+    if (view.getWidth() != 101 || view.getHeight() != 77 || view.getStride() != I.getWidth() ||
+        view.isContinuous() || view[0] != &I[9][17]) {
+      std::cerr << "Bad view geometry" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    vpImage<unsigned char> I_copy;
+    vpImageTools::crop(view, I_copy);
+    if (!equal(I_copy, I_crop, "crop")) {
+      return EXIT_FAILURE;
+    }
+
+    // Sub-view and view of a raw buffer
+    vpImageView<unsigned char> sub = view.getView(3, 5, 20, 30);
+    vpImageView<unsigned char> raw(I.bitmap + 12 * I.getWidth() + 22, 20, 30, I.getWidth());
+    vpImage<unsigned char> I_sub, I_raw;
+    sub.copyTo(I_sub);
+    raw.copyTo(I_raw);
+    if (!equal(I_sub, I_raw, "getView")) {
+      return EXIT_FAILURE;
+    }
+
+    // Filters
+    vpImage<double> G_view, G_crop;
+    vpImageFilter::gaussianBlur(view, G_view, 7);
+    vpImageFilter::gaussianBlur(I_crop, G_crop, 7);
+    if (!equal(G_view, G_crop, "gaussianBlur double")) {
+      return EXIT_FAILURE;
+    }
+    vpImage<float> F_view, F_crop;
+    vpImageFilter::gaussianBlur(view, F_view, 5);
+    vpImageFilter::gaussianBlur(I_crop, F_crop, 5);
+    if (!equal(F_view, F_crop, "gaussianBlur float")) {
+      return EXIT_FAILURE;
+    }
+    vpImage<unsigned char> B_view, B_crop;
+    vpImageFilter::gaussianBlur(view, B_view, 9);
+    vpImageFilter::gaussianBlur(I_crop, B_crop, 9);
+    if (!equal(B_view, B_crop, "gaussianBlur unsigned char")) {
+      return EXIT_FAILURE;
+    }
+    const double grad[3] = {0., 0.5, 0.};
+    vpImageFilter::getGradX(view, G_view, grad, 3);
+    vpImageFilter::getGradX(I_crop, G_crop, grad, 3);
+    if (!equal(G_view, G_crop, "getGradX")) {
+      return EXIT_FAILURE;
+    }
+    vpImageFilter::getGradY(view, G_view, grad, 3);
+    vpImageFilter::getGradY(I_crop, G_crop, grad, 3);
+    if (!equal(G_view, G_crop, "getGradY")) {
+      return EXIT_FAILURE;
+    }
+
+    // Conversion
+    vpImage<vpRGBa> I_color_crop;
+    vpImageTools::crop(I_color, roi, I_color_crop);
+    vpImage<unsigned char> C_view, C_crop;
+    vpImageConvert::convert(vpImageView<vpRGBa>(I_color, roi), C_view);
+    vpImageConvert::convert(I_color_crop, C_crop);
+    if (!equal(C_view, C_crop, "convert")) {
+      return EXIT_FAILURE;
+    }
+
+    // Resize
+    const vpImageTools::vpImageInterpolationType methods[4] = {
+        vpImageTools::INTERPOLATION_NEAREST, vpImageTools::INTERPOLATION_LINEAR, vpImageTools::INTERPOLATION_CUBIC,
+        vpImageTools::INTERPOLATION_AREA};
+    vpImage<float> I_float_crop;
+    vpImageTools::crop(I_float, roi, I_float_crop);
+    for (int m = 0; m < 4; m++) {
+      vpImage<unsigned char> R_view(40, 53), R_crop(40, 53);
+      vpImageTools::resize(view, R_view, methods[m]);
+      vpImageTools::resize(I_crop, R_crop, methods[m]);
+      vpImage<vpRGBa> RC_view(130, 170), RC_crop(130, 170);
+      vpImageTools::resize(vpImageView<vpRGBa>(I_color, roi), RC_view, methods[m]);
+      vpImageTools::resize(I_color_crop, RC_crop, methods[m]);
+      vpImage<float> RF_view(40, 53), RF_crop(40, 53);
+      vpImageTools::resize(vpImageView<float>(I_float, roi), RF_view, methods[m]);
+      vpImageTools::resize(I_float_crop, RF_crop, methods[m]);
+      if (!equal(R_view, R_crop, "resize unsigned char") || !equal(RC_view, RC_crop, "resize vpRGBa") ||
+          !equal(RF_view, RF_crop, "resize float")) {
+        return EXIT_FAILURE;
+      }
+    }
+
+    // Histogram
+    vpHistogram h_view, h_crop;
+    h_view.calculate(view, 64);
+    h_crop.calculate(I_crop, 64);
+    for (unsigned int k = 0; k < 64; k++) {
+      if (h_view[k] != h_crop[k]) {
+        std::cerr << "calculate: bin " << k << " differs" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // Template matching
+    vpTemplateMatcher matcher_view, matcher_crop;
+    matcher_view.setImage(view);
+    matcher_crop.setImage(I_crop);
+    std::vector<vpTemplateMatcher::vpMatch> matches_view, matches_crop;
+    matcher_view.match(sub, matches_view);
+    matcher_crop.match(I_sub, matches_crop);
+    if (matches_view.size() != 1 || matches_crop.size() != 1 || matches_view[0].i != matches_crop[0].i ||
+        matches_view[0].j != matches_crop[0].j || matches_view[0].i != 3 || matches_view[0].j != 5) {
+      std::cerr << "match: the template is not found at the same position" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Rectangles outside the image or the view
+    bool thrown = false;
+    try {
+      vpImageView<unsigned char> outside(I, 100, 0, 21, 10);
+    } catch (const vpException &) {
+      thrown = true;
+    }
+    try {
+      view.getView(0, 100, 1, 2);
+      thrown = false;
+    } catch (const vpException &) {
+    }
+    if (!thrown || vpImageView<unsigned char>(I, vpRect(200, 0, 10, 10)).getSize() != 0) {
+      std::cerr << "Missing exception or non empty view for a rectangle outside the image" << std::endl;
+      return EXIT_FAILURE;
+    }
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test succeed" << std::endl;
+  return EXIT_SUCCESS;
+}
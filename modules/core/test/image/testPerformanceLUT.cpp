@@ -38,7 +38,9 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <visp3/core/vpHistogram.h>
 #include <visp3/core/vpImage.h>
+#include <visp3/core/vpImageConvert.h>
 #include <visp3/core/vpIoTools.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/io/vpImageIo.h>
@@ -220,6 +222,72 @@ void iterate_method2(vpImage<vpRGBa> &I, const double alpha, const double beta)
   }
 }
 
+/*!
+  Look-up table stretching the intensities of a channel, given by its
+  histogram, to [0 - 255].
+
+  \param hist : Histogram of the channel.
+  \param lut : Look-up table.
+*/
+void stretchingLut(const vpHistogram &hist, unsigned char (&lut)[256])
+{
+  unsigned int min = 0, max = 255;
+  while (min < 255 && hist[(unsigned char)min] == 0) {
+    min++;
+  }
+  while (max > min && hist[(unsigned char)max] == 0) {
+    max--;
+  }
+  for (unsigned int x = 0; x < 256; x++) {
+    lut[x] = (unsigned char)(max > min && x >= min && x <= max ? 255 * (x - min) / (max - min) : x);
+  }
+}
+
+/*!
+  Stretch the contrast of each channel of a color image like it was done
+  before the fused histogram and look-up table path: the image is split into
+  planes, each plane is scanned to compute its histogram, then its look-up
+  table is applied and the planes are merged.
+
+  \param I : Input color image.
+*/
+void stretchContrastPlanes(vpImage<vpRGBa> &I)
+{
+  vpImage<unsigned char> planes[4];
+  vpImageConvert::split(I, &planes[0], &planes[1], &planes[2], &planes[3]);
+  for (unsigned int c = 0; c < 4; c++) {
+    vpHistogram hist;
+    hist.calculate(planes[c]);
+    unsigned char lut[256];
+    stretchingLut(hist, lut);
+    planes[c].performLut(lut);
+  }
+  vpImageConvert::merge(&planes[0], &planes[1], &planes[2], &planes[3], I);
+}
+
+/*!
+  Stretch the contrast of each channel of a color image with the fused path:
+  one pass computes the four histograms on the threads of vpThreadPool, a
+  second one applies the look-up table.
+
+  \param I : Input color image.
+  \param nbThreads : Maximum number of threads.
+*/
+void stretchContrastFused(vpImage<vpRGBa> &I, unsigned int nbThreads)
+{
+  vpHistogram hist[4];
+  vpHistogram::calculate(I, hist[0], hist[1], hist[2], hist[3], 256, nbThreads);
+  unsigned char lutChannels[4][256];
+  for (unsigned int c = 0; c < 4; c++) {
+    stretchingLut(hist[c], lutChannels[c]);
+  }
+  vpRGBa lut[256];
+  for (unsigned int x = 0; x < 256; x++) {
+    lut[x] = vpRGBa(lutChannels[0][x], lutChannels[1][x], lutChannels[2][x], lutChannels[3][x]);
+  }
+  I.performLut(lut, nbThreads);
+}
+
 int main(int argc, const char **argv)
 {
   try {
@@ -505,6 +573,67 @@ int main(int argc, const char **argv)
     std::cout << "\nt_lut_singlethread/t_lut_multithread (grayscale)=" << t_lut_singlethread / t_lut_multithread << "X"
               << std::endl;
 
+    // Histogram, look-up table and application: planes against the fused path
+    vpImage<vpRGBa> I_planes, I_fused;
+    filename = vpIoTools::createFilePath(ipath, "Klimt/Klimt.ppm");
+    vpImageIo::read(I_planes, filename);
+    // Reduce the dynamic so that the stretching is not the identity
+    vpRGBa lut_dynamic[256];
+    for (unsigned int i = 0; i < 256; i++) {
+      unsigned char value = (unsigned char)(64 + i / 2);
+      lut_dynamic[i] = vpRGBa(value, value, value, value);
+    }
+    I_planes.performLut(lut_dynamic);
+    I_fused = I_planes;
+
+    double t_planes = vpTime::measureTimeMs();
+    for (unsigned int cpt = 0; cpt < nbIterations * 10; cpt++) {
+      vpImage<vpRGBa> I_tmp = I_planes;
+      stretchContrastPlanes(I_tmp);
+    }
+    t_planes = vpTime::measureTimeMs() - t_planes;
+
+    double t_fused = vpTime::measureTimeMs();
+    for (unsigned int cpt = 0; cpt < nbIterations * 10; cpt++) {
+      vpImage<vpRGBa> I_tmp = I_fused;
+      stretchContrastFused(I_tmp, nbThreads);
+    }
+    t_fused = vpTime::measureTimeMs() - t_fused;
+
+    std::cout << "\nt_planes=" << t_planes / (nbIterations * 10) << " ms ; t_fused=" << t_fused / (nbIterations * 10)
+              << " ms ; t_planes/t_fused=" << t_planes / t_fused << "X" << std::endl;
+
+    stretchContrastPlanes(I_planes);
+    stretchContrastFused(I_fused, nbThreads);
+    if (I_planes != I_fused) {
+      std::cerr << "Fused histogram and LUT path gives a different image!" << std::endl;
+      return -1;
+    }
+
+    // Grayscale histogram on one thread and on nbThreads
+    vpImageIo::read(I_lut_grayscale, vpIoTools::createFilePath(ipath, "Klimt/Klimt.pgm"));
+    vpHistogram hist_singlethread, hist_multithread;
+    double t_hist_singlethread = vpTime::measureTimeMs();
+    for (unsigned int cpt = 0; cpt < nbIterations * 10; cpt++) {
+      hist_singlethread.calculate(I_lut_grayscale, 256, 1);
+    }
+    t_hist_singlethread = vpTime::measureTimeMs() - t_hist_singlethread;
+
+    double t_hist_multithread = vpTime::measureTimeMs();
+    for (unsigned int cpt = 0; cpt < nbIterations * 10; cpt++) {
+      hist_multithread.calculate(I_lut_grayscale, 256, nbThreads);
+    }
+    t_hist_multithread = vpTime::measureTimeMs() - t_hist_multithread;
+
+    std::cout << "t_hist_singlethread/t_hist_multithread=" << t_hist_singlethread / t_hist_multithread << "X"
+              << std::endl;
+    for (unsigned int i = 0; i < 256; i++) {
+      if (hist_singlethread[(unsigned char)i] != hist_multithread[(unsigned char)i]) {
+        std::cerr << "Histograms computed with 1 and " << nbThreads << " threads are different!" << std::endl;
+        return -1;
+      }
+    }
+
     // Check performLut with multithreading and image size not divisible by 8
     vpImage<unsigned char> I_test_grayscale(49, 7);
     // Construct the LUT
@@ -0,0 +1,258 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Test vpTemplateMatcher.
+ *
+ *****************************************************************************/
+/*!
+  \example testTemplateMatcher.cpp
+
+  \brief Check the scores of vpTemplateMatcher against a direct ZNCC
+  computation and the locations found by the exhaustive, coarse-to-fine and
+  ROI-restricted searches.
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpTemplateMatcher.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace
+{
+double znccReference(const vpImage<unsigned char> &I, const vpImage<unsigned char> &I_tpl, unsigned int i0,
+                     unsigned int j0)
+{
+  double meanI = 0, meanT = 0;
+  for (unsigned int i = 0; i < I_tpl.getHeight(); i++) {
+    for (unsigned int j = 0; j < I_tpl.getWidth(); j++) {
+      meanI += I[i0 + i][j0 + j];
+      meanT += I_tpl[i][j];
+    }
+  }
+  meanI /= I_tpl.getSize();
+  meanT /= I_tpl.getSize();
+
+  double ab = 0, a2 = 0, b2 = 0;
+  for (unsigned int i = 0; i < I_tpl.getHeight(); i++) {
+    for (unsigned int j = 0; j < I_tpl.getWidth(); j++) {
+      const double a = I[i0 + i][j0 + j] - meanI, b = I_tpl[i][j] - meanT;
+      ab += a * b;
+      a2 += a * a;
+      b2 += b * b;
+    }
+  }
+  return a2 * b2 > 0 ? ab / std::sqrt(a2 * b2) : 0.0;
+}
+
+// Textured image made of random blobs, smooth enough to be matched at the
+// coarse levels of a pyramid
+void fillImage(vpImage<unsigned char> &I, vpUniRand &rng)
+{
+  vpImage<double> acc(I.getHeight(), I.getWidth(), 0.0);
+  for (int k = 0; k < 400; k++) {
+    const double ci = rng.uniform(0.0, (double)I.getHeight()), cj = rng.uniform(0.0, (double)I.getWidth());
+    const double radius = rng.uniform(3.0, 12.0), amplitude = rng.uniform(-80.0, 80.0);
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        const double d2 = ((i - ci) * (i - ci) + (j - cj) * (j - cj)) / (radius * radius);
+        if (d2 < 9) {
+          acc[i][j] += amplitude * std::exp(-d2);
+        }
+      }
+    }
+  }
+  for (unsigned int k = 0; k < I.getSize(); k++) {
+    const double v = 128 + acc.bitmap[k];
+    I.bitmap[k] = (unsigned char)(v < 0 ? 0 : (v > 255 ? 255 : v));
+  }
+}
+
+void extract(const vpImage<unsigned char> &I, unsigned int i0, unsigned int j0, vpImage<unsigned char> &I_tpl)
+{
+  for (unsigned int i = 0; i < I_tpl.getHeight(); i++) {
+    for (unsigned int j = 0; j < I_tpl.getWidth(); j++) {
+      I_tpl[i][j] = I[i0 + i][j0 + j];
+    }
+  }
+}
+
+void paste(const vpImage<unsigned char> &I_tpl, unsigned int i0, unsigned int j0, vpImage<unsigned char> &I)
+{
+  for (unsigned int i = 0; i < I_tpl.getHeight(); i++) {
+    for (unsigned int j = 0; j < I_tpl.getWidth(); j++) {
+      I[i0 + i][j0 + j] = I_tpl[i][j];
+    }
+  }
+}
+
+bool checkMatch(const std::string &name, const std::vector<vpTemplateMatcher::vpMatch> &matches, unsigned int i,
+                unsigned int j)
+{
+  if (matches.empty() || matches[0].i != i || matches[0].j != j || matches[0].score < 0.999) {
+    std::cerr << name << ": template not found at (" << i << ", " << j << ")";
+    if (!matches.empty()) {
+      std::cerr << ", best match at (" << matches[0].i << ", " << matches[0].j << ") with score " << matches[0].score;
+    }
+    std::cerr << std::endl;
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+int main()
+{
+  try {
+    vpUniRand rng(42);
+
+    // Scores against the direct computation, with odd template sizes and a
+    // uniform area
+    {
+      vpImage<unsigned char> I(47, 61), I_tpl(7, 19);
+      for (unsigned int k = 0; k < I.getSize(); k++) {
+        I.bitmap[k] = (unsigned char)rng.uniform(0, 256);
+      }
+      for (unsigned int i = 20; i < 35; i++) {
+        for (unsigned int j = 10; j < 40; j++) {
+          I[i][j] = 77;
+        }
+      }
+      extract(I, 5, 9, I_tpl);
+
+      vpTemplateMatcher matcher;
+      matcher.setImage(I);
+      vpImage<double> I_score;
+      matcher.computeScores(I_tpl, I_score);
+      if (I_score.getHeight() != I.getHeight() - I_tpl.getHeight() + 1 ||
+          I_score.getWidth() != I.getWidth() - I_tpl.getWidth() + 1) {
+        std::cerr << "computeScores: bad score map size" << std::endl;
+        return EXIT_FAILURE;
+      }
+      for (unsigned int i = 0; i < I_score.getHeight(); i++) {
+        for (unsigned int j = 0; j < I_score.getWidth(); j++) {
+          const double ref = znccReference(I, I_tpl, i, j);
+          if (std::fabs(I_score[i][j] - ref) > 1e-9) {
+            std::cerr << "computeScores: score " << I_score[i][j] << " instead of " << ref << " at (" << i << ", " << j
+                      << ")" << std::endl;
+            return EXIT_FAILURE;
+          }
+        }
+      }
+
+      vpImage<double> I_score_tools;
+      vpImageTools::templateMatching(I, I_tpl, I_score_tools, 3, 2);
+      for (unsigned int i = 0; i < I_score_tools.getHeight(); i++) {
+        for (unsigned int j = 0; j < I_score_tools.getWidth(); j++) {
+          const double expected = (i % 2 == 0 && j % 3 == 0) ? I_score[i][j] : 0.0;
+          if (I_score_tools[i][j] != expected) {
+            std::cerr << "vpImageTools::templateMatching: bad score at (" << i << ", " << j << ")" << std::endl;
+            return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+
+    vpImage<unsigned char> I(240, 320);
+    fillImage(I, rng);
+    vpImage<unsigned char> I_tpl(37, 45);
+    extract(I, 101, 187, I_tpl);
+
+    vpTemplateMatcher matcher;
+    matcher.setImage(I);
+    std::vector<vpTemplateMatcher::vpMatch> matches;
+    matcher.match(I_tpl, matches);
+    if (!checkMatch("Exhaustive search", matches, 101, 187)) {
+      return EXIT_FAILURE;
+    }
+
+    matcher.setPyramidLevels(2);
+    matcher.match(I_tpl, matches);
+    if (!checkMatch("Coarse-to-fine search", matches, 101, 187)) {
+      return EXIT_FAILURE;
+    }
+
+    // The template is outside of the region of interest
+    matcher.setROI(vpRect(0, 0, 160, 240));
+    matcher.match(I_tpl, matches);
+    for (size_t k = 0; k < matches.size(); k++) {
+      if (matches[k].j + I_tpl.getWidth() > 160 || matches[k].score > 0.99) {
+        std::cerr << "ROI search: match outside of the region of interest" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    matcher.setROI(vpRect(150, 80, 100, 70));
+    matcher.match(I_tpl, matches);
+    if (!checkMatch("ROI search", matches, 101, 187)) {
+      return EXIT_FAILURE;
+    }
+    matcher.resetROI();
+
+    // Several instances of a template, and several templates
+    const unsigned int locations[3][2] = {{10, 20}, {150, 40}, {60, 250}};
+    for (int k = 0; k < 3; k++) {
+      paste(I_tpl, locations[k][0], locations[k][1], I);
+    }
+    vpImage<unsigned char> I_tpl2(24, 30);
+    extract(I, 200, 120, I_tpl2);
+    matcher.setImage(I);
+    matcher.setMaxMatches(5);
+    matcher.setMinScore(0.95);
+    std::vector<vpImage<unsigned char> > templates;
+    templates.push_back(I_tpl);
+    templates.push_back(I_tpl2);
+    std::vector<std::vector<vpTemplateMatcher::vpMatch> > allMatches;
+    matcher.match(templates, allMatches);
+    if (allMatches.size() != 2 || allMatches[0].size() != 4 || !checkMatch("Second template", allMatches[1], 200, 120)) {
+      std::cerr << "Multiple matches: bad number of matches" << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (int k = 0; k < 3; k++) {
+      bool found = false;
+      for (size_t l = 0; l < allMatches[0].size(); l++) {
+        found = found || (allMatches[0][l].i == locations[k][0] && allMatches[0][l].j == locations[k][1]);
+      }
+      if (!found) {
+        std::cerr << "Multiple matches: instance " << k << " not found" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test succeed" << std::endl;
+  return EXIT_SUCCESS;
+}
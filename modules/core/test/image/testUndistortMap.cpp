@@ -0,0 +1,215 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Test the precomputed undistortion map.
+ *
+ *****************************************************************************/
+/*!
+  \example testUndistortMap.cpp
+
+  \brief Check the fixed-point remap of vpUndistortMap against a bilinear
+  interpolation in double precision.
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <visp3/core/vpUndistortMap.h>
+
+namespace
+{
+// Source position in the acquired image of the rectified pixel (u, v)
+bool sourcePosition(const vpCameraParameters &cam, const vpRotationMatrix &rRc, const vpCameraParameters &camRect,
+                    unsigned int u, unsigned int v, double &us, double &vs)
+{
+  vpColVector ray(3);
+  ray[0] = (u - camRect.get_u0()) / camRect.get_px();
+  ray[1] = (v - camRect.get_v0()) / camRect.get_py();
+  ray[2] = 1.0;
+  vpColVector c = rRc.t() * ray;
+  if (c[2] <= 0.0) {
+    return false;
+  }
+  double x = c[0] / c[2], y = c[1] / c[2];
+  double fr = 1.0 + cam.get_kud() * (x * x + y * y);
+  us = cam.get_u0() + cam.get_px() * x * fr;
+  vs = cam.get_v0() + cam.get_py() * y * fr;
+  return true;
+}
+
+double bilinear(const vpImage<unsigned char> &I, double u, double v)
+{
+  unsigned int u0 = std::min((unsigned int)u, I.getWidth() - 2), v0 = std::min((unsigned int)v, I.getHeight() - 2);
+  double du = u - u0, dv = v - v0;
+  return (1 - dv) * ((1 - du) * I[v0][u0] + du * I[v0][u0 + 1]) + dv * ((1 - du) * I[v0 + 1][u0] + du * I[v0 + 1][u0 + 1]);
+}
+
+// Smooth synthetic image, so that the 1/32 pixel quantization of the map
+// changes the values by less than one grey level
+void fillImage(vpImage<unsigned char> &I)
+{
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      I[i][j] = (unsigned char)(127.5 + 60 * std::sin(j / 9.0) + 60 * std::cos(i / 13.0));
+    }
+  }
+}
+
+bool checkMap(const std::string &name, const vpUndistortMap &map, const vpImage<unsigned char> &I,
+              const vpCameraParameters &cam, const vpRotationMatrix &rRc, const vpCameraParameters &camRect)
+{
+  vpImage<unsigned char> Iundist, Iundist_seq;
+  map.remap(I, Iundist);
+  map.remap(I, Iundist_seq, 1);
+  if (Iundist != Iundist_seq) {
+    std::cerr << name << ": multi-threaded and sequential remaps differ" << std::endl;
+    return false;
+  }
+
+  vpImage<vpRGBa> I_color(I.getHeight(), I.getWidth()), Iundist_color;
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I_color.bitmap[i] = vpRGBa(I.bitmap[i], (unsigned char)(255 - I.bitmap[i]), I.bitmap[i], 255);
+  }
+  map.remap(I_color, Iundist_color);
+
+  const double margin = 0.1;
+  unsigned int nbInside = 0;
+  for (unsigned int v = 0; v < map.getHeight(); v++) {
+    for (unsigned int u = 0; u < map.getWidth(); u++) {
+      double us = 0, vs = 0;
+      bool valid = sourcePosition(cam, rRc, camRect, u, v, us, vs);
+      bool inside = valid && us >= margin && vs >= margin && us <= I.getWidth() - 1 - margin &&
+                    vs <= I.getHeight() - 1 - margin;
+      bool outside = !valid || us < -margin || vs < -margin || us > I.getWidth() - 1 + margin ||
+                     vs > I.getHeight() - 1 + margin;
+
+      const vpRGBa &c = Iundist_color[v][u];
+      if (inside) {
+        nbInside++;
+        double ref = bilinear(I, us, vs);
+        if (std::fabs(Iundist[v][u] - ref) > 1.5 || std::fabs(c.R - ref) > 1.5 || std::fabs(c.G - (255 - ref)) > 1.5 ||
+            c.B != Iundist[v][u] || c.A != 255) {
+          std::cerr << name << ": bad value at (" << u << ", " << v << "): " << (int)Iundist[v][u] << " instead of "
+                    << ref << std::endl;
+          return false;
+        }
+      } else if (outside && (Iundist[v][u] != 0 || c.R != 0 || c.G != 0 || c.B != 0 || c.A != 0)) {
+        std::cerr << name << ": pixel (" << u << ", " << v << ") without source is not null" << std::endl;
+        return false;
+      }
+    }
+  }
+
+  if (nbInside < map.getWidth() * map.getHeight() / 2) {
+    std::cerr << name << ": too few pixels have a source" << std::endl;
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+int main()
+{
+  try {
+    const unsigned int width = 321, height = 243;
+    vpImage<unsigned char> I(height, width);
+    fillImage(I);
+
+    // Without distortion the map is the identity
+    vpCameraParameters cam;
+    cam.initPersProjWithoutDistortion(300, 310, 160.3, 120.6);
+    vpUndistortMap identity(cam, width, height);
+    vpImage<unsigned char> Iundist;
+    identity.remap(I, Iundist);
+    if (Iundist != I) {
+      std::cerr << "The map without distortion is not the identity" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Barrel and pincushion distortions
+    const double kuds[2] = {-0.25, 0.3};
+    for (int k = 0; k < 2; k++) {
+      cam.initPersProjWithDistortion(300, 310, 160.3, 120.6, kuds[k], -kuds[k]);
+      vpUndistortMap map(cam, width, height);
+      if (!checkMap("Undistortion", map, I, cam, vpRotationMatrix(), cam)) {
+        return EXIT_FAILURE;
+      }
+    }
+
+    // Rectification to an image of another size with a rotated camera
+    vpRotationMatrix rRc(vpMath::rad(3), vpMath::rad(-5), vpMath::rad(10));
+    vpCameraParameters camRect;
+    camRect.initPersProjWithoutDistortion(320, 320, 150, 110);
+    vpUndistortMap rectify;
+    rectify.init(cam, width, height, rRc, camRect, 300, 220);
+    if (rectify.getWidth() != 300 || rectify.getHeight() != 220 ||
+        !checkMap("Rectification", rectify, I, cam, rRc, camRect)) {
+      return EXIT_FAILURE;
+    }
+
+    // Missing depths are never blended with valid ones
+    vpImage<uint16_t> D(height, width, 1000), Dundist;
+    for (unsigned int i = 40; i < 80; i++) {
+      for (unsigned int j = 50; j < 120; j++) {
+        D[i][j] = 0;
+      }
+    }
+    rectify.remap(D, Dundist);
+    for (unsigned int i = 0; i < Dundist.getSize(); i++) {
+      if (Dundist.bitmap[i] != 0 && Dundist.bitmap[i] != 1000) {
+        std::cerr << "Depth remap blends missing depths" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // Images of another size are rejected
+    bool thrown = false;
+    try {
+      vpImage<unsigned char> I_small(height / 2, width / 2);
+      rectify.remap(I_small, Iundist);
+    } catch (const vpException &) {
+      thrown = true;
+    }
+    if (!thrown) {
+      std::cerr << "No exception for an image of wrong size" << std::endl;
+      return EXIT_FAILURE;
+    }
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test succeed" << std::endl;
+  return EXIT_SUCCESS;
+}
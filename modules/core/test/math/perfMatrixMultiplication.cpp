@@ -40,6 +40,8 @@
 #define CATCH_CONFIG_RUNNER
 #include <catch.hpp>
 
+#include <limits>
+
 #include <visp3/core/vpMatrix.h>
 
 #if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
@@ -201,6 +203,57 @@ vpMatrix mat_mul_twist_matrix(const vpMatrix& A, const vpVelocityTwistMatrix& V)
   return M;
 }
 
+// Naive A^T * B
+vpMatrix AtB_regular(const vpMatrix& A, const vpMatrix& B)
+{
+  vpMatrix C(A.getCols(), B.getCols());
+
+  for (unsigned int i = 0; i < A.getCols(); i++) {
+    for (unsigned int j = 0; j < B.getCols(); j++) {
+      double s = 0;
+      for (unsigned int k = 0; k < A.getRows(); k++) {
+        s += A[k][i] * B[k][j];
+      }
+      C[i][j] = s;
+    }
+  }
+
+  return C;
+}
+
+// Naive A * A^T
+vpMatrix AAt_regular(const vpMatrix& A)
+{
+  vpMatrix B(A.getRows(), A.getRows());
+
+  for (unsigned int i = 0; i < A.getRows(); i++) {
+    for (unsigned int j = 0; j < A.getRows(); j++) {
+      double s = 0;
+      for (unsigned int k = 0; k < A.getCols(); k++) {
+        s += A[i][k] * A[j][k];
+      }
+      B[i][j] = s;
+    }
+  }
+
+  return B;
+}
+
+// Force the built-in matrix products in its scope, even when ViSP is built
+// with an external BLAS library
+class BuiltInProducts
+{
+public:
+  BuiltInProducts() : m_min_size(vpMatrix::getLapackMatrixMinSize())
+  {
+    vpMatrix::setLapackMatrixMinSize(std::numeric_limits<unsigned int>::max());
+  }
+  ~BuiltInProducts() { vpMatrix::setLapackMatrixMinSize(m_min_size); }
+
+private:
+  unsigned int m_min_size;
+};
+
 bool equalMatrix(const vpMatrix& A, const vpMatrix& B, double tol=1e-9)
 {
   if (A.getRows() != B.getRows() || A.getCols() != B.getCols()) {
@@ -247,6 +300,16 @@ TEST_CASE("Benchmark matrix-matrix multiplication", "[benchmark]") {
         REQUIRE(equalMatrix(C, C_true));
       }
 
+      {
+        BuiltInProducts builtIn;
+        oss.str("");
+        oss << "(" << A.getRows() << "x" << A.getCols() << ")x(" << B.getRows() << "x" << B.getCols() << ") - ViSP built-in";
+        BENCHMARK(oss.str().c_str()) {
+          vpMatrix C = A * B;
+          return C;
+        };
+      }
+
 #if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
       cv::Mat matA(sz.first, sz.second, CV_64FC1);
       cv::Mat matB(sz.second, sz.first, CV_64FC1);
@@ -296,6 +359,21 @@ TEST_CASE("Benchmark matrix-matrix multiplication", "[benchmark]") {
     vpMatrix C = A * B;
     REQUIRE(equalMatrix(C, C_true));
   }
+
+  {
+    // Sizes that are not multiple of the register tile and larger than a
+    // packed panel of the built-in implementation
+    BuiltInProducts builtIn;
+    std::vector<std::pair<int, int>> sizes = { {1, 1}, {6, 200}, {200, 6}, {47, 63}, {301, 517} };
+    for (auto sz : sizes) {
+      vpMatrix A = generateRandomMatrix(sz.first, sz.second);
+      vpMatrix B = generateRandomMatrix(sz.second, sz.first + 3);
+
+      vpMatrix C_true = dgemm_regular(A, B);
+      vpMatrix C = A * B;
+      REQUIRE(equalMatrix(C, C_true));
+    }
+  }
 }
 
 TEST_CASE("Benchmark matrix-vector multiplication", "[benchmark]") {
@@ -325,6 +403,16 @@ TEST_CASE("Benchmark matrix-vector multiplication", "[benchmark]") {
         REQUIRE(equalMatrix(C, C_true));
       }
 
+      {
+        BuiltInProducts builtIn;
+        oss.str("");
+        oss << "(" << A.getRows() << "x" << A.getCols() << ")x(" << B.getRows() << "x" << B.getCols() << ") - ViSP built-in";
+        BENCHMARK(oss.str().c_str()) {
+          vpColVector C = A * B;
+          return C;
+        };
+      }
+
 #if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
       cv::Mat matA(sz.first, sz.second, CV_64FC1);
       cv::Mat matB(sz.second, 1, CV_64FC1);
@@ -378,6 +466,19 @@ TEST_CASE("Benchmark matrix-vector multiplication", "[benchmark]") {
     vpColVector C = A * B;
     REQUIRE(equalMatrix(C, C_true));
   }
+
+  {
+    BuiltInProducts builtIn;
+    std::vector<std::pair<int, int>> sizes = { {1, 1}, {6, 200}, {200, 6}, {47, 63} };
+    for (auto sz : sizes) {
+      vpMatrix A = generateRandomMatrix(sz.first, sz.second);
+      vpColVector B = generateRandomVector(sz.second);
+
+      vpColVector C_true = dgemv_regular(A, B);
+      vpColVector C = A * B;
+      REQUIRE(equalMatrix(C, C_true));
+    }
+  }
 }
 
 TEST_CASE("Benchmark AtA", "[benchmark]") {
@@ -406,6 +507,16 @@ TEST_CASE("Benchmark AtA", "[benchmark]") {
         REQUIRE(equalMatrix(AtA, AtA_true));
       }
 
+      {
+        BuiltInProducts builtIn;
+        oss.str("");
+        oss << "(" << A.getRows() << "x" << A.getCols() << ") - ViSP built-in";
+        BENCHMARK(oss.str().c_str()) {
+          vpMatrix AtA = A.AtA();
+          return AtA;
+        };
+      }
+
 #if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
       cv::Mat matA(sz.first, sz.second, CV_64FC1);
 
@@ -450,6 +561,94 @@ TEST_CASE("Benchmark AtA", "[benchmark]") {
     vpMatrix AtA = A.AtA();
     REQUIRE(equalMatrix(AtA, AtA_true));
   }
+
+  {
+    BuiltInProducts builtIn;
+    std::vector<std::pair<int, int>> sizes = { {1, 1}, {6, 200}, {200, 6}, {47, 63}, {83, 201} };
+    for (auto sz : sizes) {
+      vpMatrix A = generateRandomMatrix(sz.first, sz.second);
+
+      vpMatrix AtA_true = AtA_regular(A);
+      vpMatrix AtA = A.AtA();
+      REQUIRE(equalMatrix(AtA, AtA_true));
+
+      vpMatrix AAt_true = AAt_regular(A);
+      vpMatrix AAt = A.AAt();
+      REQUIRE(equalMatrix(AAt, AAt_true));
+    }
+  }
+}
+
+TEST_CASE("Benchmark AtB", "[benchmark]") {
+  if (runBenchmark) {
+    // N x 6 Jacobians of the model-based trackers
+    std::vector<int> sizes = { 20, 207, 600, 1201, 10000 };
+
+    for (auto sz : sizes) {
+      vpMatrix J = generateRandomMatrix(sz, 6);
+      vpColVector e = generateRandomVector(sz);
+
+      std::ostringstream oss;
+      oss << "(" << J.getRows() << "x" << J.getCols() << ")^T x(" << e.getRows() << ") - Naive code";
+      BENCHMARK(oss.str().c_str()) {
+        vpColVector Jte = J.t() * e;
+        return Jte;
+      };
+
+      oss.str("");
+      oss << "(" << J.getRows() << "x" << J.getCols() << ")^T x(" << e.getRows() << ") - ViSP";
+      BENCHMARK(oss.str().c_str()) {
+        vpColVector Jte = J.AtB(e);
+        return Jte;
+      };
+
+      {
+        BuiltInProducts builtIn;
+        oss.str("");
+        oss << "(" << J.getRows() << "x" << J.getCols() << ")^T x(" << e.getRows() << ") - ViSP built-in";
+        BENCHMARK(oss.str().c_str()) {
+          vpColVector Jte = J.AtB(e);
+          return Jte;
+        };
+      }
+
+#ifdef VISP_HAVE_EIGEN3
+      Eigen::MatrixXd eigenJ(J.getRows(), J.getCols());
+      Eigen::VectorXd eigenE(e.getRows());
+
+      for (unsigned int i = 0; i < J.getRows(); i++) {
+        for (unsigned int j = 0; j < J.getCols(); j++) {
+          eigenJ(i, j) = J[i][j];
+        }
+        eigenE(i) = e[i];
+      }
+
+      oss.str("");
+      oss << "(" << eigenJ.rows() << "x" << eigenJ.cols() << ")^T x(" << eigenE.rows() << ") - Eigen";
+      BENCHMARK(oss.str().c_str()) {
+        Eigen::VectorXd eigenJte = eigenJ.transpose() * eigenE;
+        return eigenJte;
+      };
+#endif
+    }
+  }
+
+  std::vector<std::pair<int, int>> sizes = { {1, 1}, {47, 6}, {47, 63}, {301, 70} };
+  for (auto sz : sizes) {
+    vpMatrix A = generateRandomMatrix(sz.first, sz.second);
+    vpMatrix B = generateRandomMatrix(sz.first, sz.second + 5);
+    vpColVector b = generateRandomVector(sz.first);
+    vpMatrix b_mat(b);
+
+    vpMatrix AtB_true = AtB_regular(A, B);
+    vpMatrix Atb_true = AtB_regular(A, b_mat);
+    REQUIRE(equalMatrix(A.AtB(B), AtB_true));
+    REQUIRE(equalMatrix(A.AtB(b), Atb_true));
+
+    BuiltInProducts builtIn;
+    REQUIRE(equalMatrix(A.AtB(B), AtB_true));
+    REQUIRE(equalMatrix(A.AtB(b), Atb_true));
+  }
 }
 
 TEST_CASE("Benchmark matrix-velocity twist multiplication", "[benchmark]") {
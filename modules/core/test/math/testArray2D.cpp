@@ -46,6 +46,7 @@
 #include <limits>
 #include <vector>
 
+#include <visp3/core/vpHomogeneousMatrix.h>
 #include <visp3/core/vpTranslationVector.h>
 
 template <typename Type> bool test(const std::string &s, const vpArray2D<Type> &A, const std::vector<Type> &bench)
@@ -67,6 +68,23 @@ template <typename Type> bool test(const std::string &s, const vpArray2D<Type> &
   return true;
 }
 
+bool test_near(const std::string &s, const vpArray2D<double> &A, const vpArray2D<double> &B, double eps = 1e-12)
+{
+  std::cout << s << "(" << A.getRows() << "," << A.getCols() << ") = \n" << A << std::endl;
+  if (A.getRows() != B.getRows() || A.getCols() != B.getCols()) {
+    std::cout << "Test fails: bad size" << std::endl;
+    return false;
+  }
+  for (unsigned int i = 0; i < A.size(); i++) {
+    if (std::fabs(A.data[i] - B.data[i]) > eps) {
+      std::cout << "Test fails: bad content" << std::endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
 int main()
 {
   {
@@ -188,6 +206,48 @@ int main()
     C2 = C1.hadamard(C2);
     std::cout << "\nRes:\n" << C2 << std::endl;
   }
+  {
+    // Test arrays that keep their elements in the object
+    std::cout << "\nTest fixed-size arrays" << std::endl;
+    vpHomogeneousMatrix aMb(0.1, -0.2, 0.3, vpMath::rad(10), vpMath::rad(-20), vpMath::rad(30));
+    vpHomogeneousMatrix bMc(-0.4, 0.5, 0.6, vpMath::rad(-40), vpMath::rad(50), vpMath::rad(60));
+
+    vpMatrix aMc = static_cast<vpMatrix>(aMb) * static_cast<vpMatrix>(bMc);
+    if (test_near("aMb * bMc", aMb * bMc, aMc) == false)
+      return EXIT_FAILURE;
+
+    vpHomogeneousMatrix aMc_bis = aMb;
+    aMc_bis *= bMc;
+    if (test_near("aMc", aMc_bis, aMc) == false)
+      return EXIT_FAILURE;
+
+    vpMatrix I;
+    I.eye(4);
+    if (test_near("aMb * aMb^-1", static_cast<vpMatrix>(aMb) * static_cast<vpMatrix>(aMb.inverse()), I) == false)
+      return EXIT_FAILURE;
+
+    std::vector<double> bench(aMc_bis.data, aMc_bis.data + 16);
+    // Changing the dimensions moves the elements to the heap
+    vpArray2D<double> &A = aMc_bis;
+    A.reshape(2, 8);
+    if (test("A", A, bench) == false)
+      return EXIT_FAILURE;
+    A.resize(5, 5);
+    std::vector<double> bench_zero(25, 0);
+    if (test("A", A, bench_zero) == false)
+      return EXIT_FAILURE;
+
+    std::vector<vpHomogeneousMatrix> vec_M(10, aMb * bMc);
+    vec_M.resize(100);
+    if (test_near("vec_M[0]", vec_M[0], aMc) == false)
+      return EXIT_FAILURE;
+
+    // Self-assignment keeps the elements
+    vpHomogeneousMatrix &aMc_ref = vec_M[1];
+    vec_M[1] = aMc_ref;
+    if (test_near("vec_M[1]", vec_M[1], aMc) == false)
+      return EXIT_FAILURE;
+  }
   std::cout << "All tests succeed" << std::endl;
   return 0;
 }
@@ -0,0 +1,161 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the solver of 6-by-6 normal equations.
+ *
+ *****************************************************************************/
+
+/*!
+
+  \example testMatrixNormalEquations6.cpp
+
+  \brief Test vpMatrix::solveNormalEquations6() and
+  vpMatrix::kernelNormalEquations6() against the pseudo-inverse and the
+  kernel computed by SVD, on full rank and rank deficient problems.
+
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <visp3/core/vpColVector.h>
+#include <visp3/core/vpGaussRand.h>
+#include <visp3/core/vpMatrix.h>
+
+namespace
+{
+bool check(const std::string &name, const vpArray2D<double> &A, const vpArray2D<double> &B, double eps)
+{
+  if (A.getRows() != B.getRows() || A.getCols() != B.getCols()) {
+    std::cerr << name << ": bad size (" << A.getRows() << "x" << A.getCols() << ") instead of (" << B.getRows() << "x"
+              << B.getCols() << ")" << std::endl;
+    return false;
+  }
+  for (unsigned int i = 0; i < A.size(); i++) {
+    if (std::fabs(A.data[i] - B.data[i]) > eps) {
+      std::cerr << name << ": bad content\n" << A << "\ninstead of\n" << B << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Nx6 matrix whose last 6 - rank columns are combinations of the first ones
+vpMatrix randomJacobian(vpGaussRand &rng, unsigned int nrows, unsigned int rank)
+{
+  vpMatrix J(nrows, 6);
+  for (unsigned int i = 0; i < nrows; i++) {
+    for (unsigned int j = 0; j < rank; j++) {
+      J[i][j] = rng();
+    }
+    for (unsigned int j = rank; j < 6; j++) {
+      J[i][j] = J[i][0] - 2 * J[i][j - rank];
+    }
+  }
+  return J;
+}
+
+bool test(vpGaussRand &rng, unsigned int nrows, unsigned int rank)
+{
+  std::cout << "Test " << nrows << "x6 matrix of rank " << rank << std::endl;
+  vpMatrix J = randomJacobian(rng, nrows, rank);
+  vpColVector e(nrows);
+  for (unsigned int i = 0; i < nrows; i++) {
+    e[i] = rng();
+  }
+
+  vpMatrix JTJ = J.AtA();
+  vpColVector JTe = J.AtB(e);
+
+  vpColVector x;
+  unsigned int rank_ne = JTJ.solveNormalEquations6(JTe, x);
+  if (rank_ne != rank) {
+    std::cerr << "Bad rank " << rank_ne << " instead of " << rank << std::endl;
+    return false;
+  }
+  if (!check("x", x, J.pseudoInverse() * e, 1e-9)) {
+    return false;
+  }
+
+  vpMatrix K, K_svd;
+  rank_ne = JTJ.kernelNormalEquations6(K);
+  unsigned int rank_svd = J.kernel(K_svd);
+  if (rank_ne != rank_svd) {
+    std::cerr << "Bad kernel rank " << rank_ne << " instead of " << rank_svd << std::endl;
+    return false;
+  }
+  // Compare the projectors on the kernels since the bases may differ
+  if (!check("kernel", K.AtA(), K_svd.AtA(), 1e-9) || !check("J * kernel", J * K.t(), vpMatrix(nrows, 6 - rank), 1e-9)) {
+    return false;
+  }
+
+  return true;
+}
+}
+
+int main()
+{
+  try {
+    vpGaussRand rng(1., 0., 4242);
+    for (unsigned int rank = 6; rank >= 3; rank--) {
+      if (!test(rng, 20, rank) || !test(rng, 200, rank)) {
+        return EXIT_FAILURE;
+      }
+    }
+
+    // Null matrix
+    vpMatrix Z(6, 6);
+    vpColVector x, b(6, 1.);
+    if (Z.solveNormalEquations6(b, x) != 0 || !check("x", x, vpColVector(6), 0.)) {
+      return EXIT_FAILURE;
+    }
+
+    // Bad dimensions
+    bool hasThrown = false;
+    try {
+      vpMatrix(5, 6).solveNormalEquations6(b, x);
+    } catch (const vpException &) {
+      hasThrown = true;
+    }
+    if (!hasThrown) {
+      std::cerr << "A 5x6 matrix should be rejected" << std::endl;
+      return EXIT_FAILURE;
+    }
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "All tests succeed" << std::endl;
+  return EXIT_SUCCESS;
+}
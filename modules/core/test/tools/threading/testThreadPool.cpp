@@ -0,0 +1,200 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the process-wide thread pool.
+ *
+ *****************************************************************************/
+
+/*!
+
+  \example testThreadPool.cpp
+
+  \brief Test vpThreadPool::parallel_for(): coverage of the range, nested
+  calls, exceptions and change of the number of threads.
+
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpThreadPool.h>
+
+namespace
+{
+class CountBody : public vpParallelForBody
+{
+public:
+  explicit CountBody(std::vector<int> &counts) : m_counts(counts) {}
+  void operator()(int begin, int end)
+  {
+    for (int i = begin; i < end; i++) {
+      m_counts[i]++;
+    }
+  }
+
+private:
+  std::vector<int> &m_counts;
+};
+
+class NestedBody : public vpParallelForBody
+{
+public:
+  NestedBody(std::vector<int> &counts, int cols) : m_counts(counts), m_cols(cols) {}
+  void operator()(int begin, int end)
+  {
+    for (int i = begin; i < end; i++) {
+      std::vector<int> row(m_cols, 0);
+      CountBody inner(row);
+      vpThreadPool::instance().parallel_for(0, m_cols, inner, 4);
+      for (int j = 0; j < m_cols; j++) {
+        m_counts[i * m_cols + j] += row[j];
+      }
+    }
+  }
+
+private:
+  std::vector<int> &m_counts;
+  int m_cols;
+};
+
+class ThrowingBody : public vpParallelForBody
+{
+public:
+  void operator()(int begin, int end)
+  {
+    for (int i = begin; i < end; i++) {
+      if (i == 777) {
+        throw vpException(vpException::fatalError, "Expected exception");
+      }
+    }
+  }
+};
+
+bool checkCounts(const std::vector<int> &counts, const std::string &name)
+{
+  for (size_t i = 0; i < counts.size(); i++) {
+    if (counts[i] != 1) {
+      std::cerr << name << ": index " << i << " processed " << counts[i] << " times" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool testRanges()
+{
+  const int sizes[] = {0, 1, 7, 100, 1000, 100003};
+  const int grains[] = {1, 3, 64, 4096};
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    for (size_t g = 0; g < sizeof(grains) / sizeof(grains[0]); g++) {
+      for (unsigned int maxThreads = 0; maxThreads < 4; maxThreads++) {
+        std::vector<int> counts(sizes[s] + 10, 0);
+        CountBody body(counts);
+        vpThreadPool::instance().parallel_for(10, 10 + sizes[s], body, grains[g], maxThreads);
+        std::vector<int> inRange(counts.begin() + 10, counts.end());
+        if (!checkCounts(inRange, "parallel_for") || std::count(counts.begin(), counts.begin() + 10, 0) != 10) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool testNested()
+{
+  const int rows = 64, cols = 257;
+  std::vector<int> counts(rows * cols, 0);
+  NestedBody body(counts, cols);
+  vpThreadPool::instance().parallel_for(0, rows, body);
+  return checkCounts(counts, "nested parallel_for");
+}
+
+bool testException()
+{
+  ThrowingBody body;
+  try {
+    vpThreadPool::instance().parallel_for(0, 10000, body, 16);
+  } catch (const vpException &e) {
+    std::cout << "Caught: " << e.getStringMessage() << std::endl;
+    return true;
+  }
+  std::cerr << "The exception was not propagated to the caller" << std::endl;
+  return false;
+}
+
+bool testLut()
+{
+  vpImage<unsigned char> I(480, 640), I_ref;
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = (unsigned char)(i * 7);
+  }
+  I_ref = I;
+
+  unsigned char lut[256];
+  for (unsigned int i = 0; i < 256; i++) {
+    lut[i] = (unsigned char)(255 - i);
+  }
+
+  I.performLut(lut, 4);
+  I_ref.performLut(lut, 1);
+  if (I != I_ref) {
+    std::cerr << "Multi-threaded and single-threaded LUT differ" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int main()
+{
+  vpThreadPool &pool = vpThreadPool::instance();
+  std::cout << "Thread pool with " << pool.getNumThreads() << " threads" << std::endl;
+
+  const unsigned int nbThreads[] = {4, 1, 0};
+  for (size_t i = 0; i < sizeof(nbThreads) / sizeof(nbThreads[0]); i++) {
+    pool.setNumThreads(nbThreads[i]);
+    std::cout << "Test with " << pool.getNumThreads() << " threads" << std::endl;
+
+    if (!testRanges() || !testNested() || !testException() || !testLut()) {
+      std::cerr << "Test failed" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test succeed" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -47,6 +47,7 @@
 #include <tagCircle21h7.h>
 #include <tagStandard41h12.h>
 #include <apriltag_pose.h>
+#include <common/workerpool.h>
 #include <visp3/detection/vpDetectorAprilTag.h>
 #if defined(VISP_HAVE_APRILTAG_BIG_FAMILY)
 #include <tagCircle49h12.h>
@@ -58,9 +59,37 @@
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpPixelMeterConversion.h>
 #include <visp3/core/vpPoint.h>
+#include <visp3/core/vpThreadPool.h>
 #include <visp3/vision/vpPose.h>
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+class vpAprilTagTaskBody : public vpParallelForBody
+{
+public:
+  vpAprilTagTaskBody(void (*run_task)(void *ctx, int i), void *ctx) : m_run_task(run_task), m_ctx(ctx) {}
+
+  void operator()(int begin, int end)
+  {
+    for (int i = begin; i < end; i++) {
+      m_run_task(m_ctx, i);
+    }
+  }
+
+private:
+  void (*m_run_task)(void *ctx, int i);
+  void *m_ctx;
+};
+
+// Run the tasks of the AprilTag worker pools on the ViSP thread pool
+void runAprilTagTasks(int ntasks, int nthreads, void (*run_task)(void *ctx, int i), void *ctx)
+{
+  vpAprilTagTaskBody body(run_task, ctx);
+  vpThreadPool::instance().parallel_for(0, ntasks, body, 1, (unsigned int)nthreads);
+}
+}
+
 class vpDetectorAprilTag::Impl
 {
 public:
@@ -68,6 +97,8 @@ public:
     : m_cam(), m_poseEstimationMethod(method), m_tagFamily(tagFamily), m_tagSize(1.0), m_td(NULL),
       m_tf(NULL), m_detections(NULL), m_zAlignedWithCameraFrame(false)
   {
+    workerpool_set_executor(runAprilTagTasks);
+
     switch (m_tagFamily) {
     case TAG_36h11:
       m_tf = tag36h11_create();
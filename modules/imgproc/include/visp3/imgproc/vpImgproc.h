@@ -134,14 +134,19 @@ VISP_EXPORT void fillHoles(vpImage<unsigned char> &I
                            const vpImageMorphology::vpConnexityType &connexity = vpImageMorphology::CONNEXITY_4
 #endif
 );
+VISP_EXPORT void fillHoles(vpBinaryImage &I);
 
 VISP_EXPORT void floodFill(vpImage<unsigned char> &I, const vpImagePoint &seedPoint, const unsigned char oldValue,
                            const unsigned char newValue,
                            const vpImageMorphology::vpConnexityType &connexity = vpImageMorphology::CONNEXITY_4);
+VISP_EXPORT void floodFill(vpBinaryImage &I, const vpImagePoint &seedPoint, bool newValue,
+                           const vpImageMorphology::vpConnexityType &connexity = vpImageMorphology::CONNEXITY_4);
 
 VISP_EXPORT void reconstruct(const vpImage<unsigned char> &marker, const vpImage<unsigned char> &mask,
                              vpImage<unsigned char> &I,
                              const vpImageMorphology::vpConnexityType &connexity = vpImageMorphology::CONNEXITY_4);
+VISP_EXPORT void reconstruct(const vpBinaryImage &marker, const vpBinaryImage &mask, vpBinaryImage &I,
+                             const vpImageMorphology::vpConnexityType &connexity = vpImageMorphology::CONNEXITY_4);
 
 VISP_EXPORT unsigned char autoThreshold(vpImage<unsigned char> &I, const vp::vpAutoThresholdMethod &method,
                                         const unsigned char backgroundValue = 0,
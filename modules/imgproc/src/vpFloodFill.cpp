@@ -91,6 +91,13 @@ void vp::floodFill(vpImage<unsigned char> &I, const vpImagePoint &seedPoint, con
     return;
   }
 
+  // Otherwise the fill would start next to the seed point
+  if (seedPoint.get_i() < 0 || seedPoint.get_j() < 0 || seedPoint.get_i() >= I.getHeight() ||
+      seedPoint.get_j() >= I.getWidth() ||
+      I[(unsigned int)seedPoint.get_i()][(unsigned int)seedPoint.get_j()] != oldValue) {
+    return;
+  }
+
   std::queue<vpImagePoint> seed_queue;
 
   // Add initial seed point
@@ -171,3 +178,53 @@ void vp::floodFill(vpImage<unsigned char> &I, const vpImagePoint &seedPoint, con
     }
   }
 }
+
+/*!
+  \ingroup group_imgproc_connected_components
+
+  Perform the flood fill algorithm on a bit-packed binary image: the pixels
+  connected to the seed point that have the value of the seed point are set
+  to \e newValue.
+
+  Instead of a queue of seed points, the region is filled by a
+  morphological reconstruction that processes the runs of pixels 64 pixels
+  at a time, see vp::reconstruct().
+
+  \param I : Input image to flood fill.
+  \param seedPoint : Seed position in the image.
+  \param newValue : New value to flood fill.
+  \param connexity : Type of connexity.
+*/
+void vp::floodFill(vpBinaryImage &I, const vpImagePoint &seedPoint, bool newValue,
+                   const vpImageMorphology::vpConnexityType &connexity)
+{
+  if (I.isEmpty() || seedPoint.get_i() < 0 || seedPoint.get_j() < 0 || seedPoint.get_i() >= I.getHeight() ||
+      seedPoint.get_j() >= I.getWidth()) {
+    return;
+  }
+
+  const unsigned int i = (unsigned int)seedPoint.get_i(), j = (unsigned int)seedPoint.get_j();
+  if (I.getValue(i, j) == newValue) {
+    return;
+  }
+
+  // The region contains the pixels that have the old value
+  vpBinaryImage mask = I;
+  if (newValue) {
+    mask.invert();
+  }
+  vpBinaryImage marker(I.getHeight(), I.getWidth());
+  marker.setValue(i, j, true);
+
+  vpBinaryImage region;
+  reconstruct(marker, mask, region, connexity);
+
+  const unsigned int nbWords = I.getNbWords();
+  for (unsigned int y = 0; y < I.getHeight(); y++) {
+    uint64_t *row = I.getRow(y);
+    const uint64_t *regionRow = region.getRow(y);
+    for (unsigned int k = 0; k < nbWords; k++) {
+      row[k] = newValue ? (row[k] | regionRow[k]) : (row[k] & ~regionRow[k]);
+    }
+  }
+}
@@ -65,8 +65,93 @@
 #include <visp3/core/vpImageConvert.h>
 #include <visp3/core/vpImageFilter.h>
 #include <visp3/core/vpMath.h>
+#include <visp3/core/vpThreadPool.h>
 #include <visp3/imgproc/vpImgproc.h>
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// The histograms and the look-up tables are computed on the threads of vpThreadPool
+unsigned int getNbThreads() { return vpThreadPool::instance().getNumThreads(); }
+
+/*
+  Look-up table of the histogram equalization of one channel of nbPixels
+  pixels. Return false if all the pixels have the same intensity, the
+  look-up table is then the identity.
+*/
+bool equalizationLut(const vpHistogram &hist, unsigned int nbPixels, unsigned char (&lut)[256])
+{
+  for (unsigned int x = 0; x < 256; x++) {
+    lut[x] = (unsigned char)x;
+  }
+
+  // Calculate the cumulative distribution function
+  unsigned int cdf[256];
+  unsigned int cdfMin = /*std::numeric_limits<unsigned int>::max()*/ UINT_MAX, cdfMax = 0;
+  unsigned int minValue =
+                   /*std::numeric_limits<unsigned int>::max()*/ UINT_MAX,
+               maxValue = 0;
+  cdf[0] = hist[0];
+
+  if (cdf[0] < cdfMin && cdf[0] > 0) {
+    cdfMin = cdf[0];
+    minValue = 0;
+  }
+
+  for (unsigned int i = 1; i < 256; i++) {
+    cdf[i] = cdf[i - 1] + hist[(unsigned char)i];
+
+    if (cdf[i] < cdfMin && cdf[i] > 0) {
+      cdfMin = cdf[i];
+      minValue = i;
+    }
+
+    if (cdf[i] > cdfMax) {
+      cdfMax = cdf[i];
+      maxValue = i;
+    }
+  }
+
+  if (nbPixels == cdfMin) {
+    // Only one brightness value in the image
+    return false;
+  }
+
+  // Construct the look-up table
+  for (unsigned int x = minValue; x <= maxValue; x++) {
+    lut[x] = vpMath::round((cdf[x] - cdfMin) / (double)(nbPixels - cdfMin) * 255.0);
+  }
+
+  return true;
+}
+
+/*
+  Look-up table stretching the intensities of one channel, from the first and
+  last non empty bins of its histogram, to [0 - 255].
+*/
+void stretchingLut(const vpHistogram &hist, unsigned char (&lut)[256])
+{
+  unsigned int min = 0, max = 255;
+  while (min < 255 && hist[(unsigned char)min] == 0) {
+    min++;
+  }
+  while (max > min && hist[(unsigned char)max] == 0) {
+    max--;
+  }
+
+  for (unsigned int x = 0; x < 256; x++) {
+    lut[x] = (unsigned char)x;
+  }
+  const unsigned int range = max - min;
+  if (range > 0) {
+    for (unsigned int x = min; x <= max; x++) {
+      lut[x] = (unsigned char)(255 * (x - min) / range);
+    }
+  }
+}
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 /*!
   \ingroup group_imgproc_brightness
 
@@ -86,7 +171,7 @@ void vp::adjust(vpImage<unsigned char> &I, const double alpha, const double beta
   }
 
   // Apply the transformation using a LUT
-  I.performLut(lut);
+  I.performLut(lut, getNbThreads());
 }
 
 /*!
@@ -123,14 +208,12 @@ void vp::adjust(vpImage<vpRGBa> &I, const double alpha, const double beta)
   // Construct the look-up table
   vpRGBa lut[256];
   for (unsigned int i = 0; i < 256; i++) {
-    lut[i].R = vpMath::saturate<unsigned char>(alpha * i + beta);
-    lut[i].G = vpMath::saturate<unsigned char>(alpha * i + beta);
-    lut[i].B = vpMath::saturate<unsigned char>(alpha * i + beta);
-    lut[i].A = vpMath::saturate<unsigned char>(alpha * i + beta);
+    const unsigned char value = vpMath::saturate<unsigned char>(alpha * i + beta);
+    lut[i] = vpRGBa(value, value, value, value);
   }
 
   // Apply the transformation using a LUT
-  I.performLut(lut);
+  I.performLut(lut, getNbThreads());
 }
 
 /*!
@@ -169,48 +252,12 @@ void vp::equalizeHistogram(vpImage<unsigned char> &I)
 
   // Calculate the histogram
   vpHistogram hist;
-  hist.calculate(I);
-
-  // Calculate the cumulative distribution function
-  unsigned int cdf[256];
-  unsigned int cdfMin = /*std::numeric_limits<unsigned int>::max()*/ UINT_MAX, cdfMax = 0;
-  unsigned int minValue =
-                   /*std::numeric_limits<unsigned int>::max()*/ UINT_MAX,
-               maxValue = 0;
-  cdf[0] = hist[0];
-
-  if (cdf[0] < cdfMin && cdf[0] > 0) {
-    cdfMin = cdf[0];
-    minValue = 0;
-  }
-
-  for (unsigned int i = 1; i < 256; i++) {
-    cdf[i] = cdf[i - 1] + hist[i];
+  hist.calculate(I, 256, getNbThreads());
 
-    if (cdf[i] < cdfMin && cdf[i] > 0) {
-      cdfMin = cdf[i];
-      minValue = i;
-    }
-
-    if (cdf[i] > cdfMax) {
-      cdfMax = cdf[i];
-      maxValue = i;
-    }
-  }
-
-  unsigned int nbPixels = I.getWidth() * I.getHeight();
-  if (nbPixels == cdfMin) {
-    // Only one brightness value in the image
-    return;
-  }
-
-  // Construct the look-up table
   unsigned char lut[256];
-  for (unsigned int x = minValue; x <= maxValue; x++) {
-    lut[x] = vpMath::round((cdf[x] - cdfMin) / (double)(nbPixels - cdfMin) * 255.0);
+  if (equalizationLut(hist, I.getSize(), lut)) {
+    I.performLut(lut, getNbThreads());
   }
-
-  I.performLut(lut);
 }
 
 /*!
@@ -249,41 +296,21 @@ void vp::equalizeHistogram(vpImage<vpRGBa> &I, const bool useHSV)
   }
 
   if (!useHSV) {
-    // Split the RGBa image into 4 images
-    vpImage<unsigned char> pR(I.getHeight(), I.getWidth());
-    vpImage<unsigned char> pG(I.getHeight(), I.getWidth());
-    vpImage<unsigned char> pB(I.getHeight(), I.getWidth());
-    vpImage<unsigned char> pa(I.getHeight(), I.getWidth());
-
-    vpImageConvert::split(I, &pR, &pG, &pB, &pa);
-
-    // Apply histogram equalization for each channel
-    vp::equalizeHistogram(pR);
-    vp::equalizeHistogram(pG);
-    vp::equalizeHistogram(pB);
-
-    // Merge the result in I
-    unsigned int size = I.getWidth() * I.getHeight();
-    unsigned char *ptrStart = (unsigned char *)I.bitmap;
-    unsigned char *ptrEnd = ptrStart + size * 4;
-    unsigned char *ptrCurrent = ptrStart;
-
-    unsigned int cpt = 0;
-    while (ptrCurrent != ptrEnd) {
-      *ptrCurrent = pR.bitmap[cpt];
-      ++ptrCurrent;
-
-      *ptrCurrent = pG.bitmap[cpt];
-      ++ptrCurrent;
-
-      *ptrCurrent = pB.bitmap[cpt];
-      ++ptrCurrent;
-
-      *ptrCurrent = pa.bitmap[cpt];
-      ++ptrCurrent;
-
-      cpt++;
+    // Histograms of the four channels in a single pass
+    vpHistogram histR, histG, histB, histA;
+    vpHistogram::calculate(I, histR, histG, histB, histA, 256, getNbThreads());
+
+    // Equalize the RGB channels independently, keep the alpha channel
+    unsigned char lutR[256], lutG[256], lutB[256];
+    equalizationLut(histR, I.getSize(), lutR);
+    equalizationLut(histG, I.getSize(), lutG);
+    equalizationLut(histB, I.getSize(), lutB);
+    vpRGBa lut[256];
+    for (unsigned int x = 0; x < 256; x++) {
+      lut[x] = vpRGBa(lutR[x], lutG[x], lutB[x], (unsigned char)x);
     }
+
+    I.performLut(lut, getNbThreads());
   } else {
     vpImage<unsigned char> hue(I.getHeight(), I.getWidth());
     vpImage<unsigned char> saturation(I.getHeight(), I.getWidth());
@@ -346,7 +373,7 @@ void vp::gammaCorrection(vpImage<unsigned char> &I, const double gamma)
     lut[i] = vpMath::saturate<unsigned char>(pow((double)i / 255.0, inverse_gamma) * 255.0);
   }
 
-  I.performLut(lut);
+  I.performLut(lut, getNbThreads());
 }
 
 /*!
@@ -384,13 +411,11 @@ void vp::gammaCorrection(vpImage<vpRGBa> &I, const double gamma)
   // Construct the look-up table
   vpRGBa lut[256];
   for (unsigned int i = 0; i < 256; i++) {
-    lut[i].R = vpMath::saturate<unsigned char>(pow((double)i / 255.0, inverse_gamma) * 255.0);
-    lut[i].G = vpMath::saturate<unsigned char>(pow((double)i / 255.0, inverse_gamma) * 255.0);
-    lut[i].B = vpMath::saturate<unsigned char>(pow((double)i / 255.0, inverse_gamma) * 255.0);
-    lut[i].A = vpMath::saturate<unsigned char>(pow((double)i / 255.0, inverse_gamma) * 255.0);
+    const unsigned char value = vpMath::saturate<unsigned char>(pow((double)i / 255.0, inverse_gamma) * 255.0);
+    lut[i] = vpRGBa(value, value, value, value);
   }
 
-  I.performLut(lut);
+  I.performLut(lut, getNbThreads());
 }
 
 /*!
@@ -417,23 +442,19 @@ void vp::gammaCorrection(const vpImage<vpRGBa> &I1, vpImage<vpRGBa> &I2, const d
 */
 void vp::stretchContrast(vpImage<unsigned char> &I)
 {
-  // Find min and max intensity values
-  unsigned char min = 255, max = 0;
-  I.getMinMaxValue(min, max);
+  if (I.getSize() == 0) {
+    return;
+  }
 
-  unsigned char range = max - min;
+  // Find min and max intensity values from the histogram
+  vpHistogram hist;
+  hist.calculate(I, 256, getNbThreads());
 
   // Construct the look-up table
   unsigned char lut[256];
-  if (range > 0) {
-    for (unsigned int x = min; x <= max; x++) {
-      lut[x] = 255 * (x - min) / range;
-    }
-  } else {
-    lut[min] = min;
-  }
+  stretchingLut(hist, lut);
 
-  I.performLut(lut);
+  I.performLut(lut, getNbThreads());
 }
 
 /*!
@@ -460,73 +481,26 @@ void vp::stretchContrast(const vpImage<unsigned char> &I1, vpImage<unsigned char
 */
 void vp::stretchContrast(vpImage<vpRGBa> &I)
 {
-  // Find min and max intensity values
-  vpRGBa min = 255, max = 0;
-
-  // Split the RGBa image into 4 images
-  vpImage<unsigned char> pR(I.getHeight(), I.getWidth());
-  vpImage<unsigned char> pG(I.getHeight(), I.getWidth());
-  vpImage<unsigned char> pB(I.getHeight(), I.getWidth());
-  vpImage<unsigned char> pa(I.getHeight(), I.getWidth());
-
-  vpImageConvert::split(I, &pR, &pG, &pB, &pa);
-  // Min max values calculated for each channel
-  unsigned char minChannel, maxChannel;
-  pR.getMinMaxValue(minChannel, maxChannel);
-  min.R = minChannel;
-  max.R = maxChannel;
-
-  pG.getMinMaxValue(minChannel, maxChannel);
-  min.G = minChannel;
-  max.G = maxChannel;
-
-  pB.getMinMaxValue(minChannel, maxChannel);
-  min.B = minChannel;
-  max.B = maxChannel;
-
-  pa.getMinMaxValue(minChannel, maxChannel);
-  min.A = minChannel;
-  max.A = maxChannel;
-
-  // Construct the look-up table
-  vpRGBa lut[256];
-  unsigned char rangeR = max.R - min.R;
-  if (rangeR > 0) {
-    for (unsigned int x = min.R; x <= max.R; x++) {
-      lut[x].R = 255 * (x - min.R) / rangeR;
-    }
-  } else {
-    lut[min.R].R = min.R;
-  }
-
-  unsigned char rangeG = max.G - min.G;
-  if (rangeG > 0) {
-    for (unsigned int x = min.G; x <= max.G; x++) {
-      lut[x].G = 255 * (x - min.G) / rangeG;
-    }
-  } else {
-    lut[min.G].G = min.G;
+  if (I.getSize() == 0) {
+    return;
   }
 
-  unsigned char rangeB = max.B - min.B;
-  if (rangeB > 0) {
-    for (unsigned int x = min.B; x <= max.B; x++) {
-      lut[x].B = 255 * (x - min.B) / rangeB;
-    }
-  } else {
-    lut[min.B].B = min.B;
-  }
+  // Find min and max intensity values of each channel from the histograms
+  vpHistogram histR, histG, histB, histA;
+  vpHistogram::calculate(I, histR, histG, histB, histA, 256, getNbThreads());
 
-  unsigned char rangeA = max.A - min.A;
-  if (rangeA > 0) {
-    for (unsigned int x = min.A; x <= max.A; x++) {
-      lut[x].A = 255 * (x - min.A) / rangeA;
-    }
-  } else {
-    lut[min.A].A = min.A;
+  // Construct the look-up table
+  unsigned char lutR[256], lutG[256], lutB[256], lutA[256];
+  stretchingLut(histR, lutR);
+  stretchingLut(histG, lutG);
+  stretchingLut(histB, lutB);
+  stretchingLut(histA, lutA);
+  vpRGBa lut[256];
+  for (unsigned int x = 0; x < 256; x++) {
+    lut[x] = vpRGBa(lutR[x], lutG[x], lutB[x], lutA[x]);
   }
 
-  I.performLut(lut);
+  I.performLut(lut, getNbThreads());
 }
 
 /*!
@@ -41,9 +41,127 @@
   \brief Additional image morphology functions.
 */
 
+#include <queue>
+
 #include <visp3/core/vpImageTools.h>
 #include <visp3/imgproc/vpImgproc.h>
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Set in fill the runs of consecutive pixels of mask that contain at least
+// one pixel of seeds
+void fillRuns(const uint64_t *seeds, const uint64_t *mask, uint64_t *fill, unsigned int nbWords)
+{
+  // Toward the last column: the carry of the addition of the seeds to the
+  // mask goes along the run of the seed and clears it
+  uint64_t carry = 0;
+  for (unsigned int k = 0; k < nbWords; k++) {
+    const uint64_t m = mask[k];
+    const uint64_t t = (seeds[k] | carry) & m;
+    const uint64_t up = (((m + t) ^ m) | t) & m;
+    fill[k] = up;
+    carry = up >> 63;
+  }
+
+  // Toward the first column: occluded fill by shifts of 1, 2, 4... pixels
+  carry = 0;
+  for (unsigned int k = nbWords; k-- > 0;) {
+    const uint64_t m = mask[k];
+    uint64_t gen = (seeds[k] | (carry << 63)) & m;
+    uint64_t pro = m;
+    gen |= pro & (gen >> 1);
+    pro &= pro >> 1;
+    gen |= pro & (gen >> 2);
+    pro &= pro >> 2;
+    gen |= pro & (gen >> 4);
+    pro &= pro >> 4;
+    gen |= pro & (gen >> 8);
+    pro &= pro >> 8;
+    gen |= pro & (gen >> 16);
+    pro &= pro >> 16;
+    gen |= pro & (gen >> 32);
+    fill[k] |= gen;
+    carry = gen & 1;
+  }
+}
+
+// Add to the pixels of a row their left and right neighbors
+void dilateRow(const uint64_t *src, uint64_t *dst, unsigned int nbWords)
+{
+  for (unsigned int k = 0; k < nbWords; k++) {
+    const uint64_t prev = k > 0 ? src[k - 1] : 0;
+    const uint64_t next = k + 1 < nbWords ? src[k + 1] : 0;
+    dst[k] = src[k] | (src[k] << 1) | (prev >> 63) | (src[k] >> 1) | (next << 63);
+  }
+}
+
+// Hybrid reconstruction algorithm of L. Vincent, "Morphological grayscale
+// reconstruction in image analysis: applications and efficient algorithms",
+// IEEE Trans. on Image Processing, 1993. J must be lower or equal to mask.
+void reconstructHybrid(const vpImage<unsigned char> &mask, vpImage<unsigned char> &J,
+                       const vpImageMorphology::vpConnexityType &connexity)
+{
+  const int height = (int)J.getHeight(), width = (int)J.getWidth();
+  // Neighbors scanned before the current pixel in raster order, the ones
+  // after it are the opposite
+  const int di[4] = {0, -1, -1, -1}, dj[4] = {-1, 0, -1, 1};
+  const int nbNeighbors = connexity == vpImageMorphology::CONNEXITY_4 ? 2 : 4;
+
+  // Raster scan
+  for (int i = 0; i < height; i++) {
+    for (int j = 0; j < width; j++) {
+      unsigned char v = J[i][j];
+      for (int n = 0; n < nbNeighbors; n++) {
+        const int y = i + di[n], x = j + dj[n];
+        if (y >= 0 && x >= 0 && x < width) {
+          v = std::max(v, J[y][x]);
+        }
+      }
+      J[i][j] = std::min(v, mask[i][j]);
+    }
+  }
+
+  // Anti-raster scan, the pixels that can still propagate are queued
+  std::queue<std::pair<int, int> > fifo;
+  for (int i = height - 1; i >= 0; i--) {
+    for (int j = width - 1; j >= 0; j--) {
+      unsigned char v = J[i][j];
+      for (int n = 0; n < nbNeighbors; n++) {
+        const int y = i - di[n], x = j - dj[n];
+        if (y < height && x >= 0 && x < width) {
+          v = std::max(v, J[y][x]);
+        }
+      }
+      J[i][j] = std::min(v, mask[i][j]);
+
+      for (int n = 0; n < nbNeighbors; n++) {
+        const int y = i - di[n], x = j - dj[n];
+        if (y < height && x >= 0 && x < width && J[y][x] < J[i][j] && J[y][x] < mask[y][x]) {
+          fifo.push(std::make_pair(i, j));
+          break;
+        }
+      }
+    }
+  }
+
+  // Propagation
+  while (!fifo.empty()) {
+    const int i = fifo.front().first, j = fifo.front().second;
+    fifo.pop();
+    for (int n = 0; n < 2 * nbNeighbors; n++) {
+      const int y = n < nbNeighbors ? i + di[n] : i - di[n - nbNeighbors];
+      const int x = n < nbNeighbors ? j + dj[n] : j - dj[n - nbNeighbors];
+      if (y >= 0 && y < height && x >= 0 && x < width && J[y][x] < J[i][j] && mask[y][x] != J[y][x]) {
+        J[y][x] = std::min(J[i][j], mask[y][x]);
+        fifo.push(std::make_pair(y, x));
+      }
+    }
+  }
+}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 /*!
   \ingroup group_imgproc_morph
 
@@ -101,26 +219,10 @@ void vp::fillHoles(vpImage<unsigned char> &I
     }
   }
 #else
-  // Create flood fill mask
-  vpImage<unsigned char> flood_fill_mask(I.getHeight() + 2, I.getWidth() + 2, 0);
-  // Copy I to mask + add border padding
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
-    memcpy(flood_fill_mask[i + 1] + 1, I[i], sizeof(unsigned char) * I.getWidth());
-  }
-
-  // Perform flood fill
-  vp::floodFill(flood_fill_mask, vpImagePoint(0, 0), 0, 255);
-
-  // Get current mask
-  vpImage<unsigned char> mask(I.getHeight(), I.getWidth());
-  for (unsigned int i = 0; i < mask.getHeight(); i++) {
-    memcpy(mask[i], flood_fill_mask[i + 1] + 1, sizeof(unsigned char) * mask.getWidth());
-  }
-
-  // Get image with holes filled
-  vpImage<unsigned char> I_white(I.getHeight(), I.getWidth(), 255), I_holes;
-  vpImageTools::imageSubtract(I_white, mask, I_holes);
-  vpImageTools::imageAdd(I, I_holes, I, true);
+  // The background pixels that are not connected to the border are holes
+  vpBinaryImage B(I);
+  fillHoles(B);
+  B.convert(I);
 #endif
 }
 
@@ -157,24 +259,143 @@ void vp::reconstruct(const vpImage<unsigned char> &marker, const vpImage<unsigne
     return;
   }
 
-  vpImage<unsigned char> h_k = marker;
-  h_kp1 = h_k;
+  // Start from one geodesic dilatation, which is lower than the mask
+  h_kp1 = marker;
+  vpImageMorphology::dilatation(h_kp1, connexity);
+  for (unsigned int i = 0; i < h_kp1.getHeight(); i++) {
+    for (unsigned int j = 0; j < h_kp1.getWidth(); j++) {
+      h_kp1[i][j] = std::min(h_kp1[i][j], mask[i][j]);
+    }
+  }
 
-  do {
-    // Dilatation
-    vpImageMorphology::dilatation(h_kp1, connexity);
+  reconstructHybrid(mask, h_kp1, connexity);
+}
 
-    // Keep min
-    for (unsigned int i = 0; i < h_kp1.getHeight(); i++) {
-      for (unsigned int j = 0; j < h_kp1.getWidth(); j++) {
-        h_kp1[i][j] = std::min(h_kp1[i][j], mask[i][j]);
-      }
+/*!
+  \ingroup group_imgproc_morph
+
+  Fill the holes in a bit-packed binary image: set the pixels that are not
+  set and that are not 4-connected to the border of the image through pixels
+  that are not set.
+
+  \param I : Input binary image.
+*/
+void vp::fillHoles(vpBinaryImage &I)
+{
+  if (I.isEmpty()) {
+    return;
+  }
+
+  vpBinaryImage background = I;
+  background.invert();
+
+  // The background pixels of the border are the markers
+  vpBinaryImage marker(I.getHeight(), I.getWidth());
+  const unsigned int nbWords = I.getNbWords();
+  for (unsigned int k = 0; k < nbWords; k++) {
+    marker.getRow(0)[k] = background.getRow(0)[k];
+    marker.getRow(I.getHeight() - 1)[k] = background.getRow(I.getHeight() - 1)[k];
+  }
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    marker.setValue(i, 0, background.getValue(i, 0));
+    marker.setValue(i, I.getWidth() - 1, background.getValue(i, I.getWidth() - 1));
+  }
+
+  reconstruct(marker, background, I, vpImageMorphology::CONNEXITY_4);
+  I.invert();
+}
+
+/*!
+  \ingroup group_imgproc_morph
+
+  Perform the morphological reconstruction by dilatation of the bit-packed
+  binary image \a marker under the image \a mask: \a I contains the pixels
+  of \a mask that are connected through pixels of \a mask to a pixel set in
+  both \a marker and \a mask.
+
+  The runs of pixels of a row are filled 64 pixels at a time, and the rows
+  whose pixels changed propagate to their neighboring rows until no pixel
+  is added.
+
+  \param marker : Binary image marker.
+  \param mask : Binary image mask.
+  \param I : Image morphologically reconstructed.
+  \param connexity : Type of connexity.
+*/
+void vp::reconstruct(const vpBinaryImage &marker, const vpBinaryImage &mask, vpBinaryImage &I,
+                     const vpImageMorphology::vpConnexityType &connexity)
+{
+  if (marker.getHeight() != mask.getHeight() || marker.getWidth() != mask.getWidth()) {
+    std::cerr << "marker.getHeight() != mask.getHeight() || "
+                 "marker.getWidth() != mask.getWidth()"
+              << std::endl;
+    return;
+  }
+
+  if (marker.isEmpty()) {
+    std::cerr << "Input images are empty!" << std::endl;
+    return;
+  }
+
+  const unsigned int height = mask.getHeight(), nbWords = mask.getNbWords();
+  std::vector<uint64_t> seeds(nbWords), fill(nbWords);
+  std::vector<unsigned int> rows;
+  std::vector<bool> isQueued(height, false);
+
+  I.resize(height, mask.getWidth());
+  for (unsigned int i = 0; i < height; i++) {
+    const uint64_t *markerRow = marker.getRow(i);
+    const uint64_t *maskRow = mask.getRow(i);
+    uint64_t nonZero = 0;
+    for (unsigned int k = 0; k < nbWords; k++) {
+      seeds[k] = markerRow[k] & maskRow[k];
+      nonZero |= seeds[k];
     }
+    if (nonZero) {
+      fillRuns(&seeds[0], maskRow, I.getRow(i), nbWords);
+      rows.push_back(i);
+      isQueued[i] = true;
+    }
+  }
 
-    if (h_kp1 == h_k) {
-      break;
+  std::vector<uint64_t> source(nbWords);
+  while (!rows.empty()) {
+    const unsigned int i = rows.back();
+    rows.pop_back();
+    isQueued[i] = false;
+
+    if (connexity == vpImageMorphology::CONNEXITY_4) {
+      std::copy(I.getRow(i), I.getRow(i) + nbWords, source.begin());
+    } else {
+      dilateRow(I.getRow(i), &source[0], nbWords);
     }
 
-    h_k = h_kp1;
-  } while (true);
+    for (unsigned int n = 0; n < 2; n++) {
+      if ((n == 0 && i == 0) || (n == 1 && i + 1 == height)) {
+        continue;
+      }
+      const unsigned int y = n == 0 ? i - 1 : i + 1;
+      const uint64_t *maskRow = mask.getRow(y);
+      uint64_t *row = I.getRow(y);
+
+      // The filled runs contain all their pixels, only the new seeds matter
+      uint64_t nonZero = 0;
+      for (unsigned int k = 0; k < nbWords; k++) {
+        seeds[k] = source[k] & maskRow[k] & ~row[k];
+        nonZero |= seeds[k];
+      }
+      if (!nonZero) {
+        continue;
+      }
+
+      fillRuns(&seeds[0], maskRow, &fill[0], nbWords);
+      for (unsigned int k = 0; k < nbWords; k++) {
+        row[k] |= fill[k];
+      }
+      if (!isQueued[y]) {
+        rows.push_back(y);
+        isQueued[y] = true;
+      }
+    }
+  }
 }
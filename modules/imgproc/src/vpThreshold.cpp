@@ -42,7 +42,7 @@
 */
 
 #include <visp3/core/vpHistogram.h>
-#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpThreadPool.h>
 #include <visp3/imgproc/vpImgproc.h>
 
 namespace
@@ -378,8 +378,10 @@ unsigned char vp::autoThreshold(vpImage<unsigned char> &I, const vpAutoThreshold
     return 0;
   }
 
-  // Compute image histogram
-  vpHistogram histogram(I);
+  // Compute image histogram on the threads of vpThreadPool
+  const unsigned int nbThreads = vpThreadPool::instance().getNumThreads();
+  vpHistogram histogram;
+  histogram.calculate(I, 256, nbThreads);
   int threshold = -1;
 
   switch (method) {
@@ -412,9 +414,12 @@ unsigned char vp::autoThreshold(vpImage<unsigned char> &I, const vpAutoThreshold
   }
 
   if (threshold != -1) {
-    // Threshold
-    vpImageTools::binarise(I, (unsigned char)threshold, (unsigned char)255, backgroundValue, foregroundValue,
-                           foregroundValue);
+    // Threshold, as vpImageTools::binarise() with a look-up table applied in parallel
+    unsigned char lut[256];
+    for (unsigned int i = 0; i < 256; i++) {
+      lut[i] = i < (unsigned int)threshold ? backgroundValue : foregroundValue;
+    }
+    I.performLut(lut, nbThreads);
   }
 
   return threshold;
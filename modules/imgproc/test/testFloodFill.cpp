@@ -295,6 +295,21 @@ int main(int argc, const char **argv)
     std::cout << "\n(I_test_flood_fill_8_connexity == I_check_8_connexity)? "
               << (I_test_flood_fill_8_connexity == I_check_8_connexity) << std::endl;
 
+    // Test flood fill on bit-packed test data
+    vpImage<unsigned char> I_test_bit_packed;
+    vpBinaryImage B_test_flood_fill_4_connexity(vpImage<unsigned char>(image_data, 8, 8, true));
+    vpBinaryImage B_test_flood_fill_8_connexity = B_test_flood_fill_4_connexity;
+    vp::floodFill(B_test_flood_fill_4_connexity, vpImagePoint(2, 2), true, vpImageMorphology::CONNEXITY_4);
+    B_test_flood_fill_4_connexity.convert(I_test_bit_packed, 1, 0);
+    if (I_test_bit_packed != I_check_4_connexity) {
+      throw vpException(vpException::fatalError, "Problem with bit-packed vp::floodFill() and 4-connexity!");
+    }
+    vp::floodFill(B_test_flood_fill_8_connexity, vpImagePoint(2, 2), true, vpImageMorphology::CONNEXITY_8);
+    B_test_flood_fill_8_connexity.convert(I_test_bit_packed, 1, 0);
+    if (I_test_bit_packed != I_check_8_connexity) {
+      throw vpException(vpException::fatalError, "Problem with bit-packed vp::floodFill() and 8-connexity!");
+    }
+
     // Read Klimt.ppm
     filename = vpIoTools::createFilePath(ipath, "Klimt/Klimt.pgm");
     vpImage<unsigned char> I_klimt;
@@ -325,6 +340,22 @@ int main(int argc, const char **argv)
     filename = vpIoTools::createFilePath(opath, "Klimt_flood_fill_8_connexity.pgm");
     vpImageIo::write(I_klimt_flood_fill_8_connexity, filename);
 
+    vpImage<unsigned char> I_klimt_bit_packed;
+    vpImageMorphology::vpConnexityType connexities[2] = {vpImageMorphology::CONNEXITY_4, vpImageMorphology::CONNEXITY_8};
+    for (int c = 0; c < 2; c++) {
+      vpBinaryImage B_klimt(I_klimt);
+      t = vpTime::measureTimeMs();
+      vp::floodFill(B_klimt, vpImagePoint(seed_y, seed_x), true, connexities[c]);
+      t = vpTime::measureTimeMs() - t;
+      std::cout << "Flood fill on bit-packed Klimt image (" << (c == 0 ? 4 : 8) << "-connexity): " << t << " ms"
+                << std::endl;
+
+      B_klimt.convert(I_klimt_bit_packed);
+      if (I_klimt_bit_packed != (c == 0 ? I_klimt_flood_fill_4_connexity : I_klimt_flood_fill_8_connexity)) {
+        throw vpException(vpException::fatalError, "Problem with bit-packed vp::floodFill() on Klimt image!");
+      }
+    }
+
 #if VISP_HAVE_OPENCV_VERSION >= 0x020408
     cv::Mat matImg_klimt_4_connexity, matImg_klimt_8_connexity;
     vpImageConvert::convert(I_klimt, matImg_klimt_4_connexity);
@@ -0,0 +1,261 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the histogram based look-up tables of the imgproc module.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testImgprocLut.cpp
+
+  \brief Compare vp::stretchContrast(), vp::equalizeHistogram() and
+  vp::autoThreshold() with the per plane computations they replace, on
+  grey and color images, with 1 and 4 threads.
+*/
+
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <visp3/core/vpHistogram.h>
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpThreadPool.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/imgproc/vpImgproc.h>
+
+namespace
+{
+// Previous implementation of vp::equalizeHistogram() on a grey image
+void equalizeHistogramReference(vpImage<unsigned char> &I)
+{
+  vpHistogram hist;
+  hist.calculate(I);
+
+  unsigned int cdf[256];
+  unsigned int cdfMin = UINT_MAX, cdfMax = 0;
+  unsigned int minValue = UINT_MAX, maxValue = 0;
+  cdf[0] = hist[0];
+  if (cdf[0] < cdfMin && cdf[0] > 0) {
+    cdfMin = cdf[0];
+    minValue = 0;
+  }
+  for (unsigned int i = 1; i < 256; i++) {
+    cdf[i] = cdf[i - 1] + hist[i];
+    if (cdf[i] < cdfMin && cdf[i] > 0) {
+      cdfMin = cdf[i];
+      minValue = i;
+    }
+    if (cdf[i] > cdfMax) {
+      cdfMax = cdf[i];
+      maxValue = i;
+    }
+  }
+
+  unsigned int nbPixels = I.getWidth() * I.getHeight();
+  if (nbPixels == cdfMin) {
+    return;
+  }
+
+  unsigned char lut[256];
+  for (unsigned int x = 0; x < 256; x++) {
+    lut[x] = (unsigned char)x;
+  }
+  for (unsigned int x = minValue; x <= maxValue; x++) {
+    lut[x] = vpMath::round((cdf[x] - cdfMin) / (double)(nbPixels - cdfMin) * 255.0);
+  }
+  I.performLut(lut);
+}
+
+// Look-up table of the previous implementation of vp::stretchContrast() for
+// a channel of intensities in [min, max]
+void stretchingLutReference(unsigned char min, unsigned char max, unsigned char (&lut)[256])
+{
+  for (unsigned int x = 0; x < 256; x++) {
+    lut[x] = (unsigned char)x;
+  }
+  unsigned char range = max - min;
+  if (range > 0) {
+    for (unsigned int x = min; x <= max; x++) {
+      lut[x] = 255 * (x - min) / range;
+    }
+  }
+}
+
+void stretchContrastReference(vpImage<unsigned char> &I)
+{
+  unsigned char min = 255, max = 0;
+  I.getMinMaxValue(min, max);
+  unsigned char lut[256];
+  stretchingLutReference(min, max, lut);
+  I.performLut(lut);
+}
+
+// Previous implementations on color images: each plane is processed on its
+// own, then the planes are merged
+void splitPlanes(const vpImage<vpRGBa> &I, vpImage<unsigned char> (&planes)[4])
+{
+  for (unsigned int c = 0; c < 4; c++) {
+    planes[c].resize(I.getHeight(), I.getWidth());
+  }
+  vpImageConvert::split(I, &planes[0], &planes[1], &planes[2], &planes[3]);
+}
+
+void mergePlanes(const vpImage<unsigned char> (&planes)[4], vpImage<vpRGBa> &I)
+{
+  for (unsigned int k = 0; k < I.getSize(); k++) {
+    I.bitmap[k] = vpRGBa(planes[0].bitmap[k], planes[1].bitmap[k], planes[2].bitmap[k], planes[3].bitmap[k]);
+  }
+}
+
+void equalizeHistogramReference(vpImage<vpRGBa> &I)
+{
+  vpImage<unsigned char> planes[4];
+  splitPlanes(I, planes);
+  for (unsigned int c = 0; c < 3; c++) {
+    equalizeHistogramReference(planes[c]);
+  }
+  mergePlanes(planes, I);
+}
+
+void stretchContrastReference(vpImage<vpRGBa> &I)
+{
+  vpImage<unsigned char> planes[4];
+  splitPlanes(I, planes);
+  for (unsigned int c = 0; c < 4; c++) {
+    stretchContrastReference(planes[c]);
+  }
+  mergePlanes(planes, I);
+}
+
+// Image with a different range of intensities in each channel. The grey
+// image is bimodal so that the thresholds are meaningful
+void createImages(unsigned int height, unsigned int width, vpImage<unsigned char> &I, vpImage<vpRGBa> &I_color)
+{
+  vpUniRand rng(height * width);
+  I.resize(height, width);
+  I_color.resize(height, width);
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      double noise = rng.uniform(-20.0, 20.0);
+      I[i][j] = (unsigned char)vpMath::round((j < width / 3 ? 60 : 170) + noise);
+      I_color[i][j] = vpRGBa((unsigned char)rng.uniform(30, 200), (unsigned char)rng.uniform(0, 256),
+                             (unsigned char)rng.uniform(100, 110), (unsigned char)rng.uniform(10, 240));
+    }
+  }
+}
+
+template <class Type> bool sameImages(const std::string &name, const vpImage<Type> &I, const vpImage<Type> &I_ref)
+{
+  if (I.getHeight() != I_ref.getHeight() || I.getWidth() != I_ref.getWidth() ||
+      memcmp(I.bitmap, I_ref.bitmap, I.getSize() * sizeof(Type)) != 0) {
+    std::cerr << name << ": the image differs from the per plane result" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool testImages(const std::string &name, const vpImage<unsigned char> &I_grey, const vpImage<vpRGBa> &I_color,
+                bool testThresholds)
+{
+  bool success = true;
+
+  vpImage<unsigned char> I = I_grey, I_ref = I_grey;
+  vp::stretchContrast(I);
+  stretchContrastReference(I_ref);
+  success = sameImages(name + ", grey stretchContrast", I, I_ref) && success;
+
+  I = I_grey;
+  I_ref = I_grey;
+  vp::equalizeHistogram(I);
+  equalizeHistogramReference(I_ref);
+  success = sameImages(name + ", grey equalizeHistogram", I, I_ref) && success;
+
+  vpImage<vpRGBa> I_rgba = I_color, I_rgba_ref = I_color;
+  vp::stretchContrast(I_rgba);
+  stretchContrastReference(I_rgba_ref);
+  success = sameImages(name + ", RGBa stretchContrast", I_rgba, I_rgba_ref) && success;
+
+  I_rgba = I_color;
+  I_rgba_ref = I_color;
+  vp::equalizeHistogram(I_rgba);
+  equalizeHistogramReference(I_rgba_ref);
+  success = sameImages(name + ", RGBa equalizeHistogram", I_rgba, I_rgba_ref) && success;
+
+  const vp::vpAutoThresholdMethod methods[] = {vp::AUTO_THRESHOLD_HUANG, vp::AUTO_THRESHOLD_INTERMODES,
+                                               vp::AUTO_THRESHOLD_ISODATA, vp::AUTO_THRESHOLD_MEAN,
+                                               vp::AUTO_THRESHOLD_OTSU, vp::AUTO_THRESHOLD_TRIANGLE};
+  for (unsigned int k = 0; k < sizeof(methods) / sizeof(methods[0]) && testThresholds; k++) {
+    I = I_grey;
+    unsigned char threshold = vp::autoThreshold(I, methods[k], 0, 255);
+    I_ref = I_grey;
+    vpImageTools::binarise(I_ref, threshold, (unsigned char)255, (unsigned char)0, (unsigned char)255,
+                           (unsigned char)255);
+    success = sameImages(name + ", autoThreshold", I, I_ref) && success;
+    if (methods[k] == vp::AUTO_THRESHOLD_OTSU && (threshold < 80 || threshold > 150)) {
+      std::cerr << name << ": Otsu threshold " << (int)threshold << " does not separate the modes" << std::endl;
+      success = false;
+    }
+  }
+
+  return success;
+}
+} // namespace
+
+int main()
+{
+  bool success = true;
+  const unsigned int nbThreads[] = {1, 4};
+  for (unsigned int t = 0; t < sizeof(nbThreads) / sizeof(nbThreads[0]); t++) {
+    vpThreadPool::instance().setNumThreads(nbThreads[t]);
+    std::string threads = nbThreads[t] == 1 ? "1 thread" : "4 threads";
+
+    // Odd sizes, large enough to be split between the threads
+    vpImage<unsigned char> I;
+    vpImage<vpRGBa> I_color;
+    createImages(481, 639, I, I_color);
+    success = testImages("481x639 image, " + threads, I, I_color, true) && success;
+
+    // Single intensity in each channel, that has no threshold
+    I = 42;
+    I_color = vpRGBa(10, 20, 30, 40);
+    success = testImages("uniform image, " + threads, I, I_color, false) && success;
+  }
+
+  if (!success) {
+    std::cerr << "Test failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test succeed" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,226 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * KLT (Kanade-Lucas-Tomasi) feature tracker working on ViSP images.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpKltTracker.h
+
+  \brief KLT (Kanade-Lucas-Tomasi) feature tracker working on ViSP images
+  without third party library.
+*/
+
+#ifndef vpKltTracker_h
+#define vpKltTracker_h
+
+#include <vector>
+
+#include <visp3/core/vpColor.h>
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpImagePoint.h>
+#include <visp3/core/vpImagePyramid.h>
+
+/*!
+  \class vpKltTracker
+
+  \ingroup module_klt
+
+  \brief KLT (Kanade-Lucas-Tomasi) feature tracker working directly on
+  vpImage<unsigned char>, without OpenCV.
+
+  It offers the same interface as vpKltOpencv with image points expressed as
+  vpImagePoint, and the same default parameters:
+
+  - initTracking() detects the corners of an image with the Shi-Tomasi
+    criterion, i.e. the minimal eigenvalue of the gradient covariance matrix
+    over a setBlockSize() neighborhood, or with the Harris response when
+    setUseHarris() is set. The local maxima above setQuality() times the best
+    response are kept from the strongest one, at least setMinDistance()
+    apart from each other thanks to a grid of cells of that size. Their
+    location is then refined to sub-pixel accuracy.
+  - track() follows the features with the iterative pyramidal Lucas-Kanade
+    method over setWindowSize() windows and setPyramidLevels() levels of a
+    vpImagePyramid. The windows are interpolated and summed in fixed-point
+    arithmetic, with SSE2 instructions when available, and the features are
+    shared between the threads of vpThreadPool. The features whose gradient
+    matrix has a normalized minimal eigenvalue below setMinEigThreshold() or
+    whose window leaves the image are removed.
+
+  The pyramid of the image can be given to track() when it is already built
+  for other algorithms processing the same frame.
+
+  \code
+#include <visp3/klt/vpKltTracker.h>
+
+int main()
+{
+  vpImage<unsigned char> I(480, 640);
+  // Acquire I
+  vpKltTracker tracker;
+  tracker.setMaxFeatures(200);
+  tracker.setWindowSize(10);
+  tracker.initTracking(I);
+  for (int frame = 0; frame < 100; frame++) {
+    // Acquire I
+    tracker.track(I);
+    for (int k = 0; k < tracker.getNbFeatures(); k++) {
+      long id;
+      float x, y;
+      tracker.getFeature(k, id, x, y);
+    }
+  }
+}
+  \endcode
+
+  \sa vpKltOpencv
+*/
+class VISP_EXPORT vpKltTracker
+{
+public:
+  vpKltTracker();
+
+  void addFeature(const float &x, const float &y);
+  void addFeature(const long &id, const float &x, const float &y);
+  void addFeature(const vpImagePoint &f);
+
+  void display(const vpImage<unsigned char> &I, const vpColor &color = vpColor::red, unsigned int thickness = 1) const;
+  void display(const vpImage<vpRGBa> &I, const vpColor &color = vpColor::red, unsigned int thickness = 1) const;
+
+  //! Get the size of the averaging block used to detect the features.
+  int getBlockSize() const { return m_blockSize; }
+  void getFeature(const int &index, long &id, float &x, float &y) const;
+  //! Get the list of current features.
+  const std::vector<vpImagePoint> &getFeatures() const { return m_points[1]; }
+  //! Get the unique id of each feature.
+  const std::vector<long> &getFeaturesId() const { return m_points_id; }
+  //! Get the free parameter of the Harris detector.
+  double getHarrisFreeParameter() const { return m_harris_k; }
+  //! Get the maximum number of features to track in the image.
+  int getMaxFeatures() const { return m_maxCount; }
+  //! Get the maximal number of iterations of the feature refinements.
+  int getMaxIterations() const { return m_maxIterations; }
+  //! Get the minimal Euclidean distance between detected corners during
+  //! initialization.
+  double getMinDistance() const { return m_minDistance; }
+  //! Get the minimal eigenvalue threshold used to reject a feature during the
+  //! tracking.
+  double getMinEigThreshold() const { return m_minEigThreshold; }
+  //! Get the number of current features.
+  int getNbFeatures() const { return static_cast<int>(m_points[1].size()); }
+  //! Get the number of previous features.
+  int getNbPrevFeatures() const { return static_cast<int>(m_points[0].size()); }
+  //! Get the list of previous features.
+  const std::vector<vpImagePoint> &getPrevFeatures() const { return m_points[0]; }
+  //! Get the maximal pyramid level.
+  int getPyramidLevels() const { return m_pyrMaxLevel; }
+  //! Get the parameter characterizing the minimal accepted quality of image
+  //! corners.
+  double getQuality() const { return m_qualityLevel; }
+  //! Get the displacement below which a feature refinement stops.
+  double getTerminationEpsilon() const { return m_epsilon; }
+  //! Get the window size used to track the features.
+  int getWindowSize() const { return m_winSize; }
+  //! Return true if the Harris response is used instead of the minimal
+  //! eigenvalue to detect the corners.
+  bool getUseHarris() const { return m_useHarrisDetector; }
+
+  void initTracking(const vpImage<unsigned char> &I, const vpImage<unsigned char> *mask = NULL);
+  void initTracking(const vpImage<unsigned char> &I, const std::vector<vpImagePoint> &pts);
+  void initTracking(const vpImage<unsigned char> &I, const std::vector<vpImagePoint> &pts,
+                    const std::vector<long> &ids);
+
+  void setBlockSize(int blockSize);
+  void setHarrisFreeParameter(double harris_k);
+  void setInitialGuess(const std::vector<vpImagePoint> &guess_pts);
+  void setInitialGuess(const std::vector<vpImagePoint> &init_pts, const std::vector<vpImagePoint> &guess_pts,
+                       const std::vector<long> &fid);
+  void setMaxFeatures(int maxCount);
+  void setMaxIterations(int maxIterations);
+  void setMinDistance(double minDistance);
+  void setMinEigThreshold(double minEigThreshold);
+  void setPyramidLevels(int pyrMaxLevel);
+  void setQuality(double qualityLevel);
+  void setTerminationEpsilon(double epsilon);
+  void setUseHarris(bool useHarrisDetector);
+  void setWindowSize(int winSize);
+  void suppressFeature(const int &index);
+
+  void track(const vpImage<unsigned char> &I);
+  void track(const vpImagePyramid &pyramid);
+
+private:
+  void buildDerivatives(const std::vector<const vpImage<unsigned char> *> &levels, unsigned int nbLevels);
+  void detectFeatures(const vpImage<unsigned char> &I, const vpImage<unsigned char> *mask);
+  void refineCorners(const vpImage<unsigned char> &I);
+  void setImage(const vpImage<unsigned char> &I);
+  void setLevels(const vpImagePyramid &pyramid, std::vector<const vpImage<unsigned char> *> &levels) const;
+  void setPrevLevels();
+  void trackFeatures();
+
+  //! Pyramids built by the tracker for the previous and current images
+  vpImagePyramid m_pyramids[2];
+  //! Index of the pyramid of the last tracked image in m_pyramids
+  unsigned int m_current;
+  //! Levels of the last tracked image kept when its pyramid was given to
+  //! track()
+  std::vector<vpImage<unsigned char> > m_prevLevelsCopy;
+  //! True when the last tracked image is in m_prevLevelsCopy rather than in
+  //! m_pyramids[m_current]
+  bool m_prevIsCopy;
+  //! Levels of the previous and current images used by the tracking, set at
+  //! each call to track() from the storage above so that they never point
+  //! into another tracker the object was copied from
+  std::vector<const vpImage<unsigned char> *> m_prevLevels, m_curLevels;
+  //! Scharr derivatives along u and v of the levels of the previous pyramid
+  std::vector<vpImage<short> > m_derivU, m_derivV;
+  //! Previous [0] and current [1] feature locations
+  std::vector<vpImagePoint> m_points[2];
+  //! Feature ids
+  std::vector<long> m_points_id;
+  int m_maxCount;
+  int m_maxIterations;
+  double m_epsilon;
+  int m_winSize;
+  double m_qualityLevel;
+  double m_minDistance;
+  double m_minEigThreshold;
+  double m_harris_k;
+  int m_blockSize;
+  bool m_useHarrisDetector;
+  int m_pyrMaxLevel;
+  long m_next_points_id;
+  bool m_initial_guess;
+};
+
+#endif
@@ -0,0 +1,1271 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * KLT (Kanade-Lucas-Tomasi) feature tracker working on ViSP images.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpKltTracker.cpp
+
+  \brief KLT (Kanade-Lucas-Tomasi) feature tracker working on ViSP images
+  without third party library.
+*/
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <sstream>
+
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpDisplay.h>
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpThreadPool.h>
+#include <visp3/core/vpTrackingException.h>
+#include <visp3/klt/vpKltTracker.h>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Bits of the fixed-point bilinear interpolation weights
+const int W_BITS = 14;
+// The interpolated intensities keep 5 fractional bits, so that they have the
+// same scale as the Scharr derivatives, that are 32 times the gradient
+const int I_BITS = W_BITS - 5;
+// Scale of the window sums of products of intensities and derivatives
+const float FLT_SCALE = 1.f / (1 << 20);
+
+inline int descale(int x, int n) { return (x + (1 << (n - 1))) >> n; }
+
+inline int clampIndex(int x, int size) { return x < 0 ? 0 : (x >= size ? size - 1 : x); }
+
+// Fixed-point bilinear interpolation weights of the fractional parts a, b
+struct vpBilinearWeights {
+  vpBilinearWeights(float a, float b)
+  {
+    w00 = vpMath::round((1.f - a) * (1.f - b) * (1 << W_BITS));
+    w01 = vpMath::round(a * (1.f - b) * (1 << W_BITS));
+    w10 = vpMath::round((1.f - a) * b * (1 << W_BITS));
+    w11 = (1 << W_BITS) - w00 - w01 - w10;
+  }
+  int w00, w01, w10, w11;
+};
+
+// Pointers to the four neighbors of pixel (v, u) of an image of size h x w,
+// with the pixels outside the image replaced by the nearest border pixel
+template <typename Type>
+inline void getNeighbors(const Type *src, int w, int h, int u, int v, const Type *&p00, const Type *&p01,
+                         const Type *&p10, const Type *&p11)
+{
+  int u0 = clampIndex(u, w), u1 = clampIndex(u + 1, w);
+  int v0 = clampIndex(v, h), v1 = clampIndex(v + 1, h);
+  p00 = src + v0 * w + u0;
+  p01 = src + v0 * w + u1;
+  p10 = src + v1 * w + u0;
+  p11 = src + v1 * w + u1;
+}
+
+/*
+  Scharr derivatives along u and v of the rows [begin, end) of an image,
+  with the border pixels replicated. They are 32 times the gradient.
+*/
+class vpScharrBody : public vpParallelForBody
+{
+public:
+  vpScharrBody(const vpImage<unsigned char> &I, vpImage<short> &dU, vpImage<short> &dV)
+    : m_I(I), m_dU(dU), m_dV(dV)
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    const int w = static_cast<int>(m_I.getWidth()), h = static_cast<int>(m_I.getHeight());
+    // Vertical smoothing and difference of the rows, with one replicated
+    // pixel on each side
+    std::vector<short> smooth(static_cast<size_t>(w + 2)), diff(static_cast<size_t>(w + 2));
+    short *s = &smooth[1], *d = &diff[1];
+#if VISP_HAVE_SSE2
+    const bool useSSE2 = vpCPUFeatures::checkSSE2();
+    const __m128i zero = _mm_setzero_si128(), three = _mm_set1_epi16(3), ten = _mm_set1_epi16(10);
+#endif
+
+    for (int i = begin; i < end; i++) {
+      const unsigned char *r0 = m_I[clampIndex(i - 1, h)], *r1 = m_I[i], *r2 = m_I[clampIndex(i + 1, h)];
+      int j = 0;
+#if VISP_HAVE_SSE2
+      if (useSSE2) {
+        for (; j + 8 <= w; j += 8) {
+          __m128i v0 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(r0 + j)), zero);
+          __m128i v1 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(r1 + j)), zero);
+          __m128i v2 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(r2 + j)), zero);
+          _mm_storeu_si128((__m128i *)(s + j),
+                           _mm_add_epi16(_mm_mullo_epi16(_mm_add_epi16(v0, v2), three), _mm_mullo_epi16(v1, ten)));
+          _mm_storeu_si128((__m128i *)(d + j), _mm_sub_epi16(v2, v0));
+        }
+      }
+#endif
+      for (; j < w; j++) {
+        s[j] = static_cast<short>((r0[j] + r2[j]) * 3 + r1[j] * 10);
+        d[j] = static_cast<short>(r2[j] - r0[j]);
+      }
+      s[-1] = s[0];
+      s[w] = s[w - 1];
+      d[-1] = d[0];
+      d[w] = d[w - 1];
+
+      short *dU = m_dU[i], *dV = m_dV[i];
+      j = 0;
+#if VISP_HAVE_SSE2
+      if (useSSE2) {
+        for (; j + 8 <= w; j += 8) {
+          __m128i sl = _mm_loadu_si128((const __m128i *)(s + j - 1)), sr = _mm_loadu_si128((const __m128i *)(s + j + 1));
+          __m128i dl = _mm_loadu_si128((const __m128i *)(d + j - 1)), dc = _mm_loadu_si128((const __m128i *)(d + j)),
+                  dr = _mm_loadu_si128((const __m128i *)(d + j + 1));
+          _mm_storeu_si128((__m128i *)(dU + j), _mm_sub_epi16(sr, sl));
+          _mm_storeu_si128((__m128i *)(dV + j),
+                           _mm_add_epi16(_mm_mullo_epi16(_mm_add_epi16(dl, dr), three), _mm_mullo_epi16(dc, ten)));
+        }
+      }
+#endif
+      for (; j < w; j++) {
+        dU[j] = static_cast<short>(s[j + 1] - s[j - 1]);
+        dV[j] = static_cast<short>((d[j - 1] + d[j + 1]) * 3 + d[j] * 10);
+      }
+    }
+  }
+
+private:
+  const vpImage<unsigned char> &m_I;
+  vpImage<short> &m_dU, &m_dV;
+};
+
+/*
+  Corner response of the rows [begin, end) of an image: minimal eigenvalue
+  (Shi-Tomasi) or Harris response of the covariance matrix of the Sobel
+  derivatives summed over a block x block neighborhood.
+*/
+class vpCornerResponseBody : public vpParallelForBody
+{
+public:
+  vpCornerResponseBody(const vpImage<unsigned char> &I, int block, bool harris, float harris_k,
+                       vpImage<float> &response)
+    : m_I(I), m_block(block), m_harris(harris), m_harris_k(harris_k), m_response(response)
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    const int w = static_cast<int>(m_I.getWidth()), h = static_cast<int>(m_I.getHeight());
+    const int r = m_block / 2;
+    std::vector<int> sxx(static_cast<size_t>(w + 2 * r)), sxy(sxx.size()), syy(sxx.size());
+    std::vector<short> du(static_cast<size_t>(w)), dv(static_cast<size_t>(w));
+    // The derivatives of the pixels closer than 1 pixel to the border use
+    // the replicated border pixels
+    const float norm = 1.f / (m_block * m_block * 255.f * 255.f * 16.f);
+
+    for (int i = begin; i < end; i++) {
+      std::fill(sxx.begin(), sxx.end(), 0);
+      std::fill(sxy.begin(), sxy.end(), 0);
+      std::fill(syy.begin(), syy.end(), 0);
+      // Vertical sums of the products of the derivatives over the block
+      for (int k = i - r; k <= i + m_block - 1 - r; k++) {
+        sobelRow(clampIndex(k, h), w, h, &du[0], &dv[0]);
+        for (int j = 0; j < w; j++) {
+          int u = du[static_cast<size_t>(j)], v = dv[static_cast<size_t>(j)];
+          sxx[static_cast<size_t>(j + r)] += u * u;
+          sxy[static_cast<size_t>(j + r)] += u * v;
+          syy[static_cast<size_t>(j + r)] += v * v;
+        }
+      }
+      for (int j = 0; j < r; j++) {
+        sxx[static_cast<size_t>(j)] = sxx[static_cast<size_t>(r)];
+        sxy[static_cast<size_t>(j)] = sxy[static_cast<size_t>(r)];
+        syy[static_cast<size_t>(j)] = syy[static_cast<size_t>(r)];
+        sxx[static_cast<size_t>(w + r + j)] = sxx[static_cast<size_t>(w + r - 1)];
+        sxy[static_cast<size_t>(w + r + j)] = sxy[static_cast<size_t>(w + r - 1)];
+        syy[static_cast<size_t>(w + r + j)] = syy[static_cast<size_t>(w + r - 1)];
+      }
+
+      // Horizontal running sums
+      int a = 0, b = 0, c = 0;
+      for (int j = 0; j < m_block - 1; j++) {
+        a += sxx[static_cast<size_t>(j)];
+        b += sxy[static_cast<size_t>(j)];
+        c += syy[static_cast<size_t>(j)];
+      }
+      float *dst = m_response[i];
+      for (int j = 0; j < w; j++) {
+        a += sxx[static_cast<size_t>(j + m_block - 1)];
+        b += sxy[static_cast<size_t>(j + m_block - 1)];
+        c += syy[static_cast<size_t>(j + m_block - 1)];
+        float fa = a * norm, fb = b * norm, fc = c * norm;
+        if (m_harris) {
+          dst[j] = fa * fc - fb * fb - m_harris_k * (fa + fc) * (fa + fc);
+        } else {
+          dst[j] = 0.5f * ((fa + fc) - std::sqrt((fa - fc) * (fa - fc) + 4.f * fb * fb));
+        }
+        a -= sxx[static_cast<size_t>(j)];
+        b -= sxy[static_cast<size_t>(j)];
+        c -= syy[static_cast<size_t>(j)];
+      }
+    }
+  }
+
+private:
+  void sobelRow(int i, int w, int h, short *du, short *dv) const
+  {
+    const unsigned char *r0 = m_I[clampIndex(i - 1, h)], *r1 = m_I[i], *r2 = m_I[clampIndex(i + 1, h)];
+    for (int j = 0; j < w; j++) {
+      int jl = clampIndex(j - 1, w), jr = clampIndex(j + 1, w);
+      du[j] = static_cast<short>((r0[jr] - r0[jl]) + 2 * (r1[jr] - r1[jl]) + (r2[jr] - r2[jl]));
+      dv[j] = static_cast<short>((r2[jl] - r0[jl]) + 2 * (r2[j] - r0[j]) + (r2[jr] - r0[jr]));
+    }
+  }
+
+  const vpImage<unsigned char> &m_I;
+  int m_block;
+  bool m_harris;
+  float m_harris_k;
+  vpImage<float> &m_response;
+};
+
+struct vpCorner {
+  float response;
+  int index;
+  bool operator<(const vpCorner &c) const
+  {
+    // Strongest first, then in raster order
+    return response > c.response || (response == c.response && index < c.index);
+  }
+};
+
+/*
+  Sub-pixel refinement of the corners [begin, end): the corner is moved to
+  the point that minimizes the sum over a window of the squared dot products
+  between the image gradient and the vector from the corner to the pixel.
+*/
+class vpCornerSubPixBody : public vpParallelForBody
+{
+public:
+  vpCornerSubPixBody(const vpImage<unsigned char> &I, int halfWin, int maxIterations, double epsilon,
+                     std::vector<vpImagePoint> &corners)
+    : m_I(I), m_halfWin(halfWin), m_maxIterations(maxIterations), m_epsilon(epsilon), m_corners(corners)
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    const int winW = 2 * m_halfWin + 1, patchW = winW + 2;
+    const int w = static_cast<int>(m_I.getWidth()), h = static_cast<int>(m_I.getHeight());
+    std::vector<double> mask(static_cast<size_t>(winW * winW)), patch(static_cast<size_t>(patchW * patchW));
+    for (int i = 0; i < winW; i++) {
+      double y = (i - m_halfWin) / static_cast<double>(m_halfWin);
+      for (int j = 0; j < winW; j++) {
+        double x = (j - m_halfWin) / static_cast<double>(m_halfWin);
+        mask[static_cast<size_t>(i * winW + j)] = std::exp(-x * x) * std::exp(-y * y);
+      }
+    }
+
+    for (int k = begin; k < end; k++) {
+      const double u0 = m_corners[static_cast<size_t>(k)].get_u(), v0 = m_corners[static_cast<size_t>(k)].get_v();
+      double u = u0, v = v0;
+      for (int iter = 0; iter < m_maxIterations; iter++) {
+        // Bilinear interpolation of the window and its one pixel border
+        double su = u - (m_halfWin + 1), sv = v - (m_halfWin + 1);
+        int iu = static_cast<int>(std::floor(su)), iv = static_cast<int>(std::floor(sv));
+        double a = su - iu, b = sv - iv;
+        for (int i = 0; i < patchW; i++) {
+          for (int j = 0; j < patchW; j++) {
+            const unsigned char *p00, *p01, *p10, *p11;
+            getNeighbors(m_I.bitmap, w, h, iu + j, iv + i, p00, p01, p10, p11);
+            patch[static_cast<size_t>(i * patchW + j)] =
+                (1 - b) * ((1 - a) * *p00 + a * *p01) + b * ((1 - a) * *p10 + a * *p11);
+          }
+        }
+
+        double gxx = 0, gxy = 0, gyy = 0, bu = 0, bv = 0;
+        for (int i = 0; i < winW; i++) {
+          double py = i - m_halfWin;
+          const double *row = &patch[static_cast<size_t>((i + 1) * patchW + 1)];
+          for (int j = 0; j < winW; j++) {
+            double px = j - m_halfWin;
+            double m = mask[static_cast<size_t>(i * winW + j)];
+            double tgx = row[j + 1] - row[j - 1], tgy = row[j + patchW] - row[j - patchW];
+            double txx = tgx * tgx * m, txy = tgx * tgy * m, tyy = tgy * tgy * m;
+            gxx += txx;
+            gxy += txy;
+            gyy += tyy;
+            bu += txx * px + txy * py;
+            bv += txy * px + tyy * py;
+          }
+        }
+
+        double det = gxx * gyy - gxy * gxy;
+        if (std::fabs(det) <= DBL_EPSILON * DBL_EPSILON) {
+          break;
+        }
+        double du = (gyy * bu - gxy * bv) / det, dv = (gxx * bv - gxy * bu) / det;
+        u += du;
+        v += dv;
+        if (u < 0 || u >= w || v < 0 || v >= h || du * du + dv * dv <= m_epsilon * m_epsilon) {
+          break;
+        }
+      }
+      if (std::fabs(u - u0) <= m_halfWin && std::fabs(v - v0) <= m_halfWin) {
+        m_corners[static_cast<size_t>(k)].set_uv(u, v);
+      }
+    }
+  }
+
+private:
+  const vpImage<unsigned char> &m_I;
+  int m_halfWin;
+  int m_maxIterations;
+  double m_epsilon;
+  std::vector<vpImagePoint> &m_corners;
+};
+
+/*
+  Pyramidal Lucas-Kanade tracking of the features [begin, end).
+*/
+class vpLucasKanadeBody : public vpParallelForBody
+{
+public:
+  vpLucasKanadeBody(const std::vector<const vpImage<unsigned char> *> &prev, const std::vector<vpImage<short> > &derivU,
+                    const std::vector<vpImage<short> > &derivV, const std::vector<const vpImage<unsigned char> *> &cur,
+                    int nbLevels, int winSize,
+                    int maxIterations, float epsilon, float minEigThreshold, bool initialGuess,
+                    const std::vector<vpImagePoint> &prevPts, std::vector<vpImagePoint> &nextPts,
+                    std::vector<unsigned char> &status)
+    : m_prev(prev), m_derivU(derivU), m_derivV(derivV), m_cur(cur), m_nbLevels(nbLevels), m_winSize(winSize),
+      m_maxIterations(maxIterations), m_epsilon(epsilon), m_minEigThreshold(minEigThreshold),
+      m_initialGuess(initialGuess), m_prevPts(prevPts), m_nextPts(nextPts), m_status(status)
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+#if VISP_HAVE_SSE2
+    const bool useSSE2 = vpCPUFeatures::checkSSE2();
+#else
+    const bool useSSE2 = false;
+#endif
+    const int n = m_winSize * m_winSize;
+    // Intensities with 5 fractional bits and derivatives of the window in the
+    // previous image
+    std::vector<short> patchI(static_cast<size_t>(n)), patchU(static_cast<size_t>(n)),
+        patchV(static_cast<size_t>(n));
+
+    for (int k = begin; k < end; k++) {
+      m_status[static_cast<size_t>(k)] = trackFeature(k, &patchI[0], &patchU[0], &patchV[0], useSSE2) ? 1 : 0;
+    }
+  }
+
+private:
+  bool trackFeature(int k, short *patchI, short *patchU, short *patchV, bool useSSE2)
+  {
+    const float halfWin = (m_winSize - 1) * 0.5f;
+    const vpImagePoint &prevPt = m_prevPts[static_cast<size_t>(k)];
+    vpImagePoint &nextPt = m_nextPts[static_cast<size_t>(k)];
+    // Window centers at the current level
+    float nextU = 0.f, nextV = 0.f;
+
+    for (int level = m_nbLevels - 1; level >= 0; level--) {
+      const float scale = 1.f / (1 << level);
+      const float prevU = static_cast<float>(prevPt.get_u()) * scale, prevV = static_cast<float>(prevPt.get_v()) * scale;
+      if (level == m_nbLevels - 1) {
+        if (m_initialGuess) {
+          nextU = static_cast<float>(nextPt.get_u()) * scale;
+          nextV = static_cast<float>(nextPt.get_v()) * scale;
+        } else {
+          nextU = prevU;
+          nextV = prevV;
+        }
+      } else {
+        nextU *= 2.f;
+        nextV *= 2.f;
+      }
+
+      const vpImage<unsigned char> &I = *m_prev[static_cast<size_t>(level)];
+      const vpImage<unsigned char> &J = *m_cur[static_cast<size_t>(level)];
+      const vpImage<short> &dU = m_derivU[static_cast<size_t>(level)];
+      const vpImage<short> &dV = m_derivV[static_cast<size_t>(level)];
+
+      // Window of the feature in the previous image and its gradient matrix
+      float su = prevU - halfWin, sv = prevV - halfWin;
+      int iu = static_cast<int>(std::floor(su)), iv = static_cast<int>(std::floor(sv));
+      if (iu < -m_winSize || iu >= static_cast<int>(I.getWidth()) || iv < -m_winSize ||
+          iv >= static_cast<int>(I.getHeight())) {
+        if (level == 0) {
+          return false;
+        }
+        continue;
+      }
+      extractWindow(I, dU, dV, iu, iv, vpBilinearWeights(su - iu, sv - iv), patchI, patchU, patchV);
+
+      float A11, A12, A22;
+      gradientMatrix(patchU, patchV, useSSE2, A11, A12, A22);
+      float D = A11 * A22 - A12 * A12;
+      float minEig = (A22 + A11 - std::sqrt((A11 - A22) * (A11 - A22) + 4.f * A12 * A12)) /
+                     (2.f * m_winSize * m_winSize);
+      if (minEig < m_minEigThreshold || D < FLT_EPSILON) {
+        if (level == 0) {
+          return false;
+        }
+        continue;
+      }
+      D = 1.f / D;
+
+      // Gauss-Newton iterations on the window position in the current image
+      float tu = nextU - halfWin, tv = nextV - halfWin;
+      float prevDeltaU = 0.f, prevDeltaV = 0.f;
+      for (int j = 0; j < m_maxIterations; j++) {
+        int ju = static_cast<int>(std::floor(tu)), jv = static_cast<int>(std::floor(tv));
+        if (ju < -m_winSize || ju >= static_cast<int>(J.getWidth()) || jv < -m_winSize ||
+            jv >= static_cast<int>(J.getHeight())) {
+          if (level == 0) {
+            return false;
+          }
+          break;
+        }
+
+        float b1, b2;
+        mismatchVector(J, ju, jv, vpBilinearWeights(tu - ju, tv - jv), patchI, patchU, patchV, useSSE2, b1, b2);
+        float deltaU = (A12 * b2 - A22 * b1) * D;
+        float deltaV = (A12 * b1 - A11 * b2) * D;
+        tu += deltaU;
+        tv += deltaV;
+        nextU = tu + halfWin;
+        nextV = tv + halfWin;
+
+        if (deltaU * deltaU + deltaV * deltaV <= m_epsilon * m_epsilon) {
+          break;
+        }
+        // Stop the oscillations between two positions
+        if (j > 0 && std::fabs(deltaU + prevDeltaU) < 0.01f && std::fabs(deltaV + prevDeltaV) < 0.01f) {
+          nextU -= deltaU * 0.5f;
+          nextV -= deltaV * 0.5f;
+          break;
+        }
+        prevDeltaU = deltaU;
+        prevDeltaV = deltaV;
+      }
+    }
+
+    nextPt.set_uv(nextU, nextV);
+    return true;
+  }
+
+  // Fixed-point bilinear interpolation of the intensities and derivatives of
+  // the window whose top left pixel is (iv, iu)
+  void extractWindow(const vpImage<unsigned char> &I, const vpImage<short> &dU, const vpImage<short> &dV, int iu,
+                     int iv, const vpBilinearWeights &wt, short *patchI, short *patchU, short *patchV) const
+  {
+    const int w = static_cast<int>(I.getWidth()), h = static_cast<int>(I.getHeight());
+    for (int y = 0; y < m_winSize; y++) {
+      for (int x = 0; x < m_winSize; x++) {
+        const unsigned char *i00, *i01, *i10, *i11;
+        const short *u00, *u01, *u10, *u11, *v00, *v01, *v10, *v11;
+        getNeighbors(I.bitmap, w, h, iu + x, iv + y, i00, i01, i10, i11);
+        getNeighbors(dU.bitmap, w, h, iu + x, iv + y, u00, u01, u10, u11);
+        getNeighbors(dV.bitmap, w, h, iu + x, iv + y, v00, v01, v10, v11);
+        int k = y * m_winSize + x;
+        patchI[k] = static_cast<short>(descale(*i00 * wt.w00 + *i01 * wt.w01 + *i10 * wt.w10 + *i11 * wt.w11, I_BITS));
+        patchU[k] = static_cast<short>(descale(*u00 * wt.w00 + *u01 * wt.w01 + *u10 * wt.w10 + *u11 * wt.w11, W_BITS));
+        patchV[k] = static_cast<short>(descale(*v00 * wt.w00 + *v01 * wt.w01 + *v10 * wt.w10 + *v11 * wt.w11, W_BITS));
+      }
+    }
+  }
+
+  // Sums over the window of the products of the derivatives
+  void gradientMatrix(const short *patchU, const short *patchV, bool useSSE2, float &A11, float &A12,
+                      float &A22) const
+  {
+    const int n = m_winSize * m_winSize;
+    int k = 0;
+    float a11 = 0.f, a12 = 0.f, a22 = 0.f;
+#if VISP_HAVE_SSE2
+    if (useSSE2) {
+      __m128 q11 = _mm_setzero_ps(), q12 = _mm_setzero_ps(), q22 = _mm_setzero_ps();
+      for (; k + 8 <= n; k += 8) {
+        __m128i u = _mm_loadu_si128((const __m128i *)(patchU + k)), v = _mm_loadu_si128((const __m128i *)(patchV + k));
+        q11 = _mm_add_ps(q11, _mm_cvtepi32_ps(_mm_madd_epi16(u, u)));
+        q12 = _mm_add_ps(q12, _mm_cvtepi32_ps(_mm_madd_epi16(u, v)));
+        q22 = _mm_add_ps(q22, _mm_cvtepi32_ps(_mm_madd_epi16(v, v)));
+      }
+      float buf[4];
+      _mm_storeu_ps(buf, q11);
+      a11 = buf[0] + buf[1] + buf[2] + buf[3];
+      _mm_storeu_ps(buf, q12);
+      a12 = buf[0] + buf[1] + buf[2] + buf[3];
+      _mm_storeu_ps(buf, q22);
+      a22 = buf[0] + buf[1] + buf[2] + buf[3];
+    }
+#else
+    (void)useSSE2;
+#endif
+    for (; k < n; k++) {
+      a11 += static_cast<float>(patchU[k] * patchU[k]);
+      a12 += static_cast<float>(patchU[k] * patchV[k]);
+      a22 += static_cast<float>(patchV[k] * patchV[k]);
+    }
+    A11 = a11 * FLT_SCALE;
+    A12 = a12 * FLT_SCALE;
+    A22 = a22 * FLT_SCALE;
+  }
+
+  // Sums over the window of the products of the derivatives and of the
+  // difference between the current window at (jv, ju) and the previous one
+  void mismatchVector(const vpImage<unsigned char> &J, int ju, int jv, const vpBilinearWeights &wt,
+                      const short *patchI, const short *patchU, const short *patchV, bool useSSE2, float &b1,
+                      float &b2) const
+  {
+    const int w = static_cast<int>(J.getWidth()), h = static_cast<int>(J.getHeight());
+    // The window and the pixels on its right and bottom are inside the image
+    const bool inside = ju >= 0 && jv >= 0 && ju + m_winSize < w && jv + m_winSize < h;
+    float sb1 = 0.f, sb2 = 0.f;
+#if VISP_HAVE_SSE2
+    __m128 qb1 = _mm_setzero_ps(), qb2 = _mm_setzero_ps();
+    const __m128i zero = _mm_setzero_si128(), round = _mm_set1_epi32(1 << (I_BITS - 1));
+    const __m128i qw0 = _mm_set1_epi32((wt.w01 << 16) | (wt.w00 & 0xffff));
+    const __m128i qw1 = _mm_set1_epi32((wt.w11 << 16) | (wt.w10 & 0xffff));
+#else
+    (void)useSSE2;
+    (void)inside;
+#endif
+
+    for (int y = 0; y < m_winSize; y++) {
+      int x = 0;
+      const short *pI = patchI + y * m_winSize, *pU = patchU + y * m_winSize, *pV = patchV + y * m_winSize;
+#if VISP_HAVE_SSE2
+      if (useSSE2 && inside) {
+        const unsigned char *src = J.bitmap + (jv + y) * w + ju;
+        for (; x + 8 <= m_winSize; x += 8) {
+          __m128i r0 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(src + x)), zero);
+          __m128i r0n = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(src + x + 1)), zero);
+          __m128i r1 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(src + x + w)), zero);
+          __m128i r1n = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(src + x + w + 1)), zero);
+          __m128i t0 = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(r0, r0n), qw0),
+                                     _mm_madd_epi16(_mm_unpacklo_epi16(r1, r1n), qw1));
+          __m128i t1 = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(r0, r0n), qw0),
+                                     _mm_madd_epi16(_mm_unpackhi_epi16(r1, r1n), qw1));
+          t0 = _mm_srai_epi32(_mm_add_epi32(t0, round), I_BITS);
+          t1 = _mm_srai_epi32(_mm_add_epi32(t1, round), I_BITS);
+          __m128i diff = _mm_sub_epi16(_mm_packs_epi32(t0, t1), _mm_loadu_si128((const __m128i *)(pI + x)));
+          qb1 = _mm_add_ps(qb1, _mm_cvtepi32_ps(_mm_madd_epi16(diff, _mm_loadu_si128((const __m128i *)(pU + x)))));
+          qb2 = _mm_add_ps(qb2, _mm_cvtepi32_ps(_mm_madd_epi16(diff, _mm_loadu_si128((const __m128i *)(pV + x)))));
+        }
+      }
+#endif
+      for (; x < m_winSize; x++) {
+        const unsigned char *p00, *p01, *p10, *p11;
+        getNeighbors(J.bitmap, w, h, ju + x, jv + y, p00, p01, p10, p11);
+        int diff = descale(*p00 * wt.w00 + *p01 * wt.w01 + *p10 * wt.w10 + *p11 * wt.w11, I_BITS) - pI[x];
+        sb1 += static_cast<float>(diff * pU[x]);
+        sb2 += static_cast<float>(diff * pV[x]);
+      }
+    }
+
+#if VISP_HAVE_SSE2
+    float buf[4];
+    _mm_storeu_ps(buf, qb1);
+    sb1 += buf[0] + buf[1] + buf[2] + buf[3];
+    _mm_storeu_ps(buf, qb2);
+    sb2 += buf[0] + buf[1] + buf[2] + buf[3];
+#endif
+    b1 = sb1 * FLT_SCALE;
+    b2 = sb2 * FLT_SCALE;
+  }
+
+  const std::vector<const vpImage<unsigned char> *> &m_prev;
+  const std::vector<vpImage<short> > &m_derivU, &m_derivV;
+  const std::vector<const vpImage<unsigned char> *> &m_cur;
+  int m_nbLevels;
+  int m_winSize;
+  int m_maxIterations;
+  float m_epsilon;
+  float m_minEigThreshold;
+  bool m_initialGuess;
+  const std::vector<vpImagePoint> &m_prevPts;
+  std::vector<vpImagePoint> &m_nextPts;
+  std::vector<unsigned char> &m_status;
+};
+} // namespace
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Default constructor.
+*/
+vpKltTracker::vpKltTracker()
+  : m_pyramids(), m_current(0), m_prevLevelsCopy(), m_prevIsCopy(false), m_prevLevels(), m_curLevels(), m_derivU(),
+    m_derivV(), m_points_id(), m_maxCount(500), m_maxIterations(20), m_epsilon(0.03), m_winSize(10),
+    m_qualityLevel(0.01), m_minDistance(15), m_minEigThreshold(1e-4), m_harris_k(0.04), m_blockSize(3),
+    m_useHarrisDetector(false), m_pyrMaxLevel(3), m_next_points_id(0), m_initial_guess(false)
+{
+}
+
+/*!
+  Add a keypoint at the end of the feature list. The id of the feature is set
+  to ensure that it is unique.
+
+  \param x,y : Coordinates of the feature in the image.
+*/
+void vpKltTracker::addFeature(const float &x, const float &y)
+{
+  m_points[1].push_back(vpImagePoint(y, x));
+  m_points_id.push_back(m_next_points_id++);
+}
+
+/*!
+  Add a keypoint at the end of the feature list.
+
+  \warning This function doesn't ensure that the id of the feature is unique.
+  You should rather use addFeature(const float &, const float &) or
+  addFeature(const vpImagePoint &).
+
+  \param id : Feature id. Should be unique
+  \param x,y : Coordinates of the feature in the image.
+*/
+void vpKltTracker::addFeature(const long &id, const float &x, const float &y)
+{
+  m_points[1].push_back(vpImagePoint(y, x));
+  m_points_id.push_back(id);
+  if (id >= m_next_points_id)
+    m_next_points_id = id + 1;
+}
+
+/*!
+  Add a keypoint at the end of the feature list. The id of the feature is set
+  to ensure that it is unique.
+
+  \param f : Coordinates of the feature in the image.
+*/
+void vpKltTracker::addFeature(const vpImagePoint &f)
+{
+  m_points[1].push_back(f);
+  m_points_id.push_back(m_next_points_id++);
+}
+
+/*!
+  Display the current features and their id.
+
+  \param I : Image used as background. Display should be initialized on it.
+  \param color : Color used to display the features.
+  \param thickness : Thickness of the drawings.
+*/
+void vpKltTracker::display(const vpImage<unsigned char> &I, const vpColor &color, unsigned int thickness) const
+{
+  for (size_t i = 0; i < m_points[1].size(); i++) {
+    vpImagePoint ip(vpMath::round(m_points[1][i].get_v()), vpMath::round(m_points[1][i].get_u()));
+    vpDisplay::displayCross(I, ip, 10, color, thickness);
+
+    std::ostringstream id;
+    id << m_points_id[i];
+    ip.set_u(vpMath::round(m_points[1][i].get_u() + 5));
+    vpDisplay::displayText(I, ip, id.str(), color);
+  }
+}
+
+/*!
+  Display the current features and their id.
+
+  \param I : Image used as background. Display should be initialized on it.
+  \param color : Color used to display the features.
+  \param thickness : Thickness of the drawings.
+*/
+void vpKltTracker::display(const vpImage<vpRGBa> &I, const vpColor &color, unsigned int thickness) const
+{
+  for (size_t i = 0; i < m_points[1].size(); i++) {
+    vpImagePoint ip(vpMath::round(m_points[1][i].get_v()), vpMath::round(m_points[1][i].get_u()));
+    vpDisplay::displayCross(I, ip, 10, color, thickness);
+
+    std::ostringstream id;
+    id << m_points_id[i];
+    ip.set_u(vpMath::round(m_points[1][i].get_u() + 5));
+    vpDisplay::displayText(I, ip, id.str(), color);
+  }
+}
+
+/*!
+  Get the 'index'th feature image coordinates. Beware that getFeature(i,...)
+  may not represent the same feature before and after a tracking iteration
+  (if a feature is lost, features are shifted in the array).
+
+  \param index : Index of feature.
+  \param id : id of the feature.
+  \param x : x coordinate.
+  \param y : y coordinate.
+*/
+void vpKltTracker::getFeature(const int &index, long &id, float &x, float &y) const
+{
+  if (index < 0 || static_cast<size_t>(index) >= m_points[1].size()) {
+    throw(vpException(vpException::badValue, "Feature [%d] doesn't exist", index));
+  }
+
+  x = static_cast<float>(m_points[1][static_cast<size_t>(index)].get_u());
+  y = static_cast<float>(m_points[1][static_cast<size_t>(index)].get_v());
+  id = m_points_id[static_cast<size_t>(index)];
+}
+
+/*!
+  Initialise the tracking by extracting KLT keypoints on the provided image.
+
+  \param I : Grey level image used as input.
+  \param mask : Image mask used to restrict the keypoint detection area to
+  its non zero pixels. If mask is NULL, all the image will be considered.
+
+  \exception vpTrackingException::initializationError : If the image is
+  empty or if the mask does not have the size of the image.
+*/
+void vpKltTracker::initTracking(const vpImage<unsigned char> &I, const vpImage<unsigned char> *mask)
+{
+  if (mask != NULL && (mask->getWidth() != I.getWidth() || mask->getHeight() != I.getHeight())) {
+    throw(vpTrackingException(vpTrackingException::initializationError,
+                              "The mask size (%dx%d) differs from the image size (%dx%d)", mask->getWidth(),
+                              mask->getHeight(), I.getWidth(), I.getHeight()));
+  }
+  setImage(I);
+
+  m_next_points_id = 0;
+  m_initial_guess = false;
+  for (size_t i = 0; i < 2; i++) {
+    m_points[i].clear();
+  }
+  m_points_id.clear();
+
+  detectFeatures(I, mask);
+  if (!m_points[1].empty()) {
+    refineCorners(I);
+    for (size_t i = 0; i < m_points[1].size(); i++) {
+      m_points_id.push_back(m_next_points_id++);
+    }
+  }
+}
+
+/*!
+  Set the points that will be used as initialization during the next call to
+  track().
+
+  \param I : Input image.
+  \param pts : Vector of points that should be tracked.
+*/
+void vpKltTracker::initTracking(const vpImage<unsigned char> &I, const std::vector<vpImagePoint> &pts)
+{
+  initTracking(I, pts, std::vector<long>());
+}
+
+/*!
+  Set the points that will be used as initialization during the next call to
+  track().
+
+  \param I : Input image.
+  \param pts : Vector of points that should be tracked.
+  \param ids : Identifiers of the points. If its size differs from the one of
+  \e pts, the points are numbered from 0.
+*/
+void vpKltTracker::initTracking(const vpImage<unsigned char> &I, const std::vector<vpImagePoint> &pts,
+                                const std::vector<long> &ids)
+{
+  setImage(I);
+
+  m_initial_guess = false;
+  m_points[0].clear();
+  m_points[1] = pts;
+  m_points_id.clear();
+
+  if (ids.size() != pts.size()) {
+    m_next_points_id = 0;
+    for (size_t i = 0; i < m_points[1].size(); i++)
+      m_points_id.push_back(m_next_points_id++);
+  } else {
+    long max = 0;
+    for (size_t i = 0; i < m_points[1].size(); i++) {
+      m_points_id.push_back(ids[i]);
+      if (ids[i] > max)
+        max = ids[i];
+    }
+    m_next_points_id = max + 1;
+  }
+}
+
+/*!
+  Set the size of the averaging block used to detect the features.
+
+  \param blockSize : Size of the neighborhood over which the derivative
+  covariation matrix of each pixel is summed. Default value is set to 3.
+*/
+void vpKltTracker::setBlockSize(int blockSize)
+{
+  if (blockSize < 1) {
+    throw(vpException(vpException::badValue, "Bad block size %d", blockSize));
+  }
+  m_blockSize = blockSize;
+}
+
+/*!
+  Set the free parameter of the Harris detector.
+
+  \param harris_k : Free parameter of the Harris detector. Default value is
+  set to 0.04.
+*/
+void vpKltTracker::setHarrisFreeParameter(double harris_k) { m_harris_k = harris_k; }
+
+/*!
+  Set the points that will be used as initial guess during the next call to
+  track(). A typical usage of this function is to predict the position of the
+  features before the next call to track().
+
+  \param guess_pts : Vector of points that should be tracked. The size of this
+  vector should be the same as the one returned by getFeatures(). If this is
+  not the case, an exception is returned. Note also that the id of the points
+  is not modified.
+*/
+void vpKltTracker::setInitialGuess(const std::vector<vpImagePoint> &guess_pts)
+{
+  if (guess_pts.size() != m_points[1].size()) {
+    throw(vpException(vpException::badValue,
+                      "Cannot set initial guess: size feature vector [%d] "
+                      "and guess vector [%d] doesn't match",
+                      m_points[1].size(), guess_pts.size()));
+  }
+
+  m_points[0] = m_points[1];
+  m_points[1] = guess_pts;
+  m_initial_guess = true;
+}
+
+/*!
+  Set the points that will be used as initial guess during the next call to
+  track(). A typical usage of this function is to predict the position of the
+  features before the next call to track().
+
+  \param init_pts : Initial points (could be obtained from getPrevFeatures()
+  or getFeatures()).
+  \param guess_pts : Prediction of the new position of the initial points.
+  The size of this vector must be the same as the size of the vector of
+  initial points.
+  \param fid : Identifiers of the initial points.
+*/
+void vpKltTracker::setInitialGuess(const std::vector<vpImagePoint> &init_pts,
+                                   const std::vector<vpImagePoint> &guess_pts, const std::vector<long> &fid)
+{
+  if (guess_pts.size() != init_pts.size() || fid.size() != init_pts.size()) {
+    throw(vpException(vpException::badValue,
+                      "Cannot set initial guess: size init vector [%d], "
+                      "guess vector [%d] and id vector [%d] don't match",
+                      init_pts.size(), guess_pts.size(), fid.size()));
+  }
+
+  m_points[0] = init_pts;
+  m_points[1] = guess_pts;
+  m_points_id = fid;
+  m_initial_guess = true;
+}
+
+/*!
+  Set the maximum number of features to detect in the image.
+
+  \param maxCount : Maximum number of features to detect and track. If not
+  positive, all the detected corners are kept. Default value is set to 500.
+*/
+void vpKltTracker::setMaxFeatures(int maxCount) { m_maxCount = maxCount; }
+
+/*!
+  Set the maximal number of iterations of the Lucas-Kanade tracking of a
+  feature at each pyramid level and of the sub-pixel refinement of the
+  detected corners.
+
+  \param maxIterations : Maximal number of iterations. Default value is set
+  to 20.
+*/
+void vpKltTracker::setMaxIterations(int maxIterations)
+{
+  if (maxIterations < 1) {
+    throw(vpException(vpException::badValue, "Bad number of iterations %d", maxIterations));
+  }
+  m_maxIterations = maxIterations;
+}
+
+/*!
+  Set the minimal Euclidean distance between detected corners during
+  initialization.
+
+  \param minDistance : Minimal possible Euclidean distance between the
+  detected corners. Default value is set to 15.
+*/
+void vpKltTracker::setMinDistance(double minDistance) { m_minDistance = minDistance; }
+
+/*!
+  Set the minimal eigen value threshold used to reject a point during the
+  tracking.
+
+  \param minEigThreshold : Threshold on the minimal eigenvalue of the
+  gradient matrix of the window divided by the number of pixels of the
+  window. Default value is set to 1e-4.
+*/
+void vpKltTracker::setMinEigThreshold(double minEigThreshold) { m_minEigThreshold = minEigThreshold; }
+
+/*!
+  Set the maximal pyramid level. If the level is zero, then no pyramid is
+  computed for the optical flow.
+
+  \param pyrMaxLevel : 0-based maximal pyramid level number; if set to 0,
+  pyramids are not used (single level), if set to 1, two levels are used, and
+  so on. Default value is set to 3.
+*/
+void vpKltTracker::setPyramidLevels(int pyrMaxLevel)
+{
+  if (pyrMaxLevel < 0) {
+    throw(vpException(vpException::badValue, "Bad pyramid level %d", pyrMaxLevel));
+  }
+  m_pyrMaxLevel = pyrMaxLevel;
+}
+
+/*!
+  Set the parameter characterizing the minimal accepted quality of image
+  corners.
+
+  \param qualityLevel : Quality level parameter. Default value is set to 0.01.
+  The parameter value is multiplied by the best corner quality measure, which
+  is the minimal eigenvalue or the Harris function response. The corners with
+  the quality measure less than the product are rejected.
+*/
+void vpKltTracker::setQuality(double qualityLevel) { m_qualityLevel = qualityLevel; }
+
+/*!
+  Set the displacement in pixels below which the Lucas-Kanade tracking of a
+  feature at a pyramid level and the sub-pixel refinement of the detected
+  corners stop.
+
+  \param epsilon : Displacement threshold. Default value is set to 0.03.
+*/
+void vpKltTracker::setTerminationEpsilon(double epsilon) { m_epsilon = epsilon; }
+
+/*!
+  Set the parameter indicating whether to use a Harris detector or the
+  minimal eigenvalue of gradient matrices for corner detection.
+
+  \param useHarrisDetector : If true, use the Harris detector. If false
+  (default value), use the minimal eigenvalue.
+*/
+void vpKltTracker::setUseHarris(bool useHarrisDetector) { m_useHarrisDetector = useHarrisDetector; }
+
+/*!
+  Set the window size used to track the features.
+
+  \param winSize : Side length of the tracking window, that is also the
+  half side length of the window used to refine the detected corners.
+  Default value is set to 10.
+*/
+void vpKltTracker::setWindowSize(int winSize)
+{
+  if (winSize < 2) {
+    throw(vpException(vpException::badValue, "Bad window size %d", winSize));
+  }
+  m_winSize = winSize;
+}
+
+/*!
+  Remove the feature with the given index as parameter.
+
+  \param index : Index of the feature to remove.
+*/
+void vpKltTracker::suppressFeature(const int &index)
+{
+  if (index < 0 || static_cast<size_t>(index) >= m_points[1].size()) {
+    throw(vpException(vpException::badValue, "Feature [%d] doesn't exist", index));
+  }
+
+  m_points[1].erase(m_points[1].begin() + index);
+  m_points_id.erase(m_points_id.begin() + index);
+}
+
+/*!
+  Track KLT keypoints using the iterative Lucas-Kanade method with pyramids.
+
+  \param I : Input image.
+
+  \exception vpTrackingException::fatalError : If there is no feature to
+  track.
+*/
+void vpKltTracker::track(const vpImage<unsigned char> &I)
+{
+  if (m_points[1].empty())
+    throw vpTrackingException(vpTrackingException::fatalError, "Not enough key points to track.");
+
+  // The previous levels are either in m_pyramids[m_current] or in
+  // m_prevLevelsCopy, the current image goes in the other pyramid
+  setPrevLevels();
+  m_current = 1 - m_current;
+  m_pyramids[m_current].build(I, static_cast<unsigned int>(m_pyrMaxLevel + 1), vpImagePyramid::GAUSSIAN_FILTER);
+  setLevels(m_pyramids[m_current], m_curLevels);
+  trackFeatures();
+  m_prevIsCopy = false;
+}
+
+/*!
+  Track KLT keypoints using the iterative Lucas-Kanade method in a pyramid
+  that is already built, typically shared with other algorithms processing
+  the same image. The number of levels used is limited by the number of
+  levels of the pyramid.
+
+  The levels of the pyramid are read in place to track the features. Once
+  done, the levels used by the tracker are copied since they are needed as
+  previous image by the next call to track() while the caller may rebuild
+  the pyramid in the meantime. This copy is made at each frame, in buffers
+  that are reused as long as the image size does not change. It saves the
+  construction of a second pyramid, not the copy of its levels.
+
+  \param pyramid : Pyramid of the input image.
+
+  \exception vpTrackingException::fatalError : If there is no feature to
+  track.
+*/
+void vpKltTracker::track(const vpImagePyramid &pyramid)
+{
+  if (m_points[1].empty())
+    throw vpTrackingException(vpTrackingException::fatalError, "Not enough key points to track.");
+
+  setPrevLevels();
+  setLevels(pyramid, m_curLevels);
+  trackFeatures();
+
+  // The previous levels are no longer used and may be overwritten
+  unsigned int nbLevels = static_cast<unsigned int>(m_curLevels.size());
+  m_prevLevelsCopy.resize(nbLevels);
+  for (unsigned int level = 0; level < nbLevels; level++) {
+    m_prevLevelsCopy[level] = pyramid.getLevel(level);
+  }
+  m_prevIsCopy = true;
+}
+
+/*!
+  Compute the Scharr derivatives of the first levels of a pyramid.
+*/
+void vpKltTracker::buildDerivatives(const std::vector<const vpImage<unsigned char> *> &levels, unsigned int nbLevels)
+{
+  m_derivU.resize(nbLevels);
+  m_derivV.resize(nbLevels);
+  for (unsigned int level = 0; level < nbLevels; level++) {
+    const vpImage<unsigned char> &I = *levels[level];
+    m_derivU[level].resize(I.getHeight(), I.getWidth());
+    m_derivV[level].resize(I.getHeight(), I.getWidth());
+    vpScharrBody body(I, m_derivU[level], m_derivV[level]);
+    vpThreadPool::instance().parallel_for(0, static_cast<int>(I.getHeight()), body, 16);
+  }
+}
+
+/*!
+  Detect the corners of an image in m_points[1].
+*/
+void vpKltTracker::detectFeatures(const vpImage<unsigned char> &I, const vpImage<unsigned char> *mask)
+{
+  const int w = static_cast<int>(I.getWidth()), h = static_cast<int>(I.getHeight());
+  if (w < 3 || h < 3) {
+    return;
+  }
+
+  vpImage<float> response(I.getHeight(), I.getWidth());
+  vpCornerResponseBody body(I, m_blockSize, m_useHarrisDetector, static_cast<float>(m_harris_k), response);
+  vpThreadPool::instance().parallel_for(0, h, body, 16);
+
+  float maxResponse = 0.f;
+  for (int i = 0; i < h; i++) {
+    for (int j = 0; j < w; j++) {
+      if ((mask == NULL || (*mask)[i][j]) && response[i][j] > maxResponse) {
+        maxResponse = response[i][j];
+      }
+    }
+  }
+  if (maxResponse <= 0.f) {
+    return;
+  }
+  const float threshold = static_cast<float>(m_qualityLevel) * maxResponse;
+
+  // Local maxima above the threshold, the border pixels excluded
+  std::vector<vpCorner> corners;
+  for (int i = 1; i < h - 1; i++) {
+    const float *r0 = response[i - 1], *r1 = response[i], *r2 = response[i + 1];
+    for (int j = 1; j < w - 1; j++) {
+      float val = r1[j];
+      if (val < threshold || val <= 0.f || (mask != NULL && !(*mask)[i][j])) {
+        continue;
+      }
+      if (val >= r0[j - 1] && val >= r0[j] && val >= r0[j + 1] && val >= r1[j - 1] && val >= r1[j + 1] &&
+          val >= r2[j - 1] && val >= r2[j] && val >= r2[j + 1]) {
+        vpCorner c;
+        c.response = val;
+        c.index = i * w + j;
+        corners.push_back(c);
+      }
+    }
+  }
+  std::sort(corners.begin(), corners.end());
+
+  const size_t maxCount = m_maxCount > 0 ? static_cast<size_t>(m_maxCount) : corners.size();
+  if (m_minDistance < 1.) {
+    for (size_t k = 0; k < corners.size() && m_points[1].size() < maxCount; k++) {
+      m_points[1].push_back(vpImagePoint(corners[k].index / w, corners[k].index % w));
+    }
+    return;
+  }
+
+  // Grid of cells of size minDistance, so that the accepted corners closer
+  // than minDistance to a candidate are in the 3x3 neighboring cells
+  const int cellSize = static_cast<int>(std::ceil(m_minDistance));
+  const int gridW = (w + cellSize - 1) / cellSize, gridH = (h + cellSize - 1) / cellSize;
+  const double minDistance2 = m_minDistance * m_minDistance;
+  std::vector<std::vector<int> > grid(static_cast<size_t>(gridW * gridH));
+
+  for (size_t k = 0; k < corners.size() && m_points[1].size() < maxCount; k++) {
+    const int i = corners[k].index / w, j = corners[k].index % w;
+    const int ci = i / cellSize, cj = j / cellSize;
+    bool good = true;
+    for (int gi = std::max(ci - 1, 0); good && gi <= std::min(ci + 1, gridH - 1); gi++) {
+      for (int gj = std::max(cj - 1, 0); good && gj <= std::min(cj + 1, gridW - 1); gj++) {
+        const std::vector<int> &cell = grid[static_cast<size_t>(gi * gridW + gj)];
+        for (size_t l = 0; l < cell.size(); l++) {
+          const int di = cell[l] / w - i, dj = cell[l] % w - j;
+          if (di * di + dj * dj < minDistance2) {
+            good = false;
+            break;
+          }
+        }
+      }
+    }
+    if (good) {
+      grid[static_cast<size_t>(ci * gridW + cj)].push_back(corners[k].index);
+      m_points[1].push_back(vpImagePoint(i, j));
+    }
+  }
+}
+
+/*!
+  Refine the location of the detected corners m_points[1] to sub-pixel
+  accuracy.
+*/
+void vpKltTracker::refineCorners(const vpImage<unsigned char> &I)
+{
+  vpCornerSubPixBody body(I, m_winSize, m_maxIterations, m_epsilon, m_points[1]);
+  vpThreadPool::instance().parallel_for(0, static_cast<int>(m_points[1].size()), body, 8);
+}
+
+/*!
+  Build the pyramid of the image in which the features are given.
+*/
+void vpKltTracker::setImage(const vpImage<unsigned char> &I)
+{
+  if (I.getSize() == 0) {
+    throw(vpTrackingException(vpTrackingException::initializationError, "The image is empty"));
+  }
+  m_pyramids[m_current].build(I, static_cast<unsigned int>(m_pyrMaxLevel + 1), vpImagePyramid::GAUSSIAN_FILTER);
+  m_prevIsCopy = false;
+}
+
+/*!
+  Point to the levels of a pyramid used by the tracker.
+*/
+void vpKltTracker::setLevels(const vpImagePyramid &pyramid, std::vector<const vpImage<unsigned char> *> &levels) const
+{
+  unsigned int nbLevels = std::min(static_cast<unsigned int>(m_pyrMaxLevel + 1), pyramid.getNbLevels());
+  levels.resize(nbLevels);
+  for (unsigned int level = 0; level < nbLevels; level++) {
+    levels[level] = &pyramid.getLevel(level);
+  }
+}
+
+/*!
+  Point to the levels of the last tracked image, kept either in
+  m_pyramids[m_current] or in m_prevLevelsCopy.
+*/
+void vpKltTracker::setPrevLevels()
+{
+  if (!m_prevIsCopy) {
+    setLevels(m_pyramids[m_current], m_prevLevels);
+    return;
+  }
+  unsigned int nbLevels =
+      std::min(static_cast<unsigned int>(m_pyrMaxLevel + 1), static_cast<unsigned int>(m_prevLevelsCopy.size()));
+  m_prevLevels.resize(nbLevels);
+  for (unsigned int level = 0; level < nbLevels; level++) {
+    m_prevLevels[level] = &m_prevLevelsCopy[level];
+  }
+}
+
+/*!
+  Track the features from the previous pyramid to the current one.
+*/
+void vpKltTracker::trackFeatures()
+{
+  const std::vector<const vpImage<unsigned char> *> &prev = m_prevLevels;
+  const std::vector<const vpImage<unsigned char> *> &cur = m_curLevels;
+  if (prev.empty()) {
+    throw(vpTrackingException(vpTrackingException::initializationError, "The tracking is not initialized"));
+  }
+  if (cur.empty() || prev[0]->getWidth() != cur[0]->getWidth() || prev[0]->getHeight() != cur[0]->getHeight()) {
+    throw(vpTrackingException(vpTrackingException::fatalError, "The image size changed from %dx%d to %dx%d",
+                              prev[0]->getWidth(), prev[0]->getHeight(), cur.empty() ? 0 : cur[0]->getWidth(),
+                              cur.empty() ? 0 : cur[0]->getHeight()));
+  }
+  unsigned int nbLevels = static_cast<unsigned int>(std::min(prev.size(), cur.size()));
+  buildDerivatives(prev, nbLevels);
+
+  if (!m_initial_guess) {
+    m_points[0] = m_points[1];
+  }
+
+  std::vector<unsigned char> status(m_points[1].size());
+  vpLucasKanadeBody body(prev, m_derivU, m_derivV, cur, static_cast<int>(nbLevels), m_winSize, m_maxIterations,
+                         static_cast<float>(m_epsilon), static_cast<float>(m_minEigThreshold), m_initial_guess,
+                         m_points[0], m_points[1], status);
+  vpThreadPool::instance().parallel_for(0, static_cast<int>(m_points[1].size()), body, 4);
+  m_initial_guess = false;
+
+  // Remove the lost features
+  size_t nb = 0;
+  for (size_t i = 0; i < status.size(); i++) {
+    if (status[i]) {
+      m_points[0][nb] = m_points[0][i];
+      m_points[1][nb] = m_points[1][i];
+      m_points_id[nb] = m_points_id[i];
+      nb++;
+    }
+  }
+  m_points[0].resize(nb);
+  m_points[1].resize(nb);
+  m_points_id.resize(nb);
+}
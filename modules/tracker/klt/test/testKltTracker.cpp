@@ -0,0 +1,271 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test vpKltTracker.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testKltTracker.cpp
+
+  \brief Check the corners detected by vpKltTracker and their tracking in a
+  synthetic image translated by a known sub-pixel displacement.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <visp3/core/vpImagePyramid.h>
+#include <visp3/core/vpTrackingException.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/klt/vpKltTracker.h>
+
+namespace
+{
+struct Rect {
+  double top, left, bottom, right;
+  double amplitude;
+};
+
+// Length of the intersection of the intervals [a0, a1] and [b0, b1]
+double overlap(double a0, double a1, double b0, double b1)
+{
+  return std::max(0.0, std::min(a1, b1) - std::max(a0, b0));
+}
+
+// Textured image made of rectangles translated by (du, dv). Each pixel is
+// the exact mean over a 2x2 pixels footprint, so that the edges are smooth
+// and located with sub-pixel accuracy.
+void generateImage(const std::vector<Rect> &rects, double du, double dv, vpImage<unsigned char> &I)
+{
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      double val = 128;
+      for (size_t k = 0; k < rects.size(); k++) {
+        double y = i - dv, x = j - du;
+        val += rects[k].amplitude * overlap(y - 1, y + 1, rects[k].top, rects[k].bottom) *
+               overlap(x - 1, x + 1, rects[k].left, rects[k].right) / 4;
+      }
+      I[i][j] = (unsigned char)(val < 0 ? 0 : (val > 255 ? 255 : val + 0.5));
+    }
+  }
+}
+
+bool checkDetection(const vpKltTracker &tracker, double minDistance, int maxCount)
+{
+  const std::vector<vpImagePoint> &pts = tracker.getFeatures();
+  if (pts.empty() || (int)pts.size() > maxCount) {
+    std::cerr << "Bad number of detected features: " << pts.size() << std::endl;
+    return false;
+  }
+  // The sub-pixel refinement moves the corners by a few pixels, and can
+  // bring the detections of the edges next to a junction onto the same point
+  size_t nbClose = 0;
+  for (size_t i = 0; i < pts.size(); i++) {
+    for (size_t j = i + 1; j < pts.size(); j++) {
+      if (vpImagePoint::distance(pts[i], pts[j]) < minDistance - 2) {
+        nbClose++;
+      }
+    }
+  }
+  if (nbClose > pts.size() / 10) {
+    std::cerr << nbClose << " pairs of features are too close" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool checkTracking(const vpKltTracker &tracker, const std::vector<vpImagePoint> &initial,
+                   const std::vector<long> &initialIds, double du, double dv)
+{
+  if (tracker.getNbFeatures() < (int)initial.size() * 9 / 10) {
+    std::cerr << "Lost too many features: " << tracker.getNbFeatures() << " / " << initial.size() << std::endl;
+    return false;
+  }
+  unsigned int nbBad = 0;
+  for (int k = 0; k < tracker.getNbFeatures(); k++) {
+    long id;
+    float x, y;
+    tracker.getFeature(k, id, x, y);
+    size_t l = 0;
+    while (l < initialIds.size() && initialIds[l] != id) {
+      l++;
+    }
+    if (l == initialIds.size()) {
+      std::cerr << "Unknown feature id " << id << std::endl;
+      return false;
+    }
+    if (std::fabs(x - initial[l].get_u() - du) > 0.1 || std::fabs(y - initial[l].get_v() - dv) > 0.1) {
+      nbBad++;
+    }
+  }
+  if (nbBad > (unsigned int)tracker.getNbFeatures() / 10) {
+    std::cerr << nbBad << " features are badly tracked" << std::endl;
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+int main()
+{
+  try {
+    vpUniRand rng(42);
+    std::vector<Rect> rects(60);
+    for (size_t k = 0; k < rects.size(); k++) {
+      rects[k].top = rng.uniform(-20.0, 240.0);
+      rects[k].left = rng.uniform(-20.0, 320.0);
+      rects[k].bottom = rects[k].top + rng.uniform(15.0, 60.0);
+      rects[k].right = rects[k].left + rng.uniform(15.0, 60.0);
+      rects[k].amplitude = rng.uniform(0, 2) ? rng.uniform(30.0, 60.0) : -rng.uniform(30.0, 60.0);
+    }
+
+    vpImage<unsigned char> I0(240, 320), I1(240, 320);
+    const double du = 3.3, dv = -2.6;
+    generateImage(rects, 0, 0, I0);
+    generateImage(rects, du, dv, I1);
+
+    vpKltTracker tracker;
+    tracker.setMaxFeatures(100);
+    tracker.setMinDistance(15);
+    tracker.initTracking(I0);
+    if (!checkDetection(tracker, 15, 100)) {
+      return EXIT_FAILURE;
+    }
+    std::cout << "Detected " << tracker.getNbFeatures() << " features" << std::endl;
+    const std::vector<vpImagePoint> initial = tracker.getFeatures();
+    const std::vector<long> initialIds = tracker.getFeaturesId();
+
+    tracker.track(I1);
+    if (!checkTracking(tracker, initial, initialIds, du, dv)) {
+      return EXIT_FAILURE;
+    }
+
+    // Tracking in a pyramid built by the caller gives the same result
+    vpKltTracker trackerPyr;
+    trackerPyr.setMaxFeatures(100);
+    trackerPyr.setMinDistance(15);
+    trackerPyr.initTracking(I0);
+    trackerPyr.track(vpImagePyramid(I1, 4));
+    if (trackerPyr.getFeatures() != tracker.getFeatures() || trackerPyr.getFeaturesId() != tracker.getFeaturesId()) {
+      std::cerr << "Different results with a given pyramid" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // The previous levels are kept when the caller rebuilds its pyramid, and
+    // both kinds of calls can be mixed
+    vpImagePyramid pyramid(I0, 4);
+    tracker.track(I0);
+    trackerPyr.track(pyramid);
+    pyramid.build(I1, 4);
+    tracker.track(pyramid);
+    trackerPyr.track(I1);
+    if (trackerPyr.getFeatures() != tracker.getFeatures() || trackerPyr.getFeaturesId() != tracker.getFeaturesId()) {
+      std::cerr << "Different results with a reused pyramid" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // A copy of the tracker keeps tracking once the original is destroyed,
+    // whether the previous image is in its own pyramid or in a given one
+    for (int given = 0; given < 2; given++) {
+      vpKltTracker *original = new vpKltTracker;
+      original->setMaxFeatures(100);
+      original->setMinDistance(15);
+      original->initTracking(I0);
+      if (given) {
+        original->track(vpImagePyramid(I0, 4));
+      }
+      vpKltTracker copy(*original);
+      delete original;
+      copy.track(I1);
+      if (!checkTracking(copy, initial, initialIds, du, dv)) {
+        std::cerr << "Bad tracking with a copied tracker" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // Tracking with an initial guess and given points
+    tracker.initTracking(I0, initial, initialIds);
+    std::vector<vpImagePoint> guess = initial;
+    for (size_t k = 0; k < guess.size(); k++) {
+      guess[k].set_uv(guess[k].get_u() + 3, guess[k].get_v() - 3);
+    }
+    tracker.setInitialGuess(guess);
+    tracker.track(I1);
+    if (!checkTracking(tracker, initial, initialIds, du, dv)) {
+      return EXIT_FAILURE;
+    }
+
+    // No feature is detected outside the mask, up to the sub-pixel refinement
+    // window
+    vpImage<unsigned char> mask(240, 320, 0);
+    for (unsigned int i = 60; i < 180; i++) {
+      for (unsigned int j = 80; j < 240; j++) {
+        mask[i][j] = 255;
+      }
+    }
+    tracker.setUseHarris(true);
+    tracker.initTracking(I0, &mask);
+    if (!checkDetection(tracker, 15, 100)) {
+      return EXIT_FAILURE;
+    }
+    for (int k = 0; k < tracker.getNbFeatures(); k++) {
+      const vpImagePoint &ip = tracker.getFeatures()[(size_t)k];
+      if (ip.get_v() < 50 || ip.get_v() > 190 || ip.get_u() < 70 || ip.get_u() > 250) {
+        std::cerr << "Feature " << ip << " outside the mask" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // Nothing to track in a uniform image
+    vpImage<unsigned char> uniform(240, 320, 128);
+    tracker.initTracking(uniform);
+    bool thrown = false;
+    try {
+      tracker.track(uniform);
+    } catch (const vpTrackingException &) {
+      thrown = true;
+    }
+    if (!thrown || tracker.getNbFeatures() != 0) {
+      std::cerr << "Features detected in a uniform image" << std::endl;
+      return EXIT_FAILURE;
+    }
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test succeed" << std::endl;
+  return EXIT_SUCCESS;
+}
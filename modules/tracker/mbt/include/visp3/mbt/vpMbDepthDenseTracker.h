@@ -117,6 +117,7 @@ public:
   virtual void track(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud);
 #endif
   virtual void track(const std::vector<vpColVector> &point_cloud, const unsigned int width, const unsigned int height);
+  virtual void track(const vpMatrix &point_cloud, const unsigned int width, const unsigned int height);
 
 protected:
   //! Set of faces describing the object used only for display with scan line.
@@ -171,5 +172,8 @@ protected:
 #endif
   void segmentPointCloud(const std::vector<vpColVector> &point_cloud, const unsigned int width,
                          const unsigned int height);
+  void segmentPointCloud(const vpMatrix &point_cloud, const unsigned int width, const unsigned int height);
+  template <class PointCloud>
+  void segmentPointCloudImpl(const PointCloud &point_cloud, const unsigned int width, const unsigned int height);
 };
 #endif
@@ -47,13 +47,14 @@
 
 #include <visp3/core/vpConfig.h>
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
 
 #include <visp3/core/vpExponentialMap.h>
 #include <visp3/core/vpPoseVector.h>
 #include <visp3/core/vpSubColVector.h>
 #include <visp3/core/vpSubMatrix.h>
 #include <visp3/klt/vpKltOpencv.h>
+#include <visp3/klt/vpKltTracker.h>
 #include <visp3/mbt/vpMbEdgeTracker.h>
 #include <visp3/mbt/vpMbKltTracker.h>
 #include <visp3/mbt/vpMbTracker.h>
@@ -63,11 +64,13 @@
   \ingroup group_mbt_trackers
   \warning This class is deprecated for user usage. You should rather use the high level
   vpMbGenericTracker class.
-  \warning This class is only available if OpenCV is installed, and used.
 
   \brief Hybrid tracker based on moving-edges and keypoints tracked using KLT
   tracker.
 
+  The keypoints are tracked with vpKltOpencv when OpenCV is installed, and
+  used, and with vpKltTracker otherwise.
+
   The \ref tutorial-tracking-mb-deprecated is a good starting point to use this class.
 
   The tracker requires the knowledge of the 3D model that could be provided in
@@ -361,4 +364,4 @@ protected:
 
 #endif
 
-#endif // VISP_HAVE_OPENCV
+#endif // VISP_HAVE_MODULE_KLT
@@ -82,7 +82,7 @@ class VISP_EXPORT vpMbGenericTracker : public vpMbTracker
 public:
   enum vpTrackerType {
     EDGE_TRACKER = 1 << 0, /*!< Model-based tracking using moving edges features. */
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
     KLT_TRACKER = 1 << 1, /*!< Model-based tracking using KLT features. */
 #endif
     DEPTH_NORMAL_TRACKER = 1 << 2, /*!< Model-based tracking using depth normal features. */
@@ -140,7 +140,7 @@ public:
   virtual vpMbHiddenFaces<vpMbtPolygon> &getFaces();
   virtual vpMbHiddenFaces<vpMbtPolygon> &getFaces(const std::string &cameraName);
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   virtual std::list<vpMbtDistanceCircle *> &getFeaturesCircle();
   virtual std::list<vpMbtDistanceKltCylinder *> &getFeaturesKltCylinder();
   virtual std::list<vpMbtDistanceKltPoints *> &getFeaturesKlt();
@@ -151,18 +151,22 @@ public:
 
   virtual double getGoodMovingEdgesRatioThreshold() const;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   virtual std::vector<vpImagePoint> getKltImagePoints() const;
   virtual std::map<int, vpImagePoint> getKltImagePointsWithId() const;
 
   virtual unsigned int getKltMaskBorder() const;
   virtual int getKltNbPoints() const;
 
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   virtual vpKltOpencv getKltOpencv() const;
   virtual void getKltOpencv(vpKltOpencv &klt1, vpKltOpencv &klt2) const;
   virtual void getKltOpencv(std::map<std::string, vpKltOpencv> &mapOfKlts) const;
+#else
+  virtual vpKltTracker getKltTracker() const;
+#endif
 
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408))
   virtual std::vector<cv::Point2f> getKltPoints() const;
 #endif
 
@@ -356,14 +360,18 @@ public:
   virtual void setNbRayCastingAttemptsForVisibility(const unsigned int &attempts);
 #endif
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   virtual void setKltMaskBorder(const unsigned int &e);
   virtual void setKltMaskBorder(const unsigned int &e1, const unsigned int &e2);
   virtual void setKltMaskBorder(const std::map<std::string, unsigned int> &mapOfErosions);
 
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   virtual void setKltOpencv(const vpKltOpencv &t);
   virtual void setKltOpencv(const vpKltOpencv &t1, const vpKltOpencv &t2);
   virtual void setKltOpencv(const std::map<std::string, vpKltOpencv> &mapOfKlts);
+#else
+  virtual void setKltTracker(const vpKltTracker &t);
+#endif
 
   virtual void setKltThresholdAcceptation(const double th);
 
@@ -389,6 +397,8 @@ public:
 
   virtual void setOptimizationMethod(const vpMbtOptimizationMethod &opt);
 
+  virtual void setParallelCameraComputation(const bool parallel);
+
   virtual void setPose(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cdMo);
   virtual void setPose(const vpImage<vpRGBa> &I_color, const vpHomogeneousMatrix &cdMo);
 
@@ -418,7 +428,7 @@ public:
   virtual void setUseDepthDenseTracking(const std::string &name, const bool &useDepthDenseTracking);
   virtual void setUseDepthNormalTracking(const std::string &name, const bool &useDepthNormalTracking);
   virtual void setUseEdgeTracking(const std::string &name, const bool &useEdgeTracking);
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   virtual void setUseKltTracking(const std::string &name, const bool &useKltTracking);
 #endif
 
@@ -449,6 +459,15 @@ public:
                      std::map<std::string, unsigned int> &mapOfPointCloudWidths,
                      std::map<std::string, unsigned int> &mapOfPointCloudHeights);
 
+  virtual void track(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                     std::map<std::string, const vpMatrix *> &mapOfPointClouds,
+                     std::map<std::string, unsigned int> &mapOfPointCloudWidths,
+                     std::map<std::string, unsigned int> &mapOfPointCloudHeights);
+  virtual void track(std::map<std::string, const vpImage<vpRGBa> *> &mapOfColorImages,
+                     std::map<std::string, const vpMatrix *> &mapOfPointClouds,
+                     std::map<std::string, unsigned int> &mapOfPointCloudWidths,
+                     std::map<std::string, unsigned int> &mapOfPointCloudHeights);
+
 protected:
   virtual void computeProjectionError();
 
@@ -459,6 +478,8 @@ protected:
   virtual void computeVVSInteractionMatrixAndResidu();
   virtual void computeVVSInteractionMatrixAndResidu(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
                                                     std::map<std::string, vpVelocityTwistMatrix> &mapOfVelocityTwist);
+  virtual void computeVVSNormalEquations(double &num, double &den);
+  virtual void computeVVSPoseUpdate(const bool isoJoIdentity_, const unsigned int iter, double &mu, vpColVector &v);
   using vpMbTracker::computeVVSWeights;
   virtual void computeVVSWeights();
 
@@ -480,10 +501,87 @@ protected:
                            std::map<std::string, const std::vector<vpColVector> *> &mapOfPointClouds,
                            std::map<std::string, unsigned int> &mapOfPointCloudWidths,
                            std::map<std::string, unsigned int> &mapOfPointCloudHeights);
+  virtual void preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                           std::map<std::string, const vpMatrix *> &mapOfPointClouds,
+                           std::map<std::string, unsigned int> &mapOfPointCloudWidths,
+                           std::map<std::string, unsigned int> &mapOfPointCloudHeights);
 
 private:
+  class TrackerWrapper;
+
+  static void checkPointCloud(const std::string &cameraName, const std::vector<vpColVector> *point_cloud,
+                              const unsigned int width, const unsigned int height);
+  static void checkPointCloud(const std::string &cameraName, const vpMatrix *point_cloud, const unsigned int width,
+                              const unsigned int height);
+
+  template <class PointCloud>
+  void trackImpl(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                 std::map<std::string, const vpImage<vpRGBa> *> *mapOfColorImages,
+                 std::map<std::string, const PointCloud *> &mapOfPointClouds,
+                 std::map<std::string, unsigned int> &mapOfPointCloudWidths,
+                 std::map<std::string, unsigned int> &mapOfPointCloudHeights);
+
+  /*!
+    Buffers used by the virtual visual servoing stage. They are resized once
+    per frame, in computeVVSInit(), so that no memory is allocated for them
+    during the Gauss-Newton / Levenberg-Marquardt iterations.
+  */
+  class VVSWorkspace
+  {
+  public:
+    //! Robust weights multiplied by the feature factors
+    vpColVector W_true;
+    //! Unweighted interaction matrix kept for the covariance computation
+    vpMatrix L_true;
+    //! Unweighted interaction matrix times the Jacobian kept for the
+    //! covariance computation
+    vpMatrix LVJ_true;
+    //! Residual of the previous iteration
+    vpColVector error_prev;
+    //! Weighted normal matrix (6x6)
+    vpMatrix LTL;
+    //! Weighted right hand side of the normal equations (6x1)
+    vpColVector LTR;
+    //! Normal matrix expressed in the estimated dof, with damping (6x6)
+    vpMatrix H;
+    //! Right hand side expressed in the estimated dof (6x1)
+    vpColVector g;
+    //! Solution of the normal equations H dv = g (6x1)
+    vpColVector dv;
+    //! Jacobian cVo * oJo (6x6)
+    vpMatrix J;
+    //! Temporary 6x6 product
+    vpMatrix tmp;
+    //! Velocity twist matrix built from the current pose
+    vpVelocityTwistMatrix cVo;
+    //! Displacement given by the exponential map of the velocity
+    vpHomogeneousMatrix dM;
+    //! Inverse of dM, applied to the previous pose
+    vpHomogeneousMatrix dMinv;
+    //! Unweighted normal matrix expressed in the object frame, used to test
+    //! the rank of the interaction matrix (6x6)
+    vpMatrix LTLo;
+    //! Kernel of the interaction matrix when it is rank deficient
+    vpMatrix K;
+    //! Trackers of the cameras, given to the per-camera stages
+    std::vector<TrackerWrapper *> trackers;
+    //! Image of each camera
+    std::vector<const vpImage<unsigned char> *> images;
+    //! Velocity twist matrix of each camera
+    std::vector<vpVelocityTwistMatrix> velocityTwists;
+    //! First row of each camera in the stacked system
+    std::vector<unsigned int> startIndexes;
+
+    VVSWorkspace();
+    void resize(const unsigned int nbFeatures, const bool computeCovariance);
+  };
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+  class CameraVVSBody;
+#endif
+
   class TrackerWrapper : public vpMbEdgeTracker,
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                          public vpMbKltTracker,
 #endif
                          public vpMbDepthNormalTracker,
@@ -606,6 +704,8 @@ private:
     virtual void preTracking(const vpImage<unsigned char> *const ptr_I = NULL,
                              const std::vector<vpColVector> *const point_cloud = NULL,
                              const unsigned int pointcloud_width = 0, const unsigned int pointcloud_height = 0);
+    virtual void preTracking(const vpImage<unsigned char> *const ptr_I, const vpMatrix *const point_cloud,
+                             const unsigned int pointcloud_width, const unsigned int pointcloud_height);
 
     virtual void reInitModel(const vpImage<unsigned char> * const I, const vpImage<vpRGBa> * const I_color,
                              const std::string &cad_name, const vpHomogeneousMatrix &cMo_, const bool verbose = false,
@@ -648,5 +748,11 @@ protected:
   vpColVector m_w;
   //! Weighted error
   vpColVector m_weightedError;
+  //! If true, compute the features of each camera in parallel
+  bool m_parallelCameraComputation;
+
+private:
+  //! Buffers of the virtual visual servoing stage
+  VVSWorkspace m_vvsWorkspace;
 };
 #endif
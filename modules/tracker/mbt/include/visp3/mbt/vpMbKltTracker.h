@@ -46,7 +46,7 @@
 
 #include <visp3/core/vpConfig.h>
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
 
 #include <visp3/core/vpExponentialMap.h>
 #include <visp3/core/vpMeterPixelConversion.h>
@@ -54,6 +54,7 @@
 #include <visp3/core/vpSubColVector.h>
 #include <visp3/core/vpSubMatrix.h>
 #include <visp3/klt/vpKltOpencv.h>
+#include <visp3/klt/vpKltTracker.h>
 #include <visp3/mbt/vpMbTracker.h>
 #include <visp3/mbt/vpMbtDistanceCircle.h>
 #include <visp3/mbt/vpMbtDistanceKltCylinder.h>
@@ -65,10 +66,12 @@
   \ingroup group_mbt_trackers
   \warning This class is deprecated for user usage. You should rather use the high level
   vpMbGenericTracker class.
-  \warning This class is only available if OpenCV is installed, and used.
 
   \brief Model based tracker using only KLT.
 
+  The points are tracked with vpKltOpencv when OpenCV is installed, and used,
+  and with vpKltTracker otherwise.
+
   The \ref tutorial-tracking-mb-deprecated is a good starting point to use this class.
 
   The tracker requires the knowledge of the 3D model that could be provided in
@@ -219,10 +222,11 @@ class VISP_EXPORT vpMbKltTracker : public virtual vpMbTracker
   friend class vpMbEdgeKltMultiTracker;
 
 protected:
-//! Temporary OpenCV image for fast conversion.
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408))
+  //! Temporary OpenCV image for fast conversion.
   cv::Mat cur;
-#else
+#elif (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+  //! Temporary OpenCV image for fast conversion.
   IplImage *cur;
 #endif
   //! Initial pose.
@@ -242,7 +246,11 @@ protected:
   //! the initial position.
   vpHomogeneousMatrix ctTc0;
   //! Points tracker.
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   vpKltOpencv tracker;
+#else
+  vpKltTracker tracker;
+#endif
   //!
   std::list<vpMbtDistanceKltPoints *> kltPolygons;
   //!
@@ -291,9 +299,9 @@ public:
 
    \return the list of KLT points through vpKltOpencv.
  */
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408))
   inline std::vector<cv::Point2f> getKltPoints() const { return tracker.getFeatures(); }
-#else
+#elif (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   inline CvPoint2D32f *getKltPoints() { return tracker.getFeatures(); }
 #endif
 
@@ -301,12 +309,21 @@ public:
 
   std::map<int, vpImagePoint> getKltImagePointsWithId() const;
 
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   /*!
     Get the klt tracker at the current state.
 
     \return klt tracker.
    */
   inline vpKltOpencv getKltOpencv() const { return tracker; }
+#else
+  /*!
+    Get the klt tracker at the current state.
+
+    \return klt tracker.
+   */
+  inline vpKltTracker getKltTracker() const { return tracker; }
+#endif
 
   /*!
     Get the erosion of the mask used on the Model faces.
@@ -360,7 +377,11 @@ public:
     faces.getMbScanLineRenderer().setMaskBorder(maskBorder);
   }
 
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   virtual void setKltOpencv(const vpKltOpencv &t);
+#else
+  virtual void setKltTracker(const vpKltTracker &t);
+#endif
 
   /*!
     Set the threshold for the acceptation of a point.
@@ -496,4 +517,4 @@ protected:
 };
 
 #endif
-#endif // VISP_HAVE_OPENCV
+#endif // VISP_HAVE_MODULE_KLT
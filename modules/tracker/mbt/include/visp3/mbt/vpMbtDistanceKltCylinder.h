@@ -41,7 +41,7 @@
 
 #include <visp3/core/vpConfig.h>
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
 
 #include <map>
 
@@ -52,6 +52,7 @@
 #include <visp3/core/vpPlane.h>
 #include <visp3/core/vpPolygon3D.h>
 #include <visp3/klt/vpKltOpencv.h>
+#include <visp3/klt/vpKltTracker.h>
 #include <visp3/mbt/vpMbHiddenFaces.h>
 #include <visp3/vision/vpHomography.h>
 
@@ -61,7 +62,8 @@
   \brief Implementation of a polygon of the model containing points of
   interest. It is used by the model-based tracker KLT, and hybrid.
 
-  \warning This class is only available if OpenCV is installed, and used.
+  The points can be given by vpKltTracker, or by vpKltOpencv if OpenCV is
+  installed, and used.
 
   \ingroup group_mbt_features
 */
@@ -112,6 +114,10 @@ public:
 private:
   double computeZ(const double &x, const double &y);
   bool isTrackedFeature(const int id);
+  template <class KltTracker> unsigned int computeNbDetectedCurrentImpl(const KltTracker &_tracker);
+  template <class KltTracker> void initImpl(const KltTracker &_tracker, const vpHomogeneousMatrix &cMo);
+  void updateMaskImpl(unsigned char *data, int width, int height, int stride, unsigned char _nb,
+                      unsigned int _shiftBorder);
 
   // private:
   //#ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -137,7 +143,10 @@ public:
 
   void buildFrom(const vpPoint &p1, const vpPoint &p2, const double &r);
 
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   unsigned int computeNbDetectedCurrent(const vpKltOpencv &_tracker);
+#endif
+  unsigned int computeNbDetectedCurrent(const vpKltTracker &_tracker);
   void computeInteractionMatrixAndResidu(const vpHomogeneousMatrix &cMc0, vpColVector &_R, vpMatrix &_J);
 
   void display(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam,
@@ -195,7 +204,10 @@ public:
   */
   inline bool isTracked() const { return isTrackedKltCylinder; }
 
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   void init(const vpKltOpencv &_tracker, const vpHomogeneousMatrix &cMo);
+#endif
+  void init(const vpKltTracker &_tracker, const vpHomogeneousMatrix &cMo);
 
   void removeOutliers(const vpColVector &weight, const double &threshold_outlier);
 
@@ -213,13 +225,14 @@ public:
   */
   inline void setTracked(const bool &track) { this->isTrackedKltCylinder = track; }
 
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408))
   void updateMask(cv::Mat &mask, unsigned char _nb = 255, unsigned int _shiftBorder = 0);
-#else
+#elif (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   void updateMask(IplImage *mask, unsigned char _nb = 255, unsigned int _shiftBorder = 0);
 #endif
+  void updateMask(vpImage<unsigned char> &mask, unsigned char _nb = 255, unsigned int _shiftBorder = 0);
 };
 
 #endif
 
-#endif // VISP_HAVE_OPENCV
+#endif // VISP_HAVE_MODULE_KLT
@@ -107,6 +107,14 @@ public:
 #endif
                               , const vpImage<bool> *mask = NULL
   );
+  bool computeDesiredFeatures(const vpHomogeneousMatrix &cMo, const unsigned int width, const unsigned int height,
+                              const vpMatrix &point_cloud, const unsigned int stepX, const unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                              ,
+                              vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                              , const vpImage<bool> *mask = NULL
+  );
 
   void computeInteractionMatrixAndResidu(const vpHomogeneousMatrix &cMo, vpMatrix &L, vpColVector &error);
 
@@ -226,6 +234,17 @@ protected:
   std::vector<PolygonLine> m_polygonLines;
 
 protected:
+  template <class PointCloud>
+  bool computeDesiredFeaturesImpl(const vpHomogeneousMatrix &cMo, const unsigned int width, const unsigned int height,
+                                  const PointCloud &point_cloud, const unsigned int stepX, const unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                  ,
+                                  vpImage<unsigned char> &debugImage,
+                                  std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                  , const vpImage<bool> *mask
+  );
+
   void computeROI(const vpHomogeneousMatrix &cMo, const unsigned int width, const unsigned int height,
                   std::vector<vpImagePoint> &roiPts
 #if DEBUG_DISPLAY_DEPTH_DENSE
@@ -109,6 +109,15 @@ public:
 #endif
                               , const vpImage<bool> *mask = NULL
   );
+  bool computeDesiredFeatures(const vpHomogeneousMatrix &cMo, const unsigned int width, const unsigned int height,
+                              const vpMatrix &point_cloud, vpColVector &desired_features,
+                              const unsigned int stepX, const unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                              ,
+                              vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                              , const vpImage<bool> *mask = NULL
+  );
 
   void computeInteractionMatrix(const vpHomogeneousMatrix &cMo, vpMatrix &L, vpColVector &features);
 
@@ -274,6 +283,17 @@ protected:
                                  vpColVector &desired_features, vpColVector &desired_normal,
                                  vpColVector &centroid_point);
 #endif
+  template <class PointCloud>
+  bool computeDesiredFeaturesImpl(const vpHomogeneousMatrix &cMo, const unsigned int width, const unsigned int height,
+                                  const PointCloud &point_cloud, vpColVector &desired_features,
+                                  const unsigned int stepX, const unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                  ,
+                                  vpImage<unsigned char> &debugImage,
+                                  std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                  , const vpImage<bool> *mask
+  );
   void computeDesiredFeaturesRobustFeatures(const std::vector<double> &point_cloud_face_custom,
                                             const std::vector<double> &point_cloud_face, const vpHomogeneousMatrix &cMo,
                                             vpColVector &desired_features, vpColVector &desired_normal,
@@ -197,7 +197,7 @@ void vpMbDepthDenseTracker::computeVVS()
           cVo.buildFrom(cMo);
 
           vpMatrix K; // kernel
-          unsigned int rank = (m_L_depthDense * cVo).kernel(K);
+          unsigned int rank = (m_L_depthDense * cVo).AtA().kernelNormalEquations6(K);
           if (rank == 0) {
             throw vpException(vpException::fatalError, "Rank=0, cannot estimate the pose !");
           }
@@ -601,6 +601,25 @@ void vpMbDepthDenseTracker::segmentPointCloud(const pcl::PointCloud<pcl::PointXY
 
 void vpMbDepthDenseTracker::segmentPointCloud(const std::vector<vpColVector> &point_cloud, const unsigned int width,
                                               const unsigned int height)
+{
+  segmentPointCloudImpl(point_cloud, width, height);
+}
+
+void vpMbDepthDenseTracker::segmentPointCloud(const vpMatrix &point_cloud, const unsigned int width,
+                                              const unsigned int height)
+{
+  if (point_cloud.getCols() != 3 || point_cloud.getRows() != width * height) {
+    throw vpException(vpException::dimensionError,
+                      "Point cloud matrix is %dx%d, expected %dx3 for a %dx%d organized point cloud",
+                      point_cloud.getRows(), point_cloud.getCols(), width * height, width, height);
+  }
+
+  segmentPointCloudImpl(point_cloud, width, height);
+}
+
+template <class PointCloud>
+void vpMbDepthDenseTracker::segmentPointCloudImpl(const PointCloud &point_cloud, const unsigned int width,
+                                                  const unsigned int height)
 {
   m_depthDenseListOfActiveFaces.clear();
 
@@ -742,6 +761,26 @@ void vpMbDepthDenseTracker::track(const std::vector<vpColVector> &point_cloud, c
   computeVisibility(width, height);
 }
 
+/*!
+  Track the object using an organized point cloud stored in a contiguous
+  (width*height)x3 matrix, each row containing the X, Y, Z coordinates of a
+  point expressed in the depth camera frame.
+
+  \throw vpException::dimensionError if the matrix is not (width*height)x3.
+
+  \param point_cloud : Point cloud.
+  \param width : Width of the point cloud.
+  \param height : Height of the point cloud.
+*/
+void vpMbDepthDenseTracker::track(const vpMatrix &point_cloud, const unsigned int width, const unsigned int height)
+{
+  segmentPointCloud(point_cloud, width, height);
+
+  computeVVS();
+
+  computeVisibility(width, height);
+}
+
 void vpMbDepthDenseTracker::initCircle(const vpPoint & /*p1*/, const vpPoint & /*p2*/, const vpPoint & /*p3*/,
                                        const double /*radius*/, const int /*idFace*/, const std::string & /*name*/)
 {
@@ -202,7 +202,7 @@ void vpMbDepthNormalTracker::computeVVS()
           cVo.buildFrom(cMo);
 
           vpMatrix K; // kernel
-          unsigned int rank = (m_L_depthNormal * cVo).kernel(K);
+          unsigned int rank = (m_L_depthNormal * cVo).AtA().kernelNormalEquations6(K);
           if (rank == 0) {
             throw vpException(vpException::fatalError, "Rank=0, cannot estimate the pose !");
           }
@@ -650,6 +650,25 @@ void vpMbDepthNormalTracker::segmentPointCloud(const pcl::PointCloud<pcl::PointX
 
 void vpMbDepthNormalTracker::segmentPointCloud(const std::vector<vpColVector> &point_cloud, const unsigned int width,
                                                const unsigned int height)
+{
+  segmentPointCloudImpl(point_cloud, width, height);
+}
+
+void vpMbDepthNormalTracker::segmentPointCloud(const vpMatrix &point_cloud, const unsigned int width,
+                                               const unsigned int height)
+{
+  if (point_cloud.getCols() != 3 || point_cloud.getRows() != width * height) {
+    throw vpException(vpException::dimensionError,
+                      "Point cloud matrix is %dx%d, expected %dx3 for a %dx%d organized point cloud",
+                      point_cloud.getRows(), point_cloud.getCols(), width * height, width, height);
+  }
+
+  segmentPointCloudImpl(point_cloud, width, height);
+}
+
+template <class PointCloud>
+void vpMbDepthNormalTracker::segmentPointCloudImpl(const PointCloud &point_cloud, const unsigned int width,
+                                                   const unsigned int height)
 {
   m_depthNormalListOfActiveFaces.clear();
   m_depthNormalListOfDesiredFeatures.clear();
@@ -816,6 +835,26 @@ void vpMbDepthNormalTracker::track(const std::vector<vpColVector> &point_cloud,
   computeVisibility(width, height);
 }
 
+/*!
+  Track the object using an organized point cloud stored in a contiguous
+  (width*height)x3 matrix, each row containing the X, Y, Z coordinates of a
+  point expressed in the depth camera frame.
+
+  \throw vpException::dimensionError if the matrix is not (width*height)x3.
+
+  \param point_cloud : Point cloud.
+  \param width : Width of the point cloud.
+  \param height : Height of the point cloud.
+*/
+void vpMbDepthNormalTracker::track(const vpMatrix &point_cloud, const unsigned int width, const unsigned int height)
+{
+  segmentPointCloud(point_cloud, width, height);
+
+  computeVVS();
+
+  computeVisibility(width, height);
+}
+
 void vpMbDepthNormalTracker::initCircle(const vpPoint & /*p1*/, const vpPoint & /*p2*/, const vpPoint & /*p3*/,
                                         const double /*radius*/, const int /*idFace*/, const std::string & /*name*/)
 {
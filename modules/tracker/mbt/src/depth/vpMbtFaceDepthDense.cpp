@@ -266,15 +266,16 @@ bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo,
 }
 #endif
 
-bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, const unsigned int width,
-                                                 const unsigned int height, const std::vector<vpColVector> &point_cloud,
-                                                 const unsigned int stepX, const unsigned int stepY
+template <class PointCloud>
+bool vpMbtFaceDepthDense::computeDesiredFeaturesImpl(const vpHomogeneousMatrix &cMo, const unsigned int width,
+                                                     const unsigned int height, const PointCloud &point_cloud,
+                                                     const unsigned int stepX, const unsigned int stepY
 #if DEBUG_DISPLAY_DEPTH_DENSE
-                                                 ,
-                                                 vpImage<unsigned char> &debugImage,
-                                                 std::vector<std::vector<vpImagePoint> > &roiPts_vec
+                                                     ,
+                                                     vpImage<unsigned char> &debugImage,
+                                                     std::vector<std::vector<vpImagePoint> > &roiPts_vec
 #endif
-                                                 , const vpImage<bool> *mask
+                                                     , const vpImage<bool> *mask
 )
 {
   m_pointCloudFace.clear();
@@ -388,6 +389,68 @@ bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo,
   return true;
 }
 
+bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, const unsigned int width,
+                                                 const unsigned int height, const std::vector<vpColVector> &point_cloud,
+                                                 const unsigned int stepX, const unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                                 ,
+                                                 vpImage<unsigned char> &debugImage,
+                                                 std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                                 , const vpImage<bool> *mask
+)
+{
+  return computeDesiredFeaturesImpl(cMo, width, height, point_cloud, stepX, stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                    ,
+                                    debugImage, roiPts_vec
+#endif
+                                    , mask);
+}
+
+/*!
+  Keep the 3D points that belong to the face.
+
+  \param cMo : Current pose.
+  \param width : Width of the point cloud.
+  \param height : Height of the point cloud.
+  \param point_cloud : Organized point cloud stored in a (width*height)x3
+  matrix, each row containing the X, Y, Z coordinates of a point. Contrary to
+  the std::vector<vpColVector> representation, the points are stored in one
+  contiguous memory block.
+  \param stepX : Sampling step along the X-axis.
+  \param stepY : Sampling step along the Y-axis.
+  \param mask : Mask image, only pixels with a true value are considered.
+
+  \return True if the face is considered by the tracker.
+
+  \throw vpException::dimensionError if the matrix is not (width*height)x3.
+*/
+bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, const unsigned int width,
+                                                 const unsigned int height, const vpMatrix &point_cloud,
+                                                 const unsigned int stepX, const unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                                 ,
+                                                 vpImage<unsigned char> &debugImage,
+                                                 std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                                 , const vpImage<bool> *mask
+)
+{
+  if (point_cloud.getCols() != 3 || point_cloud.getRows() != width * height) {
+    throw vpException(vpException::dimensionError,
+                      "Point cloud matrix is %dx%d, expected %dx3 for a %dx%d organized point cloud",
+                      point_cloud.getRows(), point_cloud.getCols(), width * height, width, height);
+  }
+
+  return computeDesiredFeaturesImpl(cMo, width, height, point_cloud, stepX, stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                    ,
+                                    debugImage, roiPts_vec
+#endif
+                                    , mask);
+}
+
 void vpMbtFaceDepthDense::computeVisibility() { m_isVisible = m_polygon->isVisible(); }
 
 void vpMbtFaceDepthDense::computeVisibilityDisplay()
@@ -307,17 +307,17 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
 }
 #endif
 
-bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, const unsigned int width,
-                                                  const unsigned int height,
-                                                  const std::vector<vpColVector> &point_cloud,
-                                                  vpColVector &desired_features, const unsigned int stepX,
-                                                  const unsigned int stepY
+template <class PointCloud>
+bool vpMbtFaceDepthNormal::computeDesiredFeaturesImpl(const vpHomogeneousMatrix &cMo, const unsigned int width,
+                                                      const unsigned int height, const PointCloud &point_cloud,
+                                                      vpColVector &desired_features, const unsigned int stepX,
+                                                      const unsigned int stepY
 #if DEBUG_DISPLAY_DEPTH_NORMAL
-                                                  ,
-                                                  vpImage<unsigned char> &debugImage,
-                                                  std::vector<std::vector<vpImagePoint> > &roiPts_vec
+                                                      ,
+                                                      vpImage<unsigned char> &debugImage,
+                                                      std::vector<std::vector<vpImagePoint> > &roiPts_vec
 #endif
-                                                  , const vpImage<bool> *mask
+                                                      , const vpImage<bool> *mask
 )
 {
   m_faceActivated = false;
@@ -465,6 +465,73 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
   return true;
 }
 
+bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, const unsigned int width,
+                                                  const unsigned int height,
+                                                  const std::vector<vpColVector> &point_cloud,
+                                                  vpColVector &desired_features, const unsigned int stepX,
+                                                  const unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                                  ,
+                                                  vpImage<unsigned char> &debugImage,
+                                                  std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                                  , const vpImage<bool> *mask
+)
+{
+  return computeDesiredFeaturesImpl(cMo, width, height, point_cloud, desired_features, stepX, stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                    ,
+                                    debugImage, roiPts_vec
+#endif
+                                    , mask);
+}
+
+/*!
+  Estimate the desired features (plane equation) from the 3D points that
+  belong to the face.
+
+  \param cMo : Current pose.
+  \param width : Width of the point cloud.
+  \param height : Height of the point cloud.
+  \param point_cloud : Organized point cloud stored in a (width*height)x3
+  matrix, each row containing the X, Y, Z coordinates of a point. Contrary to
+  the std::vector<vpColVector> representation, the points are stored in one
+  contiguous memory block.
+  \param desired_features : Estimated desired features.
+  \param stepX : Sampling step along the X-axis.
+  \param stepY : Sampling step along the Y-axis.
+  \param mask : Mask image, only pixels with a true value are considered.
+
+  \return True if the face is considered by the tracker.
+
+  \throw vpException::dimensionError if the matrix is not (width*height)x3.
+*/
+bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, const unsigned int width,
+                                                  const unsigned int height, const vpMatrix &point_cloud,
+                                                  vpColVector &desired_features, const unsigned int stepX,
+                                                  const unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                                  ,
+                                                  vpImage<unsigned char> &debugImage,
+                                                  std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                                  , const vpImage<bool> *mask
+)
+{
+  if (point_cloud.getCols() != 3 || point_cloud.getRows() != width * height) {
+    throw vpException(vpException::dimensionError,
+                      "Point cloud matrix is %dx%d, expected %dx3 for a %dx%d organized point cloud",
+                      point_cloud.getRows(), point_cloud.getCols(), width * height, width, height);
+  }
+
+  return computeDesiredFeaturesImpl(cMo, width, height, point_cloud, desired_features, stepX, stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                    ,
+                                    debugImage, roiPts_vec
+#endif
+                                    , mask);
+}
+
 #ifdef VISP_HAVE_PCL
 bool vpMbtFaceDepthNormal::computeDesiredFeaturesPCL(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud_face,
                                                      vpColVector &desired_features, vpColVector &desired_normal,
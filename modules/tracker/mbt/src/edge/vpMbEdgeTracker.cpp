@@ -688,7 +688,7 @@ void vpMbEdgeTracker::computeVVSFirstPhasePoseEstimation(const unsigned int iter
     cVo.buildFrom(cMo);
 
     vpMatrix K; // kernel
-    unsigned int rank = (m_L_edge * cVo).kernel(K);
+    unsigned int rank = (m_L_edge * cVo).AtA().kernelNormalEquations6(K);
     if (rank == 0) {
       throw vpException(vpException::fatalError, "Rank=0, cannot estimate the pose !");
     }
@@ -708,15 +708,16 @@ void vpMbEdgeTracker::computeVVSFirstPhasePoseEstimation(const unsigned int iter
   if (isoJoIdentity_) {
     LTL = m_L_edge.AtA();
     computeJTR(m_L_edge, m_weightedError_edge, LTR);
-    v = -0.7 * LTL.pseudoInverse(LTL.getRows() * std::numeric_limits<double>::epsilon()) * LTR;
+    LTL.solveNormalEquations6(LTR, v, LTL.getRows() * std::numeric_limits<double>::epsilon());
+    v *= -0.7;
   } else {
     cVo.buildFrom(cMo);
     vpMatrix LVJ = (m_L_edge * cVo * oJo);
     vpMatrix LVJTLVJ = (LVJ).AtA();
     vpColVector LVJTR;
     computeJTR(LVJ, m_weightedError_edge, LVJTR);
-    v = -0.7 * LVJTLVJ.pseudoInverse(LVJTLVJ.getRows() * std::numeric_limits<double>::epsilon()) * LVJTR;
-    v = cVo * v;
+    LVJTLVJ.solveNormalEquations6(LVJTR, v, LVJTLVJ.getRows() * std::numeric_limits<double>::epsilon());
+    v = cVo * (-0.7 * v);
   }
 
   cMo = vpExponentialMap::direct(v).inverse() * cMo;
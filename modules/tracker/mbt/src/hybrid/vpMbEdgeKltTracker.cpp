@@ -45,7 +45,7 @@
 #include <visp3/mbt/vpMbEdgeKltTracker.h>
 #include <visp3/mbt/vpMbtXmlGenericParser.h>
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
 
 vpMbEdgeKltTracker::vpMbEdgeKltTracker()
   : thresholdKLT(2.), thresholdMBT(2.), m_maxIterKlt(30), w_mbt(), w_klt(), m_error_hybrid(), m_w_hybrid()
@@ -1385,7 +1385,7 @@ void vpMbEdgeKltTracker::reInitModel(const vpImage<unsigned char> &I, const std:
                                      const vpHomogeneousMatrix &T)
 {
   // Reinit klt
-  #if (VISP_HAVE_OPENCV_VERSION < 0x020408)
+  #if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION < 0x020408))
     if (cur != NULL) {
       cvReleaseImage(&cur);
       cur = NULL;
@@ -1480,4 +1480,4 @@ void vpMbEdgeKltTracker::reInitModel(const vpImage<unsigned char> &I, const std:
 // Work arround to avoid warning: libvisp_mbt.a(vpMbEdgeKltTracker.cpp.o) has
 // no symbols
 void dummy_vpMbEdgeKltTracker(){};
-#endif // VISP_HAVE_OPENCV
+#endif // VISP_HAVE_MODULE_KLT
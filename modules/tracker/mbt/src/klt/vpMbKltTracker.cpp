@@ -43,7 +43,7 @@
 #include <visp3/mbt/vpMbKltTracker.h>
 #include <visp3/mbt/vpMbtXmlGenericParser.h>
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
 
 #if defined(__APPLE__) && defined(__MACH__) // Apple OSX and iOS (Darwin)
 #include <TargetConditionals.h>             // To detect OSX or IOS using TARGET_OS_IPHONE or TARGET_OS_IOS macro
@@ -51,16 +51,18 @@
 
 vpMbKltTracker::vpMbKltTracker()
   :
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408))
     cur(),
-#else
+#elif (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
     cur(NULL),
 #endif
     c0Mo(), firstInitialisation(true), maskBorder(5), threshold_outlier(0.5), percentGood(0.6), ctTc0(), tracker(),
     kltPolygons(), kltCylinders(), circles_disp(), m_nbInfos(0), m_nbFaceUsed(0), m_L_klt(), m_error_klt(), m_w_klt(),
     m_weightedError_klt(), m_robust_klt(), m_featuresToBeDisplayedKlt()
 {
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   tracker.setTrackerId(1);
+#endif
   tracker.setUseHarris(1);
   tracker.setMaxFeatures(10000);
   tracker.setWindowSize(5);
@@ -84,7 +86,7 @@ vpMbKltTracker::vpMbKltTracker()
 */
 vpMbKltTracker::~vpMbKltTracker()
 {
-#if (VISP_HAVE_OPENCV_VERSION < 0x020408)
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION < 0x020408))
   if (cur != NULL) {
     cvReleaseImage(&cur);
     cur = NULL;
@@ -158,7 +160,9 @@ void vpMbKltTracker::reinit(const vpImage<unsigned char> &I)
   c0Mo = cMo;
   ctTc0.eye();
 
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   vpImageConvert::convert(I, cur);
+#endif
 
   cam.computeFov(I.getWidth(), I.getHeight());
 
@@ -168,17 +172,23 @@ void vpMbKltTracker::reinit(const vpImage<unsigned char> &I)
   }
 
 // mask
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408))
   cv::Mat mask((int)I.getRows(), (int)I.getCols(), CV_8UC1, cv::Scalar(0));
-#else
+#elif (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   IplImage *mask = cvCreateImage(cvSize((int)I.getWidth(), (int)I.getHeight()), IPL_DEPTH_8U, 1);
   cvZero(mask);
+#else
+  vpImage<unsigned char> mask(I.getHeight(), I.getWidth(), 0);
 #endif
 
   vpMbtDistanceKltPoints *kltpoly;
   vpMbtDistanceKltCylinder *kltPolyCylinder;
   if (useScanLine) {
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
     vpImageConvert::convert(faces.getMbScanLineRenderer().getMask(), mask);
+#else
+    mask = faces.getMbScanLineRenderer().getMask();
+#endif
   } else {
     unsigned char val = 255 /* - i*15*/;
     for (std::list<vpMbtDistanceKltPoints *>::const_iterator it = kltPolygons.begin(); it != kltPolygons.end(); ++it) {
@@ -209,7 +219,11 @@ void vpMbKltTracker::reinit(const vpImage<unsigned char> &I)
     }
   }
 
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   tracker.initTracking(cur, mask);
+#else
+  tracker.initTracking(I, &mask);
+#endif
   //  tracker.track(cur); // AY: Not sure to be usefull but makes sure that
   //  the points are valid for tracking and avoid too fast reinitialisations.
   //  vpCTRACE << "init klt. detected " << tracker.getNbFeatures() << "
@@ -230,7 +244,7 @@ void vpMbKltTracker::reinit(const vpImage<unsigned char> &I)
       kltPolyCylinder->init(tracker, cMo);
   }
 
-#if (VISP_HAVE_OPENCV_VERSION < 0x020408)
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION < 0x020408))
   cvReleaseImage(&mask);
 #endif
 }
@@ -243,7 +257,7 @@ void vpMbKltTracker::resetTracker()
 {
   cMo.eye();
 
-#if (VISP_HAVE_OPENCV_VERSION < 0x020408)
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION < 0x020408))
   if (cur != NULL) {
     cvReleaseImage(&cur);
     cur = NULL;
@@ -285,7 +299,9 @@ void vpMbKltTracker::resetTracker()
   firstInitialisation = true;
   computeCovariance = false;
 
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   tracker.setTrackerId(1);
+#endif
   tracker.setUseHarris(1);
 
   tracker.setMaxFeatures(10000);
@@ -370,7 +386,11 @@ std::map<int, vpImagePoint> vpMbKltTracker::getKltImagePointsWithId() const
 
   \param t : Klt tracker containing the new values.
 */
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
 void vpMbKltTracker::setKltOpencv(const vpKltOpencv &t)
+#else
+void vpMbKltTracker::setKltTracker(const vpKltTracker &t)
+#endif
 {
   tracker.setMaxFeatures(t.getMaxFeatures());
   tracker.setWindowSize(t.getWindowSize());
@@ -427,11 +447,11 @@ void vpMbKltTracker::setPose(const vpImage<unsigned char> * const I, const vpIma
   } else {
     vpMbtDistanceKltPoints *kltpoly;
 
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408))
     std::vector<cv::Point2f> init_pts;
     std::vector<long> init_ids;
     std::vector<cv::Point2f> guess_pts;
-#else
+#elif (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
     unsigned int nbp = 0;
     for (std::list<vpMbtDistanceKltPoints *>::const_iterator it = kltPolygons.begin(); it != kltPolygons.end(); ++it) {
       kltpoly = *it;
@@ -446,6 +466,10 @@ void vpMbKltTracker::setPose(const vpImage<unsigned char> * const I, const vpIma
 
     CvPoint2D32f *guess_pts = NULL;
     guess_pts = (CvPoint2D32f *)cvAlloc(tracker.getMaxFeatures() * sizeof(guess_pts[0]));
+#else
+    std::vector<vpImagePoint> init_pts;
+    std::vector<long> init_ids;
+    std::vector<vpImagePoint> guess_pts;
 #endif
 
     vpHomogeneousMatrix cdMc = cdMo * cMo.inverse();
@@ -486,7 +510,7 @@ void vpMbKltTracker::setPose(const vpImage<unsigned char> * const I, const vpIma
         std::map<int, vpImagePoint>::const_iterator iter = kltpoly->getCurrentPoints().begin();
         // nbCur+= (unsigned int)kltpoly->getCurrentPoints().size();
         for (; iter != kltpoly->getCurrentPoints().end(); ++iter) {
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if !(defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION < 0x020408))
 #if TARGET_OS_IPHONE
           if (std::find(init_ids.begin(), init_ids.end(), (long)(kltpoly->getCurrentPointsInd())[(int)iter->first]) !=
               init_ids.end())
@@ -506,18 +530,22 @@ void vpMbKltTracker::setPose(const vpImage<unsigned char> * const I, const vpIma
           cdp[1] = iter->second.get_i();
           cdp[2] = 1.0;
 
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION < 0x020408))
+          init_pts[iter_pts].x = (float)cdp[0];
+          init_pts[iter_pts].y = (float)cdp[1];
+          init_ids[iter_pts] = (kltpoly->getCurrentPointsInd())[(size_t)iter->first];
+#else
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408))
           cv::Point2f p((float)cdp[0], (float)cdp[1]);
+#else
+          vpImagePoint p(cdp[1], cdp[0]);
+#endif
           init_pts.push_back(p);
 #if TARGET_OS_IPHONE
           init_ids.push_back((size_t)(kltpoly->getCurrentPointsInd())[(int)iter->first]);
 #else
           init_ids.push_back((size_t)(kltpoly->getCurrentPointsInd())[(size_t)iter->first]);
 #endif
-#else
-          init_pts[iter_pts].x = (float)cdp[0];
-          init_pts[iter_pts].y = (float)cdp[1];
-          init_ids[iter_pts] = (kltpoly->getCurrentPointsInd())[(size_t)iter->first];
 #endif
 
           double p_mu_t_2 = cdp[0] * cdGc[2][0] + cdp[1] * cdGc[2][1] + cdGc[2][2];
@@ -532,24 +560,28 @@ void vpMbKltTracker::setPose(const vpImage<unsigned char> * const I, const vpIma
           cdp[1] = (cdp[0] * cdGc[1][0] + cdp[1] * cdGc[1][1] + cdGc[1][2]) / p_mu_t_2;
 
 // Set value to the KLT tracker
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408))
           cv::Point2f p_guess((float)cdp[0], (float)cdp[1]);
           guess_pts.push_back(p_guess);
-#else
+#elif (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
           guess_pts[iter_pts].x = (float)cdp[0];
           guess_pts[iter_pts++].y = (float)cdp[1];
+#else
+          guess_pts.push_back(vpImagePoint(cdp[1], cdp[0]));
 #endif
         }
       }
     }
 
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
     if (I) {
       vpImageConvert::convert(*I, cur);
     } else {
       vpImageConvert::convert(m_I, cur);
     }
+#endif
 
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if !(defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION < 0x020408))
     tracker.setInitialGuess(init_pts, guess_pts, init_ids);
 #else
     tracker.setInitialGuess(&init_pts, &guess_pts, init_ids, iter_pts);
@@ -678,8 +710,12 @@ void vpMbKltTracker::initFaceFromLines(vpMbtPolygon &polygon)
 */
 void vpMbKltTracker::preTracking(const vpImage<unsigned char> &I)
 {
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   vpImageConvert::convert(I, cur);
   tracker.track(cur);
+#else
+  tracker.track(I);
+#endif
 
   m_nbInfos = 0;
   m_nbFaceUsed = 0;
@@ -1400,7 +1436,7 @@ void vpMbKltTracker::reInitModel(const vpImage<unsigned char> &I, const std::str
 {
   this->cMo.eye();
 
-#if (VISP_HAVE_OPENCV_VERSION < 0x020408)
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION < 0x020408))
   if (cur != NULL) {
     cvReleaseImage(&cur);
     cur = NULL;
@@ -1465,4 +1501,4 @@ void vpMbKltTracker::setUseKltTracking(const std::string &name, const bool &useK
 // Work arround to avoid warning: libvisp_mbt.a(vpMbKltTracker.cpp.o) has no
 // symbols
 void dummy_vpMbKltTracker(){};
-#endif // VISP_HAVE_OPENCV
+#endif // VISP_HAVE_MODULE_KLT
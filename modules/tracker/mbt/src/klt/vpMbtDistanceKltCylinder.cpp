@@ -40,7 +40,7 @@
 #include <visp3/mbt/vpMbtDistanceKltCylinder.h>
 #include <visp3/mbt/vpMbtDistanceKltPoints.h>
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
 
 #if defined(VISP_HAVE_CLIPPER)
 #include <clipper.hpp> // clipper private library
@@ -95,6 +95,7 @@ void vpMbtDistanceKltCylinder::buildFrom(const vpPoint &p1, const vpPoint &p2, c
                                (p1.get_oY() + p2.get_oY()) / 2.0, (p1.get_oZ() + p2.get_oZ()) / 2.0, r);
 }
 
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
 /*!
   Initialise the cylinder to track. All the points in the map, representing
   all the map detected in the image, are parsed in order to extract the id of
@@ -104,6 +105,26 @@ void vpMbtDistanceKltCylinder::buildFrom(const vpPoint &p1, const vpPoint &p2, c
   \param cMo : Pose of the object in the camera frame at initialization.
 */
 void vpMbtDistanceKltCylinder::init(const vpKltOpencv &_tracker, const vpHomogeneousMatrix &cMo)
+{
+  initImpl(_tracker, cMo);
+}
+#endif
+
+/*!
+  Initialise the cylinder to track. All the points in the map, representing
+  all the map detected in the image, are parsed in order to extract the id of
+  the points that are indeed in the face.
+
+  \param _tracker : ViSP KLT Tracker.
+  \param cMo : Pose of the object in the camera frame at initialization.
+*/
+void vpMbtDistanceKltCylinder::init(const vpKltTracker &_tracker, const vpHomogeneousMatrix &cMo)
+{
+  initImpl(_tracker, cMo);
+}
+
+template <class KltTracker>
+void vpMbtDistanceKltCylinder::initImpl(const KltTracker &_tracker, const vpHomogeneousMatrix &cMo)
 {
   c0Mo = cMo;
   cylinder.changeFrame(cMo);
@@ -185,6 +206,7 @@ void vpMbtDistanceKltCylinder::init(const vpKltOpencv &_tracker, const vpHomogen
   // std::endl;
 }
 
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
 /*!
   compute the number of point in this instanciation of the tracker that
   corresponds to the points of the cylinder
@@ -194,6 +216,26 @@ void vpMbtDistanceKltCylinder::init(const vpKltOpencv &_tracker, const vpHomogen
   instanciation of the tracker
 */
 unsigned int vpMbtDistanceKltCylinder::computeNbDetectedCurrent(const vpKltOpencv &_tracker)
+{
+  return computeNbDetectedCurrentImpl(_tracker);
+}
+#endif
+
+/*!
+  compute the number of point in this instanciation of the tracker that
+  corresponds to the points of the cylinder
+
+  \param _tracker : the KLT tracker
+  \return the number of points that are tracked in this face and in this
+  instanciation of the tracker
+*/
+unsigned int vpMbtDistanceKltCylinder::computeNbDetectedCurrent(const vpKltTracker &_tracker)
+{
+  return computeNbDetectedCurrentImpl(_tracker);
+}
+
+template <class KltTracker>
+unsigned int vpMbtDistanceKltCylinder::computeNbDetectedCurrentImpl(const KltTracker &_tracker)
 {
   long id;
   float x, y;
@@ -364,6 +406,7 @@ bool vpMbtDistanceKltCylinder::isTrackedFeature(const int _id)
   return false;
 }
 
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
 /*!
   Modification of all the pixels that are in the roi to the value of _nb (
   default is 255).
@@ -382,13 +425,31 @@ void vpMbtDistanceKltCylinder::updateMask(
     unsigned char nb, unsigned int shiftBorder)
 {
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
-  int width = mask.cols;
-  int height = mask.rows;
+  updateMaskImpl(mask.data, mask.cols, mask.rows, static_cast<int>(mask.step), nb, shiftBorder);
 #else
-  int width = mask->width;
-  int height = mask->height;
+  updateMaskImpl((unsigned char *)mask->imageData, mask->width, mask->height, mask->widthStep, nb, shiftBorder);
+#endif
+}
 #endif
 
+/*!
+  Modification of all the pixels that are in the roi to the value of _nb (
+  default is 255).
+
+  \param mask : the mask to update (0, not in the object, _nb otherwise).
+  \param nb : Optionnal value to set to the pixels included in the face.
+  \param shiftBorder : Optionnal shift for the border in pixel (sort of
+  built-in erosion) to avoid to consider pixels near the limits of the face.
+*/
+void vpMbtDistanceKltCylinder::updateMask(vpImage<unsigned char> &mask, unsigned char nb, unsigned int shiftBorder)
+{
+  updateMaskImpl(mask.bitmap, static_cast<int>(mask.getWidth()), static_cast<int>(mask.getHeight()),
+                 static_cast<int>(mask.getWidth()), nb, shiftBorder);
+}
+
+void vpMbtDistanceKltCylinder::updateMaskImpl(unsigned char *data, int width, int height, int stride,
+                                              unsigned char nb, unsigned int shiftBorder)
+{
   for (unsigned int kc = 0; kc < listIndicesCylinderBBox.size(); kc++) {
     if ((*hiddenface)[(unsigned int)listIndicesCylinderBBox[kc]]->isVisible() &&
         (*hiddenface)[(unsigned int)listIndicesCylinderBBox[kc]]->getNbPoint() > 2) {
@@ -464,9 +525,9 @@ void vpMbtDistanceKltCylinder::updateMask(
         j_max = width;
       }
 
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
       for (int i = i_min; i < i_max; i++) {
         double i_d = (double)i;
+        unsigned char *row = data + i * stride;
 
         for (int j = j_min; j < j_max; j++) {
           double j_d = (double)j;
@@ -474,7 +535,7 @@ void vpMbtDistanceKltCylinder::updateMask(
 #if defined(VISP_HAVE_CLIPPER)
           imPt.set_ij(i_d, j_d);
           if (polygon_test.isInside(imPt)) {
-            mask.ptr<uchar>(i)[j] = nb;
+            row[j] = nb;
           }
 #else
           if (shiftBorder != 0) {
@@ -483,43 +544,16 @@ void vpMbtDistanceKltCylinder::updateMask(
                 vpPolygon::isInside(roi, i_d - shiftBorder_d, j_d + shiftBorder_d) &&
                 vpPolygon::isInside(roi, i_d + shiftBorder_d, j_d - shiftBorder_d) &&
                 vpPolygon::isInside(roi, i_d - shiftBorder_d, j_d - shiftBorder_d)) {
-              mask.at<unsigned char>(i, j) = nb;
+              row[j] = nb;
             }
           } else {
             if (vpPolygon::isInside(roi, i, j)) {
-              mask.at<unsigned char>(i, j) = nb;
+              row[j] = nb;
             }
           }
 #endif
         }
       }
-#else
-      unsigned char *ptrData = (unsigned char *)mask->imageData + i_min * mask->widthStep + j_min;
-      for (int i = i_min; i < i_max; i++) {
-        double i_d = (double)i;
-        for (int j = j_min; j < j_max; j++) {
-          double j_d = (double)j;
-          if (shiftBorder != 0) {
-            if (vpPolygon::isInside(roi, i_d, j_d) &&
-                vpPolygon::isInside(roi, i_d + shiftBorder_d, j_d + shiftBorder_d) &&
-                vpPolygon::isInside(roi, i_d - shiftBorder_d, j_d + shiftBorder_d) &&
-                vpPolygon::isInside(roi, i_d + shiftBorder_d, j_d - shiftBorder_d) &&
-                vpPolygon::isInside(roi, i_d - shiftBorder_d, j_d - shiftBorder_d)) {
-              *(ptrData++) = nb;
-            } else {
-              ptrData++;
-            }
-          } else {
-            if (vpPolygon::isInside(roi, i, j)) {
-              *(ptrData++) = nb;
-            } else {
-              ptrData++;
-            }
-          }
-        }
-        ptrData += mask->widthStep - j_max + j_min;
-      }
-#endif
     }
   }
 }
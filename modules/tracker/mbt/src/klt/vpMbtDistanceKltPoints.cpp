@@ -41,7 +41,7 @@
 #include <visp3/mbt/vpMbtDistanceKltPoints.h>
 #include <visp3/me/vpMeTracker.h>
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
 
 #if defined(VISP_HAVE_CLIPPER)
 #include <clipper.hpp> // clipper private library
@@ -69,6 +69,7 @@ vpMbtDistanceKltPoints::vpMbtDistanceKltPoints()
 */
 vpMbtDistanceKltPoints::~vpMbtDistanceKltPoints() {}
 
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
 /*!
   Initialise the face to track. All the points in the map, representing all
   the map detected in the image, are parsed in order to extract the id of the
@@ -78,6 +79,25 @@ vpMbtDistanceKltPoints::~vpMbtDistanceKltPoints() {}
   \param mask: Mask image or NULL if not wanted. Mask values that are set to true are considered in the tracking. To disable a pixel, set false.
 */
 void vpMbtDistanceKltPoints::init(const vpKltOpencv &_tracker, const vpImage<bool> *mask)
+{
+  initImpl(_tracker, mask);
+}
+#endif
+
+/*!
+  Initialise the face to track. All the points in the map, representing all
+  the map detected in the image, are parsed in order to extract the id of the
+  points that are indeed in the face.
+
+  \param _tracker : ViSP KLT Tracker.
+  \param mask: Mask image or NULL if not wanted. Mask values that are set to true are considered in the tracking. To disable a pixel, set false.
+*/
+void vpMbtDistanceKltPoints::init(const vpKltTracker &_tracker, const vpImage<bool> *mask)
+{
+  initImpl(_tracker, mask);
+}
+
+template <class KltTracker> void vpMbtDistanceKltPoints::initImpl(const KltTracker &_tracker, const vpImage<bool> *mask)
 {
   // extract ids of the points in the face
   nbPointsInit = 0;
@@ -141,6 +161,7 @@ void vpMbtDistanceKltPoints::init(const vpKltOpencv &_tracker, const vpImage<boo
   invd0 = 1.0 / d0;
 }
 
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
 /*!
   compute the number of point in this instanciation of the tracker that
   corresponds to the points of the face
@@ -151,6 +172,28 @@ void vpMbtDistanceKltPoints::init(const vpKltOpencv &_tracker, const vpImage<boo
   \param mask: Mask image or NULL if not wanted. Mask values that are set to true are considered in the tracking. To disable a pixel, set false.
 */
 unsigned int vpMbtDistanceKltPoints::computeNbDetectedCurrent(const vpKltOpencv &_tracker, const vpImage<bool> *mask)
+{
+  return computeNbDetectedCurrentImpl(_tracker, mask);
+}
+#endif
+
+/*!
+  compute the number of point in this instanciation of the tracker that
+  corresponds to the points of the face
+
+  \param _tracker : the KLT tracker
+  \return the number of points that are tracked in this face and in this
+  instanciation of the tracker
+  \param mask: Mask image or NULL if not wanted. Mask values that are set to true are considered in the tracking. To disable a pixel, set false.
+*/
+unsigned int vpMbtDistanceKltPoints::computeNbDetectedCurrent(const vpKltTracker &_tracker, const vpImage<bool> *mask)
+{
+  return computeNbDetectedCurrentImpl(_tracker, mask);
+}
+
+template <class KltTracker>
+unsigned int vpMbtDistanceKltPoints::computeNbDetectedCurrentImpl(const KltTracker &_tracker,
+                                                                  const vpImage<bool> *mask)
 {
   long id;
   float x, y;
@@ -342,6 +385,7 @@ bool vpMbtDistanceKltPoints::isTrackedFeature(const int _id)
   return false;
 }
 
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
 /*!
   Modification of all the pixels that are in the roi to the value of _nb (
   default is 255).
@@ -360,13 +404,31 @@ void vpMbtDistanceKltPoints::updateMask(
     unsigned char nb, unsigned int shiftBorder)
 {
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
-  int width = mask.cols;
-  int height = mask.rows;
+  updateMaskImpl(mask.data, mask.cols, mask.rows, static_cast<int>(mask.step), nb, shiftBorder);
 #else
-  int width = mask->width;
-  int height = mask->height;
+  updateMaskImpl((unsigned char *)mask->imageData, mask->width, mask->height, mask->widthStep, nb, shiftBorder);
+#endif
+}
 #endif
 
+/*!
+  Modification of all the pixels that are in the roi to the value of _nb (
+  default is 255).
+
+  \param mask : the mask to update (0, not in the object, _nb otherwise).
+  \param nb : Optionnal value to set to the pixels included in the face.
+  \param shiftBorder : Optionnal shift for the border in pixel (sort of
+  built-in erosion) to avoid to consider pixels near the limits of the face.
+*/
+void vpMbtDistanceKltPoints::updateMask(vpImage<unsigned char> &mask, unsigned char nb, unsigned int shiftBorder)
+{
+  updateMaskImpl(mask.bitmap, static_cast<int>(mask.getWidth()), static_cast<int>(mask.getHeight()),
+                 static_cast<int>(mask.getWidth()), nb, shiftBorder);
+}
+
+void vpMbtDistanceKltPoints::updateMaskImpl(unsigned char *data, int width, int height, int stride, unsigned char nb,
+                                            unsigned int shiftBorder)
+{
   int i_min, i_max, j_min, j_max;
   std::vector<vpImagePoint> roi;
   polygon->getRoiClipped(cam, roi);
@@ -440,9 +502,9 @@ void vpMbtDistanceKltPoints::updateMask(
     j_max = width;
   }
 
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
   for (int i = i_min; i < i_max; i++) {
     double i_d = (double)i;
+    unsigned char *row = data + i * stride;
 
     for (int j = j_min; j < j_max; j++) {
       double j_d = (double)j;
@@ -450,7 +512,7 @@ void vpMbtDistanceKltPoints::updateMask(
 #if defined(VISP_HAVE_CLIPPER)
       imPt.set_ij(i_d, j_d);
       if (polygon_test.isInside(imPt)) {
-        mask.ptr<uchar>(i)[j] = nb;
+        row[j] = nb;
       }
 #else
       if (shiftBorder != 0) {
@@ -458,42 +520,16 @@ void vpMbtDistanceKltPoints::updateMask(
             vpPolygon::isInside(roi, i_d - shiftBorder_d, j_d + shiftBorder_d) &&
             vpPolygon::isInside(roi, i_d + shiftBorder_d, j_d - shiftBorder_d) &&
             vpPolygon::isInside(roi, i_d - shiftBorder_d, j_d - shiftBorder_d)) {
-          mask.at<unsigned char>(i, j) = nb;
+          row[j] = nb;
         }
       } else {
         if (vpPolygon::isInside(roi, i, j)) {
-          mask.at<unsigned char>(i, j) = nb;
+          row[j] = nb;
         }
       }
 #endif
     }
   }
-#else
-  unsigned char *ptrData = (unsigned char *)mask->imageData + i_min * mask->widthStep + j_min;
-  for (int i = i_min; i < i_max; i++) {
-    double i_d = (double)i;
-    for (int j = j_min; j < j_max; j++) {
-      double j_d = (double)j;
-      if (shiftBorder != 0) {
-        if (vpPolygon::isInside(roi, i_d, j_d) && vpPolygon::isInside(roi, i_d + shiftBorder_d, j_d + shiftBorder_d) &&
-            vpPolygon::isInside(roi, i_d - shiftBorder_d, j_d + shiftBorder_d) &&
-            vpPolygon::isInside(roi, i_d + shiftBorder_d, j_d - shiftBorder_d) &&
-            vpPolygon::isInside(roi, i_d - shiftBorder_d, j_d - shiftBorder_d)) {
-          *(ptrData++) = nb;
-        } else {
-          ptrData++;
-        }
-      } else {
-        if (vpPolygon::isInside(roi, i, j)) {
-          *(ptrData++) = nb;
-        } else {
-          ptrData++;
-        }
-      }
-    }
-    ptrData += mask->widthStep - j_max + j_min;
-  }
-#endif
 }
 
 /*!
@@ -37,12 +37,64 @@
 
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpExponentialMap.h>
+#include <visp3/core/vpThreadPool.h>
 #include <visp3/core/vpTrackingException.h>
 #include <visp3/mbt/vpMbtXmlGenericParser.h>
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// C = A * B with A, B and C 6x6 matrices, C must differ from A and B
+void mult6x6(const vpArray2D<double> &A, const vpArray2D<double> &B, vpArray2D<double> &C)
+{
+  for (unsigned int i = 0; i < 6; i++) {
+    for (unsigned int j = 0; j < 6; j++) {
+      double sum = 0;
+      for (unsigned int k = 0; k < 6; k++) {
+        sum += A[i][k] * B[k][j];
+      }
+      C[i][j] = sum;
+    }
+  }
+}
+
+// Rows [start, start + A.getRows()[ of C = A * B with A a n x 6 matrix and B
+// a 6x6 matrix, C must differ from A
+void multRows6(const vpMatrix &A, const vpArray2D<double> &B, vpMatrix &C, const unsigned int start)
+{
+  for (unsigned int i = 0; i < A.getRows(); i++) {
+    const double *a = A[i];
+    double *c = C[start + i];
+    for (unsigned int j = 0; j < 6; j++) {
+      double sum = 0;
+      for (unsigned int k = 0; k < 6; k++) {
+        sum += a[k] * B[k][j];
+      }
+      c[j] = sum;
+    }
+  }
+}
+
+// C = A^T * B with A, B and C 6x6 matrices, C must differ from A and B
+void multTranspose6x6(const vpArray2D<double> &A, const vpArray2D<double> &B, vpArray2D<double> &C)
+{
+  for (unsigned int i = 0; i < 6; i++) {
+    for (unsigned int j = 0; j < 6; j++) {
+      double sum = 0;
+      for (unsigned int k = 0; k < 6; k++) {
+        sum += A[k][i] * B[k][j];
+      }
+      C[i][j] = sum;
+    }
+  }
+}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 vpMbGenericTracker::vpMbGenericTracker()
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
-    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError()
+    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
+    m_parallelCameraComputation(false), m_vvsWorkspace()
 {
   m_mapOfTrackers["Camera"] = new TrackerWrapper(EDGE_TRACKER);
 
@@ -52,7 +104,7 @@ vpMbGenericTracker::vpMbGenericTracker()
   // Add default ponderation between each feature type
   m_mapOfFeatureFactors[EDGE_TRACKER] = 1.0;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   m_mapOfFeatureFactors[KLT_TRACKER] = 1.0;
 #endif
 
@@ -62,7 +114,8 @@ vpMbGenericTracker::vpMbGenericTracker()
 
 vpMbGenericTracker::vpMbGenericTracker(const unsigned int nbCameras, const int trackerType)
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
-    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError()
+    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
+    m_parallelCameraComputation(false), m_vvsWorkspace()
 {
   if (nbCameras == 0) {
     throw vpException(vpTrackingException::fatalError, "Cannot use no camera!");
@@ -88,7 +141,7 @@ vpMbGenericTracker::vpMbGenericTracker(const unsigned int nbCameras, const int t
   // Add default ponderation between each feature type
   m_mapOfFeatureFactors[EDGE_TRACKER] = 1.0;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   m_mapOfFeatureFactors[KLT_TRACKER] = 1.0;
 #endif
 
@@ -98,7 +151,8 @@ vpMbGenericTracker::vpMbGenericTracker(const unsigned int nbCameras, const int t
 
 vpMbGenericTracker::vpMbGenericTracker(const std::vector<int> &trackerTypes)
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
-    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError()
+    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
+    m_parallelCameraComputation(false), m_vvsWorkspace()
 {
   if (trackerTypes.empty()) {
     throw vpException(vpException::badValue, "There is no camera!");
@@ -126,7 +180,7 @@ vpMbGenericTracker::vpMbGenericTracker(const std::vector<int> &trackerTypes)
   // Add default ponderation between each feature type
   m_mapOfFeatureFactors[EDGE_TRACKER] = 1.0;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   m_mapOfFeatureFactors[KLT_TRACKER] = 1.0;
 #endif
 
@@ -137,7 +191,8 @@ vpMbGenericTracker::vpMbGenericTracker(const std::vector<int> &trackerTypes)
 vpMbGenericTracker::vpMbGenericTracker(const std::vector<std::string> &cameraNames,
                                        const std::vector<int> &trackerTypes)
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
-    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError()
+    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
+    m_parallelCameraComputation(false), m_vvsWorkspace()
 {
   if (cameraNames.size() != trackerTypes.size() || cameraNames.empty()) {
     throw vpException(vpTrackingException::badValue,
@@ -157,7 +212,7 @@ vpMbGenericTracker::vpMbGenericTracker(const std::vector<std::string> &cameraNam
   // Add default ponderation between each feature type
   m_mapOfFeatureFactors[EDGE_TRACKER] = 1.0;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   m_mapOfFeatureFactors[KLT_TRACKER] = 1.0;
 #endif
 
@@ -284,18 +339,14 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
   double normRes_1 = -1;
   unsigned int iter = 0;
 
-  vpMatrix LTL;
-  vpColVector LTR, v;
-  vpColVector error_prev;
+  vpColVector v(6);
 
   double mu = m_initialMu;
   vpHomogeneousMatrix cMo_prev;
 
   bool isoJoIdentity_ = true;
 
-  // Covariance
-  vpColVector W_true(m_error.getRows());
-  vpMatrix L_true, LVJ_true;
+  VVSWorkspace &ws = m_vvsWorkspace;
 
   // Create the map of VelocityTwistMatrices
   std::map<std::string, vpVelocityTwistMatrix> mapOfVelocityTwist;
@@ -306,18 +357,11 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
     mapOfVelocityTwist[it->first] = cVo;
   }
 
-  double factorEdge = m_mapOfFeatureFactors[EDGE_TRACKER];
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
-  double factorKlt = m_mapOfFeatureFactors[KLT_TRACKER];
-#endif
-  double factorDepth = m_mapOfFeatureFactors[DEPTH_NORMAL_TRACKER];
-  double factorDepthDense = m_mapOfFeatureFactors[DEPTH_DENSE_TRACKER];
-
   while (std::fabs(normRes_1 - normRes) > m_stopCriteriaEpsilon && (iter < m_maxIter)) {
     computeVVSInteractionMatrixAndResidu(mapOfImages, mapOfVelocityTwist);
 
     bool reStartFromLastIncrement = false;
-    computeVVSCheckLevenbergMarquardt(iter, m_error, error_prev, cMo_prev, mu, reStartFromLastIncrement);
+    computeVVSCheckLevenbergMarquardt(iter, m_error, ws.error_prev, cMo_prev, mu, reStartFromLastIncrement);
     if (reStartFromLastIncrement) {
       for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
            it != m_mapOfTrackers.end(); ++it) {
@@ -325,7 +369,7 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
 
         tracker->cMo = m_mapOfCameraTransformationMatrix[it->first] * cMo_prev;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
         vpHomogeneousMatrix c_curr_tTc_curr0 =
             m_mapOfCameraTransformationMatrix[it->first] * cMo_prev * tracker->c0Mo.inverse();
         tracker->ctTc0 = c_curr_tTc_curr0;
@@ -337,15 +381,14 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
       computeVVSWeights();
 
       if (computeCovariance) {
-        L_true = m_L;
+        ws.L_true = m_L;
         if (!isoJoIdentity_) {
-          vpVelocityTwistMatrix cVo;
-          cVo.buildFrom(cMo);
-          LVJ_true = (m_L * (cVo * oJo));
+          ws.cVo.buildFrom(cMo);
+          mult6x6(ws.cVo, oJo, ws.J);
+          vpMatrix::mult2Matrices(m_L, ws.J, ws.LVJ_true);
         }
       }
 
-      vpVelocityTwistMatrix cVo;
       if (iter == 0) {
         isoJoIdentity_ = true;
         oJo.eye();
@@ -355,18 +398,42 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
         // cannot be estimated This is particularly useful when consering
         // circles (rank 5) and cylinders (rank 4)
         if (isoJoIdentity_) {
-          cVo.buildFrom(cMo);
+          // The rank of L cVo is the one of cVo^T (L^T L) cVo
+          ws.cVo.buildFrom(cMo);
+          ws.LTLo = 0;
+          double *LTLo = ws.LTLo.data;
+          for (unsigned int i = 0; i < m_L.getRows(); i++) {
+            const double *L = m_L[i];
+            for (unsigned int a = 0; a < 6; a++) {
+              for (unsigned int b = a; b < 6; b++) {
+                LTLo[a * 6 + b] += L[a] * L[b];
+              }
+            }
+          }
+          for (unsigned int a = 1; a < 6; a++) {
+            for (unsigned int b = 0; b < a; b++) {
+              LTLo[a * 6 + b] = LTLo[b * 6 + a];
+            }
+          }
+          mult6x6(ws.LTLo, ws.cVo, ws.tmp);
+          multTranspose6x6(ws.cVo, ws.tmp, ws.LTLo);
 
-          vpMatrix K; // kernel
-          unsigned int rank = (m_L * cVo).kernel(K);
+          unsigned int rank = ws.LTLo.kernelNormalEquations6(ws.K);
           if (rank == 0) {
             throw vpException(vpException::fatalError, "Rank=0, cannot estimate the pose !");
           }
 
           if (rank != 6) {
-            vpMatrix I; // Identity
-            I.eye(6);
-            oJo = I - K.AtA();
+            // oJo = I - K^T K
+            for (unsigned int a = 0; a < 6; a++) {
+              for (unsigned int b = 0; b < 6; b++) {
+                double sum = (a == b) ? 1. : 0.;
+                for (unsigned int k = 0; k < ws.K.getRows(); k++) {
+                  sum -= ws.K[k][a] * ws.K[k][b];
+                }
+                oJo[a][b] = sum;
+              }
+            }
 
             isoJoIdentity_ = false;
           }
@@ -376,93 +443,20 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
       // Weighting
       double num = 0;
       double den = 0;
-
-      unsigned int start_index = 0;
-      for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-           it != m_mapOfTrackers.end(); ++it) {
-        TrackerWrapper *tracker = it->second;
-
-        if (tracker->m_trackerType & EDGE_TRACKER) {
-          for (unsigned int i = 0; i < tracker->m_error_edge.getRows(); i++) {
-            double wi = tracker->m_w_edge[i] * tracker->m_factor[i] * factorEdge;
-            W_true[start_index + i] = wi;
-            m_weightedError[start_index + i] = wi * m_error[start_index + i];
-
-            num += wi * vpMath::sqr(m_error[start_index + i]);
-            den += wi;
-
-            for (unsigned int j = 0; j < m_L.getCols(); j++) {
-              m_L[start_index + i][j] *= wi;
-            }
-          }
-
-          start_index += tracker->m_error_edge.getRows();
-        }
-
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
-        if (tracker->m_trackerType & KLT_TRACKER) {
-          for (unsigned int i = 0; i < tracker->m_error_klt.getRows(); i++) {
-            double wi = tracker->m_w_klt[i] * factorKlt;
-            W_true[start_index + i] = wi;
-            m_weightedError[start_index + i] = wi * m_error[start_index + i];
-
-            num += wi * vpMath::sqr(m_error[start_index + i]);
-            den += wi;
-
-            for (unsigned int j = 0; j < m_L.getCols(); j++) {
-              m_L[start_index + i][j] *= wi;
-            }
-          }
-
-          start_index += tracker->m_error_klt.getRows();
-        }
-#endif
-
-        if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
-          for (unsigned int i = 0; i < tracker->m_error_depthNormal.getRows(); i++) {
-            double wi = tracker->m_w_depthNormal[i] * factorDepth;
-            W_true[start_index + i] = wi;
-            m_weightedError[start_index + i] = wi * m_error[start_index + i];
-
-            num += wi * vpMath::sqr(m_error[start_index + i]);
-            den += wi;
-
-            for (unsigned int j = 0; j < m_L.getCols(); j++) {
-              m_L[start_index + i][j] *= wi;
-            }
-          }
-
-          start_index += tracker->m_error_depthNormal.getRows();
-        }
-
-        if (tracker->m_trackerType & DEPTH_DENSE_TRACKER) {
-          for (unsigned int i = 0; i < tracker->m_error_depthDense.getRows(); i++) {
-            double wi = tracker->m_w_depthDense[i] * factorDepthDense;
-            W_true[start_index + i] = wi;
-            m_weightedError[start_index + i] = wi * m_error[start_index + i];
-
-            num += wi * vpMath::sqr(m_error[start_index + i]);
-            den += wi;
-
-            for (unsigned int j = 0; j < m_L.getCols(); j++) {
-              m_L[start_index + i][j] *= wi;
-            }
-          }
-
-          start_index += tracker->m_error_depthDense.getRows();
-        }
-      }
+      computeVVSNormalEquations(num, den);
 
       normRes_1 = normRes;
       normRes = sqrt(num / den);
 
-      computeVVSPoseEstimation(isoJoIdentity_, iter, m_L, LTL, m_weightedError, m_error, error_prev, LTR, mu, v);
+      computeVVSPoseUpdate(isoJoIdentity_, iter, mu, v);
 
       cMo_prev = cMo;
 
-      cMo = vpExponentialMap::direct(v).inverse() * cMo;
+      ws.dM = vpExponentialMap::direct(v);
+      ws.dM.inverse(ws.dMinv);
+      vpHomogeneousMatrix::multiply(ws.dMinv, cMo_prev, cMo);
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
       for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
            it != m_mapOfTrackers.end(); ++it) {
         TrackerWrapper *tracker = it->second;
@@ -484,7 +478,7 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
     iter++;
   }
 
-  computeCovarianceMatrixVVS(isoJoIdentity_, W_true, cMo_prev, L_true, LVJ_true, m_error);
+  computeCovarianceMatrixVVS(isoJoIdentity_, ws.W_true, cMo_prev, ws.L_true, ws.LVJ_true, m_error);
 
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
        it != m_mapOfTrackers.end(); ++it) {
@@ -496,6 +490,58 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
   }
 }
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/*!
+  Per-camera stage of the virtual visual servoing, run on vpThreadPool with
+  one camera per index. Each camera only writes to its own tracker and to its
+  own block of rows of the stacked system. The images, indexed as the
+  trackers, are only needed by the INIT and INTERACTION_MATRIX stages.
+*/
+class vpMbGenericTracker::CameraVVSBody : public vpParallelForBody
+{
+public:
+  typedef enum { INIT, INTERACTION_MATRIX, WEIGHTS } vpStage;
+
+  CameraVVSBody(const vpStage stage, const std::vector<TrackerWrapper *> &trackers,
+                const std::vector<const vpImage<unsigned char> *> *images = NULL,
+                const std::vector<vpVelocityTwistMatrix> *velocityTwists = NULL,
+                const std::vector<unsigned int> *startIndexes = NULL, vpMatrix *L = NULL, vpColVector *error = NULL)
+    : m_stage(stage), m_trackers(trackers), m_images(images), m_velocityTwists(velocityTwists),
+      m_startIndexes(startIndexes), m_L(L), m_error(error)
+  {
+  }
+
+  void operator()(int begin, int end)
+  {
+    for (size_t i = static_cast<size_t>(begin); i < static_cast<size_t>(end); i++) {
+      TrackerWrapper *tracker = m_trackers[i];
+      switch (m_stage) {
+      case INIT:
+        tracker->computeVVSInit((*m_images)[i]);
+        break;
+      case INTERACTION_MATRIX:
+        tracker->computeVVSInteractionMatrixAndResidu((*m_images)[i]);
+        multRows6(tracker->m_L, (*m_velocityTwists)[i], *m_L, (*m_startIndexes)[i]);
+        m_error->insert((*m_startIndexes)[i], tracker->m_error);
+        break;
+      case WEIGHTS:
+        tracker->computeVVSWeights();
+        break;
+      }
+    }
+  }
+
+private:
+  vpStage m_stage;
+  const std::vector<TrackerWrapper *> &m_trackers;
+  const std::vector<const vpImage<unsigned char> *> *m_images;
+  const std::vector<vpVelocityTwistMatrix> *m_velocityTwists;
+  const std::vector<unsigned int> *m_startIndexes;
+  vpMatrix *m_L;
+  vpColVector *m_error;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 void vpMbGenericTracker::computeVVSInit()
 {
   throw vpException(vpException::fatalError, "vpMbGenericTracker::computeVVSInit() should not be called!");
@@ -505,12 +551,31 @@ void vpMbGenericTracker::computeVVSInit(std::map<std::string, const vpImage<unsi
 {
   unsigned int nbFeatures = 0;
 
-  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-       it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-    tracker->computeVVSInit(mapOfImages[it->first]);
+  if (m_parallelCameraComputation && m_mapOfTrackers.size() > 1) {
+    std::vector<TrackerWrapper *> &trackers = m_vvsWorkspace.trackers;
+    std::vector<const vpImage<unsigned char> *> &images = m_vvsWorkspace.images;
+    trackers.clear();
+    images.clear();
+    for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+         it != m_mapOfTrackers.end(); ++it) {
+      trackers.push_back(it->second);
+      images.push_back(mapOfImages[it->first]);
+    }
 
-    nbFeatures += tracker->m_error.getRows();
+    CameraVVSBody body(CameraVVSBody::INIT, trackers, &images);
+    vpThreadPool::instance().parallel_for(0, static_cast<int>(trackers.size()), body);
+
+    for (size_t i = 0; i < trackers.size(); i++) {
+      nbFeatures += trackers[i]->m_error.getRows();
+    }
+  } else {
+    for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+         it != m_mapOfTrackers.end(); ++it) {
+      TrackerWrapper *tracker = it->second;
+      tracker->computeVVSInit(mapOfImages[it->first]);
+
+      nbFeatures += tracker->m_error.getRows();
+    }
   }
 
   m_L.resize(nbFeatures, 6, false, false);
@@ -519,6 +584,8 @@ void vpMbGenericTracker::computeVVSInit(std::map<std::string, const vpImage<unsi
   m_weightedError.resize(nbFeatures, false);
   m_w.resize(nbFeatures, false);
   m_w = 1;
+
+  m_vvsWorkspace.resize(nbFeatures, computeCovariance);
 }
 
 void vpMbGenericTracker::computeVVSInteractionMatrixAndResidu()
@@ -532,38 +599,265 @@ void vpMbGenericTracker::computeVVSInteractionMatrixAndResidu(
     std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
     std::map<std::string, vpVelocityTwistMatrix> &mapOfVelocityTwist)
 {
-  unsigned int start_index = 0;
+  if (m_parallelCameraComputation && m_mapOfTrackers.size() > 1) {
+    // Each camera fills its own block of rows of m_L and m_error. Block
+    // offsets are known from computeVVSInit(), so the blocks can be computed
+    // concurrently and the stacked system is identical to the serial one.
+    // The vectors of the workspace keep their capacity between iterations.
+    std::vector<TrackerWrapper *> &trackers = m_vvsWorkspace.trackers;
+    std::vector<const vpImage<unsigned char> *> &images = m_vvsWorkspace.images;
+    std::vector<vpVelocityTwistMatrix> &velocityTwists = m_vvsWorkspace.velocityTwists;
+    std::vector<unsigned int> &startIndexes = m_vvsWorkspace.startIndexes;
+    trackers.clear();
+    images.clear();
+    velocityTwists.clear();
+    startIndexes.clear();
+
+    unsigned int start_index = 0;
+    for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+         it != m_mapOfTrackers.end(); ++it) {
+      TrackerWrapper *tracker = it->second;
+
+      tracker->cMo = m_mapOfCameraTransformationMatrix[it->first] * cMo;
+#if defined(VISP_HAVE_MODULE_KLT)
+      vpHomogeneousMatrix c_curr_tTc_curr0 =
+          m_mapOfCameraTransformationMatrix[it->first] * cMo * tracker->c0Mo.inverse();
+      tracker->ctTc0 = c_curr_tTc_curr0;
+#endif
+
+      trackers.push_back(tracker);
+      images.push_back(mapOfImages[it->first]);
+      velocityTwists.push_back(mapOfVelocityTwist[it->first]);
+      startIndexes.push_back(start_index);
+
+      start_index += tracker->m_error.getRows();
+    }
+
+    CameraVVSBody body(CameraVVSBody::INTERACTION_MATRIX, trackers, &images, &velocityTwists, &startIndexes, &m_L,
+                       &m_error);
+    vpThreadPool::instance().parallel_for(0, static_cast<int>(trackers.size()), body);
+  } else {
+    unsigned int start_index = 0;
+
+    for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+         it != m_mapOfTrackers.end(); ++it) {
+      TrackerWrapper *tracker = it->second;
+
+      tracker->cMo = m_mapOfCameraTransformationMatrix[it->first] * cMo;
+#if defined(VISP_HAVE_MODULE_KLT)
+      vpHomogeneousMatrix c_curr_tTc_curr0 =
+          m_mapOfCameraTransformationMatrix[it->first] * cMo * tracker->c0Mo.inverse();
+      tracker->ctTc0 = c_curr_tTc_curr0;
+#endif
+
+      tracker->computeVVSInteractionMatrixAndResidu(mapOfImages[it->first]);
+
+      multRows6(tracker->m_L, mapOfVelocityTwist[it->first], m_L, start_index);
+      m_error.insert(start_index, tracker->m_error);
+
+      start_index += tracker->m_error.getRows();
+    }
+  }
+}
+
+/*!
+  Compute the weights of the stacked features (robust weights times the
+  feature factors), the weighted residual and the weighted normal equations
+  \f$ \mathbf{L}^T \mathbf{W}^2 \mathbf{L} \f$ and
+  \f$ \mathbf{L}^T \mathbf{W}^2 \mathbf{e} \f$ in a single pass over the
+  stacked interaction matrix, which is left unweighted.
+
+  \param num : Weighted sum of the squared residuals.
+  \param den : Sum of the weights.
+*/
+void vpMbGenericTracker::computeVVSNormalEquations(double &num, double &den)
+{
+  VVSWorkspace &ws = m_vvsWorkspace;
+
+  double factorEdge = m_mapOfFeatureFactors[EDGE_TRACKER];
+#if defined(VISP_HAVE_MODULE_KLT)
+  double factorKlt = m_mapOfFeatureFactors[KLT_TRACKER];
+#endif
+  double factorDepth = m_mapOfFeatureFactors[DEPTH_NORMAL_TRACKER];
+  double factorDepthDense = m_mapOfFeatureFactors[DEPTH_DENSE_TRACKER];
 
+  unsigned int start_index = 0;
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
        it != m_mapOfTrackers.end(); ++it) {
     TrackerWrapper *tracker = it->second;
 
-    tracker->cMo = m_mapOfCameraTransformationMatrix[it->first] * cMo;
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
-    vpHomogeneousMatrix c_curr_tTc_curr0 = m_mapOfCameraTransformationMatrix[it->first] * cMo * tracker->c0Mo.inverse();
-    tracker->ctTc0 = c_curr_tTc_curr0;
+    if (tracker->m_trackerType & EDGE_TRACKER) {
+      for (unsigned int i = 0; i < tracker->m_error_edge.getRows(); i++) {
+        ws.W_true[start_index + i] = tracker->m_w_edge[i] * tracker->m_factor[i] * factorEdge;
+      }
+
+      start_index += tracker->m_error_edge.getRows();
+    }
+
+#if defined(VISP_HAVE_MODULE_KLT)
+    if (tracker->m_trackerType & KLT_TRACKER) {
+      for (unsigned int i = 0; i < tracker->m_error_klt.getRows(); i++) {
+        ws.W_true[start_index + i] = tracker->m_w_klt[i] * factorKlt;
+      }
+
+      start_index += tracker->m_error_klt.getRows();
+    }
 #endif
 
-    tracker->computeVVSInteractionMatrixAndResidu(mapOfImages[it->first]);
+    if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
+      for (unsigned int i = 0; i < tracker->m_error_depthNormal.getRows(); i++) {
+        ws.W_true[start_index + i] = tracker->m_w_depthNormal[i] * factorDepth;
+      }
 
-    m_L.insert(tracker->m_L * mapOfVelocityTwist[it->first], start_index, 0);
-    m_error.insert(start_index, tracker->m_error);
+      start_index += tracker->m_error_depthNormal.getRows();
+    }
 
-    start_index += tracker->m_error.getRows();
+    if (tracker->m_trackerType & DEPTH_DENSE_TRACKER) {
+      for (unsigned int i = 0; i < tracker->m_error_depthDense.getRows(); i++) {
+        ws.W_true[start_index + i] = tracker->m_w_depthDense[i] * factorDepthDense;
+      }
+
+      start_index += tracker->m_error_depthDense.getRows();
+    }
+  }
+
+  num = 0;
+  den = 0;
+  ws.LTL = 0;
+  ws.LTR = 0;
+  double *LTL = ws.LTL.data;
+  double *LTR = ws.LTR.data;
+  double wL[6];
+
+  for (unsigned int i = 0; i < m_L.getRows(); i++) {
+    const double wi = ws.W_true[i];
+    const double wei = wi * m_error[i];
+    m_weightedError[i] = wei;
+
+    num += wi * vpMath::sqr(m_error[i]);
+    den += wi;
+
+    const double *L = m_L[i];
+    for (unsigned int a = 0; a < 6; a++) {
+      wL[a] = wi * L[a];
+    }
+
+    // Upper triangular part only, the normal matrix is symmetric
+    for (unsigned int a = 0; a < 6; a++) {
+      LTR[a] += wL[a] * wei;
+      for (unsigned int b = a; b < 6; b++) {
+        LTL[a * 6 + b] += wL[a] * wL[b];
+      }
+    }
+  }
+
+  for (unsigned int a = 1; a < 6; a++) {
+    for (unsigned int b = 0; b < a; b++) {
+      LTL[a * 6 + b] = LTL[b * 6 + a];
+    }
+  }
+}
+
+/*!
+  Compute the velocity from the weighted normal equations computed in
+  computeVVSNormalEquations(), using Gauss-Newton or Levenberg-Marquardt.
+  When some dof cannot be estimated, the normal equations are projected with
+  \f$ {^c}\mathbf{V}_o \; {^o}\mathbf{J}_o \f$ instead of projecting the whole
+  stacked interaction matrix.
+
+  \param isoJoIdentity_ : If false, the Jacobian oJo removes the dof that
+  cannot be estimated.
+  \param iter : Current iteration.
+  \param mu : Levenberg-Marquardt damping factor.
+  \param v : Resulting velocity (6x1).
+*/
+void vpMbGenericTracker::computeVVSPoseUpdate(const bool isoJoIdentity_, const unsigned int iter, double &mu,
+                                              vpColVector &v)
+{
+  VVSWorkspace &ws = m_vvsWorkspace;
+
+  if (isoJoIdentity_) {
+    ws.H = ws.LTL;
+    ws.g = ws.LTR;
+  } else {
+    // With LVJ = L * J, LVJ^T LVJ = J^T (L^T L) J and LVJ^T R = J^T (L^T R)
+    ws.cVo.buildFrom(cMo);
+    mult6x6(ws.cVo, oJo, ws.J);
+    mult6x6(ws.LTL, ws.J, ws.tmp);
+    multTranspose6x6(ws.J, ws.tmp, ws.H);
+    for (unsigned int a = 0; a < 6; a++) {
+      double sum = 0;
+      for (unsigned int b = 0; b < 6; b++) {
+        sum += ws.J[b][a] * ws.LTR[b];
+      }
+      ws.g[a] = sum;
+    }
+  }
+
+  if (m_optimizationMethod == vpMbTracker::LEVENBERG_MARQUARDT_OPT) {
+    for (unsigned int a = 0; a < 6; a++) {
+      ws.H[a][a] += mu;
+    }
+  }
+
+  ws.H.solveNormalEquations6(ws.g, ws.dv, ws.H.getRows() * std::numeric_limits<double>::epsilon());
+
+  v.resize(6, false);
+  for (unsigned int a = 0; a < 6; a++) {
+    v[a] = -m_lambda * ws.dv[a];
+  }
+
+  if (!isoJoIdentity_) {
+    double tmp[6];
+    for (unsigned int a = 0; a < 6; a++) {
+      tmp[a] = v[a];
+    }
+    for (unsigned int a = 0; a < 6; a++) {
+      double sum = 0;
+      for (unsigned int b = 0; b < 6; b++) {
+        sum += ws.cVo[a][b] * tmp[b];
+      }
+      v[a] = sum;
+    }
+  }
+
+  if (m_optimizationMethod == vpMbTracker::LEVENBERG_MARQUARDT_OPT) {
+    if (iter != 0)
+      mu /= 10.0;
+
+    ws.error_prev = m_error;
   }
 }
 
 void vpMbGenericTracker::computeVVSWeights()
 {
-  unsigned int start_index = 0;
+  if (m_parallelCameraComputation && m_mapOfTrackers.size() > 1) {
+    std::vector<TrackerWrapper *> &trackers = m_vvsWorkspace.trackers;
+    trackers.clear();
+    for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+         it != m_mapOfTrackers.end(); ++it) {
+      trackers.push_back(it->second);
+    }
 
-  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-       it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-    tracker->computeVVSWeights();
+    CameraVVSBody body(CameraVVSBody::WEIGHTS, trackers);
+    vpThreadPool::instance().parallel_for(0, static_cast<int>(trackers.size()), body);
+
+    unsigned int start_index = 0;
+    for (size_t i = 0; i < trackers.size(); i++) {
+      m_w.insert(start_index, trackers[i]->m_w);
+      start_index += trackers[i]->m_w.getRows();
+    }
+  } else {
+    unsigned int start_index = 0;
 
-    m_w.insert(start_index, tracker->m_w);
-    start_index += tracker->m_w.getRows();
+    for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+         it != m_mapOfTrackers.end(); ++it) {
+      TrackerWrapper *tracker = it->second;
+      tracker->computeVVSWeights();
+
+      m_w.insert(start_index, tracker->m_w);
+      start_index += tracker->m_w.getRows();
+    }
   }
 }
 
@@ -898,7 +1192,7 @@ vpMbHiddenFaces<vpMbtPolygon> &vpMbGenericTracker::getFaces(const std::string &c
   return faces;
 }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
 /*!
   Return the address of the circle feature list for the reference camera.
 */
@@ -997,7 +1291,7 @@ void vpMbGenericTracker::getFeaturesForDisplay(std::map<std::string, std::vector
 */
 double vpMbGenericTracker::getGoodMovingEdgesRatioThreshold() const { return m_percentageGdPt; }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
 /*!
   Get the current list of KLT points for the reference camera.
 
@@ -1076,6 +1370,7 @@ int vpMbGenericTracker::getKltNbPoints() const
   return 0;
 }
 
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
 /*!
   Get the klt tracker at the current state for the reference camera.
 
@@ -1133,8 +1428,29 @@ void vpMbGenericTracker::getKltOpencv(std::map<std::string, vpKltOpencv> &mapOfK
     mapOfKlts[it->first] = tracker->getKltOpencv();
   }
 }
+#else
+/*!
+  Get the klt tracker at the current state for the reference camera.
+
+  \return klt tracker.
+*/
+vpKltTracker vpMbGenericTracker::getKltTracker() const
+{
+  std::map<std::string, TrackerWrapper *>::const_iterator it_tracker = m_mapOfTrackers.find(m_referenceCameraName);
+
+  if (it_tracker != m_mapOfTrackers.end()) {
+    TrackerWrapper *tracker;
+    tracker = it_tracker->second;
+    return tracker->getKltTracker();
+  } else {
+    std::cerr << "Cannot find the reference camera: " << m_referenceCameraName << "!" << std::endl;
+  }
+
+  return vpKltTracker();
+}
+#endif
 
-#if (VISP_HAVE_OPENCV_VERSION >= 0x020408)
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408))
 /*!
   Get the current list of KLT points for the reference camera.
 
@@ -2948,6 +3264,19 @@ void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigne
   }
 }
 
+void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                                     std::map<std::string, const vpMatrix *> &mapOfPointClouds,
+                                     std::map<std::string, unsigned int> &mapOfPointCloudWidths,
+                                     std::map<std::string, unsigned int> &mapOfPointCloudHeights)
+{
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+    tracker->preTracking(mapOfImages[it->first], mapOfPointClouds[it->first], mapOfPointCloudWidths[it->first],
+                         mapOfPointCloudHeights[it->first]);
+  }
+}
+
 /*!
   Re-initialize the model used by the tracker.
 
@@ -3295,7 +3624,7 @@ void vpMbGenericTracker::resetTracker()
   // Reset default ponderation between each feature type
   m_mapOfFeatureFactors[EDGE_TRACKER] = 1.0;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   m_mapOfFeatureFactors[KLT_TRACKER] = 1.0;
 #endif
 
@@ -4021,7 +4350,8 @@ void vpMbGenericTracker::setNbRayCastingAttemptsForVisibility(const unsigned int
 }
 #endif
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
 /*!
   Set the new value of the klt tracker.
 
@@ -4076,6 +4406,23 @@ void vpMbGenericTracker::setKltOpencv(const std::map<std::string, vpKltOpencv> &
     }
   }
 }
+#else
+/*!
+  Set the new value of the klt tracker.
+
+  \param t : Klt tracker containing the new values.
+
+  \note This function will set the new parameter for all the cameras.
+*/
+void vpMbGenericTracker::setKltTracker(const vpKltTracker &t)
+{
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+    tracker->setKltTracker(t);
+  }
+}
+#endif
 
 /*!
   Set the threshold for the acceptation of a point.
@@ -4117,7 +4464,7 @@ void vpMbGenericTracker::setLod(const bool useLod, const std::string &name)
   }
 }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
 /*!
   Set the erosion of the mask used on the Model faces.
 
@@ -4428,6 +4775,26 @@ void vpMbGenericTracker::setOptimizationMethod(const vpMbtOptimizationMethod &op
   }
 }
 
+/*!
+  Enable or disable the concurrent computation of the per-camera features
+  during the virtual visual servoing stage.
+
+  When enabled, the moving-edges, KLT and depth features (interaction matrix,
+  residual and robust weights) of each camera are computed in parallel on
+  vpThreadPool, one camera per task, before being stacked in the same order
+  as in the serial implementation. An exception thrown for a camera is
+  rethrown once all the cameras have been processed. The estimated pose is thus the
+  same as with the serial computation. This is only useful when more than one
+  camera is used.
+
+  \param parallel : If true, compute the features of each camera in parallel.
+  By default the per-camera features are computed sequentially.
+*/
+void vpMbGenericTracker::setParallelCameraComputation(const bool parallel)
+{
+  m_parallelCameraComputation = parallel;
+}
+
 /*!
   Set the pose to be used in entry (as guess) of the next call to the track()
   function. This pose will be just used once.
@@ -4885,7 +5252,7 @@ void vpMbGenericTracker::setUseEdgeTracking(const std::string &name, const bool
   }
 }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
 /*!
   Set if the polygon that has the given name has to be considered during
   the tracking phase.
@@ -5077,7 +5444,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
     TrackerWrapper *tracker = it->second;
 
     if ((tracker->m_trackerType & (EDGE_TRACKER |
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                                    KLT_TRACKER |
 #endif
                                    DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER)) == 0) {
@@ -5085,7 +5452,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
     }
 
     if (tracker->m_trackerType & (EDGE_TRACKER
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                                   | KLT_TRACKER
 #endif
                                   ) &&
@@ -5121,7 +5488,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
     tracker->postTracking(mapOfImages[it->first], mapOfPointClouds[it->first]);
 
     if (displayFeatures) {
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
       if (tracker->m_trackerType & KLT_TRACKER) {
         tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
       }
@@ -5153,7 +5520,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &m
     TrackerWrapper *tracker = it->second;
 
     if ((tracker->m_trackerType & (EDGE_TRACKER |
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                                    KLT_TRACKER |
 #endif
                                    DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER)) == 0) {
@@ -5161,13 +5528,13 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &m
     }
 
     if (tracker->m_trackerType & (EDGE_TRACKER
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                                   | KLT_TRACKER
 #endif
                                   ) && mapOfImages[it->first] == NULL) {
       throw vpException(vpException::fatalError, "Image pointer is NULL!");
     } else if (tracker->m_trackerType & (EDGE_TRACKER
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                                   | KLT_TRACKER
 #endif
                                   ) && mapOfImages[it->first] != NULL) {
@@ -5203,7 +5570,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &m
     tracker->postTracking(mapOfImages[it->first], mapOfPointClouds[it->first]);
 
     if (displayFeatures) {
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
       if (tracker->m_trackerType & KLT_TRACKER) {
         tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
       }
@@ -5220,26 +5587,64 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &m
 #endif
 
 /*!
-  Realize the tracking of the object in the image.
+  Check the point cloud given to a depth tracker.
 
-  \throw vpException : if the tracking is supposed to have failed
+  \exception vpException::fatalError : If the point cloud is NULL.
+*/
+void vpMbGenericTracker::checkPointCloud(const std::string &, const std::vector<vpColVector> *point_cloud,
+                                         const unsigned int, const unsigned int)
+{
+  if (point_cloud == NULL) {
+    throw vpException(vpException::fatalError, "Pointcloud is NULL!");
+  }
+}
 
-  \param mapOfImages : Map of images.
-  \param mapOfPointClouds : Map of pointclouds.
+/*!
+  Check the point cloud given to a depth tracker.
+
+  \exception vpException::fatalError : If the point cloud is NULL.
+  \exception vpException::dimensionError : If the point cloud matrix is not
+  (width*height)x3.
+*/
+void vpMbGenericTracker::checkPointCloud(const std::string &cameraName, const vpMatrix *point_cloud,
+                                         const unsigned int width, const unsigned int height)
+{
+  if (point_cloud == NULL) {
+    throw vpException(vpException::fatalError, "Pointcloud is NULL!");
+  }
+  if (point_cloud->getCols() != 3 || point_cloud->getRows() != width * height) {
+    throw vpException(vpException::dimensionError,
+                      "Point cloud matrix of camera %s is %dx%d, expected %dx3 for a %dx%d organized point cloud",
+                      cameraName.c_str(), point_cloud->getRows(), point_cloud->getCols(), width * height, width,
+                      height);
+  }
+}
+
+/*!
+  Realize the tracking of the object with organized point clouds, whatever
+  their representation.
+
+  \param mapOfImages : Map of grayscale images. When \e mapOfColorImages is
+  given, it is filled with the converted images.
+  \param mapOfColorImages : Map of color images, or NULL to track in
+  \e mapOfImages.
+  \param mapOfPointClouds : Map of pointclouds, checked by checkPointCloud().
   \param mapOfPointCloudWidths : Map of pointcloud widths.
   \param mapOfPointCloudHeights : Map of pointcloud heights.
 */
-void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
-                               std::map<std::string, const std::vector<vpColVector> *> &mapOfPointClouds,
-                               std::map<std::string, unsigned int> &mapOfPointCloudWidths,
-                               std::map<std::string, unsigned int> &mapOfPointCloudHeights)
+template <class PointCloud>
+void vpMbGenericTracker::trackImpl(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                                   std::map<std::string, const vpImage<vpRGBa> *> *mapOfColorImages,
+                                   std::map<std::string, const PointCloud *> &mapOfPointClouds,
+                                   std::map<std::string, unsigned int> &mapOfPointCloudWidths,
+                                   std::map<std::string, unsigned int> &mapOfPointCloudHeights)
 {
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
        it != m_mapOfTrackers.end(); ++it) {
     TrackerWrapper *tracker = it->second;
 
     if ((tracker->m_trackerType & (EDGE_TRACKER |
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                                    KLT_TRACKER |
 #endif
                                    DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER)) == 0) {
@@ -5247,17 +5652,27 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
     }
 
     if (tracker->m_trackerType & (EDGE_TRACKER
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                                   | KLT_TRACKER
 #endif
-                                  ) &&
-        mapOfImages[it->first] == NULL) {
-      throw vpException(vpException::fatalError, "Image pointer is NULL!");
+                                  )) {
+      if (mapOfColorImages == NULL) {
+        if (mapOfImages[it->first] == NULL) {
+          throw vpException(vpException::fatalError, "Image pointer is NULL!");
+        }
+      } else {
+        const vpImage<vpRGBa> *I_color = (*mapOfColorImages)[it->first];
+        if (I_color == NULL) {
+          throw vpException(vpException::fatalError, "Image pointer is NULL!");
+        }
+        vpImageConvert::convert(*I_color, tracker->m_I);
+        mapOfImages[it->first] = &tracker->m_I; // update grayscale image buffer
+      }
     }
 
-    if (tracker->m_trackerType & (DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER) &&
-        (mapOfPointClouds[it->first] == NULL)) {
-      throw vpException(vpException::fatalError, "Pointcloud is NULL!");
+    if (tracker->m_trackerType & (DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER)) {
+      checkPointCloud(it->first, mapOfPointClouds[it->first], mapOfPointCloudWidths[it->first],
+                      mapOfPointCloudHeights[it->first]);
     }
   }
 
@@ -5283,7 +5698,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
     tracker->postTracking(mapOfImages[it->first], mapOfPointCloudWidths[it->first], mapOfPointCloudHeights[it->first]);
 
     if (displayFeatures) {
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
       if (tracker->m_trackerType & KLT_TRACKER) {
         tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
       }
@@ -5298,6 +5713,24 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
   computeProjectionError();
 }
 
+/*!
+  Realize the tracking of the object in the image.
+
+  \throw vpException : if the tracking is supposed to have failed
+
+  \param mapOfImages : Map of images.
+  \param mapOfPointClouds : Map of pointclouds.
+  \param mapOfPointCloudWidths : Map of pointcloud widths.
+  \param mapOfPointCloudHeights : Map of pointcloud heights.
+*/
+void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                               std::map<std::string, const std::vector<vpColVector> *> &mapOfPointClouds,
+                               std::map<std::string, unsigned int> &mapOfPointCloudWidths,
+                               std::map<std::string, unsigned int> &mapOfPointCloudHeights)
+{
+  trackImpl(mapOfImages, NULL, mapOfPointClouds, mapOfPointCloudWidths, mapOfPointCloudHeights);
+}
+
 /*!
   Realize the tracking of the object in the image.
 
@@ -5314,74 +5747,73 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &m
                                std::map<std::string, unsigned int> &mapOfPointCloudHeights)
 {
   std::map<std::string, const vpImage<unsigned char> *> mapOfImages;
-  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-       it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-
-    if ((tracker->m_trackerType & (EDGE_TRACKER |
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
-                                   KLT_TRACKER |
-#endif
-                                   DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER)) == 0) {
-      throw vpException(vpException::fatalError, "Bad tracker type: %d", tracker->m_trackerType);
-    }
+  trackImpl(mapOfImages, &mapOfColorImages, mapOfPointClouds, mapOfPointCloudWidths, mapOfPointCloudHeights);
+}
 
-    if (tracker->m_trackerType & (EDGE_TRACKER
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
-                                  | KLT_TRACKER
-#endif
-                                  ) && mapOfColorImages[it->first] == NULL) {
-      throw vpException(vpException::fatalError, "Image pointer is NULL!");
-    } else if (tracker->m_trackerType & (EDGE_TRACKER
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
-                                  | KLT_TRACKER
-#endif
-                                  ) && mapOfColorImages[it->first] != NULL) {
-      vpImageConvert::convert(*mapOfColorImages[it->first], tracker->m_I);
-      mapOfImages[it->first] = &tracker->m_I; //update grayscale image buffer
-    }
+/*!
+  Realize the tracking of the object in the image.
 
-    if (tracker->m_trackerType & (DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER) &&
-        (mapOfPointClouds[it->first] == NULL)) {
-      throw vpException(vpException::fatalError, "Pointcloud is NULL!");
-    }
-  }
+  \throw vpException : if the tracking is supposed to have failed
+  \throw vpException::dimensionError : if a point cloud matrix is not (width*height)x3
 
-  preTracking(mapOfImages, mapOfPointClouds, mapOfPointCloudWidths, mapOfPointCloudHeights);
+  \param mapOfImages : Map of images.
+  \param mapOfPointClouds : Map of pointclouds, each one stored in a
+  (width*height)x3 matrix with the X, Y, Z coordinates of a point per row.
+  \param mapOfPointCloudWidths : Map of pointcloud widths.
+  \param mapOfPointCloudHeights : Map of pointcloud heights.
+*/
+void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                               std::map<std::string, const vpMatrix *> &mapOfPointClouds,
+                               std::map<std::string, unsigned int> &mapOfPointCloudWidths,
+                               std::map<std::string, unsigned int> &mapOfPointCloudHeights)
+{
+  trackImpl(mapOfImages, NULL, mapOfPointClouds, mapOfPointCloudWidths, mapOfPointCloudHeights);
+}
 
-  try {
-    computeVVS(mapOfImages);
-  } catch (...) {
-    covarianceMatrix = -1;
-    throw; // throw the original exception
-  }
+/*!
+  Realize the tracking of the object in the image.
 
-  testTracking();
+  \throw vpException : if the tracking is supposed to have failed
+  \throw vpException::dimensionError : if a point cloud matrix is not (width*height)x3
 
-  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-       it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
+  \param mapOfColorImages : Map of images.
+  \param mapOfPointClouds : Map of pointclouds, each one stored in a
+  (width*height)x3 matrix with the X, Y, Z coordinates of a point per row.
+  \param mapOfPointCloudWidths : Map of pointcloud widths.
+  \param mapOfPointCloudHeights : Map of pointcloud heights.
+*/
+void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &mapOfColorImages,
+                               std::map<std::string, const vpMatrix *> &mapOfPointClouds,
+                               std::map<std::string, unsigned int> &mapOfPointCloudWidths,
+                               std::map<std::string, unsigned int> &mapOfPointCloudHeights)
+{
+  std::map<std::string, const vpImage<unsigned char> *> mapOfImages;
+  trackImpl(mapOfImages, &mapOfColorImages, mapOfPointClouds, mapOfPointCloudWidths, mapOfPointCloudHeights);
+}
 
-    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
-      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
-    }
+vpMbGenericTracker::VVSWorkspace::VVSWorkspace()
+  : W_true(), L_true(), LVJ_true(), error_prev(), LTL(6, 6), LTR(6), H(6, 6), g(6), dv(6), J(6, 6), tmp(6, 6),
+    cVo(), dM(), dMinv(), LTLo(6, 6), K(), trackers(), images(), velocityTwists(), startIndexes()
+{
+}
 
-    tracker->postTracking(mapOfImages[it->first], mapOfPointCloudWidths[it->first], mapOfPointCloudHeights[it->first]);
+/*!
+  Resize the buffers for the given number of stacked features. Memory is
+  only reallocated when the number of features changes.
 
-    if (displayFeatures) {
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
-      if (tracker->m_trackerType & KLT_TRACKER) {
-        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
-      }
-#endif
+  \param nbFeatures : Number of stacked features.
+  \param computeCovariance : If true, the buffers used by the covariance
+  computation are also resized.
+*/
+void vpMbGenericTracker::VVSWorkspace::resize(const unsigned int nbFeatures, const bool computeCovariance)
+{
+  W_true.resize(nbFeatures, false);
+  error_prev.resize(nbFeatures, false);
 
-      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
-        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
-      }
-    }
+  if (computeCovariance) {
+    L_true.resize(nbFeatures, 6, false, false);
+    LVJ_true.resize(nbFeatures, 6, false, false);
   }
-
-  computeProjectionError();
 }
 
 /** TrackerWrapper **/
@@ -5402,7 +5834,7 @@ vpMbGenericTracker::TrackerWrapper::TrackerWrapper(const int trackerType)
   : m_error(), m_L(), m_trackerType(trackerType), m_w(), m_weightedError()
 {
   if ((m_trackerType & (EDGE_TRACKER |
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                         KLT_TRACKER |
 #endif
                         DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER)) == 0) {
@@ -5435,7 +5867,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char>
   unsigned int iter = 0;
 
   double factorEdge = 1.0;
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   double factorKlt = 1.0;
 #endif
   double factorDepth = 1.0;
@@ -5447,7 +5879,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char>
 
   double mu = m_initialMu;
   vpHomogeneousMatrix cMo_prev;
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   vpHomogeneousMatrix ctTc0_Prev; // Only for KLT
 #endif
   bool isoJoIdentity_ = true;
@@ -5457,7 +5889,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char>
   vpMatrix L_true, LVJ_true;
 
   unsigned int nb_edge_features = m_error_edge.getRows();
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   unsigned int nb_klt_features = m_error_klt.getRows();
 #endif
   unsigned int nb_depth_features = m_error_depthNormal.getRows();
@@ -5469,7 +5901,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char>
     bool reStartFromLastIncrement = false;
     computeVVSCheckLevenbergMarquardt(iter, m_error, error_prev, cMo_prev, mu, reStartFromLastIncrement);
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
     if (reStartFromLastIncrement) {
       if (m_trackerType & KLT_TRACKER) {
         ctTc0 = ctTc0_Prev;
@@ -5502,7 +5934,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char>
           cVo.buildFrom(cMo);
 
           vpMatrix K; // kernel
-          unsigned int rank = (m_L * cVo).kernel(K);
+          unsigned int rank = (m_L * cVo).AtA().kernelNormalEquations6(K);
           if (rank == 0) {
             throw vpException(vpException::fatalError, "Rank=0, cannot estimate the pose !");
           }
@@ -5539,7 +5971,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char>
         start_index += nb_edge_features;
       }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
       if (m_trackerType & KLT_TRACKER) {
         for (unsigned int i = 0; i < nb_klt_features; i++) {
           double wi = m_w_klt[i] * factorKlt;
@@ -5595,7 +6027,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char>
       computeVVSPoseEstimation(isoJoIdentity_, iter, m_L, LTL, m_weightedError, m_error, error_prev, LTR, mu, v);
 
       cMo_prev = cMo;
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
       if (m_trackerType & KLT_TRACKER) {
         ctTc0_Prev = ctTc0;
       }
@@ -5603,7 +6035,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char>
 
       cMo = vpExponentialMap::direct(v).inverse() * cMo;
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
       if (m_trackerType & KLT_TRACKER) {
         ctTc0 = vpExponentialMap::direct(v).inverse() * ctTc0;
       }
@@ -5645,7 +6077,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVSInit(const vpImage<unsigned c
     m_w_edge.clear();
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   if (m_trackerType & KLT_TRACKER) {
     vpMbKltTracker::computeVVSInit();
     nbFeatures += m_error_klt.getRows();
@@ -5699,7 +6131,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVSInteractionMatrixAndResidu(co
     vpMbEdgeTracker::computeVVSInteractionMatrixAndResidu(*ptr_I);
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   if (m_trackerType & KLT_TRACKER) {
     vpMbKltTracker::computeVVSInteractionMatrixAndResidu();
   }
@@ -5721,7 +6153,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVSInteractionMatrixAndResidu(co
     start_index += m_error_edge.getRows();
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   if (m_trackerType & KLT_TRACKER) {
     m_L.insert(m_L_klt, start_index, 0);
     m_error.insert(start_index, m_error_klt);
@@ -5756,7 +6188,7 @@ void vpMbGenericTracker::TrackerWrapper::computeVVSWeights()
     start_index += m_w_edge.getRows();
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   if (m_trackerType & KLT_TRACKER) {
     vpMbTracker::computeVVSWeights(m_robust_klt, m_error_klt, m_w_klt);
     m_w.insert(start_index, m_w_klt);
@@ -5852,7 +6284,7 @@ void vpMbGenericTracker::TrackerWrapper::display(const vpImage<unsigned char> &I
 
 #ifdef VISP_HAVE_OGRE
   if ((m_trackerType & EDGE_TRACKER)
-    #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+    #if defined(VISP_HAVE_MODULE_KLT)
       || (m_trackerType & KLT_TRACKER)
     #endif
       ) {
@@ -5932,7 +6364,7 @@ void vpMbGenericTracker::TrackerWrapper::display(const vpImage<vpRGBa> &I, const
 
 #ifdef VISP_HAVE_OGRE
   if ((m_trackerType & EDGE_TRACKER)
-    #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+    #if defined(VISP_HAVE_MODULE_KLT)
       || (m_trackerType & KLT_TRACKER)
     #endif
       ) {
@@ -5951,7 +6383,7 @@ std::vector<std::vector<double> > vpMbGenericTracker::TrackerWrapper::getFeature
     features.insert(features.end(), m_featuresToBeDisplayedEdge.begin(), m_featuresToBeDisplayedEdge.end());
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   if (m_trackerType & KLT_TRACKER) {
     //m_featuresToBeDisplayedKlt updated after postTracking()
     features.insert(features.end(), m_featuresToBeDisplayedKlt.begin(), m_featuresToBeDisplayedKlt.end());
@@ -5977,7 +6409,7 @@ std::vector<std::vector<double> > vpMbGenericTracker::TrackerWrapper::getModelFo
   if (m_trackerType == EDGE_TRACKER) {
     models = vpMbEdgeTracker::getModelForDisplay(width, height, cMo_, camera, displayFullModel);
   }
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   else if (m_trackerType == KLT_TRACKER) {
     models = vpMbKltTracker::getModelForDisplay(width, height, cMo_, camera, displayFullModel);
   }
@@ -6039,7 +6471,7 @@ void vpMbGenericTracker::TrackerWrapper::init(const vpImage<unsigned char> &I)
     faces.computeScanLineRender(cam, I.getWidth(), I.getHeight());
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   if (m_trackerType & KLT_TRACKER)
     vpMbKltTracker::reinit(I);
 #endif
@@ -6066,7 +6498,7 @@ void vpMbGenericTracker::TrackerWrapper::initCircle(const vpPoint &p1, const vpP
   if (m_trackerType & EDGE_TRACKER)
     vpMbEdgeTracker::initCircle(p1, p2, p3, radius, idFace, name);
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   if (m_trackerType & KLT_TRACKER)
     vpMbKltTracker::initCircle(p1, p2, p3, radius, idFace, name);
 #endif
@@ -6078,7 +6510,7 @@ void vpMbGenericTracker::TrackerWrapper::initCylinder(const vpPoint &p1, const v
   if (m_trackerType & EDGE_TRACKER)
     vpMbEdgeTracker::initCylinder(p1, p2, radius, idFace, name);
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   if (m_trackerType & KLT_TRACKER)
     vpMbKltTracker::initCylinder(p1, p2, radius, idFace, name);
 #endif
@@ -6089,7 +6521,7 @@ void vpMbGenericTracker::TrackerWrapper::initFaceFromCorners(vpMbtPolygon &polyg
   if (m_trackerType & EDGE_TRACKER)
     vpMbEdgeTracker::initFaceFromCorners(polygon);
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   if (m_trackerType & KLT_TRACKER)
     vpMbKltTracker::initFaceFromCorners(polygon);
 #endif
@@ -6106,7 +6538,7 @@ void vpMbGenericTracker::TrackerWrapper::initFaceFromLines(vpMbtPolygon &polygon
   if (m_trackerType & EDGE_TRACKER)
     vpMbEdgeTracker::initFaceFromLines(polygon);
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   if (m_trackerType & KLT_TRACKER)
     vpMbKltTracker::initFaceFromLines(polygon);
 #endif
@@ -6149,7 +6581,7 @@ void vpMbGenericTracker::TrackerWrapper::loadConfigFile(const std::string &confi
   xmlp.setKltHarrisParam(0.01);
   xmlp.setKltBlockSize(3);
   xmlp.setKltPyramidLevels(3);
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   xmlp.setKltMaskBorder(maskBorder);
 #endif
 
@@ -6171,7 +6603,7 @@ void vpMbGenericTracker::TrackerWrapper::loadConfigFile(const std::string &confi
     std::vector<std::string> tracker_names;
     if (m_trackerType & EDGE_TRACKER)
       tracker_names.push_back("Edge");
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
     if (m_trackerType & KLT_TRACKER)
       tracker_names.push_back("Klt");
 #endif
@@ -6228,7 +6660,7 @@ void vpMbGenericTracker::TrackerWrapper::loadConfigFile(const std::string &confi
   vpMbEdgeTracker::setMovingEdge(meParser);
 
 // KLT
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   tracker.setMaxFeatures((int)xmlp.getKltMaxFeatures());
   tracker.setWindowSize((int)xmlp.getKltWindowSize());
   tracker.setQuality(xmlp.getKltQuality());
@@ -6260,7 +6692,7 @@ void vpMbGenericTracker::TrackerWrapper::loadConfigFile(const std::string &confi
 void vpMbGenericTracker::TrackerWrapper::postTracking(const vpImage<unsigned char> *const ptr_I,
                                                       const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud)
 {
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   // KLT
   if (m_trackerType & KLT_TRACKER) {
     if (vpMbKltTracker::postTracking(*ptr_I, m_w_klt)) {
@@ -6314,7 +6746,7 @@ void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char
     }
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   if (m_trackerType & KLT_TRACKER) {
     try {
       vpMbKltTracker::preTracking(*ptr_I);
@@ -6349,7 +6781,7 @@ void vpMbGenericTracker::TrackerWrapper::postTracking(const vpImage<unsigned cha
                                                       const unsigned int pointcloud_width,
                                                       const unsigned int pointcloud_height)
 {
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   // KLT
   if (m_trackerType & KLT_TRACKER) {
     if (vpMbKltTracker::postTracking(*ptr_I, m_w_klt)) {
@@ -6405,7 +6837,51 @@ void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char
     }
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
+  if (m_trackerType & KLT_TRACKER) {
+    try {
+      vpMbKltTracker::preTracking(*ptr_I);
+    } catch (const vpException &e) {
+      std::cerr << "Error in KLT tracking: " << e.what() << std::endl;
+      throw;
+    }
+  }
+#endif
+
+  if (m_trackerType & DEPTH_NORMAL_TRACKER) {
+    try {
+      vpMbDepthNormalTracker::segmentPointCloud(*point_cloud, pointcloud_width, pointcloud_height);
+    } catch (...) {
+      std::cerr << "Error in Depth tracking" << std::endl;
+      throw;
+    }
+  }
+
+  if (m_trackerType & DEPTH_DENSE_TRACKER) {
+    try {
+      vpMbDepthDenseTracker::segmentPointCloud(*point_cloud, pointcloud_width, pointcloud_height);
+    } catch (...) {
+      std::cerr << "Error in Depth dense tracking" << std::endl;
+      throw;
+    }
+  }
+}
+
+void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char> * const ptr_I,
+                                                     const vpMatrix * const point_cloud,
+                                                     const unsigned int pointcloud_width,
+                                                     const unsigned int pointcloud_height)
+{
+  if (m_trackerType & EDGE_TRACKER) {
+    try {
+      vpMbEdgeTracker::trackMovingEdge(*ptr_I);
+    } catch (...) {
+      std::cerr << "Error in moving edge tracking" << std::endl;
+      throw;
+    }
+  }
+
+#if defined(VISP_HAVE_MODULE_KLT)
   if (m_trackerType & KLT_TRACKER) {
     try {
       vpMbKltTracker::preTracking(*ptr_I);
@@ -6482,8 +6958,8 @@ void vpMbGenericTracker::TrackerWrapper::reInitModel(const vpImage<unsigned char
   nbvisiblepolygone = 0;
 
 // KLT
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
-#if (VISP_HAVE_OPENCV_VERSION < 0x020408)
+#if defined(VISP_HAVE_MODULE_KLT)
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION < 0x020408))
   if (cur != NULL) {
     cvReleaseImage(&cur);
     cur = NULL;
@@ -6565,7 +7041,7 @@ void vpMbGenericTracker::TrackerWrapper::reInitModel(const vpImage<vpRGBa> &I_co
 void vpMbGenericTracker::TrackerWrapper::resetTracker()
 {
   vpMbEdgeTracker::resetTracker();
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   vpMbKltTracker::resetTracker();
 #endif
   vpMbDepthNormalTracker::resetTracker();
@@ -6577,7 +7053,7 @@ void vpMbGenericTracker::TrackerWrapper::setCameraParameters(const vpCameraParam
   this->cam = camera;
 
   vpMbEdgeTracker::setCameraParameters(cam);
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   vpMbKltTracker::setCameraParameters(cam);
 #endif
   vpMbDepthNormalTracker::setCameraParameters(cam);
@@ -6615,7 +7091,7 @@ void vpMbGenericTracker::TrackerWrapper::setPose(const vpImage<unsigned char> *
     vpImageConvert::convert(*I_color, m_I);
   }
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   if (m_trackerType & KLT_TRACKER) {
     performKltSetPose = true;
 
@@ -6687,7 +7163,7 @@ void vpMbGenericTracker::TrackerWrapper::setProjectionErrorComputation(const boo
 void vpMbGenericTracker::TrackerWrapper::setScanLineVisibilityTest(const bool &v)
 {
   vpMbEdgeTracker::setScanLineVisibilityTest(v);
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
   vpMbKltTracker::setScanLineVisibilityTest(v);
 #endif
   vpMbDepthNormalTracker::setScanLineVisibilityTest(v);
@@ -6697,7 +7173,7 @@ void vpMbGenericTracker::TrackerWrapper::setScanLineVisibilityTest(const bool &v
 void vpMbGenericTracker::TrackerWrapper::setTrackerType(const int type)
 {
   if ((type & (EDGE_TRACKER |
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                KLT_TRACKER |
 #endif
                DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER)) == 0) {
@@ -6721,7 +7197,7 @@ void vpMbGenericTracker::TrackerWrapper::track(const vpImage<unsigned char> &
 )
 {
   if ((m_trackerType & (EDGE_TRACKER
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                         | KLT_TRACKER
 #endif
                         )) == 0) {
@@ -6744,7 +7220,7 @@ void vpMbGenericTracker::TrackerWrapper::track(const vpImage<unsigned char> *con
                                                const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud)
 {
   if ((m_trackerType & (EDGE_TRACKER |
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                         KLT_TRACKER |
 #endif
                         DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER)) == 0) {
@@ -6753,7 +7229,7 @@ void vpMbGenericTracker::TrackerWrapper::track(const vpImage<unsigned char> *con
   }
 
   if (m_trackerType & (EDGE_TRACKER
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
                        | KLT_TRACKER
 #endif
                        ) &&
@@ -2936,7 +2936,8 @@ void vpMbTracker::computeVVSPoseEstimation(const bool isoJoIdentity_, const unsi
       vpMatrix LMA(LTL.getRows(), LTL.getCols());
       LMA.eye();
       vpMatrix LTLmuI = LTL + (LMA * mu);
-      v = -m_lambda * LTLmuI.pseudoInverse(LTLmuI.getRows() * std::numeric_limits<double>::epsilon()) * LTR;
+      LTLmuI.solveNormalEquations6(LTR, v, LTLmuI.getRows() * std::numeric_limits<double>::epsilon());
+      v *= -m_lambda;
 
       if (iter != 0)
         mu /= 10.0;
@@ -2949,7 +2950,8 @@ void vpMbTracker::computeVVSPoseEstimation(const bool isoJoIdentity_, const unsi
 
     case vpMbTracker::GAUSS_NEWTON_OPT:
     default:
-      v = -m_lambda * LTL.pseudoInverse(LTL.getRows() * std::numeric_limits<double>::epsilon()) * LTR;
+      LTL.solveNormalEquations6(LTR, v, LTL.getRows() * std::numeric_limits<double>::epsilon());
+      v *= -m_lambda;
       break;
     }
   } else {
@@ -2965,8 +2967,8 @@ void vpMbTracker::computeVVSPoseEstimation(const bool isoJoIdentity_, const unsi
       vpMatrix LMA(LVJTLVJ.getRows(), LVJTLVJ.getCols());
       LMA.eye();
       vpMatrix LTLmuI = LVJTLVJ + (LMA * mu);
-      v = -m_lambda * LTLmuI.pseudoInverse(LTLmuI.getRows() * std::numeric_limits<double>::epsilon()) * LVJTR;
-      v = cVo * v;
+      LTLmuI.solveNormalEquations6(LVJTR, v, LTLmuI.getRows() * std::numeric_limits<double>::epsilon());
+      v = cVo * (-m_lambda * v);
 
       if (iter != 0)
         mu /= 10.0;
@@ -2978,8 +2980,8 @@ void vpMbTracker::computeVVSPoseEstimation(const bool isoJoIdentity_, const unsi
     }
     case vpMbTracker::GAUSS_NEWTON_OPT:
     default:
-      v = -m_lambda * LVJTLVJ.pseudoInverse(LVJTLVJ.getRows() * std::numeric_limits<double>::epsilon()) * LVJTR;
-      v = cVo * v;
+      LVJTLVJ.solveNormalEquations6(LVJTR, v, LVJTLVJ.getRows() * std::numeric_limits<double>::epsilon());
+      v = cVo * (-m_lambda * v);
       break;
     }
   }
@@ -59,7 +59,7 @@
 #include <visp3/gui/vpDisplayGTK.h>
 #include <visp3/mbt/vpMbGenericTracker.h>
 
-#define GETOPTARGS "i:dclt:e:DmCh"
+#define GETOPTARGS "i:dclt:e:DmCPh"
 
 namespace
 {
@@ -70,7 +70,7 @@ namespace
     \n\
     SYNOPSIS\n\
       %s [-i <test image path>] [-c] [-d] [-h] [-l] \n\
-     [-t <tracker type>] [-e <last frame index>] [-D] [-m] [-C]\n", name);
+     [-t <tracker type>] [-e <last frame index>] [-D] [-m] [-C] [-P]\n", name);
 
     fprintf(stdout, "\n\
     OPTIONS:                                               \n\
@@ -106,6 +106,9 @@ namespace
     \n\
       -C \n\
          Use color images.\n\
+    \n\
+      -P \n\
+         Compute the features of each camera in parallel.\n\
     \n\
       -h \n\
          Print the help.\n\n");
@@ -116,7 +119,7 @@ namespace
 
   bool getOptions(int argc, const char **argv, std::string &ipath, bool &click_allowed, bool &display,
                   bool &useScanline, int &trackerType, int &lastFrame, bool &use_depth, bool &use_mask,
-                  bool &use_color_image)
+                  bool &use_color_image, bool &use_parallel)
   {
     const char *optarg_;
     int c;
@@ -150,6 +153,9 @@ namespace
       case 'C':
         use_color_image = true;
         break;
+      case 'P':
+        use_parallel = true;
+        break;
       case 'h':
         usage(argv[0], NULL);
         return false;
@@ -239,7 +245,7 @@ namespace
   template <typename Type>
   bool run(vpImage<Type> &I, vpImage<Type> &I_depth, const std::string &input_directory,
            bool opt_click_allowed, bool opt_display, bool useScanline, int trackerType_image,
-           int opt_lastFrame, bool use_depth, bool use_mask) {
+           int opt_lastFrame, bool use_depth, bool use_mask, bool use_parallel) {
 #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
     static_assert(std::is_same<Type, unsigned char>::value || std::is_same<Type, vpRGBa>::value,
                   "Template function supports only unsigned char and vpRGBa images!");
@@ -285,8 +291,12 @@ namespace
     tracker.setMovingEdge(me);
 
     // Klt
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
     vpKltOpencv klt;
+#else
+    vpKltTracker klt;
+#endif
     tracker.setKltMaskBorder(5);
     klt.setMaxFeatures(10000);
     klt.setWindowSize(5);
@@ -296,7 +306,11 @@ namespace
     klt.setBlockSize(3);
     klt.setPyramidLevels(3);
 
+#if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
     tracker.setKltOpencv(klt);
+#else
+    tracker.setKltTracker(klt);
+#endif
 #endif
 
     // Depth
@@ -334,13 +348,14 @@ namespace
     tracker.getCameraParameters(cam_color, cam_depth);
     tracker.setDisplayFeatures(true);
     tracker.setScanLineVisibilityTest(useScanline);
+    tracker.setParallelCameraComputation(use_parallel);
 
     std::map<int, std::pair<double, double> > map_thresh;
     //Take the highest thresholds between all CI machines
 #ifdef VISP_HAVE_COIN3D
     map_thresh[vpMbGenericTracker::EDGE_TRACKER]
         = useScanline ? std::pair<double, double>(0.005, 3.9) : std::pair<double, double>(0.007, 2.9);
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
     map_thresh[vpMbGenericTracker::KLT_TRACKER]
         = useScanline ? std::pair<double, double>(0.006, 1.9) : std::pair<double, double>(0.005, 1.3);
     map_thresh[vpMbGenericTracker::EDGE_TRACKER | vpMbGenericTracker::KLT_TRACKER]
@@ -348,7 +363,7 @@ namespace
 #endif
     map_thresh[vpMbGenericTracker::EDGE_TRACKER | vpMbGenericTracker::DEPTH_DENSE_TRACKER]
         = useScanline ? std::pair<double, double>(0.003, 1.7) : std::pair<double, double>(0.002, 0.8);
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
     map_thresh[vpMbGenericTracker::KLT_TRACKER | vpMbGenericTracker::DEPTH_DENSE_TRACKER]
         = std::pair<double, double>(0.002, 0.3);
     map_thresh[vpMbGenericTracker::EDGE_TRACKER | vpMbGenericTracker::KLT_TRACKER | vpMbGenericTracker::DEPTH_DENSE_TRACKER]
@@ -357,7 +372,7 @@ namespace
 #else
     map_thresh[vpMbGenericTracker::EDGE_TRACKER]
         = useScanline ? std::pair<double, double>(0.007, 2.3) : std::pair<double, double>(0.007, 2.1);
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
     map_thresh[vpMbGenericTracker::KLT_TRACKER]
         = useScanline ? std::pair<double, double>(0.006, 1.7) : std::pair<double, double>(0.005, 1.4);
     map_thresh[vpMbGenericTracker::EDGE_TRACKER | vpMbGenericTracker::KLT_TRACKER]
@@ -365,7 +380,7 @@ namespace
 #endif
     map_thresh[vpMbGenericTracker::EDGE_TRACKER | vpMbGenericTracker::DEPTH_DENSE_TRACKER]
         = useScanline ? std::pair<double, double>(0.002, 0.7) : std::pair<double, double>(0.001, 0.4);
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
     map_thresh[vpMbGenericTracker::KLT_TRACKER | vpMbGenericTracker::DEPTH_DENSE_TRACKER]
         = std::pair<double, double>(0.002, 0.3);
     map_thresh[vpMbGenericTracker::EDGE_TRACKER | vpMbGenericTracker::KLT_TRACKER | vpMbGenericTracker::DEPTH_DENSE_TRACKER]
@@ -546,6 +561,7 @@ int main(int argc, const char *argv[])
     bool use_depth = false;
     bool use_mask = false;
     bool use_color_image = false;
+    bool use_parallel = false;
 
     // Get the visp-images-data package path or VISP_INPUT_IMAGE_PATH
     // environment variable value
@@ -554,7 +570,7 @@ int main(int argc, const char *argv[])
     // Read the command line options
     if (!getOptions(argc, argv, opt_ipath, opt_click_allowed, opt_display,
                     useScanline, trackerType_image, opt_lastFrame, use_depth,
-                    use_mask, use_color_image)) {
+                    use_mask, use_color_image, use_parallel)) {
       return EXIT_FAILURE;
     }
 
@@ -563,14 +579,15 @@ int main(int argc, const char *argv[])
     std::cout << "use_depth: " << use_depth << std::endl;
     std::cout << "use_mask: " << use_mask << std::endl;
     std::cout << "use_color_image: " << use_color_image << std::endl;
+    std::cout << "use_parallel: " << use_parallel << std::endl;
 #ifdef VISP_HAVE_COIN3D
     std::cout << "COIN3D available." << std::endl;
 #endif
 
-#if !defined(VISP_HAVE_MODULE_KLT) || (!defined(VISP_HAVE_OPENCV) || (VISP_HAVE_OPENCV_VERSION < 0x020100))
+#if !defined(VISP_HAVE_MODULE_KLT)
     if (trackerType_image & 2) {
       std::cout << "KLT features cannot be used: ViSP is not built with "
-                   "KLT module or OpenCV is not available.\nTest is not run."
+                   "KLT module.\nTest is not run."
                 << std::endl;
       return EXIT_SUCCESS;
     }
@@ -597,11 +614,11 @@ int main(int argc, const char *argv[])
     if (use_color_image) {
       vpImage<vpRGBa> I_color, I_depth_color;
       return run(I_color, I_depth_color, input_directory, opt_click_allowed, opt_display, useScanline,
-                 trackerType_image, opt_lastFrame, use_depth, use_mask);
+                 trackerType_image, opt_lastFrame, use_depth, use_mask, use_parallel);
     } else {
       vpImage<unsigned char> I_gray, I_depth_gray;
       return run(I_gray, I_depth_gray, input_directory, opt_click_allowed, opt_display, useScanline,
-                 trackerType_image, opt_lastFrame, use_depth, use_mask);
+                 trackerType_image, opt_lastFrame, use_depth, use_mask, use_parallel);
     }
   } catch (const vpException &e) {
     std::cout << "Catch an exception: " << e << std::endl;
@@ -265,7 +265,7 @@ namespace
 
     tracker.setDepthDenseSamplingStep(4, 4);
 
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+#if defined(VISP_HAVE_MODULE_KLT)
     tracker.setKltMaskBorder(5);
 #endif
 
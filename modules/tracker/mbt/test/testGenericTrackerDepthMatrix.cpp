@@ -0,0 +1,282 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the depth trackers with point clouds stored in a vpMatrix.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testGenericTrackerDepthMatrix.cpp
+
+  \brief Check that the depth trackers give the same poses when the point
+  cloud is given as a std::vector<vpColVector> or as a (width*height)x3
+  vpMatrix, on a synthetic sequence of a cube.
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_MODULE_MBT)
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/mbt/vpMbDepthDenseTracker.h>
+#include <visp3/mbt/vpMbDepthNormalTracker.h>
+#include <visp3/mbt/vpMbGenericTracker.h>
+
+namespace
+{
+const unsigned int width = 160, height = 120;
+const double halfSide = 0.1;
+const int nbFrames = 8;
+
+// Cube of side 2*halfSide centered on the object frame origin
+bool writeModel(const std::string &filename)
+{
+  std::ofstream file(filename.c_str());
+  if (!file.is_open()) {
+    return false;
+  }
+  file << "V1\n8\n";
+  for (int k = 0; k < 2; k++) {
+    double z = (k == 0) ? -halfSide : halfSide;
+    file << -halfSide << " " << -halfSide << " " << z << "\n";
+    file << halfSide << " " << -halfSide << " " << z << "\n";
+    file << halfSide << " " << halfSide << " " << z << "\n";
+    file << -halfSide << " " << halfSide << " " << z << "\n";
+  }
+  file << "0\n0\n6\n";
+  file << "4 0 3 2 1\n4 4 5 6 7\n4 0 1 5 4\n4 1 2 6 5\n4 2 3 7 6\n4 3 0 4 7\n";
+  file << "0\n0\n";
+  return true;
+}
+
+vpHomogeneousMatrix groundTruth(int frame)
+{
+  vpHomogeneousMatrix cMo(0.01 * frame, -0.005 * frame, 0.7, vpMath::rad(35 + frame), vpMath::rad(-30),
+                          vpMath::rad(10 + 0.5 * frame));
+  return cMo;
+}
+
+// Organized point cloud of the cube seen from cMo, by ray casting. Pixels
+// that do not see the cube are set to (0, 0, 0)
+void renderPointCloud(const vpCameraParameters &cam, const vpHomogeneousMatrix &cMo,
+                      std::vector<vpColVector> &point_cloud, vpMatrix &point_cloud_matrix)
+{
+  vpHomogeneousMatrix oMc = cMo.inverse();
+  point_cloud.resize(width * height);
+  point_cloud_matrix.resize(width * height, 3);
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      double x = 0, y = 0;
+      vpPixelMeterConversion::convertPoint(cam, j, i, x, y);
+      // Ray o + t d in the object frame, t being the depth in the camera frame
+      double o[3], d[3];
+      for (unsigned int k = 0; k < 3; k++) {
+        o[k] = oMc[k][3];
+        d[k] = oMc[k][0] * x + oMc[k][1] * y + oMc[k][2];
+      }
+      double tmin = 0, tmax = std::numeric_limits<double>::max();
+      for (unsigned int k = 0; k < 3 && tmin <= tmax; k++) {
+        if (std::fabs(d[k]) < std::numeric_limits<double>::epsilon()) {
+          if (std::fabs(o[k]) > halfSide) {
+            tmin = tmax + 1;
+          }
+          continue;
+        }
+        double t1 = (-halfSide - o[k]) / d[k], t2 = (halfSide - o[k]) / d[k];
+        tmin = std::max(tmin, std::min(t1, t2));
+        tmax = std::min(tmax, std::max(t1, t2));
+      }
+      double Z = (tmin <= tmax) ? tmin : 0;
+
+      vpColVector pt(3);
+      pt[0] = x * Z;
+      pt[1] = y * Z;
+      pt[2] = Z;
+      point_cloud[i * width + j] = pt;
+      for (unsigned int k = 0; k < 3; k++) {
+        point_cloud_matrix[i * width + j][k] = pt[k];
+      }
+    }
+  }
+}
+
+template <class Tracker> void setup(Tracker &tracker, const vpCameraParameters &cam, const std::string &model)
+{
+  tracker.setCameraParameters(cam);
+  tracker.setNearClippingDistance(0.01);
+  tracker.setFarClippingDistance(2.0);
+  tracker.loadModel(model);
+}
+
+bool samePose(const std::string &name, int frame, const vpHomogeneousMatrix &cMo_vector,
+              const vpHomogeneousMatrix &cMo_matrix, const vpHomogeneousMatrix &cMo_truth)
+{
+  for (unsigned int k = 0; k < 16; k++) {
+    if (cMo_vector.data[k] != cMo_matrix.data[k]) {
+      std::cerr << name << ", frame " << frame << ": poses differ\n"
+                << cMo_vector << "\n" << cMo_matrix << std::endl;
+      return false;
+    }
+  }
+  vpTranslationVector t_err = cMo_truth.getTranslationVector() - cMo_matrix.getTranslationVector();
+  if (t_err.frobeniusNorm() > 5e-3) {
+    std::cerr << name << ", frame " << frame << ": translation error " << t_err.frobeniusNorm() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Track the sequence with a single depth tracker fed with both point cloud
+// representations
+template <class Tracker> bool runSingle(const std::string &name, const vpCameraParameters &cam, const std::string &model)
+{
+  Tracker tracker_vector, tracker_matrix;
+  setup(tracker_vector, cam, model);
+  setup(tracker_matrix, cam, model);
+
+  vpImage<unsigned char> I(height, width);
+  tracker_vector.initFromPose(I, groundTruth(0));
+  tracker_matrix.initFromPose(I, groundTruth(0));
+
+  std::vector<vpColVector> point_cloud;
+  vpMatrix point_cloud_matrix;
+  for (int frame = 1; frame < nbFrames; frame++) {
+    renderPointCloud(cam, groundTruth(frame), point_cloud, point_cloud_matrix);
+    tracker_vector.track(point_cloud, width, height);
+    tracker_matrix.track(point_cloud_matrix, width, height);
+    if (!samePose(name, frame, tracker_vector.getPose(), tracker_matrix.getPose(), groundTruth(frame))) {
+      return false;
+    }
+  }
+
+  // A matrix that does not hold width*height points is rejected
+  try {
+    tracker_matrix.track(point_cloud_matrix, width, height - 1);
+    std::cerr << name << ": bad point cloud size not detected" << std::endl;
+    return false;
+  } catch (vpException &e) {
+    if (e.getCode() != vpException::dimensionError) {
+      std::cerr << name << ": unexpected exception " << e.what() << std::endl;
+      return false;
+    }
+  }
+
+  std::cout << name << ": same poses with both point cloud representations" << std::endl;
+  return true;
+}
+
+bool runGeneric(const vpCameraParameters &cam, const std::string &model)
+{
+  const std::string name = "vpMbGenericTracker";
+  int trackerType = vpMbGenericTracker::DEPTH_NORMAL_TRACKER | vpMbGenericTracker::DEPTH_DENSE_TRACKER;
+  vpMbGenericTracker tracker_vector(1, trackerType), tracker_matrix(1, trackerType);
+  setup(tracker_vector, cam, model);
+  setup(tracker_matrix, cam, model);
+
+  vpImage<unsigned char> I(height, width);
+  tracker_vector.initFromPose(I, groundTruth(0));
+  tracker_matrix.initFromPose(I, groundTruth(0));
+
+  const std::string camera = "Camera";
+  std::map<std::string, const vpImage<unsigned char> *> mapOfImages;
+  std::map<std::string, const std::vector<vpColVector> *> mapOfPointClouds;
+  std::map<std::string, const vpMatrix *> mapOfPointCloudMatrices;
+  std::map<std::string, unsigned int> mapOfWidths, mapOfHeights;
+  std::vector<vpColVector> point_cloud;
+  vpMatrix point_cloud_matrix;
+  mapOfImages[camera] = &I;
+  mapOfPointClouds[camera] = &point_cloud;
+  mapOfPointCloudMatrices[camera] = &point_cloud_matrix;
+  mapOfWidths[camera] = width;
+  mapOfHeights[camera] = height;
+
+  for (int frame = 1; frame < nbFrames; frame++) {
+    renderPointCloud(cam, groundTruth(frame), point_cloud, point_cloud_matrix);
+    tracker_vector.track(mapOfImages, mapOfPointClouds, mapOfWidths, mapOfHeights);
+    tracker_matrix.track(mapOfImages, mapOfPointCloudMatrices, mapOfWidths, mapOfHeights);
+    if (!samePose(name, frame, tracker_vector.getPose(), tracker_matrix.getPose(), groundTruth(frame))) {
+      return false;
+    }
+  }
+
+  // A matrix with more than 3 columns is rejected
+  point_cloud_matrix.resize(width * height, 4);
+  try {
+    tracker_matrix.track(mapOfImages, mapOfPointCloudMatrices, mapOfWidths, mapOfHeights);
+    std::cerr << name << ": bad point cloud size not detected" << std::endl;
+    return false;
+  } catch (vpException &e) {
+    if (e.getCode() != vpException::dimensionError) {
+      std::cerr << name << ": unexpected exception " << e.what() << std::endl;
+      return false;
+    }
+  }
+
+  std::cout << name << ": same poses with both point cloud representations" << std::endl;
+  return true;
+}
+} // namespace
+
+int main()
+{
+  const std::string model = "testGenericTrackerDepthMatrix.cao";
+  if (!writeModel(model)) {
+    std::cerr << "Cannot write " << model << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vpCameraParameters cam;
+  cam.initPersProjWithoutDistortion(200.0, 200.0, width / 2.0, height / 2.0);
+
+  bool success = false;
+  try {
+    success = runSingle<vpMbDepthDenseTracker>("vpMbDepthDenseTracker", cam, model) &&
+              runSingle<vpMbDepthNormalTracker>("vpMbDepthNormalTracker", cam, model) && runGeneric(cam, model);
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.what() << std::endl;
+  }
+  vpIoTools::remove(model);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#else
+int main()
+{
+  std::cout << "Nothing to run, the mbt module is required" << std::endl;
+  return EXIT_SUCCESS;
+}
+#endif
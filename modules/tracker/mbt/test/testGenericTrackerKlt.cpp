@@ -0,0 +1,229 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the KLT features of the generic model-based tracker.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testGenericTrackerKlt.cpp
+
+  \brief Track a synthetic textured cube with the KLT features of
+  vpMbGenericTracker and check the estimated poses against the ground truth.
+  The keypoints are tracked with vpKltOpencv when OpenCV is available, and
+  with vpKltTracker otherwise.
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_MODULE_MBT) && defined(VISP_HAVE_MODULE_KLT)
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/mbt/vpMbGenericTracker.h>
+
+namespace
+{
+const unsigned int width = 320, height = 240;
+const double halfSide = 0.1;
+const double cellSize = 0.02;
+const int nbFrames = 20;
+
+// Cube of side 2*halfSide centered on the object frame origin
+bool writeModel(const std::string &filename)
+{
+  std::ofstream file(filename.c_str());
+  if (!file.is_open()) {
+    return false;
+  }
+  file << "V1\n8\n";
+  for (int k = 0; k < 2; k++) {
+    double z = (k == 0) ? -halfSide : halfSide;
+    file << -halfSide << " " << -halfSide << " " << z << "\n";
+    file << halfSide << " " << -halfSide << " " << z << "\n";
+    file << halfSide << " " << halfSide << " " << z << "\n";
+    file << -halfSide << " " << halfSide << " " << z << "\n";
+  }
+  file << "0\n0\n6\n";
+  file << "4 0 3 2 1\n4 4 5 6 7\n4 0 1 5 4\n4 1 2 6 5\n4 2 3 7 6\n4 3 0 4 7\n";
+  file << "0\n0\n";
+  return true;
+}
+
+vpHomogeneousMatrix groundTruth(int frame)
+{
+  vpHomogeneousMatrix cMo(0.002 * frame, -0.001 * frame, 0.7 + 0.002 * frame, vpMath::rad(35 + 0.3 * frame),
+                          vpMath::rad(-30 + 0.2 * frame), vpMath::rad(10 + 0.3 * frame));
+  return cMo;
+}
+
+// Grey level of a checkerboard of random cells, indexed by the object frame
+// coordinates of a point of the cube surface
+double texture(const double o[3])
+{
+  unsigned int h = 2166136261u;
+  for (unsigned int k = 0; k < 3; k++) {
+    int c = static_cast<int>(std::floor((o[k] + halfSide) / cellSize + 1e-9));
+    h = (h ^ static_cast<unsigned int>(c + 7)) * 16777619u;
+  }
+  return 40.0 + static_cast<double>(h % 176);
+}
+
+// Intensity seen along the ray through the image point (x, y), 0 for the
+// background
+double renderRay(const vpHomogeneousMatrix &oMc, double x, double y)
+{
+  // Ray o + t d in the object frame
+  double o[3], d[3];
+  for (unsigned int k = 0; k < 3; k++) {
+    o[k] = oMc[k][3];
+    d[k] = oMc[k][0] * x + oMc[k][1] * y + oMc[k][2];
+  }
+  double tmin = 0, tmax = std::numeric_limits<double>::max();
+  unsigned int axis = 0;
+  for (unsigned int k = 0; k < 3 && tmin <= tmax; k++) {
+    if (std::fabs(d[k]) < std::numeric_limits<double>::epsilon()) {
+      if (std::fabs(o[k]) > halfSide) {
+        tmin = tmax + 1;
+      }
+      continue;
+    }
+    double t1 = (-halfSide - o[k]) / d[k], t2 = (halfSide - o[k]) / d[k];
+    if (std::min(t1, t2) > tmin) {
+      tmin = std::min(t1, t2);
+      axis = k;
+    }
+    tmax = std::min(tmax, std::max(t1, t2));
+  }
+  if (tmin > tmax) {
+    return 0.0;
+  }
+
+  double p[3];
+  for (unsigned int k = 0; k < 3; k++) {
+    p[k] = o[k] + tmin * d[k];
+  }
+  // Keep the hit point inside the face it belongs to
+  p[axis] = (p[axis] > 0) ? halfSide - 1e-6 : -halfSide + 1e-6;
+  return texture(p);
+}
+
+// Image of the cube seen from cMo, with 4x4 supersampling
+void renderImage(const vpCameraParameters &cam, const vpHomogeneousMatrix &cMo, vpImage<unsigned char> &I)
+{
+  const unsigned int nbSamples = 4;
+  vpHomogeneousMatrix oMc = cMo.inverse();
+  I.resize(height, width);
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      double sum = 0;
+      for (unsigned int si = 0; si < nbSamples; si++) {
+        for (unsigned int sj = 0; sj < nbSamples; sj++) {
+          double u = j - 0.5 + (sj + 0.5) / nbSamples, v = i - 0.5 + (si + 0.5) / nbSamples;
+          double x = 0, y = 0;
+          vpPixelMeterConversion::convertPoint(cam, u, v, x, y);
+          sum += renderRay(oMc, x, y);
+        }
+      }
+      I[i][j] = static_cast<unsigned char>(vpMath::round(sum / (nbSamples * nbSamples)));
+    }
+  }
+}
+} // namespace
+
+int main()
+{
+  const std::string model = "testGenericTrackerKlt.cao";
+  if (!writeModel(model)) {
+    std::cerr << "Cannot write " << model << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vpCameraParameters cam;
+  cam.initPersProjWithoutDistortion(400.0, 400.0, width / 2.0, height / 2.0);
+
+  bool success = true;
+  try {
+    vpMbGenericTracker tracker(1, vpMbGenericTracker::KLT_TRACKER);
+    tracker.setCameraParameters(cam);
+    tracker.setKltMaskBorder(5);
+    tracker.setAngleAppear(vpMath::rad(85.0));
+    tracker.setAngleDisappear(vpMath::rad(89.0));
+    tracker.setNearClippingDistance(0.01);
+    tracker.setFarClippingDistance(2.0);
+    tracker.loadModel(model);
+
+    vpImage<unsigned char> I;
+    renderImage(cam, groundTruth(0), I);
+    tracker.initFromPose(I, groundTruth(0));
+    std::cout << "Initial number of KLT points: " << tracker.getKltNbPoints() << std::endl;
+    if (tracker.getKltNbPoints() < 20) {
+      std::cerr << "Not enough KLT points detected" << std::endl;
+      success = false;
+    }
+
+    for (int frame = 1; frame < nbFrames && success; frame++) {
+      renderImage(cam, groundTruth(frame), I);
+      tracker.track(I);
+
+      vpHomogeneousMatrix cMo = tracker.getPose();
+      vpPoseVector err(groundTruth(frame).inverse() * cMo);
+      double t_err = std::sqrt(err[0] * err[0] + err[1] * err[1] + err[2] * err[2]);
+      double tu_err = std::sqrt(err[3] * err[3] + err[4] * err[4] + err[5] * err[5]);
+      if (t_err > 5e-3 || tu_err > vpMath::rad(1.0)) {
+        std::cerr << "Frame " << frame << ": translation error " << t_err << " m, rotation error "
+                  << vpMath::deg(tu_err) << " deg" << std::endl;
+        success = false;
+      }
+    }
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.what() << std::endl;
+    success = false;
+  }
+  vpIoTools::remove(model);
+
+  if (success) {
+    std::cout << "The KLT features follow the synthetic sequence" << std::endl;
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#else
+int main()
+{
+  std::cout << "Nothing to run, the mbt and klt modules are required" << std::endl;
+  return EXIT_SUCCESS;
+}
+#endif
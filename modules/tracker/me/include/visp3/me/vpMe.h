@@ -46,6 +46,8 @@
 #ifndef vpMe_H
 #define vpMe_H
 
+#include <vector>
+
 #include <visp3/core/vpImage.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpMatrix.h>
@@ -88,8 +90,19 @@ private:
   // the that extremity
   int strip;
   // int graph ;
-  vpMatrix *mask; //! Array of matrices defining the different masks (one for
-                  //! every angle step).
+  //! Array of matrices defining the different masks (one for every angle
+  //! step). The convolutions use a fixed-point copy of the masks: call
+  //! updateFixedPointMask() after modifying these matrices.
+  //! \warning Should not be public, use getMask() instead (kept public for
+  //! compatibility reasons).
+  vpMatrix *mask;
+
+private:
+  //! Integer copy of the masks, one row of fixed_mask_stride coefficients per
+  //! mask row and mask_size rows per angle step. Rows are zero padded to a
+  //! multiple of 8 coefficients to ease the use of SIMD instructions.
+  std::vector<short> fixed_mask;
+  unsigned int fixed_mask_stride;
 
 public:
   vpMe();
@@ -113,11 +126,40 @@ public:
   */
   inline unsigned int getAngleStep() const { return anglestep; }
   /*!
-    Get the matrix of the mask.
+    Get the matrices of the masks, one for every angle step, as computed by
+    initMask(). The convolutions of the moving-edges sites use their
+    fixed-point copy returned by getFixedPointMask(): call
+    updateFixedPointMask() after modifying the matrices.
 
-    \return the value of mask.
+    \return Array of getMaskNumber() matrices of getMaskSize() rows and
+    columns.
   */
   inline vpMatrix *getMask() const { return mask; }
+  /*!
+    Get the fixed-point version of a mask, as computed by initMask().
+
+    Coefficients are stored row by row, each row containing
+    getFixedPointMaskStride() values where only the first getMaskSize() ones
+    are not null.
+
+    \param index : index of the mask in [0, getMaskNumber()-1].
+
+    \return Pointer to the first coefficient of the mask.
+
+    \sa getMask()
+  */
+  inline const short *getFixedPointMask(const unsigned int index) const
+  {
+    return &fixed_mask[index * mask_size * fixed_mask_stride];
+  }
+  /*!
+    Return the number of coefficients in a row of the fixed-point masks.
+
+    \return A multiple of 8 greater than or equal to getMaskSize().
+
+    \sa getFixedPointMask()
+  */
+  inline unsigned int getFixedPointMaskStride() const { return fixed_mask_stride; }
   /*!
     Return the number of mask  applied to determine the object contour. The
     number of mask determines the precision of the normal of the edge for
@@ -193,6 +235,7 @@ public:
   inline double getThreshold() const { return threshold; }
 
   void initMask(); // convolution masks - offset computation
+  void updateFixedPointMask();
   void print();
 
   /*!
@@ -116,6 +116,10 @@ public:
   void display(const vpImage<vpRGBa> &I);
 
   double convolution(const vpImage<unsigned char> &ima, const vpMe *me);
+  static void convolution(const vpImage<unsigned char> &ima, const vpMe *me, vpMeSite *sites,
+                          const unsigned int nbSites, double *conv);
+  static void convolution(const vpImage<unsigned char> &ima, const vpMe *me, const double alpha, const int mask_sign,
+                          int *i, int *j, const unsigned int nbSites, double *conv);
 
   vpMeSite *getQueryList(const vpImage<unsigned char> &I, const int range);
 
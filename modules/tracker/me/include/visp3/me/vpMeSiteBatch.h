@@ -0,0 +1,130 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Contiguous storage of moving edges sites.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpMeSiteBatch.h
+  \brief Contiguous storage of moving edges sites.
+*/
+
+#ifndef vpMeSiteBatch_H
+#define vpMeSiteBatch_H
+
+#include <vector>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/me/vpMe.h>
+#include <visp3/me/vpMeSite.h>
+
+/*!
+  \class vpMeSiteBatch
+  \ingroup module_me
+
+  \brief Structure-of-arrays storage of moving edges sites that are tracked
+  together.
+
+  Sites are copied into contiguous arrays (one per site component) and all
+  of them are tracked in a single pass by track(), reusing the same
+  buffers for the query locations and convolutions of every site. The
+  result of the tracking of a site is the same as calling vpMeSite::track()
+  on it, without display.
+
+  This is what vpMeTracker::track() relies on to track the sites of a
+  primitive.
+
+  \code
+  vpMeSiteBatch batch;
+  for (std::list<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
+    batch.push_back(*it);
+  }
+  batch.track(I, &me);
+  unsigned int index = 0;
+  for (std::list<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it, ++index) {
+    batch.updateSite(index, *it);
+  }
+  \endcode
+*/
+class VISP_EXPORT vpMeSiteBatch
+{
+public:
+  vpMeSiteBatch();
+  virtual ~vpMeSiteBatch() {}
+
+  void clear();
+  void push_back(const vpMeSite &site);
+  void reserve(const unsigned int n);
+  /*!
+    Return the number of sites in the batch.
+  */
+  inline unsigned int size() const { return static_cast<unsigned int>(m_i.size()); }
+
+  void track(const vpImage<unsigned char> &I, const vpMe *me, const bool test_contraste = true);
+
+  void updateSite(const unsigned int index, vpMeSite &site) const;
+
+  /*!
+    Get the state of a site after track().
+
+    \param index : Index of the site in [0, size()-1].
+  */
+  inline vpMeSite::vpMeSiteState getState(const unsigned int index) const { return m_state[index]; }
+
+private:
+  void trackSite(const vpImage<unsigned char> &I, const vpMe *me, const unsigned int index,
+                 const bool test_contraste);
+
+  // Sites components
+  std::vector<int> m_i;
+  std::vector<int> m_j;
+  std::vector<int> m_i_1;
+  std::vector<int> m_j_1;
+  std::vector<double> m_ifloat;
+  std::vector<double> m_jfloat;
+  std::vector<unsigned char> m_v;
+  std::vector<int> m_mask_sign;
+  std::vector<double> m_alpha;
+  std::vector<double> m_convlt;
+  std::vector<double> m_normGradient;
+  std::vector<double> m_weight;
+  std::vector<vpMeSite::vpMeSiteState> m_state;
+
+  // Buffers shared by all the sites during tracking
+  std::vector<int> m_queryI;
+  std::vector<int> m_queryJ;
+  std::vector<double> m_queryIfloat;
+  std::vector<double> m_queryJfloat;
+  std::vector<double> m_convolution;
+};
+
+#endif
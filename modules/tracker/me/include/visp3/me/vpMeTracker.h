@@ -49,6 +49,7 @@
 #include <visp3/core/vpTracker.h>
 #include <visp3/me/vpMe.h>
 #include <visp3/me/vpMeSite.h>
+#include <visp3/me/vpMeSiteBatch.h>
 
 #include <iostream>
 #include <list>
@@ -82,6 +83,10 @@ protected:
 protected:
   vpMeSite::vpMeSiteDisplayType selectDisplay;
 
+private:
+  //! Contiguous copy of the sites tracked by track()
+  vpMeSiteBatch m_siteBatch;
+
 public:
   // Constructor/Destructor
   vpMeTracker();
@@ -42,6 +42,7 @@
         \brief Moving edges
 */
 
+#include <algorithm>
 #include <stdlib.h>
 #include <visp3/core/vpColVector.h>
 #include <visp3/core/vpMath.h>
@@ -334,8 +335,9 @@ static void calcul_masques(vpColVector &angle, // definitions des angles theta
 
 /*!
   Initialise the array of matrices with the defined size and the number of
-  matrices to create.
-
+  matrices to create, and their fixed-point copy used by the convolutions.
+  It is called by setMaskNumber() and setMaskSize(), and must be called
+  again after modifying the public members n_mask or mask_size.
 */
 void vpMe::initMask()
 {
@@ -355,6 +357,32 @@ void vpMe::initMask()
     angle[k++] = i;
 
   calcul_masques(angle, mask_size, mask);
+  updateFixedPointMask();
+}
+
+/*!
+  Compute the fixed-point copy of the masks used by the convolutions of the
+  moving-edges sites from the matrices returned by getMask(). It is called by
+  initMask(), and must be called again after modifying these matrices, the
+  convolutions otherwise keep using the previous coefficients.
+
+  The coefficients are rounded to the nearest integer and saturated to the
+  range of a short. The masks computed by initMask() only contain integers
+  in [-100, 100], that are stored without loss.
+*/
+void vpMe::updateFixedPointMask()
+{
+  fixed_mask_stride = ((mask_size + 7) / 8) * 8;
+  fixed_mask.assign(n_mask * mask_size * fixed_mask_stride, 0);
+  for (unsigned int k = 0; k < n_mask; k++) {
+    short *fixed = &fixed_mask[k * mask_size * fixed_mask_stride];
+    for (unsigned int a = 0; a < mask_size; a++) {
+      for (unsigned int b = 0; b < mask_size; b++) {
+        double value = std::max(-32768., std::min(32767., mask[k][a][b]));
+        fixed[a * fixed_mask_stride + b] = static_cast<short>(vpMath::round(value));
+      }
+    }
+  }
 }
 
 void vpMe::print()
@@ -375,7 +403,8 @@ void vpMe::print()
 
 vpMe::vpMe()
   : threshold(1500), mu1(0.5), mu2(0.5), min_samplestep(4), anglestep(1), mask_sign(0), range(4), sample_step(10),
-    ntotal_sample(0), points_to_track(500), mask_size(5), n_mask(180), strip(2), mask(NULL)
+    ntotal_sample(0), points_to_track(500), mask_size(5), n_mask(180), strip(2), mask(NULL), fixed_mask(),
+    fixed_mask_stride(0)
 {
   // ntotal_sample = 0; // not sure that it is used
   // points_to_track = 500; // not sure that it is used
@@ -386,7 +415,8 @@ vpMe::vpMe()
 
 vpMe::vpMe(const vpMe &me)
   : threshold(1500), mu1(0.5), mu2(0.5), min_samplestep(4), anglestep(1), mask_sign(0), range(4), sample_step(10),
-    ntotal_sample(0), points_to_track(500), mask_size(5), n_mask(180), strip(2), mask(NULL)
+    ntotal_sample(0), points_to_track(500), mask_size(5), n_mask(180), strip(2), mask(NULL), fixed_mask(),
+    fixed_mask_stride(0)
 {
   *this = me;
 }
@@ -46,10 +46,17 @@
 #include <cmath>  // std::fabs
 #include <limits> // numeric_limits
 #include <stdlib.h>
+#include <vector>
+#include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpTrackingException.h>
 #include <visp3/me/vpMe.h>
 #include <visp3/me/vpMeSite.h>
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 static bool horsImage(int i, int j, int half, int rows, int cols)
 {
@@ -61,6 +68,83 @@ static bool horsImage(int i, int j, int half, int rows, int cols)
   // > (cols - half - 3) )) ;
   return ((0 < (half_1 - i)) || ((i - rows + half_3) > 0) || (0 < (half_1 - j)) || ((j - cols + half_3) > 0));
 }
+
+namespace
+{
+// Index of the mask corresponding to the tangent of a site with normal alpha
+unsigned int maskIndex(double alpha, const vpMe *me)
+{
+  // Calculate tangent angle from normal
+  double theta = alpha + M_PI / 2;
+  // Move tangent angle to within 0->M_PI for a positive
+  // mask index
+  while (theta < 0)
+    theta += M_PI;
+  while (theta > M_PI)
+    theta -= M_PI;
+
+  // Convert radians to degrees
+  int thetadeg = vpMath::round(theta * 180 / M_PI);
+
+  if (abs(thetadeg) == 180) {
+    thetadeg = 0;
+  }
+
+  return (unsigned int)(thetadeg / (double)me->getAngleStep());
+}
+
+// Integer convolution of the msize x msize block starting at src with a
+// fixed-point mask whose rows hold stride coefficients. When the SSE2 path is
+// used, stride pixels are read per row, the caller has to ensure that they
+// lay inside the image.
+int convolutionFixedPoint(const unsigned char *src, unsigned int width, const short *mask, unsigned int msize,
+                          unsigned int stride, bool useSSE2)
+{
+#if VISP_HAVE_SSE2
+  if (useSSE2) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = _mm_setzero_si128();
+    for (unsigned int a = 0; a < msize; a++, src += width, mask += stride) {
+      for (unsigned int b = 0; b < stride; b += 8) {
+        const __m128i pix = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(src + b)), zero);
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(pix, _mm_loadu_si128((const __m128i *)(mask + b))));
+      }
+    }
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(acc);
+  }
+#else
+  (void)useSSE2;
+#endif
+
+  int conv = 0;
+  for (unsigned int a = 0; a < msize; a++, src += width, mask += stride) {
+    for (unsigned int b = 0; b < msize; b++) {
+      conv += mask[b] * src[b];
+    }
+  }
+  return conv;
+}
+
+// Convolution of a site that is known to be inside the image
+double convolutionInside(const vpImage<unsigned char> &I, const vpMe *me, const short *mask, int i, int j,
+                         int mask_sign, bool checkSSE2)
+{
+  unsigned int msize = me->getMaskSize();
+  unsigned int stride = me->getFixedPointMaskStride();
+  unsigned int width = I.getWidth();
+  unsigned int half = (msize - 1) >> 1;
+  unsigned int ihalf = static_cast<unsigned int>(i) - half;
+  unsigned int jhalf = static_cast<unsigned int>(j) - half;
+
+  // The SIMD path reads stride pixels on the last row of the block
+  bool useSSE2 = checkSSE2 && ((ihalf + msize - 1) * width + jhalf + stride <= I.getSize());
+
+  return mask_sign * static_cast<double>(convolutionFixedPoint(I.bitmap + ihalf * width + jhalf, width, mask,
+                                                               msize, stride, useSSE2));
+}
+} // namespace
 #endif
 
 void vpMeSite::init()
@@ -306,42 +390,107 @@ double vpMeSite::convolution(const vpImage<unsigned char> &I, const vpMe *me)
     i = 0;
     j = 0;
   } else {
-    // Calculate tangent angle from normal
-    double theta = alpha + M_PI / 2;
-    // Move tangent angle to within 0->M_PI for a positive
-    // mask index
-    while (theta < 0)
-      theta += M_PI;
-    while (theta > M_PI)
-      theta -= M_PI;
-
-    // Convert radians to degrees
-    int thetadeg = vpMath::round(theta * 180 / M_PI);
-
-    if (abs(thetadeg) == 180) {
-      thetadeg = 0;
-    }
+    bool checkSSE2 = vpCPUFeatures::checkSSE2();
+#if !VISP_HAVE_SSE2
+    checkSSE2 = false;
+#endif
+
+    // The masks only hold integer coefficients, the fixed-point
+    // computation gives the same result than the double-precision one
+    conv = convolutionInside(I, me, me->getFixedPointMask(maskIndex(alpha, me)), i, j, mask_sign, checkSSE2);
+  }
+
+  return (conv);
+}
 
-    unsigned int index_mask = (unsigned int)(thetadeg / (double)me->getAngleStep());
+/*!
+  Compute the convolution of a set of sites sharing the same normal, such as
+  the query list returned by getQueryList().
+
+  The mask index is computed once from the normal of the first site and the
+  pixel values are convolved with the fixed-point version of the mask (see
+  vpMe::getFixedPointMask()), using SSE2 instructions when available. The
+  result is the same as calling convolution() on each site: sites lying too
+  close to the image border have a null convolution and their coordinates
+  are set to (0,0).
+
+  \param I : Image in which the convolution is computed.
+  \param me : Moving edges settings.
+  \param sites : Array of nbSites sites with the same alpha.
+  \param nbSites : Number of sites.
+  \param conv : Array of nbSites values filled with the convolutions.
+*/
+void vpMeSite::convolution(const vpImage<unsigned char> &I, const vpMe *me, vpMeSite *sites,
+                           const unsigned int nbSites, double *conv)
+{
+  if (nbSites == 0) {
+    return;
+  }
 
-    unsigned int i_ = static_cast<unsigned int>(i);
-    unsigned int j_ = static_cast<unsigned int>(j);
-    unsigned int half_ = static_cast<unsigned int>(half);
+  int height_ = static_cast<int>(I.getHeight());
+  int width_ = static_cast<int>(I.getWidth());
+  int half = (static_cast<int>(me->getMaskSize()) - 1) >> 1;
+  const short *mask = me->getFixedPointMask(maskIndex(sites[0].alpha, me));
 
-    unsigned int ihalf = i_ - half_;
-    unsigned int jhalf = j_ - half_;
+  bool checkSSE2 = vpCPUFeatures::checkSSE2();
+#if !VISP_HAVE_SSE2
+  checkSSE2 = false;
+#endif
 
-    for (unsigned int a = 0; a < msize; a++) {
-      unsigned int ihalfa = ihalf + a;
-      for (unsigned int b = 0; b < msize; b++) {
-        conv += mask_sign * me->getMask()[index_mask][a][b] *
-                //	  I(i-half+a,j-half+b) ;
-                I(ihalfa, jhalf + b);
-      }
+  for (unsigned int n = 0; n < nbSites; n++) {
+    vpMeSite &site = sites[n];
+    if (horsImage(site.i, site.j, half + me->getStrip(), height_, width_)) {
+      conv[n] = 0.0;
+      site.i = 0;
+      site.j = 0;
+    } else {
+      conv[n] = convolutionInside(I, me, mask, site.i, site.j, site.mask_sign, checkSSE2);
     }
   }
+}
 
-  return (conv);
+/*!
+  Compute the convolution of a set of pixel locations sharing the same normal
+  and mask sign. This is the structure-of-arrays counterpart of
+  convolution(const vpImage<unsigned char> &, const vpMe *, vpMeSite *, const unsigned int, double *).
+
+  \param I : Image in which the convolution is computed.
+  \param me : Moving edges settings.
+  \param alpha : Angle of the normal shared by all the locations.
+  \param mask_sign : Mask sign shared by all the locations.
+  \param i : Array of nbSites row coordinates. Locations too close to the
+  image border are set to 0.
+  \param j : Array of nbSites column coordinates. Locations too close to the
+  image border are set to 0.
+  \param nbSites : Number of locations.
+  \param conv : Array of nbSites values filled with the convolutions.
+*/
+void vpMeSite::convolution(const vpImage<unsigned char> &I, const vpMe *me, const double alpha, const int mask_sign,
+                           int *i, int *j, const unsigned int nbSites, double *conv)
+{
+  if (nbSites == 0) {
+    return;
+  }
+
+  int height_ = static_cast<int>(I.getHeight());
+  int width_ = static_cast<int>(I.getWidth());
+  int half = (static_cast<int>(me->getMaskSize()) - 1) >> 1;
+  const short *mask = me->getFixedPointMask(maskIndex(alpha, me));
+
+  bool checkSSE2 = vpCPUFeatures::checkSSE2();
+#if !VISP_HAVE_SSE2
+  checkSSE2 = false;
+#endif
+
+  for (unsigned int n = 0; n < nbSites; n++) {
+    if (horsImage(i[n], j[n], half + me->getStrip(), height_, width_)) {
+      conv[n] = 0.0;
+      i[n] = 0;
+      j[n] = 0;
+    } else {
+      conv[n] = convolutionInside(I, me, mask, i[n], j[n], mask_sign, checkSSE2);
+    }
+  }
 }
 
 /*!
@@ -499,8 +648,6 @@ void vpMeSite::track(const vpImage<unsigned char> &I, const vpMe *me, const bool
   double contraste_max = 1 + me->getMu2();
   double contraste_min = 1 - me->getMu1();
 
-  // array in which likelihood ratios will be stored
-  double *likelihood = new double[2 * range + 1];
 
   int ii_1 = i;
   int jj_1 = j;
@@ -510,22 +657,36 @@ void vpMeSite::track(const vpImage<unsigned char> &I, const vpMe *me, const bool
   threshold = me->getThreshold();
   double diff = 1e6;
 
+  // convolution results of all the query sites, on the stack for the usual
+  // ranges
+  const unsigned int nbQueryMaxOnStack = 65;
+  double convolutionsOnStack[nbQueryMaxOnStack];
+  std::vector<double> convolutionsOnHeap;
+  double *convolutions = convolutionsOnStack;
+  if (2 * range + 1 > nbQueryMaxOnStack) {
+    convolutionsOnHeap.resize(2 * range + 1);
+    convolutions = &convolutionsOnHeap[0];
+  }
+  vpMeSite::convolution(I, me, list_query_pixels, 2 * range + 1, convolutions);
+
   //    std::cout <<"---------------------"<<std::endl ;
   for (unsigned int n = 0; n < 2 * range + 1; n++) {
     //   convolution results
-    double convolution_ = list_query_pixels[n].convolution(I, me);
+    double convolution_ = convolutions[n];
+    // likelihood ratio
+    double likelihood;
 
     // luminance ratio of reference pixel to potential correspondent pixel
     // the luminance must be similar, hence the ratio value should
     // lay between, for instance, 0.5 and 1.5 (parameter tolerance)
     if (test_contraste) {
-      likelihood[n] = fabs(convolution_ + convlt);
-      if (likelihood[n] > threshold) {
+      likelihood = fabs(convolution_ + convlt);
+      if (likelihood > threshold) {
         contraste = convolution_ / convlt;
         if ((contraste > contraste_min) && (contraste < contraste_max) && fabs(1 - contraste) < diff) {
           diff = fabs(1 - contraste);
           max_convolution = convolution_;
-          max = likelihood[n];
+          max = likelihood;
           max_rank = (int)n;
           // 	    max_rank2 = max_rank1;
           // 	    max_rank1 = max_rank;
@@ -534,10 +695,10 @@ void vpMeSite::track(const vpImage<unsigned char> &I, const vpMe *me, const bool
     }
 
     else {
-      likelihood[n] = fabs(2 * convolution_);
-      if (likelihood[n] > max && likelihood[n] > threshold) {
+      likelihood = fabs(2 * convolution_);
+      if (likelihood > max && likelihood > threshold) {
         max_convolution = convolution_;
-        max = likelihood[n];
+        max = likelihood;
         max_rank = (int)n;
         //           max_rank2 = max_rank1;
         //           max_rank1 = max_rank;
@@ -566,7 +727,6 @@ void vpMeSite::track(const vpImage<unsigned char> &I, const vpMe *me, const bool
     i_1 = ii_1; // list_query_pixels[max_rank].i ;
     j_1 = jj_1; // list_query_pixels[max_rank].j ;
     delete[] list_query_pixels;
-    delete[] likelihood;
   } else // none of the query sites is better than the threshold
   {
     if ((selectDisplay == RANGE_RESULT) || (selectDisplay == RESULT)) {
@@ -582,7 +742,6 @@ void vpMeSite::track(const vpImage<unsigned char> &I, const vpMe *me, const bool
       state = THRESHOLD; // threshold suppression
 
     delete[] list_query_pixels;
-    delete[] likelihood; // modif portage
   }
 }
 
@@ -0,0 +1,248 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Contiguous storage of moving edges sites.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpMeSiteBatch.cpp
+  \brief Contiguous storage of moving edges sites.
+*/
+
+#include <cmath>  // std::fabs
+#include <limits> // numeric_limits
+
+#include <visp3/me/vpMeSiteBatch.h>
+
+/*!
+  Default constructor that builds an empty batch.
+*/
+vpMeSiteBatch::vpMeSiteBatch()
+  : m_i(), m_j(), m_i_1(), m_j_1(), m_ifloat(), m_jfloat(), m_v(), m_mask_sign(), m_alpha(), m_convlt(),
+    m_normGradient(), m_weight(), m_state(), m_queryI(), m_queryJ(), m_queryIfloat(), m_queryJfloat(), m_convolution()
+{
+}
+
+/*!
+  Remove all the sites. The memory is kept to be reused by the next sites.
+*/
+void vpMeSiteBatch::clear()
+{
+  m_i.clear();
+  m_j.clear();
+  m_i_1.clear();
+  m_j_1.clear();
+  m_ifloat.clear();
+  m_jfloat.clear();
+  m_v.clear();
+  m_mask_sign.clear();
+  m_alpha.clear();
+  m_convlt.clear();
+  m_normGradient.clear();
+  m_weight.clear();
+  m_state.clear();
+}
+
+/*!
+  Reserve memory for n sites.
+
+  \param n : Number of sites.
+*/
+void vpMeSiteBatch::reserve(const unsigned int n)
+{
+  m_i.reserve(n);
+  m_j.reserve(n);
+  m_i_1.reserve(n);
+  m_j_1.reserve(n);
+  m_ifloat.reserve(n);
+  m_jfloat.reserve(n);
+  m_v.reserve(n);
+  m_mask_sign.reserve(n);
+  m_alpha.reserve(n);
+  m_convlt.reserve(n);
+  m_normGradient.reserve(n);
+  m_weight.reserve(n);
+  m_state.reserve(n);
+}
+
+/*!
+  Append a copy of a site to the batch.
+
+  \param site : Site to add.
+*/
+void vpMeSiteBatch::push_back(const vpMeSite &site)
+{
+  m_i.push_back(site.i);
+  m_j.push_back(site.j);
+  m_i_1.push_back(site.i_1);
+  m_j_1.push_back(site.j_1);
+  m_ifloat.push_back(site.ifloat);
+  m_jfloat.push_back(site.jfloat);
+  m_v.push_back(site.v);
+  m_mask_sign.push_back(site.mask_sign);
+  m_alpha.push_back(site.alpha);
+  m_convlt.push_back(site.convlt);
+  m_normGradient.push_back(site.normGradient);
+  m_weight.push_back(site.weight);
+  m_state.push_back(site.getState());
+}
+
+/*!
+  Copy the components of a site of the batch into a vpMeSite, typically the
+  one that was given to push_back(), once track() has been called.
+
+  \param index : Index of the site in [0, size()-1].
+  \param site : Site to update.
+*/
+void vpMeSiteBatch::updateSite(const unsigned int index, vpMeSite &site) const
+{
+  site.i = m_i[index];
+  site.j = m_j[index];
+  site.i_1 = m_i_1[index];
+  site.j_1 = m_j_1[index];
+  site.ifloat = m_ifloat[index];
+  site.jfloat = m_jfloat[index];
+  site.v = m_v[index];
+  site.mask_sign = m_mask_sign[index];
+  site.alpha = m_alpha[index];
+  site.convlt = m_convlt[index];
+  site.normGradient = m_normGradient[index];
+  site.weight = m_weight[index];
+  site.setState(m_state[index]);
+}
+
+/*!
+  Track all the sites of the batch that are not suppressed. Each of them is
+  processed as vpMeSite::track() would do: the 2*range+1 query locations
+  along the normal are convolved at once with vpMeSite::convolution(), and
+  the site is moved to the location of maximum likelihood or suppressed.
+
+  \param I : Image in which the sites are tracked.
+  \param me : Moving edges settings.
+  \param test_contraste : When true, the contrast of the edge has to be
+  similar to the one of the previous image.
+*/
+void vpMeSiteBatch::track(const vpImage<unsigned char> &I, const vpMe *me, const bool test_contraste)
+{
+  unsigned int nbQuery = 2 * me->getRange() + 1;
+  m_queryI.resize(nbQuery);
+  m_queryJ.resize(nbQuery);
+  m_queryIfloat.resize(nbQuery);
+  m_queryJfloat.resize(nbQuery);
+  m_convolution.resize(nbQuery);
+
+  for (unsigned int index = 0; index < size(); index++) {
+    if (m_state[index] == vpMeSite::NO_SUPPRESSION) {
+      trackSite(I, me, index, test_contraste);
+    }
+  }
+}
+
+void vpMeSiteBatch::trackSite(const vpImage<unsigned char> &I, const vpMe *me, const unsigned int index,
+                              const bool test_contraste)
+{
+  // Query locations along the normal, see vpMeSite::getQueryList()
+  int range = static_cast<int>(me->getRange());
+  double salpha = sin(m_alpha[index]);
+  double calpha = cos(m_alpha[index]);
+  unsigned int n = 0;
+  for (int k = -range; k <= range; k++, n++) {
+    double ii = (m_ifloat[index] + k * salpha);
+    double jj = (m_jfloat[index] + k * calpha);
+    m_queryIfloat[n] = ii;
+    m_queryJfloat[n] = jj;
+    m_queryI[n] = (int)ii;
+    m_queryJ[n] = (int)jj;
+  }
+
+  unsigned int nbQuery = n;
+  vpMeSite::convolution(I, me, m_alpha[index], m_mask_sign[index], &m_queryI[0], &m_queryJ[0], nbQuery,
+                        &m_convolution[0]);
+
+  // Maximum likelihood search, see vpMeSite::track()
+  double convlt = m_convlt[index];
+  double contraste_max = 1 + me->getMu2();
+  double contraste_min = 1 - me->getMu1();
+  double threshold = me->getThreshold();
+  double diff = 1e6;
+  double contraste = 0;
+  double max_convolution = 0;
+  double max = 0;
+  int max_rank = -1;
+
+  for (n = 0; n < nbQuery; n++) {
+    double convolution_ = m_convolution[n];
+    if (test_contraste) {
+      double likelihood = fabs(convolution_ + convlt);
+      if (likelihood > threshold) {
+        contraste = convolution_ / convlt;
+        if ((contraste > contraste_min) && (contraste < contraste_max) && fabs(1 - contraste) < diff) {
+          diff = fabs(1 - contraste);
+          max_convolution = convolution_;
+          max = likelihood;
+          max_rank = (int)n;
+        }
+      }
+    } else {
+      double likelihood = fabs(2 * convolution_);
+      if (likelihood > max && likelihood > threshold) {
+        max_convolution = convolution_;
+        max = likelihood;
+        max_rank = (int)n;
+      }
+    }
+  }
+
+  if (max_rank >= 0) {
+    // The site is replaced by the query site of max likelihood
+    m_i_1[index] = m_i[index];
+    m_j_1[index] = m_j[index];
+    m_i[index] = m_queryI[max_rank];
+    m_j[index] = m_queryJ[max_rank];
+    m_ifloat[index] = m_queryIfloat[max_rank];
+    m_jfloat[index] = m_queryJfloat[max_rank];
+    m_v[index] = 0;
+    m_normGradient[index] = vpMath::sqr(max_convolution);
+    m_convlt[index] = max_convolution;
+    m_weight[index] = 1;
+    m_state[index] = vpMeSite::NO_SUPPRESSION;
+  } else {
+    // none of the query sites is better than the threshold
+    m_i_1[index] = m_i[index];
+    m_j_1[index] = m_j[index];
+    m_normGradient[index] = 0;
+    if (std::fabs(contraste) > std::numeric_limits<double>::epsilon())
+      m_state[index] = vpMeSite::CONSTRAST; // contrast suppression
+    else
+      m_state[index] = vpMeSite::THRESHOLD; // threshold suppression
+  }
+}
@@ -60,7 +60,7 @@ void vpMeTracker::init()
 }
 
 vpMeTracker::vpMeTracker()
-  : list(), me(NULL), init_range(1), nGoodElement(0), m_mask(NULL), selectDisplay(vpMeSite::NONE)
+  : list(), me(NULL), init_range(1), nGoodElement(0), m_mask(NULL), selectDisplay(vpMeSite::NONE), m_siteBatch()
 #ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
     ,
     query_range(0), display_point(false)
@@ -70,7 +70,8 @@ vpMeTracker::vpMeTracker()
 }
 
 vpMeTracker::vpMeTracker(const vpMeTracker &meTracker)
-  : vpTracker(meTracker), list(), me(NULL), init_range(1), nGoodElement(0), m_mask(NULL), selectDisplay(vpMeSite::NONE)
+  : vpTracker(meTracker), list(), me(NULL), init_range(1), nGoodElement(0), m_mask(NULL),
+    selectDisplay(vpMeSite::NONE), m_siteBatch()
 #ifdef VISP_BUILD_DEPRECATED_FUNCTIONS
     ,
     query_range(0), display_point(false)
@@ -261,7 +262,21 @@ void vpMeTracker::track(const vpImage<unsigned char> &I)
 
   nGoodElement = 0;
 
+  // Without display, all the sites are tracked in a single pass from a
+  // contiguous copy
+  bool batch = (selectDisplay == vpMeSite::NONE);
+  if (batch) {
+    m_siteBatch.clear();
+    for (std::list<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
+      if (it->getState() == vpMeSite::NO_SUPPRESSION) {
+        m_siteBatch.push_back(*it);
+      }
+    }
+    m_siteBatch.track(I, me, true);
+  }
+
   // Loop through list of sites to track
+  unsigned int index = 0;
   std::list<vpMeSite>::iterator it = list.begin();
   while (it != list.end()) {
     vpMeSite s = *it; // current reference pixel
@@ -269,12 +284,16 @@ void vpMeTracker::track(const vpImage<unsigned char> &I)
     // If element hasn't been suppressed
     if (s.getState() == vpMeSite::NO_SUPPRESSION) {
 
-      try {
-        s.track(I, me, true);
-      } catch (...) {
-        s.setState(vpMeSite::THRESHOLD);
+      if (batch) {
+        m_siteBatch.updateSite(index++, s);
+      } else {
+        try {
+          s.track(I, me, true);
+        } catch (...) {
+          s.setState(vpMeSite::THRESHOLD);
+        }
       }
-      
+
       if (vpMeTracker::inMask(m_mask, s.i, s.j)) {
         if (s.getState() != vpMeSite::THRESHOLD) {
           nGoodElement++;
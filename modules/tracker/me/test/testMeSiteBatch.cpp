@@ -0,0 +1,139 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test moving edges sites batch tracking.
+ *
+ *****************************************************************************/
+/*!
+  \example testMeSiteBatch.cpp
+
+  \brief Check that tracking sites with vpMeSiteBatch gives the same result
+  than vpMeSite::track().
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/me/vpMe.h>
+#include <visp3/me/vpMeSite.h>
+#include <visp3/me/vpMeSiteBatch.h>
+
+namespace
+{
+bool equal(const vpMeSite &s1, const vpMeSite &s2)
+{
+  const double eps = std::numeric_limits<double>::epsilon();
+  return s1.i == s2.i && s1.j == s2.j && s1.i_1 == s2.i_1 && s1.j_1 == s2.j_1 &&
+         vpMath::equal(s1.ifloat, s2.ifloat, eps) && vpMath::equal(s1.jfloat, s2.jfloat, eps) && s1.v == s2.v &&
+         s1.mask_sign == s2.mask_sign && vpMath::equal(s1.alpha, s2.alpha, eps) &&
+         vpMath::equal(s1.convlt, s2.convlt, eps) && vpMath::equal(s1.normGradient, s2.normGradient, eps) &&
+         vpMath::equal(s1.weight, s2.weight, eps) && s1.getState() == s2.getState();
+}
+} // namespace
+
+int main()
+{
+  // Smoothed random image to get edges of various contrasts
+  vpUniRand rng;
+  vpImage<unsigned char> I_rand(240, 320);
+  for (unsigned int i = 0; i < I_rand.getSize(); i++) {
+    I_rand.bitmap[i] = static_cast<unsigned char>(rng.uniform(0, 256));
+  }
+  vpImage<double> I_blur;
+  vpImageFilter::gaussianBlur(I_rand, I_blur, 7);
+  vpImage<unsigned char> I(I_blur.getHeight(), I_blur.getWidth());
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = static_cast<unsigned char>(vpMath::saturate<unsigned char>(2 * (I_blur.bitmap[i] - 128) + 128));
+  }
+
+  vpMe me;
+  me.setRange(6);
+  me.setThreshold(500);
+
+  std::vector<vpMeSite> sites;
+  for (unsigned int cpt = 0; cpt < 2000; cpt++) {
+    vpMeSite site;
+    // Some sites are drawn close to the image border on purpose
+    site.init(rng.uniform(-5.0, I.getHeight() + 5.0), rng.uniform(-5.0, I.getWidth() + 5.0),
+              rng.uniform(-M_PI, M_PI), rng.uniform(-3000.0, 3000.0), rng.uniform(0.0, 1.0) < 0.5 ? -1 : 1);
+    if (cpt % 10 == 0) {
+      site.setState(vpMeSite::CONSTRAST);
+    }
+    sites.push_back(site);
+  }
+
+  for (int test_contraste = 0; test_contraste < 2; test_contraste++) {
+    vpMeSiteBatch batch;
+    for (size_t k = 0; k < sites.size(); k++) {
+      batch.push_back(sites[k]);
+    }
+    double t_batch = vpTime::measureTimeMs();
+    batch.track(I, &me, test_contraste != 0);
+    t_batch = vpTime::measureTimeMs() - t_batch;
+
+    std::vector<vpMeSite> sites_ref = sites;
+    double t_ref = vpTime::measureTimeMs();
+    for (size_t k = 0; k < sites_ref.size(); k++) {
+      if (sites_ref[k].getState() == vpMeSite::NO_SUPPRESSION) {
+        sites_ref[k].track(I, &me, test_contraste != 0);
+      }
+    }
+    t_ref = vpTime::measureTimeMs() - t_ref;
+
+    unsigned int nb_tracked = 0;
+    for (size_t k = 0; k < sites.size(); k++) {
+      vpMeSite site = sites[k];
+      batch.updateSite(static_cast<unsigned int>(k), site);
+      if (!equal(site, sites_ref[k])) {
+        std::cerr << "Site " << k << " differs: batch (" << site.i << ", " << site.j << ", " << site.getState()
+                  << ") vpMeSite::track() (" << sites_ref[k].i << ", " << sites_ref[k].j << ", "
+                  << sites_ref[k].getState() << ")" << std::endl;
+        return EXIT_FAILURE;
+      }
+      if (site.getState() == vpMeSite::NO_SUPPRESSION) {
+        nb_tracked++;
+      }
+    }
+    std::cout << "test_contraste=" << test_contraste << ": " << nb_tracked << " sites tracked, batch: " << t_batch
+              << " ms, vpMeSite::track(): " << t_ref << " ms" << std::endl;
+  }
+
+  std::cout << "Test succeed" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,175 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test moving edges site convolution.
+ *
+ *****************************************************************************/
+/*!
+  \example testMeSiteConvolution.cpp
+
+  \brief Check that the fixed-point convolutions computed by vpMeSite give
+  the same result than a double-precision convolution with the vpMe masks,
+  also after modifying the masks and calling vpMe::updateFixedPointMask().
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/me/vpMe.h>
+#include <visp3/me/vpMeSite.h>
+
+namespace
+{
+// Reference implementation of vpMeSite::convolution() using the
+// double-precision masks
+double convolutionReference(const vpImage<unsigned char> &I, const vpMe &me, const vpMeSite &site)
+{
+  int half = (static_cast<int>(me.getMaskSize()) - 1) >> 1;
+  int height = static_cast<int>(I.getHeight());
+  int width = static_cast<int>(I.getWidth());
+  int border = half + me.getStrip();
+  if (site.i < border + 1 || site.i > height - border - 3 || site.j < border + 1 || site.j > width - border - 3) {
+    return 0.0;
+  }
+
+  double theta = site.alpha + M_PI / 2;
+  while (theta < 0)
+    theta += M_PI;
+  while (theta > M_PI)
+    theta -= M_PI;
+  int thetadeg = vpMath::round(theta * 180 / M_PI);
+  if (abs(thetadeg) == 180) {
+    thetadeg = 0;
+  }
+  unsigned int index_mask = (unsigned int)(thetadeg / (double)me.getAngleStep());
+
+  double conv = 0.0;
+  for (unsigned int a = 0; a < me.getMaskSize(); a++) {
+    for (unsigned int b = 0; b < me.getMaskSize(); b++) {
+      conv += site.mask_sign * me.getMask()[index_mask][a][b] *
+              I(static_cast<unsigned int>(site.i - half) + a, static_cast<unsigned int>(site.j - half) + b);
+    }
+  }
+
+  return conv;
+}
+
+bool runTest(const vpImage<unsigned char> &I, unsigned int mask_size, unsigned int range, bool editMasks = false)
+{
+  vpMe me;
+  me.setMaskSize(mask_size);
+  me.setRange(range);
+  if (editMasks) {
+    // Masks modified through getMask() are used once their fixed-point copy
+    // is updated
+    vpMatrix *mask = me.getMask();
+    for (unsigned int k = 0; k < me.getMaskNumber(); k++) {
+      for (unsigned int a = 0; a < mask_size; a++) {
+        for (unsigned int b = 0; b < mask_size; b++) {
+          mask[k][a][b] = static_cast<double>((static_cast<int>(k + 3 * a + 7 * b) % 41) - 20);
+        }
+      }
+    }
+    me.updateFixedPointMask();
+  }
+
+  vpUniRand rng;
+  unsigned int nbSites = 2 * range + 1;
+  double *conv = new double[nbSites];
+  bool success = true;
+  for (unsigned int cpt = 0; cpt < 1000 && success; cpt++) {
+    vpMeSite site;
+    // Some sites are drawn close to the image border on purpose
+    site.init(rng.uniform(-5.0, I.getHeight() + 5.0), rng.uniform(-5.0, I.getWidth() + 5.0),
+              rng.uniform(-M_PI, M_PI), 0, rng.uniform(0.0, 1.0) < 0.5 ? -1 : 1);
+
+    vpMeSite *list = site.getQueryList(I, static_cast<int>(range));
+    vpMeSite::convolution(I, &me, list, nbSites, conv);
+    for (unsigned int n = 0; n < nbSites; n++) {
+      vpMeSite query;
+      query.init(site.ifloat + (static_cast<int>(n) - static_cast<int>(range)) * sin(site.alpha),
+                 site.jfloat + (static_cast<int>(n) - static_cast<int>(range)) * cos(site.alpha), site.alpha, 0,
+                 site.mask_sign);
+      double conv_ref = convolutionReference(I, me, query);
+      double conv_single = query.convolution(I, &me);
+      if (!vpMath::equal(conv[n], conv_ref, 1e-9) || !vpMath::equal(conv_single, conv_ref, 1e-9)) {
+        std::cerr << "Mask size " << mask_size << ", site (" << query.ifloat << ", " << query.jfloat
+                  << "): batch=" << conv[n] << " single=" << conv_single << " reference=" << conv_ref << std::endl;
+        success = false;
+      }
+    }
+    delete[] list;
+  }
+  delete[] conv;
+
+  return success;
+}
+} // namespace
+
+int main()
+{
+  vpUniRand rng;
+  vpImage<unsigned char> I(240, 320);
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = static_cast<unsigned char>(rng.uniform(0, 256));
+  }
+
+  unsigned int mask_sizes[] = {3, 5, 7, 9, 11};
+  for (unsigned int k = 0; k < sizeof(mask_sizes) / sizeof(mask_sizes[0]); k++) {
+    if (!runTest(I, mask_sizes[k], 6)) {
+      std::cerr << "Test failed with a mask of size " << mask_sizes[k] << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (!runTest(I, 7, 6, true)) {
+    std::cerr << "Test failed with modified masks" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Rough timing of the moving edges tracking
+  vpMe me;
+  double t = vpTime::measureTimeMs();
+  for (unsigned int cpt = 0; cpt < 10000; cpt++) {
+    vpMeSite site;
+    site.init(rng.uniform(20.0, I.getHeight() - 20.0), rng.uniform(20.0, I.getWidth() - 20.0),
+              rng.uniform(-M_PI, M_PI), 1000, 1);
+    site.track(I, &me, false);
+  }
+  std::cout << "10000 vpMeSite::track(): " << vpTime::measureTimeMs() - t << " ms" << std::endl;
+
+  std::cout << "Test succeed" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -45,9 +45,12 @@
 #ifndef vpTemplateTracker_hh
 #define vpTemplateTracker_hh
 
+#include <map>
 #include <math.h>
+#include <vector>
 
 #include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpImagePyramid.h>
 #include <visp3/tt/vpTemplateTrackerHeader.h>
 #include <visp3/tt/vpTemplateTrackerWarp.h>
 #include <visp3/tt/vpTemplateTrackerZone.h>
@@ -143,6 +146,27 @@ protected:
   vpImage<double> dIy;
   vpTemplateTrackerZone zoneRef_; // Reference zone
 
+  // Coordinates of the template points, and the same points warped by
+  // warpTemplate() with their intensity set by getWarpedIntensities()
+  std::vector<double> templateU;
+  std::vector<double> templateV;
+  std::vector<double> warpedU;
+  std::vector<double> warpedV;
+  std::vector<double> warpedIntensity;
+  std::vector<unsigned char> warpedInside;
+  // Contiguous storage of the dW and HiG vectors of the template points of
+  // each pyramid level, indexed by the array of points they belong to
+  std::map<const vpTemplateTrackerPoint *, std::vector<double> > templateData;
+  // Pyramid of the current image, reused from one frame to the next
+  vpImagePyramid pyr_I;
+  // Blurred images and gradients set by a vpTemplateTrackerGroup while it
+  // tracks, and whether BI and dIx, dIy currently point to them
+  const std::vector<vpTemplateTrackerFilteredImage> *sharedImages;
+  bool sharedBlur;
+  bool sharedGradients;
+
+  friend class vpTemplateTrackerGroup;
+
 public:
   //! Default constructor.
   vpTemplateTracker()
@@ -155,7 +179,8 @@ public:
       useBrent(false), nbIterBrent(0), taillef(0), fgG(NULL), fgdG(NULL), ratioPixelIn(0), mod_i(0), mod_j(0),
       nbParam(), lambdaDep(0), iterationMax(0), iterationGlobale(0), diverge(false), nbIteration(0),
       useCompositionnal(false), useInverse(false), Warp(NULL), p(), dp(), X1(), X2(), dW(), BI(), dIx(), dIy(),
-      zoneRef_()
+      zoneRef_(), templateU(), templateV(), warpedU(), warpedV(), warpedIntensity(), warpedInside(), templateData(),
+      pyr_I(), sharedImages(NULL), sharedBlur(false), sharedGradients(false)
   {
   }
   explicit vpTemplateTracker(vpTemplateTrackerWarp *_warp);
@@ -266,6 +291,7 @@ public:
   void setUseBrent(bool b) { useBrent = b; }
 
   void track(const vpImage<unsigned char> &I);
+  void track(const vpImagePyramid &pyramid);
   void trackRobust(const vpImage<unsigned char> &I);
 
 #if defined(VISP_BUILD_DEPRECATED_FUNCTIONS)
@@ -286,15 +312,23 @@ protected:
   void computeEvalRMS(const vpColVector &p);
   void computeOptimalBrentGain(const vpImage<unsigned char> &I, vpColVector &tp, double tMI, vpColVector &direction,
                                double &alpha);
+  void computeTemplateHessian(vpMatrix &Hessian, const bool *select) const;
   virtual double getCost(const vpImage<unsigned char> &I, const vpColVector &tp) = 0;
-  void getGaussianBluredImage(const vpImage<unsigned char> &I) { vpImageFilter::filter(I, BI, fgG, taillef); }
+  void getWarpedIntensities(const vpImage<unsigned char> &I);
+  void getGaussianBluredImage(const vpImage<unsigned char> &I);
+  void getGaussianGradients(const vpImage<unsigned char> &I);
+  const vpTemplateTrackerFilteredImage *getSharedImage(const vpImage<unsigned char> &I) const;
   virtual void initHessienDesired(const vpImage<unsigned char> &I) = 0;
   virtual void initHessienDesiredPyr(const vpImage<unsigned char> &I);
   void initPosEvalRMS(const vpColVector &p);
+  void initTemplateData(unsigned int dWSize, unsigned int HiGSize = 0, unsigned int dWCompoSize = 0);
   virtual void initPyramidal(unsigned int nbLvl, unsigned int l0);
   void initTracking(const vpImage<unsigned char> &I, vpTemplateTrackerZone &zone);
   virtual void initTrackingPyr(const vpImage<unsigned char> &I, vpTemplateTrackerZone &zone);
+  void releaseSharedImages();
   virtual void trackNoPyr(const vpImage<unsigned char> &I) = 0;
+  void warpTemplate(const vpColVector &tp, const bool *select = NULL);
   virtual void trackPyr(const vpImage<unsigned char> &I);
+  void trackPyrLevels(const std::vector<const vpImage<unsigned char> *> &pyramid);
 };
 #endif
@@ -0,0 +1,188 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Group of template trackers sharing the preprocessing of the frames.
+ *
+ *****************************************************************************/
+/*!
+ \file vpTemplateTrackerGroup.h
+ \brief Group of template trackers sharing the preprocessing of the frames.
+*/
+
+#ifndef vpTemplateTrackerGroup_hh
+#define vpTemplateTrackerGroup_hh
+
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpImagePyramid.h>
+#include <visp3/tt/vpTemplateTracker.h>
+
+/*!
+  \class vpTemplateTrackerGroup
+  \ingroup group_tt_tracker
+
+  Track several templates in the same images.
+
+  For each new image, the group computes once the pyramid of the image, and
+  for each pyramid level and each Gaussian filter size used by its trackers
+  the blurred image and the gradients that the trackers would otherwise
+  compute each on their own. The gradients are only computed for the levels
+  used by a forward additional, forward compositional or ESM tracker, since
+  the inverse compositional trackers do not need them. These computations
+  are shared between the threads of vpThreadPool, and the trackers are then
+  run in parallel, so that the time spent on a frame becomes close to the
+  preprocessing time plus the time of the slowest tracker.
+
+  The failure of a tracker does not stop the others: the exception it throws
+  is caught, and hasFailed() and getFailureMessage() report it until the
+  next call to track(). Its parameters are left as the tracker left them,
+  and it is up to the caller to reinitialize it. The group also measures
+  the time spent on each frame, on the preprocessing and by each tracker.
+
+  The trackers must be initialized before they are added, and remain owned
+  by the caller. Since they run concurrently, each of them must have its own
+  warp. They use the pyramid built by vpImagePyramid with its
+  GAUSSIAN_FILTER, exactly as if they were tracked with
+  vpTemplateTracker::track(const vpImagePyramid &). A tracker must not be
+  part of two groups tracking at the same time.
+
+  \code
+#include <visp3/tt/vpTemplateTrackerGroup.h>
+#include <visp3/tt/vpTemplateTrackerSSDInverseCompositional.h>
+#include <visp3/tt/vpTemplateTrackerWarpHomography.h>
+
+int main()
+{
+  vpImage<unsigned char> I;
+  std::vector<std::vector<vpImagePoint> > patches;
+  // Acquire I and select the corners of the patches...
+
+  std::vector<vpTemplateTrackerWarpHomography> warps(patches.size());
+  std::vector<vpTemplateTrackerSSDInverseCompositional *> trackers;
+  vpTemplateTrackerGroup group;
+  for (size_t k = 0; k < patches.size(); k++) {
+    trackers.push_back(new vpTemplateTrackerSSDInverseCompositional(&warps[k]));
+    trackers.back()->setPyramidal(2, 1);
+    trackers.back()->initFromPoints(I, patches[k]);
+    group.addTracker(trackers.back());
+  }
+
+  while (true) {
+    // Acquire a new image I...
+    group.track(I);
+    for (unsigned int k = 0; k < group.getNbTrackers(); k++) {
+      if (!group.hasFailed(k)) {
+        vpColVector p = trackers[k]->getp();
+      }
+    }
+  }
+
+  for (size_t k = 0; k < trackers.size(); k++)
+    delete trackers[k];
+}
+  \endcode
+*/
+class VISP_EXPORT vpTemplateTrackerGroup
+{
+public:
+  vpTemplateTrackerGroup();
+  virtual ~vpTemplateTrackerGroup();
+
+  unsigned int addTracker(vpTemplateTracker *tracker);
+  void clear();
+
+  std::string getFailureMessage(unsigned int index) const;
+  /*!
+    Return the mean time in ms spent on a frame by track() since the
+    creation of the group or the last call to resetTimes().
+   */
+  double getMeanTime() const { return m_nbFrames ? m_cumulatedTime / m_nbFrames : 0.; }
+  unsigned int getNbFailures(unsigned int index) const;
+  /*!
+    Return the number of frames processed by track() since the creation of
+    the group or the last call to resetTimes().
+   */
+  unsigned int getNbFrames() const { return m_nbFrames; }
+  //! Return the number of trackers of the group.
+  unsigned int getNbTrackers() const { return static_cast<unsigned int>(m_trackers.size()); }
+  /*!
+    Return the time in ms spent by the last call to track() to build the
+    pyramid, blur the images and compute their gradients.
+   */
+  double getPreprocessingTime() const { return m_preprocessingTime; }
+  /*!
+    Return the time in ms spent by the last call to track().
+   */
+  double getTime() const { return m_time; }
+  vpTemplateTracker *getTracker(unsigned int index) const;
+  double getTrackingTime(unsigned int index) const;
+  bool hasFailed(unsigned int index) const;
+
+  void resetTimes();
+
+  bool track(const vpImage<unsigned char> &I);
+
+private:
+  vpTemplateTrackerGroup(const vpTemplateTrackerGroup &);
+  vpTemplateTrackerGroup &operator=(const vpTemplateTrackerGroup &);
+
+  void checkIndex(unsigned int index) const;
+  void preprocess(const vpImage<unsigned char> &I);
+  void trackOne(unsigned int index);
+
+  void filterOne(unsigned int task);
+
+  class FilterBody;
+  class TrackBody;
+
+  std::vector<vpTemplateTracker *> m_trackers;
+  std::vector<unsigned char> m_failed;
+  std::vector<std::string> m_failureMessages;
+  std::vector<unsigned int> m_nbFailures;
+  std::vector<double> m_trackingTimes;
+
+  vpImagePyramid m_pyramid;
+  std::vector<const vpImage<unsigned char> *> m_levels;
+  std::vector<vpTemplateTrackerFilteredImage> m_images;
+  // Gaussian and derivative kernels of the filter of each shared image
+  std::vector<const double *> m_kernels;
+  std::vector<const double *> m_derivativeKernels;
+  // Shared image and kind (0 blur, 1 and 2 gradients) of each filtering task
+  std::vector<unsigned int> m_taskImages;
+  std::vector<unsigned int> m_taskKinds;
+
+  double m_preprocessingTime;
+  double m_time;
+  double m_cumulatedTime;
+  unsigned int m_nbFrames;
+};
+#endif
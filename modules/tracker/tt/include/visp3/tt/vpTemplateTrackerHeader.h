@@ -47,6 +47,8 @@
 
 #include <stdio.h>
 
+#include <visp3/core/vpImage.h>
+
 /*!
   \struct vpTemplateTrackerZPoint
   \ingroup group_tt_tools
@@ -68,6 +70,10 @@ struct vpTemplateTrackerDPoint {
 /*!
   \struct vpTemplateTrackerPoint
   \ingroup group_tt_tools
+
+  Point of the reference template. The dW and HiG vectors of the points of
+  a template are stored one after the other in a single block of memory
+  owned by the tracker.
 */
 struct vpTemplateTrackerPoint {
   int x, y;
@@ -101,6 +107,22 @@ struct vpTemplateTrackerPointSuppMIInv {
   {
   }
 };
+
+// Blurred image and gradients of an image computed once with the Gaussian
+// filter of a given size for all the trackers of a vpTemplateTrackerGroup
+struct vpTemplateTrackerFilteredImage {
+  const vpImage<unsigned char> *I;
+  unsigned int filterSize;
+  bool hasBlur;
+  bool hasGradients;
+  vpImage<double> BI;
+  vpImage<double> dIx;
+  vpImage<double> dIy;
+  vpTemplateTrackerFilteredImage()
+    : I(NULL), filterSize(0), hasBlur(false), hasGradients(false), BI(), dIx(), dIy()
+  {
+  }
+};
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
 #endif
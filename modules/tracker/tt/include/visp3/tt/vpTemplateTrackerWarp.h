@@ -195,14 +195,19 @@ public:
   /*!
     Warp a list of points.
 
+    The default implementation calls computeDenom() and warpX() for each
+    point. The affine, rotation-translation, SRT, translation and homography
+    warps map the whole list in one call, which is how the template trackers
+    warp their template at each iteration.
+
     \param ut0 : List of u coordinates of the points.
     \param vt0 : List of v coordinates of the points.
     \param nb_pt : Number of points to consider.
     \param p : Parameters of the warp.
-    \param u : Resulting u coordinates.
-    \param v : resulting v coordinates.
+    \param u : Resulting u coordinates. It may be \e ut0.
+    \param v : resulting v coordinates. It may be \e vt0.
   */
-  void warp(const double *ut0, const double *vt0, int nb_pt, const vpColVector &p, double *u, double *v);
+  virtual void warp(const double *ut0, const double *vt0, int nb_pt, const vpColVector &p, double *u, double *v);
 
   /*!
     Warp a point.
@@ -252,6 +257,9 @@ public:
     vpTemplateTracker::getp(). \param out : Resulting zone.
   */
   void warpZone(const vpTemplateTrackerZone &in, const vpColVector &p, vpTemplateTrackerZone &out);
+
+protected:
+  static void warpAffine(const double *ut0, const double *vt0, int nb_pt, const double *M, double *u, double *v);
 };
 
 #endif
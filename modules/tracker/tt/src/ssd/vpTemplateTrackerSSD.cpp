@@ -60,24 +60,12 @@ double vpTemplateTrackerSSD::getCost(const vpImage<unsigned char> &I, const vpCo
   double IW;
   int Nbpoint = 0;
 
-  Warp->computeCoeff(tp);
+  warpTemplate(tp);
+  getWarpedIntensities(I);
   for (unsigned int point = 0; point < templateSize; point++) {
-    int i = ptTemplate[point].y;
-    int j = ptTemplate[point].x;
-    X1[0] = j;
-    X1[1] = i;
-    Warp->computeDenom(X1, tp);
-    Warp->warpX(X1, X2, tp);
-
-    double j2 = X2[0];
-    double i2 = X2[1];
-    if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
+    if (warpedInside[point]) {
       double Tij = ptTemplate[point].val;
-      if (!blur)
-        IW = I.getValue(i2, j2);
-      else
-        IW = BI.getValue(i2, j2);
-      // IW=getSubPixBspline4(I,i2,j2);
+      IW = warpedIntensity[point];
       erreur += (Tij - IW) * (Tij - IW);
       Nbpoint++;
     }
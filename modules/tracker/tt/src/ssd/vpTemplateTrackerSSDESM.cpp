@@ -64,28 +64,22 @@ void vpTemplateTrackerSSDESM::initHessienDesired(const vpImage<unsigned char> &I
 void vpTemplateTrackerSSDESM::initCompInverse(const vpImage<unsigned char> & /*I*/)
 {
   ptTemplateCompo = new vpTemplateTrackerPointCompo[templateSize];
+  initTemplateData(nbParam, 0, 2 * nbParam);
   int i, j;
   // direct
   for (unsigned int point = 0; point < templateSize; point++) {
     i = ptTemplate[point].y;
     j = ptTemplate[point].x;
-    ptTemplateCompo[point].dW = new double[2 * nbParam];
     Warp->getdWdp0(i, j, ptTemplateCompo[point].dW);
   }
 
   // inverse
-  HInv = 0;
   for (unsigned int point = 0; point < templateSize; point++) {
     i = ptTemplate[point].y;
     j = ptTemplate[point].x;
-
-    ptTemplate[point].dW = new double[nbParam];
     Warp->getdW0(i, j, ptTemplate[point].dy, ptTemplate[point].dx, ptTemplate[point].dW);
-
-    for (unsigned int it = 0; it < nbParam; it++)
-      for (unsigned int jt = 0; jt < nbParam; jt++)
-        HInv[it][jt] += ptTemplate[point].dW[it] * ptTemplate[point].dW[jt];
   }
+  computeTemplateHessian(HInv, NULL);
   vpMatrix::computeHLM(HInv, lambdaDep, HLMInv);
 
   compoInitialised = true;
@@ -94,14 +88,12 @@ void vpTemplateTrackerSSDESM::initCompInverse(const vpImage<unsigned char> & /*I
 void vpTemplateTrackerSSDESM::trackNoPyr(const vpImage<unsigned char> &I)
 {
   if (blur)
-    vpImageFilter::filter(I, BI, fgG, taillef);
-  vpImageFilter::getGradXGauss2D(I, dIx, fgG, fgdG, taillef);
-  vpImageFilter::getGradYGauss2D(I, dIy, fgG, fgdG, taillef);
+    getGaussianBluredImage(I);
+  getGaussianGradients(I);
 
   double IW, dIWx, dIWy;
   double Tij;
   unsigned int iteration = 0;
-  int i, j;
   double i2, j2;
   double alpha = 2.;
 
@@ -118,25 +110,18 @@ void vpTemplateTrackerSSDESM::trackNoPyr(const vpImage<unsigned char> &I)
     HDir = 0;
     GDir = 0;
     GInv = 0;
-    Warp->computeCoeff(p);
+    warpTemplate(p);
+    getWarpedIntensities(I);
     for (unsigned int point = 0; point < templateSize; point++) {
-      i = ptTemplate[point].y;
-      j = ptTemplate[point].x;
-      X1[0] = j;
-      X1[1] = i;
-
-      Warp->computeDenom(X1, p);
-      Warp->warpX(X1, X2, p);
+      if (warpedInside[point]) {
+        X1[0] = templateU[point];
+        X1[1] = templateV[point];
+        X2[0] = j2 = warpedU[point];
+        X2[1] = i2 = warpedV[point];
 
-      j2 = X2[0];
-      i2 = X2[1];
-      if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
         // INVERSE
         Tij = ptTemplate[point].val;
-        if (!blur)
-          IW = I.getValue(i2, j2);
-        else
-          IW = BI.getValue(i2, j2);
+        IW = warpedIntensity[point];
         Nbpoint++;
         double er = (Tij - IW);
         for (unsigned int it = 0; it < nbParam; it++)
@@ -148,6 +133,7 @@ void vpTemplateTrackerSSDESM::trackNoPyr(const vpImage<unsigned char> &I)
         dIWy = dIy.getValue(i2, j2) + ptTemplate[point].dy;
 
         // Calcul du Hessien
+        Warp->computeDenom(X1, p);
         Warp->dWarpCompo(X1, X2, p, ptTemplateCompo[point].dW, dW);
 
         double *tempt = new double[nbParam];
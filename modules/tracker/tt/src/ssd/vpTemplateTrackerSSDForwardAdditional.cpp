@@ -52,9 +52,8 @@ vpTemplateTrackerSSDForwardAdditional::vpTemplateTrackerSSDForwardAdditional(vpT
 void vpTemplateTrackerSSDForwardAdditional::trackNoPyr(const vpImage<unsigned char> &I)
 {
   if (blur)
-    vpImageFilter::filter(I, BI, fgG, taillef);
-  vpImageFilter::getGradXGauss2D(I, dIx, fgG, fgdG, taillef);
-  vpImageFilter::getGradYGauss2D(I, dIy, fgG, fgdG, taillef);
+    getGaussianBluredImage(I);
+  getGaussianGradients(I);
 
   dW = 0;
 
@@ -62,7 +61,6 @@ void vpTemplateTrackerSSDForwardAdditional::trackNoPyr(const vpImage<unsigned ch
   double IW, dIWx, dIWy;
   double Tij;
   unsigned int iteration = 0;
-  int i, j;
   double i2, j2;
   double alpha = 2.;
 
@@ -77,30 +75,24 @@ void vpTemplateTrackerSSDForwardAdditional::trackNoPyr(const vpImage<unsigned ch
     double erreur = 0;
     G = 0;
     H = 0;
-    Warp->computeCoeff(p);
+    warpTemplate(p);
+    getWarpedIntensities(I);
     for (unsigned int point = 0; point < templateSize; point++) {
-      i = ptTemplate[point].y;
-      j = ptTemplate[point].x;
-      X1[0] = j;
-      X1[1] = i;
+      if (warpedInside[point]) {
+        X1[0] = templateU[point];
+        X1[1] = templateV[point];
+        X2[0] = j2 = warpedU[point];
+        X2[1] = i2 = warpedV[point];
 
-      Warp->computeDenom(X1, p);
-      Warp->warpX(X1, X2, p);
-
-      j2 = X2[0];
-      i2 = X2[1];
-      if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
         Tij = ptTemplate[point].val;
 
-        if (!blur)
-          IW = I.getValue(i2, j2);
-        else
-          IW = BI.getValue(i2, j2);
+        IW = warpedIntensity[point];
 
         dIWx = dIx.getValue(i2, j2);
         dIWy = dIy.getValue(i2, j2);
         Nbpoint++;
         // Calcul du Hessien
+        Warp->computeDenom(X1, p);
         Warp->dWarp(X1, X2, p, dW);
         double *tempt = new double[nbParam];
         for (unsigned int it = 0; it < nbParam; it++)
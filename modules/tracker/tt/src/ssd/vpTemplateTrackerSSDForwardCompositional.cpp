@@ -47,10 +47,10 @@ vpTemplateTrackerSSDForwardCompositional::vpTemplateTrackerSSDForwardComposition
 
 void vpTemplateTrackerSSDForwardCompositional::initCompo(const vpImage<unsigned char> & /*I*/)
 {
+  initTemplateData(2 * nbParam);
   for (unsigned int point = 0; point < templateSize; point++) {
     int i = ptTemplate[point].y;
     int j = ptTemplate[point].x;
-    ptTemplate[point].dW = new double[2 * nbParam];
     X1[0] = j;
     X1[1] = i;
     Warp->computeDenom(X1, p);
@@ -68,10 +68,9 @@ void vpTemplateTrackerSSDForwardCompositional::trackNoPyr(const vpImage<unsigned
   }
 
   if (blur) {
-    vpImageFilter::filter(I, BI, fgG, taillef);
+    getGaussianBluredImage(I);
   }
-  vpImageFilter::getGradXGauss2D(I, dIx, fgG, fgdG, taillef);
-  vpImageFilter::getGradYGauss2D(I, dIy, fgG, fgdG, taillef);
+  getGaussianGradients(I);
 
   dW = 0;
 
@@ -79,7 +78,6 @@ void vpTemplateTrackerSSDForwardCompositional::trackNoPyr(const vpImage<unsigned
   double IW, dIWx, dIWy;
   double Tij;
   unsigned int iteration = 0;
-  int i, j;
   double i2, j2;
   double alpha = 2.;
 
@@ -94,28 +92,22 @@ void vpTemplateTrackerSSDForwardCompositional::trackNoPyr(const vpImage<unsigned
     double erreur = 0;
     G = 0;
     H = 0;
-    Warp->computeCoeff(p);
+    warpTemplate(p);
+    getWarpedIntensities(I);
     for (unsigned int point = 0; point < templateSize; point++) {
-      i = ptTemplate[point].y;
-      j = ptTemplate[point].x;
-      X1[0] = j;
-      X1[1] = i;
+      if (warpedInside[point]) {
+        X1[0] = templateU[point];
+        X1[1] = templateV[point];
+        X2[0] = j2 = warpedU[point];
+        X2[1] = i2 = warpedV[point];
 
-      Warp->computeDenom(X1, p);
-      Warp->warpX(X1, X2, p);
-
-      j2 = X2[0];
-      i2 = X2[1];
-      if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
         Tij = ptTemplate[point].val;
-        if (!blur)
-          IW = I.getValue(i2, j2);
-        else
-          IW = BI.getValue(i2, j2);
+        IW = warpedIntensity[point];
         dIWx = dIx.getValue(i2, j2);
         dIWy = dIy.getValue(i2, j2);
         Nbpoint++;
 
+        Warp->computeDenom(X1, p);
         Warp->dWarpCompo(X1, X2, p, ptTemplate[point].dW, dW);
 
         double *tempt = new double[nbParam];
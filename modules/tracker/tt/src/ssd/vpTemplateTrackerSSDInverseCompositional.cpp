@@ -50,28 +50,23 @@ vpTemplateTrackerSSDInverseCompositional::vpTemplateTrackerSSDInverseComposition
 
 void vpTemplateTrackerSSDInverseCompositional::initCompInverse(const vpImage<unsigned char> & /*I*/)
 {
-  H = 0;
-  int i, j;
+  initTemplateData(nbParam, nbParam);
+  const bool *select = useTemplateSelect ? ptTemplateSelect : NULL;
 
   for (unsigned int point = 0; point < templateSize; point++) {
     if ((!useTemplateSelect) || (ptTemplateSelect[point])) {
-      i = ptTemplate[point].y;
-      j = ptTemplate[point].x;
-      ptTemplate[point].dW = new double[nbParam];
-
-      Warp->getdW0(i, j, ptTemplate[point].dy, ptTemplate[point].dx, ptTemplate[point].dW);
-
-      for (unsigned int it = 0; it < nbParam; it++)
-        for (unsigned int jt = 0; jt < nbParam; jt++)
-          H[it][jt] += ptTemplate[point].dW[it] * ptTemplate[point].dW[jt];
+      Warp->getdW0(ptTemplate[point].y, ptTemplate[point].x, ptTemplate[point].dy, ptTemplate[point].dx,
+                   ptTemplate[point].dW);
     }
   }
+  computeTemplateHessian(H, select);
   HInv = H;
   vpMatrix HLMtemp(nbParam, nbParam);
   vpMatrix::computeHLM(H, lambdaDep, HLMtemp);
 
   HCompInverse.resize(nbParam, nbParam);
   HCompInverse = HLMtemp.inverseByLU();
+  const vpMatrix minusHCompInverse = -HCompInverse;
   vpColVector dWtemp(nbParam);
   vpColVector HiGtemp(nbParam);
 
@@ -80,8 +75,7 @@ void vpTemplateTrackerSSDInverseCompositional::initCompInverse(const vpImage<uns
       for (unsigned int it = 0; it < nbParam; it++)
         dWtemp[it] = ptTemplate[point].dW[it];
 
-      HiGtemp = - HCompInverse * dWtemp;
-      ptTemplate[point].HiG = new double[nbParam];
+      vpMatrix::multMatrixVector(minusHCompInverse, dWtemp, HiGtemp);
 
       for (unsigned int it = 0; it < nbParam; it++)
         ptTemplate[point].HiG[it] = HiGtemp[it];
@@ -98,14 +92,12 @@ void vpTemplateTrackerSSDInverseCompositional::initHessienDesired(const vpImage<
 void vpTemplateTrackerSSDInverseCompositional::trackNoPyr(const vpImage<unsigned char> &I)
 {
   if (blur)
-    vpImageFilter::filter(I, BI, fgG, taillef);
+    getGaussianBluredImage(I);
 
   vpColVector dpinv(nbParam);
   double IW;
   double Tij;
   unsigned int iteration = 0;
-  int i, j;
-  double i2, j2;
   double alpha = 2.;
   initPosEvalRMS(p);
 
@@ -119,25 +111,15 @@ void vpTemplateTrackerSSDInverseCompositional::trackNoPyr(const vpImage<unsigned
     unsigned int Nbpoint = 0;
     double erreur = 0;
     dp = 0;
-    Warp->computeCoeff(p);
+    warpTemplate(p, useTemplateSelect ? ptTemplateSelect : NULL);
+    getWarpedIntensities(I);
     for (unsigned int point = 0; point < templateSize; point++) {
       if ((!useTemplateSelect) || (ptTemplateSelect[point])) {
         pt = &ptTemplate[point];
-        i = pt->y;
-        j = pt->x;
-        X1[0] = j;
-        X1[1] = i;
-        Warp->computeDenom(X1, p);
-        Warp->warpX(X1, X2, p);
-        j2 = X2[0];
-        i2 = X2[1];
-
-        if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
+
+        if (warpedInside[point]) {
           Tij = pt->val;
-          if (!blur)
-            IW = I.getValue(i2, j2);
-          else
-            IW = BI.getValue(i2, j2);
+          IW = warpedIntensity[point];
           Nbpoint++;
           double er = (Tij - IW);
           for (unsigned int it = 0; it < nbParam; it++)
@@ -38,9 +38,17 @@
  *
  *****************************************************************************/
 
+#include <algorithm>
+
+#include <visp3/core/vpCPUFeatures.h>
 #include <visp3/tt/vpTemplateTracker.h>
 #include <visp3/tt/vpTemplateTrackerBSpline.h>
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
 vpTemplateTracker::vpTemplateTracker(vpTemplateTrackerWarp *_warp)
   : nbLvlPyr(1), l0Pyr(0), pyrInitialised(false), evolRMS(0), x_pos(), y_pos(),
     evolRMS_eps(1e-4), ptTemplate(NULL), ptTemplatePyr(NULL), ptTemplateInit(false),
@@ -51,7 +59,9 @@ vpTemplateTracker::vpTemplateTracker(vpTemplateTrackerWarp *_warp)
     gain(1.), thresholdGradient(40), costFunctionVerification(false), blur(true), useBrent(false), nbIterBrent(3),
     taillef(7), fgG(NULL), fgdG(NULL), ratioPixelIn(0), mod_i(1), mod_j(1), nbParam(0), lambdaDep(0.001),
     iterationMax(30), iterationGlobale(0), diverge(false), nbIteration(0), useCompositionnal(true), useInverse(false),
-    Warp(_warp), p(0), dp(), X1(), X2(), dW(), BI(), dIx(), dIy(), zoneRef_()
+    Warp(_warp), p(0), dp(), X1(), X2(), dW(), BI(), dIx(), dIy(), zoneRef_(), templateU(), templateV(),
+    warpedU(), warpedV(), warpedIntensity(), warpedInside(), templateData(), pyr_I(), sharedImages(NULL),
+    sharedBlur(false), sharedGradients(false)
 {
   nbParam = Warp->getNbParam();
   p.resize(nbParam);
@@ -117,8 +127,7 @@ void vpTemplateTracker::initTracking(const vpImage<unsigned char> &I, vpTemplate
   // vpTemplateTrackerZPoint ptZ;
   vpImage<double> GaussI;
   vpImageFilter::filter(I, GaussI, fgG, taillef);
-  vpImageFilter::getGradXGauss2D(I, dIx, fgG, fgdG, taillef);
-  vpImageFilter::getGradYGauss2D(I, dIy, fgG, fgdG, taillef);
+  getGaussianGradients(I);
 
   unsigned int cpt_point = 0;
   templateSelectSize = 0;
@@ -187,10 +196,6 @@ void vpTemplateTracker::resetTracker()
     if (ptTemplatePyr) {
       for (unsigned int i = 0; i < nbLvlPyr; i++) {
         if (ptTemplatePyr[i]) {
-          for (unsigned int point = 0; point < templateSizePyr[i]; point++) {
-            delete[] ptTemplatePyr[i][point].dW;
-            delete[] ptTemplatePyr[i][point].HiG;
-          }
           delete[] ptTemplatePyr[i];
         }
       }
@@ -201,9 +206,6 @@ void vpTemplateTracker::resetTracker()
     if (ptTemplateCompoPyr) {
       for (unsigned int i = 0; i < nbLvlPyr; i++) {
         if (ptTemplateCompoPyr[i]) {
-          for (unsigned int point = 0; point < templateSizePyr[i]; point++) {
-            delete[] ptTemplateCompoPyr[i][point].dW;
-          }
           delete[] ptTemplateCompoPyr[i];
         }
       }
@@ -269,18 +271,11 @@ void vpTemplateTracker::resetTracker()
     }
   } else {
     if (ptTemplateInit) {
-      for (unsigned int point = 0; point < templateSize; point++) {
-        delete[] ptTemplate[point].dW;
-        delete[] ptTemplate[point].HiG;
-      }
       delete[] ptTemplate;
       ptTemplate = NULL;
       ptTemplateInit = false;
     }
     if (ptTemplateCompo) {
-      for (unsigned int point = 0; point < templateSize; point++) {
-        delete[] ptTemplateCompo[point].dW;
-      }
       delete[] ptTemplateCompo;
       ptTemplateCompo = NULL;
     }
@@ -303,6 +298,7 @@ void vpTemplateTracker::resetTracker()
       }
     }
   }
+  templateData.clear();
 }
 
 /*!
@@ -617,6 +613,9 @@ void vpTemplateTracker::initTrackingPyr(const vpImage<unsigned char> &I, vpTempl
   zoneTrackedPyr[0].copy(zone);
   // vpTRACE("fin copy zone");
 
+  // The levels of the reference image are built as the ones of the tracked
+  // images, by vpImagePyramid
+  vpImagePyramid pyramid(I, nbLvlPyr, vpImagePyramid::GAUSSIAN_FILTER);
   pyr_IDes[0] = I;
   initTracking(pyr_IDes[0], zoneTrackedPyr[0]);
   ptTemplatePyr[0] = ptTemplate;
@@ -627,7 +626,7 @@ void vpTemplateTracker::initTrackingPyr(const vpImage<unsigned char> &I, vpTempl
   if (nbLvlPyr > 1) {
     for (unsigned int i = 1; i < nbLvlPyr; i++) {
       zoneTrackedPyr[i] = zoneTrackedPyr[i - 1].getPyramidDown();
-      vpImageFilter::getGaussPyramidal(pyr_IDes[i - 1], pyr_IDes[i]);
+      pyr_IDes[i] = pyramid.getLevel(i);
 
       initTracking(pyr_IDes[i], zoneTrackedPyr[i]);
       ptTemplatePyr[i] = ptTemplate;
@@ -758,10 +757,9 @@ void vpTemplateTracker::initHessienDesiredPyr(const vpImage<unsigned char> &I)
   }
 
   if (nbLvlPyr > 1) {
-    vpImage<unsigned char> Itemp;
-    Itemp = I;
+    vpImagePyramid pyramid(I, nbLvlPyr, vpImagePyramid::GAUSSIAN_FILTER);
     for (unsigned int i = 1; i < nbLvlPyr; i++) {
-      vpImageFilter::getGaussPyramidal(Itemp, Itemp);
+      const vpImage<unsigned char> &Itemp = pyramid.getLevel(i);
 
       templateSize = templateSizePyr[i];
       ptTemplate = ptTemplatePyr[i];
@@ -800,100 +798,144 @@ void vpTemplateTracker::track(const vpImage<unsigned char> &I)
     trackNoPyr(I);
 }
 
+/*!
+   Track the template on an image pyramid built once for the current frame,
+   for example shared with other trackers. The reference template and
+   track(const vpImage<unsigned char> &) use pyramids built by vpImagePyramid
+   with vpImagePyramid::GAUSSIAN_FILTER: with such a pyramid of \e I, the
+   result is exactly the one of track(I).
+   \param pyramid: Pyramid of the image to process, with at least as many
+   levels as set with setPyramidal().
+ */
+void vpTemplateTracker::track(const vpImagePyramid &pyramid)
+{
+  if (pyramid.getNbLevels() < std::max(nbLvlPyr, 1u)) {
+    throw(vpTrackingException(vpTrackingException::badValue,
+                              "The image pyramid has %u levels while the tracker uses %u levels",
+                              pyramid.getNbLevels(), nbLvlPyr));
+  }
+  if (nbLvlPyr <= 1) {
+    trackNoPyr(pyramid.getLevel(0));
+    return;
+  }
+
+  std::vector<const vpImage<unsigned char> *> levels(nbLvlPyr);
+  for (unsigned int i = 0; i < nbLvlPyr; i++) {
+    levels[i] = &pyramid.getLevel(i);
+  }
+  try {
+    trackPyrLevels(levels);
+  } catch (const vpException &e) {
+    throw(vpTrackingException(vpTrackingException::badValue, e.getMessage()));
+  }
+}
+
 void vpTemplateTracker::trackPyr(const vpImage<unsigned char> &I)
 {
   // vpTRACE("trackPyr");
-  vpImage<unsigned char> *pyr_I;
-  //  pyr_I=new vpImage<unsigned char>[nbLvlPyr+1]; // Why +1 ?
-  pyr_I = new vpImage<unsigned char>[nbLvlPyr]; // Why +1 ?
-  pyr_I[0] = I;
-
   try {
-    vpColVector ptemp(nbParam);
-    if (nbLvlPyr > 1) {
-      //    vpColVector *p_sauv=new vpColVector[nbLvlPyr];
-      //    for(unsigned int i=0;i<nbLvlPyr;i++)p_sauv[i].resize(nbParam);
-
-      //    p_sauv[0]=p;
-      for (unsigned int i = 1; i < nbLvlPyr; i++) {
-        vpImageFilter::getGaussPyramidal(pyr_I[i - 1], pyr_I[i]);
-        // test getParamPyramidDown
-        /*vpColVector vX_test(2);vX_test[0]=15.;vX_test[1]=30.;
-        vpColVector vX_test2(2);
-        Warp->computeCoeff(p);
-        Warp->computeDenom(vX_test,p);
-        Warp->warpX(vX_test,vX_test2,p);
-        std::cout<<"p = "<<p.t()<<std::endl;*/
-        // std::cout<<"get p down"<<std::endl;
-        Warp->getParamPyramidDown(p, ptemp);
-        p = ptemp;
-        zoneTracked = &zoneTrackedPyr[i];
-
-        //      p_sauv[i]=p;
-        /*std::cout<<"p_down = "<<p.t()<<std::endl;
-
-        vpColVector vX_testd(2);vX_testd[0]=15./2.;vX_testd[1]=30./2.;
-        vpColVector vX_testd2(2);
-        Warp->computeCoeff(p);
-        Warp->computeDenom(vX_testd,p);
-        Warp->warpX(vX_testd,vX_testd2,p);
-        std::cout<<2.*vX_testd2[0]<<","<<2.*vX_testd2[1]<<" <=>
-        "<<vX_test2[0]<<","<<vX_test2[1]<<std::endl;*/
-      }
+    // The levels are kept in pyr_I so that their memory is reused from one
+    // frame to the next; the full resolution level is the image itself
+    pyr_I.build(I, nbLvlPyr, vpImagePyramid::GAUSSIAN_FILTER);
+    std::vector<const vpImage<unsigned char> *> pyramid(nbLvlPyr);
+    pyramid[0] = &I;
+    for (unsigned int i = 1; i < nbLvlPyr; i++) {
+      pyramid[i] = &pyr_I.getLevel(i);
+    }
+    trackPyrLevels(pyramid);
+  } catch (const vpException &e) {
+    throw(vpTrackingException(vpTrackingException::badValue, e.getMessage()));
+  }
+}
 
-      for (int i = (int)nbLvlPyr - 1; i >= 0; i--) {
-        if (i >= (int)l0Pyr) {
-          templateSize = templateSizePyr[i];
-          ptTemplate = ptTemplatePyr[i];
-          ptTemplateSelect = ptTemplateSelectPyr[i];
-          ptTemplateSupp = ptTemplateSuppPyr[i];
-          ptTemplateCompo = ptTemplateCompoPyr[i];
-          H = HdesirePyr[i];
-          HLM = HLMdesirePyr[i];
-          HLMdesireInverse = HLMdesireInversePyr[i];
-          //        zoneTracked=&zoneTrackedPyr[i];
-          trackRobust(pyr_I[i]);
-        }
-        // std::cout<<"get p up"<<std::endl;
-        //      ptemp=p_sauv[i-1];
-        if (i > 0) {
-          Warp->getParamPyramidUp(p, ptemp);
-          p = ptemp;
-          zoneTracked = &zoneTrackedPyr[i - 1];
-        }
+/*!
+  Track the template from the coarsest to the finest level of a pyramid of
+  images.
+  \param pyramid : Images of the levels, starting with the full resolution
+  one. It must have at least as many levels as the tracker.
+ */
+void vpTemplateTracker::trackPyrLevels(const std::vector<const vpImage<unsigned char> *> &pyramid)
+{
+  const vpImage<unsigned char> &I = *pyramid[0];
+  vpColVector ptemp(nbParam);
+  if (nbLvlPyr > 1) {
+    //    vpColVector *p_sauv=new vpColVector[nbLvlPyr];
+    //    for(unsigned int i=0;i<nbLvlPyr;i++)p_sauv[i].resize(nbParam);
+
+    //    p_sauv[0]=p;
+    for (unsigned int i = 1; i < nbLvlPyr; i++) {
+      // test getParamPyramidDown
+      /*vpColVector vX_test(2);vX_test[0]=15.;vX_test[1]=30.;
+      vpColVector vX_test2(2);
+      Warp->computeCoeff(p);
+      Warp->computeDenom(vX_test,p);
+      Warp->warpX(vX_test,vX_test2,p);
+      std::cout<<"p = "<<p.t()<<std::endl;*/
+      // std::cout<<"get p down"<<std::endl;
+      Warp->getParamPyramidDown(p, ptemp);
+      p = ptemp;
+      zoneTracked = &zoneTrackedPyr[i];
+
+      //      p_sauv[i]=p;
+      /*std::cout<<"p_down = "<<p.t()<<std::endl;
+
+      vpColVector vX_testd(2);vX_testd[0]=15./2.;vX_testd[1]=30./2.;
+      vpColVector vX_testd2(2);
+      Warp->computeCoeff(p);
+      Warp->computeDenom(vX_testd,p);
+      Warp->warpX(vX_testd,vX_testd2,p);
+      std::cout<<2.*vX_testd2[0]<<","<<2.*vX_testd2[1]<<" <=>
+      "<<vX_test2[0]<<","<<vX_test2[1]<<std::endl;*/
+    }
+
+    for (int i = (int)nbLvlPyr - 1; i >= 0; i--) {
+      if (i >= (int)l0Pyr) {
+        templateSize = templateSizePyr[i];
+        ptTemplate = ptTemplatePyr[i];
+        ptTemplateSelect = ptTemplateSelectPyr[i];
+        ptTemplateSupp = ptTemplateSuppPyr[i];
+        ptTemplateCompo = ptTemplateCompoPyr[i];
+        H = HdesirePyr[i];
+        HLM = HLMdesirePyr[i];
+        HLMdesireInverse = HLMdesireInversePyr[i];
+        //        zoneTracked=&zoneTrackedPyr[i];
+        trackRobust(*pyramid[(unsigned int)i]);
       }
+      // std::cout<<"get p up"<<std::endl;
+      //      ptemp=p_sauv[i-1];
+      if (i > 0) {
+        Warp->getParamPyramidUp(p, ptemp);
+        p = ptemp;
+        zoneTracked = &zoneTrackedPyr[i - 1];
+      }
+    }
 #if 0
-        if(l0Pyr==0)
-        {
-          templateSize=templateSizePyr[0];
-          ptTemplate=ptTemplatePyr[0];
-          ptTemplateSelect=ptTemplateSelectPyr[0];
-          ptTemplateSupp=ptTemplateSuppPyr[0];
-          ptTemplateCompo=ptTemplateCompoPyr[0];
-          H=HdesirePyr[0];
-          HLM=HLMdesirePyr[0];
-          HLMdesireInverse=HLMdesireInversePyr[0];
-          zoneTracked=&zoneTrackedPyr[0];
-          trackRobust(pyr_I[0]);
-        }
+      if(l0Pyr==0)
+      {
+        templateSize=templateSizePyr[0];
+        ptTemplate=ptTemplatePyr[0];
+        ptTemplateSelect=ptTemplateSelectPyr[0];
+        ptTemplateSupp=ptTemplateSuppPyr[0];
+        ptTemplateCompo=ptTemplateCompoPyr[0];
+        H=HdesirePyr[0];
+        HLM=HLMdesirePyr[0];
+        HLMdesireInverse=HLMdesireInversePyr[0];
+        zoneTracked=&zoneTrackedPyr[0];
+        trackRobust(pyr_I[0]);
+      }
 
-        if (l0Pyr > 0) {
-    //      for (int l=(int)l0Pyr; l >=0; l--) {
-    //        Warp->getParamPyramidUp(p,ptemp);
-    //        p=ptemp;
-    //      }
-          zoneTracked=&zoneTrackedPyr[0];
-        }
+      if (l0Pyr > 0) {
+  //      for (int l=(int)l0Pyr; l >=0; l--) {
+  //        Warp->getParamPyramidUp(p,ptemp);
+  //        p=ptemp;
+  //      }
+        zoneTracked=&zoneTrackedPyr[0];
+      }
 #endif
-      //    delete [] p_sauv;
-    } else {
-      // std::cout<<"reviens a tracker de base"<<std::endl;
-      trackRobust(I);
-    }
-    delete[] pyr_I;
-  } catch (const vpException &e) {
-    delete[] pyr_I;
-    throw(vpTrackingException(vpTrackingException::badValue, e.getMessage()));
+    //    delete [] p_sauv;
+  } else {
+    // std::cout<<"reviens a tracker de base"<<std::endl;
+    trackRobust(I);
   }
 }
 
@@ -977,3 +1019,290 @@ void vpTemplateTracker::initPosEvalRMS(const vpColVector &p)
     }
   }
 }
+
+/*!
+  Warp the points of the current template with the parameters \e tp in one
+  call to vpTemplateTrackerWarp::warp(). The warped coordinates of the point
+  \e k are warpedU[k] (along the columns) and warpedV[k] (along the rows).
+
+  \param tp : Parameters of the warping function.
+  \param select : If not NULL, only the points \e k for which select[k] is
+  true are warped, as the per point warps did before. The other ones are
+  set to (-1, -1), outside the image, and are never given to the warp.
+*/
+void vpTemplateTracker::warpTemplate(const vpColVector &tp, const bool *select)
+{
+  templateU.resize(templateSize);
+  templateV.resize(templateSize);
+  warpedU.resize(templateSize);
+  warpedV.resize(templateSize);
+  if (templateSize == 0) {
+    return;
+  }
+
+  for (unsigned int point = 0; point < templateSize; point++) {
+    templateU[point] = ptTemplate[point].x;
+    templateV[point] = ptTemplate[point].y;
+  }
+  if (select == NULL) {
+    Warp->warp(&templateU[0], &templateV[0], static_cast<int>(templateSize), tp, &warpedU[0], &warpedV[0]);
+    return;
+  }
+
+  // Warp the selected points packed at the beginning of warpedU and warpedV,
+  // then move them back to their index, starting from the last one
+  unsigned int nbSelected = 0;
+  for (unsigned int point = 0; point < templateSize; point++) {
+    if (select[point]) {
+      warpedU[nbSelected] = templateU[point];
+      warpedV[nbSelected] = templateV[point];
+      nbSelected++;
+    }
+  }
+  if (nbSelected > 0) {
+    Warp->warp(&warpedU[0], &warpedV[0], static_cast<int>(nbSelected), tp, &warpedU[0], &warpedV[0]);
+  }
+  for (unsigned int point = templateSize; point-- > 0;) {
+    if (select[point]) {
+      nbSelected--;
+      warpedU[point] = warpedU[nbSelected];
+      warpedV[point] = warpedV[nbSelected];
+    } else {
+      warpedU[point] = -1.;
+      warpedV[point] = -1.;
+    }
+  }
+}
+
+/*!
+  Interpolate the intensity of the image at the template points warped by
+  warpTemplate(): BI when the image is blurred, \e I otherwise.
+
+  warpedInside[k] is set to 1 when the point \e k is inside the image, and
+  warpedIntensity[k] is then the value that vpImage::getValue(double, double)
+  returns at this point.
+
+  \param I : Current image.
+*/
+void vpTemplateTracker::getWarpedIntensities(const vpImage<unsigned char> &I)
+{
+  warpedIntensity.resize(warpedU.size());
+  warpedInside.resize(warpedU.size());
+
+  const double height_1 = I.getHeight() - 1, width_1 = I.getWidth() - 1;
+  for (size_t point = 0; point < warpedU.size(); point++) {
+    const double i2 = warpedV[point], j2 = warpedU[point];
+    warpedInside[point] = (i2 >= 0) && (j2 >= 0) && (i2 < height_1) && (j2 < width_1);
+  }
+
+  if (blur) {
+    const unsigned int width = BI.getWidth();
+    for (size_t point = 0; point < warpedU.size(); point++) {
+      if (!warpedInside[point]) {
+        continue;
+      }
+      const double i2 = warpedV[point], j2 = warpedU[point];
+      const unsigned int iround = static_cast<unsigned int>(floor(i2));
+      const unsigned int jround = static_cast<unsigned int>(floor(j2));
+      const double rratio = i2 - static_cast<double>(iround), cratio = j2 - static_cast<double>(jround);
+      const double rfrac = 1.0 - rratio, cfrac = 1.0 - cratio;
+      const double *up = BI.bitmap + iround * width + jround;
+      const double *down = up + width;
+      warpedIntensity[point] = (up[0] * rfrac + down[0] * rratio) * cfrac + (up[1] * rfrac + down[1] * rratio) * cratio;
+    }
+  } else {
+    // Fixed-point interpolation on 16 bits
+    const unsigned int width = I.getWidth();
+    for (size_t point = 0; point < warpedU.size(); point++) {
+      if (!warpedInside[point]) {
+        continue;
+      }
+      const int64_t y = static_cast<int64_t>(warpedV[point] * (1 << 16));
+      const int64_t x = static_cast<int64_t>(warpedU[point] * (1 << 16));
+      const int64_t rratio = y & 0xFFFF, cratio = x & 0xFFFF;
+      const int64_t rfrac = (1 << 16) - rratio, cfrac = (1 << 16) - cratio;
+      const unsigned char *up = I.bitmap + (y >> 16) * width + (x >> 16);
+      const unsigned char *down = up + width;
+      warpedIntensity[point] = static_cast<unsigned char>(
+          ((up[0] * rfrac + down[0] * rratio) * cfrac + (up[1] * rfrac + down[1] * rratio) * cratio) >> 32);
+    }
+  }
+}
+
+/*!
+  Allocate in a single block of memory the vectors of the current template
+  points: ptTemplate[k].dW with \e dWSize values, ptTemplate[k].HiG with \e
+  HiGSize values and, when ptTemplateCompo is allocated,
+  ptTemplateCompo[k].dW with \e dWCompoSize values. A size of 0 leaves the
+  corresponding pointers unchanged.
+
+  The vectors of the same kind follow each other point after point, so that
+  the dW vectors form a templateSize x dWSize row-major matrix. The block is
+  set to zero and released by resetTracker().
+
+  \param dWSize : Size of the dW vectors.
+  \param HiGSize : Size of the HiG vectors.
+  \param dWCompoSize : Size of the dW vectors of the compositional points.
+*/
+void vpTemplateTracker::initTemplateData(unsigned int dWSize, unsigned int HiGSize, unsigned int dWCompoSize)
+{
+  if (ptTemplateCompo == NULL) {
+    dWCompoSize = 0;
+  }
+  std::vector<double> &data = templateData[ptTemplate];
+  data.assign(static_cast<size_t>(templateSize) * (dWSize + HiGSize + dWCompoSize), 0.);
+  if (data.empty()) {
+    return;
+  }
+
+  double *dWData = &data[0];
+  double *HiGData = dWData + static_cast<size_t>(templateSize) * dWSize;
+  double *dWCompoData = HiGData + static_cast<size_t>(templateSize) * HiGSize;
+  for (unsigned int point = 0; point < templateSize; point++) {
+    if (dWSize) {
+      ptTemplate[point].dW = dWData + static_cast<size_t>(point) * dWSize;
+    }
+    if (HiGSize) {
+      ptTemplate[point].HiG = HiGData + static_cast<size_t>(point) * HiGSize;
+    }
+    if (dWCompoSize) {
+      ptTemplateCompo[point].dW = dWCompoData + static_cast<size_t>(point) * dWCompoSize;
+    }
+  }
+}
+
+/*!
+  Compute the Gauss-Newton approximation of the Hessian from the dW vectors
+  of nbParam values of the current template points:
+  \f$ \sum_k dW_k \, dW_k^\top \f$.
+
+  \param Hessian : Resulting nbParam x nbParam matrix.
+  \param select : When not NULL, only the points \e k with select[k] set to
+  true are taken into account.
+*/
+void vpTemplateTracker::computeTemplateHessian(vpMatrix &Hessian, const bool *select) const
+{
+  Hessian.resize(nbParam, nbParam);
+  Hessian = 0;
+
+  // Accumulate the upper triangle only, the products being symmetric
+#if VISP_HAVE_SSE2
+  const bool useSSE2 = vpCPUFeatures::checkSSE2();
+#endif
+  for (unsigned int point = 0; point < templateSize; point++) {
+    if (select && !select[point]) {
+      continue;
+    }
+    const double *dWp = ptTemplate[point].dW;
+    for (unsigned int it = 0; it < nbParam; it++) {
+      double *row = Hessian[it];
+      unsigned int jt = it;
+#if VISP_HAVE_SSE2
+      if (useSSE2) {
+        const __m128d a = _mm_set1_pd(dWp[it]);
+        for (; jt + 2 <= nbParam; jt += 2) {
+          _mm_storeu_pd(row + jt, _mm_add_pd(_mm_loadu_pd(row + jt), _mm_mul_pd(a, _mm_loadu_pd(dWp + jt))));
+        }
+      }
+#endif
+      for (; jt < nbParam; jt++) {
+        row[jt] += dWp[it] * dWp[jt];
+      }
+    }
+  }
+
+  for (unsigned int it = 1; it < nbParam; it++) {
+    for (unsigned int jt = 0; jt < it; jt++) {
+      Hessian[it][jt] = Hessian[jt][it];
+    }
+  }
+}
+
+/*!
+  Return the blurred image and gradients of \e I computed with the Gaussian
+  filter of the tracker by the vpTemplateTrackerGroup that is tracking, or
+  NULL when they have not been shared.
+
+  \param I : Image being processed.
+*/
+const vpTemplateTrackerFilteredImage *vpTemplateTracker::getSharedImage(const vpImage<unsigned char> &I) const
+{
+  if (sharedImages == NULL) {
+    return NULL;
+  }
+  for (size_t k = 0; k < sharedImages->size(); k++) {
+    const vpTemplateTrackerFilteredImage &filtered = (*sharedImages)[k];
+    if (filtered.I == &I && filtered.filterSize == taillef) {
+      return &filtered;
+    }
+  }
+  return NULL;
+}
+
+/*!
+  Set BI to \e I blurred by the Gaussian filter of the tracker. When the
+  tracker belongs to a vpTemplateTrackerGroup that has already blurred this
+  image, BI points to the shared image instead of computing it again.
+
+  \param I : Image to blur.
+*/
+void vpTemplateTracker::getGaussianBluredImage(const vpImage<unsigned char> &I)
+{
+  const vpTemplateTrackerFilteredImage *filtered = getSharedImage(I);
+  if (filtered != NULL && filtered->hasBlur) {
+    BI.init(filtered->BI.bitmap, filtered->BI.getHeight(), filtered->BI.getWidth(), false);
+    sharedBlur = true;
+    return;
+  }
+
+  if (sharedBlur) {
+    // Do not write into the image of the group
+    BI.destroy();
+    sharedBlur = false;
+  }
+  vpImageFilter::filter(I, BI, fgG, taillef);
+}
+
+/*!
+  Set dIx and dIy to the gradients of \e I along the columns and the rows
+  computed with the Gaussian filter of the tracker, or point them to the
+  gradients shared by the vpTemplateTrackerGroup that is tracking.
+
+  \param I : Image to derivate.
+*/
+void vpTemplateTracker::getGaussianGradients(const vpImage<unsigned char> &I)
+{
+  const vpTemplateTrackerFilteredImage *filtered = getSharedImage(I);
+  if (filtered != NULL && filtered->hasGradients) {
+    dIx.init(filtered->dIx.bitmap, filtered->dIx.getHeight(), filtered->dIx.getWidth(), false);
+    dIy.init(filtered->dIy.bitmap, filtered->dIy.getHeight(), filtered->dIy.getWidth(), false);
+    sharedGradients = true;
+    return;
+  }
+
+  if (sharedGradients) {
+    dIx.destroy();
+    dIy.destroy();
+    sharedGradients = false;
+  }
+  vpImageFilter::getGradXGauss2D(I, dIx, fgG, fgdG, taillef);
+  vpImageFilter::getGradYGauss2D(I, dIy, fgG, fgdG, taillef);
+}
+
+/*!
+  Stop using the images shared by a vpTemplateTrackerGroup, so that the
+  tracker does not keep pointers to them once the group has tracked.
+*/
+void vpTemplateTracker::releaseSharedImages()
+{
+  sharedImages = NULL;
+  if (sharedBlur) {
+    BI.destroy();
+    sharedBlur = false;
+  }
+  if (sharedGradients) {
+    dIx.destroy();
+    dIy.destroy();
+    sharedGradients = false;
+  }
+}
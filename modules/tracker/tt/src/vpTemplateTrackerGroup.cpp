@@ -0,0 +1,362 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Group of template trackers sharing the preprocessing of the frames.
+ *
+ *****************************************************************************/
+
+#include <algorithm>
+
+#include <visp3/core/vpThreadPool.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/core/vpTrackingException.h>
+#include <visp3/tt/vpTemplateTrackerGroup.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+class vpTemplateTrackerGroup::FilterBody : public vpParallelForBody
+{
+public:
+  explicit FilterBody(vpTemplateTrackerGroup &group) : m_group(group) {}
+  void operator()(int begin, int end)
+  {
+    for (int task = begin; task < end; task++) {
+      m_group.filterOne(static_cast<unsigned int>(task));
+    }
+  }
+
+private:
+  vpTemplateTrackerGroup &m_group;
+};
+
+class vpTemplateTrackerGroup::TrackBody : public vpParallelForBody
+{
+public:
+  explicit TrackBody(vpTemplateTrackerGroup &group) : m_group(group) {}
+  void operator()(int begin, int end)
+  {
+    for (int index = begin; index < end; index++) {
+      m_group.trackOne(static_cast<unsigned int>(index));
+    }
+  }
+
+private:
+  vpTemplateTrackerGroup &m_group;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Default constructor: a group without trackers.
+*/
+vpTemplateTrackerGroup::vpTemplateTrackerGroup()
+  : m_trackers(), m_failed(), m_failureMessages(), m_nbFailures(), m_trackingTimes(), m_pyramid(), m_levels(),
+    m_images(), m_kernels(), m_derivativeKernels(), m_taskImages(), m_taskKinds(), m_preprocessingTime(0.),
+    m_time(0.), m_cumulatedTime(0.), m_nbFrames(0)
+{
+}
+
+/*!
+  Destructor. The trackers are not destroyed.
+*/
+vpTemplateTrackerGroup::~vpTemplateTrackerGroup() { clear(); }
+
+/*!
+  Add a tracker to the group.
+
+  \param tracker : Tracker already initialized on its reference template.
+  It is not copied and must remain valid while it belongs to the group.
+
+  \return The index of the tracker in the group.
+
+  \exception vpException::badValue : If \e tracker is NULL, already belongs
+  to the group or uses the same warp as another tracker of the group.
+*/
+unsigned int vpTemplateTrackerGroup::addTracker(vpTemplateTracker *tracker)
+{
+  if (tracker == NULL) {
+    throw(vpException(vpException::badValue, "Cannot add a NULL tracker to the group"));
+  }
+  for (size_t k = 0; k < m_trackers.size(); k++) {
+    if (m_trackers[k] == tracker) {
+      throw(vpException(vpException::badValue, "The tracker already belongs to the group"));
+    }
+    if (m_trackers[k]->getWarp() == tracker->getWarp()) {
+      throw(vpException(vpException::badValue, "The tracker uses the same warp as the tracker %u of the group",
+                        static_cast<unsigned int>(k)));
+    }
+  }
+
+  m_trackers.push_back(tracker);
+  m_failed.push_back(0);
+  m_failureMessages.push_back(std::string());
+  m_nbFailures.push_back(0);
+  m_trackingTimes.push_back(0.);
+  return static_cast<unsigned int>(m_trackers.size() - 1);
+}
+
+/*!
+  Remove all the trackers from the group, without destroying them.
+*/
+void vpTemplateTrackerGroup::clear()
+{
+  for (size_t k = 0; k < m_trackers.size(); k++) {
+    m_trackers[k]->releaseSharedImages();
+  }
+  m_trackers.clear();
+  m_failed.clear();
+  m_failureMessages.clear();
+  m_nbFailures.clear();
+  m_trackingTimes.clear();
+  m_images.clear();
+  m_levels.clear();
+}
+
+void vpTemplateTrackerGroup::checkIndex(unsigned int index) const
+{
+  if (index >= m_trackers.size()) {
+    throw(vpException(vpException::dimensionError, "Tracker %u does not exist in a group of %u trackers", index,
+                      getNbTrackers()));
+  }
+}
+
+/*!
+  Return the message of the exception thrown by the tracker \e index during
+  the last call to track(), or an empty string if it did not fail.
+*/
+std::string vpTemplateTrackerGroup::getFailureMessage(unsigned int index) const
+{
+  checkIndex(index);
+  return m_failureMessages[index];
+}
+
+/*!
+  Return the number of frames on which the tracker \e index failed since it
+  was added to the group.
+*/
+unsigned int vpTemplateTrackerGroup::getNbFailures(unsigned int index) const
+{
+  checkIndex(index);
+  return m_nbFailures[index];
+}
+
+/*!
+  Return the tracker \e index of the group.
+*/
+vpTemplateTracker *vpTemplateTrackerGroup::getTracker(unsigned int index) const
+{
+  checkIndex(index);
+  return m_trackers[index];
+}
+
+/*!
+  Return the time in ms spent by the tracker \e index during the last call
+  to track().
+*/
+double vpTemplateTrackerGroup::getTrackingTime(unsigned int index) const
+{
+  checkIndex(index);
+  return m_trackingTimes[index];
+}
+
+/*!
+  Return true if the tracker \e index threw an exception during the last
+  call to track().
+*/
+bool vpTemplateTrackerGroup::hasFailed(unsigned int index) const
+{
+  checkIndex(index);
+  return m_failed[index] != 0;
+}
+
+/*!
+  Reset the number of frames and the cumulated time used by getMeanTime().
+*/
+void vpTemplateTrackerGroup::resetTimes()
+{
+  m_cumulatedTime = 0.;
+  m_nbFrames = 0;
+}
+
+/*!
+  Track all the templates of the group in a new image.
+
+  \param I : Image to process.
+
+  \return true if all the trackers succeeded, false if at least one of them
+  failed.
+*/
+bool vpTemplateTrackerGroup::track(const vpImage<unsigned char> &I)
+{
+  const double t0 = vpTime::measureTimeMs();
+  preprocess(I);
+  m_preprocessingTime = vpTime::measureTimeMs() - t0;
+
+  for (size_t k = 0; k < m_trackers.size(); k++) {
+    m_trackers[k]->sharedImages = &m_images;
+  }
+  TrackBody body(*this);
+  vpThreadPool::instance().parallel_for(0, static_cast<int>(m_trackers.size()), body);
+
+  bool success = true;
+  for (size_t k = 0; k < m_trackers.size(); k++) {
+    m_trackers[k]->releaseSharedImages();
+    success = success && !m_failed[k];
+  }
+
+  m_time = vpTime::measureTimeMs() - t0;
+  m_cumulatedTime += m_time;
+  m_nbFrames++;
+  return success;
+}
+
+/*!
+  Build the pyramid of \e I, then blur its levels and compute their
+  gradients once for each Gaussian filter size used by the trackers.
+*/
+void vpTemplateTrackerGroup::preprocess(const vpImage<unsigned char> &I)
+{
+  unsigned int nbLevels = 1;
+  for (size_t k = 0; k < m_trackers.size(); k++) {
+    nbLevels = std::max(nbLevels, m_trackers[k]->nbLvlPyr);
+  }
+
+  m_levels.resize(1);
+  m_levels[0] = &I;
+  if (nbLevels > 1) {
+    m_pyramid.build(I, nbLevels, vpImagePyramid::GAUSSIAN_FILTER);
+    m_levels.resize(m_pyramid.getNbLevels());
+    for (unsigned int l = 0; l < m_pyramid.getNbLevels(); l++) {
+      m_levels[l] = &m_pyramid.getLevel(l);
+    }
+  }
+
+  // List the images to filter, reusing the ones of the previous frame
+  unsigned int nbImages = 0;
+  for (size_t k = 0; k < m_trackers.size(); k++) {
+    const vpTemplateTracker *tracker = m_trackers[k];
+    unsigned int first = 0, last = 0;
+    if (tracker->nbLvlPyr > 1) {
+      first = tracker->l0Pyr;
+      last = std::min(tracker->nbLvlPyr, static_cast<unsigned int>(m_levels.size())) - 1;
+    }
+    for (unsigned int l = first; l <= last; l++) {
+      unsigned int index = 0;
+      while (index < nbImages &&
+             (m_images[index].I != m_levels[l] || m_images[index].filterSize != tracker->taillef)) {
+        index++;
+      }
+      if (index == nbImages) {
+        if (nbImages == m_images.size()) {
+          m_images.resize(nbImages + 1);
+          m_kernels.resize(nbImages + 1);
+          m_derivativeKernels.resize(nbImages + 1);
+        }
+        m_images[index].I = m_levels[l];
+        m_images[index].filterSize = tracker->taillef;
+        m_images[index].hasBlur = false;
+        m_images[index].hasGradients = false;
+        m_kernels[index] = tracker->fgG;
+        m_derivativeKernels[index] = tracker->fgdG;
+        nbImages++;
+      }
+      m_images[index].hasBlur = m_images[index].hasBlur || tracker->blur || tracker->costFunctionVerification;
+      // Only the forward and ESM trackers compute the gradients of each frame
+      m_images[index].hasGradients = m_images[index].hasGradients || !tracker->useInverse;
+    }
+  }
+  m_images.resize(nbImages);
+
+  m_taskImages.clear();
+  m_taskKinds.clear();
+  for (unsigned int index = 0; index < nbImages; index++) {
+    if (m_images[index].hasBlur) {
+      m_taskImages.push_back(index);
+      m_taskKinds.push_back(0);
+    }
+    if (m_images[index].hasGradients) {
+      m_taskImages.push_back(index);
+      m_taskKinds.push_back(1);
+      m_taskImages.push_back(index);
+      m_taskKinds.push_back(2);
+    }
+  }
+
+  FilterBody body(*this);
+  vpThreadPool::instance().parallel_for(0, static_cast<int>(m_taskImages.size()), body);
+}
+
+void vpTemplateTrackerGroup::filterOne(unsigned int task)
+{
+  vpTemplateTrackerFilteredImage &filtered = m_images[m_taskImages[task]];
+  const double *fg = m_kernels[m_taskImages[task]];
+  const double *fgd = m_derivativeKernels[m_taskImages[task]];
+  switch (m_taskKinds[task]) {
+  case 0:
+    vpImageFilter::filter(*filtered.I, filtered.BI, fg, filtered.filterSize);
+    break;
+  case 1:
+    vpImageFilter::getGradXGauss2D(*filtered.I, filtered.dIx, fg, fgd, filtered.filterSize);
+    break;
+  default:
+    vpImageFilter::getGradYGauss2D(*filtered.I, filtered.dIy, fg, fgd, filtered.filterSize);
+    break;
+  }
+}
+
+void vpTemplateTrackerGroup::trackOne(unsigned int index)
+{
+  vpTemplateTracker *tracker = m_trackers[index];
+  const double t0 = vpTime::measureTimeMs();
+  m_failed[index] = 0;
+  m_failureMessages[index].clear();
+  try {
+    if (tracker->nbLvlPyr > 1) {
+      if (m_levels.size() < tracker->nbLvlPyr) {
+        throw(vpTrackingException(vpTrackingException::badValue,
+                                  "The image pyramid has %u levels while the tracker uses %u levels",
+                                  static_cast<unsigned int>(m_levels.size()), tracker->nbLvlPyr));
+      }
+      std::vector<const vpImage<unsigned char> *> levels(m_levels.begin(), m_levels.begin() + tracker->nbLvlPyr);
+      tracker->trackPyrLevels(levels);
+    } else {
+      tracker->trackNoPyr(*m_levels[0]);
+    }
+  } catch (const vpException &e) {
+    m_failed[index] = 1;
+    m_failureMessages[index] = e.getMessage();
+  } catch (const std::exception &e) {
+    m_failed[index] = 1;
+    m_failureMessages[index] = e.what();
+  }
+  if (m_failed[index]) {
+    m_nbFailures[index]++;
+  }
+  m_trackingTimes[index] = vpTime::measureTimeMs() - t0;
+}
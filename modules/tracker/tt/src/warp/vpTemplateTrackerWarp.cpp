@@ -37,8 +37,14 @@
  * Fabien Spindler
  *
  *****************************************************************************/
+#include <visp3/core/vpCPUFeatures.h>
 #include <visp3/tt/vpTemplateTrackerWarp.h>
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
 void vpTemplateTrackerWarp::warpTriangle(const vpTemplateTrackerTriangle &in, const vpColVector &p,
                                          vpTemplateTrackerTriangle &out)
 {
@@ -108,6 +114,35 @@ void vpTemplateTrackerWarp::warp(const double *ut0, const double *vt0, int nb_pt
   }
 }
 
+/*!
+  Apply an affine transformation to a list of points:
+  u = M[0] * ut0 + M[1] * vt0 + M[2] and v = M[3] * ut0 + M[4] * vt0 + M[5].
+  The points are processed two by two with SSE2, with the same operations as
+  the warpX() functions of the affine warps.
+*/
+void vpTemplateTrackerWarp::warpAffine(const double *ut0, const double *vt0, int nb_pt, const double *M, double *u,
+                                       double *v)
+{
+  int i = 0;
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2()) {
+    const __m128d m0 = _mm_set1_pd(M[0]), m1 = _mm_set1_pd(M[1]), m2 = _mm_set1_pd(M[2]);
+    const __m128d m3 = _mm_set1_pd(M[3]), m4 = _mm_set1_pd(M[4]), m5 = _mm_set1_pd(M[5]);
+    for (; i + 2 <= nb_pt; i += 2) {
+      const __m128d x = _mm_loadu_pd(ut0 + i);
+      const __m128d y = _mm_loadu_pd(vt0 + i);
+      _mm_storeu_pd(u + i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(m0, x), _mm_mul_pd(m1, y)), m2));
+      _mm_storeu_pd(v + i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(m3, x), _mm_mul_pd(m4, y)), m5));
+    }
+  }
+#endif
+  for (; i < nb_pt; i++) {
+    const double x = ut0[i], y = vt0[i];
+    u[i] = M[0] * x + M[1] * y + M[2];
+    v[i] = M[3] * x + M[4] * y + M[5];
+  }
+}
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 void vpTemplateTrackerWarp::findWarp(const double *ut0, const double *vt0, const double *u, const double *v, int nb_pt,
                                      vpColVector &p)
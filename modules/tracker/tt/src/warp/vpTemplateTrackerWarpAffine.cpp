@@ -101,6 +101,13 @@ void vpTemplateTrackerWarpAffine::warpX(const vpColVector &vX, vpColVector &vXre
   vXres[1] = ParamM[1] * vX[0] + (1.0 + ParamM[3]) * vX[1] + ParamM[5];
 }
 
+void vpTemplateTrackerWarpAffine::warp(const double *ut0, const double *vt0, int nb_pt, const vpColVector &p,
+                                       double *u, double *v)
+{
+  const double M[6] = {1.0 + p[0], p[2], p[4], p[1], 1.0 + p[3], p[5]};
+  warpAffine(ut0, vt0, nb_pt, M, u, v);
+}
+
 void vpTemplateTrackerWarpAffine::dWarp(const vpColVector &X1, const vpColVector & /*X2*/,
                                         const vpColVector & /*ParamM*/, vpMatrix &dW_)
 {
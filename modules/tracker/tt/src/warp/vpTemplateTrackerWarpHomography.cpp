@@ -37,9 +37,15 @@
  * Fabien Spindler
  *
  *****************************************************************************/
+#include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpTrackingException.h>
 #include <visp3/tt/vpTemplateTrackerWarpHomography.h>
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
 vpTemplateTrackerWarpHomography::vpTemplateTrackerWarpHomography()
 {
   nbParam = 8;
@@ -127,6 +133,48 @@ void vpTemplateTrackerWarpHomography::warpX(const vpColVector &vX, vpColVector &
   vXres[1] = (ParamM[1] * vX[0] + (1 + ParamM[4]) * vX[1] + ParamM[7]) * denom;
 }
 
+void vpTemplateTrackerWarpHomography::warp(const double *ut0, const double *vt0, int nb_pt, const vpColVector &p,
+                                           double *u, double *v)
+{
+  const double a = 1. + p[0], b = p[3], c = p[6];
+  const double d = p[1], e = 1. + p[4], f = p[7];
+  const double g = p[2], h = p[5];
+  bool divideByZero = false;
+
+  int i = 0;
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2()) {
+    const __m128d va = _mm_set1_pd(a), vb = _mm_set1_pd(b), vc = _mm_set1_pd(c);
+    const __m128d vd = _mm_set1_pd(d), ve = _mm_set1_pd(e), vf = _mm_set1_pd(f);
+    const __m128d vg = _mm_set1_pd(g), vh = _mm_set1_pd(h), one = _mm_set1_pd(1.);
+    const __m128d eps = _mm_set1_pd(std::numeric_limits<double>::epsilon());
+    const __m128d absMask = _mm_castsi128_pd(_mm_set_epi32(0x7FFFFFFF, -1, 0x7FFFFFFF, -1));
+    for (; i + 2 <= nb_pt && !divideByZero; i += 2) {
+      const __m128d x = _mm_loadu_pd(ut0 + i);
+      const __m128d y = _mm_loadu_pd(vt0 + i);
+      const __m128d value = _mm_add_pd(_mm_add_pd(_mm_mul_pd(vg, x), _mm_mul_pd(vh, y)), one);
+      divideByZero = _mm_movemask_pd(_mm_cmpngt_pd(_mm_and_pd(value, absMask), eps)) != 0;
+      const __m128d inv = _mm_div_pd(one, value);
+      _mm_storeu_pd(u + i, _mm_mul_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(va, x), _mm_mul_pd(vb, y)), vc), inv));
+      _mm_storeu_pd(v + i, _mm_mul_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(vd, x), _mm_mul_pd(ve, y)), vf), inv));
+    }
+  }
+#endif
+  for (; i < nb_pt && !divideByZero; i++) {
+    const double x = ut0[i], y = vt0[i];
+    const double value = g * x + h * y + 1.;
+    divideByZero = !(std::fabs(value) > std::numeric_limits<double>::epsilon());
+    const double inv = 1. / value;
+    u[i] = (a * x + b * y + c) * inv;
+    v[i] = (d * x + e * y + f) * inv;
+  }
+
+  if (divideByZero) {
+    throw(vpTrackingException(vpTrackingException::fatalError,
+                              "Division by zero in vpTemplateTrackerWarpHomography::warp()"));
+  }
+}
+
 void vpTemplateTrackerWarpHomography::dWarp(const vpColVector &X1, const vpColVector &X2,
                                             const vpColVector & /*ParamM*/, vpMatrix &dW_)
 {
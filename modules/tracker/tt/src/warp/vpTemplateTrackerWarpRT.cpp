@@ -93,6 +93,14 @@ void vpTemplateTrackerWarpRT::warpX(const vpColVector &vX, vpColVector &vXres, c
   vXres[1] = (sin(ParamM[0]) * vX[0]) + (cos(ParamM[0]) * vX[1]) + ParamM[2];
 }
 
+void vpTemplateTrackerWarpRT::warp(const double *ut0, const double *vt0, int nb_pt, const vpColVector &p, double *u,
+                                   double *v)
+{
+  const double c = cos(p[0]), s = sin(p[0]);
+  const double M[6] = {c, -s, p[1], s, c, p[2]};
+  warpAffine(ut0, vt0, nb_pt, M, u, v);
+}
+
 void vpTemplateTrackerWarpRT::dWarp(const vpColVector &X1, const vpColVector & /*X2*/, const vpColVector &ParamM,
                                     vpMatrix &dW_)
 {
@@ -96,6 +96,14 @@ void vpTemplateTrackerWarpSRT::warpX(const vpColVector &vX, vpColVector &vXres,
   vXres[1] = ((1.0 + ParamM[0]) * sin(ParamM[1]) * vX[0]) + ((1.0 + ParamM[0]) * cos(ParamM[1]) * vX[1]) + ParamM[3];
 }
 
+void vpTemplateTrackerWarpSRT::warp(const double *ut0, const double *vt0, int nb_pt, const vpColVector &p, double *u,
+                                    double *v)
+{
+  const double c = (1.0 + p[0]) * cos(p[1]), s = (1.0 + p[0]) * sin(p[1]);
+  const double M[6] = {c, -s, p[2], s, c, p[3]};
+  warpAffine(ut0, vt0, nb_pt, M, u, v);
+}
+
 void vpTemplateTrackerWarpSRT::dWarp(const vpColVector &X1, const vpColVector & /*X2*/, const vpColVector &ParamM,
                                      vpMatrix &dW_)
 {
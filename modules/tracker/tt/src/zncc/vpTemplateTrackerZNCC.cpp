@@ -56,30 +56,17 @@ vpTemplateTrackerZNCC::vpTemplateTrackerZNCC(vpTemplateTrackerWarp *warp) : vpTe
 double vpTemplateTrackerZNCC::getCost(const vpImage<unsigned char> &I, const vpColVector &tp)
 {
   double IW, Tij;
-  int i, j;
-  double i2, j2;
   int Nbpoint = 0;
 
-  Warp->computeCoeff(tp);
+  warpTemplate(tp);
+  getWarpedIntensities(I);
 
   double moyTij = 0;
   double moyIW = 0;
   for (unsigned int point = 0; point < templateSize; point++) {
-    i = ptTemplate[point].y;
-    j = ptTemplate[point].x;
-    X1[0] = j;
-    X1[1] = i;
-    Warp->computeDenom(X1, tp);
-    Warp->warpX(X1, X2, tp);
-
-    j2 = X2[0];
-    i2 = X2[1];
-    if ((j2 < I.getWidth() - 1) && (i2 < I.getHeight() - 1) && (i2 > 0) && (j2 > 0)) {
+    if (warpedInside[point] && (warpedV[point] > 0) && (warpedU[point] > 0)) {
       Tij = ptTemplate[point].val;
-      if (!blur)
-        IW = I.getValue(i2, j2);
-      else
-        IW = BI.getValue(i2, j2);
+      IW = warpedIntensity[point];
       // IW=getSubPixBspline4(I,i2,j2);
       moyTij += Tij;
       moyIW += IW;
@@ -97,21 +84,9 @@ double vpTemplateTrackerZNCC::getCost(const vpImage<unsigned char> &I, const vpC
   double nom = 0; //,denom=0;
   double var1 = 0, var2 = 0;
   for (unsigned int point = 0; point < templateSize; point++) {
-    i = ptTemplate[point].y;
-    j = ptTemplate[point].x;
-    X1[0] = j;
-    X1[1] = i;
-    Warp->computeDenom(X1, tp);
-    Warp->warpX(X1, X2, tp);
-
-    j2 = X2[0];
-    i2 = X2[1];
-    if ((j2 < I.getWidth() - 1) && (i2 < I.getHeight() - 1) && (i2 > 0) && (j2 > 0)) {
+    if (warpedInside[point] && (warpedV[point] > 0) && (warpedU[point] > 0)) {
       Tij = ptTemplate[point].val;
-      if (!blur)
-        IW = I.getValue(i2, j2);
-      else
-        IW = BI.getValue(i2, j2);
+      IW = warpedIntensity[point];
       // IW=getSubPixBspline4(I,i2,j2);
       nom += (Tij - moyTij) * (IW - moyIW);
       // denom+=(Tij-moyTij)*(Tij-moyTij)*(IW-moyIW)*(IW-moyIW);
@@ -49,9 +49,8 @@ vpTemplateTrackerZNCCForwardAdditional::vpTemplateTrackerZNCCForwardAdditional(v
 void vpTemplateTrackerZNCCForwardAdditional::initHessienDesired(const vpImage<unsigned char> &I)
 {
   if (blur)
-    vpImageFilter::filter(I, BI, fgG, taillef);
-  vpImageFilter::getGradXGauss2D(I, dIx, fgG, fgdG, taillef);
-  vpImageFilter::getGradYGauss2D(I, dIy, fgG, fgdG, taillef);
+    getGaussianBluredImage(I);
+  getGaussianGradients(I);
 
   vpImage<double> dIxx, dIxy, dIyx, dIyy;
   vpImageFilter::getGradX(dIx, dIxx, fgdG, taillef);
@@ -152,16 +151,14 @@ void vpTemplateTrackerZNCCForwardAdditional::initHessienDesired(const vpImage<un
 void vpTemplateTrackerZNCCForwardAdditional::trackNoPyr(const vpImage<unsigned char> &I)
 {
   if (blur)
-    vpImageFilter::filter(I, BI, fgG, taillef);
-  vpImageFilter::getGradXGauss2D(I, dIx, fgG, fgdG, taillef);
-  vpImageFilter::getGradYGauss2D(I, dIy, fgG, fgdG, taillef);
+    getGaussianBluredImage(I);
+  getGaussianGradients(I);
 
   dW = 0;
 
   double IW, dIWx, dIWy;
   double Tij;
   unsigned int iteration = 0;
-  int i, j;
   double i2, j2;
   double alpha = 2.;
 
@@ -176,28 +173,15 @@ void vpTemplateTrackerZNCCForwardAdditional::trackNoPyr(const vpImage<unsigned c
     double erreur = 0;
     G = 0;
     H = 0;
-    Warp->computeCoeff(p);
+    warpTemplate(p);
+    getWarpedIntensities(I);
     double moyTij = 0;
     double moyIW = 0;
     double denom = 0;
     for (unsigned int point = 0; point < templateSize; point++) {
-      i = ptTemplate[point].y;
-      j = ptTemplate[point].x;
-      X1[0] = j;
-      X1[1] = i;
-
-      Warp->computeDenom(X1, p);
-      Warp->warpX(X1, X2, p);
-
-      j2 = X2[0];
-      i2 = X2[1];
-      if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
+      if (warpedInside[point]) {
         Tij = ptTemplate[point].val;
-
-        if (!blur)
-          IW = I.getValue(i2, j2);
-        else
-          IW = BI.getValue(i2, j2);
+        IW = warpedIntensity[point];
 
         Nbpoint++;
         moyTij += Tij;
@@ -212,27 +196,19 @@ void vpTemplateTrackerZNCCForwardAdditional::trackNoPyr(const vpImage<unsigned c
     moyTij = moyTij / Nbpoint;
     moyIW = moyIW / Nbpoint;
     for (unsigned int point = 0; point < templateSize; point++) {
-      i = ptTemplate[point].y;
-      j = ptTemplate[point].x;
-      X1[0] = j;
-      X1[1] = i;
-
-      Warp->computeDenom(X1, p);
-      Warp->warpX(X1, X2, p);
+      if (warpedInside[point]) {
+        X1[0] = templateU[point];
+        X1[1] = templateV[point];
+        X2[0] = j2 = warpedU[point];
+        X2[1] = i2 = warpedV[point];
 
-      j2 = X2[0];
-      i2 = X2[1];
-      if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
         Tij = ptTemplate[point].val;
-
-        if (!blur)
-          IW = I.getValue(i2, j2);
-        else
-          IW = BI.getValue(i2, j2);
+        IW = warpedIntensity[point];
 
         dIWx = dIx.getValue(i2, j2);
         dIWy = dIy.getValue(i2, j2);
         // Calcul du Hessien
+        Warp->computeDenom(X1, p);
         Warp->dWarp(X1, X2, p, dW);
         double *tempt = new double[nbParam];
         for (unsigned int it = 0; it < nbParam; it++)
@@ -50,15 +50,13 @@ vpTemplateTrackerZNCCInverseCompositional::vpTemplateTrackerZNCCInverseCompositi
 
 void vpTemplateTrackerZNCCInverseCompositional::initCompInverse(const vpImage<unsigned char> &I)
 {
-  vpImageFilter::getGradXGauss2D(I, dIx, fgG, fgdG, taillef);
-  vpImageFilter::getGradYGauss2D(I, dIy, fgG, fgdG, taillef);
+  getGaussianGradients(I);
 
+  initTemplateData(nbParam);
   for (unsigned int point = 0; point < templateSize; point++) {
     int i = ptTemplate[point].y;
     int j = ptTemplate[point].x;
 
-    ptTemplate[point].dW = new double[nbParam];
-
     double dx = ptTemplate[point].dx;
     double dy = ptTemplate[point].dy;
 
@@ -72,9 +70,8 @@ void vpTemplateTrackerZNCCInverseCompositional::initHessienDesired(const vpImage
   initCompInverse(I);
 
   if (blur)
-    vpImageFilter::filter(I, BI, fgG, taillef);
-  vpImageFilter::getGradXGauss2D(I, dIx, fgG, fgdG, taillef);
-  vpImageFilter::getGradYGauss2D(I, dIy, fgG, fgdG, taillef);
+    getGaussianBluredImage(I);
+  getGaussianGradients(I);
 
   vpImage<double> dIxx, dIxy, dIyx, dIyy;
   vpImageFilter::getGradX(dIx, dIxx, fgdG, taillef);
@@ -236,14 +233,12 @@ void vpTemplateTrackerZNCCInverseCompositional::initHessienDesired(const vpImage
 void vpTemplateTrackerZNCCInverseCompositional::trackNoPyr(const vpImage<unsigned char> &I)
 {
   if (blur)
-    vpImageFilter::filter(I, BI, fgG, taillef);
+    getGaussianBluredImage(I);
 
   vpColVector dpinv(nbParam);
   double Ic;
   double Iref;
   unsigned int iteration = 0;
-  int i, j;
-  double i2, j2;
   initPosEvalRMS(p);
 
   double evolRMS_init = 0;
@@ -253,27 +248,14 @@ void vpTemplateTrackerZNCCInverseCompositional::trackNoPyr(const vpImage<unsigne
   do {
     unsigned int Nbpoint = 0;
     G = 0;
-    Warp->computeCoeff(p);
+    warpTemplate(p);
+    getWarpedIntensities(I);
     double moyIref = 0;
     double moyIc = 0;
     for (unsigned int point = 0; point < templateSize; point++) {
-      i = ptTemplate[point].y;
-      j = ptTemplate[point].x;
-      X1[0] = j;
-      X1[1] = i;
-
-      Warp->computeDenom(X1, p);
-      Warp->warpX(X1, X2, p);
-
-      j2 = X2[0];
-      i2 = X2[1];
-      if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
+      if (warpedInside[point]) {
         Iref = ptTemplate[point].val;
-
-        if (!blur)
-          Ic = I.getValue(i2, j2);
-        else
-          Ic = BI.getValue(i2, j2);
+        Ic = warpedIntensity[point];
 
         Nbpoint++;
         moyIref += Iref;
@@ -291,23 +273,9 @@ void vpTemplateTrackerZNCCInverseCompositional::trackNoPyr(const vpImage<unsigne
       sIrefdIref = 0;
 
       for (unsigned int point = 0; point < templateSize; point++) {
-        i = ptTemplate[point].y;
-        j = ptTemplate[point].x;
-        X1[0] = j;
-        X1[1] = i;
-
-        Warp->computeDenom(X1, p);
-        Warp->warpX(X1, X2, p);
-
-        j2 = X2[0];
-        i2 = X2[1];
-        if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
+        if (warpedInside[point]) {
           Iref = ptTemplate[point].val;
-
-          if (!blur)
-            Ic = I.getValue(i2, j2);
-          else
-            Ic = BI.getValue(i2, j2);
+          Ic = warpedIntensity[point];
 
           double prod = (Ic - moyIc);
           for (unsigned int it = 0; it < nbParam; it++)
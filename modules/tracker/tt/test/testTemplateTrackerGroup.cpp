@@ -0,0 +1,274 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the tracking of several templates with vpTemplateTrackerGroup.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testTemplateTrackerGroup.cpp
+
+  \brief Track several templates of a synthetic sequence with
+  vpTemplateTrackerGroup and with trackers of their own fed with a
+  vpImagePyramid, and check that both give exactly the same parameters with
+  1 and 4 threads. A tracker that loses its template must be reported as
+  failed without disturbing the other ones.
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <visp3/core/vpImagePyramid.h>
+#include <visp3/core/vpThreadPool.h>
+#include <visp3/tt/vpTemplateTrackerGroup.h>
+#include <visp3/tt/vpTemplateTrackerSSDForwardAdditional.h>
+#include <visp3/tt/vpTemplateTrackerSSDInverseCompositional.h>
+#include <visp3/tt/vpTemplateTrackerWarpAffine.h>
+#include <visp3/tt/vpTemplateTrackerWarpHomography.h>
+#include <visp3/tt/vpTemplateTrackerWarpSRT.h>
+#include <visp3/tt/vpTemplateTrackerWarpTranslation.h>
+#include <visp3/tt/vpTemplateTrackerZNCCForwardAdditional.h>
+#include <visp3/tt/vpTemplateTrackerZNCCInverseCompositional.h>
+
+namespace
+{
+const unsigned int width = 320, height = 240;
+const unsigned int nbFrames = 10;
+const unsigned int nbTrackers = 5;
+// Index of the tracker that is moved out of the image
+const unsigned int lostTracker = nbTrackers - 1;
+
+// Smooth texture translated by (0.7, -0.4) pixels per frame
+void renderImage(unsigned int frame, vpImage<unsigned char> &I)
+{
+  I.resize(height, width);
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      double x = j - 0.7 * frame, y = i + 0.4 * frame;
+      double v = 128 + 60 * std::sin(0.15 * x + 0.8 * std::sin(0.05 * y)) * std::cos(0.12 * y) +
+                 35 * std::sin(0.09 * (x + y) + 1.0);
+      I[i][j] = static_cast<unsigned char>(vpMath::round(std::max(0.0, std::min(255.0, v))));
+    }
+  }
+}
+
+// Two triangles covering a square of 60 pixels
+std::vector<vpImagePoint> square(double i0, double j0)
+{
+  std::vector<vpImagePoint> v_ip;
+  v_ip.push_back(vpImagePoint(i0, j0));
+  v_ip.push_back(vpImagePoint(i0, j0 + 60));
+  v_ip.push_back(vpImagePoint(i0 + 60, j0 + 60));
+  v_ip.push_back(vpImagePoint(i0 + 60, j0 + 60));
+  v_ip.push_back(vpImagePoint(i0 + 60, j0));
+  v_ip.push_back(vpImagePoint(i0, j0));
+  return v_ip;
+}
+
+// Trackers of different kinds, warps, pyramids and filter sizes
+struct TrackerSet {
+  std::vector<vpTemplateTrackerWarp *> warps;
+  std::vector<vpTemplateTracker *> trackers;
+
+  explicit TrackerSet(const vpImage<unsigned char> &I) : warps(), trackers()
+  {
+    warps.push_back(new vpTemplateTrackerWarpHomography);
+    trackers.push_back(new vpTemplateTrackerSSDInverseCompositional(warps.back()));
+    trackers.back()->setPyramidal(3, 0);
+    trackers.back()->initFromPoints(I, square(30, 30));
+
+    warps.push_back(new vpTemplateTrackerWarpAffine);
+    trackers.push_back(new vpTemplateTrackerSSDForwardAdditional(warps.back()));
+    trackers.back()->setPyramidal(2, 0);
+    trackers.back()->initFromPoints(I, square(30, 220));
+
+    warps.push_back(new vpTemplateTrackerWarpSRT);
+    trackers.push_back(new vpTemplateTrackerZNCCInverseCompositional(warps.back()));
+    trackers.back()->setPyramidal(2, 0);
+    trackers.back()->setGaussianFilterSize(5);
+    trackers.back()->initFromPoints(I, square(140, 30));
+
+    warps.push_back(new vpTemplateTrackerWarpTranslation);
+    trackers.push_back(new vpTemplateTrackerZNCCForwardAdditional(warps.back()));
+    trackers.back()->initFromPoints(I, square(140, 220));
+
+    warps.push_back(new vpTemplateTrackerWarpTranslation);
+    trackers.push_back(new vpTemplateTrackerSSDInverseCompositional(warps.back()));
+    trackers.back()->initFromPoints(I, square(90, 130));
+    vpColVector p(2);
+    p[0] = 10 * width;
+    p[1] = 10 * height;
+    trackers.back()->setp(p);
+  }
+
+  ~TrackerSet()
+  {
+    for (size_t k = 0; k < trackers.size(); k++) {
+      delete trackers[k];
+      delete warps[k];
+    }
+  }
+};
+
+bool sameParameters(const vpColVector &p1, const vpColVector &p2)
+{
+  if (p1.size() != p2.size()) {
+    return false;
+  }
+  for (unsigned int k = 0; k < p1.size(); k++) {
+    if (p1[k] != p2[k]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Track the sequence with a group and with trackers of their own. The
+// parameters estimated at each frame are appended to \e params
+bool run(unsigned int nbThreads, std::vector<vpColVector> &params)
+{
+  vpThreadPool::instance().setNumThreads(nbThreads);
+
+  vpImage<unsigned char> I;
+  renderImage(0, I);
+  TrackerSet grouped(I), single(I);
+
+  vpTemplateTrackerGroup group;
+  for (unsigned int k = 0; k < nbTrackers; k++) {
+    group.addTracker(grouped.trackers[k]);
+  }
+
+  bool success = true;
+  vpImagePyramid pyramid;
+  for (unsigned int frame = 1; frame < nbFrames && success; frame++) {
+    renderImage(frame, I);
+    if (group.track(I)) {
+      std::cerr << "Frame " << frame << ": the lost tracker is not reported" << std::endl;
+      success = false;
+    }
+
+    pyramid.build(I, 3, vpImagePyramid::GAUSSIAN_FILTER);
+    for (unsigned int k = 0; k < nbTrackers; k++) {
+      bool failed = false;
+      try {
+        single.trackers[k]->track(pyramid);
+      } catch (const vpException &) {
+        failed = true;
+      }
+
+      if (group.hasFailed(k) != failed || failed != (k == lostTracker) ||
+          group.getFailureMessage(k).empty() != !failed) {
+        std::cerr << "Frame " << frame << ", tracker " << k << ": unexpected failure status" << std::endl;
+        success = false;
+      }
+      if (!failed) {
+        vpColVector p = grouped.trackers[k]->getp();
+        if (!sameParameters(p, single.trackers[k]->getp())) {
+          std::cerr << "Frame " << frame << ", tracker " << k << ": the group gives " << p.t()
+                    << " instead of " << single.trackers[k]->getp().t() << std::endl;
+          success = false;
+        }
+        params.push_back(p);
+      }
+    }
+  }
+
+  if (success && group.getNbFailures(lostTracker) != nbFrames - 1) {
+    std::cerr << "The lost tracker failed " << group.getNbFailures(lostTracker) << " times instead of "
+              << nbFrames - 1 << std::endl;
+    success = false;
+  }
+
+  // The homography tracker follows the translation of the texture
+  vpColVector p = grouped.trackers[0]->getp();
+  if (success && (std::fabs(p[6] - 0.7 * (nbFrames - 1)) > 0.1 || std::fabs(p[7] + 0.4 * (nbFrames - 1)) > 0.1)) {
+    std::cerr << "The homography tracker estimates " << p.t() << std::endl;
+    success = false;
+  }
+  return success;
+}
+
+bool testAddTracker()
+{
+  vpImage<unsigned char> I;
+  renderImage(0, I);
+  TrackerSet trackers(I);
+  vpTemplateTrackerGroup group;
+  group.addTracker(trackers.trackers[0]);
+
+  vpTemplateTrackerSSDForwardAdditional sameWarp(trackers.warps[0]);
+  vpTemplateTracker *invalid[] = {NULL, trackers.trackers[0], &sameWarp};
+  for (unsigned int k = 0; k < 3; k++) {
+    try {
+      group.addTracker(invalid[k]);
+      std::cerr << "Invalid tracker " << k << " added to the group" << std::endl;
+      return false;
+    } catch (vpException &e) {
+      if (e.getCode() != vpException::badValue) {
+        std::cerr << "Unexpected exception " << e.what() << std::endl;
+        return false;
+      }
+    }
+  }
+  return group.getNbTrackers() == 1;
+}
+} // namespace
+
+int main()
+{
+  bool success = false;
+  try {
+    std::vector<vpColVector> params_single, params_multi;
+    success = testAddTracker() && run(1, params_single) && run(4, params_multi);
+    if (success) {
+      // The parameters do not depend on the number of threads
+      success = (params_single.size() == params_multi.size());
+      for (size_t k = 0; k < params_single.size() && success; k++) {
+        success = sameParameters(params_single[k], params_multi[k]);
+      }
+      if (!success) {
+        std::cerr << "The parameters depend on the number of threads" << std::endl;
+      }
+    }
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.what() << std::endl;
+    success = false;
+  }
+
+  if (!success) {
+    std::cerr << "Test failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test succeed" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,231 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the tracking of a template on a shared image pyramid.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testTemplateTrackerPyramid.cpp
+
+  \brief Check that vpTemplateTracker::track() on a pyramid built by
+  vpImagePyramid gives exactly the same parameters as the tracking of the
+  image itself, that the parameters settle close to identity on a static
+  image, and that a pyramid with too few levels is rejected.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <visp3/core/vpImagePyramid.h>
+#include <visp3/tt/vpTemplateTrackerSSDForwardAdditional.h>
+#include <visp3/tt/vpTemplateTrackerSSDInverseCompositional.h>
+#include <visp3/tt/vpTemplateTrackerWarpAffine.h>
+#include <visp3/tt/vpTemplateTrackerWarpHomography.h>
+#include <visp3/tt/vpTemplateTrackerWarpSRT.h>
+#include <visp3/tt/vpTemplateTrackerZNCCInverseCompositional.h>
+
+namespace
+{
+const unsigned int width = 320, height = 240;
+const unsigned int nbFrames = 8;
+const unsigned int nbLevels = 3;
+
+// Smooth texture translated by (0.6, 0.3) pixels per frame
+void renderImage(unsigned int frame, vpImage<unsigned char> &I)
+{
+  I.resize(height, width);
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      double x = j - 0.6 * frame, y = i - 0.3 * frame;
+      double v = 128 + 60 * std::sin(0.15 * x + 0.8 * std::sin(0.05 * y)) * std::cos(0.12 * y) +
+                 35 * std::sin(0.09 * (x + y) + 1.0);
+      I[i][j] = static_cast<unsigned char>(vpMath::round(std::max(0.0, std::min(255.0, v))));
+    }
+  }
+}
+
+// Two triangles covering a square of 80 pixels
+std::vector<vpImagePoint> square(double i0, double j0)
+{
+  std::vector<vpImagePoint> v_ip;
+  v_ip.push_back(vpImagePoint(i0, j0));
+  v_ip.push_back(vpImagePoint(i0, j0 + 80));
+  v_ip.push_back(vpImagePoint(i0 + 80, j0 + 80));
+  v_ip.push_back(vpImagePoint(i0 + 80, j0 + 80));
+  v_ip.push_back(vpImagePoint(i0 + 80, j0));
+  v_ip.push_back(vpImagePoint(i0, j0));
+  return v_ip;
+}
+
+// Tracker of kind \e kind on a pyramid of \e levels levels, 1 for no pyramid
+vpTemplateTracker *createTracker(unsigned int kind, unsigned int levels, vpTemplateTrackerWarp *&warp)
+{
+  vpTemplateTracker *tracker = NULL;
+  switch (kind) {
+  case 0:
+    warp = new vpTemplateTrackerWarpHomography;
+    tracker = new vpTemplateTrackerSSDInverseCompositional(warp);
+    break;
+  case 1:
+    warp = new vpTemplateTrackerWarpAffine;
+    tracker = new vpTemplateTrackerSSDForwardAdditional(warp);
+    break;
+  default:
+    warp = new vpTemplateTrackerWarpSRT;
+    tracker = new vpTemplateTrackerZNCCInverseCompositional(warp);
+    break;
+  }
+  if (levels > 1) {
+    tracker->setPyramidal(levels, 0);
+  }
+  return tracker;
+}
+
+bool sameParameters(const vpColVector &p1, const vpColVector &p2)
+{
+  if (p1.size() != p2.size()) {
+    return false;
+  }
+  for (unsigned int k = 0; k < p1.size(); k++) {
+    if (p1[k] != p2[k]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Track a static image, then a moving one, with track(I) and with
+// track(pyramid)
+bool testTracker(unsigned int kind, unsigned int levels)
+{
+  std::stringstream ss;
+  ss << "tracker " << kind << " with " << levels << " level(s)";
+  const std::string name = ss.str();
+
+  vpImage<unsigned char> I;
+  renderImage(0, I);
+  vpTemplateTrackerWarp *warp_image = NULL, *warp_pyramid = NULL;
+  vpTemplateTracker *tracker_image = createTracker(kind, levels, warp_image);
+  vpTemplateTracker *tracker_pyramid = createTracker(kind, levels, warp_pyramid);
+  tracker_image->initFromPoints(I, square(80, 120));
+  tracker_pyramid->initFromPoints(I, square(80, 120));
+
+  // On a static image the parameters settle close to identity. They do not
+  // reach it exactly: the template intensities are B-spline interpolated while
+  // the tracked ones are bilinear, and the coarse levels of the inverse
+  // compositional homography leave a bias below one pixel
+  bool success = true;
+  vpImagePyramid pyramid(I, nbLevels, vpImagePyramid::GAUSSIAN_FILTER);
+  vpColVector p_prev = tracker_pyramid->getp();
+  double step = 0;
+  for (unsigned int n = 0; n < 20 && success; n++) {
+    tracker_pyramid->track(pyramid);
+    vpColVector p = tracker_pyramid->getp();
+    step = 0;
+    for (unsigned int k = 0; k < p.size(); k++) {
+      // The last two parameters are translations, in pixels
+      double bound = (k + 2 < p.size()) ? 1e-2 : 1.;
+      if (!(std::fabs(p[k]) < bound)) {
+        std::cerr << name << ": the parameters drift to " << p.t() << " on a static image" << std::endl;
+        success = false;
+        break;
+      }
+      step = std::max(step, std::fabs(p[k] - p_prev[k]));
+    }
+    p_prev = p;
+  }
+  if (success && !(step < 1e-4)) {
+    std::cerr << name << ": the parameters still move by " << step << " on a static image" << std::endl;
+    success = false;
+  }
+
+  // Both trackers start the sequence from identity
+  tracker_pyramid->setp(tracker_image->getp());
+  for (unsigned int frame = 1; frame < nbFrames && success; frame++) {
+    renderImage(frame, I);
+    tracker_image->track(I);
+    pyramid.build(I, nbLevels, vpImagePyramid::GAUSSIAN_FILTER);
+    tracker_pyramid->track(pyramid);
+    if (!sameParameters(tracker_image->getp(), tracker_pyramid->getp())) {
+      std::cerr << name << ", frame " << frame << ": track(I) gives " << tracker_image->getp().t()
+                << " and track(pyramid) " << tracker_pyramid->getp().t() << std::endl;
+      success = false;
+    }
+  }
+
+  if (success && levels > 1) {
+    pyramid.build(I, levels - 1, vpImagePyramid::GAUSSIAN_FILTER);
+    try {
+      tracker_pyramid->track(pyramid);
+      std::cerr << name << ": a pyramid with too few levels is accepted" << std::endl;
+      success = false;
+    } catch (const vpException &) {
+    }
+  }
+
+  delete tracker_image;
+  delete tracker_pyramid;
+  delete warp_image;
+  delete warp_pyramid;
+  if (success) {
+    std::cout << name << ": ok" << std::endl;
+  }
+  return success;
+}
+} // namespace
+
+int main()
+{
+  bool success = true;
+  try {
+    const unsigned int levels[] = {1, 2, 3};
+    for (unsigned int kind = 0; kind < 3; kind++) {
+      for (unsigned int l = 0; l < sizeof(levels) / sizeof(levels[0]); l++) {
+        success = testTracker(kind, levels[l]) && success;
+      }
+    }
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.what() << std::endl;
+    success = false;
+  }
+
+  if (!success) {
+    std::cerr << "Test failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test succeed" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,235 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the warp of a list of points by the template tracker warps.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testTemplateTrackerWarp.cpp
+
+  \brief Compare vpTemplateTrackerWarp::warp() with computeDenom() and
+  warpX() applied point by point, for every warp, and check that the
+  template of an inverse compositional tracker only warps its selected
+  points.
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include <visp3/core/vpUniRand.h>
+#include <visp3/tt/vpTemplateTrackerSSDInverseCompositional.h>
+#include <visp3/tt/vpTemplateTrackerWarpAffine.h>
+#include <visp3/tt/vpTemplateTrackerWarpHomography.h>
+#include <visp3/tt/vpTemplateTrackerWarpHomographySL3.h>
+#include <visp3/tt/vpTemplateTrackerWarpRT.h>
+#include <visp3/tt/vpTemplateTrackerWarpSRT.h>
+#include <visp3/tt/vpTemplateTrackerWarpTranslation.h>
+
+namespace
+{
+const double tolerance = 1e-10;
+
+// Odd number of points to also use the scalar tail of the SSE2 loops
+const int nbPoints = 1001;
+
+bool sameCoordinates(double u, double v, double u_ref, double v_ref)
+{
+  return std::fabs(u - u_ref) <= tolerance && std::fabs(v - v_ref) <= tolerance;
+}
+
+// Warp of a list of points, out of place and in place, against the warp of
+// each point
+bool testWarp(const std::string &name, vpTemplateTrackerWarp &warp, vpUniRand &rng)
+{
+  vpColVector p(warp.getNbParam());
+  for (unsigned int k = 0; k < p.size(); k++) {
+    p[k] = rng.uniform(-0.1, 0.1);
+  }
+  if (name == "vpTemplateTrackerWarpHomography") {
+    // Keep the points far from the line at infinity
+    p[2] *= 1e-3;
+    p[5] *= 1e-3;
+  }
+
+  std::vector<double> ut0(nbPoints), vt0(nbPoints), u(nbPoints), v(nbPoints);
+  for (int i = 0; i < nbPoints; i++) {
+    ut0[i] = rng.uniform(0.0, 640.0);
+    vt0[i] = rng.uniform(0.0, 480.0);
+  }
+  warp.warp(&ut0[0], &vt0[0], nbPoints, p, &u[0], &v[0]);
+  std::vector<double> u_inplace(ut0), v_inplace(vt0);
+  warp.warp(&u_inplace[0], &v_inplace[0], nbPoints, p, &u_inplace[0], &v_inplace[0]);
+
+  warp.computeCoeff(p);
+  vpColVector X1(2), X2(2);
+  for (int i = 0; i < nbPoints; i++) {
+    X1[0] = ut0[i];
+    X1[1] = vt0[i];
+    warp.computeDenom(X1, p);
+    warp.warpX(X1, X2, p);
+    if (!sameCoordinates(u[i], v[i], X2[0], X2[1]) || !sameCoordinates(u_inplace[i], v_inplace[i], X2[0], X2[1])) {
+      std::cerr << name << ": point " << i << " warped to (" << u[i] << ", " << v[i] << ") and (" << u_inplace[i]
+                << ", " << v_inplace[i] << ") instead of (" << X2[0] << ", " << X2[1] << ")" << std::endl;
+      return false;
+    }
+  }
+  std::cout << name << ": ok" << std::endl;
+  return true;
+}
+
+// Inverse compositional tracker that gives access to the warp of its
+// template
+class SelectTracker : public vpTemplateTrackerSSDInverseCompositional
+{
+public:
+  explicit SelectTracker(vpTemplateTrackerWarp *warp) : vpTemplateTrackerSSDInverseCompositional(warp) {}
+
+  // Homography whose denominator vanishes at a point that is not selected
+  bool testSelection()
+  {
+    unsigned int lost = templateSize;
+    unsigned int nbSelected = 0;
+    for (unsigned int point = 0; point < templateSize; point++) {
+      if (ptTemplateSelect[point]) {
+        nbSelected++;
+      } else {
+        lost = point;
+      }
+    }
+    if (nbSelected == 0 || lost == templateSize) {
+      std::cerr << "The template should have selected and unselected points" << std::endl;
+      return false;
+    }
+
+    vpColVector p(8);
+    p[5] = 1.3717e-3;
+    p[2] = (-1. - p[5] * ptTemplate[lost].y) / ptTemplate[lost].x;
+    for (unsigned int point = 0; point < templateSize; point++) {
+      double value = p[2] * ptTemplate[point].x + p[5] * ptTemplate[point].y + 1.;
+      if (ptTemplateSelect[point] && !(std::fabs(value) > std::numeric_limits<double>::epsilon())) {
+        std::cerr << "The denominator vanishes at a selected point" << std::endl;
+        return false;
+      }
+    }
+
+    try {
+      warpTemplate(p);
+      std::cerr << "The division by zero is not detected" << std::endl;
+      return false;
+    } catch (const vpException &) {
+    }
+
+    try {
+      warpTemplate(p, ptTemplateSelect);
+    } catch (const vpException &e) {
+      std::cerr << "The unselected points are warped: " << e.what() << std::endl;
+      return false;
+    }
+    vpColVector X1(2), X2(2);
+    for (unsigned int point = 0; point < templateSize; point++) {
+      if (ptTemplateSelect[point]) {
+        X1[0] = ptTemplate[point].x;
+        X1[1] = ptTemplate[point].y;
+        Warp->computeDenom(X1, p);
+        Warp->warpX(X1, X2, p);
+      } else {
+        X2[0] = X2[1] = -1.;
+      }
+      if (!sameCoordinates(warpedU[point], warpedV[point], X2[0], X2[1])) {
+        std::cerr << "Template point " << point << " warped to (" << warpedU[point] << ", " << warpedV[point]
+                  << ") instead of (" << X2[0] << ", " << X2[1] << ")" << std::endl;
+        return false;
+      }
+    }
+    std::cout << "Warp of the " << nbSelected << " selected points among " << templateSize << ": ok" << std::endl;
+    return true;
+  }
+};
+
+bool testTemplateSelection()
+{
+  // Uniform left half, textured right half
+  vpImage<unsigned char> I(120, 160, 128);
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = I.getWidth() / 2; j < I.getWidth(); j++) {
+      I[i][j] = static_cast<unsigned char>(128 + 100 * std::sin(0.3 * j) * std::cos(0.25 * i));
+    }
+  }
+  std::vector<vpImagePoint> v_ip;
+  v_ip.push_back(vpImagePoint(30, 40));
+  v_ip.push_back(vpImagePoint(30, 120));
+  v_ip.push_back(vpImagePoint(90, 120));
+  v_ip.push_back(vpImagePoint(90, 120));
+  v_ip.push_back(vpImagePoint(90, 40));
+  v_ip.push_back(vpImagePoint(30, 40));
+
+  vpTemplateTrackerWarpHomography warp;
+  SelectTracker tracker(&warp);
+  tracker.setUseTemplateSelect(true);
+  tracker.initFromPoints(I, v_ip);
+  return tracker.testSelection();
+}
+} // namespace
+
+int main()
+{
+  bool success = true;
+  try {
+    vpUniRand rng(42);
+    vpTemplateTrackerWarpAffine affine;
+    vpTemplateTrackerWarpHomography homography;
+    vpTemplateTrackerWarpHomographySL3 homographySL3;
+    vpTemplateTrackerWarpRT rt;
+    vpTemplateTrackerWarpSRT srt;
+    vpTemplateTrackerWarpTranslation translation;
+    success = testWarp("vpTemplateTrackerWarpAffine", affine, rng) && success;
+    success = testWarp("vpTemplateTrackerWarpHomography", homography, rng) && success;
+    success = testWarp("vpTemplateTrackerWarpHomographySL3", homographySL3, rng) && success;
+    success = testWarp("vpTemplateTrackerWarpRT", rt, rng) && success;
+    success = testWarp("vpTemplateTrackerWarpSRT", srt, rng) && success;
+    success = testWarp("vpTemplateTrackerWarpTranslation", translation, rng) && success;
+    success = testTemplateSelection() && success;
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.what() << std::endl;
+    success = false;
+  }
+
+  if (!success) {
+    std::cerr << "Test failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test succeed" << std::endl;
+  return EXIT_SUCCESS;
+}
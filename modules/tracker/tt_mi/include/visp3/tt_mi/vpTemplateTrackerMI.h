@@ -45,6 +45,7 @@
 #include <visp3/core/vpImageFilter.h>
 #include <visp3/tt/vpTemplateTracker.h>
 #include <visp3/tt/vpTemplateTrackerHeader.h>
+#include <visp3/tt_mi/vpTemplateTrackerMIHistogram.h>
 
 /*!
   \class vpTemplateTrackerMI
@@ -105,6 +106,9 @@ protected:
   vpMatrix covarianceMatrix;
   bool computeCovariance;
 
+  bool reducedPrecision;
+  vpTemplateTrackerMIHistogram miHistogram;
+
   // Internal vars for computeHessienNormalized()
   std::vector<double> m_du;
   std::vector<double> m_dv;
@@ -126,6 +130,7 @@ protected:
   double getNormalizedCost(const vpImage<unsigned char> &I, const vpColVector &tp);
   double getNormalizedCost(const vpImage<unsigned char> &I) { return getNormalizedCost(I, p); }
   virtual void initHessienDesired(const vpImage<unsigned char> &I) = 0;
+  void normalizeProbabilities(int nbpoint);
   virtual void trackNoPyr(const vpImage<unsigned char> &I) = 0;
   void zeroProbabilities();
 
@@ -157,7 +162,7 @@ public:
       Prt(NULL), dPrt(NULL), Pt(NULL), Pr(NULL), d2Prt(NULL), PrtTout(NULL), dprtemp(NULL), PrtD(NULL), dPrtD(NULL),
       influBspline(0), bspline(0), Nc(0), Ncb(0), d2Ix(), d2Iy(), d2Ixy(), MI_preEstimation(0), MI_postEstimation(0),
       NMI_preEstimation(0), NMI_postEstimation(0), covarianceMatrix(), computeCovariance(false),
-      m_du(), m_dv(), m_A(), m_dB(), m_d2u(), m_d2v(), m_dA()
+      reducedPrecision(false), miHistogram(), m_du(), m_dv(), m_A(), m_dB(), m_d2u(), m_d2v(), m_dA()
   {
   }
   explicit vpTemplateTrackerMI(vpTemplateTrackerWarp *_warp);
@@ -167,6 +172,7 @@ public:
   double getMI(const vpImage<unsigned char> &I, int &nc, const int &bspline, vpColVector &tp);
   double getMI256(const vpImage<unsigned char> &I, const vpColVector &tp);
   double getNMI() const { return NMI_postEstimation; }
+  bool getReducedPrecision() const { return reducedPrecision; }
   // initialisation du Hessien en position desiree
   void setApprocHessian(vpHessienApproximationType approx) { ApproxHessian = approx; }
   void setCovarianceComputation(const bool &flag) { computeCovariance = flag; }
@@ -174,6 +180,13 @@ public:
   void setBspline(const vpBsplineType &newbs);
   void setLambda(double _l) { lambda = _l; }
   void setNc(int newNc);
+  /*!
+    When enabled, the joint histogram and its derivatives are accumulated in
+    single precision before being summed in double precision. This speeds up
+    the tracking, especially with the homographies, at the cost of a slightly
+    different estimation. Disabled by default.
+  */
+  void setReducedPrecision(bool reduced) { reducedPrecision = reduced; }
 };
 
 #endif
@@ -0,0 +1,119 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Joint histogram accumulation of the mutual information template trackers.
+ *
+ *****************************************************************************/
+/*!
+ \file vpTemplateTrackerMIHistogram.h
+ \brief Joint histogram accumulation of the mutual information template
+ trackers.
+*/
+
+#ifndef vpTemplateTrackerMIHistogram_hh
+#define vpTemplateTrackerMIHistogram_hh
+
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+/*
+  Accumulates the B-spline weighted joint histogram of the mutual information
+  trackers and its derivatives with respect to the warp parameters.
+
+  The trackers first record the bins of the reference and current intensities
+  of every template point with addSample(), then accumulate() computes the
+  B-spline weights of all the samples in contiguous tables and adds their
+  contributions. Samples are split in blocks of a size that only depends on
+  the number of samples and of bins: the blocks are accumulated in parallel on
+  vpThreadPool into private histograms that are then summed in block order,
+  so that the result does not depend on the number of threads. When the
+  reduced precision is enabled, the blocks are accumulated in single
+  precision before being summed in double precision.
+*/
+class VISP_EXPORT vpTemplateTrackerMIHistogram
+{
+public:
+  typedef enum {
+    HISTOGRAM_ONLY,    // Only the joint histogram
+    FIRST_DERIVATIVES, // Joint histogram and its first derivatives
+    SECOND_DERIVATIVES // Joint histogram, its first and second derivatives
+  } vpDerivativeType;
+
+  vpTemplateTrackerMIHistogram();
+
+  void accumulate(double *PrtTout, vpDerivativeType type);
+  void accumulate(double *Prt, double *dPrt, double *d2Prt, vpDerivativeType type);
+  void addSample(int cr, double er, int ct, double et, const double *val = NULL);
+  unsigned int getNbSamples() const { return nbSamples; }
+  void reset(int nc, int bspline, unsigned int nbParam, bool reducedPrecision);
+
+private:
+  class AccumulateBody;
+  class MergeBody;
+
+  void accumulate(double *Prt, double *dPrt, double *d2Prt, bool direct, vpDerivativeType type);
+  void accumulateBlock(unsigned int block);
+  template <typename T> void accumulateSamples(unsigned int first, unsigned int last, T *Prt, T *dPrt, T *d2Prt);
+  void computeWeights(unsigned int first, unsigned int last);
+  void mergeBlocks(int begin, int end);
+
+  int Nc;
+  int bspline;
+  unsigned int nbParam;
+  bool reducedPrecision;
+
+  unsigned int nbSamples;
+  std::vector<int> bins;           // (cr, ct) of each sample
+  std::vector<double> fractions;   // (er, et) of each sample
+  std::vector<double> derivatives; // nbParam values of each sample
+  std::vector<bool> hasDerivatives;
+
+  // B-spline weights of each sample: Br, Bt, dBt and d2Bt, 4 values each
+  std::vector<double> weights;
+  std::vector<int> cells; // First bin of each sample along r and t
+
+  // Layout and destination of the current accumulation
+  bool direct;
+  vpDerivativeType derivativeType;
+  double *dst[3];
+  unsigned int dstSize[3];
+  unsigned int nbBlocks;
+  unsigned int blockSize;
+  unsigned int histogramSize;
+  std::vector<std::vector<double> > blocks;
+  std::vector<std::vector<float> > blocksF;
+};
+
+#endif
+#endif
@@ -37,10 +37,16 @@
  * Fabien Spindler
  *
  *****************************************************************************/
+#include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpException.h>
 #include <visp3/tt_mi/vpTemplateTrackerMI.h>
 #include <visp3/tt_mi/vpTemplateTrackerMIBSpline.h>
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
 void vpTemplateTrackerMI::setBspline(const vpBsplineType &newbs)
 {
   bspline = (int)newbs;
@@ -82,7 +88,8 @@ vpTemplateTrackerMI::vpTemplateTrackerMI(vpTemplateTrackerWarp *_warp)
   : vpTemplateTracker(_warp), hessianComputation(USE_HESSIEN_NORMAL), ApproxHessian(HESSIAN_NEW), lambda(0), temp(NULL),
     Prt(NULL), dPrt(NULL), Pt(NULL), Pr(NULL), d2Prt(NULL), PrtTout(NULL), dprtemp(NULL), PrtD(NULL), dPrtD(NULL),
     influBspline(0), bspline(3), Nc(8), Ncb(0), d2Ix(), d2Iy(), d2Ixy(), MI_preEstimation(0), MI_postEstimation(0),
-    NMI_preEstimation(0), NMI_postEstimation(0), covarianceMatrix(), computeCovariance(false)
+    NMI_preEstimation(0), NMI_postEstimation(0), covarianceMatrix(), computeCovariance(false),
+    reducedPrecision(false), miHistogram()
 {
   Ncb = Nc + bspline;
   influBspline = bspline * bspline;
@@ -158,26 +165,14 @@ double vpTemplateTrackerMI::getCost(const vpImage<unsigned char> &I, const vpCol
   memset(Prt, 0, Ncb_ * Ncb_ * sizeof(double));
   memset(PrtD, 0, Nc_ * Nc_ * influBspline_ * sizeof(double));
 
-  // Warp->ComputeMAtWarp(tp);
-  Warp->computeCoeff(tp);
+  warpTemplate(tp);
+  getWarpedIntensities(I);
   for (unsigned int point = 0; point < templateSize; point++) {
-    X1[0] = ptTemplate[point].x;
-    X1[1] = ptTemplate[point].y;
-
-    Warp->computeDenom(X1, tp);
-    Warp->warpX(X1, X2, tp);
-    double j2 = X2[0];
-    double i2 = X2[1];
-
-    // Tij=Templ[i-(int)Triangle->GetMiny()][j-(int)Triangle->GetMinx()];
-    if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
+    if (warpedInside[point]) {
       Nbpoint++;
 
       double Tij = ptTemplate[point].val;
-      if (!blur)
-        IW = I.getValue(i2, j2);
-      else
-        IW = BI.getValue(i2, j2);
+      IW = warpedIntensity[point];
 
       double Nc_1 = (Nc - 1.)/255.;
       double IW_Nc = IW * Nc_1;
@@ -346,6 +341,9 @@ void vpTemplateTrackerMI::computeProba(int &nbpoint)
   unsigned int Nc_ = static_cast<unsigned int>(Nc);
   unsigned int Ncb_ = static_cast<unsigned int>(Ncb);
   unsigned int bspline_ = static_cast<unsigned int>(bspline);
+#if VISP_HAVE_SSE2
+  const bool useSSE2 = vpCPUFeatures::checkSSE2();
+#endif
 
   for (unsigned int r = 0; r < Nc_; r++) {
     for (unsigned int t = 0; t < Nc_; t++) {
@@ -357,10 +355,19 @@ void vpTemplateTrackerMI::computeProba(int &nbpoint)
           Prt[r2_r_Ncb_ + t2_t_] += *pt++;
           for (unsigned int ip = 0; ip < nbParam; ip++) {
             dPrt[r2_r_Ncb_t2_t_nbParam_ + ip] += *pt++;
-            unsigned int ip_nbParam_ = ip * nbParam;
-            for (unsigned int it = 0; it < nbParam; it++) {
-              d2Prt[r2_r_Ncb_t2_t_nbParam_ * nbParam + ip_nbParam_ + it] += *pt++;
+            double *d2Prt_ = &d2Prt[(r2_r_Ncb_t2_t_nbParam_ + ip) * nbParam];
+            unsigned int it = 0;
+#if VISP_HAVE_SSE2
+            if (useSSE2) {
+              for (; it + 2 <= nbParam; it += 2) {
+                _mm_storeu_pd(d2Prt_ + it, _mm_add_pd(_mm_loadu_pd(d2Prt_ + it), _mm_loadu_pd(pt + it)));
+              }
+            }
+#endif
+            for (; it < nbParam; it++) {
+              d2Prt_[it] += pt[it];
             }
+            pt += nbParam;
           }
         }
       }
@@ -370,18 +377,37 @@ void vpTemplateTrackerMI::computeProba(int &nbpoint)
   if (nbpoint == 0) {
     throw(vpTrackingException(vpTrackingException::notEnoughPointError, "No points in the template"));
   }
-  unsigned int indd, indd2;
-  indd = indd2 = 0;
-  for (volatile int i = 0; i < Ncb * Ncb; i++) {
-    Prt[i] = Prt[i] / nbpoint;
-    for (unsigned int j = 0; j < nbParam; j++) {
-      dPrt[indd] /= nbpoint;
-      indd++;
-      for (unsigned int k = 0; k < nbParam; k++) {
-        d2Prt[indd2] /= nbpoint;
-        indd2++;
+  normalizeProbabilities(nbpoint);
+}
+
+/*!
+  Divide the joint histogram and its derivatives by the number of points
+  \e nbpoint that were accumulated.
+*/
+void vpTemplateTrackerMI::normalizeProbabilities(int nbpoint)
+{
+  unsigned int Ncb2_ = static_cast<unsigned int>(Ncb * Ncb);
+  double *tab[3] = {Prt, dPrt, d2Prt};
+  unsigned int size[3] = {Ncb2_, Ncb2_ * nbParam, Ncb2_ * nbParam * nbParam};
+  double n = static_cast<double>(nbpoint);
+#if VISP_HAVE_SSE2
+  const bool useSSE2 = vpCPUFeatures::checkSSE2();
+  const __m128d vn = _mm_set1_pd(n);
+#endif
+
+  for (unsigned int k = 0; k < 3; k++) {
+    double *pt = tab[k];
+    unsigned int i = 0;
+#if VISP_HAVE_SSE2
+    if (useSSE2) {
+      for (; i + 2 <= size[k]; i += 2) {
+        _mm_storeu_pd(pt + i, _mm_div_pd(_mm_loadu_pd(pt + i), vn));
       }
     }
+#endif
+    for (; i < size[k]; i++) {
+      pt[i] /= n;
+    }
   }
 }
 
@@ -425,6 +451,13 @@ void vpTemplateTrackerMI::computeHessien(vpMatrix &Hessian)
   double dtemp;
   unsigned int Ncb_ = static_cast<unsigned int>(Ncb);
   unsigned int nbParam2 = nbParam * nbParam;
+  // The first order term is not used by HESSIAN_NEW, the second order one by
+  // HESSIAN_NONSECOND
+  const bool firstOrder = (ApproxHessian != HESSIAN_NEW);
+  const bool secondOrder = (ApproxHessian != HESSIAN_NONSECOND);
+#if VISP_HAVE_SSE2
+  const bool useSSE2 = vpCPUFeatures::checkSSE2();
+#endif
 
   for (unsigned int t = 0; t < Ncb_; t++) {
     // if(Pt[t]!=0)
@@ -443,15 +476,35 @@ void vpTemplateTrackerMI::computeHessien(vpMatrix &Hessian)
           double Prt_Pt_ = 1. / Prt[r_Ncb_t_] - 1. / Pt[t];
           unsigned int r_Ncb_t_nbParam2_ = r_Ncb_t_ * nbParam2;
           for (unsigned int it = 0; it < nbParam; it++) {
-            unsigned int r_Ncb_t_nbParam2_it_nbParam_ = r_Ncb_t_nbParam2_ + it * nbParam;
-            for (unsigned int jt = 0; jt < nbParam; jt++) {
-              if (ApproxHessian != HESSIAN_NONSECOND && ApproxHessian != HESSIAN_NEW)
-                Hessian[it][jt] += dprtemp[it] * dprtemp[jt] * Prt_Pt_ +
-                                   d2Prt[r_Ncb_t_nbParam2_it_nbParam_ + jt] * dtemp;
-              else if (ApproxHessian == HESSIAN_NEW)
-                Hessian[it][jt] += d2Prt[r_Ncb_t_nbParam2_it_nbParam_ + jt] * dtemp;
+            const double *d2Prt_ = &d2Prt[r_Ncb_t_nbParam2_ + it * nbParam];
+            double *H_ = Hessian[it];
+            unsigned int jt = 0;
+#if VISP_HAVE_SSE2
+            if (useSSE2) {
+              const __m128d vdprt = _mm_set1_pd(dprtemp[it]);
+              const __m128d vPrt_Pt = _mm_set1_pd(Prt_Pt_);
+              const __m128d vdtemp = _mm_set1_pd(dtemp);
+              for (; jt + 2 <= nbParam; jt += 2) {
+                __m128d h = _mm_loadu_pd(H_ + jt);
+                if (firstOrder && secondOrder) {
+                  h = _mm_add_pd(h, _mm_add_pd(_mm_mul_pd(_mm_mul_pd(vdprt, _mm_loadu_pd(dprtemp + jt)), vPrt_Pt),
+                                               _mm_mul_pd(_mm_loadu_pd(d2Prt_ + jt), vdtemp)));
+                } else if (secondOrder) {
+                  h = _mm_add_pd(h, _mm_mul_pd(_mm_loadu_pd(d2Prt_ + jt), vdtemp));
+                } else {
+                  h = _mm_add_pd(h, _mm_mul_pd(_mm_mul_pd(vdprt, _mm_loadu_pd(dprtemp + jt)), vPrt_Pt));
+                }
+                _mm_storeu_pd(H_ + jt, h);
+              }
+            }
+#endif
+            for (; jt < nbParam; jt++) {
+              if (firstOrder && secondOrder)
+                H_[jt] += dprtemp[it] * dprtemp[jt] * Prt_Pt_ + d2Prt_[jt] * dtemp;
+              else if (secondOrder)
+                H_[jt] += d2Prt_[jt] * dtemp;
               else
-                Hessian[it][jt] += dprtemp[it] * dprtemp[jt] * Prt_Pt_;
+                H_[jt] += dprtemp[it] * dprtemp[jt] * Prt_Pt_;
             }
           }
         }
@@ -596,6 +649,8 @@ void vpTemplateTrackerMI::zeroProbabilities()
   memset(dPrt, 0, Ncb2_nbParam_);
   memset(d2Prt, 0, Ncb2_nbParam2_);
   memset(PrtTout, 0, Nc_ * Nc_ * influBspline_ * (1 + nbParam + nbParam * nbParam) * sizeof(double));
+
+  miHistogram.reset(Nc, bspline, nbParam, reducedPrecision);
 }
 
 double vpTemplateTrackerMI::getMI(const vpImage<unsigned char> &I, int &nc, const int &bspline_, vpColVector &tp)
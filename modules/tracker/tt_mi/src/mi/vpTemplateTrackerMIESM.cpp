@@ -40,10 +40,6 @@
 
 #include <visp3/tt_mi/vpTemplateTrackerMIESM.h>
 
-#ifdef VISP_HAVE_OPENMP
-#include <omp.h>
-#endif
-
 vpTemplateTrackerMIESM::vpTemplateTrackerMIESM(vpTemplateTrackerWarp *_warp)
   : vpTemplateTrackerMI(_warp), minimizationMethod(USE_NEWTON), CompoInitialised(false), HDirect(), HInverse(),
     HdesireDirect(), HdesireInverse(), GDirect(), GInverse()
@@ -73,11 +69,14 @@ void vpTemplateTrackerMIESM::initHessienDesired(const vpImage<unsigned char> &I)
   Nbpoint = 0;
 
   if (blur)
-    vpImageFilter::filter(I, BI, fgG, taillef);
+    getGaussianBluredImage(I);
 
   zeroProbabilities();
 
   vpColVector tptemp(nbParam);
+  vpTemplateTrackerMIHistogram::vpDerivativeType derivativeType = vpTemplateTrackerMIHistogram::SECOND_DERIVATIVES;
+  if (ApproxHessian == HESSIAN_NONSECOND)
+    derivativeType = vpTemplateTrackerMIHistogram::FIRST_DERIVATIVES;
 
   Warp->computeCoeff(p);
   for (unsigned int point = 0; point < templateSize; point++) {
@@ -105,17 +104,17 @@ void vpTemplateTrackerMIESM::initHessienDesired(const vpImage<unsigned char> &I)
       cr = static_cast<int>((IW*(Nc-1))/255.);
       er = (IW*(Nc-1))/255.-cr;
 
-      vpTemplateTrackerMIBSpline::computeProbabilities(PrtTout, cr, er, ct, et, Nc, ptTemplate[point].dW, nbParam, bspline, ApproxHessian, false);
+      miHistogram.addSample(cr, er, ct, et, ptTemplate[point].dW);
     }
   }
+  miHistogram.accumulate(PrtTout, derivativeType);
 
   double MI;
   computeProba(Nbpoint);
   computeMI(MI);
   computeHessien(HdesireInverse);
 
-  vpImageFilter::getGradXGauss2D(I, dIx, fgG, fgdG, taillef);
-  vpImageFilter::getGradYGauss2D(I, dIy, fgG, fgdG, taillef);
+  getGaussianGradients(I);
   if (ApproxHessian != HESSIAN_NONSECOND && ApproxHessian != HESSIAN_0 && ApproxHessian != HESSIAN_NEW &&
       ApproxHessian != HESSIAN_YOUCEF) {
     vpImageFilter::getGradX(dIx, d2Ix, fgdG, taillef);
@@ -160,9 +159,10 @@ void vpTemplateTrackerMIESM::initHessienDesired(const vpImage<unsigned char> &I)
       for (unsigned int it = 0; it < nbParam; it++)
         tptemp[it] = dW[0][it] * dx + dW[1][it] * dy;
 
-      vpTemplateTrackerMIBSpline::computeProbabilities(PrtTout, cr, er, ct, et, Nc, tptemp.data, nbParam, bspline, ApproxHessian, false);
+      miHistogram.addSample(cr, er, ct, et, tptemp.data);
     }
   }
+  miHistogram.accumulate(PrtTout, derivativeType);
 
   computeProba(Nbpoint);
   computeMI(MI);
@@ -188,6 +188,7 @@ void vpTemplateTrackerMIESM::initCompInverse()
 
   ptTemplateSupp = new vpTemplateTrackerPointSuppMIInv[templateSize];
   ptTemplateCompo = new vpTemplateTrackerPointCompo[templateSize];
+  initTemplateData(nbParam, 0, 2 * nbParam);
   for (unsigned int point = 0; point < templateSize; point++) {
     int i = ptTemplate[point].y;
     int j = ptTemplate[point].x;
@@ -195,10 +196,8 @@ void vpTemplateTrackerMIESM::initCompInverse()
     X1[1] = i;
     Warp->computeDenom(X1, p);
 
-    ptTemplateCompo[point].dW = new double[2 * nbParam];
     Warp->getdWdp0(i, j, ptTemplateCompo[point].dW);
 
-    ptTemplate[point].dW = new double[nbParam];
     double dx = ptTemplate[point].dx * (Nc - 1) / 255.;
     double dy = ptTemplate[point].dy * (Nc - 1) / 255.;
     Warp->getdW0(i, j, dy, dx, ptTemplate[point].dW);
@@ -226,9 +225,8 @@ void vpTemplateTrackerMIESM::trackNoPyr(const vpImage<unsigned char> &I)
   dW = 0;
 
   if (blur)
-    vpImageFilter::filter(I, BI, fgG, taillef);
-  vpImageFilter::getGradXGauss2D(I, dIx, fgG, fgdG, taillef);
-  vpImageFilter::getGradYGauss2D(I, dIy, fgG, fgdG, taillef);
+    getGaussianBluredImage(I);
+  getGaussianGradients(I);
 
   int point;
 
@@ -248,6 +246,9 @@ void vpTemplateTrackerMIESM::trackNoPyr(const vpImage<unsigned char> &I)
   int i, j;
   unsigned int iteration = 0;
   vpColVector tptemp(nbParam);
+  vpTemplateTrackerMIHistogram::vpDerivativeType derivativeType = vpTemplateTrackerMIHistogram::SECOND_DERIVATIVES;
+  if (ApproxHessian == HESSIAN_NONSECOND || hessianComputation == USE_HESSIEN_DESIRE)
+    derivativeType = vpTemplateTrackerMIHistogram::FIRST_DERIVATIVES;
 
   do {
     int Nbpoint = 0;
@@ -283,9 +284,10 @@ void vpTemplateTrackerMIESM::trackNoPyr(const vpImage<unsigned char> &I)
         cr = static_cast<int>((IW*(Nc-1))/255.);
         er = (IW*(Nc-1))/255.-cr;
 
-        vpTemplateTrackerMIBSpline::computeProbabilities(PrtTout, cr, er, ct, et, Nc, ptTemplate[point].dW, nbParam, bspline, ApproxHessian, hessianComputation==USE_HESSIEN_DESIRE);
+        miHistogram.addSample(cr, er, ct, et, ptTemplate[point].dW);
       }
     }
+    miHistogram.accumulate(PrtTout, derivativeType);
 
     if (Nbpoint == 0) {
       diverge = true;
@@ -309,13 +311,6 @@ void vpTemplateTrackerMIESM::trackNoPyr(const vpImage<unsigned char> &I)
       zeroProbabilities();
 
       Warp->computeCoeff(p);
-#ifdef VISP_HAVE_OPENMP
-      int nthreads = omp_get_num_procs();
-      // std::cout << "file: " __FILE__ << " line: " << __LINE__ << "
-      // function: " << __FUNCTION__ << " nthread: " << nthreads << std::endl;
-      omp_set_num_threads(nthreads);
-#pragma omp parallel for private(point, i, j, i2, j2) default(shared)
-#endif
       for (point = 0; point < static_cast<int>(templateSize); point++) {
         i = ptTemplate[point].y;
         j = ptTemplate[point].x;
@@ -346,9 +341,10 @@ void vpTemplateTrackerMIESM::trackNoPyr(const vpImage<unsigned char> &I)
           for (unsigned int it = 0; it < nbParam; it++)
             tptemp[it] = dW[0][it] * dx + dW[1][it] * dy;
 
-          vpTemplateTrackerMIBSpline::computeProbabilities(PrtTout,cr, er, ct, et, Nc, tptemp.data, nbParam, bspline, ApproxHessian, hessianComputation==USE_HESSIEN_DESIRE);
+          miHistogram.addSample(cr, er, ct, et, tptemp.data);
         }
       }
+      miHistogram.accumulate(PrtTout, derivativeType);
 
       computeProba(Nbpoint);
       computeMI(MI);
@@ -40,10 +40,6 @@
 
 #include <visp3/tt_mi/vpTemplateTrackerMIForwardAdditional.h>
 
-#ifdef VISP_HAVE_OPENMP
-#include <omp.h>
-#endif
-
 vpTemplateTrackerMIForwardAdditional::vpTemplateTrackerMIForwardAdditional(vpTemplateTrackerWarp *_warp)
   : vpTemplateTrackerMI(_warp), minimizationMethod(USE_NEWTON), p_prec(), G_prec(), KQuasiNewton()
 {
@@ -57,9 +53,8 @@ void vpTemplateTrackerMIForwardAdditional::initHessienDesired(const vpImage<unsi
   int Nbpoint = 0;
 
   if (blur)
-    vpImageFilter::filter(I, BI, fgG, taillef);
-  vpImageFilter::getGradXGauss2D(I, dIx, fgG, fgdG, taillef);
-  vpImageFilter::getGradYGauss2D(I, dIy, fgG, fgdG, taillef);
+    getGaussianBluredImage(I);
+  getGaussianGradients(I);
 
   double Tij;
   double IW, dx, dy;
@@ -69,6 +64,7 @@ void vpTemplateTrackerMIForwardAdditional::initHessienDesired(const vpImage<unsi
   Nbpoint = 0;
 
   zeroProbabilities();
+  std::vector<double> tptemp(nbParam);
   Warp->computeCoeff(p);
   for (unsigned int point = 0; point < templateSize; point++) {
     int i = ptTemplate[point].y;
@@ -101,18 +97,17 @@ void vpTemplateTrackerMIForwardAdditional::initHessienDesired(const vpImage<unsi
       er = (static_cast<double>(Tij) * (Nc - 1)) / 255. - cr;
       Warp->dWarp(X1, X2, p, dW);
 
-      double *tptemp = new double[nbParam];
       for (unsigned int it = 0; it < nbParam; it++)
         tptemp[it] = dW[0][it] * dx + dW[1][it] * dy;
 
-      if (ApproxHessian == HESSIAN_NONSECOND)
-        vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
-      else if (ApproxHessian == HESSIAN_0 || ApproxHessian == HESSIAN_NEW)
-        vpTemplateTrackerMIBSpline::PutTotPVBspline(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
-
-      delete[] tptemp;
+      if (ApproxHessian == HESSIAN_NONSECOND || ApproxHessian == HESSIAN_0 || ApproxHessian == HESSIAN_NEW)
+        miHistogram.addSample(cr, er, ct, et, &tptemp[0]);
     }
   }
+  if (ApproxHessian == HESSIAN_NONSECOND)
+    miHistogram.accumulate(PrtTout, vpTemplateTrackerMIHistogram::FIRST_DERIVATIVES);
+  else
+    miHistogram.accumulate(PrtTout, vpTemplateTrackerMIHistogram::SECOND_DERIVATIVES);
 
   if (Nbpoint > 0) {
     double MI;
@@ -135,9 +130,8 @@ void vpTemplateTrackerMIForwardAdditional::trackNoPyr(const vpImage<unsigned cha
 
   int Nbpoint = 0;
   if (blur)
-    vpImageFilter::filter(I, BI, fgG, taillef);
-  vpImageFilter::getGradXGauss2D(I, dIx, fgG, fgdG, taillef);
-  vpImageFilter::getGradYGauss2D(I, dIy, fgG, fgdG, taillef);
+    getGaussianBluredImage(I);
+  getGaussianGradients(I);
 
   double MI = 0, MIprec = -1000;
 
@@ -151,6 +145,7 @@ void vpTemplateTrackerMIForwardAdditional::trackNoPyr(const vpImage<unsigned cha
   double evolRMS_init = 0;
   double evolRMS_prec = 0;
   double evolRMS_delta;
+  std::vector<double> tptemp(nbParam);
 
   do {
     if (iteration % 5 == 0)
@@ -161,15 +156,10 @@ void vpTemplateTrackerMIForwardAdditional::trackNoPyr(const vpImage<unsigned cha
     // erreur=0;
 
     zeroProbabilities();
+    bool firstDerivatives =
+        (ApproxHessian == HESSIAN_NONSECOND || hessianComputation == vpTemplateTrackerMI::USE_HESSIEN_DESIRE);
 
     Warp->computeCoeff(p);
-#ifdef VISP_HAVE_OPENMP
-    int nthreads = omp_get_num_procs();
-    // std::cout << "file: " __FILE__ << " line: " << __LINE__ << " function:
-    // " << __FUNCTION__ << " nthread: " << nthreads << std::endl;
-    omp_set_num_threads(nthreads);
-#pragma omp parallel for default(shared)
-#endif
     for (int point = 0; point < (int)templateSize; point++) {
       int i = ptTemplate[point].y;
       int j = ptTemplate[point].x;
@@ -201,18 +191,16 @@ void vpTemplateTrackerMIForwardAdditional::trackNoPyr(const vpImage<unsigned cha
 
         Warp->dWarp(X1, X2, p, dW);
 
-        double *tptemp = new double[nbParam];
-        ;
         for (unsigned int it = 0; it < nbParam; it++)
           tptemp[it] = (dW[0][it] * dx + dW[1][it] * dy);
-        if (ApproxHessian == HESSIAN_NONSECOND || hessianComputation == vpTemplateTrackerMI::USE_HESSIEN_DESIRE)
-          vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
-        else if (ApproxHessian == HESSIAN_0 || ApproxHessian == HESSIAN_NEW)
-          vpTemplateTrackerMIBSpline::PutTotPVBspline(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
-
-        delete[] tptemp;
+        if (firstDerivatives || ApproxHessian == HESSIAN_0 || ApproxHessian == HESSIAN_NEW)
+          miHistogram.addSample(cr, er, ct, et, &tptemp[0]);
       }
     }
+    if (firstDerivatives)
+      miHistogram.accumulate(PrtTout, vpTemplateTrackerMIHistogram::FIRST_DERIVATIVES);
+    else
+      miHistogram.accumulate(PrtTout, vpTemplateTrackerMIHistogram::SECOND_DERIVATIVES);
 
     if (Nbpoint == 0) {
       diverge = true;
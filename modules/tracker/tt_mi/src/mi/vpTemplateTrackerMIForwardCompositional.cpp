@@ -47,13 +47,13 @@ vpTemplateTrackerMIForwardCompositional::vpTemplateTrackerMIForwardCompositional
 void vpTemplateTrackerMIForwardCompositional::initCompo()
 {
   ptTemplateSupp = new vpTemplateTrackerPointSuppMIInv[templateSize];
+  initTemplateData(2 * nbParam);
   for (unsigned int point = 0; point < templateSize; point++) {
     int i = ptTemplate[point].y;
     int j = ptTemplate[point].x;
     X1[0] = j;
     X1[1] = i;
     Warp->computeDenom(X1, p);
-    ptTemplate[point].dW = new double[2 * nbParam];
     Warp->getdWdp0(i, j, ptTemplate[point].dW);
 
     double Tij = ptTemplate[point].val;
@@ -77,9 +77,8 @@ void vpTemplateTrackerMIForwardCompositional::initHessienDesired(const vpImage<u
   dW = 0;
 
   if (blur)
-    vpImageFilter::filter(I, BI, fgG, taillef);
-  vpImageFilter::getGradXGauss2D(I, dIx, fgG, fgdG, taillef);
-  vpImageFilter::getGradYGauss2D(I, dIy, fgG, fgdG, taillef);
+    getGaussianBluredImage(I);
+  getGaussianGradients(I);
 
   int Nbpoint = 0;
 
@@ -90,6 +89,7 @@ void vpTemplateTrackerMIForwardCompositional::initHessienDesired(const vpImage<u
   Nbpoint = 0;
 
   zeroProbabilities();
+  std::vector<double> tptemp(nbParam);
 
   Warp->computeCoeff(p);
   for (unsigned int point = 0; point < templateSize; point++) {
@@ -121,15 +121,13 @@ void vpTemplateTrackerMIForwardCompositional::initHessienDesired(const vpImage<u
 
       Warp->dWarpCompo(X1, X2, p, ptTemplate[point].dW, dW);
 
-      double *tptemp = new double[nbParam];
       for (unsigned int it = 0; it < nbParam; it++)
         tptemp[it] = dW[0][it] * dx + dW[1][it] * dy;
 
-      vpTemplateTrackerMIBSpline::PutTotPVBspline(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
-
-      delete[] tptemp;
+      miHistogram.addSample(cr, er, ct, et, &tptemp[0]);
     }
   }
+  miHistogram.accumulate(PrtTout, vpTemplateTrackerMIHistogram::SECOND_DERIVATIVES);
   double MI;
   computeProba(Nbpoint);
   computeMI(MI);
@@ -149,10 +147,9 @@ void vpTemplateTrackerMIForwardCompositional::trackNoPyr(const vpImage<unsigned
   dW = 0;
 
   if (blur) {
-    vpImageFilter::filter(I, BI, fgG, taillef);
+    getGaussianBluredImage(I);
   }
-  vpImageFilter::getGradXGauss2D(I, dIx, fgG, fgdG, taillef);
-  vpImageFilter::getGradYGauss2D(I, dIy, fgG, fgdG, taillef);
+  getGaussianGradients(I);
 
   lambda = lambdaDep;
   double MI = 0, MIprec = -1000;
@@ -176,6 +173,7 @@ void vpTemplateTrackerMIForwardCompositional::trackNoPyr(const vpImage<unsigned
   double evolRMS_init = 0;
   double evolRMS_prec = 0;
   double evolRMS_delta;
+  std::vector<double> tptemp(nbParam);
 
   do {
     int Nbpoint = 0;
@@ -183,6 +181,8 @@ void vpTemplateTrackerMIForwardCompositional::trackNoPyr(const vpImage<unsigned
     MI = 0;
 
     zeroProbabilities();
+    bool firstDerivatives =
+        (ApproxHessian == HESSIAN_NONSECOND || hessianComputation == vpTemplateTrackerMI::USE_HESSIEN_DESIRE);
 
     Warp->computeCoeff(p);
 
@@ -213,18 +213,17 @@ void vpTemplateTrackerMIForwardCompositional::trackNoPyr(const vpImage<unsigned
 
         Warp->dWarpCompo(X1, X2, p, ptTemplate[point].dW, dW);
 
-        double *tptemp = new double[nbParam];
         for (unsigned int it = 0; it < nbParam; it++)
           tptemp[it] = dW[0][it] * dx + dW[1][it] * dy;
 
-        if (ApproxHessian == HESSIAN_NONSECOND || hessianComputation == vpTemplateTrackerMI::USE_HESSIEN_DESIRE)
-          vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
-        else if (ApproxHessian == HESSIAN_0 || ApproxHessian == HESSIAN_NEW)
-          vpTemplateTrackerMIBSpline::PutTotPVBspline(PrtTout, cr, er, ct, et, Nc, tptemp, nbParam, bspline);
-
-        delete[] tptemp;
+        if (firstDerivatives || ApproxHessian == HESSIAN_0 || ApproxHessian == HESSIAN_NEW)
+          miHistogram.addSample(cr, er, ct, et, &tptemp[0]);
       }
     }
+    if (firstDerivatives)
+      miHistogram.accumulate(PrtTout, vpTemplateTrackerMIHistogram::FIRST_DERIVATIVES);
+    else
+      miHistogram.accumulate(PrtTout, vpTemplateTrackerMIHistogram::SECOND_DERIVATIVES);
     if (Nbpoint == 0) {
       diverge = true;
       MI = 0;
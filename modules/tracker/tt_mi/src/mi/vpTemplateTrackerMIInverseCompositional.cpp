@@ -90,8 +90,7 @@ void vpTemplateTrackerMIInverseCompositional::initCompInverse(const vpImage<unsi
 {
   ptTemplateSupp = new vpTemplateTrackerPointSuppMIInv[templateSize];
 
-  vpImageFilter::getGradXGauss2D(I, dIx, fgG, fgdG, taillef);
-  vpImageFilter::getGradYGauss2D(I, dIy, fgG, fgdG, taillef);
+  getGaussianGradients(I);
 
   if (ApproxHessian != HESSIAN_NONSECOND && ApproxHessian != HESSIAN_0 && ApproxHessian != HESSIAN_NEW &&
       ApproxHessian != HESSIAN_YOUCEF) {
@@ -101,12 +100,11 @@ void vpTemplateTrackerMIInverseCompositional::initCompInverse(const vpImage<unsi
   }
   double Nc_255_ = (Nc - 1) / 255.;
   Warp->computeCoeff(p);
+  initTemplateData(nbParam);
   for (unsigned int point = 0; point < templateSize; point++) {
     int i = ptTemplate[point].y;
     int j = ptTemplate[point].x;
 
-    ptTemplate[point].dW = new double[nbParam];
-
     double dx = ptTemplate[point].dx * Nc_255_;
     double dy = ptTemplate[point].dy * Nc_255_;
 
@@ -133,9 +131,14 @@ void vpTemplateTrackerMIInverseCompositional::initHessienDesired(const vpImage<u
   Nbpoint = 0;
 
   if (blur)
-    vpImageFilter::filter(I, BI, fgG, taillef);
+    getGaussianBluredImage(I);
 
   zeroProbabilities();
+  vpTemplateTrackerMIHistogram::vpDerivativeType derivativeType = vpTemplateTrackerMIHistogram::HISTOGRAM_ONLY;
+  if (ApproxHessian == HESSIAN_NONSECOND)
+    derivativeType = vpTemplateTrackerMIHistogram::FIRST_DERIVATIVES;
+  else if (ApproxHessian == HESSIAN_0 || ApproxHessian == HESSIAN_NEW)
+    derivativeType = vpTemplateTrackerMIHistogram::SECOND_DERIVATIVES;
   Warp->computeCoeff(p);
 
   for (unsigned int point = 0; point < templateSize; point++) {
@@ -163,20 +166,11 @@ void vpTemplateTrackerMIInverseCompositional::initHessienDesired(const vpImage<u
       cr = static_cast<int>((IW * (Nc - 1)) / 255.);
       er = (IW * (Nc - 1)) / 255. - cr;
 
-      if (ApproxHessian == HESSIAN_NONSECOND && (ptTemplateSelect[point] || !useTemplateSelect)) {
-        vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(PrtTout, cr, er, ct, et, Nc, ptTemplate[point].dW, nbParam,
-                                                            bspline);
-      } else if ((ApproxHessian == HESSIAN_0 || ApproxHessian == HESSIAN_NEW) &&
-                 (ptTemplateSelect[point] || !useTemplateSelect)) {
-        if (bspline == 3) {
-          vpTemplateTrackerMIBSpline::PutTotPVBspline3(PrtTout, cr, er, ct, et, Nc, ptTemplate[point].dW, nbParam);
-        } else {
-          vpTemplateTrackerMIBSpline::PutTotPVBspline4(PrtTout, cr, er, ct, et, Nc, ptTemplate[point].dW, nbParam);
-        }
-      } else if (ptTemplateSelect[point] || !useTemplateSelect)
-        vpTemplateTrackerMIBSpline::PutTotPVBsplinePrt(PrtTout, cr, er, ct, et, Nc, nbParam, bspline);
+      if (ptTemplateSelect[point] || !useTemplateSelect)
+        miHistogram.addSample(cr, er, ct, et, ptTemplate[point].dW);
     }
   }
+  miHistogram.accumulate(PrtTout, derivativeType);
 
   double MI;
   computeProba(Nbpoint);
@@ -200,7 +194,7 @@ void vpTemplateTrackerMIInverseCompositional::trackNoPyr(const vpImage<unsigned
   dW = 0;
 
   if (blur)
-    vpImageFilter::filter(I, BI, fgG, taillef);
+    getGaussianBluredImage(I);
 
   lambda = lambdaDep;
   double MI = 0, MIprec = -1000;
@@ -232,27 +226,18 @@ void vpTemplateTrackerMIInverseCompositional::trackNoPyr(const vpImage<unsigned
     MI = 0;
 
     zeroProbabilities();
+    vpTemplateTrackerMIHistogram::vpDerivativeType derivativeType = vpTemplateTrackerMIHistogram::SECOND_DERIVATIVES;
+    if (ApproxHessian == HESSIAN_NONSECOND || hessianComputation == vpTemplateTrackerMI::USE_HESSIEN_DESIRE)
+      derivativeType = vpTemplateTrackerMIHistogram::FIRST_DERIVATIVES;
 
-    Warp->computeCoeff(p);
+    warpTemplate(p);
+    getWarpedIntensities(I);
 
     for (int point = 0; point < static_cast<int>(templateSize); point++) {
-      X1[0] = static_cast<double>(ptTemplate[point].x);
-      X1[1] = static_cast<double>(ptTemplate[point].y);
-
-      Warp->computeDenom(X1, p);
-      Warp->warpX(X1, X2, p);
-
-      double j2 = X2[0];
-      double i2 = X2[1];
-
-      if ((i2 >= 0) && (j2 >= 0) && (i2 < I.getHeight() - 1) && (j2 < I.getWidth() - 1)) {
+      if (warpedInside[point]) {
 
         Nbpoint++;
-        double IW;
-        if (!blur)
-          IW = static_cast<double>(I.getValue(i2, j2));
-        else
-          IW = BI.getValue(i2, j2);
+        double IW = warpedIntensity[point];
 
         int ct = ptTemplateSupp[point].ct;
         double et = ptTemplateSupp[point].et;
@@ -260,23 +245,14 @@ void vpTemplateTrackerMIInverseCompositional::trackNoPyr(const vpImage<unsigned
         int cr = static_cast<int>(tmp);
         double er = tmp - static_cast<double>(cr);
 
-        if ((ApproxHessian == HESSIAN_NONSECOND || hessianComputation == vpTemplateTrackerMI::USE_HESSIEN_DESIRE) &&
-            (ptTemplateSelect[point] || !useTemplateSelect)) {
-          vpTemplateTrackerMIBSpline::PutTotPVBsplineNoSecond(Prt, dPrt, cr, er, ct, et, Ncb, ptTemplate[point].dW,
-                                                              nbParam, bspline);
-        } else if (ptTemplateSelect[point] || !useTemplateSelect) {
-          if (bspline == 3) {
-            vpTemplateTrackerMIBSpline::PutTotPVBspline3(Prt, dPrt, d2Prt, cr, er, ct, et, Ncb,
-                                                         ptTemplate[point].dW, nbParam);
-          } else {
-            vpTemplateTrackerMIBSpline::PutTotPVBspline4(Prt, dPrt, d2Prt, cr, er, ct, et, Ncb,
-                                                         ptTemplate[point].dW, nbParam);
-          }
-        } else {
-          vpTemplateTrackerMIBSpline::PutTotPVBsplinePrt(Prt, cr, er, ct, et, Ncb, nbParam, bspline);
-        }
+        // The points that are not selected only contribute to the histogram
+        if (ptTemplateSelect[point] || !useTemplateSelect)
+          miHistogram.addSample(cr, er, ct, et, ptTemplate[point].dW);
+        else
+          miHistogram.addSample(cr, er, ct, et);
       }
     }
+    miHistogram.accumulate(Prt, dPrt, d2Prt, derivativeType);
 
     if (Nbpoint == 0) {
       diverge = true;
@@ -284,20 +260,7 @@ void vpTemplateTrackerMIInverseCompositional::trackNoPyr(const vpImage<unsigned
       throw(vpTrackingException(vpTrackingException::notEnoughPointError, "No points in the template"));
 
     } else {
-      unsigned int indd, indd2;
-      indd = indd2 = 0;
-      unsigned int Ncb_ = static_cast<unsigned int>(Ncb);
-      for (unsigned int i = 0; i < Ncb_ * Ncb_; i++) {
-        Prt[i] /= Nbpoint;
-        for (unsigned int j = 0; j < nbParam; j++) {
-          dPrt[indd] /= Nbpoint;
-          indd++;
-          for (unsigned int k = 0; k < nbParam; k++) {
-            d2Prt[indd2] /= Nbpoint;
-            indd2++;
-          }
-        }
-      }
+      normalizeProbabilities(Nbpoint);
 
       computeMI(MI);
 
@@ -0,0 +1,466 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Joint histogram accumulation of the mutual information template trackers.
+ *
+ *****************************************************************************/
+
+#include <algorithm>
+
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpThreadPool.h>
+#include <visp3/tt_mi/vpTemplateTrackerMIBSpline.h>
+#include <visp3/tt_mi/vpTemplateTrackerMIHistogram.h>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+namespace
+{
+// Smallest number of samples accumulated in a private histogram
+const unsigned int minBlockSize = 2048;
+// Largest number of private histograms
+const unsigned int maxNbBlocks = 16;
+
+// dst[i] += a * x[i] for i < n
+inline void addScaled(double *dst, double a, const double *x, unsigned int n, bool useSSE2)
+{
+  unsigned int i = 0;
+#if VISP_HAVE_SSE2
+  if (useSSE2) {
+    const __m128d va = _mm_set1_pd(a);
+    for (; i + 2 <= n; i += 2) {
+      _mm_storeu_pd(dst + i, _mm_add_pd(_mm_loadu_pd(dst + i), _mm_mul_pd(va, _mm_loadu_pd(x + i))));
+    }
+  }
+#else
+  (void)useSSE2;
+#endif
+  for (; i < n; i++) {
+    dst[i] += a * x[i];
+  }
+}
+
+inline void addScaled(float *dst, float a, const float *x, unsigned int n, bool useSSE2)
+{
+  unsigned int i = 0;
+#if VISP_HAVE_SSE2
+  if (useSSE2) {
+    const __m128 va = _mm_set1_ps(a);
+    for (; i + 4 <= n; i += 4) {
+      _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(va, _mm_loadu_ps(x + i))));
+    }
+  }
+#else
+  (void)useSSE2;
+#endif
+  for (; i < n; i++) {
+    dst[i] += a * x[i];
+  }
+}
+} // namespace
+
+class vpTemplateTrackerMIHistogram::AccumulateBody : public vpParallelForBody
+{
+public:
+  explicit AccumulateBody(vpTemplateTrackerMIHistogram &histogram) : m_histogram(histogram) {}
+  void operator()(int begin, int end)
+  {
+    for (int block = begin; block < end; block++) {
+      m_histogram.accumulateBlock(static_cast<unsigned int>(block));
+    }
+  }
+
+private:
+  vpTemplateTrackerMIHistogram &m_histogram;
+};
+
+class vpTemplateTrackerMIHistogram::MergeBody : public vpParallelForBody
+{
+public:
+  explicit MergeBody(vpTemplateTrackerMIHistogram &histogram) : m_histogram(histogram) {}
+  void operator()(int begin, int end) { m_histogram.mergeBlocks(begin, end); }
+
+private:
+  vpTemplateTrackerMIHistogram &m_histogram;
+};
+
+vpTemplateTrackerMIHistogram::vpTemplateTrackerMIHistogram()
+  : Nc(0), bspline(3), nbParam(0), reducedPrecision(false), nbSamples(0), bins(), fractions(), derivatives(),
+    hasDerivatives(), weights(), cells(), direct(false), derivativeType(HISTOGRAM_ONLY), nbBlocks(0), blockSize(0),
+    histogramSize(0), blocks(), blocksF()
+{
+  for (unsigned int i = 0; i < 3; i++) {
+    dst[i] = NULL;
+    dstSize[i] = 0;
+  }
+}
+
+/*
+  Forget the samples of the previous accumulation and set the histogram
+  dimensions: nc bins, B-spline of order bspline (3 or 4) and derivatives
+  with respect to nbParam parameters.
+*/
+void vpTemplateTrackerMIHistogram::reset(int nc, int bspline_, unsigned int nbParam_, bool reducedPrecision_)
+{
+  Nc = nc;
+  bspline = bspline_;
+  nbParam = nbParam_;
+  reducedPrecision = reducedPrecision_;
+
+  nbSamples = 0;
+  bins.clear();
+  fractions.clear();
+  derivatives.clear();
+  hasDerivatives.clear();
+}
+
+/*
+  Record a template point whose current intensity falls in bin cr with
+  fractional part er and reference intensity in bin ct with fractional part
+  et. val holds the nbParam derivatives of the intensity along t with respect
+  to the warp parameters; when NULL, the point only contributes to the joint
+  histogram.
+*/
+void vpTemplateTrackerMIHistogram::addSample(int cr, double er, int ct, double et, const double *val)
+{
+  bins.push_back(cr);
+  bins.push_back(ct);
+  fractions.push_back(er);
+  fractions.push_back(et);
+  derivatives.resize(derivatives.size() + nbParam);
+  if (val != NULL) {
+    std::copy(val, val + nbParam, derivatives.end() - nbParam);
+  }
+  hasDerivatives.push_back(val != NULL);
+  nbSamples++;
+}
+
+/*
+  Add the contributions of the samples to PrtTout, where each (r, t) bin owns
+  bspline * bspline cells of 1 + nbParam + nbParam * nbParam values as
+  expected by vpTemplateTrackerMI::computeProba().
+*/
+void vpTemplateTrackerMIHistogram::accumulate(double *PrtTout, vpDerivativeType type)
+{
+  accumulate(PrtTout, NULL, NULL, false, type);
+}
+
+/*
+  Add the contributions of the samples directly to the joint histogram Prt of
+  (Nc + bspline)^2 bins and to its first and second derivatives dPrt and
+  d2Prt.
+*/
+void vpTemplateTrackerMIHistogram::accumulate(double *Prt, double *dPrt, double *d2Prt, vpDerivativeType type)
+{
+  accumulate(Prt, dPrt, d2Prt, true, type);
+}
+
+void vpTemplateTrackerMIHistogram::accumulate(double *Prt, double *dPrt, double *d2Prt, bool direct_,
+                                              vpDerivativeType type)
+{
+  if (nbSamples == 0) {
+    return;
+  }
+
+  direct = direct_;
+  derivativeType = type;
+  dst[0] = Prt;
+  dst[1] = dPrt;
+  dst[2] = d2Prt;
+  if (direct) {
+    unsigned int Ncb2 = static_cast<unsigned int>((Nc + bspline) * (Nc + bspline));
+    dstSize[0] = Ncb2;
+    dstSize[1] = (type != HISTOGRAM_ONLY) ? Ncb2 * nbParam : 0;
+    dstSize[2] = (type == SECOND_DERIVATIVES) ? Ncb2 * nbParam * nbParam : 0;
+  } else {
+    dstSize[0] = static_cast<unsigned int>(Nc * Nc * bspline * bspline) * (1 + nbParam + nbParam * nbParam);
+    dstSize[1] = dstSize[2] = 0;
+  }
+  histogramSize = dstSize[0] + dstSize[1] + dstSize[2];
+
+  // The partition only depends on the number of samples and of bins so that
+  // the summation order does not depend on the number of threads
+  unsigned int minSize = std::max<unsigned int>(minBlockSize, static_cast<unsigned int>(8 * Nc * Nc));
+  nbBlocks = std::min<unsigned int>(maxNbBlocks, (nbSamples + minSize - 1) / minSize);
+  blockSize = (nbSamples + nbBlocks - 1) / nbBlocks;
+
+  weights.resize(16 * nbSamples);
+  cells.resize(2 * nbSamples);
+  if (reducedPrecision) {
+    blocksF.resize(nbBlocks);
+  } else if (blocks.size() < nbBlocks - 1) {
+    blocks.resize(nbBlocks - 1);
+  }
+
+  AccumulateBody body(*this);
+  vpThreadPool::instance().parallel_for(0, static_cast<int>(nbBlocks), body);
+
+  if (reducedPrecision || nbBlocks > 1) {
+    MergeBody merge(*this);
+    vpThreadPool::instance().parallel_for(0, static_cast<int>(histogramSize), merge, 4096);
+  }
+}
+
+void vpTemplateTrackerMIHistogram::accumulateBlock(unsigned int block)
+{
+  unsigned int first = block * blockSize;
+  unsigned int last = std::min(nbSamples, first + blockSize);
+  computeWeights(first, last);
+
+  if (reducedPrecision) {
+    std::vector<float> &buffer = blocksF[block];
+    buffer.resize(histogramSize);
+    std::fill(buffer.begin(), buffer.end(), 0.f);
+    float *Prt = &buffer[0];
+    accumulateSamples(first, last, Prt, Prt + dstSize[0], Prt + dstSize[0] + dstSize[1]);
+  } else if (block == 0) {
+    accumulateSamples(first, last, dst[0], dst[1], dst[2]);
+  } else {
+    std::vector<double> &buffer = blocks[block - 1];
+    buffer.resize(histogramSize);
+    std::fill(buffer.begin(), buffer.end(), 0.);
+    double *Prt = &buffer[0];
+    accumulateSamples(first, last, Prt, Prt + dstSize[0], Prt + dstSize[0] + dstSize[1]);
+  }
+}
+
+/*
+  Compute the first bins and the B-spline weights of the samples in
+  [first, last). For the third order B-spline, the fractional parts above 0.5
+  are moved to the next bin.
+*/
+void vpTemplateTrackerMIHistogram::computeWeights(unsigned int first, unsigned int last)
+{
+  double (*B)(double);
+  double (*dB)(double);
+  double (*d2B)(double);
+  if (bspline == 3) {
+    B = &vpTemplateTrackerMIBSpline::Bspline3;
+    dB = &vpTemplateTrackerMIBSpline::dBspline3;
+    d2B = &vpTemplateTrackerMIBSpline::d2Bspline3;
+  } else {
+    B = &vpTemplateTrackerBSpline::Bspline4;
+    dB = &vpTemplateTrackerMIBSpline::dBspline4;
+    d2B = &vpTemplateTrackerMIBSpline::d2Bspline4;
+  }
+  int nbW = bspline;
+
+  for (unsigned int s = first; s < last; s++) {
+    int cr = bins[2 * s];
+    int ct = bins[2 * s + 1];
+    double er = fractions[2 * s];
+    double et = fractions[2 * s + 1];
+    if (bspline == 3) {
+      if (er > 0.5) {
+        cr++;
+        er = er - 1;
+      }
+      if (et > 0.5) {
+        ct++;
+        et = et - 1;
+      }
+    }
+    cells[2 * s] = cr;
+    cells[2 * s + 1] = ct;
+
+    double *w = &weights[16 * s];
+    bool withDerivatives = hasDerivatives[s] && derivativeType != HISTOGRAM_ONLY;
+    for (int k = 0; k < nbW; k++) {
+      w[k] = (*B)(static_cast<double>(1 - k) + er);
+      w[4 + k] = (*B)(static_cast<double>(1 - k) + et);
+      if (withDerivatives) {
+        w[8 + k] = (*dB)(static_cast<double>(1 - k) + et);
+        if (derivativeType == SECOND_DERIVATIVES) {
+          w[12 + k] = (*d2B)(static_cast<double>(1 - k) + et);
+        }
+      }
+    }
+  }
+}
+
+/*
+  Add the contributions of the samples in [first, last) to the histogram Prt
+  and its derivatives dPrt and d2Prt, that are only used with the direct
+  layout.
+
+  The bspline cells of a sample that share the same bin along r are
+  contiguous in both layouts: the contributions of the sample to such a row
+  of cells are computed once for Br = 1 and then added to each of the bspline
+  rows scaled by Br.
+*/
+template <typename T>
+void vpTemplateTrackerMIHistogram::accumulateSamples(unsigned int first, unsigned int last, T *Prt, T *dPrt,
+                                                     T *d2Prt)
+{
+#if VISP_HAVE_SSE2
+  const bool useSSE2 = vpCPUFeatures::checkSSE2();
+#else
+  const bool useSSE2 = false;
+#endif
+  const unsigned int n = nbParam;
+  const unsigned int b = static_cast<unsigned int>(bspline);
+  const unsigned int Ncb = static_cast<unsigned int>(Nc + bspline);
+  const unsigned int cellSize = 1 + n + n * n;
+  const bool second = (derivativeType == SECOND_DERIVATIVES);
+  std::vector<T> val(n);
+  std::vector<T> row(b * cellSize);
+
+  for (unsigned int s = first; s < last; s++) {
+    const double *w = &weights[16 * s];
+    unsigned int r0 = static_cast<unsigned int>(cells[2 * s]);
+    unsigned int t0 = static_cast<unsigned int>(cells[2 * s + 1]);
+    // First cell of each row along r and distance between the cells of a row
+    T *pt = direct ? Prt + r0 * Ncb + t0 : Prt + (r0 * static_cast<unsigned int>(Nc) + t0) * b * b * cellSize;
+    unsigned int rowStride = direct ? Ncb : b * cellSize;
+    unsigned int cellStride = direct ? 1 : cellSize;
+
+    if (!hasDerivatives[s] || derivativeType == HISTOGRAM_ONLY) {
+      for (unsigned int kr = 0; kr < b; kr++) {
+        T Br = static_cast<T>(w[kr]);
+        for (unsigned int kt = 0; kt < b; kt++) {
+          pt[kr * rowStride + kt * cellStride] += Br * static_cast<T>(w[4 + kt]);
+        }
+      }
+      continue;
+    }
+
+    const double *d = &derivatives[s * n];
+    for (unsigned int ip = 0; ip < n; ip++) {
+      val[ip] = static_cast<T>(d[ip]);
+    }
+
+    if (direct) {
+      // row holds the b histogram values, then the b * n first derivatives and
+      // the b * n * n second derivatives
+      T *dRow = &row[b];
+      T *d2Row = dRow + b * n;
+      for (unsigned int kt = 0; kt < b; kt++) {
+        T dBt = static_cast<T>(w[8 + kt]);
+        row[kt] = static_cast<T>(w[4 + kt]);
+        for (unsigned int ip = 0; ip < n; ip++) {
+          dRow[kt * n + ip] = -dBt * val[ip];
+        }
+        if (second) {
+          T d2Bt = static_cast<T>(w[12 + kt]);
+          for (unsigned int ip = 0; ip < n; ip++) {
+            T a = d2Bt * val[ip];
+            for (unsigned int jt = 0; jt < n; jt++) {
+              d2Row[(kt * n + ip) * n + jt] = a * val[jt];
+            }
+          }
+        }
+      }
+      for (unsigned int kr = 0; kr < b; kr++) {
+        T Br = static_cast<T>(w[kr]);
+        unsigned int ind = (r0 + kr) * Ncb + t0;
+        addScaled(Prt + ind, Br, &row[0], b, useSSE2);
+        addScaled(dPrt + ind * n, Br, dRow, b * n, useSSE2);
+        if (second) {
+          addScaled(d2Prt + ind * n * n, Br, d2Row, b * n * n, useSSE2);
+        }
+      }
+    } else if (second) {
+      // row holds b cells laid out as in PrtTout
+      for (unsigned int kt = 0; kt < b; kt++) {
+        T dBt = static_cast<T>(w[8 + kt]);
+        T d2Bt = static_cast<T>(w[12 + kt]);
+        T *c = &row[kt * cellSize];
+        c[0] = static_cast<T>(w[4 + kt]);
+        for (unsigned int ip = 0; ip < n; ip++) {
+          T *cp = c + 1 + ip * (n + 1);
+          T a = d2Bt * val[ip];
+          cp[0] = -dBt * val[ip];
+          for (unsigned int jt = 0; jt < n; jt++) {
+            cp[1 + jt] = a * val[jt];
+          }
+        }
+      }
+      for (unsigned int kr = 0; kr < b; kr++) {
+        addScaled(pt + kr * rowStride, static_cast<T>(w[kr]), &row[0], b * cellSize, useSSE2);
+      }
+    } else {
+      // Only the first derivatives of the PrtTout cells are updated: row
+      // holds the b histogram values each followed by its n first derivatives
+      for (unsigned int kt = 0; kt < b; kt++) {
+        T dBt = static_cast<T>(w[8 + kt]);
+        T *c = &row[kt * (n + 1)];
+        c[0] = static_cast<T>(w[4 + kt]);
+        for (unsigned int ip = 0; ip < n; ip++) {
+          c[1 + ip] = -dBt * val[ip];
+        }
+      }
+      for (unsigned int kr = 0; kr < b; kr++) {
+        T Br = static_cast<T>(w[kr]);
+        for (unsigned int kt = 0; kt < b; kt++) {
+          T *cell = pt + kr * rowStride + kt * cellSize;
+          const T *c = &row[kt * (n + 1)];
+          cell[0] += Br * c[0];
+          for (unsigned int ip = 0; ip < n; ip++) {
+            cell[1 + ip * (n + 1)] += Br * c[1 + ip];
+          }
+        }
+      }
+    }
+  }
+}
+
+/*
+  Sum the private histograms into the destination for the values in
+  [begin, end) of the concatenation of the destination arrays.
+*/
+void vpTemplateTrackerMIHistogram::mergeBlocks(int begin, int end)
+{
+  unsigned int offset = 0;
+  for (unsigned int a = 0; a < 3; a++) {
+    unsigned int from = std::max(static_cast<unsigned int>(begin), offset);
+    unsigned int to = std::min(static_cast<unsigned int>(end), offset + dstSize[a]);
+    for (unsigned int i = from; i < to; i++) {
+      double *out = dst[a] + (i - offset);
+      if (reducedPrecision) {
+        for (unsigned int block = 0; block < nbBlocks; block++) {
+          *out += static_cast<double>(blocksF[block][i]);
+        }
+      } else {
+        for (unsigned int block = 1; block < nbBlocks; block++) {
+          *out += blocks[block - 1][i];
+        }
+      }
+    }
+    offset += dstSize[a];
+  }
+}
+
+#endif
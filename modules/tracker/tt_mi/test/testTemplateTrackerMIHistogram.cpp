@@ -0,0 +1,276 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the joint histogram accumulation of the mutual information trackers.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testTemplateTrackerMIHistogram.cpp
+
+  \brief Compare vpTemplateTrackerMIHistogram::accumulate() with a scalar
+  accumulation of the B-spline weighted joint histogram, for both B-spline
+  orders, all the derivative types and both layouts, with 1 and 4 threads.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <visp3/core/vpThreadPool.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/tt/vpTemplateTrackerBSpline.h>
+#include <visp3/tt_mi/vpTemplateTrackerMIBSpline.h>
+#include <visp3/tt_mi/vpTemplateTrackerMIHistogram.h>
+
+namespace
+{
+const int Nc = 8;
+const unsigned int nbParam = 3;
+const unsigned int nbSamples = 10000;
+
+struct Sample {
+  int cr, ct;
+  double er, et;
+  bool hasDerivatives;
+  double val[nbParam];
+};
+
+// Samples computed as in the trackers from intensities in [0, 255]. Every
+// fifth sample has no derivatives
+std::vector<Sample> createSamples()
+{
+  vpUniRand rng(42);
+  std::vector<Sample> samples(nbSamples);
+  for (unsigned int s = 0; s < nbSamples; s++) {
+    Sample &sample = samples[s];
+    double IW = rng.uniform(0.0, 255.0);
+    double IT = rng.uniform(0.0, 255.0);
+    sample.cr = static_cast<int>((IW * (Nc - 1)) / 255.);
+    sample.er = (IW * (Nc - 1)) / 255. - sample.cr;
+    sample.ct = static_cast<int>((IT * (Nc - 1)) / 255.);
+    sample.et = (IT * (Nc - 1)) / 255. - sample.ct;
+    sample.hasDerivatives = (s % 5 != 0);
+    for (unsigned int ip = 0; ip < nbParam; ip++) {
+      sample.val[ip] = rng.uniform(-2.0, 2.0);
+    }
+  }
+  return samples;
+}
+
+// Scalar accumulation of the samples. With the direct layout, Prt holds the
+// (Nc + bspline)^2 bins followed by their first and second derivatives. With
+// the PrtTout layout, each (r, t) bin owns bspline * bspline cells of
+// 1 + nbParam + nbParam * nbParam values
+void accumulateReference(const std::vector<Sample> &samples, int bspline, bool direct,
+                         vpTemplateTrackerMIHistogram::vpDerivativeType type, std::vector<double> &Prt)
+{
+  const unsigned int n = nbParam;
+  const unsigned int b = static_cast<unsigned int>(bspline);
+  const unsigned int Ncb = static_cast<unsigned int>(Nc + bspline);
+  const unsigned int cellSize = 1 + n + n * n;
+  const bool first = (type != vpTemplateTrackerMIHistogram::HISTOGRAM_ONLY);
+  const bool second = (type == vpTemplateTrackerMIHistogram::SECOND_DERIVATIVES);
+
+  if (direct) {
+    Prt.assign(Ncb * Ncb * (1 + (first ? n : 0) + (second ? n * n : 0)), 0.);
+  } else {
+    Prt.assign(static_cast<unsigned int>(Nc * Nc) * b * b * cellSize, 0.);
+  }
+  double *dPrt = &Prt[0] + Ncb * Ncb;
+  double *d2Prt = dPrt + (first ? Ncb * Ncb * n : 0);
+
+  for (size_t s = 0; s < samples.size(); s++) {
+    int cr = samples[s].cr, ct = samples[s].ct;
+    double er = samples[s].er, et = samples[s].et;
+    if (bspline == 3) {
+      if (er > 0.5) {
+        cr++;
+        er = er - 1;
+      }
+      if (et > 0.5) {
+        ct++;
+        et = et - 1;
+      }
+    }
+    const double *val = samples[s].val;
+    bool derivatives = samples[s].hasDerivatives && first;
+
+    for (unsigned int kr = 0; kr < b; kr++) {
+      double x = static_cast<double>(1 - static_cast<int>(kr)) + er;
+      double Br = (bspline == 3) ? vpTemplateTrackerMIBSpline::Bspline3(x) : vpTemplateTrackerBSpline::Bspline4(x);
+      for (unsigned int kt = 0; kt < b; kt++) {
+        double y = static_cast<double>(1 - static_cast<int>(kt)) + et;
+        double Bt, dBt, d2Bt;
+        if (bspline == 3) {
+          Bt = vpTemplateTrackerMIBSpline::Bspline3(y);
+          dBt = vpTemplateTrackerMIBSpline::dBspline3(y);
+          d2Bt = vpTemplateTrackerMIBSpline::d2Bspline3(y);
+        } else {
+          Bt = vpTemplateTrackerBSpline::Bspline4(y);
+          dBt = vpTemplateTrackerMIBSpline::dBspline4(y);
+          d2Bt = vpTemplateTrackerMIBSpline::d2Bspline4(y);
+        }
+
+        if (direct) {
+          unsigned int bin = (static_cast<unsigned int>(cr) + kr) * Ncb + static_cast<unsigned int>(ct) + kt;
+          Prt[bin] += Br * Bt;
+          if (derivatives) {
+            for (unsigned int ip = 0; ip < n; ip++) {
+              dPrt[bin * n + ip] -= Br * dBt * val[ip];
+              if (second) {
+                for (unsigned int jt = 0; jt < n; jt++) {
+                  d2Prt[(bin * n + ip) * n + jt] += Br * d2Bt * val[ip] * val[jt];
+                }
+              }
+            }
+          }
+        } else {
+          double *cell = &Prt[((static_cast<unsigned int>(cr * Nc + ct) * b + kr) * b + kt) * cellSize];
+          cell[0] += Br * Bt;
+          if (derivatives) {
+            for (unsigned int ip = 0; ip < n; ip++) {
+              cell[1 + ip * (n + 1)] -= Br * dBt * val[ip];
+              if (second) {
+                for (unsigned int jt = 0; jt < n; jt++) {
+                  cell[2 + ip * (n + 1) + jt] += Br * d2Bt * val[ip] * val[jt];
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+void accumulate(const std::vector<Sample> &samples, int bspline, bool direct,
+                vpTemplateTrackerMIHistogram::vpDerivativeType type, bool reducedPrecision, std::vector<double> &Prt)
+{
+  vpTemplateTrackerMIHistogram histogram;
+  histogram.reset(Nc, bspline, nbParam, reducedPrecision);
+  for (size_t s = 0; s < samples.size(); s++) {
+    if (samples[s].hasDerivatives) {
+      histogram.addSample(samples[s].cr, samples[s].er, samples[s].ct, samples[s].et, samples[s].val);
+    } else {
+      histogram.addSample(samples[s].cr, samples[s].er, samples[s].ct, samples[s].et);
+    }
+  }
+
+  const unsigned int Ncb = static_cast<unsigned int>(Nc + bspline);
+  if (direct) {
+    const bool first = (type != vpTemplateTrackerMIHistogram::HISTOGRAM_ONLY);
+    const bool second = (type == vpTemplateTrackerMIHistogram::SECOND_DERIVATIVES);
+    Prt.assign(Ncb * Ncb * (1 + (first ? nbParam : 0) + (second ? nbParam * nbParam : 0)), 0.);
+    double *dPrt = first ? &Prt[0] + Ncb * Ncb : NULL;
+    double *d2Prt = second ? dPrt + Ncb * Ncb * nbParam : NULL;
+    histogram.accumulate(&Prt[0], dPrt, d2Prt, type);
+  } else {
+    unsigned int b = static_cast<unsigned int>(bspline);
+    Prt.assign(static_cast<unsigned int>(Nc * Nc) * b * b * (1 + nbParam + nbParam * nbParam), 0.);
+    histogram.accumulate(&Prt[0], type);
+  }
+}
+
+bool compare(const std::string &name, const std::vector<double> &Prt, const std::vector<double> &Prt_ref,
+             double tolerance)
+{
+  if (Prt.size() != Prt_ref.size()) {
+    std::cerr << name << ": sizes differ" << std::endl;
+    return false;
+  }
+  double maxValue = 0, maxError = 0;
+  for (size_t i = 0; i < Prt.size(); i++) {
+    maxValue = std::max(maxValue, std::fabs(Prt_ref[i]));
+    maxError = std::max(maxError, std::fabs(Prt[i] - Prt_ref[i]));
+  }
+  if (!(maxError <= tolerance * maxValue)) {
+    std::cerr << name << ": max error " << maxError << " for values up to " << maxValue << std::endl;
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+int main()
+{
+  const std::vector<Sample> samples = createSamples();
+  const char *typeNames[] = {"HISTOGRAM_ONLY", "FIRST_DERIVATIVES", "SECOND_DERIVATIVES"};
+  const unsigned int nbThreads[] = {1, 4};
+
+  bool success = true;
+  for (int bspline = 3; bspline <= 4; bspline++) {
+    for (int t = 0; t < 3; t++) {
+      vpTemplateTrackerMIHistogram::vpDerivativeType type = static_cast<vpTemplateTrackerMIHistogram::vpDerivativeType>(t);
+      for (int layout = 0; layout < 2; layout++) {
+        bool direct = (layout == 1);
+        std::stringstream ss;
+        ss << "bspline " << bspline << ", " << typeNames[t] << ", " << (direct ? "direct" : "PrtTout") << " layout";
+
+        std::vector<double> Prt_ref;
+        accumulateReference(samples, bspline, direct, type, Prt_ref);
+
+        std::vector<double> Prt_single, Prt_singleF;
+        for (unsigned int k = 0; k < sizeof(nbThreads) / sizeof(nbThreads[0]); k++) {
+          vpThreadPool::instance().setNumThreads(nbThreads[k]);
+          std::stringstream ss_threads;
+          ss_threads << ss.str() << ", " << nbThreads[k] << " thread(s)";
+
+          std::vector<double> Prt, PrtF;
+          accumulate(samples, bspline, direct, type, false, Prt);
+          accumulate(samples, bspline, direct, type, true, PrtF);
+          success = compare(ss_threads.str(), Prt, Prt_ref, 1e-12) && success;
+          success = compare(ss_threads.str() + ", reduced precision", PrtF, Prt_ref, 1e-5) && success;
+
+          // The summation order does not depend on the number of threads
+          if (k == 0) {
+            Prt_single = Prt;
+            Prt_singleF = PrtF;
+          } else if (Prt != Prt_single || PrtF != Prt_singleF) {
+            std::cerr << ss_threads.str() << ": results depend on the number of threads" << std::endl;
+            success = false;
+          }
+        }
+        std::cout << ss.str() << (success ? ": ok" : ": failed") << std::endl;
+      }
+    }
+  }
+
+  if (!success) {
+    std::cerr << "Test failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test succeed" << std::endl;
+  return EXIT_SUCCESS;
+}
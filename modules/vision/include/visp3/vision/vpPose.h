@@ -144,7 +144,7 @@ private:
   std::vector<vpPoint> listOfPoints;
   //! If true, use a parallel RANSAC implementation
   bool useParallelRansac;
-  //! Number of threads to spawn for the parallel RANSAC implementation
+  //! Number of threads used by the parallel RANSAC implementation
   int nbParallelRansacThreads;
   //! Stop the optimization loop when the residual change (|r-r_prec|) <=
   //! epsilon
@@ -316,8 +316,8 @@ public:
     Set the number of threads for the parallel RANSAC implementation.
 
     \note You have to enable the parallel version with setUseParallelRansac().
-    If the number of threads is 0, the number of threads to use is
-    automatically determined with C++11.
+    If the number of threads is 0, all the threads of the process-wide
+    vpThreadPool are used.
     \sa setUseParallelRansac
   */
   inline void setNbParallelRansacThreads(const int nb) { nbParallelRansacThreads = nb; }
@@ -53,13 +53,10 @@
 #include <visp3/core/vpColVector.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpRansac.h>
+#include <visp3/core/vpThreadPool.h>
 #include <visp3/vision/vpPose.h>
 #include <visp3/vision/vpPoseException.h>
 
-#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
-#include <thread>
-#endif
-
 #define eps 1e-6
 
 namespace
@@ -391,12 +388,14 @@ bool vpPose::poseRansac(vpHomogeneousMatrix &cMo, bool (*func)(const vpHomogeneo
   if (executeParallelVersion) {
 #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
     if (nbParallelRansacThreads <= 0) {
-      // Get number of CPU threads
-      nbThreads = std::thread::hardware_concurrency();
-      if (nbThreads <= 1) {
-        nbThreads = 1;
-        executeParallelVersion = false;
-      }
+      // Use all the threads of the shared pool
+      nbThreads = vpThreadPool::instance().getNumThreads();
+    } else {
+      nbThreads = (unsigned int)nbParallelRansacThreads;
+    }
+    if (nbThreads <= 1) {
+      nbThreads = 1;
+      executeParallelVersion = false;
     }
 #endif
   }
@@ -405,15 +404,13 @@ bool vpPose::poseRansac(vpHomogeneousMatrix &cMo, bool (*func)(const vpHomogeneo
 
   if (executeParallelVersion) {
 #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
-    std::vector<std::thread> threadpool;
     std::vector<RansacFunctor> ransacWorkers;
-    const unsigned int nthreads = std::thread::hardware_concurrency();
 
-    int splitTrials = ransacMaxTrials / nthreads;
+    int splitTrials = ransacMaxTrials / nbThreads;
     std::atomic<bool> abort{false};
-    for (size_t i = 0; i < (size_t)nthreads; i++) {
+    for (size_t i = 0; i < (size_t)nbThreads; i++) {
       unsigned int initial_seed = (unsigned int)i; //((unsigned int) time(NULL) ^ i);
-      if (i < (size_t)nthreads - 1) {
+      if (i < (size_t)nbThreads - 1) {
         ransacWorkers.emplace_back(cMo, ransacNbInlierConsensus, splitTrials, ransacThreshold, initial_seed,
                                    checkDegeneratePoints, listOfUniquePoints, func, abort);
       } else {
@@ -423,13 +420,14 @@ bool vpPose::poseRansac(vpHomogeneousMatrix &cMo, bool (*func)(const vpHomogeneo
       }
     }
 
-    for (auto& worker : ransacWorkers) {
-      threadpool.emplace_back(&RansacFunctor::operator(), &worker);
-    }
-
-    for (auto& th : threadpool) {
-      th.join();
-    }
+    // One RANSAC worker per task, run on the process-wide thread pool
+    vpThreadPool::instance().parallel_for(0, (int)ransacWorkers.size(),
+                                          [&ransacWorkers](int begin, int end) {
+                                            for (int i = begin; i < end; i++) {
+                                              ransacWorkers[i]();
+                                            }
+                                          },
+                                          1, nbThreads);
 
     bool successRansac = false;
     size_t best_consensus_size = 0;
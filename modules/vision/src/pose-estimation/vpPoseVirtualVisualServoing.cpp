@@ -69,6 +69,8 @@ void vpPose::poseVirtualVS(vpHomogeneousMatrix &cMo)
     vpColVector err(2 * nb);
     vpColVector sd(2 * nb), s(2 * nb);
     vpColVector v;
+    vpMatrix LTL;
+    vpColVector LTe;
 
     vpPoint P;
     std::list<vpPoint> lP;
@@ -123,12 +125,12 @@ void vpPose::poseVirtualVS(vpHomogeneousMatrix &cMo)
       // compute the residual
       r = err.sumSquare();
 
-      // compute the pseudo inverse of the interaction matrix
-      vpMatrix Lp;
-      L.pseudoInverse(Lp, 1e-16);
-
-      // compute the VVS control law
-      v = -lambda * Lp * err;
+      // compute the VVS control law from the normal equations of the
+      // interaction matrix
+      L.AtA(LTL);
+      L.AtB(err, LTe);
+      LTL.solveNormalEquations6(LTe, v, 1e-32);
+      v *= -lambda;
 
       // std::cout << "r=" << r <<std::endl ;
       // update the pose
@@ -176,6 +178,8 @@ void vpPose::poseVirtualVSrobust(vpHomogeneousMatrix &cMo)
     vpColVector error(2 * nb);
     vpColVector sd(2 * nb), s(2 * nb);
     vpColVector v;
+    vpMatrix WL(2 * nb, 6), WLTWL;
+    vpColVector We(2 * nb), WLTWe;
 
     listP.front();
     vpPoint P;
@@ -244,12 +248,21 @@ void vpPose::poseVirtualVSrobust(vpHomogeneousMatrix &cMo)
         W[2 * k][2 * k] = w[k];
         W[2 * k + 1][2 * k + 1] = w[k];
       }
-      // compute the pseudo inverse of the interaction matrix
-      vpMatrix Lp;
-      (W * L).pseudoInverse(Lp, 1e-6);
+      // compute the weighted interaction matrix and error
+      for (unsigned int i = 0; i < error.getRows(); i++) {
+        const double wi = W[i][i];
+        for (unsigned int j = 0; j < 6; j++) {
+          WL[i][j] = wi * L[i][j];
+        }
+        We[i] = wi * error[i];
+      }
 
-      // compute the VVS control law
-      v = -lambda * Lp * W * error;
+      // compute the VVS control law from the normal equations of the
+      // weighted interaction matrix
+      WL.AtA(WLTWL);
+      WL.AtB(We, WLTWe);
+      WLTWL.solveNormalEquations6(WLTWe, v, 1e-12);
+      v *= -lambda;
 
       cMo = vpExponentialMap::direct(v).inverse() * cMo;
       ;